@@ -19,10 +19,26 @@ AudioEngine::~AudioEngine() {
 
 void AudioEngine::Init(daisy::DaisySeed* hw) {
     hw_ = hw;
+    if (hw_) {
+        // Block size must already be configured (SystemInitializer::InitAudio)
+        timing_monitor_.Configure(hw_->AudioSampleRate(), hw_->AudioBlockSize());
+        sample_clock_.Configure(hw_->AudioSampleRate());
+        transport_clock_.Configure(hw_->AudioSampleRate());
+    }
     initialized_ = true;
 }
 
 void AudioEngine::ProcessAudio(const float* const* in, float* const* out, size_t size) {
+    // Time every callback so overruns and late arrivals are visible in the debug view
+    uint32_t start_us = daisy::System::GetUs();
+    timing_monitor_.BeginCallback(start_us);
+    sample_clock_.AdvanceBlock(start_us, size);
+    transport_clock_.ProcessBlock(sample_clock_.GetBlockStartSample(), size);
+    ProcessBlock(in, out, size);
+    timing_monitor_.EndCallback(daisy::System::GetUs());
+}
+
+void AudioEngine::ProcessBlock(const float* const* in, float* const* out, size_t size) {
     if (!initialized_) {
         // Output silence if not ready
         for (size_t i = 0; i < size; i++) {
@@ -3,6 +3,9 @@
 #include "daisy_seed.h"
 #include "daisysp.h"
 #include "volume_interface.h"
+#include "audio_timing_monitor.h"
+#include "sample_clock.h"
+#include "transport_clock.h"
 
 namespace OpenChord {
 
@@ -60,6 +63,18 @@ public:
     // Query if any audio is playing (for power management)
     bool IsNoteOn() const;
     
+    // Callback timing (xruns, late callbacks, worst-case duration)
+    const AudioTimingMonitor::Stats& GetTimingStats() const { return timing_monitor_.GetStats(); }
+    const AudioTimingMonitor& GetTimingMonitor() const { return timing_monitor_; }
+    float GetCpuLoad() const { return timing_monitor_.GetLoad(); }
+    void ResetTimingStats() { timing_monitor_.Reset(); }
+    
+    // Sample timeline (MIDI event timestamps are in these samples)
+    const SampleClock* GetSampleClock() const { return &sample_clock_; }
+    
+    // Internal transport and MIDI clock (advanced on the sample timeline)
+    TransportClock* GetTransportClock() { return &transport_clock_; }
+    
 private:
     daisy::DaisySeed* hw_;
     IVolumeManager* volume_manager_;
@@ -72,6 +87,19 @@ private:
     
     // Temporary buffers for track mixing
     float track_output_buffer_[2][64];  // Max 64 samples per block
+    
+    // Audio callback watchdog
+    AudioTimingMonitor timing_monitor_;
+    
+    // Samples processed since boot, advanced at every callback start
+    SampleClock sample_clock_;
+    
+    // Clocks are placed in the block before it is processed, so tracks see
+    // the position of the block they render
+    TransportClock transport_clock_;
+    
+    // Actual block processing (ProcessAudio wraps this with timing)
+    void ProcessBlock(const float* const* in, float* const* out, size_t size);
 };
 
 } // namespace OpenChord
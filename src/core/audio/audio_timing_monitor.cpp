@@ -0,0 +1,92 @@
+#include "audio_timing_monitor.h"
+
+namespace OpenChord {
+
+AudioTimingMonitor::AudioTimingMonitor()
+    : period_us_(0.0f)
+    , late_threshold_us_(0)
+    , current_start_us_(0)
+    , has_previous_(false)
+    , log_head_(0)
+    , log_count_(0)
+{
+    Reset();
+}
+
+AudioTimingMonitor::~AudioTimingMonitor() {
+}
+
+void AudioTimingMonitor::Configure(float sample_rate, size_t block_size) {
+    if (sample_rate <= 0.0f || block_size == 0) {
+        period_us_ = 0.0f;
+        late_threshold_us_ = 0;
+    } else {
+        period_us_ = static_cast<float>(block_size) * 1000000.0f / sample_rate;
+        late_threshold_us_ = static_cast<uint32_t>(period_us_ * (1.0f + LATE_TOLERANCE));
+    }
+    stats_.period_us = static_cast<uint32_t>(period_us_);
+}
+
+void AudioTimingMonitor::Reset() {
+    stats_.callback_count = 0;
+    stats_.xrun_count = 0;
+    stats_.late_count = 0;
+    stats_.last_duration_us = 0;
+    stats_.worst_duration_us = 0;
+    stats_.worst_interval_us = 0;
+    stats_.period_us = static_cast<uint32_t>(period_us_);
+    has_previous_ = false;
+    log_head_ = 0;
+    log_count_ = 0;
+}
+
+void AudioTimingMonitor::BeginCallback(uint32_t now_us) {
+    // Interval since previous callback start (unsigned math handles timer wrap)
+    if (has_previous_) {
+        uint32_t interval = now_us - current_start_us_;
+        if (interval > stats_.worst_interval_us) {
+            stats_.worst_interval_us = interval;
+        }
+        if (late_threshold_us_ > 0 && interval > late_threshold_us_) {
+            stats_.late_count++;
+        }
+    }
+
+    current_start_us_ = now_us;
+    has_previous_ = true;
+    stats_.callback_count++;
+
+    log_[log_head_] = now_us;
+    log_head_ = (log_head_ + 1) % LOG_SIZE;
+    if (log_count_ < LOG_SIZE) {
+        log_count_++;
+    }
+}
+
+void AudioTimingMonitor::EndCallback(uint32_t now_us) {
+    if (!has_previous_) return;
+
+    uint32_t duration = now_us - current_start_us_;
+    stats_.last_duration_us = duration;
+    if (duration > stats_.worst_duration_us) {
+        stats_.worst_duration_us = duration;
+    }
+
+    // Callback must finish before the next block is due
+    if (period_us_ > 0.0f && static_cast<float>(duration) > period_us_) {
+        stats_.xrun_count++;
+    }
+}
+
+float AudioTimingMonitor::GetLoad() const {
+    if (period_us_ <= 0.0f) return 0.0f;
+    return static_cast<float>(stats_.last_duration_us) / period_us_;
+}
+
+uint32_t AudioTimingMonitor::GetLoggedTimestamp(size_t age) const {
+    if (age >= log_count_) return 0;
+    size_t index = (log_head_ + LOG_SIZE - 1 - age) % LOG_SIZE;
+    return log_[index];
+}
+
+} // namespace OpenChord
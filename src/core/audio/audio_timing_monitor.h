@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * AudioTimingMonitor - Audio callback watchdog counters
+ *
+ * Records when each audio callback starts and how long it runs, and counts:
+ * - xruns: callback ran longer than one block period (output underrun)
+ * - late callbacks: gap between callback starts exceeded the period + tolerance
+ *
+ * Timestamps are passed in (microseconds) rather than read from hardware.
+ * Written from the audio callback, read from the main loop (debug view).
+ */
+class AudioTimingMonitor {
+public:
+    static constexpr size_t LOG_SIZE = 32;              // Recent callback start timestamps
+    static constexpr float LATE_TOLERANCE = 0.5f;       // Fraction of a period a callback may slip
+
+    struct Stats {
+        uint32_t callback_count;
+        uint32_t xrun_count;
+        uint32_t late_count;
+        uint32_t last_duration_us;
+        uint32_t worst_duration_us;   // Since boot (or last Reset())
+        uint32_t worst_interval_us;   // Largest gap between callback starts
+        uint32_t period_us;           // Block period the above are measured against
+    };
+
+    AudioTimingMonitor();
+    ~AudioTimingMonitor();
+
+    // Set block period from audio configuration
+    void Configure(float sample_rate, size_t block_size);
+
+    // Call at the start and end of every audio callback
+    void BeginCallback(uint32_t now_us);
+    void EndCallback(uint32_t now_us);
+
+    // Clear counters (configuration is kept)
+    void Reset();
+
+    const Stats& GetStats() const { return stats_; }
+
+    // CPU load of the last callback (0.0 - 1.0+, >1.0 is an xrun)
+    float GetLoad() const;
+
+    // Callback start log (age 0 = most recent)
+    size_t GetLogCount() const { return log_count_; }
+    uint32_t GetLoggedTimestamp(size_t age) const;
+
+private:
+    Stats stats_;
+    float period_us_;
+    uint32_t late_threshold_us_;
+
+    uint32_t current_start_us_;
+    bool has_previous_;
+
+    // Circular log of callback start times
+    uint32_t log_[LOG_SIZE];
+    size_t log_head_;
+    size_t log_count_;
+};
+
+} // namespace OpenChord
@@ -0,0 +1,65 @@
+#include "sample_clock.h"
+
+namespace OpenChord {
+
+SampleClock::SampleClock()
+    : sample_rate_(48000.0f)
+    , samples_per_us_(0.048f)
+    , sequence_(0)
+    , block_start_sample_(0)
+    , block_start_us_(0)
+    , next_block_sample_(0)
+{
+}
+
+SampleClock::~SampleClock() {
+}
+
+void SampleClock::Configure(float sample_rate) {
+    if (sample_rate <= 0.0f) return;
+    sample_rate_ = sample_rate;
+    samples_per_us_ = sample_rate / 1000000.0f;
+}
+
+void SampleClock::AdvanceBlock(uint32_t now_us, size_t block_size) {
+    // Odd sequence while the anchor is being written
+    uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_release);
+    block_start_sample_ = next_block_sample_;
+    block_start_us_ = now_us;
+    sequence_.store(seq + 2, std::memory_order_release);
+
+    next_block_sample_ += static_cast<uint32_t>(block_size);
+}
+
+uint32_t SampleClock::GetBlockStartSample() const {
+    uint32_t seq;
+    uint32_t sample;
+    do {
+        seq = sequence_.load(std::memory_order_acquire);
+        sample = block_start_sample_;
+    } while ((seq & 1) || seq != sequence_.load(std::memory_order_acquire));
+    return sample;
+}
+
+uint32_t SampleClock::MicrosToSampleTime(uint32_t time_us) const {
+    uint32_t seq;
+    uint32_t sample;
+    uint32_t start_us;
+    do {
+        seq = sequence_.load(std::memory_order_acquire);
+        sample = block_start_sample_;
+        start_us = block_start_us_;
+    } while ((seq & 1) || seq != sequence_.load(std::memory_order_acquire));
+
+    // Signed offset: events may arrive just before the current block started
+    int32_t delta_us = static_cast<int32_t>(time_us - start_us);
+    int32_t delta_samples = static_cast<int32_t>(static_cast<float>(delta_us) * samples_per_us_);
+    return sample + static_cast<uint32_t>(delta_samples);
+}
+
+uint32_t SampleClock::SamplesToMicros(uint32_t samples) const {
+    return static_cast<uint32_t>(static_cast<float>(samples) / samples_per_us_);
+}
+
+} // namespace OpenChord
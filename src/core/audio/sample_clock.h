@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * SampleClock - Running count of audio samples processed since boot
+ *
+ * Advanced once per audio callback with the block's start time, so a
+ * microsecond timestamp taken anywhere (e.g. a MIDI receive interrupt) can
+ * be mapped onto the sample timeline used by MidiEvent timestamps.
+ *
+ * Written from the audio callback, read from the main loop. The block anchor
+ * is published with a sequence counter so readers never see a torn pair.
+ */
+class SampleClock {
+public:
+    SampleClock();
+    ~SampleClock();
+
+    void Configure(float sample_rate);
+
+    // Call at the start of every audio callback (before processing the block)
+    void AdvanceBlock(uint32_t now_us, size_t block_size);
+
+    // Sample time of the current block start
+    uint32_t GetBlockStartSample() const;
+
+    // Map a GetUs() timestamp to sample time (wraps like the sample counter)
+    uint32_t MicrosToSampleTime(uint32_t time_us) const;
+
+    // Duration conversions
+    uint32_t SamplesToMicros(uint32_t samples) const;
+
+    float GetSampleRate() const { return sample_rate_; }
+
+private:
+    float sample_rate_;
+    float samples_per_us_;
+
+    // Anchor of the block being processed (published by the audio callback)
+    std::atomic<uint32_t> sequence_;
+    uint32_t block_start_sample_;
+    uint32_t block_start_us_;
+    uint32_t next_block_sample_;
+};
+
+} // namespace OpenChord
@@ -0,0 +1,240 @@
+#include "transport_clock.h"
+
+namespace OpenChord {
+
+namespace {
+constexpr uint8_t MIDI_CLOCK = 0xF8;
+constexpr uint8_t MIDI_START = 0xFA;
+constexpr uint8_t MIDI_CONTINUE = 0xFB;
+constexpr uint8_t MIDI_STOP = 0xFC;
+} // namespace
+
+TransportClock::TransportClock()
+    : sample_rate_(48000.0f)
+    , output_(nullptr)
+    , output_context_(nullptr)
+    , tempo_(120.0f)
+    , tick_interval_q16_(0)
+    , numerator_(4)
+    , denominator_(4)
+    , command_(COMMAND_NONE)
+    , following_(false)
+    , model_sequence_(0)
+    , model_{0, 0, 0}
+    , playing_(false)
+    , was_following_(false)
+    , audio_model_{0, 0, 0}
+    , next_tick_(0)
+    , samples_to_tick_q16_(0)
+    , clock_count_(0)
+    , block_tick_(0)
+    , block_tick_offset_q16_(0)
+    , block_interval_q16_(0)
+{
+    UpdateTickInterval();
+}
+
+TransportClock::~TransportClock() {
+}
+
+void TransportClock::Configure(float sample_rate) {
+    if (sample_rate <= 0.0f) return;
+    sample_rate_ = sample_rate;
+    UpdateTickInterval();
+}
+
+void TransportClock::SetOutput(RealtimeOutput output, void* context) {
+    output_context_ = context;
+    output_ = output;
+}
+
+void TransportClock::SetTempo(float bpm) {
+    if (bpm < MIN_TEMPO) bpm = MIN_TEMPO;
+    if (bpm > MAX_TEMPO) bpm = MAX_TEMPO;
+    tempo_.store(bpm, std::memory_order_relaxed);
+    UpdateTickInterval();
+}
+
+void TransportClock::SetTimeSignature(int numerator, int denominator) {
+    // Denominator must be a power of two that divides the 96 clocks of a whole note
+    if (numerator < 1 || numerator > 32) return;
+    if (denominator != 1 && denominator != 2 && denominator != 4 &&
+        denominator != 8 && denominator != 16 && denominator != 32) return;
+    numerator_.store(static_cast<uint8_t>(numerator), std::memory_order_relaxed);
+    denominator_.store(static_cast<uint8_t>(denominator), std::memory_order_relaxed);
+}
+
+void TransportClock::Start() {
+    command_.store(COMMAND_START, std::memory_order_release);
+}
+
+void TransportClock::Stop() {
+    command_.store(COMMAND_STOP, std::memory_order_release);
+}
+
+void TransportClock::Continue() {
+    command_.store(COMMAND_CONTINUE, std::memory_order_release);
+}
+
+void TransportClock::SetFollowing(bool following) {
+    following_.store(following, std::memory_order_release);
+}
+
+void TransportClock::SetExternalModel(uint32_t tick, uint32_t tick_sample, uint32_t interval_q16, float bpm) {
+    // Odd sequence while the model is being written
+    uint32_t seq = model_sequence_.load(std::memory_order_relaxed);
+    model_sequence_.store(seq + 1, std::memory_order_release);
+    model_.tick = tick;
+    model_.tick_sample = tick_sample;
+    model_.interval_q16 = interval_q16;
+    model_sequence_.store(seq + 2, std::memory_order_release);
+
+    // Tempo for plugins and for carrying on if the master goes away
+    tempo_.store(bpm, std::memory_order_relaxed);
+    tick_interval_q16_.store(interval_q16, std::memory_order_relaxed);
+}
+
+void TransportClock::UpdateTickInterval() {
+    // Samples per clock in 16.16 fixed point (6000 samples at 20 BPM / 48kHz fits).
+    // Double here: float rounding of the interval adds up to samples of drift.
+    double samples_per_tick = static_cast<double>(sample_rate_) * 60.0 /
+                              (static_cast<double>(tempo_.load(std::memory_order_relaxed)) * PPQN);
+    tick_interval_q16_.store(static_cast<uint32_t>(samples_per_tick * 65536.0 + 0.5),
+                             std::memory_order_relaxed);
+}
+
+void TransportClock::ProcessBlock(uint32_t block_start_sample, size_t block_size) {
+    const bool following = following_.load(std::memory_order_acquire);
+    if (following) {
+        ReadModel();
+    } else if (was_following_ && audio_model_.interval_q16 > 0) {
+        // Master gone or sync turned off: carry on from the model's next clock
+        int32_t offset = ModelTickOffset(next_tick_.load(std::memory_order_relaxed), block_start_sample);
+        int32_t max_offset = static_cast<int32_t>(audio_model_.interval_q16 >> 16);
+        if (offset < 0) offset = 0;
+        if (offset > max_offset) offset = max_offset;
+        samples_to_tick_q16_ = static_cast<uint32_t>(offset) << 16;
+    }
+    was_following_ = following;
+
+    ApplyCommand(block_start_sample);
+    if (!playing_.load(std::memory_order_relaxed)) return;
+
+    if (following) {
+        ProcessFollowingBlock(block_start_sample, block_size);
+        return;
+    }
+
+    // A new tempo takes effect from the next clock on
+    const uint32_t interval_q16 = tick_interval_q16_.load(std::memory_order_relaxed);
+    const uint32_t block_q16 = static_cast<uint32_t>(block_size) << 16;
+    SetBlockGrid(next_tick_.load(std::memory_order_relaxed), samples_to_tick_q16_, interval_q16);
+
+    while (samples_to_tick_q16_ < block_q16) {
+        Send(MIDI_CLOCK, block_start_sample + (samples_to_tick_q16_ >> 16));
+        next_tick_.store(next_tick_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        clock_count_++;
+        samples_to_tick_q16_ += interval_q16;
+    }
+    samples_to_tick_q16_ -= block_q16;
+}
+
+void TransportClock::ReadModel() {
+    uint32_t seq = model_sequence_.load(std::memory_order_acquire);
+    if (seq & 1) return;
+    ExternalModel model = model_;
+    if (seq != model_sequence_.load(std::memory_order_acquire)) return;
+    audio_model_ = model;
+}
+
+void TransportClock::ProcessFollowingBlock(uint32_t block_start_sample, size_t block_size) {
+    if (audio_model_.interval_q16 == 0) return;
+
+    // Late clocks count at the block start, the rest on the model's spacing
+    const uint32_t first_tick = next_tick_.load(std::memory_order_relaxed);
+    int32_t first_offset = ModelTickOffset(first_tick, block_start_sample);
+    if (first_offset < 0) first_offset = 0;
+    SetBlockGrid(first_tick, static_cast<uint32_t>(first_offset) << 16, audio_model_.interval_q16);
+
+    for (int i = 0; i < MAX_CATCH_UP_TICKS; i++) {
+        uint32_t tick = next_tick_.load(std::memory_order_relaxed);
+        int32_t offset = ModelTickOffset(tick, block_start_sample);
+        if (offset >= static_cast<int32_t>(block_size)) break;
+
+        // Late clocks (the model moved back, or was rebased by Start) count now
+        next_tick_.store(tick + 1, std::memory_order_relaxed);
+        clock_count_++;
+    }
+}
+
+int32_t TransportClock::ModelTickOffset(uint32_t tick, uint32_t block_start_sample) const {
+    // Clock `tick` relative to the block start, from the model's reference clock
+    int32_t ticks_from_model = static_cast<int32_t>(tick - audio_model_.tick);
+    int64_t samples_from_model = static_cast<int64_t>(ticks_from_model) * audio_model_.interval_q16 / 65536;
+    return static_cast<int32_t>(audio_model_.tick_sample - block_start_sample) +
+           static_cast<int32_t>(samples_from_model);
+}
+
+void TransportClock::ApplyCommand(uint32_t block_start_sample) {
+    uint8_t command = command_.exchange(COMMAND_NONE, std::memory_order_acquire);
+    bool playing = playing_.load(std::memory_order_relaxed);
+
+    switch (command) {
+        case COMMAND_START:
+            // The first clock goes out with START, on the block's first sample
+            next_tick_.store(0, std::memory_order_relaxed);
+            samples_to_tick_q16_ = 0;
+            Send(MIDI_START, block_start_sample);
+            playing_.store(true, std::memory_order_relaxed);
+            break;
+
+        case COMMAND_CONTINUE:
+            if (playing) break;
+            samples_to_tick_q16_ = 0;
+            Send(MIDI_CONTINUE, block_start_sample);
+            playing_.store(true, std::memory_order_relaxed);
+            break;
+
+        case COMMAND_STOP:
+            if (!playing) break;
+            Send(MIDI_STOP, block_start_sample);
+            playing_.store(false, std::memory_order_relaxed);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void TransportClock::SetBlockGrid(uint32_t tick, uint32_t offset_q16, uint32_t interval_q16) {
+    block_tick_.store(tick, std::memory_order_relaxed);
+    block_tick_offset_q16_.store(offset_q16, std::memory_order_relaxed);
+    block_interval_q16_.store(interval_q16, std::memory_order_relaxed);
+}
+
+void TransportClock::Send(uint8_t status, uint32_t sample_time) {
+    if (output_ && !was_following_) {
+        output_(status, sample_time, output_context_);
+    }
+}
+
+SongPosition TransportClock::GetPosition() const {
+    SongPosition position;
+    uint32_t next_tick = next_tick_.load(std::memory_order_relaxed);
+    position.tick = next_tick > 0 ? next_tick - 1 : 0;
+    position.playing = playing_.load(std::memory_order_relaxed);
+
+    const uint32_t ticks_per_beat = PPQN * 4 / denominator_.load(std::memory_order_relaxed);
+    const uint32_t ticks_per_bar = ticks_per_beat * numerator_.load(std::memory_order_relaxed);
+    position.bar = position.tick / ticks_per_bar;
+    uint32_t tick_in_bar = position.tick % ticks_per_bar;
+    position.beat = static_cast<uint8_t>(tick_in_bar / ticks_per_beat);
+    position.tick_in_beat = static_cast<uint8_t>(tick_in_bar % ticks_per_beat);
+
+    position.block_tick = block_tick_.load(std::memory_order_relaxed);
+    position.block_tick_offset_q16 = block_tick_offset_q16_.load(std::memory_order_relaxed);
+    position.tick_interval_q16 = block_interval_q16_.load(std::memory_order_relaxed);
+    return position;
+}
+
+} // namespace OpenChord
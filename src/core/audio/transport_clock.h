@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * Musical position of the internal transport
+ *
+ * tick counts 24 PPQN clocks since Start (0 = downbeat of bar 1). A beat is
+ * one time signature denominator note, so 6/8 has six 12-tick beats.
+ */
+struct SongPosition {
+    uint32_t tick;          // Clocks since Start (index of the last clock sent)
+    uint32_t bar;           // 0-based
+    uint8_t beat;           // 0-based beat within the bar
+    uint8_t tick_in_beat;   // 0-based clock within the beat
+    bool playing;
+
+    // Clocks in the block: clock block_tick falls block_tick_offset_q16 after
+    // the block start, later ones every tick_interval_q16 (samples, 16.16)
+    uint32_t block_tick;
+    uint32_t block_tick_offset_q16;
+    uint32_t tick_interval_q16;
+
+    SongPosition()
+        : tick(0), bar(0), beat(0), tick_in_beat(0), playing(false)
+        , block_tick(0), block_tick_offset_q16(0), tick_interval_q16(0) {}
+};
+
+/**
+ * TransportClock - Internal transport driven by the audio sample counter
+ *
+ * ProcessBlock() runs at the start of every audio callback and places each
+ * 24 PPQN clock on the sample where it falls inside the block, so clock
+ * timing follows the audio timeline and never the main loop: output jitter
+ * is at most one block, whatever the UI is doing. Tick spacing is kept in
+ * 16.16 fixed point samples, so there is no drift over long runs.
+ *
+ * Start/Stop/Continue and tempo are requested from the main loop and take
+ * effect at the next block; the matching real-time bytes (0xFA/0xFC/0xFB,
+ * then 0xF8 per clock) go to the output callback from the audio callback
+ * with their sample time.
+ *
+ * While following an external clock (MidiClockFollower), clock positions
+ * come from the follower's model of the master's clocks instead of the
+ * internal tempo, and nothing is sent: the master's clock already reaches
+ * other devices.
+ */
+class TransportClock {
+public:
+    static constexpr uint32_t PPQN = 24;
+    static constexpr float MIN_TEMPO = 20.0f;
+    static constexpr float MAX_TEMPO = 300.0f;
+
+    // Called from the audio callback for every real-time byte
+    typedef void (*RealtimeOutput)(uint8_t status, uint32_t sample_time, void* context);
+
+    TransportClock();
+    ~TransportClock();
+
+    void Configure(float sample_rate);
+    void SetOutput(RealtimeOutput output, void* context);
+
+    // Main loop side
+    void SetTempo(float bpm);
+    float GetTempo() const { return tempo_.load(std::memory_order_relaxed); }
+    void SetTimeSignature(int numerator, int denominator);
+    void Start();       // From the top
+    void Stop();
+    void Continue();    // From the current position
+
+    // External sync (main loop). The model says clock `tick` (counted from
+    // Start) falls on `tick_sample`, and later clocks follow every interval.
+    void SetFollowing(bool following);
+    bool IsFollowing() const { return following_.load(std::memory_order_relaxed); }
+    void SetExternalModel(uint32_t tick, uint32_t tick_sample, uint32_t interval_q16, float bpm);
+
+    // Call at the start of every audio callback (after SampleClock::AdvanceBlock)
+    void ProcessBlock(uint32_t block_start_sample, size_t block_size);
+
+    // Position at the current block (safe from any context)
+    SongPosition GetPosition() const;
+    bool IsPlaying() const { return playing_.load(std::memory_order_relaxed); }
+
+    // Clocks sent since boot (diagnostics)
+    uint32_t GetClockCount() const { return clock_count_; }
+
+private:
+    enum Command : uint8_t {
+        COMMAND_NONE,
+        COMMAND_START,
+        COMMAND_STOP,
+        COMMAND_CONTINUE
+    };
+
+    float sample_rate_;
+    RealtimeOutput output_;
+    void* output_context_;
+
+    // Written by the main loop, read by the audio callback
+    std::atomic<float> tempo_;
+    std::atomic<uint32_t> tick_interval_q16_;   // Samples per clock, 16.16
+    std::atomic<uint8_t> numerator_;
+    std::atomic<uint8_t> denominator_;
+    std::atomic<uint8_t> command_;
+
+    struct ExternalModel {
+        uint32_t tick;
+        uint32_t tick_sample;
+        uint32_t interval_q16;
+    };
+
+    // Late clocks sent at once per block, at most (after a model jump)
+    static constexpr int MAX_CATCH_UP_TICKS = 4;
+
+    // External clock model, published by the main loop with a sequence
+    // counter. The audio callback can't wait for the writer it interrupted,
+    // so a torn read keeps the previous copy (audio_model_).
+    std::atomic<bool> following_;
+    std::atomic<uint32_t> model_sequence_;
+    ExternalModel model_;
+
+    // Audio callback state
+    std::atomic<bool> playing_;
+    bool was_following_;
+    ExternalModel audio_model_;
+    std::atomic<uint32_t> next_tick_;           // Index of the next clock to send
+    uint32_t samples_to_tick_q16_;              // From block start to the next clock
+    uint32_t clock_count_;
+
+    // Clock grid of the current block, for plugins placing events on clocks
+    std::atomic<uint32_t> block_tick_;
+    std::atomic<uint32_t> block_tick_offset_q16_;
+    std::atomic<uint32_t> block_interval_q16_;
+
+    void UpdateTickInterval();
+    void ApplyCommand(uint32_t block_start_sample);
+    void SetBlockGrid(uint32_t tick, uint32_t offset_q16, uint32_t interval_q16);
+    void ReadModel();
+    void ProcessFollowingBlock(uint32_t block_start_sample, size_t block_size);
+    int32_t ModelTickOffset(uint32_t tick, uint32_t block_start_sample) const;
+    void Send(uint8_t status, uint32_t sample_time);
+};
+
+} // namespace OpenChord
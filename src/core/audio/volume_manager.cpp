@@ -18,8 +18,8 @@ VolumeManager::VolumeManager()
 VolumeManager::~VolumeManager() = default;
 
 void VolumeManager::Update() {
-    // Get current ADC value from IO system
-    float current_raw = io_->GetAnalog()->GetADCValue(0); // Channel 0 for volume pot
+    // Get current (One-Euro filtered) volume pot value from IO system
+    float current_raw = io_->GetAnalog()->GetVolume();
     
     // Check if values have changed significantly (reduced threshold for smoother control)
     if (fabs(current_raw - volume_data_.raw_adc) > 0.001f) {
@@ -5,15 +5,19 @@
 #include <cmath>
 
 AnalogManager::AnalogManager() 
-    : hw_(nullptr), filter_strength_(0.1f), dead_zone_(0.05f), 
+    : hw_(nullptr), filter_strength_(1.0f), dead_zone_(0.05f), 
       battery_check_ms_(1000), low_battery_threshold_(3.3f), healthy_(true),
-      mic_adc_enabled_(false) {  // Disabled by default for power savings
+      mic_adc_enabled_(false),  // Disabled by default for power savings
+      sample_timer_running_(false), last_sample_us_(0), sample_count_(0),
+      snapshot_sequence_(0) {
     
     // Initialize ADC configuration
     memset(adc_configured_, 0, sizeof(adc_configured_));
     
     // Initialize analog inputs
     memset(inputs_, 0, sizeof(inputs_));
+    memset(&snapshot_, 0, sizeof(snapshot_));
+    memset(filter_enabled_, 0, sizeof(filter_enabled_));
     
     // Initialize joystick calibration
     memset(&joystick_cal_, 0, sizeof(joystick_cal_));
@@ -61,6 +65,8 @@ void AnalogManager::Init(daisy::DaisySeed* hw) {
     
     // Configure ADC channels - AnalogManager now handles its own hardware
     ConfigureADC();
+    ConfigureFilters();
+    StartSampleTimer();
 }
 
 void AnalogManager::Update() {
@@ -69,7 +75,6 @@ void AnalogManager::Update() {
     UpdateADC();
     UpdateInputs();
     UpdateBattery();
-    ApplyFiltering();
     ApplyCalibration();
     DetectClipping();
 }
@@ -77,6 +82,11 @@ void AnalogManager::Update() {
 void AnalogManager::Shutdown() {
     if (!hw_) return;
     
+    if (sample_timer_running_) {
+        sample_timer_.Stop();
+        sample_timer_running_ = false;
+    }
+    
     // Shutdown ADC if needed
     healthy_ = false;
     hw_ = nullptr;
@@ -206,6 +216,7 @@ void AnalogManager::ResetCalibration() {
 // Configuration
 void AnalogManager::SetFilterStrength(float strength) {
     filter_strength_ = std::max(0.0f, std::min(1.0f, strength));
+    ConfigureFilters();
 }
 
 void AnalogManager::SetDeadZone(float dead_zone) {
@@ -243,8 +254,10 @@ void AnalogManager::ConfigureADC() {
     adc_configured_[3] = true;  // Joystick Y
     adc_configured_[4] = true;  // Microphone
     
-    // Initialize the ADC system with 5 channels
-    hw_->adc.Init(&adc_configs_[0], 5);
+    // Initialize the ADC system with 5 channels. After Start() the ADC scans
+    // all channels continuously into a circular DMA buffer; 64x hardware
+    // oversampling averages out conversion noise before the filters see it
+    hw_->adc.Init(&adc_configs_[0], 5, daisy::AdcHandle::OVS_64);
     
     // Add delay for ADC to stabilize
     hw_->DelayMs(20);
@@ -265,51 +278,101 @@ void AnalogManager::ConfigureADC() {
     inputs_[4].healthy = true;  // Microphone
 }
 
+void AnalogManager::ConfigureFilters() {
+    // One-Euro filters on the controls; battery and mic pass through
+    // (battery is read once a second, mic clipping needs the raw peak)
+    filter_enabled_[0] = filter_strength_ > 0.0f;  // Volume
+    filter_enabled_[2] = filter_strength_ > 0.0f;  // Joystick X
+    filter_enabled_[3] = filter_strength_ > 0.0f;  // Joystick Y
+    if (filter_strength_ <= 0.0f) return;
+    
+    // Lower strength raises the rest cutoff (less smoothing, same speed response)
+    OneEuroTuning volume = VOLUME_FILTER_TUNING;
+    OneEuroTuning joystick = JOYSTICK_FILTER_TUNING;
+    volume.min_cutoff_hz /= filter_strength_;
+    joystick.min_cutoff_hz /= filter_strength_;
+    filters_[0].Configure(volume);
+    filters_[2].Configure(joystick);
+    filters_[3].Configure(joystick);
+}
+
+void AnalogManager::StartSampleTimer() {
+    // Sample and filter from a timer interrupt at a fixed rate
+    daisy::TimerHandle::Config timer_config;
+    timer_config.periph = daisy::TimerHandle::Config::Peripheral::TIM_4;
+    timer_config.dir = daisy::TimerHandle::Config::CounterDir::UP;
+    timer_config.enable_irq = true;
+    timer_config.period = daisy::System::GetPClk1Freq() * 2 / ADC_SAMPLE_TICK_HZ;  // APB1 timer clock = 2x PCLK1
+    if (sample_timer_.Init(timer_config) == daisy::TimerHandle::Result::OK) {
+        sample_timer_.SetCallback(SampleTimerCallback, this);
+        sample_timer_running_ = (sample_timer_.Start() == daisy::TimerHandle::Result::OK);
+    }
+}
+
+void AnalogManager::SampleTimerCallback(void* data) {
+    AnalogManager* manager = static_cast<AnalogManager*>(data);
+    if (!manager || !manager->hw_) return;
+    manager->SampleTick(daisy::System::GetUs());
+}
+
+void AnalogManager::SampleTick(uint32_t now_us) {
+    float dt_s = (sample_count_ > 0) ? static_cast<float>(now_us - last_sample_us_) * 0.000001f : 0.0f;
+    last_sample_us_ = now_us;
+    sample_count_++;
+    
+    // Odd sequence while the snapshot is being written
+    uint32_t seq = snapshot_sequence_.load(std::memory_order_relaxed);
+    snapshot_sequence_.store(seq + 1, std::memory_order_release);
+    
+    for (int i = 0; i < NUM_ADC_CHANNELS; i++) {
+        // Skip mic ADC read when disabled (power savings), keep last value
+        if (i == 4 && !mic_adc_enabled_) continue;
+        
+        float raw = hw_->adc.GetFloat(i);
+        snapshot_.raw[i] = raw;
+        snapshot_.filtered[i] = filter_enabled_[i] ? filters_[i].Process(raw, dt_s) : raw;
+    }
+    
+    snapshot_sequence_.store(seq + 2, std::memory_order_release);
+}
+
+void AnalogManager::ReadSnapshot(AnalogSnapshot* out) const {
+    uint32_t seq;
+    do {
+        seq = snapshot_sequence_.load(std::memory_order_acquire);
+        memcpy(out, &snapshot_, sizeof(AnalogSnapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1) || seq != snapshot_sequence_.load(std::memory_order_acquire));
+}
+
 void AnalogManager::UpdateADC() {
     if (!hw_) return;
     
-    // ADC is updated automatically by Daisy Seed
-    // We just read the values when needed
+    // Without the timer, sample and filter from here (filters use the real dt)
+    if (!sample_timer_running_) {
+        SampleTick(daisy::System::GetUs());
+    }
 }
 
 void AnalogManager::UpdateInputs() {
     if (!hw_) return;
     
-    // Read ADC values - array index matches ADC channel number
-    // inputs_[0] = ADC channel 0 (Volume pot)
-    float float_value = hw_->adc.GetFloat(0);
-    inputs_[0].raw_value = float_value;
-    inputs_[0].filtered_value = float_value;
-    inputs_[0].healthy = (float_value >= 0.0f && float_value <= 1.0f);
-    
-    // inputs_[1] = ADC channel 1 (Battery monitor)
-    float battery_value = hw_->adc.GetFloat(1);
-    inputs_[1].raw_value = battery_value;
-    inputs_[1].filtered_value = battery_value;
-    inputs_[1].healthy = (battery_value >= 0.0f && battery_value <= 1.0f);
-    
-    // inputs_[2] = ADC channel 2 (Joystick X)
-    float joystick_x = hw_->adc.GetFloat(2);
-    inputs_[2].raw_value = joystick_x;
-    inputs_[2].filtered_value = joystick_x;
-    inputs_[2].healthy = (joystick_x >= 0.0f && joystick_x <= 1.0f);
-    
-    // inputs_[3] = ADC channel 3 (Joystick Y)
-    float joystick_y = hw_->adc.GetFloat(3);
-    inputs_[3].raw_value = joystick_y;
-    inputs_[3].filtered_value = joystick_y;
-    inputs_[3].healthy = (joystick_y >= 0.0f && joystick_y <= 1.0f);
-    
-    // inputs_[4] = ADC channel 4 (Microphone) - ONLY read if enabled
-    // Skip mic ADC read when disabled (power savings - mic ADC consumes significant power)
-    if (mic_adc_enabled_) {
-    float mic_value = hw_->adc.GetFloat(4);
-    inputs_[4].raw_value = mic_value;
-    inputs_[4].filtered_value = mic_value;
-    inputs_[4].healthy = (mic_value >= 0.0f && mic_value <= 1.0f);
-    } else {
-        // Keep last value, mark as not healthy to indicate it's not being read
-        inputs_[4].healthy = false;
+    // Latest filtered values - no conversion or filtering cost here
+    AnalogSnapshot snapshot;
+    ReadSnapshot(&snapshot);
+    
+    // Array index matches ADC channel number:
+    // 0 = Volume pot, 1 = Battery monitor, 2 = Joystick X, 3 = Joystick Y, 4 = Microphone
+    for (int i = 0; i < NUM_ADC_CHANNELS; i++) {
+        if (i == 4 && !mic_adc_enabled_) {
+            // Keep last value, mark as not healthy to indicate it's not being read
+            inputs_[4].healthy = false;
+            continue;
+        }
+        inputs_[i].raw_value = snapshot.raw[i];
+        inputs_[i].filtered_value = snapshot.filtered[i];
+        inputs_[i].healthy = IsValidADCValue(snapshot.raw[i]);
+        inputs_[i].update_count++;
     }
 }
 
@@ -339,16 +402,6 @@ void AnalogManager::UpdateBattery() {
     }
 }
 
-void AnalogManager::ApplyFiltering() {
-    // Simple low-pass filter for all inputs
-    for (int i = 0; i < NUM_ADC_CHANNELS; i++) {
-        if (inputs_[i].healthy) {
-            inputs_[i].filtered_value = inputs_[i].filtered_value * (1.0f - filter_strength_) + 
-                                       inputs_[i].raw_value * filter_strength_;
-        }
-    }
-}
-
 void AnalogManager::ApplyCalibration() {
     // Always set normalized values, even without calibration
     // Convert from 0.0-1.0 range to -1.0 to 1.0 centered range
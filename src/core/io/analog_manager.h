@@ -1,6 +1,8 @@
 #pragma once
 
 #include "daisy_seed.h"
+#include "one_euro_filter.h"
+#include <atomic>
 #include <cstdint>
 
 // ADC channel configuration
@@ -56,6 +58,11 @@ struct BatteryState {
  * - Microphone input with clipping detection
  * - Battery voltage monitoring with percentage calculation
  * - ADC noise filtering and smoothing
+ *
+ * The ADC scans all channels continuously by DMA with hardware oversampling.
+ * A 1 kHz timer interrupt samples the latest conversions, runs the One-Euro
+ * filters (joystick, volume) and publishes a snapshot; Update() only copies
+ * the snapshot, so the main loop rate no longer sets the filter rate.
  */
 class AnalogManager {
 public:
@@ -107,7 +114,7 @@ public:
     const JoystickCalibration& GetJoystickCalibration() const { return joystick_cal_; }
     
     // Configuration
-    void SetFilterStrength(float strength); // 0.0f = no filter, 1.0f = max filter
+    void SetFilterStrength(float strength); // 0.0f = no filter, 1.0f = tuned (max) smoothing at rest
     void SetDeadZone(float dead_zone);      // Joystick dead zone (0.0f to 0.5f)
     void SetBatteryCheckInterval(uint32_t ms);
     void SetLowBatteryThreshold(float voltage);
@@ -115,6 +122,10 @@ public:
     // Power optimization - disable mic ADC reads when not needed
     void SetMicADCEnabled(bool enabled) { mic_adc_enabled_ = enabled; }
     bool IsMicADCEnabled() const { return mic_adc_enabled_; }
+    
+    // Sampling diagnostics
+    bool IsSampleTimerRunning() const { return sample_timer_running_; }
+    uint32_t GetSampleCount() const { return sample_count_; }
 
 private:
     // Hardware reference
@@ -144,12 +155,31 @@ private:
     bool healthy_;
     bool mic_adc_enabled_;        // Enable/disable mic ADC reads (power savings)
     
+    // Timer-driven sampling and filtering (interrupt -> snapshot)
+    static constexpr uint32_t ADC_SAMPLE_TICK_HZ = 1000;
+    struct AnalogSnapshot {
+        float raw[NUM_ADC_CHANNELS];       // Latest oversampled conversion
+        float filtered[NUM_ADC_CHANNELS];  // One-Euro output (raw for battery/mic)
+    };
+    OneEuroFilter filters_[NUM_ADC_CHANNELS];
+    bool filter_enabled_[NUM_ADC_CHANNELS];
+    daisy::TimerHandle sample_timer_;
+    bool sample_timer_running_;
+    uint32_t last_sample_us_;
+    uint32_t sample_count_;
+    AnalogSnapshot snapshot_;
+    std::atomic<uint32_t> snapshot_sequence_;  // Odd while the interrupt is writing
+    
     // Internal methods
     void ConfigureADC();
+    void ConfigureFilters();
+    void StartSampleTimer();
+    static void SampleTimerCallback(void* data);
+    void SampleTick(uint32_t now_us);
+    void ReadSnapshot(AnalogSnapshot* out) const;
     void UpdateADC();
     void UpdateInputs();
     void UpdateBattery();
-    void ApplyFiltering();
     void ApplyCalibration();
     void DetectClipping();
     float NormalizeValue(float raw_value, AnalogInputType type);
@@ -7,160 +7,77 @@ ButtonInputHandler::ButtonInputHandler()
     : digital_manager_(nullptr),
       input_mode_(InputMode::MIDI_NOTES),
       hold_threshold_ms_(500),
-      event_queue_head_(0),
-      event_queue_tail_(0),
-      event_queue_count_(0) {
+      event_stream_(nullptr) {
     
-    memset(prev_musical_states_, 0, sizeof(prev_musical_states_));
-    memset(prev_system_states_, 0, sizeof(prev_system_states_));
-    memset(event_queue_, 0, sizeof(event_queue_));
+    memset(hold_reported_, 0, sizeof(hold_reported_));
 }
 
 ButtonInputHandler::~ButtonInputHandler() {
     digital_manager_ = nullptr;
 }
 
-void ButtonInputHandler::Init(::DigitalManager* digital_manager) {
+void ButtonInputHandler::Init(::DigitalManager* digital_manager, InputEventStream* event_stream) {
     digital_manager_ = digital_manager;
+    event_stream_ = event_stream;
     input_mode_ = InputMode::MIDI_NOTES;
     hold_threshold_ms_ = 500;
     
     // Reset state
-    memset(prev_musical_states_, 0, sizeof(prev_musical_states_));
-    memset(prev_system_states_, 0, sizeof(prev_system_states_));
-    event_queue_head_ = 0;
-    event_queue_tail_ = 0;
-    event_queue_count_ = 0;
+    memset(hold_reported_, 0, sizeof(hold_reported_));
 }
 
 void ButtonInputHandler::Update() {
     if (!digital_manager_) return;
     
-    // Process musical buttons and system buttons
-    ProcessMusicalButtons();
-    ProcessSystemButtons();
+    // Edges were detected once, at scan time - just publish them
+    PublishKeyEdges();
+    PublishHoldEvents();
 }
 
-void ButtonInputHandler::ProcessMusicalButtons() {
-    if (!digital_manager_) return;
-    
-    for (int i = 0; i < static_cast<int>(MusicalButton::COUNT); i++) {
-        MusicalButton button = static_cast<MusicalButton>(i);
-        int row, col;
-        MusicalButtonToRowCol(button, row, col);
-        
-        bool current_pressed = digital_manager_->IsKeyPressed(row, col);
-        bool was_pressed = digital_manager_->WasKeyPressed(row, col);
-        bool prev_pressed = prev_musical_states_[i];
-        
-        // Detect press event
-        if (was_pressed || (!prev_pressed && current_pressed)) {
-            ButtonEvent event;
-            event.type = ButtonEventType::PRESSED;
-            event.timestamp = 0; // TODO: Get actual timestamp if needed
-            event.musical_button = button;
-            event.is_musical = true;
-            QueueEvent(event);
-        }
-        
-        // Detect release event
-        if (prev_pressed && !current_pressed) {
-            ButtonEvent event;
-            event.type = ButtonEventType::RELEASED;
-            event.timestamp = 0;
-            event.musical_button = button;
-            event.is_musical = true;
-            QueueEvent(event);
-        }
+void ButtonInputHandler::PublishKeyEdges() {
+    for (size_t i = 0; i < digital_manager_->GetKeyEdgeCount(); i++) {
+        const KeyEvent& edge = digital_manager_->GetKeyEdge(i);
+        int key = RowColToKeyIndex(edge.row, edge.col);
+        if (key < 0) continue;
         
-        // Detect hold event (after threshold)
-        if (current_pressed) {
-            uint32_t hold_time = digital_manager_->GetKeyHoldTime(row, col);
-            if (hold_time > hold_threshold_ms_ && !prev_musical_states_[i]) {
-                // Only trigger once when threshold is crossed
-                ButtonEvent event;
-                event.type = ButtonEventType::HELD;
-                event.timestamp = 0;
-                event.musical_button = button;
-                event.is_musical = true;
-                QueueEvent(event);
-            }
+        if (!edge.pressed) {
+            hold_reported_[key] = false;
         }
+        if (!event_stream_) continue;
         
-        prev_musical_states_[i] = current_pressed;
+        InputEvent event;
+        event.timestamp_us = edge.timestamp_us;
+        event.type = edge.pressed ? InputEventType::KEY_DOWN : InputEventType::KEY_UP;
+        event.id = static_cast<uint8_t>(key);
+        event.value = 0;
+        event_stream_->Push(event);
     }
 }
 
-void ButtonInputHandler::ProcessSystemButtons() {
-    if (!digital_manager_) return;
-    
-    for (int i = 0; i < static_cast<int>(SystemButton::COUNT); i++) {
-        SystemButton button = static_cast<SystemButton>(i);
-        int row, col;
-        SystemButtonToRowCol(button, row, col);
-        
-        bool current_pressed = digital_manager_->IsKeyPressed(row, col);
-        bool was_pressed = digital_manager_->WasKeyPressed(row, col);
-        bool prev_pressed = prev_system_states_[i];
-        
-        // Detect press event
-        if (was_pressed || (!prev_pressed && current_pressed)) {
-            ButtonEvent event;
-            event.type = ButtonEventType::PRESSED;
-            event.timestamp = 0;
-            event.system_button = button;
-            event.is_musical = false;
-            QueueEvent(event);
-        }
-        
-        // Detect release event
-        if (prev_pressed && !current_pressed) {
-            ButtonEvent event;
-            event.type = ButtonEventType::RELEASED;
-            event.timestamp = 0;
-            event.system_button = button;
-            event.is_musical = false;
-            QueueEvent(event);
-        }
-        
-        // Detect hold event (after threshold)
-        if (current_pressed) {
-            uint32_t hold_time = digital_manager_->GetKeyHoldTime(row, col);
-            if (hold_time > hold_threshold_ms_ && !prev_system_states_[i]) {
-                ButtonEvent event;
-                event.type = ButtonEventType::HELD;
-                event.timestamp = 0;
-                event.system_button = button;
-                event.is_musical = false;
-                QueueEvent(event);
+void ButtonInputHandler::PublishHoldEvents() {
+    // One KEY_HELD per press, when the hold threshold is crossed
+    for (int row = 0; row < KEY_MATRIX_ROWS; row++) {
+        for (int col = 0; col < KEY_MATRIX_COLS; col++) {
+            int key = RowColToKeyIndex(row, col);
+            if (key < 0 || hold_reported_[key]) continue;
+            if (!digital_manager_->IsKeyPressed(row, col)) continue;
+            if (digital_manager_->GetKeyHoldTime(row, col) <= hold_threshold_ms_) continue;
+            
+            hold_reported_[key] = true;
+            if (event_stream_) {
+                event_stream_->Push(InputEventType::KEY_HELD, static_cast<uint8_t>(key), 0);
             }
         }
-        
-        prev_system_states_[i] = current_pressed;
     }
 }
 
-void ButtonInputHandler::QueueEvent(const ButtonEvent& event) {
-    if (event_queue_count_ >= MAX_EVENTS) {
-        // Queue full, drop oldest event (simple FIFO)
-        event_queue_head_ = (event_queue_head_ + 1) % MAX_EVENTS;
-        event_queue_count_--;
-    }
-    
-    event_queue_[event_queue_tail_] = event;
-    event_queue_tail_ = (event_queue_tail_ + 1) % MAX_EVENTS;
-    event_queue_count_++;
-}
-
-bool ButtonInputHandler::PollEvent(ButtonEvent& event) {
-    if (event_queue_count_ == 0) {
-        return false;
-    }
-    
-    event = event_queue_[event_queue_head_];
-    event_queue_head_ = (event_queue_head_ + 1) % MAX_EVENTS;
-    event_queue_count_--;
-    return true;
+int ButtonInputHandler::RowColToKeyIndex(int row, int col) {
+    // Inverse of MusicalButtonToRowCol / SystemButtonToRowCol
+    if (col < 0 || col >= KEY_MATRIX_COLS) return -1;
+    if (row == 0) return col;                                     // White keys
+    if (row == 1) return col < 3 ? 4 + col : -1;                  // Black keys (no R1C3)
+    if (row == 2) return InputEvent::SYSTEM_KEY_BASE + col;       // System buttons
+    return -1;
 }
 
 void ButtonInputHandler::MusicalButtonToRowCol(MusicalButton button, int& row, int& col) const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "digital_manager.h"
+#include "input_event_stream.h"
 #include <cstdint>
 
 namespace OpenChord {
@@ -55,29 +56,12 @@ enum class InputMode {
     // SEQUENCER,      // Step sequencer
 };
 
-// Button event types
-enum class ButtonEventType {
-    PRESSED,           // Button was just pressed
-    RELEASED,          // Button was just released
-    HELD,              // Button is being held (after hold threshold)
-};
-
-// Button event structure
-struct ButtonEvent {
-    ButtonEventType type;
-    uint32_t timestamp;
-    union {
-        MusicalButton musical_button;
-        SystemButton system_button;
-    };
-    bool is_musical;  // true if musical button, false if system button
-};
-
 /**
  * Button Input Handler
  * 
  * Provides high-level access to button inputs with mode support and
- * semantic button naming. Designed for extensibility and future features.
+ * semantic button naming. Key edges from the scanner are published to the
+ * InputEventStream as KEY_DOWN / KEY_UP / KEY_HELD (see InputEvent key index).
  */
 class ButtonInputHandler {
 public:
@@ -85,7 +69,7 @@ public:
     ~ButtonInputHandler();
     
     // Initialization
-    void Init(::DigitalManager* digital_manager);
+    void Init(::DigitalManager* digital_manager, InputEventStream* event_stream = nullptr);
     void Update();
     
     // Mode management
@@ -108,12 +92,8 @@ public:
     bool IsRawButtonPressed(int row, int col) const;
     bool WasRawButtonPressed(int row, int col) const;
     
-    // Event polling (for future callback/event system)
-    // Returns true if an event occurred, fills in the event structure
-    bool PollEvent(ButtonEvent& event);
-    
-    // Check if there are pending events (for power management)
-    bool HasPendingEvents() const { return event_queue_count_ > 0; }
+    // Key index used in InputEvent (-1 if the position has no button)
+    static int RowColToKeyIndex(int row, int col);
     
     // Configuration
     void SetHoldThreshold(uint32_t ms);
@@ -124,25 +104,19 @@ private:
     InputMode input_mode_;
     uint32_t hold_threshold_ms_;
     
-    // Event queue (simple for now, can be expanded later)
-    static constexpr int MAX_EVENTS = 16;
-    ButtonEvent event_queue_[MAX_EVENTS];
-    int event_queue_head_;
-    int event_queue_tail_;
-    int event_queue_count_;
+    InputEventStream* event_stream_;
     
     // Helper methods
-    void ProcessMusicalButtons();
-    void ProcessSystemButtons();
-    void QueueEvent(const ButtonEvent& event);
+    void PublishKeyEdges();
+    void PublishHoldEvents();
     
     // Convert semantic button IDs to row/col
     void MusicalButtonToRowCol(MusicalButton button, int& row, int& col) const;
     void SystemButtonToRowCol(SystemButton button, int& row, int& col) const;
     
-    // Track previous states for edge detection
-    bool prev_musical_states_[static_cast<int>(MusicalButton::COUNT)];
-    bool prev_system_states_[static_cast<int>(SystemButton::COUNT)];
+    // KEY_HELD sent for the current press (indexed by key index)
+    static constexpr int KEY_COUNT = static_cast<int>(MusicalButton::COUNT) + static_cast<int>(SystemButton::COUNT);
+    bool hold_reported_[KEY_COUNT];
 };
 
 } // namespace OpenChord
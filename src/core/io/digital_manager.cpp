@@ -2,11 +2,12 @@
 #include <cstring>
 
 DigitalManager::DigitalManager() 
-    : hw_(nullptr), debounce_time_ms_(10), hold_threshold_ms_(500), healthy_(true) {
+    : hw_(nullptr), key_scan_timer_running_(false), idle_monitor_(nullptr), key_edge_count_(0), debounce_time_ms_(10), hold_threshold_ms_(500), healthy_(true) {
     
     // Initialize key matrix state
     memset(&key_matrix_, 0, sizeof(key_matrix_));
     key_matrix_.matrix_healthy = true;
+    memset(key_edges_, 0, sizeof(key_edges_));
     
     // Initialize encoder state
     memset(&encoder_state_, 0, sizeof(encoder_state_));
@@ -59,14 +60,29 @@ void DigitalManager::Init(daisy::DaisySeed* hw) {
     joystick_button_pin_ = daisy::seed::D0;  // Pin 1 - Joystick button (was D14, moved for display)
     // audio_switch_pin_ = daisy::seed::D15;    // Pin 15 - Audio switch (disabled, pin used for display RST)
     
-    // Initialize GPIO objects
-    for (int i = 0; i < KEY_MATRIX_ROWS; i++) {
-        key_matrix_rows_[i].Init(key_matrix_row_pins_[i], daisy::GPIO::Mode::OUTPUT, daisy::GPIO::Pull::NOPULL);
-        key_matrix_rows_[i].Write(true); // Start with all rows HIGH (inactive)
+    // Initialize key matrix GPIO and scanner
+    // Row 1, Col 3 is not connected (11 keys in a 3x4 matrix)
+    key_matrix_gpio_.Init(key_matrix_row_pins_, key_matrix_col_pins_);
+    uint64_t valid_keys = 0;
+    for (int row = 0; row < KEY_MATRIX_ROWS; row++) {
+        for (int col = 0; col < KEY_MATRIX_COLS; col++) {
+            if (IsValidKeyPosition(row, col)) {
+                valid_keys |= 1ull << (row * KeyMatrixScanner::MAX_COLS + col);
+            }
+        }
     }
-    
-    for (int i = 0; i < KEY_MATRIX_COLS; i++) {
-        key_matrix_cols_[i].Init(key_matrix_col_pins_[i], daisy::GPIO::Mode::INPUT, daisy::GPIO::Pull::PULLUP);
+    key_scanner_.Init(&key_matrix_gpio_, KEY_MATRIX_ROWS, KEY_MATRIX_COLS, &valid_keys);
+    SetKeyMatrixDebounceTime(debounce_time_ms_);
+    
+    // Scan from a timer interrupt so key latency doesn't depend on the main loop
+    daisy::TimerHandle::Config timer_config;
+    timer_config.periph = daisy::TimerHandle::Config::Peripheral::TIM_5;
+    timer_config.dir = daisy::TimerHandle::Config::CounterDir::UP;
+    timer_config.enable_irq = true;
+    timer_config.period = daisy::System::GetPClk1Freq() * 2 / KEY_SCAN_TICK_HZ;  // APB1 timer clock = 2x PCLK1
+    if (key_scan_timer_.Init(timer_config) == daisy::TimerHandle::Result::OK) {
+        key_scan_timer_.SetCallback(KeyScanTimerCallback, this);
+        key_scan_timer_running_ = (key_scan_timer_.Start() == daisy::TimerHandle::Result::OK);
     }
     
     // Initialize encoder (a, b, click, update_rate)
@@ -98,6 +114,11 @@ void DigitalManager::Update() {
 void DigitalManager::Shutdown() {
     if (!hw_) return;
     
+    if (key_scan_timer_running_) {
+        key_scan_timer_.Stop();
+        key_scan_timer_running_ = false;
+    }
+    
     // Shutdown all GPIO operations
     healthy_ = false;
     hw_ = nullptr;
@@ -161,6 +182,11 @@ void DigitalManager::ResetEncoder(int value) {
 
 void DigitalManager::SetKeyMatrixDebounceTime(uint32_t ms) {
     debounce_time_ms_ = ms;
+    
+    // Scanner debounces in full matrix scans
+    uint32_t scan_period_us = 1000000 / KEY_SCAN_TICK_HZ * KEY_MATRIX_ROWS;
+    uint32_t samples = (ms * 1000 + scan_period_us - 1) / scan_period_us;
+    key_scanner_.SetDebounceSamples(static_cast<uint8_t>(samples > 255 ? 255 : samples));
 }
 
 void DigitalManager::SetButtonHoldThreshold(uint32_t ms) {
@@ -173,82 +199,105 @@ uint32_t DigitalManager::GetCurrentTime() const {
 }
 
 // Private methods
-// Simple microsecond delay using busy-wait loop
-// Daisy Seed runs at 480MHz, so we need approximately 480 cycles per microsecond
-// This is a simple approximation - adjust multiplier if needed for accuracy
-static inline void delay_us(uint32_t us) {
-    // Each iteration is roughly 3-4 cycles, so ~120 iterations per microsecond at 480MHz
-    // Using volatile to prevent compiler optimization
-    volatile uint32_t count = us * 120;
-    while (count--) {
-        __asm__("nop"); // No operation instruction
+void DaisyKeyMatrixGpio::Init(const daisy::Pin* row_pins, const daisy::Pin* col_pins) {
+    for (int i = 0; i < KEY_MATRIX_ROWS; i++) {
+        rows_[i].Init(row_pins[i], daisy::GPIO::Mode::OUTPUT, daisy::GPIO::Pull::NOPULL);
+        rows_[i].Write(true); // Start with all rows HIGH (inactive)
+    }
+    
+    for (int i = 0; i < KEY_MATRIX_COLS; i++) {
+        cols_[i].Init(col_pins[i], daisy::GPIO::Mode::INPUT, daisy::GPIO::Pull::PULLUP);
+    }
+}
+
+void DaisyKeyMatrixGpio::SetRowActive(int row, bool active) {
+    if (row < 0 || row >= KEY_MATRIX_ROWS) return;
+    rows_[row].Write(!active); // LOW = active
+}
+
+uint32_t DaisyKeyMatrixGpio::ReadColumns() {
+    // Column has pullup, so LOW = key pressed (active row connects through diode)
+    uint32_t columns = 0;
+    for (int col = 0; col < KEY_MATRIX_COLS; col++) {
+        if (!cols_[col].Read()) {
+            columns |= (1u << col);
+        }
+    }
+    return columns;
+}
+
+void DigitalManager::KeyScanTimerCallback(void* data) {
+    // Timer interrupt: one row per tick, row settles until the next tick
+    DigitalManager* manager = static_cast<DigitalManager*>(data);
+    if (!manager) return;
+    size_t queued = manager->key_scanner_.GetQueuedCount();
+    manager->key_scanner_.Tick(daisy::System::GetUs());
+    
+    OpenChord::IdleMonitor* monitor = manager->idle_monitor_;
+    if (monitor) {
+        if (manager->key_scanner_.GetQueuedCount() > queued) {
+            monitor->RequestWork(OpenChord::IdleMonitor::WAKE_KEY_SCAN);
+        } else {
+            monitor->NotifyWake(OpenChord::IdleMonitor::WAKE_KEY_SCAN);
+        }
     }
 }
 
 void DigitalManager::UpdateKeyMatrix() {
     if (!hw_) return;
     
-    // Keyboard matrix scanning with diodes:
-    // - Rows are outputs (driven LOW when active)
-    // - Columns are inputs with pullups (read HIGH when no key, LOW when key pressed)
-    // - Diodes prevent ghosting (allow current flow from column to row)
-    //   Diode orientation: Anode → Column, Cathode → Row
-    // - Scan one row at a time, read all columns
+    // Without the timer, advance the scanner from here (still one row per call, no waiting)
+    if (!key_scan_timer_running_) {
+        key_scanner_.Tick(daisy::System::GetUs());
+    }
     
-    // Set all rows HIGH (inactive) first - ensures clean state before scanning
+    // Clear was_pressed so it's only true for ONE update after a press
     for (int row = 0; row < KEY_MATRIX_ROWS; row++) {
-        key_matrix_rows_[row].Write(true); // HIGH = inactive
+        for (int col = 0; col < KEY_MATRIX_COLS; col++) {
+            key_matrix_.keys[row][col].was_pressed = false;
+        }
+    }
+    
+    // Apply debounced edges in order (a press and release within one update keep was_pressed).
+    // Edges carry the scan tick's GetUs(), press times are on GetNow() like hold times.
+    const uint32_t now_us = daisy::System::GetUs();
+    const uint32_t now_ms = daisy::System::GetNow();
+    key_edge_count_ = 0;
+    KeyEvent event;
+    while (key_edge_count_ < KeyMatrixScanner::QUEUE_CAPACITY && key_scanner_.PopEvent(&event)) {
+        if (!IsValidKeyPosition(event.row, event.col)) continue;
+        key_edges_[key_edge_count_++] = event;
+        ButtonState& key = key_matrix_.keys[event.row][event.col];
+        uint32_t event_ms = KeyMatrixScanner::EdgeTimeMs(event, now_us, now_ms);
+        if (event.pressed) {
+            key.pressed = true;
+            key.was_pressed = true;
+            key.hold_time = 0;
+            key.last_press_time = event_ms;
+        } else {
+            key.pressed = false;
+            key.hold_time = 0;
+            key.last_release_time = event_ms;
+        }
     }
     
-    // Small delay to ensure all rows are fully deactivated before scanning
-    // This prevents cross-talk between rows
-    delay_us(10); // 10 microseconds for signal stabilization
+    UpdateKeyHoldTimes();
     
-    // Scan each row
-    // Matrix layout (physical):
-    // - Row 0 (bottom): 4 columns (0-3) - all valid, (0,0)=bottom-left, (0,3)=bottom-right
-    // - Row 1 (middle): 3 columns (0-2) - column 3 is NOT connected to this row, (1,0)=middle-left, (1,2)=middle-right
-    // - Row 2 (top): 4 columns (0-3) - all valid, (2,0)=top-left, (2,3)=top-right
-    // Column 3 is only connected to switches from R0 and R2, not R1
+    key_matrix_.scan_count = key_scanner_.GetScanCount();
+    key_matrix_.last_scan_time = hw_->system.GetNow();
+}
+
+void DigitalManager::UpdateKeyHoldTimes() {
+    // Hold time in ms since the press edge
+    uint32_t now = hw_->system.GetNow();
     for (int row = 0; row < KEY_MATRIX_ROWS; row++) {
-        // Activate current row (set LOW)
-        key_matrix_rows_[row].Write(false); // LOW = active
-        
-        // Critical: Wait for signal to stabilize after activating row
-        // This ensures the column inputs have time to settle to correct state
-        // Without this delay, we may read columns before they've fully responded to the row activation
-        // This is especially important to prevent cross-talk between rows
-        delay_us(5); // 5 microseconds for row activation to stabilize
-        
-        // Read all columns for this row
-        // Only process valid key positions to avoid false readings
         for (int col = 0; col < KEY_MATRIX_COLS; col++) {
-            // Only read and update state for valid key positions
-            // This prevents reading invalid positions (like R1C3) which could cause issues
-            if (IsValidKeyPosition(row, col)) {
-                // Column has pullup, so:
-                // - HIGH = no key pressed (no connection to LOW row)
-                // - LOW = key pressed (LOW row connects through diode to column)
-                // Diodes prevent ghosting: current can only flow from column to row
-                bool raw_read = key_matrix_cols_[col].Read();
-                bool current_pressed = !raw_read; // Inverted due to pullup
-                
-                // Update button state with debouncing
-                UpdateButtonState(key_matrix_.keys[row][col], current_pressed);
+            ButtonState& key = key_matrix_.keys[row][col];
+            if (key.pressed) {
+                key.hold_time = now - key.last_press_time;
             }
         }
-        
-        // Deactivate row (set HIGH) before moving to next row
-        key_matrix_rows_[row].Write(true); // HIGH = inactive
-        
-        // Small delay after deactivating to ensure clean transition
-        // This prevents the next row scan from picking up residual signals from this row
-        // This is critical to prevent cross-talk, especially between R1 and R2
-        delay_us(5); // 5 microseconds for row deactivation to complete
     }
-    
-    key_matrix_.scan_count++;
-    key_matrix_.last_scan_time = hw_->system.GetNow();
 }
 
 void DigitalManager::UpdateEncoder() {
@@ -291,11 +340,6 @@ void DigitalManager::UpdateLEDs() {
     // For now, just keep the internal state
 }
 
-void DigitalManager::ScanKeyMatrix() {
-    // Matrix scanning is handled in UpdateKeyMatrix()
-    // This method is kept for future expansion
-}
-
 bool DigitalManager::IsValidKeyPosition(int row, int col) const {
     // Check bounds
     if (row < 0 || row >= KEY_MATRIX_ROWS || col < 0 || col >= KEY_MATRIX_COLS) {
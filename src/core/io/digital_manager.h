@@ -1,6 +1,8 @@
 #pragma once
 
 #include "daisy_seed.h"
+#include "key_matrix_scanner.h"
+#include "idle_monitor.h"
 #include <cstdint>
 
 // Key matrix dimensions
@@ -36,6 +38,21 @@ struct EncoderState {
     uint32_t button_hold_time;
 };
 
+/**
+ * Key matrix GPIO backend on the Daisy pins
+ * Rows are active LOW, columns have pullups (LOW = pressed through the diode)
+ */
+class DaisyKeyMatrixGpio : public IKeyMatrixGpio {
+public:
+    void Init(const daisy::Pin* row_pins, const daisy::Pin* col_pins);
+    void SetRowActive(int row, bool active) override;
+    uint32_t ReadColumns() override;
+
+private:
+    daisy::GPIO rows_[KEY_MATRIX_ROWS];
+    daisy::GPIO cols_[KEY_MATRIX_COLS];
+};
+
 /**
  * Digital Manager - Handles all digital inputs and outputs
  * 
@@ -45,6 +62,9 @@ struct EncoderState {
  * - Joystick Button
  * - Audio Input Switch
  * - Status LEDs (if implemented)
+ * 
+ * The key matrix is scanned by a timer interrupt (one row per tick, see
+ * KeyMatrixScanner). Update() applies the queued key edges to KeyMatrixState.
  */
 class DigitalManager {
 public:
@@ -65,6 +85,15 @@ public:
     bool IsKeyHeld(int row, int col) const;
     uint32_t GetKeyHoldTime(int row, int col) const;
     const KeyMatrixState& GetKeyMatrix() const;
+    const KeyMatrixScanner& GetKeyScanner() const { return key_scanner_; }
+    
+    // Key edges applied by the last Update(), oldest first (timestamps from the scan tick)
+    size_t GetKeyEdgeCount() const { return key_edge_count_; }
+    const KeyEvent& GetKeyEdge(size_t index) const { return key_edges_[index < key_edge_count_ ? index : 0]; }
+    bool IsKeyScanTimerRunning() const { return key_scan_timer_running_; }
+    
+    // Scan ticks report wakes here; new key edges end the main loop idle
+    void SetIdleMonitor(OpenChord::IdleMonitor* monitor) { idle_monitor_ = monitor; }
     
     // Encoder
     int GetEncoderValue() const { return encoder_state_.value; }
@@ -108,9 +137,17 @@ private:
     daisy::Pin audio_switch_pin_;
     daisy::Pin led_pins_[4]; // 4 status LEDs if implemented
     
+    // Key matrix scanning (timer interrupt -> lock-free edge queue)
+    static constexpr uint32_t KEY_SCAN_TICK_HZ = 4000;  // 3 rows -> full scan every 750us
+    DaisyKeyMatrixGpio key_matrix_gpio_;
+    KeyMatrixScanner key_scanner_;
+    daisy::TimerHandle key_scan_timer_;
+    bool key_scan_timer_running_;
+    OpenChord::IdleMonitor* idle_monitor_;
+    KeyEvent key_edges_[KeyMatrixScanner::QUEUE_CAPACITY];
+    size_t key_edge_count_;
+    
     // GPIO objects
-    daisy::GPIO key_matrix_rows_[KEY_MATRIX_ROWS];
-    daisy::GPIO key_matrix_cols_[KEY_MATRIX_COLS];
     daisy::GPIO joystick_button_gpio_;
     daisy::GPIO audio_switch_gpio_;
     daisy::GPIO led_gpios_[4];
@@ -133,10 +170,11 @@ private:
     
     // Internal methods
     void UpdateKeyMatrix();
+    void UpdateKeyHoldTimes();
+    static void KeyScanTimerCallback(void* data);
     void UpdateEncoder();
     void UpdateButtons();
     void UpdateLEDs();
-    void ScanKeyMatrix();
     bool IsValidKeyPosition(int row, int col) const;
     void UpdateButtonState(ButtonState& button, bool current_pressed);
 };
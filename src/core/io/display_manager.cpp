@@ -1,4 +1,9 @@
 #include "display_manager.h"
+#include <cstring>
+
+// Column-packed copies of the UI fonts (built at init from the libDaisy fonts)
+static uint32_t font_6x8_columns[PackedFont::GLYPH_COUNT * 6];
+static uint32_t font_11x18_columns[PackedFont::GLYPH_COUNT * 11];
 
 DisplayManager::DisplayManager() : hw_(nullptr), healthy_(false) {
 }
@@ -17,7 +22,10 @@ void DisplayManager::Init(daisy::DaisySeed* hw) {
 }
 
 void DisplayManager::Update() {
-    // No-op - display updates happen after drawing operations via Update() calls
+    // Display updates happen after drawing operations via Update() calls;
+    // here we only send a frame that arrived while the bus was busy
+    if (!hw_ || !healthy_) return;
+    transfer_.SubmitPending();
 }
 
 void DisplayManager::Shutdown() {
@@ -30,7 +38,7 @@ void DisplayManager::InitDisplay() {
     
     // Configuration matching official Daisy Seed example exactly
     // Only difference: pin assignments for our hardware
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>::Config display_cfg;
+    OledDisplayType::Config display_cfg;
     
     // SPI Configuration (matching official example)
     display_cfg.driver_config.transport_config.spi_config.periph
@@ -54,14 +62,53 @@ void DisplayManager::InitDisplay() {
     display_cfg.driver_config.transport_config.pin_config.reset
         = daisy::seed::D14;  // Pin 15 = Reset
     
+    // Background transfer of changed bytes (falls back to blocking full updates)
+    display_cfg.driver_config.transfer = &transfer_;
+    display_cfg.driver_config.blitter = &blitter_;
+    
     // Initialize display (driver handles reset sequence automatically)
     display_.Init(display_cfg);
     
+    // A font whose size doesn't match its storage stays unpacked (pixel path)
+    font_6x8_.Init(Font_6x8.data, Font_6x8.FontWidth, Font_6x8.FontHeight,
+                   font_6x8_columns, sizeof(font_6x8_columns) / sizeof(font_6x8_columns[0]));
+    font_11x18_.Init(Font_11x18.data, Font_11x18.FontWidth, Font_11x18.FontHeight,
+                     font_11x18_columns, sizeof(font_11x18_columns) / sizeof(font_11x18_columns[0]));
+    
     // Clear display and update (matching official example)
     display_.Fill(false);
     display_.Update();
 }
 
+const PackedFont* DisplayManager::GetPackedFont(const FontDef& font) const {
+    if (font_6x8_.IsReady() && font.data == font_6x8_.GetSourceRows()) return &font_6x8_;
+    if (font_11x18_.IsReady() && font.data == font_11x18_.GetSourceRows()) return &font_11x18_;
+    return nullptr;
+}
+
+int DisplayManager::DrawText(int x, int y, const char* text, const FontDef& font, bool on) {
+    if (!hw_ || !healthy_ || !text) return x;
+    
+    const PackedFont* packed = GetPackedFont(font);
+    if (packed && blitter_.IsReady()) {
+        return blitter_.DrawString(x, y, text, *packed, on);
+    }
+    
+    display_.SetCursor(x, y);
+    display_.WriteString(text, font, on);
+    return x + static_cast<int>(strlen(text)) * font.FontWidth;
+}
+
+void DisplayManager::FillRect(int x0, int y0, int x1, int y1, bool on) {
+    if (!hw_ || !healthy_) return;
+    
+    if (blitter_.IsReady()) {
+        blitter_.FillRect(x0, y0, x1, y1, on);
+        return;
+    }
+    display_.DrawRect(x0, y0, x1, y1, on, true);
+}
+
 void DisplayManager::Clear() {
     if (!hw_ || !healthy_) return;
     
@@ -2,13 +2,22 @@
 
 #include "daisy_seed.h"
 #include "dev/oled_ssd130x.h"
+#include "oled_page_driver.h"
+#include "oled_transfer.h"
 #include <cstdint>
 
+// Daisy's OledDisplay on the dirty-page SSD130x driver (changed bytes only, sent by DMA)
+typedef daisy::OledDisplay<OledPageDriver> OledDisplayType;
+
 /**
  * Display Manager - Simple wrapper for Daisy's OLED display driver
  * 
- * Uses Daisy's built-in OledDisplay with SSD130x4WireSpi128x64Driver
- * Follows official Daisy Seed example pattern exactly
+ * Uses Daisy's built-in OledDisplay with an SSD130x 128x64 SPI driver
+ * Follows official Daisy Seed example pattern, except that Update() only
+ * transmits the pages/columns that changed since the last frame, and does
+ * so by SPI DMA in the background (double-buffered, see OledTransfer).
+ * DrawText()/FillRect() write straight into the framebuffer's page format
+ * (see PageBlitter), falling back to OledDisplay's pixel drawing.
  */
 class DisplayManager {
 public:
@@ -17,7 +26,7 @@ public:
     
     // Core lifecycle
     void Init(daisy::DaisySeed* hw);
-    void Update();  // Called periodically (no-op, updates happen after drawing)
+    void Update();  // Called periodically - sends a frame left pending by a busy transfer
     void Shutdown();
     
     // Health check
@@ -31,14 +40,39 @@ public:
     void PrintText(uint8_t x, uint8_t y, const char* text);
     void SetCursor(uint8_t x, uint8_t y);
     
+    // Fast drawing into the current frame (no Update()). DrawText behaves
+    // like SetCursor + WriteString and returns the x after the text.
+    int DrawText(int x, int y, const char* text, const FontDef& font, bool on);
+    void FillRect(int x0, int y0, int x1, int y1, bool on);
+    
+    // Page-format blitter on the framebuffer, and the packed copy of a font
+    // (nullptr if not available - use the OledDisplay calls instead)
+    PageBlitter* GetBlitter() { return healthy_ && blitter_.IsReady() ? &blitter_ : nullptr; }
+    const PackedFont* GetPackedFont(const FontDef& font) const;
+    
     // Direct access to display for advanced operations
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>* GetDisplay() {
+    OledDisplayType* GetDisplay() {
         return healthy_ ? &display_ : nullptr;
     }
     
+    // Bytes sent per frame (data + address commands)
+    const FrameDiff& GetUpdateStats() const { return transfer_.GetFrameDiff(); }
+    
+    // True while the previous frame is still going out or waiting to go
+    // out from the framebuffer (don't start drawing a new frame yet)
+    bool IsTransferBusy() const { return transfer_.IsBusy() || transfer_.HasPending(); }
+    const OledTransfer& GetTransfer() const { return transfer_; }
+    
+    // Send the whole frame on the next update (e.g. after display glitches)
+    void ForceFullUpdate() { transfer_.Invalidate(); }
+    
 private:
     daisy::DaisySeed* hw_;
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver> display_;
+    OledDisplayType display_;
+    OledTransfer transfer_;
+    PageBlitter blitter_;
+    PackedFont font_6x8_;
+    PackedFont font_11x18_;
     bool healthy_;
     
     void InitDisplay();
@@ -13,21 +13,19 @@ EncoderInputHandler::EncoderInputHandler()
       prev_value_(0),
       current_delta_(0.0f),
       current_direction_(EncoderDirection::NONE),
-      event_queue_head_(0),
-      event_queue_tail_(0),
-      event_queue_count_(0),
+      event_stream_(nullptr),
+      button_prev_pressed_(false),
       rotation_steps_(0),
       last_rotation_time_(0) {
-    
-    memset(event_queue_, 0, sizeof(event_queue_));
 }
 
 EncoderInputHandler::~EncoderInputHandler() {
     digital_manager_ = nullptr;
 }
 
-void EncoderInputHandler::Init(::DigitalManager* digital_manager) {
+void EncoderInputHandler::Init(::DigitalManager* digital_manager, InputEventStream* event_stream) {
     digital_manager_ = digital_manager;
+    event_stream_ = event_stream;
     mode_ = EncoderMode::NAVIGATION;
     acceleration_enabled_ = true;
     acceleration_threshold_ = 3;
@@ -37,9 +35,7 @@ void EncoderInputHandler::Init(::DigitalManager* digital_manager) {
     current_delta_ = 0.0f;
     current_direction_ = EncoderDirection::NONE;
     
-    event_queue_head_ = 0;
-    event_queue_tail_ = 0;
-    event_queue_count_ = 0;
+    button_prev_pressed_ = false;
     
     rotation_steps_ = 0;
     last_rotation_time_ = 0;
@@ -132,13 +128,10 @@ void EncoderInputHandler::ProcessEncoder() {
         
         current_value_ = raw_value;
         
-        // Queue rotation event
-        EncoderEvent event;
-        event.type = EncoderEventType::ROTATED;
-        event.delta = delta;
-        event.value = current_value_;
-        event.timestamp = current_time;
-        QueueEvent(event);
+        // Publish rotation (raw detent delta, acceleration is left to consumers)
+        if (event_stream_) {
+            event_stream_->Push(InputEventType::ENCODER_STEP, 0, static_cast<int16_t>(delta));
+        }
         
         prev_value_ = current_value_;
     } else {
@@ -157,69 +150,20 @@ void EncoderInputHandler::ProcessEncoder() {
 void EncoderInputHandler::ProcessButton() {
     if (!digital_manager_) return;
     
-    // Check for button press (when implemented)
-    // For now, encoder button is not connected, so this is a placeholder
+    // Encoder button is not connected yet, so this rarely fires
     bool current_pressed = digital_manager_->IsEncoderButtonPressed();
     bool was_pressed = digital_manager_->WasEncoderButtonPressed();
-    static bool prev_pressed = false;
-    
-    // Detect press event
-    if (was_pressed || (!prev_pressed && current_pressed)) {
-        EncoderEvent event;
-        event.type = EncoderEventType::BUTTON_PRESSED;
-        event.delta = 0;
-        event.value = current_value_;
-        event.timestamp = 0;
-        QueueEvent(event);
-    }
     
-    // Detect release event
-    if (prev_pressed && !current_pressed) {
-        EncoderEvent event;
-        event.type = EncoderEventType::BUTTON_RELEASED;
-        event.delta = 0;
-        event.value = current_value_;
-        event.timestamp = 0;
-        QueueEvent(event);
-    }
-    
-    // Detect hold event
-    if (current_pressed) {
-        uint32_t hold_time = digital_manager_->GetEncoderButtonHoldTime();
-        if (hold_time > 500 && !prev_pressed) { // 500ms threshold
-            EncoderEvent event;
-            event.type = EncoderEventType::BUTTON_HELD;
-            event.delta = 0;
-            event.value = current_value_;
-            event.timestamp = 0;
-            QueueEvent(event);
+    if (event_stream_) {
+        if (was_pressed || (!button_prev_pressed_ && current_pressed)) {
+            event_stream_->Push(InputEventType::ENCODER_BUTTON, 0, 1);
+        }
+        if (button_prev_pressed_ && !current_pressed) {
+            event_stream_->Push(InputEventType::ENCODER_BUTTON, 0, 0);
         }
     }
     
-    prev_pressed = current_pressed;
-}
-
-void EncoderInputHandler::QueueEvent(const EncoderEvent& event) {
-    if (event_queue_count_ >= MAX_EVENTS) {
-        // Queue full, drop oldest event
-        event_queue_head_ = (event_queue_head_ + 1) % MAX_EVENTS;
-        event_queue_count_--;
-    }
-    
-    event_queue_[event_queue_tail_] = event;
-    event_queue_tail_ = (event_queue_tail_ + 1) % MAX_EVENTS;
-    event_queue_count_++;
-}
-
-bool EncoderInputHandler::PollEvent(EncoderEvent& event) {
-    if (event_queue_count_ == 0) {
-        return false;
-    }
-    
-    event = event_queue_[event_queue_head_];
-    event_queue_head_ = (event_queue_head_ + 1) % MAX_EVENTS;
-    event_queue_count_--;
-    return true;
+    button_prev_pressed_ = current_pressed;
 }
 
 int EncoderInputHandler::GetValue() const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "digital_manager.h"
+#include "input_event_stream.h"
 #include <cstdint>
 
 namespace OpenChord {
@@ -26,22 +27,6 @@ enum class EncoderMode {
     // ZOOM,            // Zoom in/out
 };
 
-// Encoder event types
-enum class EncoderEventType {
-    ROTATED,           // Encoder was rotated (increment or decrement)
-    BUTTON_PRESSED,    // Encoder button was pressed
-    BUTTON_RELEASED,   // Encoder button was released
-    BUTTON_HELD,       // Encoder button is being held
-};
-
-// Encoder event structure
-struct EncoderEvent {
-    EncoderEventType type;
-    int delta;              // Rotation delta (positive = clockwise, negative = counter-clockwise)
-    int value;              // Current encoder value
-    uint32_t timestamp;
-};
-
 // Encoder rotation direction
 enum class EncoderDirection {
     NONE,
@@ -52,8 +37,10 @@ enum class EncoderDirection {
 /**
  * Encoder Input Handler
  * 
- * Provides high-level access to encoder inputs with mode support,
- * event handling, and acceleration support.
+ * Provides high-level access to encoder inputs with mode support and
+ * acceleration. Rotation and button changes are published to the
+ * InputEventStream as ENCODER_STEP (value = delta) and ENCODER_BUTTON
+ * (value = 1 pressed, 0 released).
  */
 class EncoderInputHandler {
 public:
@@ -61,7 +48,7 @@ public:
     ~EncoderInputHandler();
     
     // Initialization
-    void Init(::DigitalManager* digital_manager);
+    void Init(::DigitalManager* digital_manager, InputEventStream* event_stream = nullptr);
     void Update();
     
     // Mode management
@@ -83,9 +70,6 @@ public:
     bool IsButtonHeld() const;
     uint32_t GetButtonHoldTime() const;
     
-    // Event polling
-    bool PollEvent(EncoderEvent& event);
-    
     // Configuration
     void Reset(int value = 0);       // Reset encoder value
     void SetAccelerationEnabled(bool enabled);
@@ -104,12 +88,8 @@ private:
     float current_delta_;
     EncoderDirection current_direction_;
     
-    // Event queue
-    static constexpr int MAX_EVENTS = 16;
-    EncoderEvent event_queue_[MAX_EVENTS];
-    int event_queue_head_;
-    int event_queue_tail_;
-    int event_queue_count_;
+    InputEventStream* event_stream_;
+    bool button_prev_pressed_;
     
     // Acceleration tracking
     int rotation_steps_;              // Consecutive rotation steps
@@ -118,7 +98,6 @@ private:
     // Helper methods
     void ProcessEncoder();
     void ProcessButton();
-    void QueueEvent(const EncoderEvent& event);
     float CalculateAcceleration(int steps) const;
 };
 
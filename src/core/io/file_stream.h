@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * File Stream - Byte stream over an open file
+ *
+ * What the file format code (e.g. SmfReader/SmfWriter) reads and writes
+ * through, so it has no FatFS or daisy dependency: StorageFile implements it
+ * on the SD card, host tools implement it over stdio.
+ */
+class IFileStream {
+public:
+    virtual ~IFileStream() = default;
+
+    // Bytes transferred - fewer than asked at the end of the file or on an error
+    virtual size_t Read(void* data, size_t size) = 0;
+    virtual size_t Write(const void* data, size_t size) = 0;
+
+    // Absolute position from the start of the file
+    virtual bool Seek(uint32_t position) = 0;
+};
+
+} // namespace OpenChord
@@ -0,0 +1,95 @@
+#include "frame_diff.h"
+#include <cstring>
+
+FrameDiff::FrameDiff() : valid_(false) {
+    memset(shadow_, 0, sizeof(shadow_));
+    ResetStats();
+}
+
+FrameDiff::~FrameDiff() {
+}
+
+size_t FrameDiff::Diff(const uint8_t* frame, Span* spans) {
+    if (!frame || !spans) return 0;
+
+    size_t count = 0;
+    uint32_t bytes = 0;
+    for (size_t page = 0; page < PAGE_COUNT; page++) {
+        size_t page_spans;
+        if (valid_) {
+            page_spans = DiffPage(frame, static_cast<uint8_t>(page), &spans[count]);
+        } else {
+            // Controller RAM unknown - send the whole page
+            spans[count].page = static_cast<uint8_t>(page);
+            spans[count].start_column = 0;
+            spans[count].length = static_cast<uint8_t>(WIDTH);
+            page_spans = 1;
+        }
+        for (size_t i = 0; i < page_spans; i++) {
+            bytes += spans[count + i].length + SPAN_OVERHEAD_BYTES;
+        }
+        count += page_spans;
+    }
+
+    memcpy(shadow_, frame, FRAME_BYTES);
+    valid_ = true;
+
+    frame_count_++;
+    if (count == 0) {
+        unchanged_count_++;
+    }
+    last_frame_bytes_ = bytes;
+    if (bytes > worst_frame_bytes_) {
+        worst_frame_bytes_ = bytes;
+    }
+    total_bytes_ += bytes;
+
+    return count;
+}
+
+size_t FrameDiff::DiffPage(const uint8_t* frame, uint8_t page, Span* spans) {
+    const uint8_t* row = &frame[page * WIDTH];
+    const uint8_t* old_row = &shadow_[page * WIDTH];
+
+    size_t count = 0;
+    int run_start = -1;
+    int run_end = -1;
+    for (int col = 0; col < static_cast<int>(WIDTH); col++) {
+        if (row[col] == old_row[col]) continue;
+
+        if (run_start < 0) {
+            run_start = col;
+        } else if (static_cast<size_t>(col - run_end - 1) > SPAN_OVERHEAD_BYTES
+                   && count < MAX_SPANS_PER_PAGE - 1) {
+            // Gap costs more than a new address command - close this span
+            spans[count].page = page;
+            spans[count].start_column = static_cast<uint8_t>(run_start);
+            spans[count].length = static_cast<uint8_t>(run_end - run_start + 1);
+            count++;
+            run_start = col;
+        }
+        // Otherwise resend the unchanged gap (or the last span takes the rest of the page)
+        run_end = col;
+    }
+
+    if (run_start >= 0) {
+        spans[count].page = page;
+        spans[count].start_column = static_cast<uint8_t>(run_start);
+        spans[count].length = static_cast<uint8_t>(run_end - run_start + 1);
+        count++;
+    }
+    return count;
+}
+
+uint32_t FrameDiff::GetAverageFrameBytes() const {
+    if (frame_count_ == 0) return 0;
+    return static_cast<uint32_t>(total_bytes_ / frame_count_);
+}
+
+void FrameDiff::ResetStats() {
+    frame_count_ = 0;
+    unchanged_count_ = 0;
+    last_frame_bytes_ = 0;
+    worst_frame_bytes_ = 0;
+    total_bytes_ = 0;
+}
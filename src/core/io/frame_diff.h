@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Frame Diff - Finds the parts of a 128x64 page-format frame that changed
+ *
+ * Keeps a shadow copy of the last frame sent to the SSD1306 and compares
+ * each new frame against it page by page (8 pages of 128 column bytes).
+ * Changed columns are grouped into spans that can be sent with the
+ * controller's page/column addressing. Runs closer together than the cost
+ * of a new address command are merged into one span.
+ *
+ * Also keeps bytes-per-frame statistics (data plus address command bytes).
+ */
+class FrameDiff {
+public:
+    static constexpr size_t WIDTH = 128;
+    static constexpr size_t PAGE_COUNT = 8;
+    static constexpr size_t FRAME_BYTES = WIDTH * PAGE_COUNT;
+    static constexpr size_t SPAN_OVERHEAD_BYTES = 3;    // Page + column low/high commands
+    static constexpr size_t MAX_SPANS_PER_PAGE = 4;
+    static constexpr size_t MAX_SPANS = PAGE_COUNT * MAX_SPANS_PER_PAGE;
+    static constexpr size_t FULL_FRAME_BYTES = FRAME_BYTES + PAGE_COUNT * SPAN_OVERHEAD_BYTES;
+
+    struct Span {
+        uint8_t page;
+        uint8_t start_column;
+        uint8_t length;        // 1-128 columns
+    };
+
+    FrameDiff();
+    ~FrameDiff();
+
+    // Compare frame (FRAME_BYTES, page-major) with the shadow, fill spans
+    // (up to MAX_SPANS) and copy the frame into the shadow. Returns span count.
+    size_t Diff(const uint8_t* frame, Span* spans);
+
+    // Forget the shadow so the next Diff() sends the whole frame
+    // (after controller init/reset, when its RAM content is unknown)
+    void Invalidate() { valid_ = false; }
+
+    // Statistics
+    uint32_t GetFrameCount() const { return frame_count_; }
+    uint32_t GetUnchangedFrameCount() const { return unchanged_count_; }
+    uint32_t GetLastFrameBytes() const { return last_frame_bytes_; }
+    uint32_t GetWorstFrameBytes() const { return worst_frame_bytes_; }
+    uint64_t GetTotalBytes() const { return total_bytes_; }
+    uint32_t GetAverageFrameBytes() const;
+    void ResetStats();
+
+private:
+    uint8_t shadow_[FRAME_BYTES];
+    bool valid_;
+
+    uint32_t frame_count_;
+    uint32_t unchanged_count_;
+    uint32_t last_frame_bytes_;
+    uint32_t worst_frame_bytes_;
+    uint64_t total_bytes_;
+
+    size_t DiffPage(const uint8_t* frame, uint8_t page, Span* spans);
+};
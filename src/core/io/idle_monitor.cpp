@@ -0,0 +1,89 @@
+#include "idle_monitor.h"
+#include <cstring>
+
+namespace OpenChord {
+
+IdleMonitor::IdleMonitor()
+    : wake_flags_(0)
+    , pending_work_(0)
+    , last_elapsed_us_(0)
+    , elapsed_started_(false)
+{
+    ResetStats();
+}
+
+IdleMonitor::~IdleMonitor() {
+}
+
+void IdleMonitor::NotifyWake(WakeSource source) {
+    if (source >= WAKE_SOURCE_COUNT) return;
+    wake_flags_.fetch_or(WakeBit(source), std::memory_order_relaxed);
+}
+
+void IdleMonitor::RequestWork(WakeSource source) {
+    if (source >= WAKE_SOURCE_COUNT) return;
+    wake_flags_.fetch_or(WakeBit(source), std::memory_order_relaxed);
+    pending_work_.fetch_or(WakeBit(source), std::memory_order_release);
+}
+
+uint32_t IdleMonitor::TakePendingWork() {
+    return pending_work_.exchange(0, std::memory_order_acq_rel);
+}
+
+void IdleMonitor::RecordSleep(int mode, uint32_t slept_us) {
+    uint32_t flags = wake_flags_.exchange(0, std::memory_order_relaxed);
+
+    // Nothing reported: SysTick, ADC timer or another peripheral woke us
+    if (flags == 0) {
+        flags = WakeBit(WAKE_OTHER);
+    }
+    for (int i = 0; i < WAKE_SOURCE_COUNT; i++) {
+        if (flags & (1u << i)) {
+            wake_counts_[i]++;
+        }
+    }
+
+    if (!IsValidMode(mode)) return;
+    sleep_us_[mode] += slept_us;
+    sleep_counts_[mode]++;
+}
+
+void IdleMonitor::RecordElapsed(int mode, uint32_t now_us) {
+    if (elapsed_started_ && IsValidMode(mode)) {
+        total_us_[mode] += now_us - last_elapsed_us_;  // Unsigned difference handles wrap
+    }
+    last_elapsed_us_ = now_us;
+    elapsed_started_ = true;
+}
+
+uint64_t IdleMonitor::GetSleepUs(int mode) const {
+    return IsValidMode(mode) ? sleep_us_[mode] : 0;
+}
+
+uint64_t IdleMonitor::GetTotalUs(int mode) const {
+    return IsValidMode(mode) ? total_us_[mode] : 0;
+}
+
+float IdleMonitor::GetSleepFraction(int mode) const {
+    if (!IsValidMode(mode) || total_us_[mode] == 0) return 0.0f;
+    float fraction = static_cast<float>(sleep_us_[mode]) / static_cast<float>(total_us_[mode]);
+    return fraction > 1.0f ? 1.0f : fraction;
+}
+
+uint32_t IdleMonitor::GetSleepCount(int mode) const {
+    return IsValidMode(mode) ? sleep_counts_[mode] : 0;
+}
+
+uint32_t IdleMonitor::GetWakeCount(WakeSource source) const {
+    return source < WAKE_SOURCE_COUNT ? wake_counts_[source] : 0;
+}
+
+void IdleMonitor::ResetStats() {
+    std::memset(wake_counts_, 0, sizeof(wake_counts_));
+    std::memset(sleep_us_, 0, sizeof(sleep_us_));
+    std::memset(total_us_, 0, sizeof(total_us_));
+    std::memset(sleep_counts_, 0, sizeof(sleep_counts_));
+    elapsed_started_ = false;
+}
+
+} // namespace OpenChord
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace OpenChord {
+
+/**
+ * Idle Monitor - Wake-up sources and sleep residency for the main loop idle
+ *
+ * Interrupts report themselves with NotifyWake(); the ones that leave work
+ * for the main loop (key edges, received MIDI) also call RequestWork(), which
+ * ends the idle early. The main loop side records how long each WFI slept,
+ * which sources woke it, and the wall time spent in each power mode, so
+ * residency (fraction of time asleep) can be compared per mode.
+ *
+ * Modes are plain indices (PowerManager::PowerMode cast to int).
+ */
+class IdleMonitor {
+public:
+    enum WakeSource {
+        WAKE_AUDIO,       // Audio DMA half/full-complete (audio callback)
+        WAKE_KEY_SCAN,    // Key matrix scan timer
+        WAKE_MIDI_RX,     // USB or UART MIDI receive
+        WAKE_OTHER,       // SysTick, ADC sample timer, anything unreported
+        WAKE_SOURCE_COUNT
+    };
+
+    static constexpr int MODE_COUNT = 4;
+
+    static constexpr uint32_t WakeBit(WakeSource source) { return 1u << source; }
+
+    IdleMonitor();
+    ~IdleMonitor();
+
+    // Interrupt side (lock-free, safe from any ISR)
+    void NotifyWake(WakeSource source);
+    void RequestWork(WakeSource source);
+
+    // Main loop side
+    bool HasPendingWork() const { return pending_work_.load(std::memory_order_acquire) != 0; }
+    uint32_t TakePendingWork();   // Mask of WakeBit()s that requested work, cleared
+
+    // Call with interrupts masked right before WFI (forgets earlier wakes)
+    void ArmWake() { wake_flags_.store(0, std::memory_order_relaxed); }
+
+    // One WFI period in `mode`; attributes the wake to the sources reported since ArmWake()
+    void RecordSleep(int mode, uint32_t slept_us);
+
+    // Wall time accounting - call once per idle with the current time
+    void RecordElapsed(int mode, uint32_t now_us);
+
+    // Statistics
+    uint64_t GetSleepUs(int mode) const;
+    uint64_t GetTotalUs(int mode) const;
+    float GetSleepFraction(int mode) const;   // 0-1, 0 if no time in this mode
+    uint32_t GetSleepCount(int mode) const;
+    uint32_t GetWakeCount(WakeSource source) const;
+    void ResetStats();
+
+private:
+    std::atomic<uint32_t> wake_flags_;     // Sources that ran since ArmWake()
+    std::atomic<uint32_t> pending_work_;   // Sources waiting for the main loop
+
+    uint32_t wake_counts_[WAKE_SOURCE_COUNT];
+    uint64_t sleep_us_[MODE_COUNT];
+    uint64_t total_us_[MODE_COUNT];
+    uint32_t sleep_counts_[MODE_COUNT];
+
+    uint32_t last_elapsed_us_;
+    bool elapsed_started_;
+
+    static bool IsValidMode(int mode) { return mode >= 0 && mode < MODE_COUNT; }
+};
+
+} // namespace OpenChord
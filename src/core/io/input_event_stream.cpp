@@ -0,0 +1,102 @@
+#include "input_event_stream.h"
+#include <cstring>
+
+namespace OpenChord {
+
+InputEventStream::InputEventStream()
+    : event_count_(0)
+    , pass_time_us_(0)
+    , subscriber_count_(0)
+    , dispatched_count_(0)
+    , dropped_count_(0)
+    , last_latency_us_(0)
+    , worst_latency_us_(0)
+{
+    memset(events_, 0, sizeof(events_));
+    memset(subscribers_, 0, sizeof(subscribers_));
+}
+
+InputEventStream::~InputEventStream() {
+}
+
+bool InputEventStream::Subscribe(InputEventCallback callback, void* context) {
+    if (!callback) return false;
+    for (size_t i = 0; i < subscriber_count_; i++) {
+        if (subscribers_[i].callback == callback && subscribers_[i].context == context) {
+            return true;  // Already subscribed
+        }
+    }
+    if (subscriber_count_ >= MAX_SUBSCRIBERS) return false;
+    subscribers_[subscriber_count_].callback = callback;
+    subscribers_[subscriber_count_].context = context;
+    subscriber_count_++;
+    return true;
+}
+
+void InputEventStream::Unsubscribe(InputEventCallback callback, void* context) {
+    for (size_t i = 0; i < subscriber_count_; i++) {
+        if (subscribers_[i].callback == callback && subscribers_[i].context == context) {
+            // Keep order of the remaining subscribers
+            for (size_t j = i + 1; j < subscriber_count_; j++) {
+                subscribers_[j - 1] = subscribers_[j];
+            }
+            subscriber_count_--;
+            return;
+        }
+    }
+}
+
+bool InputEventStream::Push(const InputEvent& event) {
+    if (event_count_ >= MAX_EVENTS) {
+        dropped_count_++;
+        return false;
+    }
+    events_[event_count_++] = event;
+    return true;
+}
+
+bool InputEventStream::Push(InputEventType type, uint8_t id, int16_t value) {
+    InputEvent event;
+    event.timestamp_us = pass_time_us_;
+    event.type = type;
+    event.id = id;
+    event.value = value;
+    return Push(event);
+}
+
+void InputEventStream::Dispatch(uint32_t now_us) {
+    // Insertion sort by timestamp (stable, few events per pass, wrap-safe compare)
+    for (size_t i = 1; i < event_count_; i++) {
+        InputEvent event = events_[i];
+        size_t j = i;
+        while (j > 0 && static_cast<int32_t>(events_[j - 1].timestamp_us - event.timestamp_us) > 0) {
+            events_[j] = events_[j - 1];
+            j--;
+        }
+        events_[j] = event;
+    }
+
+    for (size_t i = 0; i < event_count_; i++) {
+        const InputEvent& event = events_[i];
+        for (size_t s = 0; s < subscriber_count_; s++) {
+            subscribers_[s].callback(event, subscribers_[s].context);
+        }
+
+        // Edge -> subscribers reaction time
+        last_latency_us_ = now_us - event.timestamp_us;
+        if (last_latency_us_ > worst_latency_us_) {
+            worst_latency_us_ = last_latency_us_;
+        }
+        dispatched_count_++;
+    }
+    event_count_ = 0;
+}
+
+void InputEventStream::ResetStats() {
+    dispatched_count_ = 0;
+    dropped_count_ = 0;
+    last_latency_us_ = 0;
+    worst_latency_us_ = 0;
+}
+
+} // namespace OpenChord
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * Input event types in the merged input stream
+ */
+enum class InputEventType : uint8_t {
+    KEY_DOWN,            // id = key index, debounced press edge
+    KEY_UP,              // id = key index, debounced release edge
+    KEY_HELD,            // id = key index, hold threshold crossed (once per press)
+    ENCODER_STEP,        // value = detents (positive = clockwise)
+    ENCODER_BUTTON,      // value = 1 pressed, 0 released
+    JOYSTICK_DIRECTION   // id = new JoystickDirection, value = previous direction
+};
+
+/**
+ * One timestamped input event
+ *
+ * Key index: musical buttons 0-6 (MusicalButton), system buttons follow
+ * from SYSTEM_KEY_BASE (SystemButton + 7).
+ */
+struct InputEvent {
+    static constexpr uint8_t MUSICAL_KEY_COUNT = 7;
+    static constexpr uint8_t SYSTEM_KEY_BASE = MUSICAL_KEY_COUNT;
+
+    uint32_t timestamp_us;  // When the edge happened (scan tick for keys)
+    InputEventType type;
+    uint8_t id;
+    int16_t value;
+
+    bool IsKey() const {
+        return type == InputEventType::KEY_DOWN || type == InputEventType::KEY_UP ||
+               type == InputEventType::KEY_HELD;
+    }
+    bool IsMusicalKey() const { return IsKey() && id < MUSICAL_KEY_COUNT; }
+};
+
+typedef void (*InputEventCallback)(const InputEvent& event, void* context);
+
+/**
+ * Input Event Stream - Merged, time-ordered input events for subscribers
+ *
+ * Input handlers publish edges as they detect them (keys from the scanner
+ * queue, encoder detents, joystick direction crossings). Dispatch() sorts
+ * the pass's events by timestamp and delivers them to every subscriber, so
+ * plugins react to events instead of polling and diffing input state.
+ *
+ * Single-threaded (main loop).
+ */
+class InputEventStream {
+public:
+    static constexpr size_t MAX_EVENTS = 32;       // Per dispatch pass
+    static constexpr size_t MAX_SUBSCRIBERS = 8;
+
+    InputEventStream();
+    ~InputEventStream();
+
+    // Subscribers are called in subscription order for each event
+    bool Subscribe(InputEventCallback callback, void* context);
+    void Unsubscribe(InputEventCallback callback, void* context);
+    size_t GetSubscriberCount() const { return subscriber_count_; }
+
+    // Start a pass: events pushed without a timestamp get now_us
+    void BeginPass(uint32_t now_us) { pass_time_us_ = now_us; }
+
+    // Publish an event (false if the pass is full)
+    bool Push(const InputEvent& event);
+    bool Push(InputEventType type, uint8_t id, int16_t value);
+
+    // Deliver this pass's events in timestamp order, then clear
+    void Dispatch(uint32_t now_us);
+
+    // Diagnostics: edge -> dispatch latency and overflow
+    uint32_t GetDispatchedCount() const { return dispatched_count_; }
+    uint32_t GetDroppedCount() const { return dropped_count_; }
+    uint32_t GetLastLatencyUs() const { return last_latency_us_; }
+    uint32_t GetWorstLatencyUs() const { return worst_latency_us_; }
+    void ResetStats();
+
+private:
+    struct Subscriber {
+        InputEventCallback callback;
+        void* context;
+    };
+
+    InputEvent events_[MAX_EVENTS];
+    size_t event_count_;
+    uint32_t pass_time_us_;
+
+    Subscriber subscribers_[MAX_SUBSCRIBERS];
+    size_t subscriber_count_;
+
+    uint32_t dispatched_count_;
+    uint32_t dropped_count_;
+    uint32_t last_latency_us_;
+    uint32_t worst_latency_us_;
+};
+
+} // namespace OpenChord
@@ -19,20 +19,20 @@ void InputManager::Init(IOManager* io_manager) {
     // Initialize button handler
     DigitalManager* digital = io_manager_->GetDigital();
     if (digital) {
-        button_handler_.Init(digital);
+        button_handler_.Init(digital, &event_stream_);
         button_handler_.SetInputMode(InputMode::MIDI_NOTES);
     }
     
     // Initialize encoder handler
     if (digital) {
-        encoder_handler_.Init(digital);
+        encoder_handler_.Init(digital, &event_stream_);
         encoder_handler_.SetMode(EncoderMode::NAVIGATION);
     }
     
     // Initialize joystick handler
     AnalogManager* analog = io_manager_->GetAnalog();
     if (analog) {
-        joystick_handler_.Init(analog);
+        joystick_handler_.Init(analog, &event_stream_);
         joystick_handler_.SetMode(JoystickMode::NAVIGATION);
     }
     
@@ -42,10 +42,13 @@ void InputManager::Init(IOManager* io_manager) {
 void InputManager::Update() {
     if (!initialized_ || !io_manager_) return;
     
-    // Update all input handlers
+    // Handlers publish into the stream, then one dispatch delivers the
+    // whole pass in timestamp order
+    event_stream_.BeginPass(daisy::System::GetUs());
     button_handler_.Update();
     joystick_handler_.Update();
     encoder_handler_.Update();
+    event_stream_.Dispatch(daisy::System::GetUs());
 }
 
 bool InputManager::IsAnySystemButtonPressed() const {
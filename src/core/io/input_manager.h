@@ -3,6 +3,7 @@
 #include "button_input_handler.h"
 #include "joystick_input_handler.h"
 #include "encoder_input_handler.h"
+#include "input_event_stream.h"
 #include "io_manager.h"
 
 namespace OpenChord {
@@ -21,6 +22,9 @@ namespace OpenChord {
  * - Mode management across all inputs
  * - Event aggregation from all input sources
  * - Simplified access for plugins and UI systems
+ *
+ * Discrete input changes from all handlers are merged into one
+ * timestamped InputEventStream, dispatched to subscribers once per Update().
  */
 class InputManager {
 public:
@@ -43,6 +47,10 @@ public:
     EncoderInputHandler& GetEncoder() { return encoder_handler_; }
     const EncoderInputHandler& GetEncoder() const { return encoder_handler_; }
     
+    // Event stream (subscribe for KEY_*, ENCODER_*, JOYSTICK_DIRECTION events)
+    InputEventStream& GetEventStream() { return event_stream_; }
+    const InputEventStream& GetEventStream() const { return event_stream_; }
+    
     // Convenience methods for common operations
     
     // Check if any system button is pressed (for modifier keys)
@@ -101,6 +109,8 @@ private:
     JoystickInputHandler joystick_handler_;
     EncoderInputHandler encoder_handler_;
     
+    InputEventStream event_stream_;
+    
     // Initialization state
     bool initialized_;
 };
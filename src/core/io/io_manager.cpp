@@ -46,18 +46,34 @@ void IOManager::Init(daisy::DaisySeed* hw) {
 void IOManager::Update() {
     if (!hw_) return;
     
-    uint32_t now = hw_->system.GetNow();
-    
     // Always update digital manager - it needs high frequency for proper debouncing
     // Power savings come from other subsystems, not input responsiveness
-    digital_.Update();
+    UpdateDigital();
     
     // Update analog manager conditionally (power-aware)
     if (!power_mgr_ || power_mgr_->ShouldUpdateADC(last_analog_update_)) {
-    analog_.Update();
-        last_analog_update_ = now;
+        UpdateAnalog();
     }
     
+    UpdateServices();
+}
+
+void IOManager::UpdateDigital() {
+    if (!hw_) return;
+    digital_.Update();
+}
+
+void IOManager::UpdateAnalog() {
+    if (!hw_) return;
+    analog_.Update();
+    last_analog_update_ = hw_->system.GetNow();
+}
+
+void IOManager::UpdateServices() {
+    if (!hw_) return;
+    
+    uint32_t now = hw_->system.GetNow();
+    
     // Serial, display, and storage are updated less frequently or on-demand
     serial_.Update();
     display_.Update();
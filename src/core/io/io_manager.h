@@ -53,6 +53,11 @@ public:
     void Update();
     void Shutdown();
     
+    // Split updates for the task scheduler (Update() runs all of them)
+    void UpdateDigital();   // Key matrix, encoder, buttons (high rate, not power-managed)
+    void UpdateAnalog();    // ADC channels (rate set by PowerManager)
+    void UpdateServices();  // Serial, display, storage, status and errors
+    
     // Partial initialization (for early display init)
     void SetHardware(daisy::DaisySeed* hw) { hw_ = hw; }
     
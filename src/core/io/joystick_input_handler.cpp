@@ -13,19 +13,17 @@ JoystickInputHandler::JoystickInputHandler()
       current_y_(0.0f),
       prev_x_(0.0f),
       prev_y_(0.0f),
-      event_queue_head_(0),
-      event_queue_tail_(0),
-      event_queue_count_(0) {
-    
-    memset(event_queue_, 0, sizeof(event_queue_));
+      last_direction_(JoystickDirection::CENTER),
+      event_stream_(nullptr) {
 }
 
 JoystickInputHandler::~JoystickInputHandler() {
     analog_manager_ = nullptr;
 }
 
-void JoystickInputHandler::Init(::AnalogManager* analog_manager) {
+void JoystickInputHandler::Init(::AnalogManager* analog_manager, InputEventStream* event_stream) {
     analog_manager_ = analog_manager;
+    event_stream_ = event_stream;
     mode_ = JoystickMode::NAVIGATION;
     dead_zone_ = 0.05f;
     movement_threshold_ = 0.01f;
@@ -34,10 +32,7 @@ void JoystickInputHandler::Init(::AnalogManager* analog_manager) {
     current_y_ = 0.0f;
     prev_x_ = 0.0f;
     prev_y_ = 0.0f;
-    
-    event_queue_head_ = 0;
-    event_queue_tail_ = 0;
-    event_queue_count_ = 0;
+    last_direction_ = JoystickDirection::CENTER;
 }
 
 void JoystickInputHandler::Update() {
@@ -75,77 +70,21 @@ void JoystickInputHandler::ProcessJoystick() {
     if (current_y_ > 1.0f) current_y_ = 1.0f;
     if (current_y_ < -1.0f) current_y_ = -1.0f;
     
-    // Check for movement events
-    float delta_x = current_x_ - prev_x_;
-    float delta_y = current_y_ - prev_y_;
-    float movement = sqrtf(delta_x * delta_x + delta_y * delta_y);
-    
-    if (movement > movement_threshold_) {
-        JoystickEvent event;
-        event.type = JoystickEventType::MOVED;
-        event.x = current_x_;
-        event.y = current_y_;
-        event.delta_x = delta_x;
-        event.delta_y = delta_y;
-        event.timestamp = 0; // TODO: Get actual timestamp if needed
-        QueueEvent(event);
-    }
-    
-    // Check for centering
-    bool was_centered = (fabsf(prev_x_) < dead_zone_ && fabsf(prev_y_) < dead_zone_);
-    bool is_centered = (fabsf(current_x_) < dead_zone_ && fabsf(current_y_) < dead_zone_);
-    if (!was_centered && is_centered) {
-        JoystickEvent event;
-        event.type = JoystickEventType::CENTERED;
-        event.x = current_x_;
-        event.y = current_y_;
-        event.delta_x = delta_x;
-        event.delta_y = delta_y;
-        event.timestamp = 0;
-        QueueEvent(event);
-    }
-    
-    // Check for edge reached
-    bool at_edge = (fabsf(current_x_) > 0.95f || fabsf(current_y_) > 0.95f);
-    bool was_at_edge = (fabsf(prev_x_) > 0.95f || fabsf(prev_y_) > 0.95f);
-    if (!was_at_edge && at_edge) {
-        JoystickEvent event;
-        event.type = JoystickEventType::EDGE_REACHED;
-        event.x = current_x_;
-        event.y = current_y_;
-        event.delta_x = delta_x;
-        event.delta_y = delta_y;
-        event.timestamp = 0;
-        QueueEvent(event);
+    // Publish direction crossings only - continuous position is polled
+    JoystickDirection direction = CalculateDirection(current_x_, current_y_);
+    if (direction != last_direction_) {
+        if (event_stream_) {
+            event_stream_->Push(InputEventType::JOYSTICK_DIRECTION,
+                                static_cast<uint8_t>(direction),
+                                static_cast<int16_t>(last_direction_));
+        }
+        last_direction_ = direction;
     }
     
     prev_x_ = current_x_;
     prev_y_ = current_y_;
 }
 
-void JoystickInputHandler::QueueEvent(const JoystickEvent& event) {
-    if (event_queue_count_ >= MAX_EVENTS) {
-        // Queue full, drop oldest event
-        event_queue_head_ = (event_queue_head_ + 1) % MAX_EVENTS;
-        event_queue_count_--;
-    }
-    
-    event_queue_[event_queue_tail_] = event;
-    event_queue_tail_ = (event_queue_tail_ + 1) % MAX_EVENTS;
-    event_queue_count_++;
-}
-
-bool JoystickInputHandler::PollEvent(JoystickEvent& event) {
-    if (event_queue_count_ == 0) {
-        return false;
-    }
-    
-    event = event_queue_[event_queue_head_];
-    event_queue_head_ = (event_queue_head_ + 1) % MAX_EVENTS;
-    event_queue_count_--;
-    return true;
-}
-
 float JoystickInputHandler::GetX() const {
     return current_x_;
 }
@@ -168,7 +107,7 @@ float JoystickInputHandler::GetDeltaY() const {
 }
 
 JoystickDirection JoystickInputHandler::GetDirection() const {
-    return CalculateDirection(current_x_, current_y_);
+    return last_direction_;
 }
 
 bool JoystickInputHandler::IsCentered() const {
@@ -195,27 +134,43 @@ bool JoystickInputHandler::IsPushedRight(float threshold) const {
     return current_x_ > threshold;
 }
 
-JoystickDirection JoystickInputHandler::CalculateDirection(float x, float y) const {
-    if (fabsf(x) < dead_zone_ && fabsf(y) < dead_zone_) {
+JoystickDirection JoystickInputHandler::CalculateDirection(float x, float y) {
+    // Thresholds tuned on hardware for chord selection (joystick travel is
+    // roughly -0.5 to 0.5 of the normalized range in practice)
+    const float cardinal_threshold = 0.48f;    // For UP, DOWN, LEFT, RIGHT
+    const float diagonal_threshold = 0.24f;    // For diagonals (both axes need to meet this)
+    const float dead_zone = 0.1f;              // Below this = CENTER
+    
+    float abs_x = fabsf(x);
+    float abs_y = fabsf(y);
+    float distance = sqrtf(x * x + y * y);
+    
+    if (distance < dead_zone) {
         return JoystickDirection::CENTER;
     }
     
-    // Calculate angle and determine primary direction
-    float angle = atan2f(y, x) * 180.0f / 3.14159265f;
+    // Both axes significant and within ~40% of each other = diagonal
+    float axis_ratio = (abs_x > abs_y) ? (abs_y / abs_x) : (abs_x / abs_y);
+    bool is_diagonal = (axis_ratio > 0.6f) && (abs_x >= diagonal_threshold) && (abs_y >= diagonal_threshold);
+    
+    if (is_diagonal) {
+        if (x > 0 && y > 0) return JoystickDirection::UP_RIGHT;
+        if (x > 0 && y < 0) return JoystickDirection::DOWN_RIGHT;
+        if (x < 0 && y > 0) return JoystickDirection::UP_LEFT;
+        if (x < 0 && y < 0) return JoystickDirection::DOWN_LEFT;
+    }
     
-    // Normalize angle to 0-360
-    if (angle < 0) angle += 360.0f;
+    // Vertical dominates
+    if (abs_y >= cardinal_threshold && abs_y >= abs_x) {
+        return (y > 0) ? JoystickDirection::UP : JoystickDirection::DOWN;
+    }
     
-    // Determine direction based on angle
-    if (angle >= 337.5f || angle < 22.5f) return JoystickDirection::RIGHT;
-    if (angle >= 22.5f && angle < 67.5f) return JoystickDirection::UP_RIGHT;
-    if (angle >= 67.5f && angle < 112.5f) return JoystickDirection::UP;
-    if (angle >= 112.5f && angle < 157.5f) return JoystickDirection::UP_LEFT;
-    if (angle >= 157.5f && angle < 202.5f) return JoystickDirection::LEFT;
-    if (angle >= 202.5f && angle < 247.5f) return JoystickDirection::DOWN_LEFT;
-    if (angle >= 247.5f && angle < 292.5f) return JoystickDirection::DOWN;
-    if (angle >= 292.5f && angle < 337.5f) return JoystickDirection::DOWN_RIGHT;
+    // Horizontal dominates
+    if (abs_x >= cardinal_threshold && abs_x >= abs_y) {
+        return (x > 0) ? JoystickDirection::RIGHT : JoystickDirection::LEFT;
+    }
     
+    // Between dead zone and thresholds
     return JoystickDirection::CENTER;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "analog_manager.h"
+#include "input_event_stream.h"
 #include <cstdint>
 
 namespace OpenChord {
@@ -26,25 +27,6 @@ enum class JoystickMode {
     // ARP_CONTROL,    // Arpeggiator control
 };
 
-// Joystick event types
-enum class JoystickEventType {
-    MOVED,            // Joystick moved (position changed)
-    CENTERED,         // Joystick returned to center
-    EDGE_REACHED,     // Reached edge of range
-    // Future events:
-    // GESTURE,        // Detected gesture pattern
-};
-
-// Joystick event structure
-struct JoystickEvent {
-    JoystickEventType type;
-    float x;              // Current X position (-1.0 to 1.0, centered at 0.0)
-    float y;              // Current Y position (-1.0 to 1.0, centered at 0.0)
-    float delta_x;        // Change in X since last event
-    float delta_y;        // Change in Y since last event
-    uint32_t timestamp;
-};
-
 // Joystick direction (for discrete navigation)
 enum class JoystickDirection {
     CENTER,
@@ -61,8 +43,9 @@ enum class JoystickDirection {
 /**
  * Joystick Input Handler
  * 
- * Provides high-level access to joystick inputs with mode support,
- * event handling, and discrete direction detection.
+ * Provides high-level access to joystick inputs with mode support and
+ * discrete direction detection. Direction changes are published to the
+ * InputEventStream as JOYSTICK_DIRECTION (id = new direction, value = previous).
  */
 class JoystickInputHandler {
 public:
@@ -70,7 +53,7 @@ public:
     ~JoystickInputHandler();
     
     // Initialization
-    void Init(::AnalogManager* analog_manager);
+    void Init(::AnalogManager* analog_manager, InputEventStream* event_stream = nullptr);
     void Update();
     
     // Mode management
@@ -98,8 +81,8 @@ public:
     bool IsPushedLeft(float threshold = 0.3f) const;
     bool IsPushedRight(float threshold = 0.3f) const;
     
-    // Event polling
-    bool PollEvent(JoystickEvent& event);
+    // Direction classifier (dead zone 0.1, cardinal 0.48, balanced diagonals 0.24)
+    static JoystickDirection CalculateDirection(float x, float y);
     
     // Configuration
     void SetDeadZone(float dead_zone);      // Dead zone threshold (0.0 to 0.5)
@@ -119,17 +102,11 @@ private:
     float prev_x_;
     float prev_y_;
     
-    // Event queue
-    static constexpr int MAX_EVENTS = 8;
-    JoystickEvent event_queue_[MAX_EVENTS];
-    int event_queue_head_;
-    int event_queue_tail_;
-    int event_queue_count_;
+    JoystickDirection last_direction_;
+    InputEventStream* event_stream_;
     
     // Helper methods
     void ProcessJoystick();
-    void QueueEvent(const JoystickEvent& event);
-    JoystickDirection CalculateDirection(float x, float y) const;
     bool HasMoved(float threshold) const;
 };
 
@@ -0,0 +1,170 @@
+#include "key_matrix_scanner.h"
+#include <cstring>
+
+static_assert((KeyMatrixScanner::QUEUE_CAPACITY & (KeyMatrixScanner::QUEUE_CAPACITY - 1)) == 0,
+              "KeyMatrixScanner queue capacity must be a power of two");
+static_assert(KeyMatrixScanner::MAX_ROWS * KeyMatrixScanner::MAX_COLS <= 64,
+              "Key state must fit the 64-bit masks");
+
+FakeKeyMatrixGpio::FakeKeyMatrixGpio() : active_row_(-1) {
+    memset(row_columns_, 0, sizeof(row_columns_));
+}
+
+void FakeKeyMatrixGpio::SetKey(int row, int col, bool pressed) {
+    if (row < 0 || row >= MAX_ROWS || col < 0 || col >= 32) return;
+    if (pressed) {
+        row_columns_[row] |= (1u << col);
+    } else {
+        row_columns_[row] &= ~(1u << col);
+    }
+}
+
+void FakeKeyMatrixGpio::SetRowActive(int row, bool active) {
+    if (active) {
+        active_row_ = row;
+    } else if (active_row_ == row) {
+        active_row_ = -1;
+    }
+}
+
+uint32_t FakeKeyMatrixGpio::ReadColumns() {
+    if (active_row_ < 0 || active_row_ >= MAX_ROWS) return 0;
+    return row_columns_[active_row_];
+}
+
+KeyMatrixScanner::KeyMatrixScanner()
+    : gpio_(nullptr)
+    , rows_(0)
+    , cols_(0)
+    , active_row_(-1)
+    , debounce_samples_(DEFAULT_DEBOUNCE_SAMPLES)
+    , valid_mask_(~0ull)
+    , down_mask_(0)
+    , scan_count_(0)
+    , dropped_count_(0)
+    , head_(0)
+    , tail_(0)
+{
+    memset(integrator_, 0, sizeof(integrator_));
+    memset(events_, 0, sizeof(events_));
+}
+
+KeyMatrixScanner::~KeyMatrixScanner() {
+}
+
+void KeyMatrixScanner::Init(IKeyMatrixGpio* gpio, int rows, int cols, const uint64_t* valid_mask) {
+    gpio_ = gpio;
+    rows_ = rows < 0 ? 0 : (rows > MAX_ROWS ? MAX_ROWS : rows);
+    cols_ = cols < 0 ? 0 : (cols > MAX_COLS ? MAX_COLS : cols);
+    valid_mask_ = valid_mask ? *valid_mask : ~0ull;
+    memset(integrator_, 0, sizeof(integrator_));
+    down_mask_.store(0, std::memory_order_relaxed);
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    scan_count_ = 0;
+    dropped_count_ = 0;
+
+    if (!gpio_ || rows_ == 0) {
+        active_row_ = -1;
+        return;
+    }
+
+    // Release every row, then drive the first one so the first Tick can read it
+    for (int row = 0; row < rows_; row++) {
+        gpio_->SetRowActive(row, false);
+    }
+    active_row_ = 0;
+    gpio_->SetRowActive(active_row_, true);
+}
+
+void KeyMatrixScanner::SetDebounceSamples(uint8_t samples) {
+    debounce_samples_ = samples > 0 ? samples : 1;
+}
+
+void KeyMatrixScanner::Tick(uint32_t now_us) {
+    if (!gpio_ || active_row_ < 0) return;
+
+    // Row was driven one tick ago - columns have settled
+    uint32_t columns = gpio_->ReadColumns();
+    gpio_->SetRowActive(active_row_, false);
+    ProcessRow(active_row_, columns, now_us);
+
+    active_row_++;
+    if (active_row_ >= rows_) {
+        active_row_ = 0;
+        scan_count_ = scan_count_ + 1;
+    }
+    gpio_->SetRowActive(active_row_, true);
+}
+
+void KeyMatrixScanner::ProcessRow(int row, uint32_t columns, uint32_t now_us) {
+    uint64_t down = down_mask_.load(std::memory_order_relaxed);
+    uint64_t new_down = down;
+
+    for (int col = 0; col < cols_; col++) {
+        uint64_t bit = 1ull << (row * MAX_COLS + col);
+        if (!(valid_mask_ & bit)) continue;
+
+        bool sample = (columns >> col) & 1u;
+        uint8_t& integrator = integrator_[row][col];
+
+        if (new_down & bit) {
+            // Held: pressed samples recharge, released samples drain
+            if (sample) {
+                if (integrator < debounce_samples_) integrator++;
+            } else if (integrator > 0) {
+                integrator--;
+            }
+            if (integrator == 0) {
+                new_down &= ~bit;
+                PushEvent(row, col, false, now_us);
+            }
+        } else if (sample) {
+            // Settled and released: report the press on the first sample
+            integrator = debounce_samples_;
+            new_down |= bit;
+            PushEvent(row, col, true, now_us);
+        }
+    }
+
+    if (new_down != down) {
+        down_mask_.store(new_down, std::memory_order_release);
+    }
+}
+
+void KeyMatrixScanner::PushEvent(int row, int col, bool pressed, uint32_t now_us) {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail >= QUEUE_CAPACITY) {
+        dropped_count_++;
+        return;
+    }
+    KeyEvent& event = events_[head & (QUEUE_CAPACITY - 1)];
+    event.timestamp_us = now_us;
+    event.row = static_cast<uint8_t>(row);
+    event.col = static_cast<uint8_t>(col);
+    event.pressed = pressed ? 1 : 0;
+    event.reserved = 0;
+    head_.store(head + 1, std::memory_order_release);
+}
+
+bool KeyMatrixScanner::PopEvent(KeyEvent* event) {
+    if (!event) return false;
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    uint32_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+    *event = events_[tail & (QUEUE_CAPACITY - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+size_t KeyMatrixScanner::GetQueuedCount() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+bool KeyMatrixScanner::IsKeyDown(int row, int col) const {
+    if (row < 0 || row >= rows_ || col < 0 || col >= cols_) return false;
+    return (down_mask_.load(std::memory_order_acquire) >> (row * MAX_COLS + col)) & 1ull;
+}
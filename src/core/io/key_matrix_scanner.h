@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Key matrix GPIO access used by the scanner
+ *
+ * Rows are driven one at a time, columns are read together as a bitmask
+ * (bit set = key pressed on that column of the active row).
+ */
+class IKeyMatrixGpio {
+public:
+    virtual ~IKeyMatrixGpio() = default;
+    virtual void SetRowActive(int row, bool active) = 0;
+    virtual uint32_t ReadColumns() = 0;
+};
+
+/**
+ * Fake GPIO backend - key states set directly (host runs, no hardware)
+ *
+ * ReadColumns() returns the pressed keys of the currently active row, so the
+ * scanner sees exactly what a real diode matrix would report.
+ */
+class FakeKeyMatrixGpio : public IKeyMatrixGpio {
+public:
+    static constexpr int MAX_ROWS = 8;
+
+    FakeKeyMatrixGpio();
+
+    void SetKey(int row, int col, bool pressed);
+    void SetRowActive(int row, bool active) override;
+    uint32_t ReadColumns() override;
+
+    int GetActiveRow() const { return active_row_; }
+
+private:
+    uint32_t row_columns_[MAX_ROWS];
+    int active_row_;  // -1 when no row is driven
+};
+
+/**
+ * Key edge produced by the scanner
+ */
+struct KeyEvent {
+    uint32_t timestamp_us;  // Scan tick that detected the edge
+    uint8_t row;
+    uint8_t col;
+    uint8_t pressed;        // 1 = press, 0 = release
+    uint8_t reserved;
+};
+
+/**
+ * Key Matrix Scanner - Non-blocking, one row per tick
+ *
+ * Tick() is called from a periodic timer interrupt. Each tick reads the row
+ * driven on the previous tick (so it had a full tick period to settle),
+ * releases it and drives the next row - no busy-waiting.
+ *
+ * Debounce is a per-key integrator: a press is reported on the first pressed
+ * sample of a settled key, and the integrator is then charged to
+ * debounce_samples. Release is reported once it has drained back to zero,
+ * which also absorbs contact bounce after the release.
+ *
+ * Edges are pushed into a single producer / single consumer lock-free queue
+ * (timer interrupt -> main loop).
+ */
+class KeyMatrixScanner {
+public:
+    static constexpr int MAX_ROWS = 8;
+    static constexpr int MAX_COLS = 8;
+    static constexpr size_t QUEUE_CAPACITY = 32;  // Must be a power of two
+    static constexpr uint8_t DEFAULT_DEBOUNCE_SAMPLES = 8;
+
+    KeyMatrixScanner();
+    ~KeyMatrixScanner();
+
+    // valid_mask (optional): one bit per key (row * MAX_COLS + col) that exists
+    void Init(IKeyMatrixGpio* gpio, int rows, int cols, const uint64_t* valid_mask = nullptr);
+
+    // Scans needed to drain the integrator after a release (1..255)
+    void SetDebounceSamples(uint8_t samples);
+
+    // Timer interrupt: read one row, advance to the next
+    void Tick(uint32_t now_us);
+
+    // Consumer side (main loop)
+    bool PopEvent(KeyEvent* event);
+    size_t GetQueuedCount() const;
+
+    // Debounced state (safe to read from any context)
+    bool IsKeyDown(int row, int col) const;
+
+    // Edge time on a millisecond clock (System::GetNow()), from both clocks read
+    // now: the microsecond age is wrap-safe for edges under ~71 minutes old,
+    // so press times keep working after the microsecond timer wraps
+    static uint32_t EdgeTimeMs(const KeyEvent& event, uint32_t now_us, uint32_t now_ms) {
+        return now_ms - (now_us - event.timestamp_us) / 1000;
+    }
+
+    // Full matrix passes since Init
+    uint32_t GetScanCount() const { return scan_count_; }
+    uint32_t GetDroppedCount() const { return dropped_count_; }
+
+private:
+    IKeyMatrixGpio* gpio_;
+    int rows_;
+    int cols_;
+    int active_row_;
+    uint8_t debounce_samples_;
+    uint64_t valid_mask_;
+
+    uint8_t integrator_[MAX_ROWS][MAX_COLS];
+    std::atomic<uint64_t> down_mask_;  // Bit row * MAX_COLS + col
+    volatile uint32_t scan_count_;
+    uint32_t dropped_count_;
+
+    KeyEvent events_[QUEUE_CAPACITY];
+    std::atomic<uint32_t> head_;  // Written by Tick
+    std::atomic<uint32_t> tail_;  // Written by PopEvent
+
+    void ProcessRow(int row, uint32_t columns, uint32_t now_us);
+    void PushEvent(int row, int col, bool pressed, uint32_t now_us);
+};
@@ -0,0 +1,61 @@
+#include "oled_page_driver.h"
+
+// DMA can't reach DTCM - front buffer and address commands live in D2 SRAM
+static uint8_t DMA_BUFFER_MEM_SECTION oled_front_buffer[FrameDiff::FRAME_BYTES];
+static uint8_t DMA_BUFFER_MEM_SECTION oled_command_buffer[OledTransfer::COMMAND_BUFFER_BYTES];
+
+bool DaisyOledDmaBus::Init(const daisy::SpiHandle::Config& spi_config, daisy::Pin dc_pin,
+                           OledTransfer* transfer) {
+    transfer_ = transfer;
+    dc_.Init(dc_pin, daisy::GPIO::Mode::OUTPUT);
+    ready_ = (spi_.Init(spi_config) == daisy::SpiHandle::Result::OK);
+    return ready_;
+}
+
+bool DaisyOledDmaBus::StartTransmit(const uint8_t* bytes, size_t size, bool is_data) {
+    if (!ready_) return false;
+
+    // Previous segment is complete, so D/C can change now
+    dc_.Write(is_data);
+    return spi_.DmaTransmit(const_cast<uint8_t*>(bytes), size, nullptr,
+                            TransmitDoneCallback, this) == daisy::SpiHandle::Result::OK;
+}
+
+void DaisyOledDmaBus::TransmitDoneCallback(void* context, daisy::SpiHandle::Result result) {
+    DaisyOledDmaBus* bus = static_cast<DaisyOledDmaBus*>(context);
+    if (!bus || !bus->transfer_) return;
+    (void)result;  // A failed segment still ends; the next frame resends what changed
+    bus->transfer_->OnSegmentDone();
+}
+
+void OledPageDriver::Init(Config config) {
+    daisy::SSD130x4WireSpi128x64Driver::Config driver_config;
+    driver_config.transport_config = config.transport_config;
+    daisy::SSD130x4WireSpi128x64Driver::Init(driver_config);
+
+    // Page addressing mode, so each span's page/column commands take effect
+    transport_.SendCommand(0x20);
+    transport_.SendCommand(0x02);
+    
+    if (config.blitter) {
+        config.blitter->Init(buffer_);
+    }
+
+    transfer_ = nullptr;
+    if (config.transfer && bus_.Init(config.transport_config.spi_config,
+                                     config.transport_config.pin_config.dc,
+                                     config.transfer)) {
+        config.transfer->Init(&bus_, oled_front_buffer, oled_command_buffer);
+        transfer_ = config.transfer;
+    }
+}
+
+void OledPageDriver::Update() {
+    if (!transfer_) {
+        daisy::SSD130x4WireSpi128x64Driver::Update();
+        return;
+    }
+
+    // Returns at once; if the last frame is still going out this one is sent after it
+    transfer_->Submit(buffer_);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "daisy_seed.h"
+#include "dev/oled_ssd130x.h"
+#include "oled_transfer.h"
+#include "page_blitter.h"
+
+/**
+ * SPI DMA bus for the OLED - D/C pin plus non-blocking SPI transmits
+ *
+ * Shares SPI1 with the stock transport, which is only used for the
+ * blocking init sequence. Completion runs from the SPI DMA interrupt.
+ */
+class DaisyOledDmaBus : public IOledBus {
+public:
+    DaisyOledDmaBus() : transfer_(nullptr), ready_(false) {}
+
+    bool Init(const daisy::SpiHandle::Config& spi_config, daisy::Pin dc_pin, OledTransfer* transfer);
+    bool StartTransmit(const uint8_t* bytes, size_t size, bool is_data) override;
+
+private:
+    daisy::SpiHandle spi_;
+    daisy::GPIO dc_;
+    OledTransfer* transfer_;
+    bool ready_;
+
+    static void TransmitDoneCallback(void* context, daisy::SpiHandle::Result result);
+};
+
+/**
+ * OLED Page Driver - SSD130x 128x64 SPI driver with background frame updates
+ *
+ * Drop-in replacement for daisy::SSD130x4WireSpi128x64Driver inside
+ * daisy::OledDisplay. The stock driver's framebuffer is the back buffer;
+ * Update() hands it to an OledTransfer (owned by DisplayManager), which sends
+ * only the changed column spans of each page by SPI DMA and returns at once.
+ * Without a transfer, or if DMA setup fails, it sends the full frame like the
+ * stock driver. A PageBlitter in the config is bound to the framebuffer so
+ * text and rects can be drawn a byte at a time instead of pixel by pixel.
+ */
+class OledPageDriver : public daisy::SSD130x4WireSpi128x64Driver {
+public:
+    struct Config {
+        daisy::SSD130x4WireSpiTransport::Config transport_config;
+        OledTransfer* transfer = nullptr;
+        PageBlitter* blitter = nullptr;
+    };
+
+    void Init(Config config);
+    void Update();
+
+private:
+    DaisyOledDmaBus bus_;
+    OledTransfer* transfer_ = nullptr;
+};
@@ -0,0 +1,142 @@
+#include "oled_transfer.h"
+#include <cstring>
+
+FakeOledBus::FakeOledBus()
+    : transfer_(nullptr), ns_per_byte_(0), setup_ns_(0),
+      now_ns_(0), done_ns_(0), transmitting_(false),
+      page_(0), column_(0), busy_ns_(0), byte_count_(0) {
+    memset(ram_, 0, sizeof(ram_));
+}
+
+void FakeOledBus::Init(OledTransfer* transfer, uint32_t ns_per_byte, uint32_t setup_ns) {
+    transfer_ = transfer;
+    ns_per_byte_ = ns_per_byte;
+    setup_ns_ = setup_ns;
+}
+
+bool FakeOledBus::StartTransmit(const uint8_t* bytes, size_t size, bool is_data) {
+    if (!bytes || size == 0 || transmitting_) return false;
+
+    // Apply to the RAM model now; only the completion time is simulated
+    for (size_t i = 0; i < size; i++) {
+        uint8_t byte = bytes[i];
+        if (is_data) {
+            ram_[page_ * FrameDiff::WIDTH + column_] = byte;
+            column_ = static_cast<uint8_t>((column_ + 1) % FrameDiff::WIDTH);
+        } else if (byte >= 0xB0 && byte <= 0xB7) {
+            page_ = byte - 0xB0;
+        } else if (byte <= 0x0F) {
+            column_ = (column_ & 0xF0) | byte;
+        } else if (byte >= 0x10 && byte <= 0x17) {
+            column_ = static_cast<uint8_t>(((byte & 0x07) << 4) | (column_ & 0x0F));
+        }
+    }
+
+    uint64_t duration = setup_ns_ + static_cast<uint64_t>(size) * ns_per_byte_;
+    done_ns_ = now_ns_ + duration;
+    busy_ns_ += duration;
+    byte_count_ += static_cast<uint32_t>(size);
+    transmitting_ = true;
+    return true;
+}
+
+void FakeOledBus::Advance(uint64_t now_ns) {
+    // Each completion may start the next segment at the completion time
+    while (transmitting_ && done_ns_ <= now_ns) {
+        now_ns_ = done_ns_;
+        transmitting_ = false;
+        if (transfer_) {
+            transfer_->OnSegmentDone();
+        }
+    }
+    now_ns_ = now_ns;
+}
+
+OledTransfer::OledTransfer()
+    : bus_(nullptr), front_(nullptr), commands_(nullptr),
+      segment_count_(0), segment_index_(0), busy_(false),
+      pending_frame_(nullptr), busy_submit_count_(0), error_count_(0) {
+    memset(spans_, 0, sizeof(spans_));
+}
+
+OledTransfer::~OledTransfer() {
+}
+
+void OledTransfer::Init(IOledBus* bus, uint8_t* front_buffer, uint8_t* command_buffer) {
+    if (!front_buffer || !command_buffer) {
+        bus = nullptr;
+    }
+    bus_ = bus;
+    front_ = front_buffer;
+    commands_ = command_buffer;
+    busy_.store(false, std::memory_order_release);
+    pending_frame_ = nullptr;
+    diff_.Invalidate();
+}
+
+bool OledTransfer::Submit(const uint8_t* back_buffer) {
+    if (!bus_ || !back_buffer) return false;
+
+    if (IsBusy()) {
+        // Don't wait for the bus - send this frame once it's free
+        pending_frame_ = back_buffer;
+        busy_submit_count_++;
+        return false;
+    }
+    pending_frame_ = nullptr;
+
+    size_t count = diff_.Diff(back_buffer, spans_);
+    if (count == 0) return true;
+
+    // Front buffer mirrors what the panel will hold; only changed spans are copied
+    for (size_t i = 0; i < count; i++) {
+        const FrameDiff::Span& span = spans_[i];
+        size_t offset = span.page * FrameDiff::WIDTH + span.start_column;
+        memcpy(&front_[offset], &back_buffer[offset], span.length);
+
+        uint8_t* command = &commands_[i * FrameDiff::SPAN_OVERHEAD_BYTES];
+        command[0] = 0xB0 + span.page;                   // Page address
+        command[1] = 0x00 | (span.start_column & 0x0F);  // Column low nibble
+        command[2] = 0x10 | (span.start_column >> 4);    // Column high nibble
+    }
+
+    segment_count_ = count * 2;
+    segment_index_ = 0;
+    busy_.store(true, std::memory_order_release);
+    return StartSegment(0);
+}
+
+bool OledTransfer::SubmitPending() {
+    if (!pending_frame_ || IsBusy()) return false;
+    return Submit(pending_frame_);
+}
+
+void OledTransfer::OnSegmentDone() {
+    size_t next = segment_index_ + 1;
+    segment_index_ = next;
+    if (next >= segment_count_) {
+        busy_.store(false, std::memory_order_release);
+        return;
+    }
+    StartSegment(next);
+}
+
+bool OledTransfer::StartSegment(size_t index) {
+    const FrameDiff::Span& span = spans_[index / 2];
+    bool ok;
+    if (index % 2 == 0) {
+        ok = bus_->StartTransmit(&commands_[(index / 2) * FrameDiff::SPAN_OVERHEAD_BYTES],
+                                 FrameDiff::SPAN_OVERHEAD_BYTES, false);
+    } else {
+        ok = bus_->StartTransmit(&front_[span.page * FrameDiff::WIDTH + span.start_column],
+                                 span.length, true);
+    }
+
+    if (!ok) {
+        // Panel content is now unknown - resend everything next frame
+        error_count_++;
+        diff_.Invalidate();
+        busy_.store(false, std::memory_order_release);
+    }
+    return ok;
+}
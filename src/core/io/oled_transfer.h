@@ -0,0 +1,128 @@
+#pragma once
+
+#include "frame_diff.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+class OledTransfer;
+
+/**
+ * OLED bus used by OledTransfer
+ *
+ * StartTransmit() starts sending bytes with the D/C line set for commands
+ * or data and returns without waiting. When the bytes are out, the bus calls
+ * OledTransfer::OnSegmentDone() (from its DMA interrupt on hardware).
+ */
+class IOledBus {
+public:
+    virtual ~IOledBus() = default;
+    virtual bool StartTransmit(const uint8_t* bytes, size_t size, bool is_data) = 0;
+};
+
+/**
+ * Fake OLED bus - simulated transfer time and controller RAM (host runs)
+ *
+ * Each transmit takes setup_ns + size * ns_per_byte of simulated time.
+ * Advance() completes transfers whose time has passed, and command/data
+ * bytes are applied to an SSD1306 RAM model (page addressing mode), so a
+ * host run can check what the panel would show.
+ */
+class FakeOledBus : public IOledBus {
+public:
+    FakeOledBus();
+
+    void Init(OledTransfer* transfer, uint32_t ns_per_byte, uint32_t setup_ns);
+    bool StartTransmit(const uint8_t* bytes, size_t size, bool is_data) override;
+
+    // Move simulated time forward, completing transfers (and starting queued ones)
+    void Advance(uint64_t now_ns);
+
+    bool IsTransmitting() const { return transmitting_; }
+    const uint8_t* GetRam() const { return ram_; }
+    uint64_t GetBusyNs() const { return busy_ns_; }
+    uint32_t GetByteCount() const { return byte_count_; }
+
+private:
+    OledTransfer* transfer_;
+    uint32_t ns_per_byte_;
+    uint32_t setup_ns_;
+
+    uint64_t now_ns_;
+    uint64_t done_ns_;
+    bool transmitting_;
+
+    uint8_t ram_[FrameDiff::FRAME_BYTES];
+    uint8_t page_;
+    uint8_t column_;
+
+    uint64_t busy_ns_;
+    uint32_t byte_count_;
+};
+
+/**
+ * OLED Transfer - Double-buffered, non-blocking frame transmission
+ *
+ * The UI draws into the back buffer (the display driver's framebuffer).
+ * Submit() diffs it against the last frame sent, copies the changed spans
+ * into the front buffer and starts sending them in the background:
+ * an address command segment then a data segment per span, each started
+ * from the previous one's completion. Drawing the next frame can start right
+ * away; a frame submitted while the previous one is still in flight is
+ * remembered and sent by SubmitPending() instead of blocking.
+ *
+ * Front and command buffers are supplied by the caller so they can live in
+ * DMA-capable memory.
+ */
+class OledTransfer {
+public:
+    static constexpr size_t COMMAND_BUFFER_BYTES = FrameDiff::MAX_SPANS * FrameDiff::SPAN_OVERHEAD_BYTES;
+
+    OledTransfer();
+    ~OledTransfer();
+
+    // front_buffer: FrameDiff::FRAME_BYTES, command_buffer: COMMAND_BUFFER_BYTES
+    void Init(IOledBus* bus, uint8_t* front_buffer, uint8_t* command_buffer);
+    bool IsReady() const { return bus_ != nullptr; }
+
+    // Start sending the changed parts of back_buffer. Returns false if the
+    // previous frame is still in flight (frame kept as pending) or the bus failed.
+    bool Submit(const uint8_t* back_buffer);
+
+    // Send a frame that was submitted while busy (call periodically)
+    bool SubmitPending();
+
+    bool IsBusy() const { return busy_.load(std::memory_order_acquire); }
+    bool HasPending() const { return pending_frame_ != nullptr; }
+
+    // Bus completion (interrupt context)
+    void OnSegmentDone();
+
+    // Send the whole frame next time (controller RAM unknown)
+    void Invalidate() { diff_.Invalidate(); }
+
+    // What the panel shows once the transfer in flight is done (FRAME_BYTES)
+    const uint8_t* GetFrontBuffer() const { return front_; }
+
+    // Statistics
+    const FrameDiff& GetFrameDiff() const { return diff_; }
+    uint32_t GetBusySubmitCount() const { return busy_submit_count_; }
+    uint32_t GetErrorCount() const { return error_count_; }
+
+private:
+    IOledBus* bus_;
+    uint8_t* front_;
+    uint8_t* commands_;
+
+    FrameDiff diff_;
+    FrameDiff::Span spans_[FrameDiff::MAX_SPANS];
+    size_t segment_count_;               // 2 per span (address + data)
+    volatile size_t segment_index_;
+    std::atomic<bool> busy_;
+
+    const uint8_t* pending_frame_;
+    uint32_t busy_submit_count_;
+    volatile uint32_t error_count_;
+
+    bool StartSegment(size_t index);
+};
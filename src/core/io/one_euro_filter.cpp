@@ -0,0 +1,50 @@
+#include "one_euro_filter.h"
+#include <cmath>
+
+OneEuroFilter::OneEuroFilter()
+    : min_cutoff_hz_(1.0f), beta_(0.0f), derivative_cutoff_hz_(1.0f),
+      value_(0.0f), speed_(0.0f), primed_(false) {
+}
+
+void OneEuroFilter::Configure(float min_cutoff_hz, float beta, float derivative_cutoff_hz) {
+    min_cutoff_hz_ = min_cutoff_hz > 0.0f ? min_cutoff_hz : 0.01f;
+    beta_ = beta > 0.0f ? beta : 0.0f;
+    derivative_cutoff_hz_ = derivative_cutoff_hz > 0.0f ? derivative_cutoff_hz : 0.01f;
+}
+
+void OneEuroFilter::Reset() {
+    value_ = 0.0f;
+    speed_ = 0.0f;
+    primed_ = false;
+}
+
+void OneEuroFilter::Reset(float value) {
+    value_ = value;
+    speed_ = 0.0f;
+    primed_ = true;
+}
+
+float OneEuroFilter::Process(float value, float dt_s) {
+    if (!primed_ || dt_s <= 0.0f) {
+        // First sample (or no time passed) - nothing to smooth against
+        if (!primed_) {
+            Reset(value);
+        }
+        return value_;
+    }
+
+    // Smoothed speed drives the cutoff
+    float raw_speed = (value - value_) / dt_s;
+    speed_ += Alpha(derivative_cutoff_hz_, dt_s) * (raw_speed - speed_);
+
+    float cutoff_hz = min_cutoff_hz_ + beta_ * fabsf(speed_);
+    value_ += Alpha(cutoff_hz, dt_s) * (value - value_);
+    return value_;
+}
+
+float OneEuroFilter::Alpha(float cutoff_hz, float dt_s) {
+    // One-pole smoothing factor for a cutoff frequency at this sample interval
+    static constexpr float TWO_PI = 6.28318530718f;
+    float tau = 1.0f / (TWO_PI * cutoff_hz);
+    return 1.0f / (1.0f + tau / dt_s);
+}
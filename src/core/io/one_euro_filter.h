@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * One-Euro filter parameters
+ */
+struct OneEuroTuning {
+    float min_cutoff_hz;
+    float beta;
+    float derivative_cutoff_hz;
+};
+
+// Tuning for normalized (0-1) ADC readings at ~1 kHz, shared with the replay tool.
+// Joystick: +-0.5% ADC noise at rest -> ~0.06% p-p, ~5 ms extra lag on a fast flick.
+static constexpr OneEuroTuning JOYSTICK_FILTER_TUNING = {1.0f, 2.0f, 1.0f};
+static constexpr OneEuroTuning VOLUME_FILTER_TUNING = {0.5f, 1.0f, 1.0f};
+
+/**
+ * One-Euro Filter - Speed-adaptive low-pass for control inputs
+ *
+ * A one-pole low-pass whose cutoff rises with the (smoothed) speed of the
+ * signal: at rest the cutoff sits at min_cutoff_hz and jitter is smoothed
+ * away, when the input moves fast the cutoff opens up by beta * |speed| so
+ * lag stays low. Casiez, Roussel, Vogel - "1 Euro Filter" (CHI 2012).
+ */
+class OneEuroFilter {
+public:
+    OneEuroFilter();
+
+    // min_cutoff_hz: smoothing at rest, beta: cutoff gain per unit/s of speed,
+    // derivative_cutoff_hz: smoothing of the speed estimate
+    void Configure(float min_cutoff_hz, float beta, float derivative_cutoff_hz);
+    void Configure(const OneEuroTuning& tuning) {
+        Configure(tuning.min_cutoff_hz, tuning.beta, tuning.derivative_cutoff_hz);
+    }
+
+    // Start from value with no history (next Process() output = its input)
+    void Reset();
+    void Reset(float value);
+
+    // Filter one sample taken dt_s seconds after the previous one
+    float Process(float value, float dt_s);
+
+    float GetValue() const { return value_; }
+    float GetSpeed() const { return speed_; }   // Smoothed units per second
+
+    float GetMinCutoff() const { return min_cutoff_hz_; }
+    float GetBeta() const { return beta_; }
+    float GetDerivativeCutoff() const { return derivative_cutoff_hz_; }
+
+private:
+    float min_cutoff_hz_;
+    float beta_;
+    float derivative_cutoff_hz_;
+
+    float value_;
+    float speed_;
+    bool primed_;
+
+    static float Alpha(float cutoff_hz, float dt_s);
+};
@@ -0,0 +1,127 @@
+#include "page_blitter.h"
+#include <cstring>
+
+PackedFont::PackedFont()
+    : source_rows_(nullptr), columns_(nullptr), width_(0), height_(0) {
+}
+
+bool PackedFont::Init(const uint16_t* rows, uint8_t width, uint8_t height,
+                      uint32_t* storage, size_t storage_words) {
+    columns_ = nullptr;
+    source_rows_ = rows;
+    if (!rows || !storage || width == 0 || width > MAX_WIDTH ||
+        height == 0 || height > MAX_HEIGHT || storage_words < GLYPH_COUNT * width) {
+        return false;
+    }
+
+    // Transpose each glyph: row bit (15 - col) -> column bit row
+    for (size_t glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+        const uint16_t* glyph_rows = &rows[glyph * height];
+        uint32_t* glyph_columns = &storage[glyph * width];
+        for (uint8_t col = 0; col < width; col++) {
+            uint32_t bits = 0;
+            for (uint8_t row = 0; row < height; row++) {
+                if ((glyph_rows[row] << col) & 0x8000) {
+                    bits |= 1u << row;
+                }
+            }
+            glyph_columns[col] = bits;
+        }
+    }
+
+    width_ = width;
+    height_ = height;
+    columns_ = storage;
+    return true;
+}
+
+void PageBlitter::Fill(bool on) {
+    if (!buffer_) return;
+    memset(buffer_, on ? 0xFF : 0x00, WIDTH * PAGE_COUNT);
+}
+
+void PageBlitter::FillRect(int x0, int y0, int x1, int y1, bool on) {
+    if (!buffer_) return;
+    if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+    if (x1 < 0 || y1 < 0 || x0 >= WIDTH || y0 >= HEIGHT) return;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= WIDTH) x1 = WIDTH - 1;
+    if (y1 >= HEIGHT) y1 = HEIGHT - 1;
+
+    size_t width = static_cast<size_t>(x1 - x0 + 1);
+    int first_page = y0 >> 3;
+    int last_page = y1 >> 3;
+    for (int page = first_page; page <= last_page; page++) {
+        // Bits of this page inside [y0, y1]
+        uint8_t mask = 0xFF;
+        if (page == first_page) mask &= static_cast<uint8_t>(0xFF << (y0 & 7));
+        if (page == last_page) mask &= static_cast<uint8_t>(0xFF >> (7 - (y1 & 7)));
+
+        uint8_t* row = &buffer_[page * WIDTH + x0];
+        if (mask == 0xFF) {
+            memset(row, on ? 0xFF : 0x00, width);
+        } else if (on) {
+            for (size_t i = 0; i < width; i++) row[i] |= mask;
+        } else {
+            for (size_t i = 0; i < width; i++) row[i] &= static_cast<uint8_t>(~mask);
+        }
+    }
+}
+
+bool PageBlitter::DrawGlyph(int x, int y, char ch, const PackedFont& font, bool on) {
+    if (!buffer_) return false;
+    const uint32_t* columns = font.GetGlyph(ch);
+    if (!columns) return false;
+
+    int width = font.GetWidth();
+    int height = font.GetHeight();
+    if (x < 0 || y < 0 || WIDTH < x + width || HEIGHT < y + height) return false;
+
+    uint32_t cell = height >= 32 ? 0xFFFFFFFFu : ((1u << height) - 1);
+
+    // Byte-aligned cell of whole pages: one store per page per column
+    if ((y & 7) == 0 && (height & 7) == 0) {
+        int pages = height >> 3;
+        uint8_t* dest = &buffer_[(y >> 3) * WIDTH + x];
+        for (int col = 0; col < width; col++) {
+            uint32_t bits = on ? columns[col] : ~columns[col];
+            for (int p = 0; p < pages; p++) {
+                dest[p * WIDTH + col] = static_cast<uint8_t>(bits >> (p * 8));
+            }
+        }
+        return true;
+    }
+
+    for (int col = 0; col < width; col++) {
+        uint32_t bits = (on ? columns[col] : ~columns[col]) & cell;
+        WriteColumnBits(x + col, y, bits, cell);
+    }
+    return true;
+}
+
+void PageBlitter::WriteColumnBits(int x, int y, uint32_t bits, uint32_t mask) {
+    // Cell may start mid-page: shift into up to five pages and merge with the mask
+    int shift = y & 7;
+    uint64_t shifted_bits = static_cast<uint64_t>(bits) << shift;
+    uint64_t shifted_mask = static_cast<uint64_t>(mask) << shift;
+    uint8_t* dest = &buffer_[(y >> 3) * WIDTH + x];
+    for (int page = y >> 3; page < PAGE_COUNT && shifted_mask != 0; page++) {
+        uint8_t byte_mask = static_cast<uint8_t>(shifted_mask);
+        *dest = static_cast<uint8_t>((*dest & ~byte_mask) | (static_cast<uint8_t>(shifted_bits) & byte_mask));
+        shifted_bits >>= 8;
+        shifted_mask >>= 8;
+        dest += WIDTH;
+    }
+}
+
+int PageBlitter::DrawString(int x, int y, const char* text, const PackedFont& font, bool on) {
+    if (!text) return x;
+    while (*text) {
+        if (!DrawGlyph(x, y, *text, font, on)) break;
+        x += font.GetWidth();
+        text++;
+    }
+    return x;
+}
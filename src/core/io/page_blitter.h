@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Packed Font - Glyphs stored as columns for page-format drawing
+ *
+ * Built once from a row-major font (libDaisy FontDef layout: one uint16_t
+ * per glyph row, leftmost pixel in bit 15, glyphs ' ' to '~'). Each glyph
+ * becomes one uint32_t per column with row 0 in bit 0, which is how the
+ * SSD1306 stores pixels (vertical bytes, LSB at the top), so drawing is a
+ * shift and a byte write per page instead of a pixel at a time.
+ *
+ * Column storage is supplied by the caller (GLYPH_COUNT * width words).
+ */
+class PackedFont {
+public:
+    static constexpr char FIRST_CHAR = 32;
+    static constexpr char LAST_CHAR = 126;
+    static constexpr size_t GLYPH_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+    static constexpr uint8_t MAX_WIDTH = 16;
+    static constexpr uint8_t MAX_HEIGHT = 32;
+
+    PackedFont();
+
+    // rows: GLYPH_COUNT * height words. Returns false if the size is unsupported.
+    bool Init(const uint16_t* rows, uint8_t width, uint8_t height,
+              uint32_t* storage, size_t storage_words);
+    bool IsReady() const { return columns_ != nullptr; }
+
+    uint8_t GetWidth() const { return width_; }
+    uint8_t GetHeight() const { return height_; }
+
+    // Columns of a glyph (width words), nullptr if ch has no glyph
+    const uint32_t* GetGlyph(char ch) const {
+        if (!columns_ || ch < FIRST_CHAR || ch > LAST_CHAR) return nullptr;
+        return &columns_[static_cast<size_t>(ch - FIRST_CHAR) * width_];
+    }
+
+    // Source rows it was built from (lets callers match it to a font)
+    const uint16_t* GetSourceRows() const { return source_rows_; }
+
+private:
+    const uint16_t* source_rows_;
+    uint32_t* columns_;
+    uint8_t width_;
+    uint8_t height_;
+};
+
+/**
+ * Page Blitter - Byte-wise drawing into a 128x64 SSD1306 page-format buffer
+ *
+ * The buffer is 8 pages of 128 column bytes (bit 0 = top row of the page),
+ * the layout of the OLED driver's framebuffer. Text on a page boundary is
+ * written a whole byte per glyph column; other positions shift the column
+ * and merge it into two or three pages with a mask. Rects and lines fill
+ * whole bytes and only mask the top and bottom pages.
+ *
+ * Text matches OledDisplay::WriteString pixel for pixel: glyph cells are
+ * opaque (off pixels are cleared), a glyph that doesn't fit is not drawn and
+ * ends the string. Coordinates are clipped to the screen.
+ */
+class PageBlitter {
+public:
+    static constexpr int WIDTH = 128;
+    static constexpr int HEIGHT = 64;
+    static constexpr int PAGE_COUNT = HEIGHT / 8;
+
+    PageBlitter() : buffer_(nullptr) {}
+
+    void Init(uint8_t* buffer) { buffer_ = buffer; }
+    bool IsReady() const { return buffer_ != nullptr; }
+
+    void Fill(bool on);
+
+    // Inclusive corners, any order
+    void FillRect(int x0, int y0, int x1, int y1, bool on);
+    void HLine(int x0, int x1, int y, bool on) { FillRect(x0, y, x1, y, on); }
+    void VLine(int x, int y0, int y1, bool on) { FillRect(x, y0, x, y1, on); }
+
+    // Returns false (nothing drawn) if there is no glyph or it doesn't fit
+    bool DrawGlyph(int x, int y, char ch, const PackedFont& font, bool on);
+
+    // Draws until the end of text or the first glyph that can't be drawn;
+    // returns the x after the last glyph drawn
+    int DrawString(int x, int y, const char* text, const PackedFont& font, bool on);
+
+private:
+    uint8_t* buffer_;
+
+    void WriteColumnBits(int x, int y, uint32_t bits, uint32_t mask);
+};
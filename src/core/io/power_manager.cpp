@@ -47,11 +47,38 @@ void PowerManager::ReportAudioActivity() {
     }
 }
 
-uint32_t PowerManager::Update() {
-    if (!hw_) return MAIN_LOOP_NORMAL_MS;
+void PowerManager::Update() {
+    if (!hw_) return;
     
     UpdatePowerMode();
-    return GetMainLoopInterval();
+}
+
+uint32_t PowerManager::Idle(uint32_t max_sleep_us) {
+    int mode = static_cast<int>(current_mode_);
+    uint32_t start = daisy::System::GetUs();
+    idle_monitor_.RecordElapsed(mode, start);
+    
+    if (max_sleep_us >= MIN_SLEEP_US) {
+        uint32_t now = start;
+        while (now - start < max_sleep_us) {
+            // Check and sleep with interrupts masked so a request can't slip in
+            // between the check and WFI (a pending interrupt still ends WFI)
+            __disable_irq();
+            if (idle_monitor_.HasPendingWork()) {
+                __enable_irq();
+                break;
+            }
+            idle_monitor_.ArmWake();
+            uint32_t sleep_start = daisy::System::GetUs();
+            __WFI();
+            now = daisy::System::GetUs();
+            __enable_irq();  // The waking interrupt runs here
+            
+            idle_monitor_.RecordSleep(mode, now - sleep_start);
+        }
+    }
+    
+    return idle_monitor_.TakePendingWork();
 }
 
 void PowerManager::UpdatePowerMode() {
@@ -96,16 +123,6 @@ PowerManager::PowerMode PowerManager::DeterminePowerMode() const {
     return PowerMode::IDLE;
 }
 
-uint32_t PowerManager::GetMainLoopInterval() const {
-    switch (current_mode_) {
-        case PowerMode::IDLE:   return MAIN_LOOP_IDLE_MS;
-        case PowerMode::LOW:    return MAIN_LOOP_LOW_MS;
-        case PowerMode::NORMAL: return MAIN_LOOP_NORMAL_MS;
-        case PowerMode::ACTIVE: return MAIN_LOOP_ACTIVE_MS;
-        default:                return MAIN_LOOP_NORMAL_MS;
-    }
-}
-
 uint32_t PowerManager::GetADCInterval() const {
     switch (current_mode_) {
         case PowerMode::IDLE:   return ADC_IDLE_MS;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "daisy_seed.h"
+#include "idle_monitor.h"
 #include <cstdint>
 
 namespace OpenChord {
@@ -11,7 +12,12 @@ namespace OpenChord {
  * Tracks system activity and adjusts update rates dynamically:
  * - Reduces update frequencies when idle
  * - Increases frequencies when active
- * - Manages adaptive timing for main loop
+ * - Sleeps the core (WFI) between scheduled tasks instead of spinning
+ *
+ * Idle() sleeps until the next task deadline or until an interrupt leaves
+ * work for the main loop (key edge, received MIDI). Other interrupts (audio
+ * DMA, timers) are serviced and the core goes back to sleep. Wake-up sources
+ * and per-mode sleep residency are kept in the IdleMonitor.
  */
 class PowerManager {
 public:
@@ -34,14 +40,21 @@ public:
     void ReportUserInput();
     void ReportAudioActivity();
     
-    // Update - call from main loop, returns recommended delay time
-    uint32_t Update();
+    // Update - call periodically to re-evaluate the power mode
+    void Update();
+    
+    // Sleep until max_sleep_us has passed or an interrupt requested work.
+    // Returns the IdleMonitor::WakeBit() mask of sources that requested work.
+    uint32_t Idle(uint32_t max_sleep_us);
+    
+    // Wake-up and residency tracking (interrupts report wakes through this)
+    IdleMonitor* GetIdleMonitor() { return &idle_monitor_; }
+    const IdleMonitor& GetIdleStats() const { return idle_monitor_; }
     
     // Get current power mode
     PowerMode GetPowerMode() const { return current_mode_; }
     
     // Get recommended update intervals (in milliseconds)
-    uint32_t GetMainLoopInterval() const;
     uint32_t GetADCInterval() const;
     uint32_t GetDisplayInterval() const;
     // Note: Digital I/O always updates at high frequency (not power-managed) for proper debouncing
@@ -67,6 +80,10 @@ private:
     PowerMode current_mode_;
     uint32_t mode_change_time_;
     
+    // Idle sleep
+    IdleMonitor idle_monitor_;
+    static constexpr uint32_t MIN_SLEEP_US = 20;            // Shorter waits aren't worth a WFI
+    
     // Activity thresholds (in milliseconds)
     static constexpr uint32_t IDLE_THRESHOLD_MS = 5000;      // 5 seconds of no activity = IDLE
     static constexpr uint32_t LOW_THRESHOLD_MS = 2000;      // 2 seconds of no activity = LOW
@@ -74,11 +91,6 @@ private:
     static constexpr uint32_t BOOT_PERIOD_MS = 3000;        // 3 seconds after init - stay in NORMAL mode
     
     // Update intervals per mode (in milliseconds)
-    static constexpr uint32_t MAIN_LOOP_IDLE_MS = 10;       // 100 Hz when idle
-    static constexpr uint32_t MAIN_LOOP_LOW_MS = 5;         // 200 Hz when low
-    static constexpr uint32_t MAIN_LOOP_NORMAL_MS = 1;      // 1 kHz when normal
-    static constexpr uint32_t MAIN_LOOP_ACTIVE_MS = 1;      // 1 kHz when active
-    
     static constexpr uint32_t ADC_IDLE_MS = 100;             // 10 Hz when idle
     static constexpr uint32_t ADC_LOW_MS = 50;               // 20 Hz when low
     static constexpr uint32_t ADC_NORMAL_MS = 10;            // 100 Hz when normal
@@ -143,3 +143,66 @@ void StorageManager::Shutdown() {
     card_present_ = false;
     hw_ = nullptr;
 }
+
+bool StorageManager::OpenFile(const char* path, bool write, StorageFile* file) {
+    if (!file || !path || !mounted_) return false;
+    file->Close();
+    
+    BYTE mode = write ? (FA_WRITE | FA_READ | FA_CREATE_ALWAYS) : FA_READ;
+    FRESULT result = f_open(&file->file_, path, mode);
+    file->open_ = result == FR_OK;
+    return file->open_;
+}
+
+bool StorageManager::MakeDirectory(const char* path) {
+    if (!path || !mounted_) return false;
+    
+    FRESULT result = f_mkdir(path);
+    return result == FR_OK || result == FR_EXIST;
+}
+
+bool StorageManager::OpenMidiFile(const char* name, bool write, StorageFile* file) {
+    if (!name || !mounted_) return false;
+    
+    // GetSDPath() ends with the separator ("0:/")
+    char path[MAX_PATH_LENGTH];
+    const char* sd_path = fsi_.GetSDPath();
+    snprintf(path, sizeof(path), "%s%s", sd_path, MIDI_DIRECTORY);
+    if (write && !MakeDirectory(path)) return false;
+    
+    int length = snprintf(path, sizeof(path), "%s%s/%s", sd_path, MIDI_DIRECTORY, name);
+    if (length < 0 || static_cast<size_t>(length) >= sizeof(path)) return false;
+    return OpenFile(path, write, file);
+}
+
+StorageFile::StorageFile()
+    : open_(false) {
+}
+
+StorageFile::~StorageFile() {
+    Close();
+}
+
+void StorageFile::Close() {
+    if (!open_) return;
+    f_close(&file_);
+    open_ = false;
+}
+
+size_t StorageFile::Read(void* data, size_t size) {
+    if (!open_) return 0;
+    UINT read = 0;
+    if (f_read(&file_, data, static_cast<UINT>(size), &read) != FR_OK) return 0;
+    return read;
+}
+
+size_t StorageFile::Write(const void* data, size_t size) {
+    if (!open_) return 0;
+    UINT written = 0;
+    if (f_write(&file_, data, static_cast<UINT>(size), &written) != FR_OK) return 0;
+    return written;
+}
+
+bool StorageFile::Seek(uint32_t position) {
+    return open_ && f_lseek(&file_, position) == FR_OK;
+}
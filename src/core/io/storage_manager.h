@@ -2,7 +2,37 @@
 
 #include "daisy_seed.h"
 #include "fatfs.h"
+#include "file_stream.h"
 #include <cstdint>
+#include <cstddef>
+
+/**
+ * Storage File - An open file on the SD card
+ *
+ * Opened by StorageManager; reads and writes go straight to FatFS, so
+ * callers (e.g. SmfReader/SmfWriter) keep their own small buffers. Closed
+ * on destruction.
+ */
+class StorageFile : public OpenChord::IFileStream {
+public:
+    StorageFile();
+    ~StorageFile();
+
+    bool IsOpen() const { return open_; }
+    uint32_t GetSize() const { return open_ ? static_cast<uint32_t>(f_size(&file_)) : 0; }
+    void Close();
+
+    // IFileStream
+    size_t Read(void* data, size_t size) override;
+    size_t Write(const void* data, size_t size) override;
+    bool Seek(uint32_t position) override;
+
+private:
+    friend class StorageManager;
+
+    FIL file_;
+    bool open_;
+};
 
 /**
  * Storage Manager - Handles SD card operations and file management
@@ -32,13 +62,23 @@ public:
     // File system access
     FATFS* GetFileSystem() { return mounted_ ? &fsi_.GetSDFileSystem() : nullptr; }
     
+    // File operations (fail while the card isn't mounted). Paths include the
+    // drive (e.g. "0:/midi/loop.mid"); opening for writing creates or truncates
+    bool OpenFile(const char* path, bool write, StorageFile* file);
+    bool MakeDirectory(const char* path);   // True if it already exists
+    
+    // MIDI files live in 0:/midi/ (created on the first write)
+    bool OpenMidiFile(const char* name, bool write, StorageFile* file);
+    
     // TODO: Implement storage methods
-    // - File operations
     // - Audio file handling
     // - Configuration storage
     // - Error recovery
     
 private:
+    static constexpr const char* MIDI_DIRECTORY = "midi";
+    static constexpr size_t MAX_PATH_LENGTH = 64;
+    
     daisy::DaisySeed* hw_;
     bool healthy_;
     bool card_present_;
@@ -0,0 +1,215 @@
+#include "midi_clock_follower.h"
+#include <cmath>
+
+namespace OpenChord {
+
+MidiClockFollower::MidiClockFollower()
+    : transport_(nullptr)
+    , sample_rate_(48000.0f)
+    , enabled_(true)
+    , source_(0)
+    , clock_count_(0)
+    , last_clock_sample_(0)
+    , phase_offset_(0.0f)
+    , period_(0.0f)
+    , period_change_(0.0f)
+    , error_variance_(0.0f)
+    , large_error_count_(0)
+    , clock_index_(0)
+    , locked_(false)
+    , relock_count_(0)
+{
+}
+
+MidiClockFollower::~MidiClockFollower() {
+}
+
+void MidiClockFollower::Init(TransportClock* transport, float sample_rate) {
+    transport_ = transport;
+    if (sample_rate > 0.0f) {
+        sample_rate_ = sample_rate;
+    }
+}
+
+void MidiClockFollower::SetEnabled(bool enabled) {
+    if (enabled == enabled_) return;
+    enabled_ = enabled;
+    if (!enabled_) {
+        Reacquire();
+        source_ = 0;
+    }
+}
+
+void MidiClockFollower::ProcessEvent(const MidiEvent& event) {
+    if (!enabled_) return;
+
+    // Follow one source: the first to send clock, until it goes quiet
+    if (event.type == MidiEvent::CLOCK && source_ == 0) {
+        source_ = event.source;
+    }
+    if (source_ != 0 && event.source != source_) return;
+
+    switch (event.type) {
+        case MidiEvent::CLOCK:
+            ProcessClock(event.timestamp);
+            break;
+
+        case MidiEvent::START:
+            // The next clock is the downbeat: rebase so it becomes transport tick 0
+            clock_index_ = 0xFFFFFFFF;
+            if (locked_) {
+                PublishModel();
+            }
+            if (transport_) transport_->Start();
+            break;
+
+        case MidiEvent::CONTINUE:
+            if (transport_) transport_->Continue();
+            break;
+
+        case MidiEvent::STOP:
+            if (transport_) transport_->Stop();
+            break;
+
+        default:
+            break;
+    }
+}
+
+void MidiClockFollower::ProcessClock(uint32_t timestamp) {
+    clock_index_++;
+
+    if (clock_count_ == 0) {
+        last_clock_sample_ = timestamp;
+        phase_offset_ = 0.0f;
+        clock_count_ = 1;
+        return;
+    }
+
+    float elapsed = static_cast<float>(static_cast<int32_t>(timestamp - last_clock_sample_));
+    if (clock_count_ == 1) {
+        // Two clocks give the first period estimate
+        if (elapsed <= 0.0f) {
+            clock_index_--;
+            return;
+        }
+        period_ = elapsed;
+        period_change_ = 0.0f;
+        last_clock_sample_ = timestamp;
+        phase_offset_ = 0.0f;
+        clock_count_ = 2;
+        return;
+    }
+
+    // Clocks since the last one: 0 is a duplicate, more than 1 bridges missed
+    // clocks. Counted from the period rather than the prediction, so a tempo
+    // change the tracker hasn't caught up with yet isn't mistaken for either.
+    uint32_t steps = static_cast<uint32_t>(elapsed / period_ + 0.5f);
+    if (steps == 0) {
+        clock_index_--;
+        return;
+    }
+    if (steps > MAX_MISSED_CLOCKS + 1) {
+        Reacquire();
+        last_clock_sample_ = timestamp;
+        clock_count_ = 1;
+        return;
+    }
+    clock_index_ += steps - 1;
+
+    // Arrival error against the predicted time of this clock. Errors too large
+    // for jitter mean the tempo changed: restart the gain schedule to catch up.
+    const float t = static_cast<float>(steps);
+    float error = elapsed - (phase_offset_ + period_ * t + 0.5f * period_change_ * t * t);
+    if (fabsf(error) > period_ * RECONVERGE_ERROR) {
+        if (++large_error_count_ >= RECONVERGE_CLOCKS) {
+            clock_count_ = RECONVERGE_GAIN_CLOCKS;
+            large_error_count_ = 0;
+        }
+    } else {
+        large_error_count_ = 0;
+    }
+
+    // Least-squares gains while acquiring, then the steady-state gains
+    float n = static_cast<float>(clock_count_ + 1);
+    float alpha = 2.0f * (2.0f * n - 1.0f) / (n * (n + 1.0f));
+    float beta = 6.0f / (n * (n + 1.0f));
+    if (alpha < ALPHA) alpha = ALPHA;
+    if (beta < BETA) beta = BETA;
+
+    // Estimated time of this clock, kept relative to its arrival
+    phase_offset_ = -(1.0f - alpha) * error;
+    period_ += period_change_ * t + beta * error / t;
+    period_change_ += 2.0f * GAMMA * error / (t * t);
+    last_clock_sample_ = timestamp;
+    clock_count_++;
+    error_variance_ += ALPHA * (error * error - error_variance_);
+
+    // Lost if the estimate leaves the tempo range the transport supports
+    float tempo = GetTempo();
+    if (tempo < TransportClock::MIN_TEMPO * 0.5f || tempo > TransportClock::MAX_TEMPO * 1.5f) {
+        Reacquire();
+        return;
+    }
+
+    if (!locked_ && clock_count_ >= LOCK_CLOCKS) {
+        SetLocked(true);
+    }
+    if (locked_) {
+        PublishModel();
+    }
+}
+
+void MidiClockFollower::Update(uint32_t now_sample) {
+    if (clock_count_ == 0) return;
+
+    // Quiet for longer than the bridgeable gap (or half a second before a period is known)
+    float limit = clock_count_ >= 2 ? period_ * (MAX_MISSED_CLOCKS + 1) : sample_rate_ * 0.5f;
+    float quiet = static_cast<float>(static_cast<int32_t>(now_sample - last_clock_sample_));
+    if (quiet > limit) {
+        Reacquire();
+        source_ = 0;
+    }
+}
+
+void MidiClockFollower::Reacquire() {
+    if (locked_) {
+        relock_count_++;
+    }
+    SetLocked(false);
+    clock_count_ = 0;
+    phase_offset_ = 0.0f;
+    error_variance_ = 0.0f;
+    large_error_count_ = 0;
+}
+
+void MidiClockFollower::PublishModel() {
+    if (!transport_ || period_ <= 0.0f) return;
+
+    float tempo = GetTempo();
+    if (tempo < TransportClock::MIN_TEMPO) tempo = TransportClock::MIN_TEMPO;
+    if (tempo > TransportClock::MAX_TEMPO) tempo = TransportClock::MAX_TEMPO;
+
+    uint32_t clock_sample = last_clock_sample_ + static_cast<uint32_t>(static_cast<int32_t>(lroundf(phase_offset_)));
+    uint32_t interval_q16 = static_cast<uint32_t>(period_ * 65536.0f + 0.5f);
+    transport_->SetExternalModel(clock_index_, clock_sample, interval_q16, tempo);
+}
+
+void MidiClockFollower::SetLocked(bool locked) {
+    if (locked == locked_) return;
+    locked_ = locked;
+    if (transport_) {
+        transport_->SetFollowing(locked_);
+    }
+}
+
+float MidiClockFollower::GetTempo() const {
+    if (period_ <= 0.0f) return 0.0f;
+    return sample_rate_ * 60.0f / (period_ * TransportClock::PPQN);
+}
+
+float MidiClockFollower::GetJitterSamples() const {
+    return std::sqrt(error_variance_);
+}
+
+} // namespace OpenChord
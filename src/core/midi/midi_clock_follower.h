@@ -0,0 +1,94 @@
+#pragma once
+
+#include "midi_types.h"
+#include "../audio/transport_clock.h"
+#include <cstdint>
+
+namespace OpenChord {
+
+/**
+ * MidiClockFollower - Locks the internal transport to incoming MIDI clock
+ *
+ * Clock bytes are timestamped in the receive interrupt (sample time), so the
+ * follower sees when each clock arrived, not when the main loop got to it.
+ * An alpha-beta-gamma tracker (the steady-state Kalman filter of a tempo
+ * that changes smoothly, i.e. a third-order PLL) estimates when each clock
+ * was really sent, the clock period and how fast the period is changing, so
+ * tempo ramps are followed without lag. Gains start at the least-squares values and shrink
+ * to the steady-state gains, so lock is quick and per-clock jitter is then
+ * averaged out. Missed clocks are bridged, a long gap drops the lock.
+ *
+ * Once locked, the estimate drives TransportClock (SetExternalModel), and
+ * START/STOP/CONTINUE from the master start and stop it. Only the first
+ * source that sent clock is followed until it goes quiet.
+ *
+ * Runs in the main loop (MidiRouter).
+ */
+class MidiClockFollower {
+public:
+    // Steady-state gains: ~10 clock time constant, critically damped
+    // (beta = 2(2 - alpha) - 4 sqrt(1 - alpha), gamma = beta^2 / 2alpha)
+    static constexpr float ALPHA = 0.1f;
+    static constexpr float BETA = 0.0052668f;
+    static constexpr float GAMMA = 0.00013870f;
+
+    static constexpr uint32_t LOCK_CLOCKS = 24;            // One beat before driving the transport
+    static constexpr uint32_t MAX_MISSED_CLOCKS = 4;       // Longer gaps drop the lock
+
+    // Errors over a quarter period for three clocks in a row are a tempo
+    // change, not jitter: gains go back to their value after 8 clocks
+    static constexpr float RECONVERGE_ERROR = 0.25f;
+    static constexpr uint32_t RECONVERGE_CLOCKS = 3;
+    static constexpr uint32_t RECONVERGE_GAIN_CLOCKS = 8;
+
+    MidiClockFollower();
+    ~MidiClockFollower();
+
+    void Init(TransportClock* transport, float sample_rate);
+
+    // Off hands the transport back to its internal tempo
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return enabled_; }
+
+    // Clock, START, STOP and CONTINUE events (others are ignored)
+    void ProcessEvent(const MidiEvent& event);
+
+    // Call once per routing pass - drops the lock when the clock stops
+    void Update(uint32_t now_sample);
+
+    bool IsLocked() const { return locked_; }
+    float GetTempo() const;                  // Estimated master tempo (BPM)
+    float GetPeriodSamples() const { return period_; }
+    float GetJitterSamples() const;          // RMS clock arrival error vs the estimate
+    uint32_t GetClockIndex() const { return clock_index_; }
+    uint32_t GetRelockCount() const { return relock_count_; }
+
+private:
+    TransportClock* transport_;
+    float sample_rate_;
+    bool enabled_;
+
+    // Followed source (0 = none yet)
+    uint8_t source_;
+
+    // Tracker state: estimated time of the last clock is
+    // last_clock_sample_ + phase_offset_ (kept relative for float precision)
+    uint32_t clock_count_;        // Clocks since acquisition started
+    uint32_t last_clock_sample_;
+    float phase_offset_;
+    float period_;
+    float period_change_;         // Per clock (tempo ramps)
+    float error_variance_;
+    uint32_t large_error_count_;
+
+    uint32_t clock_index_;        // Index of the last clock since START
+    bool locked_;
+    uint32_t relock_count_;
+
+    void ProcessClock(uint32_t timestamp);
+    void Reacquire();
+    void PublishModel();
+    void SetLocked(bool locked);
+};
+
+} // namespace OpenChord
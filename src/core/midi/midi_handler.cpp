@@ -1,11 +1,22 @@
 #include "midi_handler.h"
 #include "daisy_seed.h"
 #include "../config.h"
+#include <cstring>
 
 namespace OpenChord {
 
 OpenChordMidiHandler::OpenChordMidiHandler() 
-    : usb_midi_initialized_(false), trs_midi_initialized_(false), hw_(nullptr) {
+    : usb_midi_initialized_(false)
+    , trs_midi_initialized_(false)
+    , usb_transfer_count_(0)
+    , tx_message_count_(0)
+    , trs_tx_byte_count_(0)
+    , trs_tx_bytes_saved_(0)
+    , usb_tx_busy_(false)
+    , realtime_dropped_count_(0)
+    , hw_(nullptr)
+    , sample_clock_(nullptr)
+    , idle_monitor_(nullptr) {
 }
 
 OpenChordMidiHandler::~OpenChordMidiHandler() {
@@ -16,125 +27,181 @@ void OpenChordMidiHandler::Init(daisy::DaisySeed* hw) {
     
     // Initialize USB MIDI only when not in debug mode
     #if DEBUG_MODE == false
-    daisy::MidiUsbHandler::Config usb_config;
+    daisy::MidiUsbTransport::Config usb_config;
     // Use EXTERNAL for external USB pins (D29/D30 = pins 36-37)
     // INTERNAL = micro USB port, EXTERNAL = external USB pins (D29/D30 = pins 36-37)
-    usb_config.transport_config.periph = daisy::MidiUsbTransport::Config::EXTERNAL;
-    usb_config.transport_config.tx_retry_count = 3;
+    usb_config.periph = daisy::MidiUsbTransport::Config::EXTERNAL;
+    usb_config.tx_retry_count = 3;
     
-    usb_midi_.Init(usb_config);
-    usb_midi_.StartReceive();
+    usb_transport_.Init(usb_config);
+    usb_transport_.StartRx(UsbRxCallback, this);
     usb_midi_initialized_ = true;
     #else
     usb_midi_initialized_ = false;
     #endif
     
-    // Initialize TRS MIDI using official Daisy Seed example pattern
-    daisy::MidiUartHandler::Config trs_config;
-    trs_config.transport_config.periph = daisy::UartHandler::Config::Peripheral::UART_4;
-    trs_config.transport_config.rx = daisy::Pin(daisy::PORTB, 8);  // PB8 = Pin 12
-    trs_config.transport_config.tx = daisy::Pin(daisy::PORTB, 9);  // PB9 = Pin 13
+    // Initialize TRS MIDI using official Daisy Seed example pins
+    daisy::MidiUartTransport::Config trs_config;
+    trs_config.periph = daisy::UartHandler::Config::Peripheral::UART_4;
+    trs_config.rx = daisy::Pin(daisy::PORTB, 8);  // PB8 = Pin 12
+    trs_config.tx = daisy::Pin(daisy::PORTB, 9);  // PB9 = Pin 13
     
-    trs_midi_.Init(trs_config);
-    trs_midi_.StartReceive();
+    trs_transport_.Init(trs_config);
+    trs_transport_.StartRx(TrsRxCallback, this);
     trs_midi_initialized_ = true;
 }
 
+void OpenChordMidiHandler::UsbRxCallback(uint8_t* data, size_t size, void* context) {
+    // Runs in the USB interrupt - timestamp and parse immediately
+    OpenChordMidiHandler* handler = static_cast<OpenChordMidiHandler*>(context);
+    if (!handler || !data) return;
+    
+    handler->usb_rx_queue_.ParseBytes(data, size, daisy::System::GetUs());
+    if (handler->idle_monitor_) {
+        handler->idle_monitor_->RequestWork(IdleMonitor::WAKE_MIDI_RX);
+    }
+}
+
+void OpenChordMidiHandler::TrsRxCallback(uint8_t* data, size_t size, void* context) {
+    // Runs in the UART interrupt - timestamp and parse immediately
+    OpenChordMidiHandler* handler = static_cast<OpenChordMidiHandler*>(context);
+    if (!handler || !data) return;
+    
+    handler->trs_rx_queue_.ParseBytes(data, size, daisy::System::GetUs());
+    if (handler->idle_monitor_) {
+        handler->idle_monitor_->RequestWork(IdleMonitor::WAKE_MIDI_RX);
+    }
+}
+
 void OpenChordMidiHandler::ProcessMidi() {
-    // Process MIDI from enabled sources and add to MidiHub
+    // Move received MIDI from enabled sources into the MidiHub
     if (usb_midi_initialized_) {
         ProcessUsbMidi();
     }
     if (trs_midi_initialized_) {
         ProcessTrsMidi();
     }
+    
+    // Transport clock bytes waiting for the UART (or a busy USB)
+    FlushRealtime();
 }
 
 void OpenChordMidiHandler::ProcessUsbMidi() {
     if (!usb_midi_initialized_) return;
     
-    // Keep MIDI listening active
-    usb_midi_.Listen();
-    
-    // Process any incoming MIDI events with safety limit
-    size_t event_count = 0;
-    const size_t MAX_EVENTS_PER_CALL = 64;  // Prevent infinite loops
-    
-    while (usb_midi_.HasEvents() && event_count < MAX_EVENTS_PER_CALL) {
-        daisy::MidiEvent event = usb_midi_.PopEvent();
-        AddToMidiHub(event, MidiHubEvent::Source::USB);
-        event_count++;
+    // Restart reception if the transport stopped (same recovery as MidiHandler::Listen)
+    if (!usb_transport_.RxActive()) {
+        usb_transport_.FlushRx();
+        usb_transport_.StartRx(UsbRxCallback, this);
     }
+    
+    DrainQueue(usb_rx_queue_, MidiEvent::SOURCE_USB);
 }
 
 void OpenChordMidiHandler::ProcessTrsMidi() {
     if (!trs_midi_initialized_) return;
     
-    // Process MIDI in the background (official Daisy Seed example pattern)
-    // Guard against freeze when TRS MIDI cable is plugged/unplugged
-    // Limit processing to prevent infinite loops if UART is in bad state
-    trs_midi_.Listen();
-    
-    // Loop through any MIDI Events with safety limit
-    // This prevents freeze if TRS MIDI UART gets stuck
-    size_t event_count = 0;
-    const size_t MAX_EVENTS_PER_CALL = 64;  // Prevent infinite loops
+    // Guard against a stuck UART when the TRS cable is plugged/unplugged:
+    // restart reception if the transport stopped (same recovery as MidiHandler::Listen)
+    if (!trs_transport_.RxActive()) {
+        trs_transport_.FlushRx();
+        trs_transport_.StartRx(TrsRxCallback, this);
+    }
     
-    while (trs_midi_.HasEvents() && event_count < MAX_EVENTS_PER_CALL) {
-        daisy::MidiEvent event = trs_midi_.PopEvent();
-        AddToMidiHub(event, MidiHubEvent::Source::TRS_IN);
-        event_count++;
+    DrainQueue(trs_rx_queue_, MidiEvent::SOURCE_TRS_IN);
+}
+
+void OpenChordMidiHandler::DrainQueue(MidiRxQueue& queue, MidiEvent::Source source) {
+    // Bounded by queue capacity - everything received so far is delivered
+    MidiRxEvent event;
+    while (queue.Pop(&event)) {
+        AddToMidiHub(event, source);
     }
 }
 
 
-void OpenChordMidiHandler::SendMidi(const MidiHubEvent& event) {
-    // Send to USB MIDI
-    if (usb_midi_initialized_) {
-        // Convert OpenChord MidiHubEvent to raw MIDI bytes and send
-        uint8_t midi_bytes[3];
-        size_t byte_count = 0;
-        ConvertToMidiBytes(event, midi_bytes, &byte_count);
-        
-        if (byte_count > 0) {
-            usb_midi_.SendMessage(midi_bytes, byte_count);
-        }
+void OpenChordMidiHandler::SendMidi(const MidiEvent& event) {
+    QueueMidi(event);
+    FlushMidi();
+}
+
+void OpenChordMidiHandler::QueueMidi(MidiEventSpan events) {
+    for (const MidiEvent& event : events) {
+        QueueMidi(event);
     }
+}
+
+void OpenChordMidiHandler::QueueMidi(const MidiEvent& event) {
+    // Convert once - the batch builds both the USB and TRS byte streams
+    uint8_t midi_bytes[3];
+    size_t byte_count = 0;
+    ConvertToMidiBytes(event, midi_bytes, &byte_count);
+    if (byte_count == 0) return;
     
-    // Send to TRS MIDI
-    if (trs_midi_initialized_) {
-        uint8_t midi_bytes[3];
-        size_t byte_count = 0;
-        ConvertToMidiBytes(event, midi_bytes, &byte_count);
-        
-        if (byte_count > 0) {
-            trs_midi_.SendMessage(midi_bytes, byte_count);
-        }
+    if (tx_batch_.IsFull()) {
+        FlushMidi();
     }
+    tx_batch_.Add(midi_bytes, byte_count);
 }
 
-void OpenChordMidiHandler::SendMidi(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-    MidiHubEvent event(type, channel, data0, data1);
-    SendMidi(event);
+void OpenChordMidiHandler::FlushMidi() {
+    if (tx_batch_.IsEmpty()) return;
+    
+    // Transport Tx takes non-const buffers, copy out of the batch
+    uint8_t bytes[MidiTxBatch::MAX_MESSAGES * MidiTxBatch::MAX_MESSAGE_BYTES];
+    
+    // USB Tx packs one message per call - anything after it would be lost.
+    // Real-time bytes from the audio callback wait until the last one is out.
+    if (usb_midi_initialized_) {
+        usb_tx_busy_.store(true, std::memory_order_release);
+        for (size_t i = 0; i < tx_batch_.GetMessageCount(); i++) {
+            size_t size = 0;
+            const uint8_t* message = tx_batch_.GetUsbMessage(i, &size);
+            std::memcpy(bytes, message, size);
+            usb_transport_.Tx(bytes, size);
+            usb_transfer_count_++;
+        }
+        usb_tx_busy_.store(false, std::memory_order_release);
+    }
+    
+    // One UART write, running status already applied
+    if (trs_midi_initialized_ && tx_batch_.GetTrsSize() > 0) {
+        std::memcpy(bytes, tx_batch_.GetTrsBytes(), tx_batch_.GetTrsSize());
+        trs_transport_.Tx(bytes, tx_batch_.GetTrsSize());
+        trs_tx_byte_count_ += tx_batch_.GetTrsSize();
+        trs_tx_bytes_saved_ += tx_batch_.GetTrsBytesSaved();
+    }
+    
+    tx_message_count_ += tx_batch_.GetMessageCount();
+    tx_batch_.Clear();
+    
+    // Clock bytes the audio callback deferred while the transfer was running
+    FlushRealtime();
 }
 
-void OpenChordMidiHandler::AddToMidiHub(const daisy::MidiEvent& event, MidiHubEvent::Source source) {
-    // Convert Daisy MidiEvent to OpenChord MidiHubEvent and add to hub
-    MidiHubEvent openchord_event;
-    openchord_event.type = event.type;
-    openchord_event.channel = event.channel;
-    openchord_event.data[0] = event.data[0];
-    openchord_event.data[1] = event.data[1];
-    openchord_event.source = source;
-    openchord_event.timestamp = hw_->system.GetNow();
+void OpenChordMidiHandler::AddToMidiHub(const MidiRxEvent& event, MidiEvent::Source source) {
+    // Status byte maps straight onto MidiEvent: channel messages split into
+    // type/channel, system messages keep the full status byte as the type
+    MidiEvent midi_event;
+    if (event.status >= 0xF0) {
+        midi_event.type = event.status;
+        midi_event.channel = 0;
+    } else {
+        midi_event.type = event.status & 0xF0;
+        midi_event.channel = event.status & 0x0F;
+    }
+    midi_event.data1 = event.data[0];
+    midi_event.data2 = event.data[1];
+    midi_event.source = source;
+    midi_event.timestamp = sample_clock_ ? sample_clock_->MicrosToSampleTime(event.timestamp_us) : 0;
     
     // Add to global MIDI hub based on source
     switch (source) {
-        case MidiHubEvent::Source::USB:
-            OpenChord::Midi::AddUsbInputEvent(openchord_event);
+        case MidiEvent::SOURCE_USB:
+            OpenChord::Midi::AddUsbInputEvent(midi_event);
             break;
-        case MidiHubEvent::Source::TRS_IN:
-            OpenChord::Midi::AddTrsInputEvent(openchord_event);
+        case MidiEvent::SOURCE_TRS_IN:
+            OpenChord::Midi::AddTrsInputEvent(midi_event);
             break;
         default:
             break;
@@ -144,52 +211,97 @@ void OpenChordMidiHandler::AddToMidiHub(const daisy::MidiEvent& event, MidiHubEv
 void OpenChordMidiHandler::SendSystemRealtime(uint8_t status_byte) {
     // System real-time messages are single-byte messages (0xF8-0xFF)
     // Valid transport messages: 0xFA (START), 0xFB (CONTINUE), 0xFC (STOP)
-    // Send directly as raw bytes (no channel or data bytes)
+    // Sent immediately along with anything queued (doesn't disturb running status)
     
-    uint8_t midi_byte = status_byte;
-    
-    // Send to USB MIDI
+    if (tx_batch_.IsFull()) {
+        FlushMidi();
+    }
+    tx_batch_.Add(&status_byte, 1);
+    FlushMidi();
+}
+
+void OpenChordMidiHandler::RealtimeOutputCallback(uint8_t status, uint32_t sample_time, void* context) {
+    // Runs in the audio callback - the byte goes out on the block its sample falls in
+    (void)sample_time;
+    OpenChordMidiHandler* handler = static_cast<OpenChordMidiHandler*>(context);
+    if (handler) {
+        handler->SendRealtimeFromAudio(status);
+    }
+}
+
+void OpenChordMidiHandler::SendRealtimeFromAudio(uint8_t status_byte) {
+    // Real-time bytes may go between any bytes of the stream, so they never
+    // disturb running status or a message the main loop is sending
     if (usb_midi_initialized_) {
-        usb_midi_.SendMessage(&midi_byte, 1);
+        // The audio callback preempts the main loop, never the other way round:
+        // if no transfer is running now, none starts before this one is done
+        if (!usb_tx_busy_.load(std::memory_order_acquire) && usb_realtime_.IsEmpty()) {
+            usb_transport_.Tx(&status_byte, 1);
+        } else if (!usb_realtime_.Push(status_byte)) {
+            realtime_dropped_count_++;
+        }
+    }
+    
+    if (trs_midi_initialized_ && !trs_realtime_.Push(status_byte)) {
+        realtime_dropped_count_++;
+    }
+}
+
+void OpenChordMidiHandler::FlushRealtime() {
+    uint8_t bytes[RealtimeFifo::CAPACITY];
+    
+    // Loop until empty: the audio callback queues instead of sending while busy.
+    // One Tx per byte, each is its own USB packet.
+    while (usb_midi_initialized_ && !usb_realtime_.IsEmpty()) {
+        usb_tx_busy_.store(true, std::memory_order_release);
+        size_t count = usb_realtime_.PopAll(bytes);
+        for (size_t i = 0; i < count; i++) {
+            usb_transport_.Tx(&bytes[i], 1);
+        }
+        usb_tx_busy_.store(false, std::memory_order_release);
     }
     
-    // Send to TRS MIDI
     if (trs_midi_initialized_) {
-        trs_midi_.SendMessage(&midi_byte, 1);
+        size_t count = trs_realtime_.PopAll(bytes);
+        if (count > 0) {
+            trs_transport_.Tx(bytes, count);
+            trs_tx_byte_count_ += count;
+        }
     }
 }
 
+bool OpenChordMidiHandler::RealtimeFifo::Push(uint8_t byte) {
+    uint32_t current_head = head.load(std::memory_order_relaxed);
+    if (current_head - tail.load(std::memory_order_acquire) >= CAPACITY) return false;
+    bytes[current_head & (CAPACITY - 1)] = byte;
+    head.store(current_head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t OpenChordMidiHandler::RealtimeFifo::PopAll(uint8_t* out) {
+    uint32_t current_tail = tail.load(std::memory_order_relaxed);
+    uint32_t current_head = head.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (current_tail != current_head) {
+        out[count++] = bytes[current_tail & (CAPACITY - 1)];
+        current_tail++;
+    }
+    tail.store(current_tail, std::memory_order_release);
+    return count;
+}
 
-void OpenChordMidiHandler::ConvertToMidiBytes(const MidiHubEvent& event, uint8_t* bytes, size_t* size) {
+void OpenChordMidiHandler::ConvertToMidiBytes(const MidiEvent& event, uint8_t* bytes, size_t* size) {
     *size = 0;
     
-    // Convert OpenChord MidiEvent to raw MIDI bytes
+    // Only channel voice messages the router generates are sent
     switch (event.type) {
-        case daisy::MidiMessageType::NoteOn:
-            bytes[0] = 0x90 | (event.channel & 0x0F);
-            bytes[1] = event.data[0];
-            bytes[2] = event.data[1];
-            *size = 3;
-            break;
-            
-        case daisy::MidiMessageType::NoteOff:
-            bytes[0] = 0x80 | (event.channel & 0x0F);
-            bytes[1] = event.data[0];
-            bytes[2] = event.data[1];
-            *size = 3;
-            break;
-            
-        case daisy::MidiMessageType::ControlChange:
-            bytes[0] = 0xB0 | (event.channel & 0x0F);
-            bytes[1] = event.data[0];
-            bytes[2] = event.data[1];
-            *size = 3;
-            break;
-            
-        case daisy::MidiMessageType::PitchBend:
-            bytes[0] = 0xE0 | (event.channel & 0x0F);
-            bytes[1] = event.data[0];  // LSB
-            bytes[2] = event.data[1];  // MSB
+        case MidiEvent::NOTE_ON:
+        case MidiEvent::NOTE_OFF:
+        case MidiEvent::CONTROL_CHANGE:
+        case MidiEvent::PITCH_BEND:  // data1 = LSB, data2 = MSB
+            bytes[0] = event.GetStatus();
+            bytes[1] = event.data1 & 0x7F;
+            bytes[2] = event.data2 & 0x7F;
             *size = 3;
             break;
             
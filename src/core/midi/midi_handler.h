@@ -3,12 +3,21 @@
 #include "daisy_seed.h"
 #include "hid/midi.h"
 #include "midi_interface.h"
+#include "midi_rx_queue.h"
+#include "midi_tx_batch.h"
+#include "../audio/sample_clock.h"
+#include "../io/idle_monitor.h"
+#include <atomic>
 
 namespace OpenChord {
 
 /**
  * Unified MIDI handler for both USB and TRS MIDI
  * Handles all MIDI input/output and routes to the global MidiHub
+ * 
+ * Input is parsed inside the USB/UART receive interrupts into timestamped
+ * lock-free queues, so incoming notes are not delayed by the main loop.
+ * ProcessMidi() drains the queues into the MidiHub.
  */
 class OpenChordMidiHandler {
 public:
@@ -18,41 +27,110 @@ public:
     // Initialization
     void Init(daisy::DaisySeed* hw);
     
-    // MIDI processing (called by system)
+    // Timebase for received event timestamps (receive time in samples).
+    // Without a clock, timestamps stay 0.
+    void SetSampleClock(const SampleClock* clock) { sample_clock_ = clock; }
+    const SampleClock* GetSampleClock() const { return sample_clock_; }
+    
+    // Receive interrupts request main loop work here (ends the idle sleep)
+    void SetIdleMonitor(IdleMonitor* monitor) { idle_monitor_ = monitor; }
+    
+    // MIDI processing (called by system) - drains receive queues into MidiHub
     void ProcessMidi();
     
+    // Receive diagnostics
+    uint32_t GetRxDroppedCount() const { return usb_rx_queue_.GetDroppedCount() + trs_rx_queue_.GetDroppedCount(); }
+    
     // Status queries
     bool IsUsbInitialized() const { return usb_midi_initialized_; }
     bool IsTrsInitialized() const { return trs_midi_initialized_; }
     
-    // MIDI output
-    void SendMidi(const MidiHubEvent& event);
-    void SendMidi(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1);
+    // MIDI output (sent immediately, together with anything already queued)
+    void SendMidi(const MidiEvent& event);
+    
+    // Batched MIDI output - queue events during a routing pass, then flush once:
+    // one USB packet (Tx call) per message and one running-status UART write of
+    // the whole batch. Queue flushes by itself when the batch is full.
+    void QueueMidi(const MidiEvent& event);
+    void QueueMidi(MidiEventSpan events);
+    void FlushMidi();
+    
+    // Transmit diagnostics
+    uint32_t GetUsbTransferCount() const { return usb_transfer_count_; }  // USB Tx calls for queued messages
+    uint32_t GetTxMessageCount() const { return tx_message_count_; }
+    uint32_t GetTrsTxByteCount() const { return trs_tx_byte_count_; }
+    uint32_t GetTrsTxBytesSaved() const { return trs_tx_bytes_saved_; }
     
     // System real-time messages (single-byte messages: START, STOP, CONTINUE)
     void SendSystemRealtime(uint8_t status_byte);  // Status byte: 0xFA (START), 0xFB (CONTINUE), 0xFC (STOP)
     
+    // Real-time bytes from the audio callback (TransportClock output).
+    // USB sends at once unless the main loop is mid-transfer, then the byte
+    // follows that transfer. TRS always waits for ProcessMidi(): a blocking
+    // UART byte (~320us) is longer than an audio block.
+    void SendRealtimeFromAudio(uint8_t status_byte);
+    static void RealtimeOutputCallback(uint8_t status, uint32_t sample_time, void* context);
+    uint32_t GetRealtimeDroppedCount() const { return realtime_dropped_count_; }
+    
 private:
-    // USB MIDI
-    daisy::MidiUsbHandler usb_midi_;
+    // Single producer (audio callback) / single consumer (main loop) byte queue
+    struct RealtimeFifo {
+        static constexpr uint32_t CAPACITY = 16;  // Must be a power of two
+        uint8_t bytes[CAPACITY];
+        std::atomic<uint32_t> head{0};
+        std::atomic<uint32_t> tail{0};
+        
+        bool IsEmpty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+        bool Push(uint8_t byte);
+        size_t PopAll(uint8_t* out);
+    };
+    
+
+    // USB MIDI (transport used directly so receive parsing runs in the interrupt)
+    daisy::MidiUsbTransport usb_transport_;
     bool usb_midi_initialized_;
     
-    // TRS MIDI - using MidiUartHandler as per official Daisy Seed example
-    daisy::MidiUartHandler trs_midi_;
+    // TRS MIDI (UART4, same pins as the official Daisy Seed example)
+    daisy::MidiUartTransport trs_transport_;
     bool trs_midi_initialized_;
     
+    // Receive queues (one per transport: single producer each)
+    MidiRxQueue usb_rx_queue_;
+    MidiRxQueue trs_rx_queue_;
+    
+    // Output batching
+    MidiTxBatch tx_batch_;
+    uint32_t usb_transfer_count_;
+    uint32_t tx_message_count_;
+    uint32_t trs_tx_byte_count_;
+    uint32_t trs_tx_bytes_saved_;
+    
+    // Real-time output from the audio callback
+    RealtimeFifo usb_realtime_;
+    RealtimeFifo trs_realtime_;
+    std::atomic<bool> usb_tx_busy_;    // Main loop is inside a USB transfer
+    uint32_t realtime_dropped_count_;
+    
     // Hardware reference
     daisy::DaisySeed* hw_;
+    const SampleClock* sample_clock_;
+    IdleMonitor* idle_monitor_;
+    
+    // Receive interrupt callbacks
+    static void UsbRxCallback(uint8_t* data, size_t size, void* context);
+    static void TrsRxCallback(uint8_t* data, size_t size, void* context);
     
     // MIDI processing methods
     void ProcessUsbMidi();
     void ProcessTrsMidi();
+    void DrainQueue(MidiRxQueue& queue, MidiEvent::Source source);
+    void FlushRealtime();
     
-    // Convert OpenChord MidiHubEvent to raw MIDI bytes
-    void ConvertToMidiBytes(const MidiHubEvent& event, uint8_t* bytes, size_t* size);
+    // Convert MidiEvent to raw MIDI bytes
+    void ConvertToMidiBytes(const MidiEvent& event, uint8_t* bytes, size_t* size);
     
     // Add events to MidiHub
-    void AddToMidiHub(const daisy::MidiEvent& event, MidiHubEvent::Source source);
+    void AddToMidiHub(const MidiRxEvent& event, MidiEvent::Source source);
 };
 
 } // namespace OpenChord
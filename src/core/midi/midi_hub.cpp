@@ -14,6 +14,7 @@ MidiHub::MidiHub()
     , trs_input_enabled_(true)
     , trs_output_enabled_(true)
     , generated_enabled_(true) {
+    generated_active_.store(0, std::memory_order_relaxed);
 }
 
 MidiHub::~MidiHub() {
@@ -27,109 +28,86 @@ MidiHub* MidiHub::GetInstance() {
     return instance_;
 }
 
-void MidiHub::AddUsbInputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-    MidiHubEvent event(type, channel, data0, data1, MidiHubEvent::Source::USB);
-    AddUsbInputEvent(event);
-}
-
-void MidiHub::AddTrsInputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-    MidiHubEvent event(type, channel, data0, data1, MidiHubEvent::Source::TRS_IN);
-    AddTrsInputEvent(event);
-}
-
-void MidiHub::AddTrsOutputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-    MidiHubEvent event(type, channel, data0, data1, MidiHubEvent::Source::TRS_OUT);
-    AddTrsOutputEvent(event);
-}
-
-void MidiHub::AddGeneratedEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-    MidiHubEvent event(type, channel, data0, data1, MidiHubEvent::Source::GENERATED);
-    AddGeneratedEvent(event);
-}
-
-void MidiHub::AddUsbInputEvent(const MidiHubEvent& event) {
+void MidiHub::AddUsbInputEvent(const MidiEvent& event) {
     if (!usb_input_enabled_) return;
-    
-    usb_input_events_.push_back(event);
-    
-    // Keep buffer size reasonable (last 1000 events)
-    if (usb_input_events_.size() > 1000) {
-        usb_input_events_.erase(usb_input_events_.begin());
-    }
+    usb_input_events_.Push(event);
 }
 
 void MidiHub::ClearUsbInputEvents() {
-    usb_input_events_.clear();
+    usb_input_events_.Clear();
 }
 
-void MidiHub::AddTrsInputEvent(const MidiHubEvent& event) {
+void MidiHub::AddTrsInputEvent(const MidiEvent& event) {
     if (!trs_input_enabled_) return;
-    
-    trs_input_events_.push_back(event);
-    
-    // Keep buffer size reasonable (last 1000 events)
-    if (trs_input_events_.size() > 1000) {
-        trs_input_events_.erase(trs_input_events_.begin());
-    }
+    trs_input_events_.Push(event);
 }
 
 void MidiHub::ClearTrsInputEvents() {
-    trs_input_events_.clear();
+    trs_input_events_.Clear();
 }
 
-void MidiHub::AddTrsOutputEvent(const MidiHubEvent& event) {
+void MidiHub::AddTrsOutputEvent(const MidiEvent& event) {
     if (!trs_output_enabled_) return;
-    
-    trs_output_buffer_.push_back(event);
-    
-    // Keep buffer size reasonable (last 1000 events)
-    if (trs_output_buffer_.size() > 1000) {
-        trs_output_buffer_.erase(trs_output_buffer_.begin());
-    }
+    trs_output_buffer_.Push(event);
 }
 
 void MidiHub::ClearTrsOutputBuffer() {
-    trs_output_buffer_.clear();
+    trs_output_buffer_.Clear();
 }
 
-void MidiHub::AddGeneratedEvent(const MidiHubEvent& event) {
+void MidiHub::AddGeneratedEvent(const MidiEvent& event) {
     if (!generated_enabled_) return;
-    
-    generated_events_.push_back(event);
-    
-    // Keep buffer size reasonable (last 1000 events)
-    if (generated_events_.size() > 1000) {
-        generated_events_.erase(generated_events_.begin());
-    }
+    generated_events_[generated_active_.load(std::memory_order_acquire)].Push(event);
 }
 
 void MidiHub::ClearGeneratedEvents() {
-    generated_events_.clear();
+    generated_events_[0].Clear();
+    generated_events_[1].Clear();
+}
+
+MidiEventSpan MidiHub::PeekGeneratedEvents() const {
+    return generated_events_[generated_active_.load(std::memory_order_acquire)].GetSpan();
 }
 
-void MidiHub::ConsumeGeneratedEvents(std::vector<MidiHubEvent>& out_events) {
-    // Move all generated events to output vector and clear
-    out_events = std::move(generated_events_);
-    generated_events_.clear();
+MidiEventSpan MidiHub::TakeGeneratedEvents() {
+    // The inactive list was handed out by the previous take and is done with -
+    // clear it and make it active. The audio callback adds a whole event before
+    // returning, so after the swap nothing writes to the list returned here.
+    uint32_t taken = generated_active_.load(std::memory_order_acquire);
+    uint32_t next = taken ^ 1;
+    generated_events_[next].Clear();
+    generated_active_.store(next, std::memory_order_release);
+    return generated_events_[taken].GetSpan();
 }
 
 void MidiHub::UpdateCombinedEvents() {
-    combined_events_.clear();
+    combined_events_.Clear();
     
     // Add USB input events first (external USB MIDI has priority)
-    combined_events_.insert(combined_events_.end(), usb_input_events_.begin(), usb_input_events_.end());
+    for (const MidiEvent& event : usb_input_events_.GetSpan()) {
+        combined_events_.Push(event);
+    }
     
     // Add TRS input events
-    combined_events_.insert(combined_events_.end(), trs_input_events_.begin(), trs_input_events_.end());
+    for (const MidiEvent& event : trs_input_events_.GetSpan()) {
+        combined_events_.Push(event);
+    }
     
     // Add generated events
-    combined_events_.insert(combined_events_.end(), generated_events_.begin(), generated_events_.end());
+    for (const MidiEvent& event : PeekGeneratedEvents()) {
+        combined_events_.Push(event);
+    }
     
-    // Sort by timestamp if needed
-    std::sort(combined_events_.begin(), combined_events_.end(), 
-              [](const MidiHubEvent& a, const MidiHubEvent& b) {
-                  return a.timestamp < b.timestamp;
-              });
+    // Sort by timestamp (stable, so same-time events keep source order)
+    std::stable_sort(combined_events_.events, combined_events_.events + combined_events_.count,
+                     [](const MidiEvent& a, const MidiEvent& b) {
+                         return static_cast<int32_t>(a.timestamp - b.timestamp) < 0;
+                     });
+}
+
+uint32_t MidiHub::GetDroppedEventCount() const {
+    return usb_input_events_.dropped + trs_input_events_.dropped + trs_output_buffer_.dropped
+         + generated_events_[0].dropped + generated_events_[1].dropped;
 }
 
 void MidiHub::SetMidiClock(uint32_t clock) {
@@ -142,75 +120,48 @@ void MidiHub::SetBPM(float bpm) {
 }
 
 void MidiHub::ClearAllEvents() {
-    usb_input_events_.clear();
-    trs_input_events_.clear();
-    trs_output_buffer_.clear();
-    generated_events_.clear();
-    combined_events_.clear();
+    usb_input_events_.Clear();
+    trs_input_events_.Clear();
+    trs_output_buffer_.Clear();
+    ClearGeneratedEvents();
+    combined_events_.Clear();
 }
 
 // Midi namespace function implementations
 namespace Midi {
 
-// Shared static empty vector to avoid dangling references
-static const std::vector<MidiHubEvent> kEmptyMidiEvents;
-
-const std::vector<MidiHubEvent>& GetUsbInputEvents() {
+MidiEventSpan GetUsbInputEvents() {
     MidiHub* hub = MidiHub::GetInstance();
-    if (hub) {
-        return hub->GetUsbInputEvents();
-    }
-    return kEmptyMidiEvents;
+    return hub ? hub->GetUsbInputEvents() : MidiEventSpan();
 }
 
-const std::vector<MidiHubEvent>& GetTrsInputEvents() {
+MidiEventSpan GetTrsInputEvents() {
     MidiHub* hub = MidiHub::GetInstance();
-    if (hub) {
-        return hub->GetTrsInputEvents();
-    }
-    return kEmptyMidiEvents;
+    return hub ? hub->GetTrsInputEvents() : MidiEventSpan();
 }
 
-const std::vector<MidiHubEvent>& GetTrsOutputBuffer() {
+MidiEventSpan GetTrsOutputBuffer() {
     MidiHub* hub = MidiHub::GetInstance();
-    if (hub) {
-        return hub->GetTrsOutputBuffer();
-    }
-    return kEmptyMidiEvents;
-}
-
-const std::vector<MidiHubEvent>& GetGeneratedEvents() {
-    MidiHub* hub = MidiHub::GetInstance();
-    if (hub) {
-        return hub->GetGeneratedEvents();
-    }
-    return kEmptyMidiEvents;
+    return hub ? hub->GetTrsOutputBuffer() : MidiEventSpan();
 }
 
-const std::vector<MidiHubEvent>& PeekGeneratedEvents() {
+MidiEventSpan PeekGeneratedEvents() {
     MidiHub* hub = MidiHub::GetInstance();
-    if (hub) {
-        return hub->PeekGeneratedEvents();
-    }
-    return kEmptyMidiEvents;
+    return hub ? hub->PeekGeneratedEvents() : MidiEventSpan();
 }
 
-void ConsumeGeneratedEvents(std::vector<MidiHubEvent>& out_events) {
+MidiEventSpan TakeGeneratedEvents() {
     MidiHub* hub = MidiHub::GetInstance();
-    if (hub) {
-        hub->ConsumeGeneratedEvents(out_events);
-    } else {
-        out_events.clear();
-    }
+    return hub ? hub->TakeGeneratedEvents() : MidiEventSpan();
 }
 
-const std::vector<MidiHubEvent>& GetCombinedEvents() {
+MidiEventSpan GetCombinedEvents() {
     MidiHub* hub = MidiHub::GetInstance();
     if (hub) {
         hub->UpdateCombinedEvents();
         return hub->GetCombinedEvents();
     }
-    return kEmptyMidiEvents;
+    return MidiEventSpan();
 }
 
 uint32_t GetMidiClock() {
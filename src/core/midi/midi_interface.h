@@ -1,33 +1,35 @@
 #pragma once
 
-#include <vector>
+#include <atomic>
 #include <cstdint>
-#include "daisy_seed.h"
-#include "hid/midi.h"
+#include <cstddef>
+#include "midi_types.h"
 
 namespace OpenChord {
 
-// MIDI event structure using Daisy's types directly
-// Note: This is separate from the plugin system's MidiEvent in midi_types.h
-// This one is used by MidiHub and MIDI handlers
-struct MidiHubEvent {
-    enum class Source {
-        USB,        // USB MIDI input
-        TRS_IN,     // TRS MIDI input
-        TRS_OUT,    // TRS MIDI output
-        GENERATED,  // Built-in controls
-        INTERNAL    // Internal processing
-    };
-    
-    daisy::MidiMessageType type;  // Use Daisy's type directly
-    uint8_t channel;
-    uint8_t data[2];
-    uint32_t timestamp; // System timestamp when event was received
-    Source source;       // Where this MIDI event came from
-    
-    MidiHubEvent() : type(daisy::MidiMessageType::NoteOff), channel(0), data{0, 0}, timestamp(0), source(Source::INTERNAL) {}
-    MidiHubEvent(daisy::MidiMessageType t, uint8_t ch, uint8_t d0, uint8_t d1, Source s = Source::INTERNAL, uint32_t ts = 0) 
-        : type(t), channel(ch), data{d0, d1}, timestamp(ts), source(s) {}
+/**
+ * Fixed-capacity list of MidiEvents (no heap, no reallocation)
+ * Events past capacity are dropped and counted.
+ */
+struct MidiEventList {
+    static constexpr size_t CAPACITY = 256;
+    
+    MidiEvent events[CAPACITY];
+    size_t count;
+    uint32_t dropped;
+    
+    MidiEventList() : count(0), dropped(0) {}
+    
+    bool Push(const MidiEvent& event) {
+        if (count >= CAPACITY) {
+            dropped++;
+            return false;
+        }
+        events[count++] = event;
+        return true;
+    }
+    void Clear() { count = 0; }
+    MidiEventSpan GetSpan() const { return MidiEventSpan(events, count); }
 };
 
 // Centralized MIDI data hub - accessible to all classes
@@ -36,14 +38,17 @@ private:
     static MidiHub* instance_;
     
     // Input MIDI events (from external sources)
-    std::vector<MidiHubEvent> usb_input_events_;
-    std::vector<MidiHubEvent> trs_input_events_;
+    MidiEventList usb_input_events_;
+    MidiEventList trs_input_events_;
     
     // Generated MIDI events (from built-in keys, etc.)
-    std::vector<MidiHubEvent> generated_events_;
+    // Double buffered: tracks add from the audio callback into the active
+    // list while the router reads the other one (see TakeGeneratedEvents)
+    MidiEventList generated_events_[2];
+    std::atomic<uint32_t> generated_active_;
     
     // Combined MIDI events (all inputs + generated)
-    std::vector<MidiHubEvent> combined_events_;
+    MidiEventList combined_events_;
     
     // MIDI clock and timing data
     uint32_t midi_clock_;
@@ -57,7 +62,7 @@ private:
     bool generated_enabled_;
     
     // TRS MIDI output buffer
-    std::vector<MidiHubEvent> trs_output_buffer_;
+    MidiEventList trs_output_buffer_;
     
 public:
     MidiHub();
@@ -67,39 +72,34 @@ public:
     static MidiHub* GetInstance();
     
     // USB MIDI handling
-    void AddUsbInputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1);
-    void AddUsbInputEvent(const MidiHubEvent& event);
+    void AddUsbInputEvent(const MidiEvent& event);
     void ClearUsbInputEvents();
-    const std::vector<MidiHubEvent>& GetUsbInputEvents() const { return usb_input_events_; }
+    MidiEventSpan GetUsbInputEvents() const { return usb_input_events_.GetSpan(); }
     
     // TRS MIDI input handling
-    void AddTrsInputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1);
-    void AddTrsInputEvent(const MidiHubEvent& event);
+    void AddTrsInputEvent(const MidiEvent& event);
     void ClearTrsInputEvents();
-    const std::vector<MidiHubEvent>& GetTrsInputEvents() const { return trs_input_events_; }
+    MidiEventSpan GetTrsInputEvents() const { return trs_input_events_.GetSpan(); }
     
     // TRS MIDI output handling
-    void AddTrsOutputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1);
-    void AddTrsOutputEvent(const MidiHubEvent& event);
+    void AddTrsOutputEvent(const MidiEvent& event);
     void ClearTrsOutputBuffer();
-    const std::vector<MidiHubEvent>& GetTrsOutputBuffer() const { return trs_output_buffer_; }
+    MidiEventSpan GetTrsOutputBuffer() const { return trs_output_buffer_.GetSpan(); }
     
-    // Generated MIDI handling
-    void AddGeneratedEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1);
-    void AddGeneratedEvent(const MidiHubEvent& event);
+    // Generated MIDI handling (AddGeneratedEvent is safe from the audio callback)
+    void AddGeneratedEvent(const MidiEvent& event);
     void ClearGeneratedEvents();
-    const std::vector<MidiHubEvent>& GetGeneratedEvents() const { return generated_events_; }
     
-    // Non-consuming read for generated events (for MIDI output)
-    // Returns events without removing them, so both audio and MIDI output can read
-    const std::vector<MidiHubEvent>& PeekGeneratedEvents() const { return generated_events_; }
+    // Non-consuming read of events generated since the last take
+    MidiEventSpan PeekGeneratedEvents() const;
     
-    // Consuming read - removes and returns events (for audio engine)
-    void ConsumeGeneratedEvents(std::vector<MidiHubEvent>& out_events);
+    // Consuming read (for MIDI output) - swaps the generated lists and returns
+    // everything added before the swap. The span stays valid until the next call.
+    MidiEventSpan TakeGeneratedEvents();
     
     // Combined MIDI access
     void UpdateCombinedEvents();
-    const std::vector<MidiHubEvent>& GetCombinedEvents() const { return combined_events_; }
+    MidiEventSpan GetCombinedEvents() const { return combined_events_.GetSpan(); }
     
     // MIDI timing
     void SetMidiClock(uint32_t clock);
@@ -119,11 +119,14 @@ public:
     bool IsGeneratedEnabled() const { return generated_enabled_; }
     
     // Utility functions
-    size_t GetUsbInputEventCount() const { return usb_input_events_.size(); }
-    size_t GetTrsInputEventCount() const { return trs_input_events_.size(); }
-    size_t GetTrsOutputEventCount() const { return trs_output_buffer_.size(); }
-    size_t GetGeneratedEventCount() const { return generated_events_.size(); }
-    size_t GetCombinedEventCount() const { return combined_events_.size(); }
+    size_t GetUsbInputEventCount() const { return usb_input_events_.count; }
+    size_t GetTrsInputEventCount() const { return trs_input_events_.count; }
+    size_t GetTrsOutputEventCount() const { return trs_output_buffer_.count; }
+    size_t GetGeneratedEventCount() const { return PeekGeneratedEvents().size; }
+    size_t GetCombinedEventCount() const { return combined_events_.count; }
+    
+    // Events lost because a list was full
+    uint32_t GetDroppedEventCount() const;
     
     // Clear all events
     void ClearAllEvents();
@@ -132,69 +135,44 @@ public:
 // Convenience namespace for easy MidiHub access
 namespace Midi {
     // USB MIDI input
-    inline void AddUsbInputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-        if (MidiHub* hub = MidiHub::GetInstance()) {
-            hub->AddUsbInputEvent(type, channel, data0, data1);
-        }
-    }
-    
-    inline void AddUsbInputEvent(const MidiHubEvent& event) {
+    inline void AddUsbInputEvent(const MidiEvent& event) {
         if (MidiHub* hub = MidiHub::GetInstance()) {
             hub->AddUsbInputEvent(event);
         }
     }
     
     // TRS MIDI input
-    inline void AddTrsInputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-        if (MidiHub* hub = MidiHub::GetInstance()) {
-            hub->AddTrsInputEvent(type, channel, data0, data1);
-        }
-    }
-    
-    inline void AddTrsInputEvent(const MidiHubEvent& event) {
+    inline void AddTrsInputEvent(const MidiEvent& event) {
         if (MidiHub* hub = MidiHub::GetInstance()) {
             hub->AddTrsInputEvent(event);
         }
     }
     
     // TRS MIDI output
-    inline void AddTrsOutputEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-        if (MidiHub* hub = MidiHub::GetInstance()) {
-            hub->AddTrsOutputEvent(type, channel, data0, data1);
-        }
-    }
-    
-    inline void AddTrsOutputEvent(const MidiHubEvent& event) {
+    inline void AddTrsOutputEvent(const MidiEvent& event) {
         if (MidiHub* hub = MidiHub::GetInstance()) {
             hub->AddTrsOutputEvent(event);
         }
     }
     
     // Generated MIDI
-    inline void AddGeneratedEvent(daisy::MidiMessageType type, uint8_t channel, uint8_t data0, uint8_t data1) {
-        if (MidiHub* hub = MidiHub::GetInstance()) {
-            hub->AddGeneratedEvent(type, channel, data0, data1);
-        }
-    }
-    
-    inline void AddGeneratedEvent(const MidiHubEvent& event) {
+    inline void AddGeneratedEvent(const MidiEvent& event) {
         if (MidiHub* hub = MidiHub::GetInstance()) {
             hub->AddGeneratedEvent(event);
         }
     }
     
-    // Get MIDI events by source
-    const std::vector<MidiHubEvent>& GetUsbInputEvents();
-    const std::vector<MidiHubEvent>& GetTrsInputEvents();
-    const std::vector<MidiHubEvent>& GetTrsOutputBuffer();
-    const std::vector<MidiHubEvent>& GetGeneratedEvents();
+    // Get MIDI events by source (views into the hub, no copy)
+    MidiEventSpan GetUsbInputEvents();
+    MidiEventSpan GetTrsInputEvents();
+    MidiEventSpan GetTrsOutputBuffer();
     
-    // Non-consuming read for generated events (for MIDI output)
-    const std::vector<MidiHubEvent>& PeekGeneratedEvents();
+    // Non-consuming read for generated events
+    MidiEventSpan PeekGeneratedEvents();
     
-    // Consuming read for generated events (for audio engine)
-    void ConsumeGeneratedEvents(std::vector<MidiHubEvent>& out_events);
-    const std::vector<MidiHubEvent>& GetCombinedEvents();
+    // Consuming read for generated events (for MIDI output)
+    MidiEventSpan TakeGeneratedEvents();
+    MidiEventSpan GetCombinedEvents();
     
     // MIDI timing
     uint32_t GetMidiClock();
@@ -0,0 +1,465 @@
+#include "midi_loop.h"
+
+namespace OpenChord {
+
+MidiLoop::MidiLoop()
+    : bank_count_{0, 0}
+    , bank_clear_count_{0, 0}
+    , published_bank_(0)
+    , audio_bank_(0)
+    , record_head_(0)
+    , record_tail_(0)
+    , record_discard_(0)
+    , merged_clear_count_(0)
+    , loading_(false)
+    , load_count_(0)
+    , command_(COMMAND_NONE)
+    , clear_requested_(false)
+    , clear_count_(0)
+    , load_requested_(false)
+    , load_length_(0)
+    , state_(static_cast<uint8_t>(State::EMPTY))
+    , length_(0)
+    , position_(0)
+    , loop_pos_(0)
+    , cursor_(0)
+    , audio_count_(0)
+    , dropped_count_(0)
+{
+    playing_notes_.Clear();
+    recording_notes_.Clear();
+}
+
+MidiLoop::~MidiLoop() {
+}
+
+void MidiLoop::ToggleRecord() {
+    command_.store(COMMAND_TOGGLE_RECORD, std::memory_order_release);
+}
+
+void MidiLoop::Play() {
+    command_.store(COMMAND_PLAY, std::memory_order_release);
+}
+
+void MidiLoop::Stop() {
+    command_.store(COMMAND_STOP, std::memory_order_release);
+}
+
+void MidiLoop::Clear() {
+    // Separate from the command so a record toggle right after still applies
+    clear_requested_.store(true, std::memory_order_release);
+}
+
+bool MidiLoop::IsRecording() const {
+    State state = GetState();
+    return state == State::RECORDING || state == State::OVERDUBBING;
+}
+
+size_t MidiLoop::GetEventCount() const {
+    return bank_count_[published_bank_.load(std::memory_order_acquire)];
+}
+
+void MidiLoop::Update() {
+    // The other bank is only free once the audio callback plays the published one
+    // (and while a load is filling it, recording waits in the queue)
+    const uint8_t published = published_bank_.load(std::memory_order_relaxed);
+    if (loading_ || audio_bank_.load(std::memory_order_acquire) != published) return;
+
+    // After a clear, drop what was recorded before it and start from nothing
+    bool cleared = false;
+    uint32_t clears = clear_count_.load(std::memory_order_acquire);
+    if (clears != merged_clear_count_) {
+        merged_clear_count_ = clears;
+        record_tail_.store(record_discard_.load(std::memory_order_relaxed), std::memory_order_release);
+        cleared = true;
+    }
+
+    // Take what was recorded since the last merge, sorted by position (stable,
+    // so a note-off and note-on on the same sample keep their order)
+    size_t batch_count = 0;
+    uint32_t tail = record_tail_.load(std::memory_order_relaxed);
+    const uint32_t head = record_head_.load(std::memory_order_acquire);
+    while (tail != head && batch_count < RECORD_QUEUE_SIZE) {
+        MidiEvent event = record_queue_[tail & (RECORD_QUEUE_SIZE - 1)];
+        tail++;
+        size_t i = batch_count++;
+        while (i > 0 && batch_[i - 1].timestamp > event.timestamp) {
+            batch_[i] = batch_[i - 1];
+            i--;
+        }
+        batch_[i] = event;
+    }
+    record_tail_.store(tail, std::memory_order_release);
+    if (batch_count == 0 && !cleared) return;
+
+    // Merge with the playing events into the other bank (older events first on a tie)
+    const MidiEvent* base = banks_[published];
+    const size_t base_count = cleared ? 0 : bank_count_[published];
+    const uint8_t spare = published ^ 1;
+    MidiEvent* out = banks_[spare];
+    size_t a = 0;
+    size_t b = 0;
+    size_t n = 0;
+    while (a < base_count || b < batch_count) {
+        const MidiEvent* next;
+        if (b >= batch_count || (a < base_count && base[a].timestamp <= batch_[b].timestamp)) {
+            next = &base[a++];
+        } else {
+            next = &batch_[b++];
+        }
+        if (n < CAPACITY) {
+            out[n++] = *next;
+        } else {
+            dropped_count_.store(dropped_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+    bank_count_[spare] = n;
+    bank_clear_count_[spare] = merged_clear_count_;
+    published_bank_.store(spare, std::memory_order_release);
+}
+
+bool MidiLoop::BeginLoad() {
+    if (loading_) return true;
+    const uint8_t published = published_bank_.load(std::memory_order_relaxed);
+    if (audio_bank_.load(std::memory_order_acquire) != published) return false;
+    loading_ = true;
+    load_count_ = 0;
+    return true;
+}
+
+bool MidiLoop::AddLoadedEvent(const MidiEvent& event) {
+    if (!loading_) return false;
+    if (!IsLoopEventType(event.type)) return true;
+    if (load_count_ >= CAPACITY) {
+        dropped_count_.store(dropped_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+    const uint8_t spare = published_bank_.load(std::memory_order_relaxed) ^ 1;
+    MidiEvent& slot = banks_[spare][load_count_++];
+    slot = event;
+    slot.source = MidiEvent::SOURCE_GENERATED;
+    return true;
+}
+
+void MidiLoop::EndLoad(uint32_t length) {
+    if (!loading_) return;
+    loading_ = false;
+    if (length == 0) length = 1;
+
+    // A note ending on the loop end (usual in a file) ends just before it; nothing else past it plays
+    const uint8_t spare = published_bank_.load(std::memory_order_relaxed) ^ 1;
+    MidiEvent* bank = banks_[spare];
+    size_t first_past = load_count_;
+    while (first_past > 0 && bank[first_past - 1].timestamp >= length) {
+        first_past--;
+    }
+    size_t kept = first_past;
+    for (size_t i = first_past; i < load_count_; i++) {
+        const MidiEvent& event = bank[i];
+        if (event.type == MidiEvent::NOTE_OFF || (event.type == MidiEvent::NOTE_ON && event.data2 == 0)) {
+            bank[kept] = event;
+            bank[kept].timestamp = length - 1;
+            kept++;
+        }
+    }
+    bank_count_[spare] = kept;
+
+    // Newer than any clear so far; what was recorded over the old loop is dropped
+    merged_clear_count_ = clear_count_.load(std::memory_order_acquire);
+    bank_clear_count_[spare] = merged_clear_count_;
+    record_tail_.store(record_head_.load(std::memory_order_acquire), std::memory_order_release);
+
+    // The audio callback stops the old loop and takes the length before playing the new bank
+    load_length_.store(length, std::memory_order_relaxed);
+    load_requested_.store(true, std::memory_order_release);
+    published_bank_.store(spare, std::memory_order_release);
+}
+
+void MidiLoop::CancelLoad() {
+    loading_ = false;
+    load_count_ = 0;
+}
+
+MidiEventSpan MidiLoop::GetEvents() const {
+    const uint8_t published = published_bank_.load(std::memory_order_acquire);
+    if (bank_clear_count_[published] != clear_count_.load(std::memory_order_acquire)) {
+        return MidiEventSpan();     // Cleared since it was merged
+    }
+    return MidiEventSpan(banks_[published], bank_count_[published]);
+}
+
+void MidiLoop::ProcessBlock(uint32_t block_start_sample, size_t block_size,
+                            MidiEvent* events, size_t* count, size_t max_events) {
+    const size_t input_count = *count;
+
+    if (clear_requested_.exchange(false, std::memory_order_acquire)) {
+        ApplyClear(block_start_sample, events, count, max_events);
+    }
+    SwitchBank();
+    // After the switch: a load seen there is applied before its bank plays a block
+    if (load_requested_.exchange(false, std::memory_order_acquire)) {
+        ApplyLoad(block_start_sample, block_size, events, count, max_events);
+    }
+    ApplyCommand(block_start_sample, block_size, events, count, max_events);
+
+    // Record the stack's own events before adding playback to them
+    State state = GetState();
+    if (state == State::RECORDING || state == State::OVERDUBBING) {
+        Record(block_start_sample, block_size, events, input_count);
+    }
+
+    if (state == State::RECORDING) {
+        loop_pos_ += static_cast<uint32_t>(block_size);
+    } else if (state == State::PLAYING || state == State::OVERDUBBING) {
+        Play(block_start_sample, block_size, events, count, max_events);
+    }
+    position_.store(loop_pos_, std::memory_order_relaxed);
+}
+
+void MidiLoop::ApplyClear(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events) {
+    ReleasePlayingNotes(block_start_sample, events, count, max_events);
+    recording_notes_.Clear();
+    SetState(State::EMPTY);
+    length_.store(0, std::memory_order_relaxed);
+    loop_pos_ = 0;
+    cursor_ = 0;
+    audio_count_ = 0;
+
+    // Update() discards everything queued so far and merges from an empty loop
+    record_discard_.store(record_head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    clear_count_.store(clear_count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void MidiLoop::ApplyLoad(uint32_t block_start_sample, size_t block_size,
+                         MidiEvent* events, size_t* count, size_t max_events) {
+    ReleasePlayingNotes(block_start_sample, events, count, max_events);
+    recording_notes_.Clear();
+    // At least a block long, like a recorded loop (a one-note file can end on its first sample)
+    uint32_t length = load_length_.load(std::memory_order_relaxed);
+    if (length < block_size) length = static_cast<uint32_t>(block_size);
+    length_.store(length, std::memory_order_relaxed);
+    loop_pos_ = 0;
+    cursor_ = 0;
+    SetState(State::STOPPED);
+}
+
+void MidiLoop::SwitchBank() {
+    const uint8_t published = published_bank_.load(std::memory_order_acquire);
+    if (published == audio_bank_.load(std::memory_order_relaxed)) return;
+
+    // A bank merged before the last clear holds the old loop
+    audio_count_ = bank_clear_count_[published] == clear_count_.load(std::memory_order_relaxed)
+                 ? bank_count_[published] : 0;
+    audio_bank_.store(published, std::memory_order_release);
+    cursor_ = LowerBound(loop_pos_);
+}
+
+void MidiLoop::ApplyCommand(uint32_t block_start_sample, size_t block_size,
+                            MidiEvent* events, size_t* count, size_t max_events) {
+    uint8_t command = command_.exchange(COMMAND_NONE, std::memory_order_acquire);
+    if (command == COMMAND_NONE) return;
+
+    const State state = GetState();
+    const uint32_t length = length_.load(std::memory_order_relaxed);
+    // Last position before this block, for closing an overdub pass
+    const uint32_t last_position = (loop_pos_ == 0 ? length : loop_pos_) - 1;
+
+    switch (command) {
+        case COMMAND_TOGGLE_RECORD:
+            if (state == State::EMPTY) {
+                loop_pos_ = 0;
+                recording_notes_.Clear();
+                SetState(State::RECORDING);
+            } else if (state == State::RECORDING) {
+                EndFirstPass(block_size);
+                SetState(State::PLAYING);
+            } else if (state == State::PLAYING) {
+                recording_notes_.Clear();
+                SetState(State::OVERDUBBING);
+            } else if (state == State::OVERDUBBING) {
+                CloseRecordedNotes(last_position);
+                SetState(State::PLAYING);
+            } else {
+                loop_pos_ = 0;
+                cursor_ = 0;
+                recording_notes_.Clear();
+                SetState(State::OVERDUBBING);
+            }
+            break;
+
+        case COMMAND_PLAY:
+            if (state == State::EMPTY || state == State::RECORDING) break;
+            ReleasePlayingNotes(block_start_sample, events, count, max_events);
+            loop_pos_ = 0;
+            cursor_ = 0;
+            if (state == State::STOPPED) {
+                SetState(State::PLAYING);
+            }
+            break;
+
+        case COMMAND_STOP:
+            if (state == State::RECORDING) {
+                EndFirstPass(block_size);
+                SetState(State::STOPPED);
+            } else if (state == State::PLAYING || state == State::OVERDUBBING) {
+                if (state == State::OVERDUBBING) {
+                    CloseRecordedNotes(last_position);
+                }
+                ReleasePlayingNotes(block_start_sample, events, count, max_events);
+                SetState(State::STOPPED);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void MidiLoop::EndFirstPass(size_t block_size) {
+    // At least a block long, so playback wraps at most once per block
+    uint32_t length = loop_pos_ > block_size ? loop_pos_ : static_cast<uint32_t>(block_size);
+    CloseRecordedNotes(length - 1);
+    length_.store(length, std::memory_order_relaxed);
+    loop_pos_ = 0;
+    cursor_ = 0;
+}
+
+void MidiLoop::CloseRecordedNotes(uint32_t position) {
+    // Notes held when a pass ends get their note-off at its end
+    for (uint8_t channel = 0; channel < 16; channel++) {
+        for (uint8_t word = 0; word < 4; word++) {
+            uint32_t bits = recording_notes_.bits[channel][word];
+            while (bits) {
+                uint8_t note = static_cast<uint8_t>(word * 32 + __builtin_ctz(bits));
+                bits &= bits - 1;
+                Push(MidiEvent(MidiEvent::NOTE_OFF, channel, note, 0, MidiEvent::SOURCE_GENERATED), position);
+            }
+        }
+    }
+    recording_notes_.Clear();
+}
+
+void MidiLoop::ReleasePlayingNotes(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events) {
+    if (playing_notes_.IsEmpty()) return;
+    for (uint8_t channel = 0; channel < 16; channel++) {
+        for (uint8_t word = 0; word < 4; word++) {
+            uint32_t bits = playing_notes_.bits[channel][word];
+            while (bits && *count < max_events) {
+                uint8_t note = static_cast<uint8_t>(word * 32 + __builtin_ctz(bits));
+                bits &= bits - 1;
+                events[(*count)++] = MidiEvent(MidiEvent::NOTE_OFF, channel, note, 0,
+                                               MidiEvent::SOURCE_GENERATED, block_start_sample);
+            }
+        }
+    }
+    playing_notes_.Clear();
+}
+
+void MidiLoop::Record(uint32_t block_start_sample, size_t block_size, const MidiEvent* events, size_t count) {
+    const bool overdub = GetState() == State::OVERDUBBING;
+    const uint32_t length = length_.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < count; i++) {
+        const MidiEvent& event = events[i];
+        if (!IsLoopEventType(event.type)) continue;
+
+        uint32_t offset = event.timestamp - block_start_sample;
+        if (offset >= block_size) offset = 0;
+        uint32_t position = loop_pos_ + offset;
+        if (overdub && position >= length) position -= length;
+
+        recording_notes_.Update(event);
+        Push(event, position);
+    }
+}
+
+void MidiLoop::Push(const MidiEvent& event, uint32_t position) {
+    const uint32_t head = record_head_.load(std::memory_order_relaxed);
+    if (head - record_tail_.load(std::memory_order_acquire) >= RECORD_QUEUE_SIZE) {
+        dropped_count_.store(dropped_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    MidiEvent& slot = record_queue_[head & (RECORD_QUEUE_SIZE - 1)];
+    slot = event;
+    slot.timestamp = position;
+    record_head_.store(head + 1, std::memory_order_release);
+}
+
+void MidiLoop::Play(uint32_t block_start_sample, size_t block_size, MidiEvent* events, size_t* count, size_t max_events) {
+    const uint32_t length = length_.load(std::memory_order_relaxed);
+    const uint32_t start = loop_pos_;
+    const uint32_t end = start + static_cast<uint32_t>(block_size);
+
+    if (end < length) {
+        PlayRange(start, end, block_start_sample, events, count, max_events);
+        loop_pos_ = end;
+        return;
+    }
+
+    // Block crosses the loop end: finish the pass, then start the next one
+    PlayRange(start, length, block_start_sample, events, count, max_events);
+    cursor_ = 0;
+    loop_pos_ = end - length;
+    PlayRange(0, loop_pos_, block_start_sample + (length - start), events, count, max_events);
+}
+
+void MidiLoop::PlayRange(uint32_t from, uint32_t to, uint32_t first_sample,
+                         MidiEvent* events, size_t* count, size_t max_events) {
+    const MidiEvent* bank = banks_[audio_bank_.load(std::memory_order_relaxed)];
+    while (cursor_ < audio_count_ && bank[cursor_].timestamp < to && *count < max_events) {
+        MidiEvent event = bank[cursor_++];
+        event.timestamp = first_sample + (event.timestamp - from);
+        event.source = MidiEvent::SOURCE_GENERATED;
+        playing_notes_.Update(event);
+        events[(*count)++] = event;
+    }
+}
+
+size_t MidiLoop::LowerBound(uint32_t position) const {
+    const MidiEvent* bank = banks_[audio_bank_.load(std::memory_order_relaxed)];
+    size_t low = 0;
+    size_t high = audio_count_;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (bank[mid].timestamp < position) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool MidiLoop::IsLoopEventType(uint8_t type) {
+    return type == MidiEvent::NOTE_ON || type == MidiEvent::NOTE_OFF
+        || type == MidiEvent::CONTROL_CHANGE || type == MidiEvent::PITCH_BEND;
+}
+
+void MidiLoop::NoteMask::Clear() {
+    for (auto& channel : bits) {
+        for (auto& word : channel) {
+            word = 0;
+        }
+    }
+}
+
+void MidiLoop::NoteMask::Update(const MidiEvent& event) {
+    const uint8_t note = event.data1 & 0x7F;
+    const uint32_t bit = 1u << (note & 31);
+    if (event.type == MidiEvent::NOTE_ON && event.data2 > 0) {
+        bits[event.channel][note >> 5] |= bit;
+    } else if (event.type == MidiEvent::NOTE_OFF || event.type == MidiEvent::NOTE_ON) {
+        bits[event.channel][note >> 5] &= ~bit;
+    }
+}
+
+bool MidiLoop::NoteMask::IsEmpty() const {
+    for (const auto& channel : bits) {
+        for (uint32_t word : channel) {
+            if (word) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace OpenChord
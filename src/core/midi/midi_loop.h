@@ -0,0 +1,159 @@
+#pragma once
+
+#include "midi_types.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * MidiLoop - Recorded MIDI loop in a fixed, pre-allocated event arena
+ *
+ * Events are kept sorted by loop position (stored in the timestamp field, in
+ * samples from the loop start). Playback walks a cursor through the sorted
+ * array, so an audio block costs O(events in the block) however long the
+ * loop is, and nothing is allocated after construction.
+ *
+ * Recording happens in the audio callback, which can't merge into the array
+ * it is playing from. Recorded events go to an SPSC queue instead; Update()
+ * in the main loop merges them with the playing events into the other bank
+ * and publishes it, and the audio callback switches banks at its next block
+ * (binary search for the cursor). Overdubs are heard from the next pass.
+ *
+ * The first recording pass sets the loop length. Notes still held when a
+ * pass ends are closed there, and notes sounding from playback are released
+ * on Stop/Clear.
+ *
+ * A loop can also be loaded from a file (SmfLoopTransfer): the main loop
+ * fills the spare bank a slice at a time between BeginLoad() and EndLoad(),
+ * while the old loop keeps playing, then publishes it STOPPED with its
+ * length; merging waits until the load is done.
+ */
+class MidiLoop {
+public:
+    static constexpr size_t CAPACITY = 4096;           // Events per loop (two banks of these)
+    static constexpr size_t RECORD_QUEUE_SIZE = 256;   // Recorded, not merged yet (power of 2)
+
+    enum class State : uint8_t {
+        EMPTY,          // Nothing recorded
+        RECORDING,      // First pass - sets the length
+        PLAYING,
+        OVERDUBBING,    // Playing and recording on top
+        STOPPED         // Has content, not playing
+    };
+
+    MidiLoop();
+    ~MidiLoop();
+
+    // Main loop side - take effect at the next audio block
+    void ToggleRecord();    // EMPTY -> RECORDING -> PLAYING <-> OVERDUBBING, STOPPED -> OVERDUBBING
+    void Play();            // From the loop start
+    void Stop();
+    void Clear();
+
+    // Merge recorded events into the playing loop (call every main loop pass)
+    void Update();
+
+    // Main loop: replace the loop. BeginLoad() fails until the audio callback
+    // has let go of the spare bank; events go in by position (timestamp in
+    // samples from the loop start, not decreasing) and AddLoadedEvent()
+    // returns false once the bank is full
+    bool BeginLoad();
+    bool AddLoadedEvent(const MidiEvent& event);
+    void EndLoad(uint32_t length);
+    void CancelLoad();
+    bool IsLoading() const { return loading_; }
+
+    // Main loop: the playing events (timestamp = position), valid until the next Update()
+    MidiEventSpan GetEvents() const;
+
+    State GetState() const { return static_cast<State>(state_.load(std::memory_order_relaxed)); }
+    bool IsRecording() const;
+    uint32_t GetLength() const { return length_.load(std::memory_order_relaxed); }  // Samples, 0 until the first pass ends
+    uint32_t GetPosition() const { return position_.load(std::memory_order_relaxed); }
+    size_t GetEventCount() const;
+    uint32_t GetDroppedCount() const { return dropped_count_.load(std::memory_order_relaxed); }
+
+    // Audio callback: records the `*count` events the stack generated for this
+    // block, then appends the loop's events that fall in it (timestamped on
+    // their sample). Events with a timestamp outside the block count as its start.
+    void ProcessBlock(uint32_t block_start_sample, size_t block_size,
+                      MidiEvent* events, size_t* count, size_t max_events);
+
+private:
+    enum Command : uint8_t {
+        COMMAND_NONE,
+        COMMAND_TOGGLE_RECORD,
+        COMMAND_PLAY,
+        COMMAND_STOP
+    };
+
+    // One bit per note and channel, to close notes without scanning the loop
+    struct NoteMask {
+        uint32_t bits[16][4];
+
+        void Clear();
+        void Update(const MidiEvent& event);
+        bool IsEmpty() const;
+    };
+
+    // Event banks: the audio callback plays the published one, Update()
+    // rewrites the other once the audio callback has switched over
+    MidiEvent banks_[2][CAPACITY];
+    size_t bank_count_[2];
+    uint32_t bank_clear_count_[2];          // Clears merged into each bank
+    std::atomic<uint8_t> published_bank_;
+    std::atomic<uint8_t> audio_bank_;       // Bank the audio callback plays from
+
+    // Recorded events, audio callback -> main loop
+    MidiEvent record_queue_[RECORD_QUEUE_SIZE];
+    std::atomic<uint32_t> record_head_;
+    std::atomic<uint32_t> record_tail_;
+    std::atomic<uint32_t> record_discard_;  // Queue position of the last clear
+
+    // Main loop state
+    MidiEvent batch_[RECORD_QUEUE_SIZE];    // Taken from the queue, sorted
+    uint32_t merged_clear_count_;
+    bool loading_;                          // Filling the spare bank from a file
+    size_t load_count_;
+
+    // Requests from the main loop
+    std::atomic<uint8_t> command_;
+    std::atomic<bool> clear_requested_;
+    std::atomic<uint32_t> clear_count_;     // Clears applied by the audio callback
+    std::atomic<bool> load_requested_;
+    std::atomic<uint32_t> load_length_;
+
+    // Audio callback state (state, length and position readable anywhere)
+    std::atomic<uint8_t> state_;
+    std::atomic<uint32_t> length_;
+    std::atomic<uint32_t> position_;
+    uint32_t loop_pos_;                     // Of the block start (elapsed, while RECORDING)
+    size_t cursor_;                         // Next event to play in the audio bank
+    size_t audio_count_;
+    NoteMask playing_notes_;
+    NoteMask recording_notes_;
+    std::atomic<uint32_t> dropped_count_;
+
+    void SetState(State state) { state_.store(static_cast<uint8_t>(state), std::memory_order_relaxed); }
+    void ApplyClear(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events);
+    void ApplyLoad(uint32_t block_start_sample, size_t block_size,
+                   MidiEvent* events, size_t* count, size_t max_events);
+    void ApplyCommand(uint32_t block_start_sample, size_t block_size,
+                      MidiEvent* events, size_t* count, size_t max_events);
+    void SwitchBank();
+    void EndFirstPass(size_t block_size);
+    void CloseRecordedNotes(uint32_t position);
+    void ReleasePlayingNotes(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events);
+    void Record(uint32_t block_start_sample, size_t block_size, const MidiEvent* events, size_t count);
+    void Push(const MidiEvent& event, uint32_t position);
+    void Play(uint32_t block_start_sample, size_t block_size, MidiEvent* events, size_t* count, size_t max_events);
+    void PlayRange(uint32_t from, uint32_t to, uint32_t first_sample,
+                   MidiEvent* events, size_t* count, size_t max_events);
+    size_t LowerBound(uint32_t position) const;
+
+    static bool IsLoopEventType(uint8_t type);
+};
+
+} // namespace OpenChord
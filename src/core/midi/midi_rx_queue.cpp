@@ -0,0 +1,189 @@
+#include "midi_rx_queue.h"
+#include <cstring>
+
+namespace OpenChord {
+
+static_assert((MidiRxQueue::CAPACITY & (MidiRxQueue::CAPACITY - 1)) == 0,
+              "MidiRxQueue capacity must be a power of two");
+
+// Latency histogram bucket upper limits (microseconds)
+static const uint32_t latency_bucket_limits_us[MidiLatencyStats::BUCKET_COUNT] = {
+    250, 500, 1000, 2000, 5000, UINT32_MAX
+};
+
+MidiRxQueue::MidiRxQueue()
+    : head_(0)
+    , tail_(0)
+    , dropped_count_(0)
+    , running_status_(0)
+    , pending_data_{0, 0}
+    , pending_count_(0)
+    , in_sysex_(false)
+{
+    std::memset(events_, 0, sizeof(events_));
+}
+
+MidiRxQueue::~MidiRxQueue() {
+}
+
+void MidiRxQueue::Reset() {
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    running_status_ = 0;
+    pending_count_ = 0;
+    in_sysex_ = false;
+}
+
+void MidiRxQueue::ParseBytes(const uint8_t* data, size_t size, uint32_t timestamp_us) {
+    if (!data) return;
+    for (size_t i = 0; i < size; i++) {
+        ParseByte(data[i], timestamp_us);
+    }
+}
+
+void MidiRxQueue::ParseByte(uint8_t byte, uint32_t timestamp_us) {
+    // System real-time can appear anywhere, even inside other messages
+    if (byte >= 0xF8) {
+        MidiRxEvent event;
+        event.timestamp_us = timestamp_us;
+        event.status = byte;
+        event.data[0] = 0;
+        event.data[1] = 0;
+        event.reserved = 0;
+        Push(event);
+        return;
+    }
+
+    if (byte & 0x80) {
+        // Status byte
+        pending_count_ = 0;
+        if (byte == 0xF0) {
+            in_sysex_ = true;
+            running_status_ = 0;
+            return;
+        }
+        in_sysex_ = false;
+        if (byte == 0xF7) {
+            running_status_ = 0;
+            return;
+        }
+        running_status_ = byte;
+        if (GetDataLength(byte) > 0) {
+            return;
+        }
+        // Zero-length system common (e.g. tune request) - complete now
+    } else {
+        // Data byte
+        if (in_sysex_ || running_status_ == 0) {
+            return;
+        }
+        pending_data_[pending_count_++] = byte;
+        if (pending_count_ < GetDataLength(running_status_)) {
+            return;
+        }
+    }
+
+    MidiRxEvent event;
+    event.timestamp_us = timestamp_us;
+    event.status = running_status_;
+    event.data[0] = pending_count_ > 0 ? pending_data_[0] : 0;
+    event.data[1] = pending_count_ > 1 ? pending_data_[1] : 0;
+    event.reserved = 0;
+
+    // Note on with velocity 0 is a note off
+    if ((event.status & 0xF0) == 0x90 && event.data[1] == 0) {
+        event.status = 0x80 | (event.status & 0x0F);
+    }
+
+    Push(event);
+    pending_count_ = 0;
+
+    // System common messages cancel running status
+    if (running_status_ >= 0xF0) {
+        running_status_ = 0;
+    }
+}
+
+uint8_t MidiRxQueue::GetDataLength(uint8_t status) {
+    switch (status & 0xF0) {
+        case 0xC0:  // Program change
+        case 0xD0:  // Channel pressure
+            return 1;
+        case 0xF0:
+            if (status == 0xF1 || status == 0xF3) return 1;
+            if (status == 0xF2) return 2;
+            return 0;
+        default:
+            return 2;
+    }
+}
+
+bool MidiRxQueue::Push(const MidiRxEvent& event) {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail >= CAPACITY) {
+        dropped_count_++;
+        return false;
+    }
+    events_[head & (CAPACITY - 1)] = event;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool MidiRxQueue::Pop(MidiRxEvent* event) {
+    if (!event) return false;
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    uint32_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+    *event = events_[tail & (CAPACITY - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+size_t MidiRxQueue::GetCount() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+MidiLatencyStats::MidiLatencyStats() {
+    Reset();
+}
+
+void MidiLatencyStats::Record(uint32_t latency_us) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (latency_us < latency_bucket_limits_us[i] || i == BUCKET_COUNT - 1) {
+            buckets_[i]++;
+            break;
+        }
+    }
+    count_++;
+    total_us_ += latency_us;
+    if (latency_us > worst_us_) {
+        worst_us_ = latency_us;
+    }
+}
+
+void MidiLatencyStats::Reset() {
+    std::memset(buckets_, 0, sizeof(buckets_));
+    count_ = 0;
+    worst_us_ = 0;
+    total_us_ = 0;
+}
+
+uint32_t MidiLatencyStats::GetAverageUs() const {
+    if (count_ == 0) return 0;
+    return static_cast<uint32_t>(total_us_ / count_);
+}
+
+uint32_t MidiLatencyStats::GetBucket(int index) const {
+    if (index < 0 || index >= BUCKET_COUNT) return 0;
+    return buckets_[index];
+}
+
+uint32_t MidiLatencyStats::GetBucketLimitUs(int index) {
+    if (index < 0 || index >= BUCKET_COUNT) return 0;
+    return latency_bucket_limits_us[index];
+}
+
+} // namespace OpenChord
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * Raw MIDI message captured at receive time
+ *
+ * status is the full status byte (type | channel), data bytes unused by
+ * the message are zero. System real-time messages carry only status.
+ */
+struct MidiRxEvent {
+    uint32_t timestamp_us;  // daisy::System::GetUs() when the last byte arrived
+    uint8_t status;
+    uint8_t data[2];
+    uint8_t reserved;
+};
+
+/**
+ * MIDI Receive Queue - Parses raw MIDI bytes into a timestamped lock-free queue
+ *
+ * Producer is the UART/USB receive interrupt (ParseBytes), consumer is the
+ * main loop (Pop). Single producer / single consumer, so one queue per
+ * transport. Handles running status, interleaved real-time bytes and skips
+ * SysEx.
+ */
+class MidiRxQueue {
+public:
+    static constexpr size_t CAPACITY = 256;  // Must be a power of two
+
+    MidiRxQueue();
+    ~MidiRxQueue();
+
+    // Clear queue and parser (only when the producer is stopped)
+    void Reset();
+
+    // Producer side (receive interrupt)
+    void ParseBytes(const uint8_t* data, size_t size, uint32_t timestamp_us);
+    bool Push(const MidiRxEvent& event);
+
+    // Consumer side (main loop)
+    bool Pop(MidiRxEvent* event);
+    size_t GetCount() const;
+
+    // Events lost because the queue was full
+    uint32_t GetDroppedCount() const { return dropped_count_; }
+
+private:
+    MidiRxEvent events_[CAPACITY];
+    std::atomic<uint32_t> head_;  // Written by producer
+    std::atomic<uint32_t> tail_;  // Written by consumer
+    uint32_t dropped_count_;
+
+    // Parser state (producer only)
+    uint8_t running_status_;
+    uint8_t pending_data_[2];
+    uint8_t pending_count_;
+    bool in_sysex_;
+
+    void ParseByte(uint8_t byte, uint32_t timestamp_us);
+    static uint8_t GetDataLength(uint8_t status);
+};
+
+/**
+ * MIDI Latency Stats - Receive-to-track latency distribution
+ */
+class MidiLatencyStats {
+public:
+    static constexpr int BUCKET_COUNT = 6;
+
+    MidiLatencyStats();
+
+    void Record(uint32_t latency_us);
+    void Reset();
+
+    uint32_t GetCount() const { return count_; }
+    uint32_t GetWorstUs() const { return worst_us_; }
+    uint32_t GetAverageUs() const;
+
+    // Histogram: bucket i counts latencies below GetBucketLimitUs(i)
+    // (last bucket counts everything above the previous limit)
+    uint32_t GetBucket(int index) const;
+    static uint32_t GetBucketLimitUs(int index);
+
+private:
+    uint32_t buckets_[BUCKET_COUNT];
+    uint32_t count_;
+    uint32_t worst_us_;
+    uint64_t total_us_;
+};
+
+} // namespace OpenChord
@@ -0,0 +1,76 @@
+#include "midi_tx_batch.h"
+#include <cstring>
+
+namespace OpenChord {
+
+MidiTxBatch::MidiTxBatch()
+    : trs_size_(0)
+    , trs_bytes_saved_(0)
+    , message_count_(0)
+    , running_status_(0)
+    , running_status_enabled_(true)
+{
+    std::memset(usb_messages_, 0, sizeof(usb_messages_));
+    std::memset(usb_sizes_, 0, sizeof(usb_sizes_));
+    std::memset(trs_bytes_, 0, sizeof(trs_bytes_));
+}
+
+MidiTxBatch::~MidiTxBatch() {
+}
+
+bool MidiTxBatch::Add(const uint8_t* message, size_t size) {
+    if (!message || size == 0 || size > MAX_MESSAGE_BYTES || IsFull()) {
+        return false;
+    }
+
+    // USB always carries the full message (each packet has its own status)
+    std::memcpy(usb_messages_[message_count_], message, size);
+    usb_sizes_[message_count_] = static_cast<uint8_t>(size);
+
+    uint8_t status = message[0];
+    if (status >= 0xF8) {
+        // Real-time bytes may be interleaved without affecting running status
+        trs_bytes_[trs_size_++] = status;
+    } else if (status >= 0xF0) {
+        // System common cancels running status
+        std::memcpy(&trs_bytes_[trs_size_], message, size);
+        trs_size_ += size;
+        running_status_ = 0;
+    } else if (running_status_enabled_ && status == running_status_) {
+        // Same status as last channel message - send data bytes only
+        std::memcpy(&trs_bytes_[trs_size_], message + 1, size - 1);
+        trs_size_ += size - 1;
+        trs_bytes_saved_++;
+    } else {
+        std::memcpy(&trs_bytes_[trs_size_], message, size);
+        trs_size_ += size;
+        running_status_ = running_status_enabled_ ? status : 0;
+    }
+
+    message_count_++;
+    return true;
+}
+
+const uint8_t* MidiTxBatch::GetUsbMessage(size_t index, size_t* size) const {
+    if (index >= message_count_) {
+        if (size) *size = 0;
+        return nullptr;
+    }
+    if (size) *size = usb_sizes_[index];
+    return usb_messages_[index];
+}
+
+void MidiTxBatch::Clear() {
+    trs_size_ = 0;
+    trs_bytes_saved_ = 0;
+    message_count_ = 0;
+}
+
+void MidiTxBatch::SetRunningStatusEnabled(bool enabled) {
+    running_status_enabled_ = enabled;
+    if (!enabled) {
+        running_status_ = 0;
+    }
+}
+
+} // namespace OpenChord
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * MIDI Transmit Batch - Collects outgoing messages for one transfer per transport
+ *
+ * Messages added during a routing pass are kept as:
+ * - USB messages, one complete message (full status byte) each. libDaisy's
+ *   MidiUsbTransport::Tx() packs a single message into a USB MIDI packet per
+ *   call, so they are sent one Tx() each
+ * - a TRS byte stream using MIDI running status, so repeated status bytes
+ *   (chords, CC streams) are dropped from the 31.25 kbaud wire, sent in
+ *   one UART write
+ *
+ * Running status persists across batches because the receiver remembers it.
+ */
+class MidiTxBatch {
+public:
+    static constexpr size_t MAX_MESSAGES = 16;
+    static constexpr size_t MAX_MESSAGE_BYTES = 3;
+
+    MidiTxBatch();
+    ~MidiTxBatch();
+
+    // Add a complete raw MIDI message (status + data), returns false if full
+    bool Add(const uint8_t* message, size_t size);
+
+    // Clear queued bytes after sending (running status is kept)
+    void Clear();
+
+    // Forget running status (next channel message sends its status byte)
+    void ResetRunningStatus() { running_status_ = 0; }
+
+    // Running status can be disabled when other code writes to the same UART
+    void SetRunningStatusEnabled(bool enabled);
+    bool IsRunningStatusEnabled() const { return running_status_enabled_; }
+
+    bool IsEmpty() const { return message_count_ == 0; }
+    bool IsFull() const { return message_count_ >= MAX_MESSAGES; }
+    size_t GetMessageCount() const { return message_count_; }
+
+    // USB message index (0..GetMessageCount()-1), size set to its length
+    const uint8_t* GetUsbMessage(size_t index, size_t* size) const;
+
+    // TRS byte stream ready to send
+    const uint8_t* GetTrsBytes() const { return trs_bytes_; }
+    size_t GetTrsSize() const { return trs_size_; }
+
+    // Status bytes omitted from the TRS stream in this batch
+    size_t GetTrsBytesSaved() const { return trs_bytes_saved_; }
+
+private:
+    uint8_t usb_messages_[MAX_MESSAGES][MAX_MESSAGE_BYTES];
+    uint8_t usb_sizes_[MAX_MESSAGES];
+
+    uint8_t trs_bytes_[MAX_MESSAGES * MAX_MESSAGE_BYTES];
+    size_t trs_size_;
+    size_t trs_bytes_saved_;
+
+    size_t message_count_;
+
+    uint8_t running_status_;
+    bool running_status_enabled_;
+};
+
+} // namespace OpenChord
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 
 namespace OpenChord {
 
 /**
- * MIDI event structure for internal use
+ * MIDI event structure - the one event type used everywhere
+ * (plugins, tracks, MidiHub, router and MIDI handler)
+ *
+ * Packed into 8 bytes: type is the MIDI status nibble (0x80..0xE0) for
+ * channel messages or the full status byte for system messages (0xF8 clock,
+ * 0xFA start...). Timestamp is in samples of the audio sample clock.
  */
 struct MidiEvent {
     enum Type {
@@ -25,11 +31,46 @@ struct MidiEvent {
         RESET = 0xFF
     };
 
+    // Where the event came from (stored in 4 bits)
+    enum Source {
+        SOURCE_INTERNAL = 0,  // Internal processing
+        SOURCE_USB,           // USB MIDI input
+        SOURCE_TRS_IN,        // TRS MIDI input
+        SOURCE_TRS_OUT,       // TRS MIDI output
+        SOURCE_GENERATED      // Built-in controls (input plugins)
+    };
+
     uint8_t type;
-    uint8_t channel;
+    uint8_t channel : 4;
+    uint8_t source : 4;
     uint8_t data1;  // Note, controller number, etc.
     uint8_t data2;  // Velocity, controller value, etc.
     uint32_t timestamp;  // Sample-accurate timestamp
+
+    MidiEvent() : type(0), channel(0), source(SOURCE_INTERNAL), data1(0), data2(0), timestamp(0) {}
+    MidiEvent(uint8_t t, uint8_t ch, uint8_t d1, uint8_t d2, uint8_t src = SOURCE_INTERNAL, uint32_t ts = 0)
+        : type(t), channel(ch & 0x0F), source(src & 0x0F), data1(d1), data2(d2), timestamp(ts) {}
+
+    // Full status byte for channel messages (type | channel)
+    uint8_t GetStatus() const { return type < 0xF0 ? static_cast<uint8_t>(type | channel) : type; }
+};
+
+static_assert(sizeof(MidiEvent) == 8, "MidiEvent must stay packed into 8 bytes");
+
+/**
+ * Read-only view of contiguous MIDI events (pointer + count, no copy)
+ */
+struct MidiEventSpan {
+    const MidiEvent* data;
+    size_t size;
+
+    MidiEventSpan() : data(nullptr), size(0) {}
+    MidiEventSpan(const MidiEvent* d, size_t s) : data(d), size(s) {}
+
+    const MidiEvent* begin() const { return data; }
+    const MidiEvent* end() const { return data + size; }
+    bool empty() const { return size == 0; }
+    const MidiEvent& operator[](size_t i) const { return data[i]; }
 };
 
 /**
@@ -41,4 +82,4 @@ struct MidiMessage {
     uint32_t timestamp;
 };
 
-} // namespace OpenChord 
\ No newline at end of file
+} // namespace OpenChord 
@@ -13,6 +13,9 @@ namespace OpenChord {
  */
 class OctaveShift {
 public:
+    static constexpr int MIN_SHIFT = -4;
+    static constexpr int MAX_SHIFT = 4;
+    
     OctaveShift();
     ~OctaveShift();
     
@@ -35,8 +38,6 @@ public:
     
 private:
     int octave_shift_;  // -4 to +4, 0 = no shift
-    static constexpr int MIN_SHIFT = -4;
-    static constexpr int MAX_SHIFT = 4;
 };
 
 } // namespace OpenChord
@@ -0,0 +1,397 @@
+#include "smf_file.h"
+
+namespace OpenChord {
+
+namespace {
+
+uint32_t ReadBigEndian(const uint8_t* data, size_t size) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+bool HasDataByte2(uint8_t type) {
+    return type != MidiEvent::PROGRAM_CHANGE && type != MidiEvent::CHANNEL_AFTERTOUCH;
+}
+
+} // namespace
+
+SmfReader::SmfReader()
+    : file_(nullptr)
+    , file_position_(0)
+    , file_error_(false)
+    , sample_rate_(48000.0f)
+    , format_(0)
+    , division_(0)
+    , track_count_(0)
+    , ignored_tracks_(0)
+    , tempo_tick_(0)
+    , tempo_sample_(0.0)
+    , samples_per_tick_(0.0)
+    , end_sample_(0)
+{
+}
+
+SmfReader::~SmfReader() {
+}
+
+SmfReader::Result SmfReader::Open(IFileStream* file, float sample_rate) {
+    file_ = file;
+    file_position_ = UNKNOWN_POSITION;
+    file_error_ = false;
+    sample_rate_ = sample_rate;
+    track_count_ = 0;
+    ignored_tracks_ = 0;
+    end_sample_ = 0;
+    if (!file_) return Result::FILE_ERROR;
+
+    // MThd, header length, format, track count, division
+    uint8_t header[14];
+    if (ReadAt(0, header, sizeof(header)) != sizeof(header)) return Result::NOT_SMF;
+    if (header[0] != 'M' || header[1] != 'T' || header[2] != 'h' || header[3] != 'd') return Result::NOT_SMF;
+    const uint32_t header_length = ReadBigEndian(&header[4], 4);
+    format_ = static_cast<uint16_t>(ReadBigEndian(&header[8], 2));
+    const uint32_t declared_tracks = ReadBigEndian(&header[10], 2);
+    division_ = static_cast<uint16_t>(ReadBigEndian(&header[12], 2));
+    if (header_length < 6 || format_ > 1 || declared_tracks == 0 || (division_ & 0x7FFF) == 0) {
+        return Result::UNSUPPORTED;
+    }
+
+    // Find the track chunks (other chunk types are skipped, a short file has fewer tracks)
+    uint32_t position = 8 + header_length;
+    uint32_t found = 0;
+    for (uint32_t chunk = 0; found < declared_tracks && chunk < declared_tracks + MAX_TRACKS; chunk++) {
+        uint8_t chunk_header[8];
+        if (ReadAt(position, chunk_header, sizeof(chunk_header)) != sizeof(chunk_header)) break;
+        const uint32_t length = ReadBigEndian(&chunk_header[4], 4);
+        const uint32_t data = position + 8;
+        if (chunk_header[0] == 'M' && chunk_header[1] == 'T' && chunk_header[2] == 'r' && chunk_header[3] == 'k') {
+            found++;
+            if (track_count_ < MAX_TRACKS) {
+                TrackCursor& track = tracks_[track_count_++];
+                track.next = data;
+                track.end = length > UINT32_MAX - data ? UINT32_MAX : data + length;
+                track.tick = 0;
+                track.head = 0;
+                track.fill = 0;
+                track.running_status = 0;
+                track.ended = false;
+            } else {
+                ignored_tracks_++;
+            }
+        }
+        if (length > UINT32_MAX - data) break;
+        position = data + length;
+    }
+    if (track_count_ == 0) return Result::UNSUPPORTED;
+
+    // Timecode division: fixed ticks per second. Otherwise ticks per quarter, 120 BPM until a tempo event
+    tempo_tick_ = 0;
+    tempo_sample_ = 0.0;
+    if (division_ & 0x8000) {
+        const int frames = -static_cast<int8_t>(division_ >> 8);
+        const double frame_rate = frames == 29 ? 29.97 : frames;
+        samples_per_tick_ = sample_rate_ / (frame_rate * (division_ & 0xFF));
+    } else {
+        samples_per_tick_ = 0.0;
+        SetTempo(0, DEFAULT_TEMPO);
+    }
+
+    for (size_t i = 0; i < track_count_; i++) {
+        ReadDelta(tracks_[i]);
+    }
+    return file_error_ ? Result::FILE_ERROR : Result::OK;
+}
+
+SmfReader::Result SmfReader::Read(MidiEvent* events, size_t max_file_events, size_t* count) {
+    *count = 0;
+    if (!file_ || track_count_ == 0) return Result::FILE_ERROR;
+
+    for (size_t n = 0; n < max_file_events; n++) {
+        TrackCursor* track = NextTrack();
+        if (!track) return Result::END;
+
+        bool is_channel_event = false;
+        Result result = ReadEvent(*track, &events[*count], &is_channel_event);
+        if (file_error_) return Result::FILE_ERROR;
+        if (result != Result::OK) return result;
+        if (is_channel_event) (*count)++;
+        if (!track->ended) ReadDelta(*track);
+        if (file_error_) return Result::FILE_ERROR;
+    }
+    return NextTrack() ? Result::OK : Result::END;
+}
+
+SmfReader::TrackCursor* SmfReader::NextTrack() {
+    // Earliest pending event; a tie goes to the lower track, so the tempo track leads
+    TrackCursor* next = nullptr;
+    for (size_t i = 0; i < track_count_; i++) {
+        TrackCursor& track = tracks_[i];
+        if (!track.ended && (!next || track.tick < next->tick)) next = &track;
+    }
+    return next;
+}
+
+size_t SmfReader::ReadAt(uint32_t position, uint8_t* data, size_t size) {
+    if (position != file_position_ && !file_->Seek(position)) {
+        file_position_ = UNKNOWN_POSITION;
+        file_error_ = true;
+        return 0;
+    }
+    const size_t read = file_->Read(data, size);
+    file_position_ = position + static_cast<uint32_t>(read);
+    return read;
+}
+
+bool SmfReader::NextByte(TrackCursor& track, uint8_t* byte) {
+    if (track.head == track.fill) {
+        if (track.next >= track.end) return false;
+        uint32_t size = track.end - track.next;
+        if (size > TRACK_BUFFER_SIZE) size = TRACK_BUFFER_SIZE;
+        const size_t read = ReadAt(track.next, track.buffer, size);
+        if (read == 0) return false;
+        if (read < size) track.end = track.next + static_cast<uint32_t>(read);   // File ends inside the chunk
+        track.next += static_cast<uint32_t>(read);
+        track.head = 0;
+        track.fill = static_cast<uint8_t>(read);
+    }
+    *byte = track.buffer[track.head++];
+    return true;
+}
+
+bool SmfReader::ReadVarLen(TrackCursor& track, uint32_t* value) {
+    // At most 4 bytes (28 bits)
+    *value = 0;
+    for (int i = 0; i < 4; i++) {
+        uint8_t byte;
+        if (!NextByte(track, &byte)) return false;
+        *value = (*value << 7) | (byte & 0x7F);
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+void SmfReader::Skip(TrackCursor& track, uint32_t size) {
+    // Past the buffer, only the file position moves
+    const uint32_t buffered = static_cast<uint32_t>(track.fill - track.head);
+    if (size <= buffered) {
+        track.head = static_cast<uint8_t>(track.head + size);
+        return;
+    }
+    size -= buffered;
+    track.head = track.fill;
+    track.next = size >= track.end - track.next ? track.end : track.next + size;
+}
+
+void SmfReader::ReadDelta(TrackCursor& track) {
+    uint32_t delta;
+    if (!ReadVarLen(track, &delta)) {
+        EndTrack(track);
+        return;
+    }
+    track.tick = delta > UINT32_MAX - track.tick ? UINT32_MAX : track.tick + delta;
+}
+
+void SmfReader::EndTrack(TrackCursor& track) {
+    track.ended = true;
+    const uint32_t sample = TickToSample(track.tick);
+    if (sample > end_sample_) end_sample_ = sample;
+}
+
+SmfReader::Result SmfReader::ReadEvent(TrackCursor& track, MidiEvent* event, bool* is_channel_event) {
+    uint8_t status;
+    if (!NextByte(track, &status)) {
+        EndTrack(track);
+        return Result::OK;
+    }
+
+    // Channel message, with running status
+    uint8_t first = 0;
+    bool have_first = false;
+    if (status < 0x80) {
+        if (!track.running_status) return Result::BAD_DATA;
+        first = status;
+        have_first = true;
+        status = track.running_status;
+    }
+    if (status < 0xF0) {
+        track.running_status = status;
+        const uint8_t type = status & 0xF0;
+        uint8_t second = 0;
+        if ((!have_first && !NextByte(track, &first)) ||
+            (HasDataByte2(type) && !NextByte(track, &second))) {
+            EndTrack(track);
+            return Result::OK;
+        }
+        *event = MidiEvent(type, status & 0x0F, first & 0x7F, second & 0x7F,
+                           MidiEvent::SOURCE_INTERNAL, TickToSample(track.tick));
+        *is_channel_event = true;
+        return Result::OK;
+    }
+
+    // SysEx and meta events cancel running status
+    track.running_status = 0;
+    uint8_t meta_type = 0;
+    uint32_t length = 0;
+    if (status == 0xFF) {
+        if (!NextByte(track, &meta_type) || !ReadVarLen(track, &length)) {
+            EndTrack(track);
+            return Result::OK;
+        }
+        if (meta_type == 0x2F) {
+            EndTrack(track);
+            return Result::OK;
+        }
+        if (meta_type == 0x51 && length == 3) {
+            uint8_t tempo[3];
+            for (int i = 0; i < 3; i++) {
+                if (!NextByte(track, &tempo[i])) {
+                    EndTrack(track);
+                    return Result::OK;
+                }
+            }
+            if (!(division_ & 0x8000)) SetTempo(track.tick, ReadBigEndian(tempo, 3));
+            return Result::OK;
+        }
+    } else if (status == 0xF0 || status == 0xF7) {
+        if (!ReadVarLen(track, &length)) {
+            EndTrack(track);
+            return Result::OK;
+        }
+    } else {
+        return Result::BAD_DATA;    // Real-time and common messages don't appear in files
+    }
+    Skip(track, length);
+    return Result::OK;
+}
+
+void SmfReader::SetTempo(uint32_t tick, uint32_t us_per_quarter) {
+    if (us_per_quarter == 0) return;
+    // Samples up to the change from the old tempo, unrounded so changes don't add drift
+    tempo_sample_ += static_cast<double>(tick - tempo_tick_) * samples_per_tick_;
+    tempo_tick_ = tick;
+    samples_per_tick_ = us_per_quarter * 1e-6 * sample_rate_ / division_;
+}
+
+uint32_t SmfReader::TickToSample(uint32_t tick) const {
+    const double sample = tempo_sample_ + static_cast<double>(tick - tempo_tick_) * samples_per_tick_ + 0.5;
+    return sample >= 4294967295.0 ? UINT32_MAX : static_cast<uint32_t>(sample);
+}
+
+SmfWriter::SmfWriter()
+    : file_(nullptr)
+    , ticks_per_sample_(0.0)
+    , last_tick_(0)
+    , written_(0)
+    , running_status_(0)
+    , ok_(false)
+    , fill_(0)
+{
+}
+
+SmfWriter::~SmfWriter() {
+}
+
+bool SmfWriter::Open(IFileStream* file, float sample_rate, float bpm) {
+    file_ = file;
+    last_tick_ = 0;
+    written_ = 0;
+    running_status_ = 0;
+    fill_ = 0;
+    ok_ = file_ != nullptr && sample_rate > 0.0f && bpm > 0.0f;
+    if (!ok_) return false;
+
+    // Ticks from the tempo as written, so a reader gets the same times back
+    uint32_t us_per_quarter = static_cast<uint32_t>(60000000.0f / bpm + 0.5f);
+    if (us_per_quarter > 0xFFFFFF) us_per_quarter = 0xFFFFFF;
+    ticks_per_sample_ = DIVISION * 1e6 / (static_cast<double>(us_per_quarter) * sample_rate);
+
+    // Header (format 0, one track), then the track chunk with its length patched by Close()
+    const uint8_t header[] = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6,
+        0, 0, 0, 1, DIVISION >> 8, DIVISION & 0xFF,
+        'M', 'T', 'r', 'k', 0, 0, 0, 0,
+        0, 0xFF, 0x51, 3,
+        static_cast<uint8_t>(us_per_quarter >> 16),
+        static_cast<uint8_t>(us_per_quarter >> 8),
+        static_cast<uint8_t>(us_per_quarter)
+    };
+    Put(header, sizeof(header));
+    return ok_;
+}
+
+bool SmfWriter::Write(const MidiEvent& event) {
+    if (!ok_ || event.type >= 0xF0) return ok_;
+
+    PutDelta(event.timestamp);
+    const uint8_t status = event.GetStatus();
+    if (status != running_status_) {
+        Put(&status, 1);
+        running_status_ = status;
+    }
+    const uint8_t data[2] = { static_cast<uint8_t>(event.data1 & 0x7F), static_cast<uint8_t>(event.data2 & 0x7F) };
+    Put(data, HasDataByte2(event.type) ? 2 : 1);
+    return ok_;
+}
+
+bool SmfWriter::Close(uint32_t end_sample) {
+    if (!ok_) return false;
+
+    PutDelta(end_sample);
+    const uint8_t end_of_track[] = { 0xFF, 0x2F, 0 };
+    Put(end_of_track, sizeof(end_of_track));
+    if (!Flush()) return false;
+
+    const uint32_t track_size = written_ - TRACK_DATA_POSITION;
+    const uint8_t length[4] = {
+        static_cast<uint8_t>(track_size >> 24), static_cast<uint8_t>(track_size >> 16),
+        static_cast<uint8_t>(track_size >> 8), static_cast<uint8_t>(track_size)
+    };
+    ok_ = file_->Seek(TRACK_DATA_POSITION - 4) && file_->Write(length, sizeof(length)) == sizeof(length);
+    file_ = nullptr;
+    return ok_;
+}
+
+void SmfWriter::Put(const uint8_t* data, size_t size) {
+    written_ += static_cast<uint32_t>(size);
+    for (size_t i = 0; i < size; i++) {
+        if (fill_ == BUFFER_SIZE && !Flush()) return;
+        buffer_[fill_++] = data[i];
+    }
+}
+
+void SmfWriter::PutVarLen(uint32_t value) {
+    if (value > 0x0FFFFFFF) value = 0x0FFFFFFF;
+    uint8_t bytes[4];
+    size_t size = 0;
+    do {
+        bytes[size++] = value & 0x7F;
+        value >>= 7;
+    } while (value);
+    // Most significant group first, continuation bit on all but the last
+    uint8_t out[4];
+    for (size_t i = 0; i < size; i++) {
+        out[i] = static_cast<uint8_t>(bytes[size - 1 - i] | (i + 1 < size ? 0x80 : 0));
+    }
+    Put(out, size);
+}
+
+void SmfWriter::PutDelta(uint32_t sample) {
+    double ticks = sample * ticks_per_sample_ + 0.5;
+    uint32_t tick = ticks >= 4294967295.0 ? UINT32_MAX : static_cast<uint32_t>(ticks);
+    if (tick < last_tick_) tick = last_tick_;
+    PutVarLen(tick - last_tick_);
+    last_tick_ = tick;
+}
+
+bool SmfWriter::Flush() {
+    if (ok_ && fill_ > 0) {
+        ok_ = file_->Write(buffer_, fill_) == fill_;
+    }
+    fill_ = 0;
+    return ok_;
+}
+
+} // namespace OpenChord
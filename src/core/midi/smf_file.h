@@ -0,0 +1,141 @@
+#pragma once
+
+#include "midi_types.h"
+#include "../io/file_stream.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * SmfReader - Streams channel events out of a Standard MIDI File (format 0/1)
+ *
+ * Never holds the file: each track chunk gets a small fixed buffer that is
+ * refilled from its own file position, and the tracks are merged by tick so
+ * events come out in time order, whatever the format. The tempo map (FF 51,
+ * usually on the first track) is applied as it goes, so timestamps are in
+ * samples from the start of the file. Nothing is allocated.
+ *
+ * Read() decodes a bounded number of file events per call, so a large file
+ * is read over several main loop passes without stalling the UI. Running
+ * status is handled; SysEx and meta events other than tempo and end of track
+ * are skipped without being read. A track cut short ends where its chunk
+ * does.
+ */
+class SmfReader {
+public:
+    static constexpr size_t MAX_TRACKS = 16;          // Tracks past this are ignored
+    static constexpr size_t TRACK_BUFFER_SIZE = 64;   // Bytes buffered per track
+
+    enum class Result : uint8_t {
+        OK,
+        END,            // Every track has ended
+        NOT_SMF,        // No MThd header
+        UNSUPPORTED,    // Format 2, or no tracks
+        FILE_ERROR,     // Seek or read failed
+        BAD_DATA        // Data byte without a running status
+    };
+
+    SmfReader();
+    ~SmfReader();
+
+    // Reads the header and finds the track chunks (the file stays open)
+    Result Open(IFileStream* file, float sample_rate);
+
+    // Decodes up to max_file_events events from the file and writes the
+    // channel messages among them to events, which has room for that many
+    // (timestamp in samples)
+    Result Read(MidiEvent* events, size_t max_file_events, size_t* count);
+
+    uint16_t GetFormat() const { return format_; }
+    size_t GetTrackCount() const { return track_count_; }
+    size_t GetIgnoredTrackCount() const { return ignored_tracks_; }
+    uint32_t GetEndSample() const { return end_sample_; }   // Latest end of track read so far
+
+private:
+    struct TrackCursor {
+        uint32_t next;          // File position of the next byte to buffer
+        uint32_t end;           // End of the track chunk
+        uint32_t tick;          // Of the next event
+        uint8_t buffer[TRACK_BUFFER_SIZE];
+        uint8_t head;
+        uint8_t fill;
+        uint8_t running_status;
+        bool ended;
+    };
+
+    static constexpr uint32_t UNKNOWN_POSITION = UINT32_MAX;
+    static constexpr uint32_t DEFAULT_TEMPO = 500000;   // us per quarter (120 BPM)
+
+    IFileStream* file_;
+    uint32_t file_position_;    // Where the stream is, to save a seek
+    bool file_error_;
+    float sample_rate_;
+    uint16_t format_;
+    uint16_t division_;
+    size_t track_count_;
+    size_t ignored_tracks_;
+    TrackCursor tracks_[MAX_TRACKS];
+
+    // Tempo map so far: samples at the last tempo change and per tick after it
+    uint32_t tempo_tick_;
+    double tempo_sample_;
+    double samples_per_tick_;
+    uint32_t end_sample_;
+
+    TrackCursor* NextTrack();
+    size_t ReadAt(uint32_t position, uint8_t* data, size_t size);
+    bool NextByte(TrackCursor& track, uint8_t* byte);
+    bool ReadVarLen(TrackCursor& track, uint32_t* value);
+    void Skip(TrackCursor& track, uint32_t size);
+    void ReadDelta(TrackCursor& track);
+    void EndTrack(TrackCursor& track);
+    Result ReadEvent(TrackCursor& track, MidiEvent* event, bool* is_channel_event);
+    void SetTempo(uint32_t tick, uint32_t us_per_quarter);
+    uint32_t TickToSample(uint32_t tick) const;
+};
+
+/**
+ * SmfWriter - Streams events into a format 0 Standard MIDI File
+ *
+ * Events go through a small buffer that is written out as it fills; the
+ * track length is patched into the chunk header by Close(). Timestamps (in
+ * samples from the start) are converted to ticks at a fixed tempo, which is
+ * written at the start so a DAW opens the file at the same tempo. Running
+ * status is used for consecutive messages with the same status.
+ */
+class SmfWriter {
+public:
+    static constexpr uint16_t DIVISION = 960;       // Ticks per quarter note
+    static constexpr size_t BUFFER_SIZE = 256;
+
+    SmfWriter();
+    ~SmfWriter();
+
+    bool Open(IFileStream* file, float sample_rate, float bpm);
+
+    // Channel messages only, timestamps not decreasing
+    bool Write(const MidiEvent& event);
+
+    // End of track at end_sample (the loop length), then the chunk length
+    bool Close(uint32_t end_sample);
+
+private:
+    static constexpr uint32_t TRACK_DATA_POSITION = 22;     // After MThd and the MTrk header
+
+    IFileStream* file_;
+    double ticks_per_sample_;
+    uint32_t last_tick_;
+    uint32_t written_;          // Bytes put so far, header included
+    uint8_t running_status_;
+    bool ok_;
+    uint8_t buffer_[BUFFER_SIZE];
+    size_t fill_;
+
+    void Put(const uint8_t* data, size_t size);
+    void PutVarLen(uint32_t value);
+    void PutDelta(uint32_t sample);
+    bool Flush();
+};
+
+} // namespace OpenChord
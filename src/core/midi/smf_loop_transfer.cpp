@@ -0,0 +1,124 @@
+#include "smf_loop_transfer.h"
+
+namespace OpenChord {
+
+SmfLoopTransfer::SmfLoopTransfer()
+    : state_(State::IDLE)
+    , loop_(nullptr)
+    , event_count_(0)
+    , dropped_count_(0)
+    , last_sample_(0)
+    , read_result_(SmfReader::Result::OK)
+    , load_started_(false)
+{
+}
+
+SmfLoopTransfer::~SmfLoopTransfer() {
+}
+
+bool SmfLoopTransfer::StartImport(MidiLoop* loop, IFileStream* file, float sample_rate) {
+    if (IsBusy() || !loop || !file) return false;
+
+    loop_ = loop;
+    event_count_ = 0;
+    dropped_count_ = 0;
+    last_sample_ = 0;
+    load_started_ = false;
+
+    // Header and track chunks now; the events a slice at a time from Update()
+    read_result_ = reader_.Open(file, sample_rate);
+    if (read_result_ != SmfReader::Result::OK) {
+        state_ = State::FAILED;
+        return false;
+    }
+    state_ = State::IMPORTING;
+    return true;
+}
+
+bool SmfLoopTransfer::StartExport(MidiLoop* loop, IFileStream* file, float sample_rate, float bpm) {
+    if (IsBusy() || !loop || !file) return false;
+
+    // Only a finished loop (the first pass sets the length)
+    MidiLoop::State loop_state = loop->GetState();
+    if (loop_state == MidiLoop::State::EMPTY || loop_state == MidiLoop::State::RECORDING || loop->GetLength() == 0) {
+        return false;
+    }
+
+    loop_ = loop;
+    event_count_ = 0;
+    dropped_count_ = 0;
+    read_result_ = SmfReader::Result::OK;
+    if (!writer_.Open(file, sample_rate, bpm)) {
+        state_ = State::FAILED;
+        return false;
+    }
+    state_ = State::EXPORTING;
+    return true;
+}
+
+bool SmfLoopTransfer::Update() {
+    if (state_ == State::IMPORTING) {
+        StepImport();
+    } else if (state_ == State::EXPORTING) {
+        StepExport();
+    }
+    return IsBusy();
+}
+
+void SmfLoopTransfer::Cancel() {
+    if (state_ == State::IMPORTING && load_started_) {
+        loop_->CancelLoad();    // The old loop stays
+    }
+    if (IsBusy()) state_ = State::IDLE;
+}
+
+void SmfLoopTransfer::StepImport() {
+    // The spare bank is free once the audio callback plays the published one
+    if (!load_started_) {
+        if (!loop_->BeginLoad()) return;
+        load_started_ = true;
+    }
+
+    size_t count = 0;
+    read_result_ = reader_.Read(batch_, EVENTS_PER_UPDATE, &count);
+    for (size_t i = 0; i < count; i++) {
+        if (loop_->AddLoadedEvent(batch_[i])) {
+            if (batch_[i].timestamp > last_sample_) last_sample_ = batch_[i].timestamp;
+            event_count_++;
+        } else {
+            dropped_count_++;
+        }
+    }
+
+    if (read_result_ == SmfReader::Result::OK) return;
+    if (read_result_ != SmfReader::Result::END || event_count_ == 0) {
+        loop_->CancelLoad();
+        Finish(false);
+        return;
+    }
+
+    // Up to the end of the longest track (notes ending there end just before it)
+    uint32_t length = reader_.GetEndSample();
+    if (length == 0) length = last_sample_ + 1;
+    loop_->EndLoad(length);
+    Finish(true);
+}
+
+void SmfLoopTransfer::StepExport() {
+    const MidiEventSpan events = loop_->GetEvents();
+    for (size_t n = 0; n < EVENTS_PER_UPDATE && event_count_ < events.size; n++) {
+        if (!writer_.Write(events[event_count_++])) {
+            Finish(false);
+            return;
+        }
+    }
+    if (event_count_ < events.size) return;
+
+    Finish(writer_.Close(loop_->GetLength()));
+}
+
+void SmfLoopTransfer::Finish(bool ok) {
+    state_ = ok ? State::DONE : State::FAILED;
+}
+
+} // namespace OpenChord
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "midi_loop.h"
+#include "smf_file.h"
+#include "../io/file_stream.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * SmfLoopTransfer - Loads a MidiLoop from a Standard MIDI File and bounces it back out
+ *
+ * Runs from the main loop a slice at a time: each Update() moves at most
+ * EVENTS_PER_UPDATE events between the file and the loop's event arena, so a
+ * large file never stalls the UI. An import fills the loop's spare bank while
+ * the old loop keeps playing and publishes it stopped, its length taken from
+ * the end of the file's longest track. An export writes the playing events as
+ * a format 0 file at the track tempo, with the end of track at the loop
+ * length; the loop doesn't merge overdubs until it's done.
+ *
+ * The file is opened and closed by the caller and must stay open while
+ * IsBusy(). Nothing is allocated.
+ */
+class SmfLoopTransfer {
+public:
+    static constexpr size_t EVENTS_PER_UPDATE = 64;
+
+    enum class State : uint8_t {
+        IDLE,
+        IMPORTING,
+        EXPORTING,
+        DONE,
+        FAILED
+    };
+
+    SmfLoopTransfer();
+    ~SmfLoopTransfer();
+
+    bool StartImport(MidiLoop* loop, IFileStream* file, float sample_rate);
+    bool StartExport(MidiLoop* loop, IFileStream* file, float sample_rate, float bpm);
+
+    // Main loop: one slice. Returns true while busy, when the loop's own
+    // Update() must wait (the export reads the bank it would rewrite)
+    bool Update();
+
+    void Cancel();
+
+    State GetState() const { return state_; }
+    bool IsBusy() const { return state_ == State::IMPORTING || state_ == State::EXPORTING; }
+    size_t GetEventCount() const { return event_count_; }   // Channel events moved so far
+    size_t GetDroppedCount() const { return dropped_count_; }  // Past the loop's capacity
+    SmfReader::Result GetReadResult() const { return read_result_; }
+
+private:
+    State state_;
+    MidiLoop* loop_;
+    size_t event_count_;
+    size_t dropped_count_;
+    uint32_t last_sample_;
+    SmfReader::Result read_result_;
+    bool load_started_;
+
+    SmfReader reader_;
+    SmfWriter writer_;
+    MidiEvent batch_[EVENTS_PER_UPDATE];
+
+    void StepImport();
+    void StepExport();
+    void Finish(bool ok);
+};
+
+} // namespace OpenChord
@@ -1,6 +1,7 @@
 #include "midi_router.h"
 #include "midi/midi_interface.h"
 #include "tracks/track_interface.h"
+#include "ui/global_settings.h"
 #include <cstring>
 
 namespace OpenChord {
@@ -9,6 +10,8 @@ MidiRouter::MidiRouter()
     : system_(nullptr)
     , midi_handler_(nullptr)
     , octave_shift_(nullptr)
+    , global_settings_(nullptr)
+    , track_event_count_(0)
 {
 }
 
@@ -20,12 +23,17 @@ void MidiRouter::Init(OpenChordSystem* system, OpenChordMidiHandler* midi_handle
     system_ = system;
     midi_handler_ = midi_handler;
     octave_shift_ = octave_shift;
+    
+    const SampleClock* clock = midi_handler ? midi_handler->GetSampleClock() : nullptr;
+    clock_follower_.Init(system ? system->GetTransportClock() : nullptr,
+                         clock ? clock->GetSampleRate() : 48000.0f);
 }
 
 void MidiRouter::RouteMIDI() {
     if (!system_ || !midi_handler_) return;
     
-    // Process incoming MIDI events from hardware (needed for RouteExternalMIDI)
+    // Drain MIDI received by the interrupt-driven queues into the hub
+    // (only place ProcessMidi is called - once per routing pass)
     midi_handler_->ProcessMidi();
     
     // Route external MIDI input to tracks
@@ -39,32 +47,35 @@ void MidiRouter::RouteExternalMIDI() {
     if (!system_) return;
     
     // Get USB and TRS input events separately (NOT combined - we don't want generated events here)
-    const std::vector<MidiHubEvent>& usb_input_events = Midi::GetUsbInputEvents();
-    const std::vector<MidiHubEvent>& trs_input_events = Midi::GetTrsInputEvents();
+    MidiEventSpan usb_input_events = Midi::GetUsbInputEvents();
+    MidiEventSpan trs_input_events = Midi::GetTrsInputEvents();
     
-    // Convert MidiHubEvent to track MidiEvent and route to active track
-    size_t track_event_count = 0;
-    const size_t max_events = MAX_EVENTS;
+    // Receive timestamps are in samples - take "now" once for the latency stats
+    const SampleClock* clock = midi_handler_->GetSampleClock();
+    uint32_t now_sample = clock ? clock->MicrosToSampleTime(daisy::System::GetUs()) : 0;
     
-    // Process USB input events
-    for (const auto& hub_event : usb_input_events) {
-        if (track_event_count >= max_events) break;
-        MidiEvent track_event = ConvertHubToTrackEvent(hub_event);
-        if (track_event.type == 0) continue;  // Skip unsupported types
-        track_events_[track_event_count++] = track_event;
+    if (global_settings_) {
+        clock_follower_.SetEnabled(global_settings_->GetClockSource() == ClockSource::MIDI_IN);
     }
     
-    // Process TRS input events
-    for (const auto& hub_event : trs_input_events) {
-        if (track_event_count >= max_events) break;
-        MidiEvent track_event = ConvertHubToTrackEvent(hub_event);
-        if (track_event.type == 0) continue;  // Skip unsupported types
-        track_events_[track_event_count++] = track_event;
+    // Route track event types to the active track (clock goes to the follower)
+    // Buffer is flushed whenever it fills, so no input is dropped
+    track_event_count_ = 0;
+    for (const MidiEvent& event : usb_input_events) {
+        QueueExternalEvent(event, now_sample);
+    }
+    for (const MidiEvent& event : trs_input_events) {
+        QueueExternalEvent(event, now_sample);
     }
+    FlushTrackEvents();
     
-    // Route MIDI events to active track via system
-    if (track_event_count > 0) {
-        system_->ProcessMIDI(track_events_, track_event_count);
+    // Clock timeout, and publish the followed tempo
+    clock_follower_.Update(now_sample);
+    if (clock_follower_.IsLocked()) {
+        if (MidiHub* hub = MidiHub::GetInstance()) {
+            hub->SetBPM(clock_follower_.GetTempo());
+            hub->SetMidiClock(clock_follower_.GetClockIndex());
+        }
     }
     
     // Clear processed input events from hub to prevent reprocessing
@@ -76,83 +87,71 @@ void MidiRouter::RouteExternalMIDI() {
     }
 }
 
+void MidiRouter::QueueExternalEvent(const MidiEvent& event, uint32_t now_sample) {
+    if (IsClockEventType(event.type)) {
+        clock_follower_.ProcessEvent(event);
+        return;
+    }
+    if (!IsTrackEventType(event.type)) return;  // Skip sysex, etc.
+    
+    // Receive interrupt -> track delivery latency
+    const SampleClock* clock = midi_handler_->GetSampleClock();
+    if (clock) {
+        latency_stats_.Record(clock->SamplesToMicros(now_sample - event.timestamp));
+    }
+    
+    track_events_[track_event_count_++] = event;
+    if (track_event_count_ >= MAX_EVENTS) {
+        FlushTrackEvents();
+    }
+}
+
+void MidiRouter::FlushTrackEvents() {
+    // Route MIDI events to active track via system
+    if (track_event_count_ > 0) {
+        system_->ProcessMIDI(track_events_, track_event_count_);
+        track_event_count_ = 0;
+    }
+}
+
 void MidiRouter::RouteGeneratedMIDI() {
     if (!system_ || !midi_handler_) return;
     
-    // Read generated MIDI events from hub (consuming read)
+    // Take generated MIDI events from hub (consuming read, no copy)
     // Track::GenerateMIDI() adds events to hub when it reads from plugins
     // Audio engine reads from plugin buffers directly, so consuming from hub is safe
-    std::vector<MidiHubEvent> hub_events;
-    Midi::ConsumeGeneratedEvents(hub_events);
+    MidiEventSpan generated_events = Midi::TakeGeneratedEvents();
     
-    // Convert hub events to track events, filter out BasicMidiInput (external MIDI echo), and send
-    for (const auto& hub_event : hub_events) {
+    for (const MidiEvent& event : generated_events) {
         // Skip external MIDI input events (we don't want to echo them back)
         // Generated events from built-in controls have source GENERATED
-        if (hub_event.source != MidiHubEvent::Source::GENERATED) {
+        if (event.source != MidiEvent::SOURCE_GENERATED || !IsTrackEventType(event.type)) {
             continue;
         }
         
-        // Convert hub event to track event format
-        MidiEvent track_event = ConvertHubToTrackEvent(hub_event);
-        if (track_event.type == 0) continue;  // Skip unsupported types
-        
-        // Apply octave shift to note messages
+        // Apply octave shift to note messages, queue for this pass's batch
         if (octave_shift_ && 
-            (track_event.type == static_cast<uint8_t>(MidiEvent::Type::NOTE_ON) ||
-             track_event.type == static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF))) {
-            track_event.data1 = octave_shift_->ApplyShift(track_event.data1);
+            (event.type == MidiEvent::NOTE_ON || event.type == MidiEvent::NOTE_OFF)) {
+            MidiEvent shifted = event;
+            shifted.data1 = octave_shift_->ApplyShift(event.data1);
+            midi_handler_->QueueMidi(shifted);
+        } else {
+            midi_handler_->QueueMidi(event);
         }
-        
-        // Convert back to hub format and send
-        daisy::MidiMessageType msg_type = ConvertTrackEventToHubType(track_event);
-        midi_handler_->SendMidi(msg_type, track_event.channel, track_event.data1, track_event.data2);
     }
+    
+    // One UART write for everything generated this pass (USB sends a packet per message)
+    midi_handler_->FlushMidi();
 }
 
-MidiEvent MidiRouter::ConvertHubToTrackEvent(const MidiHubEvent& hub_event) {
-    MidiEvent track_event;
-    track_event.channel = hub_event.channel;
-    track_event.data1 = hub_event.data[0];
-    track_event.data2 = hub_event.data[1];
-    track_event.timestamp = hub_event.timestamp;
-    
-    // Convert daisy::MidiMessageType to track MidiEvent::Type
-    switch (hub_event.type) {
-        case daisy::MidiMessageType::NoteOn:
-            track_event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_ON);
-            break;
-        case daisy::MidiMessageType::NoteOff:
-            track_event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF);
-            break;
-        case daisy::MidiMessageType::ControlChange:
-            track_event.type = static_cast<uint8_t>(MidiEvent::Type::CONTROL_CHANGE);
-            break;
-        case daisy::MidiMessageType::PitchBend:
-            track_event.type = static_cast<uint8_t>(MidiEvent::Type::PITCH_BEND);
-            break;
-        default:
-            track_event.type = 0;  // Invalid - caller should skip
-            break;
-    }
-    return track_event;
+bool MidiRouter::IsTrackEventType(uint8_t type) {
+    return type == MidiEvent::NOTE_ON || type == MidiEvent::NOTE_OFF
+        || type == MidiEvent::CONTROL_CHANGE || type == MidiEvent::PITCH_BEND;
 }
 
-daisy::MidiMessageType MidiRouter::ConvertTrackEventToHubType(const MidiEvent& track_event) {
-    // Convert track MidiEvent::Type (which uses MIDI status byte values) to daisy::MidiMessageType
-    // MidiEvent::Type uses raw MIDI status bytes: NOTE_ON=0x90, NOTE_OFF=0x80, etc.
-    if (track_event.type == static_cast<uint8_t>(MidiEvent::Type::NOTE_ON)) {
-        return daisy::MidiMessageType::NoteOn;
-    } else if (track_event.type == static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF)) {
-        return daisy::MidiMessageType::NoteOff;
-    } else if (track_event.type == static_cast<uint8_t>(MidiEvent::Type::PITCH_BEND)) {
-        return daisy::MidiMessageType::PitchBend;
-    } else if (track_event.type == static_cast<uint8_t>(MidiEvent::Type::CONTROL_CHANGE)) {
-        return daisy::MidiMessageType::ControlChange;
-    }
-    // Return NoteOff as default (safer than invalid type)
-    // This should not happen for valid note events, but provides a fallback
-    return daisy::MidiMessageType::NoteOff;
+bool MidiRouter::IsClockEventType(uint8_t type) {
+    return type == MidiEvent::CLOCK || type == MidiEvent::START
+        || type == MidiEvent::CONTINUE || type == MidiEvent::STOP;
 }
 
 bool MidiRouter::IsBasicMidiInputPlugin(const char* plugin_name) const {
@@ -5,6 +5,8 @@
 #include "midi/octave_shift.h"
 #include "midi/midi_types.h"
 #include "midi/midi_interface.h"
+#include "midi/midi_rx_queue.h"
+#include "midi/midi_clock_follower.h"
 #include "tracks/track_interface.h"
 #include <cstddef>
 
@@ -15,6 +17,7 @@ class OpenChordSystem;
 class OpenChordMidiHandler;
 class OctaveShift;
 class Track;
+class GlobalSettings;
 
 /**
  * MIDI Router
@@ -22,6 +25,7 @@ class Track;
  * Handles routing of MIDI events between:
  * - External MIDI inputs (USB, TRS) -> Tracks
  * - Tracks -> MIDI outputs (USB, TRS)
+ * - External MIDI clock -> MidiClockFollower (internal transport)
  * 
  * Consolidates the complex MIDI routing logic from main.cpp
  * Uses MidiHub for event storage and OpenChordMidiHandler for I/O
@@ -35,6 +39,9 @@ public:
     void Init(OpenChordSystem* system, OpenChordMidiHandler* midi_handler,
              OctaveShift* octave_shift);
     
+    // Clock source setting (follow incoming MIDI clock or not)
+    void SetGlobalSettings(GlobalSettings* global_settings) { global_settings_ = global_settings; }
+    
     /**
      * Route MIDI events
      * Call this from the main loop to:
@@ -43,23 +50,34 @@ public:
      */
     void RouteMIDI();
     
+    // Receive-to-track latency of external MIDI input
+    const MidiLatencyStats& GetLatencyStats() const { return latency_stats_; }
+    void ResetLatencyStats() { latency_stats_.Reset(); }
+    
+    // External clock sync state
+    const MidiClockFollower& GetClockFollower() const { return clock_follower_; }
+    
 private:
     OpenChordSystem* system_;
     OpenChordMidiHandler* midi_handler_;
     OctaveShift* octave_shift_;
+    GlobalSettings* global_settings_;
     
     // Event buffers (reused to avoid allocations)
     static constexpr size_t MAX_EVENTS = 64;
     MidiEvent track_events_[MAX_EVENTS];
-    MidiEvent generated_events_[MAX_EVENTS];
+    size_t track_event_count_;
     
-    // Conversion helpers
-    MidiEvent ConvertHubToTrackEvent(const MidiHubEvent& hub_event);
-    daisy::MidiMessageType ConvertTrackEventToHubType(const MidiEvent& track_event);
+    MidiLatencyStats latency_stats_;
+    MidiClockFollower clock_follower_;
     
     // Routing methods
     void RouteExternalMIDI();
     void RouteGeneratedMIDI();
+    void QueueExternalEvent(const MidiEvent& event, uint32_t now_sample);
+    static bool IsTrackEventType(uint8_t type);
+    static bool IsClockEventType(uint8_t type);
+    void FlushTrackEvents();
     bool IsBasicMidiInputPlugin(const char* plugin_name) const;
 };
 
@@ -0,0 +1,282 @@
+#include "arpeggiator.h"
+
+namespace OpenChord {
+
+Arpeggiator::Arpeggiator()
+    : sample_rate_(48000.0f)
+    , pattern_(static_cast<uint8_t>(Pattern::UP))
+    , ticks_per_step_(6)
+    , gate_(50)
+    , max_notes_per_second_(0.0f)
+    , limited_count_(0)
+    , last_note_(-1)
+    , ascending_(true)
+    , restart_(true)
+    , was_playing_(false)
+    , free_tick_(0)
+    , free_offset_q16_(0)
+    , tokens_(DENSITY_BURST)
+    , token_sample_(0)
+    , random_(0x2545F491u)
+{
+    held_.Clear();
+    for (auto& velocity : velocity_) {
+        velocity = 100;
+    }
+}
+
+Arpeggiator::~Arpeggiator() {
+}
+
+void Arpeggiator::SetSampleRate(float sample_rate) {
+    if (sample_rate > 0.0f) sample_rate_ = sample_rate;
+}
+
+void Arpeggiator::SetPattern(Pattern pattern) {
+    if (pattern >= Pattern::COUNT) pattern = Pattern::UP;
+    pattern_.store(static_cast<uint8_t>(pattern), std::memory_order_relaxed);
+}
+
+void Arpeggiator::SetTicksPerStep(uint32_t ticks) {
+    if (ticks < 1) ticks = 1;
+    if (ticks > TransportClock::PPQN * 4) ticks = TransportClock::PPQN * 4;
+    ticks_per_step_.store(ticks, std::memory_order_relaxed);
+}
+
+void Arpeggiator::SetGate(uint8_t percent) {
+    if (percent < 1) percent = 1;
+    if (percent > 100) percent = 100;
+    gate_.store(percent, std::memory_order_relaxed);
+}
+
+void Arpeggiator::SetMaxNotesPerSecond(float notes) {
+    max_notes_per_second_.store(notes > 0.0f ? notes : 0.0f, std::memory_order_relaxed);
+}
+
+void Arpeggiator::NoteOn(uint8_t note, uint8_t velocity, uint8_t channel) {
+    note &= 0x7F;
+    if (held_.count == 0) {
+        // A new phrase: the pattern starts over, on the channel it was played on
+        last_note_ = -1;
+        ascending_ = true;
+        restart_ = true;
+        if (!scheduler_.HasSoundingNotes()) {
+            scheduler_.SetChannel(channel);
+        }
+    }
+    held_.Insert(note);
+    velocity_[note] = velocity;
+}
+
+bool Arpeggiator::NoteOff(uint8_t note) {
+    return held_.Remove(note & 0x7F);
+}
+
+void Arpeggiator::ClearHeld() {
+    held_.Clear();
+    last_note_ = -1;
+}
+
+void Arpeggiator::ProcessBlock(const SongPosition& position, float bpm, uint32_t block_start_sample, size_t block_size,
+                               MidiEvent* events, size_t* count, size_t max_events) {
+    const uint32_t ticks_per_step = ticks_per_step_.load(std::memory_order_relaxed);
+    const uint64_t block_q16 = static_cast<uint64_t>(block_size) << 16;
+    const bool playing = position.playing && position.tick_interval_q16 > 0;
+
+    // Clock grid for the block: the transport's, or our own at the track tempo
+    uint32_t tick;
+    uint64_t offset_q16;
+    uint32_t interval_q16;
+    if (playing) {
+        tick = position.block_tick;
+        offset_q16 = position.block_tick_offset_q16;
+        interval_q16 = position.tick_interval_q16;
+    } else {
+        if (restart_ || was_playing_) {
+            free_tick_ = 0;
+            free_offset_q16_ = 0;
+        }
+        if (bpm < TransportClock::MIN_TEMPO) bpm = TransportClock::MIN_TEMPO;
+        double samples_per_tick = static_cast<double>(sample_rate_) * 60.0 / (static_cast<double>(bpm) * TransportClock::PPQN);
+        tick = free_tick_;
+        offset_q16 = free_offset_q16_;
+        interval_q16 = static_cast<uint32_t>(samples_per_tick * 65536.0 + 0.5);
+    }
+    restart_ = false;
+    was_playing_ = playing;
+
+    if (!playing) {
+        // Carry the free grid over to the next block
+        uint32_t clocks = offset_q16 < block_q16
+                        ? static_cast<uint32_t>((block_q16 - offset_q16 + interval_q16 - 1) / interval_q16) : 0;
+        free_tick_ = tick + clocks;
+        free_offset_q16_ = static_cast<uint32_t>(offset_q16 + static_cast<uint64_t>(clocks) * interval_q16 - block_q16);
+    }
+
+    // Step boundaries in the block, as StepSequencer finds them
+    const uint64_t step_length_q16 = static_cast<uint64_t>(ticks_per_step) * interval_q16;
+    const uint32_t to_step = (ticks_per_step - tick % ticks_per_step) % ticks_per_step;
+    offset_q16 += static_cast<uint64_t>(to_step) * interval_q16;
+    while (offset_q16 < block_q16) {
+        TriggerStep(block_start_sample + static_cast<uint32_t>(offset_q16 >> 16), step_length_q16);
+        offset_q16 += step_length_q16;
+    }
+
+    scheduler_.EmitDue(block_start_sample, block_start_sample + static_cast<uint32_t>(block_size),
+                       events, count, max_events);
+}
+
+void Arpeggiator::Release(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events) {
+    scheduler_.Release(block_start_sample, events, count, max_events);
+}
+
+void Arpeggiator::TriggerStep(uint32_t sample, uint64_t step_length_q16) {
+    if (held_.count == 0) return;
+
+    uint32_t gate_samples = static_cast<uint32_t>((step_length_q16 * gate_.load(std::memory_order_relaxed) / 100) >> 16);
+    if (gate_samples == 0) gate_samples = 1;
+
+    int note = -1;
+    switch (GetPattern()) {
+        case Pattern::UP:
+            note = held_.Next(last_note_);
+            if (note < 0) note = held_.Next(-1);
+            break;
+
+        case Pattern::DOWN:
+            note = held_.Previous(last_note_ < 0 ? 128 : last_note_);
+            if (note < 0) note = held_.Previous(128);
+            break;
+
+        case Pattern::UP_DOWN:
+            if (ascending_) {
+                note = held_.Next(last_note_);
+                if (note < 0) {
+                    ascending_ = false;
+                    note = held_.Previous(last_note_);
+                }
+            } else {
+                note = held_.Previous(last_note_ < 0 ? 128 : last_note_);
+                if (note < 0) {
+                    ascending_ = true;
+                    note = held_.Next(last_note_);
+                }
+            }
+            if (note < 0) note = held_.Next(-1);   // A single held note
+            break;
+
+        case Pattern::RANDOM:
+            note = held_.Nth(random_.Next() % held_.count);
+            break;
+
+        case Pattern::CHORD: {
+            size_t played = 0;
+            for (int n = held_.Next(-1); n >= 0 && played < MAX_CHORD_NOTES; n = held_.Next(n)) {
+                Play(n, sample, gate_samples);
+                played++;
+            }
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    if (note >= 0) {
+        Play(note, sample, gate_samples);
+        last_note_ = note;
+    }
+}
+
+void Arpeggiator::Play(int note, uint32_t sample, uint32_t gate_samples) {
+    if (!TakeToken(sample)) {
+        limited_count_.store(limited_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    uint8_t n = static_cast<uint8_t>(note);
+    scheduler_.Schedule(sample, sample + gate_samples, n, velocity_[n]);
+}
+
+bool Arpeggiator::TakeToken(uint32_t sample) {
+    const float rate = max_notes_per_second_.load(std::memory_order_relaxed);
+    if (rate <= 0.0f) return true;
+
+    // Refill up to this step's sample, so the limit doesn't depend on the block size
+    int32_t elapsed = static_cast<int32_t>(sample - token_sample_);
+    if (elapsed > 0) {
+        tokens_ += static_cast<float>(elapsed) * rate / sample_rate_;
+        if (tokens_ > DENSITY_BURST) tokens_ = DENSITY_BURST;
+    }
+    token_sample_ = sample;
+    if (tokens_ < 1.0f) return false;
+    tokens_ -= 1.0f;
+    return true;
+}
+
+void Arpeggiator::HeldNotes::Clear() {
+    for (auto& word : bits) {
+        word = 0;
+    }
+    count = 0;
+}
+
+bool Arpeggiator::HeldNotes::Insert(uint8_t note) {
+    uint32_t bit = 1u << (note & 31);
+    uint32_t& word = bits[note >> 5];
+    if (word & bit) return false;
+    word |= bit;
+    count++;
+    return true;
+}
+
+bool Arpeggiator::HeldNotes::Remove(uint8_t note) {
+    uint32_t bit = 1u << (note & 31);
+    uint32_t& word = bits[note >> 5];
+    if (!(word & bit)) return false;
+    word &= ~bit;
+    count--;
+    return true;
+}
+
+int Arpeggiator::HeldNotes::Next(int after) const {
+    int start = after + 1;
+    if (start < 0) start = 0;
+    if (start > 127) return -1;
+    int w = start >> 5;
+    uint32_t word = bits[w] & (~0u << (start & 31));
+    while (true) {
+        if (word) return w * 32 + __builtin_ctz(word);
+        if (++w > 3) return -1;
+        word = bits[w];
+    }
+}
+
+int Arpeggiator::HeldNotes::Previous(int before) const {
+    int end = before - 1;
+    if (end > 127) end = 127;
+    if (end < 0) return -1;
+    int w = end >> 5;
+    uint32_t word = bits[w] & (~0u >> (31 - (end & 31)));
+    while (true) {
+        if (word) return w * 32 + 31 - __builtin_clz(word);
+        if (--w < 0) return -1;
+        word = bits[w];
+    }
+}
+
+int Arpeggiator::HeldNotes::Nth(size_t n) const {
+    for (int w = 0; w < 4; w++) {
+        size_t in_word = static_cast<size_t>(__builtin_popcount(bits[w]));
+        if (n < in_word) {
+            uint32_t word = bits[w];
+            for (size_t i = 0; i < n; i++) {
+                word &= word - 1;
+            }
+            return w * 32 + __builtin_ctz(word);
+        }
+        n -= in_word;
+    }
+    return -1;
+}
+
+} // namespace OpenChord
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../midi/midi_types.h"
+#include "../audio/transport_clock.h"
+#include "note_scheduler.h"
+#include "xorshift.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * Arpeggiator - Plays held notes one step at a time on the audio timeline
+ *
+ * Note-ons/offs from the input stack go into a 128-bit held-note set
+ * (insert/remove are one bit; the next note up or down is a count of
+ * leading/trailing zeros over four words), and each step plays from it in
+ * the chosen pattern. Steps are placed like StepSequencer's: from the
+ * transport's clock grid while it plays, otherwise from a free-running grid
+ * at the track tempo that starts with the first note held.
+ *
+ * The note density limit is a token bucket in samples: a step that finds
+ * no token is skipped, so a fast chord-repeat can't flood the instrument's
+ * voices. Settings are written from the main loop; everything else runs in
+ * the audio callback.
+ */
+class Arpeggiator {
+public:
+    enum class Pattern : uint8_t {
+        UP,
+        DOWN,
+        UP_DOWN,        // Turns around without repeating the top or bottom note
+        RANDOM,
+        CHORD,          // Every held note, each step
+        COUNT
+    };
+
+    static constexpr size_t MAX_CHORD_NOTES = 8;     // Per step, for CHORD
+    static constexpr float DENSITY_BURST = 4.0f;     // Notes the limit lets through at once
+
+    Arpeggiator();
+    ~Arpeggiator();
+
+    // Main loop side
+    void SetSampleRate(float sample_rate);
+    void SetPattern(Pattern pattern);
+    Pattern GetPattern() const { return static_cast<Pattern>(pattern_.load(std::memory_order_relaxed)); }
+    void SetTicksPerStep(uint32_t ticks);           // 24 PPQN clocks: 6 = sixteenths
+    void SetGate(uint8_t percent);                   // Of the step, 1-100
+    void SetMaxNotesPerSecond(float notes);          // 0 = no limit
+    uint32_t GetLimitedCount() const { return limited_count_.load(std::memory_order_relaxed); }
+
+    // Audio callback: input from the stack
+    void NoteOn(uint8_t note, uint8_t velocity, uint8_t channel);
+    bool NoteOff(uint8_t note);     // False if it wasn't held here
+    void ClearHeld();
+
+    // Audio callback: appends the block's notes, timestamped on their sample
+    void ProcessBlock(const SongPosition& position, float bpm, uint32_t block_start_sample, size_t block_size,
+                      MidiEvent* events, size_t* count, size_t max_events);
+
+    // Audio callback: note-offs for everything sounding, at the block start
+    void Release(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events);
+
+    size_t GetHeldCount() const { return held_.count; }
+    bool HasSoundingNotes() const { return scheduler_.HasSoundingNotes(); }
+
+private:
+    // Held notes, one bit each
+    struct HeldNotes {
+        uint32_t bits[4];
+        uint8_t count;
+
+        void Clear();
+        bool Insert(uint8_t note);      // False if already held
+        bool Remove(uint8_t note);      // False if not held
+        int Next(int after) const;      // Lowest held note above `after`, -1 if none
+        int Previous(int before) const; // Highest held note below `before`, -1 if none
+        int Nth(size_t n) const;        // n-th lowest
+    };
+
+    float sample_rate_;
+    std::atomic<uint8_t> pattern_;
+    std::atomic<uint32_t> ticks_per_step_;
+    std::atomic<uint8_t> gate_;
+    std::atomic<float> max_notes_per_second_;
+    std::atomic<uint32_t> limited_count_;
+
+    // Audio callback state
+    HeldNotes held_;
+    uint8_t velocity_[128];             // Of each held note
+    int last_note_;                     // Last played, -1 = start of the pattern
+    bool ascending_;                    // UP_DOWN direction
+    bool restart_;                      // First note held: the free grid starts over
+    bool was_playing_;
+    uint32_t free_tick_;                // Free-running grid (transport stopped)
+    uint32_t free_offset_q16_;
+    float tokens_;
+    uint32_t token_sample_;
+    Xorshift32 random_;
+    NoteScheduler scheduler_;
+
+    void TriggerStep(uint32_t sample, uint64_t step_length_q16);
+    void Play(int note, uint32_t sample, uint32_t gate_samples);
+    bool TakeToken(uint32_t sample);
+};
+
+} // namespace OpenChord
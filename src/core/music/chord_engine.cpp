@@ -1,7 +1,7 @@
 #include "chord_engine.h"
-#include "../io/joystick_input_handler.h"  // For JoystickDirection enum
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
 
 namespace OpenChord {
 
@@ -148,13 +148,243 @@ static const JoystickPreset joystick_presets[] = {
     }
 };
 
+// Intervals above the root for each ChordQuality, in enum order
+static constexpr uint8_t quality_intervals[ChordEngine::QUALITY_COUNT][5] = {
+    {0, 4, 7},              // MAJOR:      1-3-5
+    {0, 3, 7},              // MINOR:      1-b3-5
+    {0, 3, 6},              // DIMINISHED: 1-b3-b5
+    {0, 4, 8},              // AUGMENTED:  1-3-#5
+    {0, 4, 7, 11},          // MAJOR_7:    1-3-5-7
+    {0, 3, 7, 10},          // MINOR_7:    1-b3-5-b7
+    {0, 4, 7, 10},          // DOMINANT_7: 1-3-5-b7
+    {0, 4, 7, 11, 14},      // MAJOR_9:    1-3-5-7-9
+    {0, 3, 7, 10, 14},      // MINOR_9:    1-b3-5-b7-9
+    {0, 5, 7},              // SUS4:       1-4-5
+    {0, 2, 7}               // SUS2:       1-2-5
+};
+static constexpr uint8_t quality_note_counts[ChordEngine::QUALITY_COUNT] = {3, 3, 3, 3, 4, 4, 4, 5, 5, 3, 3};
+
+// Chord shape: semitones above the root, lowest note first, for each
+// quality and inversion. Built at compile time.
+struct ChordShape {
+    uint8_t count;
+    uint8_t offsets[5];
+};
+
+struct ChordShapeTable {
+    ChordShape shapes[ChordEngine::QUALITY_COUNT][ChordEngine::INVERSION_COUNT];
+};
+
+static constexpr ChordShapeTable BuildChordShapes() {
+    ChordShapeTable table{};
+    for (int q = 0; q < ChordEngine::QUALITY_COUNT; q++) {
+        const int count = quality_note_counts[q];
+        for (int inv = 0; inv < ChordEngine::INVERSION_COUNT; inv++) {
+            // An inversion moves the lowest notes up an octave:
+            // 1st the root, 2nd the root and the third
+            ChordShape& shape = table.shapes[q][inv];
+            shape.count = static_cast<uint8_t>(count);
+            int n = 0;
+            for (int i = inv; i < count; i++) {
+                shape.offsets[n++] = quality_intervals[q][i];
+            }
+            for (int i = 0; i < inv; i++) {
+                shape.offsets[n++] = static_cast<uint8_t>(quality_intervals[q][i] + 12);
+            }
+        }
+    }
+    return table;
+}
+
+static constexpr ChordShapeTable chord_shapes = BuildChordShapes();
+
+// Chord names for every root pitch class, quality and inversion, interned so
+// a chord only carries a pointer. Built at compile time.
+static constexpr const char* root_names[12] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+static constexpr const char* quality_suffixes[ChordEngine::QUALITY_COUNT] = {
+    "", "m", "dim", "aug", "maj7", "m7", "7", "maj9", "m9", "sus4", "sus2"
+};
+static constexpr const char* inversion_suffixes[ChordEngine::INVERSION_COUNT] = {"", " 1st Inv", " 2nd Inv"};
+static constexpr size_t CHORD_NAME_SIZE = 16;      // Longest is "C#maj9 1st Inv"
+
+struct ChordNameTable {
+    char names[12][ChordEngine::QUALITY_COUNT][ChordEngine::INVERSION_COUNT][CHORD_NAME_SIZE];
+};
+
+static constexpr void AppendName(char* name, size_t& length, const char* text) {
+    while (*text && length < CHORD_NAME_SIZE - 1) {
+        name[length++] = *text++;
+    }
+}
+
+static constexpr ChordNameTable BuildChordNames() {
+    ChordNameTable table{};
+    for (int root = 0; root < 12; root++) {
+        for (int q = 0; q < ChordEngine::QUALITY_COUNT; q++) {
+            for (int inv = 0; inv < ChordEngine::INVERSION_COUNT; inv++) {
+                char* name = table.names[root][q][inv];
+                size_t length = 0;
+                AppendName(name, length, root_names[root]);
+                AppendName(name, length, quality_suffixes[q]);
+                AppendName(name, length, inversion_suffixes[inv]);
+            }
+        }
+    }
+    return table;
+}
+
+static constexpr ChordNameTable chord_names = BuildChordNames();
+
+// Physical button (left to right: 0, 4, 1, 5, 2, 6, 3) to scale degree
+static constexpr int button_scale_degrees[7] = {0, 2, 4, 6, 1, 3, 5};
+
+// JoystickDirection (CENTER, UP, DOWN, LEFT, RIGHT, UP_LEFT, UP_RIGHT,
+// DOWN_LEFT, DOWN_RIGHT) to the preset's direction index
+// (NORTH, NORTHEAST, EAST, SOUTHEAST, SOUTH, SOUTHWEST, WEST, NORTHWEST)
+static constexpr int direction_preset_index[9] = {-1, 0, 4, 6, 2, 7, 1, 5, 3};
+
+// Fill a chord from the tables: notes, clamped to the MIDI range, and name
+static void FillChord(Chord* chord, uint8_t root_midi_note, int quality_index, int inversion_index) {
+    const ChordShape& shape = chord_shapes.shapes[quality_index][inversion_index];
+    chord->root_note = root_midi_note;
+    chord->quality = static_cast<ChordQuality>(quality_index);
+    chord->inversion = static_cast<ChordInversion>(inversion_index);
+    chord->note_count = shape.count;
+    for (int i = 0; i < shape.count; i++) {
+        int note = root_midi_note + shape.offsets[i];
+        chord->notes[i] = static_cast<uint8_t>(note > 127 ? 127 : note);
+    }
+    chord->name = chord_names.names[root_midi_note % 12][quality_index][inversion_index];
+}
+
+static int QualityIndex(ChordQuality quality) {
+    int index = static_cast<int>(quality);
+    return (index >= 0 && index < ChordEngine::QUALITY_COUNT) ? index : 0;
+}
+
+static int InversionIndex(ChordInversion inversion) {
+    int index = static_cast<int>(inversion);
+    return (index >= 0 && index < ChordEngine::INVERSION_COUNT) ? index : 0;
+}
+
 ChordEngine::ChordEngine() {
+    SetKey(MusicalKey(0, MusicalMode::IONIAN));
 }
 
 ChordEngine::~ChordEngine() {
 }
 
-void ChordEngine::GetScaleIntervals(MusicalMode mode, int* intervals, int* count) const {
+void ChordEngine::SetKey(MusicalKey key) {
+    int mode_idx = static_cast<int>(key.mode);
+    if (mode_idx < 0 || mode_idx >= 7) {
+        mode_idx = 0;
+        key.mode = MusicalMode::IONIAN;
+    }
+    key.root_note %= 12;
+    key_ = key;
+    
+    for (int degree = 0; degree < SCALE_DEGREE_COUNT; degree++) {
+        // Same root as GetButtonMapping: C4 (60) + key root + scale interval
+        int root = 60 + key.root_note + mode_intervals[mode_idx][degree];
+        uint8_t root_midi_note = static_cast<uint8_t>(root > 127 ? 127 : root);
+        key_qualities_[degree] = mode_chord_qualities[mode_idx][degree];
+        
+        for (int q = 0; q < QUALITY_COUNT; q++) {
+            for (int inv = 0; inv < INVERSION_COUNT; inv++) {
+                FillChord(&key_chords_[degree][q][inv], root_midi_note, q, inv);
+            }
+        }
+    }
+}
+
+int ChordEngine::ResolveQualityIndex(int scale_degree, int direction, int preset_index) const {
+    ChordQuality quality = key_qualities_[scale_degree];
+    if (direction > 0 && direction <= 8) {
+        if (preset_index < 0 || preset_index >= GetJoystickPresetCount()) preset_index = 0;
+        quality = joystick_presets[preset_index].direction_qualities[direction_preset_index[direction]];
+    }
+    return QualityIndex(quality);
+}
+
+const Chord& ChordEngine::GetKeyChord(int scale_degree, int direction, int preset_index,
+                                      ChordInversion inversion) const {
+    if (scale_degree < 0 || scale_degree >= SCALE_DEGREE_COUNT) scale_degree = 0;
+    
+    int quality_index = ResolveQualityIndex(scale_degree, direction, preset_index);
+    return key_chords_[scale_degree][quality_index][InversionIndex(inversion)];
+}
+
+// Semitones between two voicings: each note to the nearest note of the other
+// chord, both ways, so a common tone costs nothing and a dropped or added
+// note costs its distance to the rest
+static int VoicingDistance(const Chord& candidate, int shift, const Chord& previous) {
+    int total = 0;
+    for (int i = 0; i < candidate.note_count; i++) {
+        int nearest = 128;
+        for (int j = 0; j < previous.note_count; j++) {
+            int distance = std::abs(candidate.notes[i] + shift - previous.notes[j]);
+            if (distance < nearest) nearest = distance;
+        }
+        total += nearest;
+    }
+    for (int j = 0; j < previous.note_count; j++) {
+        int nearest = 128;
+        for (int i = 0; i < candidate.note_count; i++) {
+            int distance = std::abs(candidate.notes[i] + shift - previous.notes[j]);
+            if (distance < nearest) nearest = distance;
+        }
+        total += nearest;
+    }
+    return total;
+}
+
+void ChordEngine::GetVoiceLedChord(int scale_degree, int direction, int preset_index,
+                                   const Chord& previous, Chord* chord) const {
+    if (!chord) return;
+    if (scale_degree < 0 || scale_degree >= SCALE_DEGREE_COUNT) scale_degree = 0;
+    
+    const Chord* candidates = key_chords_[scale_degree][ResolveQualityIndex(scale_degree, direction, preset_index)];
+    if (previous.note_count == 0) {
+        *chord = candidates[static_cast<int>(ChordInversion::ROOT)];
+        return;
+    }
+    
+    // Fixed scan: INVERSION_COUNT x OCTAVE_PLACEMENTS candidates of at most 5 notes
+    const int home = candidates[0].notes[0];
+    int best_inversion = 0;
+    int best_shift = 0;
+    int best_cost = 0x7FFFFFFF;
+    int best_register = 0x7FFFFFFF;
+    for (int inv = 0; inv < INVERSION_COUNT; inv++) {
+        const Chord& candidate = candidates[inv];
+        for (int placement = 0; placement < OCTAVE_PLACEMENTS; placement++) {
+            const int shift = (placement - 1) * 12;
+            bool in_range = true;
+            for (int i = 0; i < candidate.note_count; i++) {
+                int note = candidate.notes[i] + shift;
+                if (note < 0 || note > 127) in_range = false;
+            }
+            if (!in_range) continue;
+            
+            int cost = VoicingDistance(candidate, shift, previous);
+            int register_distance = std::abs(candidate.notes[0] + shift - home);
+            if (cost < best_cost || (cost == best_cost && register_distance < best_register)) {
+                best_cost = cost;
+                best_register = register_distance;
+                best_inversion = inv;
+                best_shift = shift;
+            }
+        }
+    }
+    
+    *chord = candidates[best_inversion];
+    chord->root_note = static_cast<uint8_t>(chord->root_note + best_shift);
+    for (int i = 0; i < chord->note_count; i++) {
+        chord->notes[i] = static_cast<uint8_t>(chord->notes[i] + best_shift);
+    }
+}
+
+void ChordEngine::GetScaleIntervals(MusicalMode mode, int* intervals, int* count) {
     *count = 7;
     int mode_idx = static_cast<int>(mode);
     if (mode_idx >= 0 && mode_idx < 7) {
@@ -169,49 +399,32 @@ void ChordEngine::GetScaleIntervals(MusicalMode mode, int* intervals, int* count
     }
 }
 
-int ChordEngine::PhysicalButtonToScaleDegree(int physical_button_index) const {
+int ChordEngine::PhysicalButtonToScaleDegree(int physical_button_index) {
     // Physical layout (left to right): White0, Black4, White1, Black5, White2, Black6, White3
     // This maps to scale degrees: I, II, III, IV, V, VI, VII (0, 1, 2, 3, 4, 5, 6)
-    // Physical left-to-right: 0, 4, 1, 5, 2, 6, 3 → Scale degrees: 0, 1, 2, 3, 4, 5, 6
-    switch (physical_button_index) {
-        case 0: return 0;  // Leftmost white → I
-        case 4: return 1;  // First black → II
-        case 1: return 2;  // Second white → III
-        case 5: return 3;  // Second black → IV
-        case 2: return 4;  // Third white → V
-        case 6: return 5;  // Third black → VI
-        case 3: return 6;  // Rightmost white → VII
-        default: return 0;
+    if (physical_button_index < 0 || physical_button_index >= 7) {
+        return 0;
     }
+    return button_scale_degrees[physical_button_index];
 }
 
-void ChordEngine::GetButtonMapping(MusicalKey key, int button_index, uint8_t* root_midi_note) const {
+void ChordEngine::GetButtonMapping(MusicalKey key, int button_index, uint8_t* root_midi_note) {
     if (!root_midi_note || button_index < 0 || button_index >= 7) {
         return;
     }
     
     // Convert physical button index to scale degree
     int scale_degree = PhysicalButtonToScaleDegree(button_index);
-    
-    // Get scale intervals for the mode
-    int intervals[7];
-    int count;
-    GetScaleIntervals(key.mode, intervals, &count);
+    int mode_idx = static_cast<int>(key.mode);
+    if (mode_idx < 0 || mode_idx >= 7) {
+        mode_idx = 0;  // Default to Ionian (major)
+    }
     
     // Calculate MIDI note: root (C4=60) + root note offset + scale interval
-    // C4 = 60 (calculated directly, no need for separate base_octave variable)
-    uint8_t root_midi_base = 60 + key.root_note;  // Root note in MIDI (60-71)
+    int note = 60 + key.root_note + mode_intervals[mode_idx][scale_degree];
     
-    // Get interval for this scale degree
-    int interval = intervals[scale_degree];
-    
-    // Calculate final MIDI note
-    *root_midi_note = root_midi_base + interval;
-    
-    // Wrap if needed (keep in reasonable range)
-    if (*root_midi_note > 127) {
-        *root_midi_note = 127;
-    }
+    // Clamp to the MIDI range
+    *root_midi_note = static_cast<uint8_t>(note > 127 ? 127 : note);
 }
 
 ChordQuality ChordEngine::GetChordQualityForDegree(MusicalMode mode, int scale_degree) const {
@@ -229,76 +442,22 @@ ChordQuality ChordEngine::GetChordQualityForDegree(MusicalMode mode, int scale_d
 }
 
 ChordQuality ChordEngine::ApplyJoystickVariation(ChordQuality base_quality, int direction, int preset_index) const {
-    // JoystickDirection enum: CENTER=0, UP=1, DOWN=2, LEFT=3, RIGHT=4, UP_LEFT=5, UP_RIGHT=6, DOWN_LEFT=7, DOWN_RIGHT=8
-    // Preset array order: [NORTH, NORTHEAST, EAST, SOUTHEAST, SOUTH, SOUTHWEST, WEST, NORTHWEST]
-    //                     [  0  ,     1     ,  2  ,    3     ,  4  ,     5    ,  6  ,    7    ]
-    // We need to map enum values to preset array indices:
-    // UP(1) -> 0, UP_RIGHT(6) -> 1, RIGHT(4) -> 2, DOWN_RIGHT(8) -> 3,
-    // DOWN(2) -> 4, DOWN_LEFT(7) -> 5, LEFT(3) -> 6, UP_LEFT(5) -> 7
-    
+    // The preset names a quality per direction; center (0) or an invalid
+    // direction keeps the base quality.
+    //
+    // IMPORTANT: This variation system works with ANY key and mode!
+    // The root note comes from key.root_note (C=0...B=11) + mode scale intervals.
+    // Presets define chord QUALITIES (maj7, min9, etc.), not specific notes.
+    // Example: C Major button 0 + UP (maj9) = Cmaj9, D Dorian button 0 + UP (maj9) = Dmaj9
     if (direction <= 0 || direction > 8) {
-        return base_quality;  // No change for center or invalid
+        return base_quality;
     }
     
     if (preset_index < 0 || preset_index >= GetJoystickPresetCount()) {
         preset_index = 0;  // Default to first preset
     }
     
-    const JoystickPreset* preset = GetJoystickPreset(preset_index);
-    if (!preset) {
-        return base_quality;
-    }
-    
-    // Map JoystickDirection enum to preset array index
-    // Preset order: NORTH, NORTHEAST, EAST, SOUTHEAST, SOUTH, SOUTHWEST, WEST, NORTHWEST
-    int dir_index = -1;
-    switch (direction) {
-        case 1: dir_index = 0; break;  // UP -> NORTH
-        case 6: dir_index = 1; break;  // UP_RIGHT -> NORTHEAST
-        case 4: dir_index = 2; break;  // RIGHT -> EAST
-        case 8: dir_index = 3; break;  // DOWN_RIGHT -> SOUTHEAST
-        case 2: dir_index = 4; break;  // DOWN -> SOUTH
-        case 7: dir_index = 5; break;  // DOWN_LEFT -> SOUTHWEST
-        case 3: dir_index = 6; break;  // LEFT -> WEST
-        case 5: dir_index = 7; break;  // UP_LEFT -> NORTHWEST
-        default: return base_quality;
-    }
-    
-    if (dir_index < 0 || dir_index >= 8) {
-        return base_quality;
-    }
-    
-    ChordQuality variation = preset->direction_qualities[dir_index];
-    
-    // Smart application: if base is minor and variation is major-only, we could blend
-    // For now, just return the variation quality, but preserve base quality type
-    // This means if base is minor, we try to keep it minor if variation allows
-    
-    // If variation is a 7th/9th extension, we can apply it to any base
-    // If variation is major/minor, we need to be smarter
-    
-    // For extensions (7th, 9th), apply them to the base quality
-    if (variation == ChordQuality::MAJOR_7 || variation == ChordQuality::MINOR_7 ||
-        variation == ChordQuality::DOMINANT_7 || variation == ChordQuality::MAJOR_9 ||
-        variation == ChordQuality::MINOR_9) {
-        // Extensions can be applied to any base
-        return variation;
-    }
-    
-    // For sus chords, apply them
-    if (variation == ChordQuality::SUS2 || variation == ChordQuality::SUS4) {
-        return variation;
-    }
-    
-    // For basic major/minor, preserve the base quality type but add extensions if needed
-    // Actually, just return the variation - let the preset designer choose
-    
-    // IMPORTANT: This variation system works with ANY key and mode!
-    // The root note comes from key.root_note (C=0...B=11) + mode scale intervals.
-    // Presets define chord QUALITIES (maj7, min9, etc.), not specific notes.
-    // Example: C Major button 0 + UP (maj9) = Cmaj9, D Dorian button 0 + UP (maj9) = Dmaj9
-    
-    return variation;
+    return joystick_presets[preset_index].direction_qualities[direction_preset_index[direction]];
 }
 
 const JoystickPreset* ChordEngine::GetJoystickPreset(int index) const {
@@ -315,192 +474,13 @@ int ChordEngine::GetJoystickPresetCount() const {
 void ChordEngine::GenerateChord(Chord* chord, uint8_t root_midi_note, ChordQuality quality, ChordInversion inversion) {
     if (!chord) return;
     
-    chord->root_note = root_midi_note;
-    chord->quality = quality;
-    chord->inversion = inversion;
-    
-    // Get intervals for this quality
-    int intervals[5];
-    int interval_count = 0;
-    GetIntervalsForQuality(quality, intervals, &interval_count);
-    
-    // Generate base chord notes
-    uint8_t notes[5];
-    notes[0] = root_midi_note;  // Root
-    
-    for (int i = 0; i < interval_count; i++) {
-        uint8_t note = root_midi_note + intervals[i];
-        if (note > 127) note = 127;  // Clamp to MIDI range
-        notes[i + 1] = note;
-    }
-    
-    chord->note_count = interval_count + 1;
-    
-    // Copy to chord structure
-    for (int i = 0; i < chord->note_count; i++) {
-        chord->notes[i] = notes[i];
-    }
-    
-    // Apply inversion
-    if (inversion != ChordInversion::ROOT) {
-        ApplyInversion(chord->notes, chord->note_count, inversion);
-    }
-    
-    // Generate name
-    GetChordName(chord);
-}
-
-void ChordEngine::GetIntervalsForQuality(ChordQuality quality, int* intervals, int* count) const {
-    *count = 0;
-    
-    switch (quality) {
-        case ChordQuality::MAJOR:
-            intervals[0] = 4;   // Major 3rd
-            intervals[1] = 7;   // Perfect 5th
-            *count = 2;
-            break;
-            
-        case ChordQuality::MINOR:
-            intervals[0] = 3;   // Minor 3rd
-            intervals[1] = 7;   // Perfect 5th
-            *count = 2;
-            break;
-            
-        case ChordQuality::DIMINISHED:
-            intervals[0] = 3;   // Minor 3rd
-            intervals[1] = 6;   // Diminished 5th
-            *count = 2;
-            break;
-            
-        case ChordQuality::AUGMENTED:
-            intervals[0] = 4;   // Major 3rd
-            intervals[1] = 8;   // Augmented 5th
-            *count = 2;
-            break;
-            
-        case ChordQuality::MAJOR_7:
-            intervals[0] = 4;   // Major 3rd
-            intervals[1] = 7;   // Perfect 5th
-            intervals[2] = 11;  // Major 7th
-            *count = 3;
-            break;
-            
-        case ChordQuality::MINOR_7:
-            intervals[0] = 3;   // Minor 3rd
-            intervals[1] = 7;   // Perfect 5th
-            intervals[2] = 10;  // Minor 7th
-            *count = 3;
-            break;
-            
-        case ChordQuality::DOMINANT_7:
-            intervals[0] = 4;   // Major 3rd
-            intervals[1] = 7;   // Perfect 5th
-            intervals[2] = 10;  // Minor 7th
-            *count = 3;
-            break;
-            
-        case ChordQuality::MAJOR_9:
-            intervals[0] = 4;   // Major 3rd
-            intervals[1] = 7;   // Perfect 5th
-            intervals[2] = 11;  // Major 7th
-            intervals[3] = 14;  // Major 9th (octave + 2 semitones)
-            *count = 4;
-            break;
-            
-        case ChordQuality::MINOR_9:
-            intervals[0] = 3;   // Minor 3rd
-            intervals[1] = 7;   // Perfect 5th
-            intervals[2] = 10;  // Minor 7th
-            intervals[3] = 14;  // Major 9th
-            *count = 4;
-            break;
-            
-        case ChordQuality::SUS4:
-            intervals[0] = 5;   // Perfect 4th
-            intervals[1] = 7;   // Perfect 5th
-            *count = 2;
-            break;
-            
-        case ChordQuality::SUS2:
-            intervals[0] = 2;   // Major 2nd
-            intervals[1] = 7;   // Perfect 5th
-            *count = 2;
-            break;
-    }
-}
-
-void ChordEngine::ApplyInversion(uint8_t* notes, uint8_t note_count, ChordInversion inversion) {
-    if (!notes || note_count == 0) return;
-    
-    switch (inversion) {
-        case ChordInversion::ROOT:
-            // No change
-            break;
-            
-        case ChordInversion::FIRST: {
-            // Move root up one octave
-            uint8_t root = notes[0];
-            for (int i = 0; i < note_count - 1; i++) {
-                notes[i] = notes[i + 1];
-            }
-            notes[note_count - 1] = root + 12;  // Root up one octave
-            break;
-        }
-        
-        case ChordInversion::SECOND: {
-            // Move root and 3rd up one octave
-            if (note_count >= 3) {
-                uint8_t root = notes[0];
-                uint8_t third = notes[1];
-                
-                // Shift remaining notes down
-                notes[0] = notes[2];
-                if (note_count > 3) {
-                    for (int i = 1; i < note_count - 2; i++) {
-                        notes[i] = notes[i + 2];
-                    }
-                }
-                
-                // Add inverted notes
-                notes[note_count - 2] = root + 12;
-                notes[note_count - 1] = third + 12;
-            }
-            break;
-        }
-    }
+    FillChord(chord, root_midi_note & 0x7F, QualityIndex(quality), InversionIndex(inversion));
 }
 
 void ChordEngine::GetChordName(Chord* chord) {
     if (!chord) return;
     
-    // Get note name without octave for cleaner display
-    const char* note_names[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
-    int note = chord->root_note % 12;
-    const char* note_name = note_names[note];
-    
-    const char* quality_str = "";
-    switch (chord->quality) {
-        case ChordQuality::MAJOR: quality_str = ""; break;
-        case ChordQuality::MINOR: quality_str = "m"; break;
-        case ChordQuality::DIMINISHED: quality_str = "dim"; break;
-        case ChordQuality::AUGMENTED: quality_str = "aug"; break;
-        case ChordQuality::MAJOR_7: quality_str = "maj7"; break;
-        case ChordQuality::MINOR_7: quality_str = "m7"; break;
-        case ChordQuality::DOMINANT_7: quality_str = "7"; break;
-        case ChordQuality::MAJOR_9: quality_str = "maj9"; break;
-        case ChordQuality::MINOR_9: quality_str = "m9"; break;
-        case ChordQuality::SUS4: quality_str = "sus4"; break;
-        case ChordQuality::SUS2: quality_str = "sus2"; break;
-    }
-    
-    const char* inversion_str = "";
-    switch (chord->inversion) {
-        case ChordInversion::ROOT: inversion_str = ""; break;
-        case ChordInversion::FIRST: inversion_str = " 1st Inv"; break;
-        case ChordInversion::SECOND: inversion_str = " 2nd Inv"; break;
-    }
-    
-    snprintf(chord->name, sizeof(chord->name), "%s%s%s", note_name, quality_str, inversion_str);
+    chord->name = chord_names.names[chord->root_note % 12][QualityIndex(chord->quality)][InversionIndex(chord->inversion)];
 }
 
 void ChordEngine::GetNoteName(uint8_t midi_note, char* buffer, size_t buffer_size) {
@@ -42,7 +42,7 @@ struct Chord {
     uint8_t note_count;         // Number of notes in chord (3-5)
     
     // For UI display
-    char name[32];              // Human-readable name (e.g., "Cmaj7 1st Inv")
+    const char* name;           // Human-readable name (e.g., "Cmaj7 1st Inv"), interned
 };
 
 /**
@@ -97,13 +97,48 @@ struct JoystickPreset {
 /**
  * Chord Engine - Chord theory and generation
  * 
- * Provides chord definitions, note generation, and preset management
+ * Provides chord definitions, note generation, and preset management.
+ * Chord shapes (intervals with each inversion applied) and chord names are
+ * constexpr tables built at compile time, so generating a chord is a table
+ * read and never formats a string. On top of that, SetKey() fills a table of
+ * every chord the buttons can play in the current key (scale degree x
+ * quality x inversion), so GetKeyChord() is a single indexed load; the track
+ * calls it through IInputPlugin::OnKeyChanged when the key changes.
  */
 class ChordEngine {
 public:
+    static constexpr int SCALE_DEGREE_COUNT = 7;
+    static constexpr int QUALITY_COUNT = 11;        // ChordQuality values
+    static constexpr int INVERSION_COUNT = 3;       // ChordInversion values
+    static constexpr int OCTAVE_PLACEMENTS = 3;     // Voicings: an octave down, as built, an octave up
+    
     ChordEngine();
     ~ChordEngine();
     
+    /**
+     * Rebuild the chord table for a key (main loop, on key change)
+     */
+    void SetKey(MusicalKey key);
+    MusicalKey GetKey() const { return key_; }
+    
+    /**
+     * Chord for a scale degree (0-6) in the current key, with the joystick
+     * direction (JoystickDirection as int, 0 = center = diatonic quality)
+     * of a preset applied. Returns a reference into the key table.
+     */
+    const Chord& GetKeyChord(int scale_degree, int direction, int preset_index,
+                             ChordInversion inversion = ChordInversion::ROOT) const;
+    
+    /**
+     * Voice leading: of the key chord's inversions (from the key table), each
+     * placed an octave down, as built or an octave up, the voicing that moves
+     * least from `previous` - total semitones, each note to the nearest note
+     * of the other chord, so common tones cost nothing. Ties keep the voicing
+     * nearest the key's register. Root position if `previous` is empty.
+     */
+    void GetVoiceLedChord(int scale_degree, int direction, int preset_index,
+                          const Chord& previous, Chord* chord) const;
+    
     /**
      * Generate chord notes from root and quality
      * Returns the number of notes generated
@@ -112,7 +147,7 @@ public:
     
     /**
      * Get human-readable chord name
-     * Populates chord->name with string like "Cmaj7 1st Inv"
+     * Points chord->name at an interned string like "Cmaj7 1st Inv"
      */
     void GetChordName(Chord* chord);
     
@@ -122,13 +157,13 @@ public:
      * Left-to-right physical order: 0, 4, 1, 5, 2, 6, 3 → maps to scale degrees I, II, III, IV, V, VI, VII
      * Returns the MIDI root note for that scale degree
      */
-    void GetButtonMapping(MusicalKey key, int button_index, uint8_t* root_midi_note) const;
+    static void GetButtonMapping(MusicalKey key, int button_index, uint8_t* root_midi_note);
     
     /**
      * Convert physical button index to scale degree index (0-6)
      * Physical order: 0, 4, 1, 5, 2, 6, 3 → Scale degrees: 0, 1, 2, 3, 4, 5, 6
      */
-    int PhysicalButtonToScaleDegree(int physical_button_index) const;
+    static int PhysicalButtonToScaleDegree(int physical_button_index);
     
     /**
      * Get chord quality for a scale degree in a mode
@@ -139,7 +174,7 @@ public:
     /**
      * Get scale intervals for a mode (semitones from root)
      */
-    void GetScaleIntervals(MusicalMode mode, int* intervals, int* count) const;
+    static void GetScaleIntervals(MusicalMode mode, int* intervals, int* count);
     
     /**
      * Apply joystick direction variation to a chord
@@ -164,17 +199,12 @@ public:
     static void GetNoteName(uint8_t midi_note, char* buffer, size_t buffer_size);
     
 private:
-    /**
-     * Get interval in semitones for chord quality
-     * Returns array of intervals and count
-     */
-    void GetIntervalsForQuality(ChordQuality quality, int* intervals, int* count) const;
-    
-    /**
-     * Apply inversion to chord notes
-     */
-    void ApplyInversion(uint8_t* notes, uint8_t note_count, ChordInversion inversion);
+    // Every chord in the current key: [scale degree][quality][inversion]
+    MusicalKey key_;
+    Chord key_chords_[SCALE_DEGREE_COUNT][QUALITY_COUNT][INVERSION_COUNT];
+    ChordQuality key_qualities_[SCALE_DEGREE_COUNT];    // Diatonic quality per degree
     
+    int ResolveQualityIndex(int scale_degree, int direction, int preset_index) const;
 };
 
 } // namespace OpenChord
@@ -0,0 +1,80 @@
+#include "note_scheduler.h"
+
+namespace OpenChord {
+
+NoteScheduler::NoteScheduler()
+    : pending_count_(0)
+    , channel_(0)
+    , sounding_{0, 0, 0, 0}
+    , sounding_count_(0)
+{
+}
+
+NoteScheduler::~NoteScheduler() {
+}
+
+bool NoteScheduler::Schedule(uint32_t on_sample, uint32_t off_sample, uint8_t note, uint8_t velocity) {
+    // Note-offs can't be dropped once their note-on is queued
+    if (pending_count_ + 2 > CAPACITY) return false;
+    note &= 0x7F;
+    Insert({on_sample, MidiEvent::NOTE_ON, note, velocity});
+    Insert({off_sample, MidiEvent::NOTE_OFF, note, 0});
+    return true;
+}
+
+void NoteScheduler::Insert(const Scheduled& event) {
+    // Latest first; on a tie the event scheduled first stays due first (a
+    // full gate's note-off goes out before the next hit's note-on)
+    size_t i = pending_count_;
+    while (i > 0 && static_cast<int32_t>(pending_[i - 1].sample - event.sample) <= 0) {
+        pending_[i] = pending_[i - 1];
+        i--;
+    }
+    pending_[i] = event;
+    pending_count_++;
+}
+
+void NoteScheduler::EmitDue(uint32_t block_start_sample, uint32_t block_end_sample,
+                            MidiEvent* events, size_t* count, size_t max_events) {
+    size_t sounding = sounding_count_.load(std::memory_order_relaxed);
+    while (pending_count_ > 0 && *count < max_events) {
+        const Scheduled& next = pending_[pending_count_ - 1];
+        if (static_cast<int32_t>(next.sample - block_end_sample) >= 0) break;
+
+        // Late only if the event buffer was full last block
+        uint32_t sample = static_cast<int32_t>(next.sample - block_start_sample) < 0 ? block_start_sample : next.sample;
+        events[(*count)++] = MidiEvent(next.type, channel_, next.note, next.velocity,
+                                       MidiEvent::SOURCE_GENERATED, sample);
+
+        const uint32_t bit = 1u << (next.note & 31);
+        uint32_t& word = sounding_[next.note >> 5];
+        if (next.type == MidiEvent::NOTE_ON) {
+            if (!(word & bit)) sounding++;
+            word |= bit;
+        } else if (word & bit) {
+            word &= ~bit;
+            sounding--;
+        }
+        pending_count_--;
+    }
+    sounding_count_.store(sounding, std::memory_order_relaxed);
+}
+
+void NoteScheduler::Release(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events) {
+    pending_count_ = 0;
+    size_t sounding = sounding_count_.load(std::memory_order_relaxed);
+    if (sounding == 0) return;
+
+    for (uint8_t word = 0; word < 4; word++) {
+        while (sounding_[word] && *count < max_events) {
+            uint8_t note = static_cast<uint8_t>(word * 32 + __builtin_ctz(sounding_[word]));
+            sounding_[word] &= sounding_[word] - 1;
+            events[(*count)++] = MidiEvent(MidiEvent::NOTE_OFF, channel_, note, 0,
+                                           MidiEvent::SOURCE_GENERATED, block_start_sample);
+            sounding--;
+        }
+    }
+    sounding_count_.store(sounding, std::memory_order_relaxed);
+}
+
+} // namespace OpenChord
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../midi/midi_types.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * NoteScheduler - Notes placed ahead of time for generators on the audio timeline
+ *
+ * A generator (sequencer, arpeggiator) schedules a note-on/note-off pair on
+ * absolute sample times when it triggers a note; EmitDue() hands each event
+ * out in the block it falls in. A note-on is only queued with room for its
+ * note-off, and what is sounding is tracked so Release() can always end it.
+ * Fixed size, for the audio callback.
+ */
+class NoteScheduler {
+public:
+    static constexpr size_t CAPACITY = 32;    // Scheduled events not yet due
+
+    NoteScheduler();
+    ~NoteScheduler();
+
+    // False (and nothing queued) if the pair doesn't fit
+    bool Schedule(uint32_t on_sample, uint32_t off_sample, uint8_t note, uint8_t velocity);
+
+    // Appends the events due before block_end_sample (late ones at the block start)
+    void EmitDue(uint32_t block_start_sample, uint32_t block_end_sample,
+                 MidiEvent* events, size_t* count, size_t max_events);
+
+    // Drops what is scheduled and ends what is sounding, at the block start
+    void Release(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events);
+
+    void SetChannel(uint8_t channel) { channel_ = channel & 0x0F; }  // Only while nothing sounds
+    uint8_t GetChannel() const { return channel_; }
+    size_t GetPendingCount() const { return pending_count_; }
+    bool HasSoundingNotes() const { return sounding_count_.load(std::memory_order_relaxed) > 0; }
+
+private:
+    struct Scheduled {
+        uint32_t sample;
+        uint8_t type;
+        uint8_t note;
+        uint8_t velocity;
+    };
+
+    // Sorted latest first, so the next event due is popped from the end
+    Scheduled pending_[CAPACITY];
+    size_t pending_count_;
+    uint8_t channel_;
+    uint32_t sounding_[4];                  // Notes on, one bit each
+    std::atomic<size_t> sounding_count_;    // Read from the main loop
+
+    void Insert(const Scheduled& event);
+};
+
+} // namespace OpenChord
@@ -0,0 +1,88 @@
+#include "scale_map.h"
+
+namespace OpenChord {
+
+ScaleMap::ScaleMap()
+    : active_(0)
+{
+    SetKey(MusicalKey(0, MusicalMode::IONIAN));
+}
+
+ScaleMap::~ScaleMap() {
+}
+
+void ScaleMap::SetKey(MusicalKey key) {
+    int intervals[7];
+    int count = 0;
+    ChordEngine::GetScaleIntervals(key.mode, intervals, &count);
+    const int root = key.root_note % 12;
+
+    // Build into the table the audio callback isn't reading
+    const uint8_t next = active_.load(std::memory_order_relaxed) ^ 1u;
+    Table& table = tables_[next];
+
+    table.pitch_classes = 0;
+    for (int i = 0; i < count; i++) {
+        table.pitch_classes |= static_cast<uint16_t>(1u << ((root + intervals[i]) % 12));
+        int note = 60 + root + intervals[i];
+        table.degree_notes[i] = static_cast<uint8_t>(note > 127 ? 127 : note);
+    }
+
+    // Nearest scale note at or below; the notes below the lowest scale note go up to it
+    int below = -1;
+    for (int note = 0; note < 128; note++) {
+        if ((table.pitch_classes >> (note % 12)) & 1u) below = note;
+        table.quantize[note] = static_cast<uint8_t>(below);
+    }
+    for (int note = 0; note < 128 && !((table.pitch_classes >> (note % 12)) & 1u); note++) {
+        int up = note;
+        while (!((table.pitch_classes >> (up % 12)) & 1u)) up++;
+        table.quantize[note] = static_cast<uint8_t>(up);
+    }
+
+    active_.store(next, std::memory_order_release);
+}
+
+uint8_t ScaleMap::GetDegreeNote(int scale_degree) const {
+    if (scale_degree < 0 || scale_degree >= 7) scale_degree = 0;
+    return Active().degree_notes[scale_degree];
+}
+
+ScaleLock::ScaleLock() {
+    for (int i = 0; i < 128; i++) {
+        sent_[i] = NOT_HELD;
+        holders_[i] = 0;
+    }
+}
+
+void ScaleLock::Process(const ScaleMap& map, bool enabled, MidiEvent* events, size_t* count) {
+    size_t kept = 0;
+    for (size_t i = 0; i < *count; i++) {
+        MidiEvent event = events[i];
+        const uint8_t in = event.data1 & 0x7F;
+        const bool note_on = event.type == MidiEvent::NOTE_ON && event.data2 > 0;
+        const bool note_off = event.type == MidiEvent::NOTE_OFF ||
+                              (event.type == MidiEvent::NOTE_ON && event.data2 == 0);
+
+        if (note_on) {
+            // Unlocked notes are counted too: they can share a note with locked ones
+            if (sent_[in] != NOT_HELD && holders_[sent_[in]] > 0) {
+                holders_[sent_[in]]--;      // Retriggered without a note-off
+            }
+            const uint8_t out = enabled ? map.Quantize(in) : in;
+            sent_[in] = out;
+            holders_[out]++;
+            event.data1 = out;
+        } else if (note_off && sent_[in] != NOT_HELD) {
+            const uint8_t out = sent_[in];
+            sent_[in] = NOT_HELD;
+            if (holders_[out] > 0) holders_[out]--;
+            if (holders_[out] > 0) continue;    // Another held input still sounds it
+            event.data1 = out;
+        }
+        events[kept++] = event;
+    }
+    *count = kept;
+}
+
+} // namespace OpenChord
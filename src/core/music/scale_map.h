@@ -0,0 +1,79 @@
+#pragma once
+
+#include "chord_engine.h"
+#include "../midi/midi_types.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * ScaleMap - Per-track note lookup for the current key
+ *
+ * One 128-entry table maps any MIDI note to the nearest note in the key's
+ * scale (an out-of-scale note goes down to the scale note below; the bottom
+ * of the range goes up), and a 7-entry table gives the button root of each
+ * scale degree (C4 + key root + scale interval, the same notes ChordEngine
+ * builds chords on). Both are rebuilt by Track::SetKey, so an input plugin
+ * gets an in-scale note with one table read instead of working through the
+ * scale intervals on every note.
+ *
+ * SetKey runs in the main loop while the audio callback may be reading:
+ * the tables are double-buffered and the new one is published with one
+ * atomic store.
+ */
+class ScaleMap {
+public:
+    ScaleMap();
+    ~ScaleMap();
+
+    // Main loop: rebuild for a key
+    void SetKey(MusicalKey key);
+
+    uint8_t Quantize(uint8_t note) const {
+        return Active().quantize[note & 0x7F];
+    }
+    bool InScale(uint8_t note) const {
+        return (Active().pitch_classes >> ((note & 0x7F) % 12)) & 1u;
+    }
+    uint8_t GetDegreeNote(int scale_degree) const;   // 0-6 (I-VII)
+
+private:
+    struct Table {
+        uint8_t quantize[128];
+        uint8_t degree_notes[7];
+        uint16_t pitch_classes;     // Bit per pitch class in the scale
+    };
+
+    Table tables_[2];
+    std::atomic<uint8_t> active_;
+
+    const Table& Active() const { return tables_[active_.load(std::memory_order_acquire)]; }
+};
+
+/**
+ * ScaleLock - Applies a ScaleMap to a stream of note events
+ *
+ * Remembers the note each held input note was sent as, so its note-off
+ * releases the same note even if the key or the lock changed while it was
+ * held. When two held inputs land on the same scale note, the note-off of
+ * the first is dropped and the note sounds until both are released.
+ */
+class ScaleLock {
+public:
+    ScaleLock();
+
+    // Rewrites note numbers in place (note-ons only while enabled; note-offs
+    // to match their note-on) and drops note-offs for a note another held
+    // input still sounds
+    void Process(const ScaleMap& map, bool enabled, MidiEvent* events, size_t* count);
+
+private:
+    static constexpr uint8_t NOT_HELD = 0xFF;
+
+    uint8_t sent_[128];         // Output note of each held input note
+    uint8_t holders_[128];      // Held inputs sounding each output note
+};
+
+} // namespace OpenChord
@@ -0,0 +1,127 @@
+#include "step_sequencer.h"
+
+namespace OpenChord {
+
+namespace {
+// Default pattern: a sixteenth-note figure in C minor
+constexpr size_t DEFAULT_LENGTH = 16;
+constexpr uint8_t DEFAULT_NOTES[DEFAULT_LENGTH] = {
+    48, 48, 55, 48, 51, 48, 58, 48, 48, 60, 55, 48, 51, 53, 55, 58
+};
+} // namespace
+
+StepSequencer::StepSequencer()
+    : length_(DEFAULT_LENGTH)
+    , ticks_per_step_(6)
+    , current_step_(0)
+    , dropped_count_(0)
+    , random_(0x12345678u)
+{
+    for (size_t i = 0; i < MAX_STEPS; i++) {
+        pattern_.note[i] = DEFAULT_NOTES[i % DEFAULT_LENGTH];
+        pattern_.velocity[i] = (i % 4 == 0) ? 110 : 80;
+        pattern_.gate[i] = 50;
+        pattern_.probability[i] = (i % 8 == 7) ? 50 : 100;
+        pattern_.ratchet[i] = (i % 16 == 15) ? 2 : 1;
+    }
+}
+
+StepSequencer::~StepSequencer() {
+}
+
+void StepSequencer::SetStep(size_t index, uint8_t note, uint8_t velocity, uint8_t gate,
+                            uint8_t probability, uint8_t ratchet) {
+    if (index >= MAX_STEPS) return;
+    pattern_.note[index] = note & 0x7F;
+    pattern_.velocity[index] = velocity & 0x7F;
+    pattern_.gate[index] = Clamp(gate, 1, 100);
+    pattern_.probability[index] = Clamp(probability, 0, 100);
+    pattern_.ratchet[index] = Clamp(ratchet, 1, MAX_RATCHET);
+}
+
+void StepSequencer::SetPattern(const Pattern& pattern) {
+    for (size_t i = 0; i < MAX_STEPS; i++) {
+        SetStep(i, pattern.note[i], pattern.velocity[i], pattern.gate[i],
+                pattern.probability[i], pattern.ratchet[i]);
+    }
+}
+
+void StepSequencer::SetLength(size_t steps) {
+    if (steps < 1) steps = 1;
+    if (steps > MAX_STEPS) steps = MAX_STEPS;
+    length_.store(steps, std::memory_order_relaxed);
+}
+
+void StepSequencer::SetTicksPerStep(uint32_t ticks) {
+    if (ticks < 1) ticks = 1;
+    if (ticks > TransportClock::PPQN * 4) ticks = TransportClock::PPQN * 4;
+    ticks_per_step_.store(ticks, std::memory_order_relaxed);
+}
+
+void StepSequencer::ProcessBlock(const SongPosition& position, uint32_t block_start_sample, size_t block_size,
+                                 MidiEvent* events, size_t* count, size_t max_events) {
+    const uint32_t interval_q16 = position.tick_interval_q16;
+    if (!position.playing || interval_q16 == 0) {
+        Release(block_start_sample, events, count, max_events);
+        return;
+    }
+
+    const uint32_t ticks_per_step = ticks_per_step_.load(std::memory_order_relaxed);
+    const size_t length = length_.load(std::memory_order_relaxed);
+    const uint64_t block_q16 = static_cast<uint64_t>(block_size) << 16;
+    const uint64_t step_length_q16 = static_cast<uint64_t>(ticks_per_step) * interval_q16;
+
+    // Jump straight to the first step boundary in the block: steps that don't
+    // start here are never looked at. Same arithmetic as the transport places
+    // its clocks with, so steps land on their clock's sample.
+    uint32_t tick = position.block_tick;
+    const uint32_t to_step = (ticks_per_step - tick % ticks_per_step) % ticks_per_step;
+    tick += to_step;
+    uint64_t offset_q16 = position.block_tick_offset_q16 + static_cast<uint64_t>(to_step) * interval_q16;
+
+    while (offset_q16 < block_q16) {
+        const size_t step = (tick / ticks_per_step) % length;
+        current_step_.store(step, std::memory_order_relaxed);
+        TriggerStep(step, block_start_sample + static_cast<uint32_t>(offset_q16 >> 16), step_length_q16);
+        tick += ticks_per_step;
+        offset_q16 += step_length_q16;
+    }
+
+    scheduler_.EmitDue(block_start_sample, block_start_sample + static_cast<uint32_t>(block_size),
+                       events, count, max_events);
+}
+
+void StepSequencer::Release(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events) {
+    scheduler_.Release(block_start_sample, events, count, max_events);
+}
+
+void StepSequencer::TriggerStep(size_t step, uint32_t sample, uint64_t step_length_q16) {
+    const uint8_t velocity = pattern_.velocity[step];
+    if (velocity == 0) return;
+
+    const uint8_t probability = pattern_.probability[step];
+    if (probability < 100 && random_.Next() % 100 >= probability) return;
+
+    const uint8_t note = pattern_.note[step];
+    const uint8_t ratchet = Clamp(pattern_.ratchet[step], 1, MAX_RATCHET);
+    const uint8_t gate = Clamp(pattern_.gate[step], 1, 100);
+    const uint64_t hit_q16 = step_length_q16 / ratchet;
+    uint32_t gate_samples = static_cast<uint32_t>((hit_q16 * gate / 100) >> 16);
+    if (gate_samples == 0) gate_samples = 1;
+
+    for (uint8_t hit = 0; hit < ratchet; hit++) {
+        const uint32_t on = sample + static_cast<uint32_t>((hit_q16 * hit) >> 16);
+        if (!scheduler_.Schedule(on, on + gate_samples, note, velocity)) {
+            dropped_count_.store(dropped_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+uint8_t StepSequencer::Clamp(uint8_t value, uint8_t low, uint8_t high) {
+    if (value < low) return low;
+    if (value > high) return high;
+    return value;
+}
+
+} // namespace OpenChord
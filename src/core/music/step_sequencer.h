@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../midi/midi_types.h"
+#include "../audio/transport_clock.h"
+#include "note_scheduler.h"
+#include "xorshift.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * StepSequencer - Note pattern played from the internal transport's clocks
+ *
+ * Each audio block, the steps that start inside it are found from the
+ * transport's clock grid (SongPosition), so a step lands on the exact sample
+ * of its clock whatever the block size, and the block only looks at the
+ * clocks it holds: the cost is O(events in the block), not O(steps).
+ *
+ * Pattern data is one small array per step field. Ratchets and gates are
+ * placed in samples from the step's length and wait in a NoteScheduler
+ * until their block comes. The pattern and settings are written from the
+ * main loop; a step edited while it plays is heard from its next pass.
+ */
+class StepSequencer {
+public:
+    static constexpr size_t MAX_STEPS = 64;
+    static constexpr uint8_t MAX_RATCHET = 4;
+
+    // One byte per step and field (SaveState copies it as is)
+    struct Pattern {
+        uint8_t note[MAX_STEPS];
+        uint8_t velocity[MAX_STEPS];      // 0 = rest
+        uint8_t gate[MAX_STEPS];          // Percent of the step (per ratchet hit), 1-100
+        uint8_t probability[MAX_STEPS];   // Percent, 100 = always
+        uint8_t ratchet[MAX_STEPS];       // Hits per step, 1-MAX_RATCHET
+    };
+
+    StepSequencer();
+    ~StepSequencer();
+
+    // Main loop side
+    void SetStep(size_t index, uint8_t note, uint8_t velocity, uint8_t gate,
+                 uint8_t probability, uint8_t ratchet);
+    void SetLength(size_t steps);
+    size_t GetLength() const { return length_.load(std::memory_order_relaxed); }
+    void SetTicksPerStep(uint32_t ticks);          // 24 PPQN clocks: 6 = sixteenths
+    uint32_t GetTicksPerStep() const { return ticks_per_step_.load(std::memory_order_relaxed); }
+    const Pattern& GetPattern() const { return pattern_; }
+    void SetPattern(const Pattern& pattern);
+    size_t GetCurrentStep() const { return current_step_.load(std::memory_order_relaxed); }
+    uint32_t GetDroppedCount() const { return dropped_count_.load(std::memory_order_relaxed); }
+
+    // Audio callback: appends the block's note events, timestamped on their
+    // sample. Stops (and releases what it holds) while the transport doesn't play.
+    void ProcessBlock(const SongPosition& position, uint32_t block_start_sample, size_t block_size,
+                      MidiEvent* events, size_t* count, size_t max_events);
+
+    // Audio callback: note-offs for everything sounding, at the block start
+    void Release(uint32_t block_start_sample, MidiEvent* events, size_t* count, size_t max_events);
+
+    bool HasSoundingNotes() const { return scheduler_.HasSoundingNotes(); }
+
+private:
+    Pattern pattern_;
+    std::atomic<size_t> length_;
+    std::atomic<uint32_t> ticks_per_step_;
+    std::atomic<size_t> current_step_;
+    std::atomic<uint32_t> dropped_count_;
+
+    // Audio callback state
+    NoteScheduler scheduler_;
+    Xorshift32 random_;
+
+    void TriggerStep(size_t step, uint32_t sample, uint64_t step_length_q16);
+    static uint8_t Clamp(uint8_t value, uint8_t low, uint8_t high);
+};
+
+} // namespace OpenChord
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace OpenChord {
+
+/**
+ * Xorshift32 - Small pseudo-random generator for the audio callback
+ *
+ * Three shifts and xors a number, no tables or allocation. Good enough for
+ * musical choices (random arpeggio notes, step probability), not for
+ * anything statistical. The seed must not be 0.
+ */
+class Xorshift32 {
+public:
+    explicit Xorshift32(uint32_t seed) : state_(seed) {}
+
+    uint32_t Next() {
+        uint32_t x = state_;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state_ = x;
+        return x;
+    }
+
+private:
+    uint32_t state_;
+};
+
+} // namespace OpenChord
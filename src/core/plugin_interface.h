@@ -6,6 +6,8 @@
 
 namespace OpenChord {
 
+struct MusicalKey;
+
 /**
  * Base interface for all plugins in the OpenChord system
  */
@@ -49,6 +51,22 @@ public:
     virtual void GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) = 0;
     virtual void ProcessMIDI(const MidiEvent* events, size_t count) = 0;
     
+    // Stack stages (e.g. the looper) see what the rest of the stack generated
+    // for the block, in stack order, and may record, add to or rewrite it
+    virtual void ProcessStackOutput(MidiEvent* events, size_t* count, size_t max_events) {
+        (void)events;
+        (void)count;
+        (void)max_events;
+    }
+    
+    // The track's key changed (main loop); plugins with key-dependent tables rebuild them
+    virtual void OnKeyChanged(const MusicalKey& key) {
+        (void)key;
+    }
+    
+    // Pitched note sources return true: the track's scale lock applies to what they generate
+    virtual bool FollowsScaleLock() const { return false; }
+    
     // Input stack specific
     virtual bool IsActive() const = 0;
     virtual void SetActive(bool active) = 0;
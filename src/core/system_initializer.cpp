@@ -21,6 +21,9 @@
 #include "../plugins/input/piano_input.h"
 #include "../plugins/input/drum_pad_input.h"
 #include "../plugins/input/basic_midi_input.h"
+#include "../plugins/input/arpeggiator_input.h"
+#include "../plugins/input/step_sequencer_input.h"
+#include "../plugins/input/loop_recorder_input.h"
 #include "../plugins/instruments/subtractive_synth.h"
 #include "../plugins/fx/delay_fx.h"
 #include "../plugins/fx/chorus_fx.h"
@@ -84,16 +87,22 @@ bool SystemInitializer::Initialize(const InitParams& params) {
     
     // 9) Initialize MIDI
     InitMIDI(params.midi_handler, params.hw);
+    params.midi_handler->SetSampleClock(params.audio_engine->GetSampleClock());
+    params.midi_handler->SetIdleMonitor(params.power_mgr->GetIdleMonitor());
+    params.audio_engine->GetTransportClock()->SetOutput(OpenChordMidiHandler::RealtimeOutputCallback,
+                                                        params.midi_handler);
     
     // 10) Initialize transport control
     InitTransportControl(params.transport_control, params.midi_handler, params.global_settings);
+    params.transport_control->SetTransportClock(params.audio_engine->GetTransportClock());
     
     // 11) Initialize system (multi-track manager)
     InitSystem(params.system, params.volume_mgr, params.octave_shift, params.hw);
     
     // 12) Setup default track with plugins
     SetupDefaultTrack(params.system, params.input_manager, params.octave_shift, params.hw,
-                     params.chord_plugin_ptr, params.piano_plugin_ptr);
+                     params.chord_plugin_ptr, params.piano_plugin_ptr, params.transport_control,
+                     params.io_manager ? params.io_manager->GetStorage() : nullptr);
     
     // 13) Add all FX plugins to track 1 only (all bypassed/off by default)
     // Do this after SetupDefaultTrack to ensure audio is fully initialized
@@ -106,6 +115,8 @@ bool SystemInitializer::Initialize(const InitParams& params) {
     
     // 13) Wire audio engine to system
     params.audio_engine->SetSystem(params.system);
+    params.system->SetTransportClock(params.audio_engine->GetTransportClock());
+    params.system->SetSampleClock(params.audio_engine->GetSampleClock());
     
     ExternalLog::PrintLine("System initialized with tracks, plugins, instrument, and FX");
     
@@ -201,6 +212,9 @@ void SystemInitializer::InitIOManagers(IOManager* io_manager, daisy::DaisySeed*
     io_manager->GetSerial()->Init(hw);
     io_manager->GetStorage()->Init(hw);  // SD card init happens here (after delay)
     io_manager->SetPowerManager(power_mgr);
+    if (power_mgr) {
+        io_manager->GetDigital()->SetIdleMonitor(power_mgr->GetIdleMonitor());
+    }
 }
 
 void SystemInitializer::InitInputSystem(InputManager* input_manager, IOManager* io_manager) {
@@ -248,7 +262,7 @@ void SystemInitializer::InitSystem(OpenChordSystem* system, VolumeManager* volum
     
     system->Init();
     system->SetSampleRate(hw->AudioSampleRate());
-    system->SetBufferSize(4);  // Match audio block size
+    system->SetBufferSize(hw->AudioBlockSize());  // Match audio block size
     system->SetVolumeManager(volume_mgr);
     system->SetOctaveShift(octave_shift);
     system->SetActiveTrack(0);  // Start with track 1
@@ -259,7 +273,9 @@ void SystemInitializer::InitSystem(OpenChordSystem* system, VolumeManager* volum
 void SystemInitializer::SetupDefaultTrack(OpenChordSystem* system, InputManager* input_manager,
                                          OctaveShift* octave_shift, daisy::DaisySeed* hw,
                                          ChordMappingInput** chord_plugin_ptr,
-                                         PianoInput** piano_plugin_ptr) {
+                                         PianoInput** piano_plugin_ptr,
+                                         TransportControl* transport_control,
+                                         StorageManager* storage) {
     if (!system || !input_manager || !hw) return;
     
     // Get first track for setup
@@ -308,6 +324,30 @@ void SystemInitializer::SetupDefaultTrack(OpenChordSystem* system, InputManager*
     basic_midi_plugin->SetActive(true);  // Active by default to receive external MIDI
     track1->AddInputPlugin(std::move(basic_midi_plugin));
     
+    // Add arpeggiator stage (off by default) - after the inputs it arpeggiates
+    auto arp_plugin = std::make_unique<ArpeggiatorInput>();
+    arp_plugin->SetTrack(track1);
+    arp_plugin->SetSampleRate(hw->AudioSampleRate());
+    arp_plugin->Init();
+    track1->AddInputPlugin(std::move(arp_plugin));
+    
+    // Add step sequencer (off by default) - before the looper so it can be recorded
+    auto sequencer_plugin = std::make_unique<StepSequencerInput>();
+    sequencer_plugin->SetTrack(track1);
+    sequencer_plugin->Init();
+    track1->AddInputPlugin(std::move(sequencer_plugin));
+    
+    // Add the looper last - it records and plays over the rest of the stack
+    auto looper_plugin = std::make_unique<LoopRecorderInput>();
+    looper_plugin->SetTrack(track1);
+    looper_plugin->SetSampleRate(hw->AudioSampleRate());
+    looper_plugin->SetStorage(storage);  // Load / Save from its settings
+    looper_plugin->Init();
+    if (transport_control) {
+        transport_control->SetLooper(looper_plugin.get());
+    }
+    track1->AddInputPlugin(std::move(looper_plugin));
+    
     // Add subtractive synth instrument
     auto synth = std::make_unique<SubtractiveSynth>();
     synth->SetSampleRate(hw->AudioSampleRate());
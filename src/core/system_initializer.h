@@ -3,8 +3,9 @@
 #include "daisy_seed.h"
 #include <cstdint>
 
-// IOManager is at global scope
+// IOManager and StorageManager are at global scope
 class IOManager;
+class StorageManager;
 
 namespace OpenChord {
 
@@ -101,7 +102,9 @@ private:
     void SetupDefaultTrack(OpenChordSystem* system, InputManager* input_manager,
                           OctaveShift* octave_shift, daisy::DaisySeed* hw,
                           ChordMappingInput** chord_plugin_ptr,
-                          PianoInput** piano_plugin_ptr);
+                          PianoInput** piano_plugin_ptr,
+                          TransportControl* transport_control,
+                          StorageManager* storage);
     void AddAllFXPluginsToTrack(Track* track, daisy::DaisySeed* hw);
     void InitUI(UIManager* ui_manager, MainUI* main_ui, OpenChordSystem* system,
                InputManager* input_manager, IOManager* io_manager,
@@ -9,6 +9,8 @@ namespace OpenChord {
 OpenChordSystem::OpenChordSystem()
     : volume_manager_(nullptr)
     , octave_shift_(nullptr)
+    , transport_clock_(nullptr)
+    , audio_sample_clock_(nullptr)
     , active_track_(0)
     , tempo_(120.0f)
     , time_signature_numerator_(4)
@@ -58,8 +60,9 @@ void OpenChordSystem::Init() {
 }
 
 void OpenChordSystem::Process(const float* const* in, float* const* out, size_t size) {
+    UpdateTransport();
     ProcessTracks(in, out, size);
-    UpdateSampleClock();
+    UpdateSampleClock(size);
 }
 
 void OpenChordSystem::Update() {
@@ -203,8 +206,11 @@ void OpenChordSystem::SendMIDI(const MidiEvent* events, size_t count) {
 
 void OpenChordSystem::SetTempo(float bpm) {
     tempo_ = bpm;
-    if (tempo_ < 20.0f) tempo_ = 20.0f;
-    if (tempo_ > 300.0f) tempo_ = 300.0f;
+    if (tempo_ < TransportClock::MIN_TEMPO) tempo_ = TransportClock::MIN_TEMPO;
+    if (tempo_ > TransportClock::MAX_TEMPO) tempo_ = TransportClock::MAX_TEMPO;
+    if (transport_clock_) {
+        transport_clock_->SetTempo(tempo_);
+    }
 }
 
 float OpenChordSystem::GetTempo() const {
@@ -216,6 +222,9 @@ void OpenChordSystem::SetTimeSignature(int numerator, int denominator) {
     time_signature_denominator_ = denominator;
     if (time_signature_numerator_ < 1) time_signature_numerator_ = 1;
     if (time_signature_denominator_ < 1) time_signature_denominator_ = 1;
+    if (transport_clock_) {
+        transport_clock_->SetTimeSignature(time_signature_numerator_, time_signature_denominator_);
+    }
 }
 
 void OpenChordSystem::GetTimeSignature(int* numerator, int* denominator) const {
@@ -241,7 +250,7 @@ void OpenChordSystem::NewProject() {
         }
     }
     active_track_ = 0;
-    tempo_ = 120.0f;
+    SetTempo(120.0f);
 }
 
 void OpenChordSystem::SetSampleRate(float sample_rate) {
@@ -324,8 +333,35 @@ void OpenChordSystem::ProcessTracks(const float* const* in, float* const* out, s
     }
 }
 
-void OpenChordSystem::UpdateSampleClock() {
-    sample_clock_ += buffer_size_;
+void OpenChordSystem::UpdateTransport() {
+    // Position of the block about to be rendered (clocks were placed before it)
+    SongPosition position;
+    float bpm = tempo_;
+    if (transport_clock_) {
+        position = transport_clock_->GetPosition();
+        bpm = transport_clock_->GetTempo();
+    }
+    
+    // Same timeline as MIDI event timestamps when the audio engine's clock is set
+    uint32_t block_start = audio_sample_clock_ ? audio_sample_clock_->GetBlockStartSample() : sample_clock_;
+    for (auto& track : tracks_) {
+        if (track) {
+            track->SetTransport(bpm, position, block_start);
+        }
+    }
+}
+
+void OpenChordSystem::UpdateSampleClock(size_t size) {
+    // Advance by the block actually processed, not the configured size
+    sample_clock_ += static_cast<uint32_t>(size);
+}
+
+void OpenChordSystem::SetTransportClock(TransportClock* transport_clock) {
+    transport_clock_ = transport_clock;
+    if (transport_clock_) {
+        transport_clock_->SetTempo(tempo_);
+        transport_clock_->SetTimeSignature(time_signature_numerator_, time_signature_denominator_);
+    }
 }
 
 void OpenChordSystem::SetOctaveShift(OctaveShift* octave_shift) {
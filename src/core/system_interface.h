@@ -48,6 +48,9 @@ public:
     IVolumeManager* GetVolumeManager() const { return volume_manager_; }
     void SetOctaveShift(OctaveShift* octave_shift);
     OctaveShift* GetOctaveShift() const { return octave_shift_; }
+    void SetTransportClock(TransportClock* transport_clock);
+    TransportClock* GetTransportClock() const { return transport_clock_; }
+    void SetSampleClock(const SampleClock* sample_clock) { audio_sample_clock_ = sample_clock; }
 
     // UI and control handling
     void UpdateUI();
@@ -80,6 +83,8 @@ private:
     // System references (set from main.cpp)
     IVolumeManager* volume_manager_;
     OctaveShift* octave_shift_;
+    TransportClock* transport_clock_;
+    const SampleClock* audio_sample_clock_;
     
     // Tracks
     std::vector<std::unique_ptr<Track>> tracks_;
@@ -101,7 +106,8 @@ private:
 
     // Internal methods
     void ProcessTracks(const float* const* in, float* const* out, size_t size);
-    void UpdateSampleClock();
+    void UpdateTransport();
+    void UpdateSampleClock(size_t size);
 };
 
 } // namespace OpenChord 
\ No newline at end of file
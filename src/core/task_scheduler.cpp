@@ -0,0 +1,154 @@
+#include "task_scheduler.h"
+#include <cstring>
+
+namespace OpenChord {
+
+TaskScheduler::TaskScheduler()
+    : clock_(nullptr)
+    , task_count_(0)
+{
+    std::memset(tasks_, 0, sizeof(tasks_));
+    std::memset(order_, 0, sizeof(order_));
+}
+
+TaskScheduler::~TaskScheduler() {
+}
+
+void TaskScheduler::Init(TaskClockFunc clock) {
+    clock_ = clock;
+    task_count_ = 0;
+}
+
+int TaskScheduler::AddTask(const char* name, TaskFunc func, uint32_t period_us, int priority) {
+    if (!clock_ || !func || period_us == 0 || task_count_ >= MAX_TASKS) {
+        return INVALID_TASK;
+    }
+
+    int id = task_count_;
+    Task& task = tasks_[id];
+    task.name = name;
+    task.func = func;
+    task.period_us = period_us;
+    task.priority = priority;
+    task.next_due_us = clock_();  // Due immediately
+    task.triggered = false;
+    std::memset(&task.stats, 0, sizeof(task.stats));
+
+    // Insert into priority order (stable for equal priorities)
+    int pos = task_count_;
+    while (pos > 0 && tasks_[order_[pos - 1]].priority > priority) {
+        order_[pos] = order_[pos - 1];
+        pos--;
+    }
+    order_[pos] = id;
+    task_count_++;
+
+    return id;
+}
+
+void TaskScheduler::SetTaskPeriod(int task_id, uint32_t period_us) {
+    if (task_id < 0 || task_id >= task_count_ || period_us == 0) return;
+
+    Task& task = tasks_[task_id];
+    if (task.period_us == period_us) return;
+
+    // Pull the next release in if the new period is shorter
+    if (clock_ && period_us < task.period_us) {
+        uint32_t now = clock_();
+        int32_t until_due = static_cast<int32_t>(task.next_due_us - now);
+        if (until_due > static_cast<int32_t>(period_us)) {
+            task.next_due_us = now + period_us;
+        }
+    }
+    task.period_us = period_us;
+}
+
+void TaskScheduler::TriggerTask(int task_id) {
+    if (task_id < 0 || task_id >= task_count_) return;
+    tasks_[task_id].triggered = true;
+}
+
+int TaskScheduler::RunPending() {
+    if (!clock_) return 0;
+
+    int run = 0;
+    for (int i = 0; i < task_count_; i++) {
+        Task& task = tasks_[order_[i]];
+        uint32_t now = clock_();
+
+        // Signed difference handles clock wrap
+        if (static_cast<int32_t>(now - task.next_due_us) >= 0) {
+            RunTask(task, now, true);
+            run++;
+        } else if (task.triggered) {
+            RunTask(task, now, false);
+            run++;
+        }
+    }
+    return run;
+}
+
+void TaskScheduler::RunTask(Task& task, uint32_t now_us, bool periodic) {
+    uint32_t lateness = periodic ? now_us - task.next_due_us : 0;
+    if (lateness > task.stats.worst_lateness_us) {
+        task.stats.worst_lateness_us = lateness;
+    }
+
+    // Cleared before running so the task can trigger itself again
+    task.triggered = false;
+    task.func();
+
+    uint32_t runtime = clock_() - now_us;
+    task.stats.last_runtime_us = runtime;
+    if (runtime > task.stats.worst_runtime_us) {
+        task.stats.worst_runtime_us = runtime;
+    }
+    task.stats.run_count++;
+
+    if (!periodic) {
+        // Triggered run - periodic releases stay where they were
+        return;
+    }
+
+    if (lateness >= task.period_us) {
+        // Missed at least one release - resync instead of bursting to catch up
+        task.stats.deadline_misses++;
+        task.next_due_us = now_us + task.period_us;
+    } else {
+        // Advance from the due time (not "now") so the rate doesn't drift
+        task.next_due_us += task.period_us;
+    }
+}
+
+uint32_t TaskScheduler::GetTimeUntilNextDue() const {
+    if (!clock_ || task_count_ == 0) return 0;
+
+    uint32_t now = clock_();
+    int32_t soonest = INT32_MAX;
+    for (int i = 0; i < task_count_; i++) {
+        if (tasks_[i].triggered) return 0;
+        int32_t until_due = static_cast<int32_t>(tasks_[i].next_due_us - now);
+        if (until_due < soonest) {
+            soonest = until_due;
+        }
+    }
+    return soonest > 0 ? static_cast<uint32_t>(soonest) : 0;
+}
+
+const TaskScheduler::Task* TaskScheduler::GetTask(int index) const {
+    if (index < 0 || index >= task_count_) return nullptr;
+    return &tasks_[order_[index]];
+}
+
+const TaskScheduler::Task* TaskScheduler::GetTaskById(int task_id) const {
+    if (task_id < 0 || task_id >= task_count_) return nullptr;
+    return &tasks_[task_id];
+}
+
+void TaskScheduler::ResetStats() {
+    for (int i = 0; i < task_count_; i++) {
+        std::memset(&tasks_[i].stats, 0, sizeof(tasks_[i].stats));
+    }
+}
+
+} // namespace OpenChord
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+
+namespace OpenChord {
+
+// Task entry point (tasks use globals, like the UI render callbacks)
+typedef void (*TaskFunc)();
+
+// Microsecond clock source (daisy::System::GetUs on hardware, simulated on host)
+typedef uint32_t (*TaskClockFunc)();
+
+/**
+ * Per-task timing statistics
+ */
+struct TaskStats {
+    uint32_t run_count;
+    uint32_t last_runtime_us;
+    uint32_t worst_runtime_us;
+    uint32_t worst_lateness_us;   // Largest start delay after the task was due (jitter)
+    uint32_t deadline_misses;     // Releases skipped because the task started a full period late
+};
+
+/**
+ * Task Scheduler - Cooperative rate-scheduled task runner
+ *
+ * Replaces the fixed-sequence main loop. Each subsystem registers a period
+ * and priority; RunPending() runs every due task in priority order
+ * (lower number = higher priority, same as input plugins) and records
+ * runtime, lateness and deadline misses. Nothing here blocks.
+ */
+class TaskScheduler {
+public:
+    static constexpr int MAX_TASKS = 8;
+    static constexpr int INVALID_TASK = -1;
+
+    struct Task {
+        const char* name;
+        TaskFunc func;
+        uint32_t period_us;
+        int priority;
+        uint32_t next_due_us;
+        bool triggered;             // Extra run requested by TriggerTask()
+        TaskStats stats;
+    };
+
+    TaskScheduler();
+    ~TaskScheduler();
+
+    // Initialization
+    void Init(TaskClockFunc clock);
+
+    // Register a task, returns task id (INVALID_TASK if full or invalid)
+    int AddTask(const char* name, TaskFunc func, uint32_t period_us, int priority);
+
+    // Change a task's period (e.g. ADC rate from PowerManager)
+    void SetTaskPeriod(int task_id, uint32_t period_us);
+
+    // Run a task on the next RunPending() pass as well as on its period
+    // (e.g. an interrupt queued work for it, or a task continuing sliced
+    // work). The periodic schedule is not shifted.
+    void TriggerTask(int task_id);
+
+    // Run all tasks that are due (call continuously from main loop)
+    // Returns number of tasks run
+    int RunPending();
+
+    // Time until the next task is due (0 if something is already due)
+    uint32_t GetTimeUntilNextDue() const;
+
+    // Task inspection (index is in priority order, for debug views)
+    int GetTaskCount() const { return task_count_; }
+    const Task* GetTask(int index) const;
+    const Task* GetTaskById(int task_id) const;
+
+    // Clear all statistics
+    void ResetStats();
+
+private:
+    TaskClockFunc clock_;
+
+    Task tasks_[MAX_TASKS];          // Indexed by task id
+    int order_[MAX_TASKS];           // Task ids sorted by priority
+    int task_count_;
+
+    void RunTask(Task& task, uint32_t now_us, bool periodic);
+};
+
+} // namespace OpenChord
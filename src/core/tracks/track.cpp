@@ -5,7 +5,7 @@
 
 namespace OpenChord {
 
-Track::Track() : focus_(Focus::INPUT), muted_(false), soloed_(false), instrument_enabled_(true), octave_shift_(nullptr) {
+Track::Track() : focus_(Focus::INPUT), muted_(false), soloed_(false), instrument_enabled_(true), scale_lock_(false), octave_shift_(nullptr) {
     std::strcpy(name_, "Track");
 }
 
@@ -22,6 +22,7 @@ void Track::Init() {
     // Initialize track context (key, BPM, etc.)
     context_.key = MusicalKey(0, MusicalMode::IONIAN);  // Default: C Major
     context_.bpm = 120.0f;  // Default BPM
+    scale_map_.SetKey(context_.key);
     
     // Clear MIDI buffer
     midi_buffer_.clear();
@@ -41,6 +42,7 @@ void Track::Process(const float* const* in, float* const* out, size_t size) {
     }
     
     // Generate MIDI from input stack (use member buffer to avoid stack allocation)
+    context_.block_size = size;
     size_t event_count = 0;
     GenerateMIDI(midi_event_buffer_, &event_count, 64);
     
@@ -113,6 +115,7 @@ void Track::Update() {
 
 void Track::AddInputPlugin(std::unique_ptr<IInputPlugin> plugin) {
     if (plugin) {
+        plugin->OnKeyChanged(context_.key);
         input_plugins_.push_back(std::move(plugin));
     }
 }
@@ -169,8 +172,9 @@ void Track::SetInputPluginActive(IInputPlugin* plugin, bool active) {
                 piano_plugin = other_plugin.get();
             }
             
-            // Check if any exclusive input plugin is active
-            if (other_plugin->IsExclusive() && other_plugin->IsActive()) {
+            // Check if any exclusive input plugin is active (the one just turned
+            // off may still report active while its note-offs go out)
+            if (other_plugin.get() != plugin && other_plugin->IsExclusive() && other_plugin->IsActive()) {
                 any_exclusive_active = true;
             }
         }
@@ -342,15 +346,17 @@ void Track::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) {
     }
     
     // If BasicMidiInput is active, check it first for external MIDI
+    bool external = false;
+    IInputPlugin* source = nullptr;
     if (basic_midi_plugin && basic_midi_plugin->IsActive()) {
         size_t plugin_count = 0;
         basic_midi_plugin->GenerateMIDI(events + *count, &plugin_count, max_events - *count);
         
         if (plugin_count > 0) {
             // External MIDI found - use it for instrument playback
-            // Don't add external MIDI to hub (we don't want to echo it back out)
             *count += plugin_count;
-            return;
+            external = true;
+            source = basic_midi_plugin;
         }
     }
     
@@ -358,6 +364,7 @@ void Track::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) {
     // Process plugins in order, but stop after first plugin generates MIDI
     // This ensures only one input mode (chord mapping OR chromatic) generates MIDI at a time
     for (auto& plugin : input_plugins_) {
+        if (external) break;
         if (plugin && plugin->IsActive()) {
             // Skip BasicMidiInput - already checked above
             const char* name = plugin->GetName();
@@ -369,34 +376,41 @@ void Track::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) {
             plugin->GenerateMIDI(events + *count, &plugin_count, max_events - *count);
             
             if (plugin_count > 0) {
-                // Add generated events to MIDI hub (for MIDI output routing)
-                // This allows RouteGeneratedMIDI to read the same events without consuming
-                for (size_t i = 0; i < plugin_count; i++) {
-                    const MidiEvent& event = events[*count + i];
-                    // Convert track event to hub event and add to hub
-                    daisy::MidiMessageType msg_type;
-                    if (event.type == static_cast<uint8_t>(MidiEvent::Type::NOTE_ON)) {
-                        msg_type = daisy::MidiMessageType::NoteOn;
-                    } else if (event.type == static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF)) {
-                        msg_type = daisy::MidiMessageType::NoteOff;
-                    } else if (event.type == static_cast<uint8_t>(MidiEvent::Type::CONTROL_CHANGE)) {
-                        msg_type = daisy::MidiMessageType::ControlChange;
-                    } else if (event.type == static_cast<uint8_t>(MidiEvent::Type::PITCH_BEND)) {
-                        msg_type = daisy::MidiMessageType::PitchBend;
-                    } else {
-                        continue;  // Skip unsupported types
-                    }
-                    Midi::AddGeneratedEvent(msg_type, event.channel, event.data1, event.data2);
-                }
-                
                 // This plugin generated MIDI, stop processing other plugins
                 *count += plugin_count;
+                source = plugin.get();
                 break;
             }
             
             if (*count >= max_events) break;
         }
     }
+    
+    // Scale lock: a pitched source's notes move into the key's scale (one
+    // table read each); runs lock on or off so held notes release correctly
+    if (source && source->FollowsScaleLock()) {
+        scale_lock_filter_.Process(scale_map_, scale_lock_.load(std::memory_order_relaxed), events, count);
+    }
+    
+    // Stack stages (recorded loops on top) see everything generated above
+    for (auto& plugin : input_plugins_) {
+        if (plugin && plugin->IsActive()) {
+            plugin->ProcessStackOutput(events, count, max_events);
+        }
+    }
+    
+    // Add generated events to MIDI hub (for MIDI output routing)
+    // This allows RouteGeneratedMIDI to read the same events without consuming
+    // Don't add external MIDI to hub (we don't want to echo it back out)
+    for (size_t i = 0; i < *count; i++) {
+        MidiEvent& event = events[i];
+        if (event.source == MidiEvent::SOURCE_USB || event.source == MidiEvent::SOURCE_TRS_IN) {
+            continue;
+        }
+        // Same event type end to end - just tag the source
+        event.source = MidiEvent::SOURCE_GENERATED;
+        Midi::AddGeneratedEvent(event);
+    }
 }
 
 void Track::SetMute(bool mute) {
@@ -428,13 +442,14 @@ const char* Track::GetName() const {
 
 void Track::SetKey(MusicalKey key) {
     context_.key = key;
+    scale_map_.SetKey(key);
     
-    // Notify all input plugins that key changed
-    // Plugins can query the key via GetKey() or GetContext()
+    // Notify all input plugins that key changed, so key tables are rebuilt
+    // here rather than on every note. Plugins can still query the key via
+    // GetKey() or GetContext()
     for (auto& plugin : input_plugins_) {
         if (plugin) {
-            // Plugins will read the key when they need it
-            // No explicit notification needed - they can poll GetKey()
+            plugin->OnKeyChanged(key);
         }
     }
 }
@@ -443,6 +458,13 @@ MusicalKey Track::GetKey() const {
     return context_.key;
 }
 
+void Track::SetTransport(float bpm, const SongPosition& position, uint32_t block_start_sample) {
+    // Called by the system from the audio callback before the track processes
+    context_.bpm = bpm;
+    context_.position = position;
+    context_.block_start_sample = block_start_sample;
+}
+
 void Track::SaveScene(int scene_index) {
     if (scene_index < 0 || scene_index >= scenes_.size()) return;
     
@@ -3,6 +3,9 @@
 #include "../plugin_interface.h"
 #include "../midi/midi_types.h"
 #include "../music/chord_engine.h"
+#include "../music/scale_map.h"
+#include "../audio/transport_clock.h"
+#include <atomic>
 #include <vector>
 #include <memory>
 
@@ -15,9 +18,12 @@ class OctaveShift;
  */
 struct TrackContext {
     MusicalKey key;         // Current musical key for the track
-    float bpm;              // Current BPM (future use)
+    float bpm;              // Internal transport tempo
+    SongPosition position;  // Internal transport position at the block being processed
+    uint32_t block_start_sample;  // Sample clock time of the block being processed
+    size_t block_size;
     
-    TrackContext() : key(MusicalKey(0, MusicalMode::IONIAN)), bpm(120.0f) {}
+    TrackContext() : key(MusicalKey(0, MusicalMode::IONIAN)), bpm(120.0f), block_start_sample(0), block_size(0) {}
 };
 
 /**
@@ -85,6 +91,13 @@ public:
     void SetKey(MusicalKey key);
     MusicalKey GetKey() const;
     const TrackContext& GetContext() const { return context_; }
+    void SetTransport(float bpm, const SongPosition& position, uint32_t block_start_sample);
+    
+    // Scale table for the key (rebuilt by SetKey) and scale lock: notes from
+    // pitched sources (FollowsScaleLock) are moved into the key's scale
+    const ScaleMap& GetScaleMap() const { return scale_map_; }
+    void SetScaleLock(bool enabled) { scale_lock_.store(enabled, std::memory_order_relaxed); }
+    bool IsScaleLocked() const { return scale_lock_.load(std::memory_order_relaxed); }
 
     // Octave shift
     void SetOctaveShift(OctaveShift* octave_shift) { octave_shift_ = octave_shift; }
@@ -113,6 +126,9 @@ private:
     
     // Track context (key, BPM, etc.)
     TrackContext context_;
+    ScaleMap scale_map_;
+    ScaleLock scale_lock_filter_;   // Audio callback
+    std::atomic<bool> scale_lock_;
     
     // Octave shift (global per track)
     OctaveShift* octave_shift_;
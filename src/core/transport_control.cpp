@@ -1,10 +1,13 @@
 #include "transport_control.h"
+#include "../plugins/input/loop_recorder_input.h"
 
 namespace OpenChord {
 
 TransportControl::TransportControl()
     : midi_handler_(nullptr)
     , global_settings_(nullptr)
+    , transport_clock_(nullptr)
+    , looper_(nullptr)
     , is_playing_(false)
     , is_recording_(false)
 {
@@ -18,6 +21,10 @@ void TransportControl::Init(OpenChordMidiHandler* midi_handler, GlobalSettings*
     global_settings_ = global_settings;
 }
 
+bool TransportControl::IsRecording() const {
+    return looper_ ? looper_->IsRecording() : is_recording_;
+}
+
 void TransportControl::HandleCombo(int combo_type) {
     if (!midi_handler_ || !global_settings_) {
         return;
@@ -40,15 +47,25 @@ void TransportControl::SendPlayPause() {
     // For now, only send to DAW (MIDI output)
     // Send CC #115 (Play/Pause) - Logic maps this to play/pause toggle, so we send the same signal every time
     // The DAW handles the toggle logic, we just send a trigger
-    // TODO: Add internal looper control when implemented
     if (routing == TransportRouting::DAW_ONLY || routing == TransportRouting::BOTH) {
         if (midi_handler_) {
             // Always send CC #115 with value 127 - DAW handles the toggle
-            midi_handler_->SendMidi(daisy::MidiMessageType::ControlChange, 0, 115, 127);
+            midi_handler_->SendMidi(MidiEvent(MidiEvent::CONTROL_CHANGE, 0, 115, 127));
         }
     }
     
-    // TODO: Control internal looper when routing includes INTERNAL_ONLY or BOTH
+    // Internal transport: START resets to bar 1, STOP keeps the position
+    // The looper starts from its top with the transport and stops with it
+    if ((routing == TransportRouting::INTERNAL_ONLY || routing == TransportRouting::BOTH) && transport_clock_) {
+        is_playing_ = !transport_clock_->IsPlaying();
+        if (is_playing_) {
+            transport_clock_->Start();
+            if (looper_) looper_->Play();
+        } else {
+            transport_clock_->Stop();
+            if (looper_) looper_->Stop();
+        }
+    }
 }
 
 
@@ -61,11 +78,14 @@ void TransportControl::SendRecord() {
     if (routing == TransportRouting::DAW_ONLY || routing == TransportRouting::BOTH) {
         if (midi_handler_) {
             // Always send CC #117 with value 127 - DAW handles the toggle
-            midi_handler_->SendMidi(daisy::MidiMessageType::ControlChange, 0, 117, 127);
+            midi_handler_->SendMidi(MidiEvent(MidiEvent::CONTROL_CHANGE, 0, 117, 127));
         }
     }
     
-    // TODO: Control internal looper recording when routing includes INTERNAL_ONLY or BOTH
+    // Internal looper: first pass, then overdub on/off
+    if ((routing == TransportRouting::INTERNAL_ONLY || routing == TransportRouting::BOTH) && looper_) {
+        looper_->ToggleRecord();
+    }
 }
 
 
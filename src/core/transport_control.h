@@ -2,10 +2,13 @@
 
 #include "midi/midi_handler.h"
 #include "ui/global_settings.h"
+#include "audio/transport_clock.h"
 #include <cstdint>
 
 namespace OpenChord {
 
+class LoopRecorderInput;
+
 /**
  * Transport Control - Handles MIDI transport commands
  * 
@@ -14,6 +17,10 @@ namespace OpenChord {
  * - RECORD tap = Record toggle
  * - INPUT hold = Input Stack menu (handled in main.cpp)
  * - RECORD hold = Global Settings menu (handled in main.cpp)
+ *
+ * With internal routing, play/pause starts and stops the internal
+ * TransportClock, which also sends MIDI START/STOP and clock, and the
+ * looper with it; record drives the looper (record, play, overdub).
  */
 class TransportControl {
 public:
@@ -22,6 +29,8 @@ public:
     
     // Initialization
     void Init(OpenChordMidiHandler* midi_handler, GlobalSettings* global_settings);
+    void SetTransportClock(TransportClock* transport_clock) { transport_clock_ = transport_clock; }
+    void SetLooper(LoopRecorderInput* looper) { looper_ = looper; }
     
     // Update (call from main loop)
     // Called when button combo is detected (on release)
@@ -30,11 +39,13 @@ public:
     
     // Get current transport state (for UI feedback)
     bool IsPlaying() const { return is_playing_; }
-    bool IsRecording() const { return is_recording_; }
+    bool IsRecording() const;
     
 private:
     OpenChordMidiHandler* midi_handler_;
     GlobalSettings* global_settings_;
+    TransportClock* transport_clock_;
+    LoopRecorderInput* looper_;
     
     // Transport state
     bool is_playing_;
@@ -19,7 +19,7 @@ namespace OpenChord {
 void RenderSystemStatus(DisplayManager* display, IOManager* io_manager) {
     if (!display || !display->IsHealthy() || !io_manager) return;
     
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>* disp = display->GetDisplay();
+    auto* disp = display->GetDisplay();
     if (!disp) return;
     
     SystemStatus status = io_manager->GetStatus();
@@ -45,7 +45,8 @@ void RenderSystemStatus(DisplayManager* display, IOManager* io_manager) {
     disp->WriteString(buffer, Font_6x8, true);
     y += 8;
     
-    snprintf(buffer, sizeof(buffer), "Display: %s", status.display_healthy ? "OK" : "FAIL");
+    snprintf(buffer, sizeof(buffer), "Display: %s %luB", status.display_healthy ? "OK" : "FAIL",
+             static_cast<unsigned long>(display->GetUpdateStats().GetLastFrameBytes()));
     disp->SetCursor(0, y);
     disp->WriteString(buffer, Font_6x8, true);
     y += 8;
@@ -65,7 +66,7 @@ void RenderSystemStatus(DisplayManager* display, IOManager* io_manager) {
 void RenderInputStatus(DisplayManager* display, InputManager* input_manager, IOManager* io_manager) {
     if (!display || !display->IsHealthy() || !input_manager || !io_manager) return;
     
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>* disp = display->GetDisplay();
+    auto* disp = display->GetDisplay();
     if (!disp) return;
     
     DigitalManager* digital = io_manager->GetDigital();
@@ -132,7 +133,7 @@ void RenderAnalogStatus(DisplayManager* display, IOManager* io_manager) {
     AnalogManager* analog = io_manager->GetAnalog();
     if (!analog) return;
     
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>* disp = display->GetDisplay();
+    auto* disp = display->GetDisplay();
     if (!disp) return;
     
     char buffer[64];
@@ -177,7 +178,7 @@ void RenderAnalogStatus(DisplayManager* display, IOManager* io_manager) {
 void RenderAudioStatus(DisplayManager* display, AudioEngine* audio_engine, VolumeManager* volume_manager) {
     if (!display || !display->IsHealthy()) return;
     
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>* disp = display->GetDisplay();
+    auto* disp = display->GetDisplay();
     if (!disp) return;
     
     char buffer[64];
@@ -188,12 +189,17 @@ void RenderAudioStatus(DisplayManager* display, AudioEngine* audio_engine, Volum
     y += 10;
     
     if (audio_engine) {
-        snprintf(buffer, sizeof(buffer), "Note: %s", audio_engine->IsNoteOn() ? "ON" : "OFF");
+        const AudioTimingMonitor::Stats& timing = audio_engine->GetTimingStats();
+        snprintf(buffer, sizeof(buffer), "Xrun:%lu Late:%lu",
+                 static_cast<unsigned long>(timing.xrun_count),
+                 static_cast<unsigned long>(timing.late_count));
         disp->SetCursor(0, y);
         disp->WriteString(buffer, Font_6x8, true);
         y += 8;
         
-        snprintf(buffer, sizeof(buffer), "Freq: N/A");
+        snprintf(buffer, sizeof(buffer), "Worst:%luus/%luus",
+                 static_cast<unsigned long>(timing.worst_duration_us),
+                 static_cast<unsigned long>(timing.period_us));
         disp->SetCursor(0, y);
         disp->WriteString(buffer, Font_6x8, true);
         y += 8;
@@ -219,10 +225,10 @@ void RenderAudioStatus(DisplayManager* display, AudioEngine* audio_engine, Volum
     // Note: Display Update() is handled by UIManager
 }
 
-void RenderMIDIStatus(DisplayManager* display, OpenChordMidiHandler* midi_handler) {
+void RenderMIDIStatus(DisplayManager* display, OpenChordMidiHandler* midi_handler, MidiRouter* midi_router) {
     if (!display || !display->IsHealthy()) return;
     
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>* disp = display->GetDisplay();
+    auto* disp = display->GetDisplay();
     if (!disp) return;
     
     char buffer[64];
@@ -233,14 +239,83 @@ void RenderMIDIStatus(DisplayManager* display, OpenChordMidiHandler* midi_handle
     y += 10;
     
     if (midi_handler) {
-        snprintf(buffer, sizeof(buffer), "TRS: %s", midi_handler->IsTrsInitialized() ? "ON" : "OFF");
+        snprintf(buffer, sizeof(buffer), "TRS:%s USB:%s",
+                 midi_handler->IsTrsInitialized() ? "ON" : "OFF",
+                 midi_handler->IsUsbInitialized() ? "ON" : "OFF");
         disp->SetCursor(0, y);
         disp->WriteString(buffer, Font_6x8, true);
         y += 8;
         
-        snprintf(buffer, sizeof(buffer), "USB: %s", midi_handler->IsUsbInitialized() ? "ON" : "OFF");
+        snprintf(buffer, sizeof(buffer), "Drop:%lu",
+                 static_cast<unsigned long>(midi_handler->GetRxDroppedCount()));
         disp->SetCursor(0, y);
         disp->WriteString(buffer, Font_6x8, true);
+        y += 8;
+    }
+    
+    if (midi_router) {
+        const MidiLatencyStats& latency = midi_router->GetLatencyStats();
+        snprintf(buffer, sizeof(buffer), "Lat avg:%lu max:%lu",
+                 static_cast<unsigned long>(latency.GetAverageUs()),
+                 static_cast<unsigned long>(latency.GetWorstUs()));
+        disp->SetCursor(0, y);
+        disp->WriteString(buffer, Font_6x8, true);
+        y += 8;
+        
+        // External clock: followed tempo and arrival jitter (samples)
+        const MidiClockFollower& follower = midi_router->GetClockFollower();
+        if (follower.IsLocked()) {
+            snprintf(buffer, sizeof(buffer), "Clk:%d.%d BPM j%d",
+                     static_cast<int>(follower.GetTempo()),
+                     static_cast<int>(follower.GetTempo() * 10.0f) % 10,
+                     static_cast<int>(follower.GetJitterSamples()));
+        } else {
+            snprintf(buffer, sizeof(buffer), "Clk:%s", follower.IsEnabled() ? "no sync" : "internal");
+        }
+        disp->SetCursor(0, y);
+        disp->WriteString(buffer, Font_6x8, true);
+        y += 8;
+    }
+    
+    if (midi_handler) {
+        snprintf(buffer, sizeof(buffer), "Tx:%lu Xfer:%lu -%luB",
+                 static_cast<unsigned long>(midi_handler->GetTxMessageCount()),
+                 static_cast<unsigned long>(midi_handler->GetUsbTransferCount()),
+                 static_cast<unsigned long>(midi_handler->GetTrsTxBytesSaved()));
+        disp->SetCursor(0, y);
+        disp->WriteString(buffer, Font_6x8, true);
+    }
+    
+    // Note: Display Update() is handled by UIManager
+}
+
+void RenderTaskStatus(DisplayManager* display, TaskScheduler* scheduler) {
+    if (!display || !display->IsHealthy()) return;
+    
+    auto* disp = display->GetDisplay();
+    if (!disp) return;
+    
+    char buffer[64];
+    int y = 10;  // Offset by 10 pixels for system bar (content area starts at y=10)
+    
+    disp->SetCursor(0, y);
+    disp->WriteString("Task   worst  miss", Font_6x8, true);
+    y += 10;
+    
+    if (scheduler) {
+        for (int i = 0; i < scheduler->GetTaskCount(); i++) {
+            const TaskScheduler::Task* task = scheduler->GetTask(i);
+            if (!task) continue;
+            if (y > 56) break;  // No more room
+            
+            snprintf(buffer, sizeof(buffer), "%-7s%5luus %lu",
+                     task->name ? task->name : "?",
+                     static_cast<unsigned long>(task->stats.worst_runtime_us),
+                     static_cast<unsigned long>(task->stats.deadline_misses));
+            disp->SetCursor(0, y);
+            disp->WriteString(buffer, Font_6x8, true);
+            y += 8;
+        }
     }
     
     // Note: Display Update() is handled by UIManager
@@ -7,6 +7,8 @@
 #include "../audio/audio_engine.h"
 #include "../audio/volume_manager.h"
 #include "../midi/midi_handler.h"
+#include "../midi_router.h"
+#include "../task_scheduler.h"
 
 namespace OpenChord {
 
@@ -27,7 +29,10 @@ void RenderAnalogStatus(DisplayManager* display, IOManager* io_manager);
 // Audio view - shows audio engine state
 void RenderAudioStatus(DisplayManager* display, AudioEngine* audio_engine, VolumeManager* volume_manager);
 
-// MIDI view - shows MIDI interface status
-void RenderMIDIStatus(DisplayManager* display, OpenChordMidiHandler* midi_handler);
+// MIDI view - shows MIDI interface status and input latency
+void RenderMIDIStatus(DisplayManager* display, OpenChordMidiHandler* midi_handler, MidiRouter* midi_router);
+
+// Task view - shows scheduler per-task worst runtime and deadline misses
+void RenderTaskStatus(DisplayManager* display, TaskScheduler* scheduler);
 
 } // namespace OpenChord
\ No newline at end of file
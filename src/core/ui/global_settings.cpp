@@ -11,9 +11,18 @@ static const char* transport_routing_options[] = {
     nullptr
 };
 
+// Enum option strings for clock source
+static const char* clock_source_options[] = {
+    "Internal",
+    "MIDI In",
+    nullptr
+};
+
 GlobalSettings::GlobalSettings()
     : transport_routing_(TransportRouting::DAW_ONLY)  // Default: DAW only (for now)
     , transport_routing_value_(static_cast<int>(TransportRouting::DAW_ONLY))
+    , clock_source_(ClockSource::MIDI_IN)  // Default: follow a DAW's clock when one is sent
+    , clock_source_value_(static_cast<int>(ClockSource::MIDI_IN))
 {
     InitializeSettings();
     SyncTransportRoutingValue();  // Initial sync
@@ -33,6 +42,17 @@ void GlobalSettings::InitializeSettings() {
     settings_[0].enum_options = transport_routing_options;
     settings_[0].enum_count = 3;
     settings_[0].on_change_callback = nullptr;
+    
+    // Setting 1: Clock Source (enum)
+    settings_[1].name = "Clock";
+    settings_[1].type = SettingType::ENUM;
+    settings_[1].value_ptr = &clock_source_value_;
+    settings_[1].min_value = 0.0f;
+    settings_[1].max_value = 1.0f;
+    settings_[1].step_size = 1.0f;
+    settings_[1].enum_options = clock_source_options;
+    settings_[1].enum_count = 2;
+    settings_[1].on_change_callback = nullptr;
 }
 
 int GlobalSettings::GetSettingCount() const {
@@ -50,6 +70,8 @@ void GlobalSettings::OnSettingChanged(int setting_index) {
     if (setting_index == 0) {
         // Transport routing changed - sync enum value
         SyncTransportRoutingValue();
+    } else if (setting_index == 1) {
+        SyncClockSourceValue();
     }
 }
 
@@ -66,5 +88,11 @@ void GlobalSettings::SyncTransportRoutingValue() {
     }
 }
 
+void GlobalSettings::SyncClockSourceValue() {
+    if (clock_source_value_ < 0) clock_source_value_ = 0;
+    if (clock_source_value_ > 1) clock_source_value_ = 1;
+    clock_source_ = static_cast<ClockSource>(clock_source_value_);
+}
+
 } // namespace OpenChord
 
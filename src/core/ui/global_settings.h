@@ -14,6 +14,15 @@ enum class TransportRouting {
     BOTH = 2            // Both internal looper and DAW
 };
 
+/**
+ * Clock Source Options
+ * Where the internal transport takes its tempo from
+ */
+enum class ClockSource {
+    INTERNAL = 0,       // Internal tempo only
+    MIDI_IN = 1         // Follow incoming MIDI clock while present
+};
+
 /**
  * Global Settings - Device-wide settings
  * 
@@ -36,14 +45,21 @@ public:
         transport_routing_ = routing;
         transport_routing_value_ = static_cast<int>(routing);
     }
+    ClockSource GetClockSource() const { return clock_source_; }
+    void SetClockSource(ClockSource source) {
+        clock_source_ = source;
+        clock_source_value_ = static_cast<int>(source);
+    }
     
 private:
     // Settings values
     TransportRouting transport_routing_;
     int transport_routing_value_;  // Helper int for settings (synced with transport_routing_)
+    ClockSource clock_source_;
+    int clock_source_value_;       // Helper int for settings (synced with clock_source_)
     
     // Settings array (similar to plugin pattern)
-    static constexpr int SETTING_COUNT = 1;
+    static constexpr int SETTING_COUNT = 2;
     mutable PluginSetting settings_[SETTING_COUNT];
     
     // Initialize settings array
@@ -51,6 +67,7 @@ private:
     
     // Sync helper value with enum
     void SyncTransportRoutingValue();
+    void SyncClockSourceValue();
 };
 
 } // namespace OpenChord
@@ -1,5 +1,4 @@
 #include "main_ui.h"
-#include "content_area.h"
 #include "../music/chord_engine.h"
 #include "../../plugins/input/chord_mapping_input.h"
 #include "../../plugins/input/piano_input.h"
@@ -8,13 +7,23 @@
 
 namespace OpenChord {
 
+namespace {
+const char* const NOTE_NAMES[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+const char* const MODE_NAMES[] = {"Maj", "Dor", "Phr", "Lyd", "Mix", "Min", "Loc"};
+}
+
 MainUI::MainUI()
     : display_(nullptr)
     , input_manager_(nullptr)
     , track_(nullptr)
     , chord_plugin_(nullptr)
     , piano_plugin_(nullptr)
+    , shown_root_(-1)
+    , shown_mode_(-1)
+    , shown_preset_(-1)
+    , shown_note_count_(-1)
 {
+    memset(shown_notes_, 0, sizeof(shown_notes_));
 }
 
 MainUI::~MainUI() {
@@ -24,6 +33,16 @@ void MainUI::Init(DisplayManager* display, InputManager* input_manager) {
     display_ = display;
     input_manager_ = input_manager;
     track_ = nullptr;
+    
+    // Content area starts at y=10 (below system bar with spacing)
+    // Key on top, chord name (large font) in the middle, preset at the bottom
+    key_label_.Init(0, 10, 128, &Font_6x8);
+    main_label_.Init(0, 10, 128);
+    preset_label_.Init(0, 55, 128, &Font_6x8);
+    shown_root_ = -1;
+    shown_mode_ = -1;
+    shown_preset_ = -1;
+    shown_note_count_ = -1;
 }
 
 void MainUI::SetTrack(Track* track) {
@@ -39,184 +58,128 @@ void MainUI::SetPianoPlugin(PianoInput* plugin) {
 }
 
 void MainUI::Update() {
-    // MainUI no longer manages its own rendering
-    // State updates happen here if needed in the future
-}
-
-void MainUI::Render(DisplayManager* display) {
-    if (!display) return;
-    
-    RenderChordName(display);
-}
-
-void MainUI::RenderChordName(DisplayManager* display) {
-    if (!display || !display->IsHealthy()) return;
-    
-    daisy::OledDisplay<daisy::SSD130x4WireSpi128x64Driver>* disp = display->GetDisplay();
-    if (!disp) return;
-    
-    // Content area starts at y=10 (below system bar with spacing)
-    
-    int y = 10;  // Start below system bar with spacing
-    
     // Check if chord mapping plugin is active
     bool chord_mode_active = chord_plugin_ && chord_plugin_->IsActive();
     
     if (chord_mode_active) {
         // Chord mode: show chord name, key, and preset
-        const char* chord_text = "----";  // Default: show dashes when no chord
-        char key_text[16] = "";
-        char preset_text[16] = "";
-        
-        if (chord_plugin_) {
-            const Chord* chord = chord_plugin_->GetCurrentChord();
-            if (chord && chord->note_count > 0) {
-                chord_text = chord->name;
-            }
-            // else: keep "----" as default
-            
-            // Get key name
-            MusicalKey key = chord_plugin_->GetCurrentKey();
-            const char* note_names[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
-            const char* mode_names[] = {"Maj", "Dor", "Phr", "Lyd", "Mix", "Min", "Loc"};
-            
-            int note_idx = key.root_note % 12;
-            int mode_idx = static_cast<int>(key.mode);
-            
-            if (note_idx >= 0 && note_idx < 12 && mode_idx >= 0 && mode_idx < 7) {
-                snprintf(key_text, sizeof(key_text), "%s %s", note_names[note_idx], mode_names[mode_idx]);
-            }
-            
-            // Get preset name (using a temporary ChordEngine instance for lookup)
-            int preset_idx = chord_plugin_->GetCurrentJoystickPreset();
-            ChordEngine engine;
-            const JoystickPreset* preset = engine.GetJoystickPreset(preset_idx);
-            if (preset && preset->name) {
-                snprintf(preset_text, sizeof(preset_text), "Preset: %s", preset->name);
-            }
-        }
-        
-        // Top line: Key info
-        if (key_text[0] != '\0') {
-            disp->SetCursor(0, y);
-            disp->WriteString(key_text, Font_6x8, true);
-            y += 10;
-        }
+        MusicalKey key = chord_plugin_->GetCurrentKey();
+        UpdateKey(&key);
         
-        // Center: Chord name (large font, centered vertically in content area)
-        // Only render if chord_text is not nullptr
-        if (chord_text) {
-            int content_start_y = y;
-            int content_height = 64 - content_start_y - 8;  // Leave space at bottom for preset
-            int font_height = 18;  // Font_11x18 height
-            int chord_y = content_start_y + (content_height - font_height) / 2;
-            
-            // Calculate chord text width for centering
-            int chord_text_len = strlen(chord_text);
-            int chord_text_width = chord_text_len * 11;  // Font_11x18 width per character
-            int chord_x = (128 - chord_text_width) / 2;
-            if (chord_x < 0) chord_x = 0;
-            
-            disp->SetCursor(chord_x, chord_y);
-            disp->WriteString(chord_text, Font_11x18, true);
-        }
+        // Show dashes when no chord
+        const Chord* chord = chord_plugin_->GetCurrentChord();
+        main_label_.SetText(chord && chord->note_count > 0 ? chord->name : "----");
         
-        // Bottom: Preset info
-        if (preset_text[0] != '\0') {
-            disp->SetCursor(0, 55);
-            disp->WriteString(preset_text, Font_6x8, true);
+        UpdatePreset(chord_plugin_->GetCurrentJoystickPreset());
+        shown_note_count_ = -1;
+    } else if (piano_plugin_ && piano_plugin_->IsActive()) {
+        // Not in chord mode: show active notes from piano input
+        if (track_) {
+            MusicalKey key = piano_plugin_->GetCurrentKey();
+            UpdateKey(&key);
+        } else {
+            UpdateKey(nullptr);
         }
+        UpdatePianoNotes();
+        UpdatePreset(-1);
     } else {
-        // Not in chord mode: show active notes from piano input
-        if (piano_plugin_ && piano_plugin_->IsActive()) {
-            RenderPianoNotes(display);
-        } else if (chord_plugin_) {
-            // Fallback: show key only if available
+        // Fallback: show key only if available
+        if (chord_plugin_) {
             MusicalKey key = chord_plugin_->GetCurrentKey();
-            const char* note_names[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
-            const char* mode_names[] = {"Maj", "Dor", "Phr", "Lyd", "Mix", "Min", "Loc"};
-            
-            int note_idx = key.root_note % 12;
-            int mode_idx = static_cast<int>(key.mode);
-            
-            if (note_idx >= 0 && note_idx < 12 && mode_idx >= 0 && mode_idx < 7) {
-                char key_text[16] = "";
-                snprintf(key_text, sizeof(key_text), "%s %s", note_names[note_idx], mode_names[mode_idx]);
-                disp->SetCursor(0, y);
-                disp->WriteString(key_text, Font_6x8, true);
-            }
+            UpdateKey(&key);
+        } else {
+            UpdateKey(nullptr);
         }
+        main_label_.SetText(nullptr);
+        UpdatePreset(-1);
+        shown_note_count_ = -1;
     }
+    
+    PlaceMainLabel();
 }
 
-void MainUI::RenderPianoNotes(DisplayManager* display) {
-    if (!display || !display->IsHealthy() || !piano_plugin_) return;
+bool MainUI::IsDirty() const {
+    return key_label_.IsDirty() || main_label_.IsDirty() || preset_label_.IsDirty();
+}
+
+void MainUI::Render(DisplayManager* display) {
+    if (!display || !display->IsHealthy()) return;
     
     auto* disp = display->GetDisplay();
     if (!disp) return;
     
-    int y = 10;  // Start below system bar with spacing
-    
-    // Show key info at top (like Chords mode)
-    if (track_ && piano_plugin_) {
-        MusicalKey key = piano_plugin_->GetCurrentKey();
-        const char* note_names[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
-        const char* mode_names[] = {"Maj", "Dor", "Phr", "Lyd", "Mix", "Min", "Loc"};
-        
-        int note_idx = key.root_note % 12;
-        int mode_idx = static_cast<int>(key.mode);
-        
-        if (note_idx >= 0 && note_idx < 12 && mode_idx >= 0 && mode_idx < 7) {
-            char key_text[16] = "";
-            snprintf(key_text, sizeof(key_text), "%s %s", note_names[note_idx], mode_names[mode_idx]);
-            disp->SetCursor(0, y);
-            disp->WriteString(key_text, Font_6x8, true);
-            y += 10;  // Move down for notes display
-        }
+    // Draw the latest state even if Update() hasn't run since it changed
+    Update();
+    key_label_.Draw(display);
+    main_label_.Draw(display);
+    preset_label_.Draw(display);
+}
+
+void MainUI::UpdateKey(const MusicalKey* key) {
+    int note_idx = key ? key->root_note % 12 : -1;
+    int mode_idx = key ? static_cast<int>(key->mode) : -1;
+    if (note_idx < 0 || note_idx >= 12 || mode_idx < 0 || mode_idx >= 7) {
+        note_idx = -1;
+        mode_idx = -1;
     }
+    if (note_idx == shown_root_ && mode_idx == shown_mode_) return;
+    shown_root_ = note_idx;
+    shown_mode_ = mode_idx;
     
-    // Get active notes from piano plugin
-    std::vector<uint8_t> active_notes = piano_plugin_->GetActiveNotes();
-    
-    // y already set above for key display, adjust for notes
-    int notes_y = y;  // Start notes display after key
-    
-    if (active_notes.empty()) {
-        // No notes active - show nothing or "--"
-        return;  // Just show nothing
+    if (note_idx < 0) {
+        key_label_.SetText(nullptr);
+        return;
     }
-    
-    // Build note name string
-    char note_text[64] = "";
-    const char* note_names[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
-    
-    for (size_t i = 0; i < active_notes.size() && i < 7; i++) {
-        uint8_t midi_note = active_notes[i];
-        int note_idx = midi_note % 12;
-        int octave = (midi_note / 12) - 1;  // MIDI note 60 = C4
-        
-        if (i > 0) {
-            strcat(note_text, " ");
-        }
-        
-        char note_str[8];
-        snprintf(note_str, sizeof(note_str), "%s%d", note_names[note_idx], octave);
-        strcat(note_text, note_str);
+    char key_text[16];
+    snprintf(key_text, sizeof(key_text), "%s %s", NOTE_NAMES[note_idx], MODE_NAMES[mode_idx]);
+    key_label_.SetText(key_text);
+}
+
+void MainUI::UpdatePreset(int preset_index) {
+    if (preset_index == shown_preset_) return;
+    shown_preset_ = preset_index;
+    
+    // Name comes from the chord plugin's engine, looked up only on change
+    const JoystickPreset* preset = preset_index >= 0 && chord_plugin_
+                                       ? chord_plugin_->GetCurrentJoystickPresetInfo()
+                                       : nullptr;
+    if (!preset || !preset->name) {
+        preset_label_.SetText(nullptr);
+        return;
     }
-    
-    // Center the text
-    int text_width = strlen(note_text) * 11;  // Font_11x18 width
-    int text_x = (128 - text_width) / 2;
-    if (text_x < 0) text_x = 0;
-    
-    int content_start_y = notes_y;
-    int content_height = 64 - content_start_y - 8;
-    int font_height = 18;
-    int text_y = content_start_y + (content_height - font_height) / 2;
-    
-    disp->SetCursor(text_x, text_y);
-    disp->WriteString(note_text, Font_11x18, true);
+    char preset_text[16];
+    snprintf(preset_text, sizeof(preset_text), "Preset: %s", preset->name);
+    preset_label_.SetText(preset_text);
 }
 
-} // namespace OpenChord
+void MainUI::UpdatePianoNotes() {
+    uint8_t notes[MAX_SHOWN_NOTES];
+    size_t count = piano_plugin_->GetActiveNotes(notes, MAX_SHOWN_NOTES);
+    if (static_cast<int>(count) == shown_note_count_ && memcmp(notes, shown_notes_, count) == 0) {
+        return;
+    }
+    memcpy(shown_notes_, notes, count);
+    shown_note_count_ = static_cast<int>(count);
+    
+    // Build note name string (no notes active - show nothing)
+    char note_text[Label::MAX_TEXT] = "";
+    size_t len = 0;
+    for (size_t i = 0; i < count; i++) {
+        int note_idx = notes[i] % 12;
+        int octave = (notes[i] / 12) - 1;  // MIDI note 60 = C4
+        int written = snprintf(&note_text[len], sizeof(note_text) - len, "%s%s%d",
+                               i > 0 ? " " : "", NOTE_NAMES[note_idx], octave);
+        if (written < 0 || len + written >= sizeof(note_text)) break;
+        len += written;
+    }
+    main_label_.SetText(note_text);
+}
 
+void MainUI::PlaceMainLabel() {
+    // Centered vertically between the key line and the preset line
+    int content_start_y = key_label_.IsEmpty() ? 10 : 20;
+    int content_height = 64 - content_start_y - 8;  // Leave space at bottom for preset
+    main_label_.SetPosition(0, content_start_y + (content_height - BigLabel::FONT_HEIGHT) / 2);
+}
+
+} // namespace OpenChord
@@ -3,6 +3,7 @@
 #include "../io/display_manager.h"
 #include "../io/input_manager.h"
 #include "../tracks/track_interface.h"
+#include "widgets.h"
 #include "daisy_seed.h"
 #include "dev/oled_ssd130x.h"
 
@@ -12,6 +13,11 @@ namespace OpenChord {
  * Main UI - Default user interface for OpenChord
  * 
  * Displays chord name and other primary information
+ * 
+ * Key, chord/notes and preset are retained widgets. Update() compares the
+ * plugin state with what is shown and rebuilds a string only when it
+ * changed; IsDirty() tells the UI Manager whether a redraw is needed, so an
+ * unchanged screen costs no drawing or display traffic.
  */
 class MainUI {
 public:
@@ -24,7 +30,10 @@ public:
     // Update - call periodically to update state (not rendering)
     void Update();
     
-    // Render - renders content area (does NOT clear display or call Update())
+    // Something shown changed since the last Render()
+    bool IsDirty() const;
+    
+    // Render - renders content area (does NOT clear display)
     // This is called by UIManager, which handles display lifecycle
     void Render(DisplayManager* display);
     
@@ -47,9 +56,23 @@ private:
     class ChordMappingInput* chord_plugin_;  // Direct reference to chord plugin
     class PianoInput* piano_plugin_;  // Direct reference to piano plugin
     
-    // Render methods
-    void RenderChordName(DisplayManager* display);
-    void RenderPianoNotes(DisplayManager* display);
+    // Retained widgets
+    static constexpr size_t MAX_SHOWN_NOTES = 7;
+    Label key_label_;
+    BigLabel main_label_;   // Chord name or held piano notes
+    Label preset_label_;
+    
+    // Values behind the widgets (-1 = nothing shown)
+    int shown_root_;
+    int shown_mode_;
+    int shown_preset_;
+    uint8_t shown_notes_[MAX_SHOWN_NOTES];
+    int shown_note_count_;   // -1 = main label isn't showing notes
+    
+    void UpdateKey(const MusicalKey* key);   // nullptr = hide
+    void UpdatePreset(int preset_index);      // -1 = hide
+    void UpdatePianoNotes();
+    void PlaceMainLabel();
 };
 
 } // namespace OpenChord
@@ -7,6 +7,9 @@
 #include "../io/io_manager.h"
 #include "../../plugins/input/chord_mapping_input.h"  // For ChordMappingInput cast
 #include "../../plugins/input/piano_input.h"  // For PianoInput cast
+#include "../../plugins/input/arpeggiator_input.h"  // For ArpeggiatorInput cast
+#include "../../plugins/input/step_sequencer_input.h"  // For StepSequencerInput cast
+#include "../../plugins/input/loop_recorder_input.h"  // For LoopRecorderInput cast
 #include "../../plugins/instruments/subtractive_synth.h"  // For SubtractiveSynth cast
 #include "../../plugins/fx/delay_fx.h"  // For DelayFX cast
 #include "../../plugins/fx/chorus_fx.h"  // For ChorusFX cast
@@ -63,6 +66,7 @@ MenuManager::MenuManager()
     ,     current_settings_plugin_(nullptr)
     , current_settings_name_(nullptr)
     , needs_refresh_(false)
+    , list_y_(-1)
     , temp_menu_count_(0)
     , menu_toggle_mode_(false)
     , menu_open_time_(0)
@@ -91,6 +95,9 @@ void MenuManager::Init(DisplayManager* display, InputManager* input_manager) {
     current_settings_plugin_ = nullptr;
     needs_refresh_ = false;
     
+    title_label_.Init(0, 10, 128, &Font_6x8);
+    list_y_ = -1;
+    
     // Initialize saved settings plugins
     for (int i = 0; i < 6; i++) {
         saved_settings_plugin_[i] = nullptr;
@@ -611,6 +618,36 @@ bool MenuManager::UpdateMenuInput(SettingsManager* settings_mgr, IOManager* io_m
     return state_changed;
 }
 
+void MenuManager::UpdateView() {
+    if (!IsOpen() || current_settings_plugin_) return;
+    
+    Menu* menu = GetCurrentMenu();
+    if (!menu) return;
+    
+    // Content area starts at y=10; items go below the title
+    title_label_.SetText(menu->GetTitle());
+    int list_y = menu->GetTitle() ? 10 + List::LINE_HEIGHT : 10;
+    if (list_y != list_y_) {
+        list_y_ = list_y;
+        item_list_.Init(0, list_y, 128, 64 - list_y, MAX_VISIBLE_LINES);
+    }
+    
+    item_list_.SetItemCount(menu->GetItemCount());
+    item_list_.SetSelected(GetCurrentSelectedIndex());
+    
+    // Only the visible rows are formatted; unchanged text doesn't redraw
+    char buffer[40];
+    int first = item_list_.GetFirstVisible();
+    for (int i = first; item_list_.IsRowVisible(i); i++) {
+        FormatItem(menu, i, buffer, sizeof(buffer));
+        item_list_.SetItem(i, buffer);
+    }
+}
+
+bool MenuManager::IsDirty() const {
+    return needs_refresh_ || title_label_.IsDirty() || item_list_.IsDirty();
+}
+
 void MenuManager::Render() {
     if (!IsHealthy() || !IsOpen()) return;
     
@@ -622,158 +659,76 @@ void MenuManager::Render() {
         return;  // Settings Manager will handle rendering
     }
     
-    Menu* menu = GetCurrentMenu();
-    if (!menu) return;
-    
-    // Render menu title and items
-    // Content area starts at y=10
-    int y = 10;
-    const int line_height = 10;
-    const int max_visible_lines = 5;
-    
-    // Render title
-    if (menu->GetTitle()) {
-        disp->SetCursor(0, y);
-        disp->WriteString(menu->GetTitle(), Font_6x8, true);
-        y += line_height;
-    }
-    
-    // Render menu items
-    int selected = GetCurrentSelectedIndex();
-    int start_index = 0;
-    if (selected >= max_visible_lines) {
-        start_index = selected - max_visible_lines + 1;
-    }
-    
-    int end_index = start_index + max_visible_lines;
-    if (end_index > menu->GetItemCount()) {
-        end_index = menu->GetItemCount();
-    }
+    UpdateView();
+    title_label_.Draw(display_);
+    item_list_.Draw(display_);
+    needs_refresh_ = false;
+}
+
+void MenuManager::FormatItem(const Menu* menu, int index, char* buffer, size_t size) const {
+    buffer[0] = '\0';
+    const MenuItem* item = menu->GetItem(index);
+    if (!item) return;
     
-    // Calculate content area bounds for scrollbar
-    const int content_start_y = y;  // After title (or 10 if no title)
-    const int content_height = 64 - content_start_y;  // Screen height (64) minus content start
-    const int scrollbar_x = 126;  // Right edge (2 pixels wide: 126 and 127)
-    
-    // Render scrollbar if needed
-    int total_items = menu->GetItemCount();
-    if (total_items > max_visible_lines) {
-        // Calculate scrollbar thumb position and size
-        float scrollbar_track_height = static_cast<float>(content_height);
-        float visible_ratio = static_cast<float>(max_visible_lines) / static_cast<float>(total_items);
-        float thumb_height = scrollbar_track_height * visible_ratio;
-        if (thumb_height < 4.0f) thumb_height = 4.0f;  // Minimum thumb size
-        
-        float scroll_ratio = static_cast<float>(start_index) / static_cast<float>(total_items - max_visible_lines);
-        if (total_items <= max_visible_lines) scroll_ratio = 0.0f;
-        
-        int thumb_start_y = content_start_y + static_cast<int>(scroll_ratio * (scrollbar_track_height - thumb_height));
-        int thumb_end_y = thumb_start_y + static_cast<int>(thumb_height);
-        if (thumb_end_y > 64) thumb_end_y = 64;
-        if (thumb_start_y < content_start_y) thumb_start_y = content_start_y;
-        
-        // Draw scrollbar track (subtle - just outline edges)
-        disp->DrawPixel(scrollbar_x, content_start_y, true);  // Top edge
-        disp->DrawPixel(scrollbar_x + 1, content_start_y, true);
-        disp->DrawPixel(scrollbar_x, 63, true);  // Bottom edge (64-1)
-        disp->DrawPixel(scrollbar_x + 1, 63, true);
-        
-        // Draw scrollbar thumb (solid filled rectangle - this is what shows position)
-        for (int sy = thumb_start_y; sy < thumb_end_y; sy++) {
-            disp->DrawPixel(scrollbar_x, sy, true);
-            disp->DrawPixel(scrollbar_x + 1, sy, true);
-        }
+    if (item->type == MenuItemType::SEPARATOR) {
+        // Subtle separator - just a few dashes, not selectable
+        snprintf(buffer, size, "- - - - - - - - -");
+        return;
     }
     
-    for (int i = start_index; i < end_index; i++) {
-        const MenuItem* item = menu->GetItem(i);
-        if (!item) continue;
+    // Check if item has submenu/settings (can navigate right)
+    bool has_submenu = (item->type == MenuItemType::PLUGIN_SETTINGS && item->context != nullptr) ||
+                      (item->type == MenuItemType::SUBMENU);
+    
+    // For plugin items, show on/off status
+    char status_suffix[8] = "";
+    if (item->type == MenuItemType::PLUGIN_SETTINGS && item->label && current_track_) {
+        // We can't safely cast from IPluginWithSettings* to IInputPlugin* due to multiple inheritance.
+        // Instead, look up the plugin from the track by name (same approach as ToggleCurrentItem).
+        // This works for both plugins with settings (item->context != nullptr) and without (item->context == nullptr).
+        const char* plugin_name = item->label;
         
-        if (item->type == MenuItemType::SEPARATOR) {
-            // Draw subtle separator line (just a simple line, not selectable)
-            // Use a more subtle visual - just a few dashes centered
-            char separator_line[22] = "  - - - - - - - - -  ";
-            disp->SetCursor(0, y);
-            disp->WriteString(separator_line, Font_6x8, true);
-            y += line_height;
-            continue;
+        // Search for the plugin in input plugins
+        const auto& plugins = current_track_->GetInputPlugins();
+        for (const auto& plugin : plugins) {
+            if (plugin && plugin->GetName() && strcmp(plugin->GetName(), plugin_name) == 0) {
+                IInputPlugin* input_plugin = plugin.get();
+                if (input_plugin) {
+                    snprintf(status_suffix, sizeof(status_suffix), " [%s]", 
+                            input_plugin->IsActive() ? "ON" : "OFF");
+                    break;
+                }
+            }
         }
         
-        const char* prefix = (i == selected) ? "> " : "  ";
-        
-        // Check if item has submenu/settings (can navigate right)
-        bool has_submenu = (item->type == MenuItemType::PLUGIN_SETTINGS && item->context != nullptr) ||
-                          (item->type == MenuItemType::SUBMENU);
-        
-        // For plugin items, show on/off status
-        char status_suffix[8] = "";
-        if (item->type == MenuItemType::PLUGIN_SETTINGS && item->label && current_track_) {
-            // We can't safely cast from IPluginWithSettings* to IInputPlugin* due to multiple inheritance.
-            // Instead, look up the plugin from the track by name (same approach as ToggleCurrentItem).
-            // This works for both plugins with settings (item->context != nullptr) and without (item->context == nullptr).
-            const char* plugin_name = item->label;
-            
-            // Search for the plugin in input plugins
-            const auto& plugins = current_track_->GetInputPlugins();
-            for (const auto& plugin : plugins) {
-                if (plugin && plugin->GetName() && strcmp(plugin->GetName(), plugin_name) == 0) {
-                    IInputPlugin* input_plugin = plugin.get();
-                    if (input_plugin) {
+        // If not found in input plugins, try effects
+        if (status_suffix[0] == '\0') {
+            const auto& effects = current_track_->GetEffects();
+            for (const auto& effect : effects) {
+                if (effect && effect->GetName() && strcmp(effect->GetName(), plugin_name) == 0) {
+                    IEffectPlugin* effect_plugin = effect.get();
+                    if (effect_plugin) {
                         snprintf(status_suffix, sizeof(status_suffix), " [%s]", 
-                                input_plugin->IsActive() ? "ON" : "OFF");
+                                effect_plugin->IsBypassed() ? "OFF" : "ON");
                         break;
                     }
                 }
             }
-            
-            // If not found in input plugins, try effects
-            if (status_suffix[0] == '\0') {
-                const auto& effects = current_track_->GetEffects();
-                for (const auto& effect : effects) {
-                    if (effect && effect->GetName() && strcmp(effect->GetName(), plugin_name) == 0) {
-                        IEffectPlugin* effect_plugin = effect.get();
-                        if (effect_plugin) {
-                            snprintf(status_suffix, sizeof(status_suffix), " [%s]", 
-                                    effect_plugin->IsBypassed() ? "OFF" : "ON");
-                            break;
-                        }
-                    }
-                }
-            }
-            
-            // If not found in effects, try instrument (only if we're in instrument menu)
-            if (status_suffix[0] == '\0' && current_menu_type_ == MenuType::INSTRUMENT) {
-                auto* instrument = current_track_->GetInstrument();
-                if (instrument && instrument->GetName() && strcmp(instrument->GetName(), plugin_name) == 0) {
-                    snprintf(status_suffix, sizeof(status_suffix), " [%s]", 
-                            current_track_->IsInstrumentEnabled() ? "ON" : "OFF");
-                }
-            }
-        }
-        
-        // Build the label with submenu indicator
-        char buffer[40];
-        if (has_submenu) {
-            // Add " >" indicator on the right for items with submenus
-            snprintf(buffer, sizeof(buffer), "%s%s%s >", prefix, item->label ? item->label : "", status_suffix);
-        } else {
-            snprintf(buffer, sizeof(buffer), "%s%s%s", prefix, item->label ? item->label : "", status_suffix);
         }
         
-        // Truncate if too long (128 pixels = ~21 chars at 6x8 font)
-        if (strlen(buffer) > 21) {
-            buffer[18] = '.';
-            buffer[19] = '.';
-            buffer[20] = '.';
-            buffer[21] = '\0';
+        // If not found in effects, try instrument (only if we're in instrument menu)
+        if (status_suffix[0] == '\0' && current_menu_type_ == MenuType::INSTRUMENT) {
+            auto* instrument = current_track_->GetInstrument();
+            if (instrument && instrument->GetName() && strcmp(instrument->GetName(), plugin_name) == 0) {
+                snprintf(status_suffix, sizeof(status_suffix), " [%s]", 
+                        current_track_->IsInstrumentEnabled() ? "ON" : "OFF");
+            }
         }
-        
-        disp->SetCursor(0, y);
-        disp->WriteString(buffer, Font_6x8, true);
-        y += line_height;
-        
-        if (y >= 64) break;
     }
+    
+    // Add " >" indicator on the right for items with submenus
+    snprintf(buffer, size, "%s%s%s", item->label ? item->label : "", status_suffix,
+             has_submenu ? " >" : "");
 }
 
 void MenuManager::HandleJoystickInput(float x, float y) {
@@ -886,6 +841,18 @@ void MenuManager::GenerateInputStackMenu() {
                 // This is PianoInput - cast to the actual object type first
                 PianoInput* piano_plugin = static_cast<PianoInput*>(plugin);
                 settings_plugin = static_cast<IPluginWithSettings*>(piano_plugin);
+            } else if (strcmp(name, "Arp") == 0) {
+                // This is ArpeggiatorInput - cast to the actual object type first
+                ArpeggiatorInput* arp_plugin = static_cast<ArpeggiatorInput*>(plugin);
+                settings_plugin = static_cast<IPluginWithSettings*>(arp_plugin);
+            } else if (strcmp(name, "Sequencer") == 0) {
+                // This is StepSequencerInput - cast to the actual object type first
+                StepSequencerInput* sequencer_plugin = static_cast<StepSequencerInput*>(plugin);
+                settings_plugin = static_cast<IPluginWithSettings*>(sequencer_plugin);
+            } else if (strcmp(name, "Looper") == 0) {
+                // This is LoopRecorderInput - cast to the actual object type first
+                LoopRecorderInput* looper_plugin = static_cast<LoopRecorderInput*>(plugin);
+                settings_plugin = static_cast<IPluginWithSettings*>(looper_plugin);
             }
         }
         
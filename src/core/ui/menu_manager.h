@@ -3,6 +3,7 @@
 #include "../io/display_manager.h"
 #include "../io/input_manager.h"
 #include "plugin_settings.h"
+#include "widgets.h"
 #include <cstdint>
 
 namespace OpenChord {
@@ -127,7 +128,10 @@ public:
     // Returns true if menu state changed (needs UI refresh)
     bool UpdateMenuInput(SettingsManager* settings_mgr, IOManager* io_manager, uint32_t current_time_ms);
     
-    // Rendering
+    // Rendering - UpdateView() binds the open menu to its widgets, IsDirty()
+    // then says whether the menu looks different from the last Render()
+    void UpdateView();
+    bool IsDirty() const;
     void Render();
     
     // Get current plugin for settings (if in plugin settings)
@@ -182,6 +186,14 @@ private:
     
     bool needs_refresh_;  // Flag to request immediate UI refresh
     
+    // Retained widgets for the open menu
+    static constexpr int MAX_VISIBLE_LINES = 5;
+    Label title_label_;
+    List item_list_;
+    int list_y_;  // Top of the item list (depends on whether there is a title)
+    
+    void FormatItem(const Menu* menu, int index, char* buffer, size_t size) const;
+    
     // Menu toggle mode state (for advanced hold behavior)
     bool menu_toggle_mode_;  // True if menu is in toggle mode (stays open after quick release)
     uint32_t menu_open_time_;  // Timestamp when menu was opened (for toggle mode timing)
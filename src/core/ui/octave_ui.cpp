@@ -23,11 +23,24 @@ void OctaveUI::Init(DisplayManager* display, OctaveShift* octave_shift) {
     is_active_ = false;
     auto_hide_timeout_ = 0;
     last_adjust_time_ = 0;
+    
+    // Content area starts at y=10 (below system bar)
+    // "Octave" label, value in large font, then where the shift sits in its range
+    title_label_.Init(0, 20, 128, &Font_6x8, Label::Align::CENTER);
+    title_label_.SetText("Octave");
+    value_label_.Init(0, 35, 128);
+    position_bar_.Init(28, 57, 72, 3, Bar::Orientation::HORIZONTAL);
 }
 
 void OctaveUI::Activate() {
     is_active_ = true;
     last_adjust_time_ = 0;
+    
+    // Screen was showing something else - draw everything
+    title_label_.Invalidate();
+    value_label_.Invalidate();
+    position_bar_.Invalidate();
+    UpdateView();
 }
 
 void OctaveUI::Deactivate() {
@@ -57,39 +70,22 @@ void OctaveUI::Update(float joystick_x, uint32_t current_time_ms) {
     // Auto-hide after timeout (if no adjustments)
     if (last_adjust_time_ > 0 && (current_time_ms - last_adjust_time_) > AUTO_HIDE_TIMEOUT_MS) {
         Deactivate();
+        return;
     }
+    
+    UpdateView();
 }
 
-void OctaveUI::Render() {
-    if (!IsHealthy() || !is_active_) return;
-    
-    auto* disp = display_->GetDisplay();
-    if (!disp || !octave_shift_) return;
-    
-    // Note: Display should already be cleared and system bar rendered by caller
-    // We just render our content area (offset below system bar)
-    
-    // Render octave shift display
-    RenderOctaveDisplay();
-    
-    // Update display (caller should do this, but do it here for safety)
-    disp->Update();
+bool OctaveUI::IsDirty() const {
+    return title_label_.IsDirty() || value_label_.IsDirty() || position_bar_.IsDirty();
 }
 
-void OctaveUI::RenderOctaveDisplay() {
-    auto* disp = display_->GetDisplay();
-    if (!disp || !octave_shift_) return;
+void OctaveUI::UpdateView() {
+    if (!octave_shift_) return;
     
     int shift = octave_shift_->GetOctaveShift();
     
-    // Content area starts at y=10 (below system bar)
-    // Render "Octave" label and value in large font, centered in content area
-    
-    const char* label = "Octave";
-    int label_width = 6 * 6;  // Font_6x8, 6 chars * 6 pixels
-    int label_x = (128 - label_width) / 2;
-    
-    // Value display
+    // Value display (only reformatted when the shift changes)
     char value_text[8];
     if (shift == 0) {
         snprintf(value_text, sizeof(value_text), "0");
@@ -98,19 +94,27 @@ void OctaveUI::RenderOctaveDisplay() {
     } else {
         snprintf(value_text, sizeof(value_text), "%d", shift);
     }
+    value_label_.SetText(value_text);
+    
+    const float steps = static_cast<float>(OctaveShift::MAX_SHIFT - OctaveShift::MIN_SHIFT);
+    position_bar_.SetSpan((shift - OctaveShift::MIN_SHIFT) / steps, 1.0f / (steps + 1.0f), 3);
+}
+
+void OctaveUI::Render() {
+    if (!IsHealthy() || !is_active_) return;
     
-    // Render label (small font, offset below system bar)
-    disp->SetCursor(label_x, 20);
-    disp->WriteString(label, Font_6x8, true);
+    auto* disp = display_->GetDisplay();
+    if (!disp || !octave_shift_) return;
     
-    // Render value (large font, center in content area)
-    int value_width = (shift == 0 ? 1 : (shift > 0 ? 2 : 2)) * 11;  // Font_11x18 width
-    int value_x = (128 - value_width) / 2;
-    disp->SetCursor(value_x, 35);
-    disp->WriteString(value_text, Font_11x18, true);
+    // Note: Display should already be cleared and system bar rendered by caller
+    // We just render our content area (offset below system bar)
+    UpdateView();
+    title_label_.Draw(display_);
+    value_label_.Draw(display_);
+    position_bar_.Draw(display_);
     
-    // Note: disp->Update() is called in Render(), not here
+    // Update display (caller should do this, but do it here for safety)
+    disp->Update();
 }
 
 } // namespace OpenChord
-
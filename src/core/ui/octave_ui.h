@@ -2,6 +2,7 @@
 
 #include "../io/display_manager.h"
 #include "../midi/octave_shift.h"
+#include "widgets.h"
 #include <cstdint>
 
 namespace OpenChord {
@@ -11,6 +12,8 @@ namespace OpenChord {
  * 
  * Activated by joystick button click in normal play mode.
  * Shows current octave shift and allows adjustment with left/right joystick.
+ * The value and a position bar are retained widgets, redrawn only when the
+ * shift changes.
  */
 class OctaveUI {
 public:
@@ -31,6 +34,7 @@ public:
     
     // Render
     void Render();
+    bool IsDirty() const;
     
     // Health check
     bool IsHealthy() const { return display_ != nullptr && octave_shift_ != nullptr; }
@@ -43,7 +47,12 @@ private:
     static constexpr uint32_t AUTO_HIDE_TIMEOUT_MS = 2000;  // Hide after 2 seconds of no input
     uint32_t last_adjust_time_;
     
-    void RenderOctaveDisplay();
+    // Retained widgets
+    Label title_label_;
+    BigLabel value_label_;
+    Bar position_bar_;
+    
+    void UpdateView();
 };
 
 } // namespace OpenChord
@@ -11,6 +11,8 @@ SystemBar::SystemBar()
     , context_text_(nullptr)
     , battery_percentage_(100.0f)
     , battery_charging_(false)
+    , shown_battery_percent_(-1)
+    , shown_battery_charging_(false)
     , last_battery_update_(0)
 {
     track_name_override_[0] = '\0';
@@ -27,7 +29,13 @@ void SystemBar::Init(DisplayManager* display, IOManager* io_manager) {
     track_name_override_[0] = '\0';
     battery_percentage_ = 100.0f;
     battery_charging_ = false;
+    shown_battery_percent_ = -1;
+    shown_battery_charging_ = false;
     last_battery_update_ = 0;
+    
+    // Layout: Track name (left) | Battery (right), font is 6x8
+    name_label_.Init(0, 0, 128, &Font_6x8, Label::Align::LEFT);
+    battery_label_.Init(0, 0, 128, &Font_6x8, Label::Align::RIGHT);
 }
 
 void SystemBar::SetContext(const char* context) {
@@ -54,6 +62,12 @@ void SystemBar::Update() {
     
     // Update battery percentage periodically
     UpdateBattery();
+    UpdateBatteryText();
+    UpdateTrackName();
+}
+
+bool SystemBar::IsDirty() const {
+    return name_label_.IsDirty() || battery_label_.IsDirty();
 }
 
 void SystemBar::Render() {
@@ -63,19 +77,14 @@ void SystemBar::Render() {
     if (!disp) return;
     
     // System bar is top 8 pixels (1 line)
-    // Layout: Track name (left) | Battery (right)
-    
-    // Render track name (left side)
-    RenderTrackName();
-    
-    // Render battery (right side)
-    RenderBattery();
+    // Pick up context/name changes made since the last Update()
+    UpdateTrackName();
+    name_label_.Draw(display_);
+    battery_label_.Draw(display_);
     
     // Draw dividing line at bottom of system bar (at y=7, 1 pixel thick)
     // System bar is pixels 0-7, so line at y=7 is the bottom edge
-    for (int x = 0; x < 128; x++) {
-        disp->DrawPixel(x, 7, true);
-    }
+    display_->FillRect(0, 7, 127, 7, true);
 }
 
 void SystemBar::UpdateBattery() {
@@ -97,10 +106,20 @@ void SystemBar::UpdateBattery() {
     }
 }
 
-void SystemBar::RenderTrackName() {
-    auto* disp = display_->GetDisplay();
-    if (!disp) return;
-    
+void SystemBar::UpdateBatteryText() {
+    // Only format when the shown value changes
+    int percent = static_cast<int>(battery_percentage_ + 0.5f);
+    if (percent == shown_battery_percent_ && battery_charging_ == shown_battery_charging_) return;
+    shown_battery_percent_ = percent;
+    shown_battery_charging_ = battery_charging_;
+    
+    // Show charging indicator: "100%+" (plus sign indicates charging)
+    char battery_str[12];
+    snprintf(battery_str, sizeof(battery_str), battery_charging_ ? "%d%%+" : "%d%%", percent);
+    battery_label_.SetText(battery_str);
+}
+
+void SystemBar::UpdateTrackName() {
     const char* display_text = nullptr;
     
     // Priority order:
@@ -120,33 +139,8 @@ void SystemBar::RenderTrackName() {
         display_text = "No Track";
     }
     
-    // Render text on left side
-    disp->SetCursor(0, 0);
-    disp->WriteString(display_text, Font_6x8, true);
-}
-
-void SystemBar::RenderBattery() {
-    auto* disp = display_->GetDisplay();
-    if (!disp) return;
-    
-    // Render battery percentage on right side with charging indicator
-    char battery_str[12];
-    if (battery_charging_) {
-        // Show charging indicator: "100%+" (plus sign indicates charging)
-        snprintf(battery_str, sizeof(battery_str), "%.0f%%+", battery_percentage_);
-    } else {
-        snprintf(battery_str, sizeof(battery_str), "%.0f%%", battery_percentage_);
-    }
-    
-    // Right-align the battery text
-    // Font is 6x8, so each char is 6 pixels wide
-    // Screen is 128 pixels wide
-    int text_width = strlen(battery_str) * 6;
-    int x_pos = 128 - text_width;
-    if (x_pos < 0) x_pos = 0;
-    
-    disp->SetCursor(x_pos, 0);
-    disp->WriteString(battery_str, Font_6x8, true);
+    // Unchanged text leaves the label clean
+    name_label_.SetText(display_text);
 }
 
 } // namespace OpenChord
@@ -3,6 +3,7 @@
 #include "../io/display_manager.h"
 #include "../io/io_manager.h"
 #include "../tracks/track_interface.h"
+#include "widgets.h"
 #include <cstdint>
 
 namespace OpenChord {
@@ -14,6 +15,9 @@ namespace OpenChord {
  * - Left: Battery percentage (e.g., "85%")
  * - Center: Current track name/number (e.g., "Track 1")
  * - Right: Current context/mode indicator (e.g., "Menu", "Input", "DEBUG")
+ * 
+ * Text is kept in retained labels: Update() rebuilds a string only when the
+ * value behind it changes, and IsDirty() tells the UI Manager a redraw is needed.
  */
 class SystemBar {
 public:
@@ -26,6 +30,7 @@ public:
     // Update and render
     void Update();
     void Render();
+    bool IsDirty() const;
     
     // Set current context (overrides track name display, e.g., "Debug Mode", "Menu")
     void SetContext(const char* context);  // Set to nullptr to show track name again
@@ -47,13 +52,18 @@ private:
     // Cached values (updated periodically)
     float battery_percentage_;
     bool battery_charging_;
+    int shown_battery_percent_;  // Rounded value in battery_label_ (-1 = none yet)
+    bool shown_battery_charging_;
     uint32_t last_battery_update_;  // 0 = never updated, >0 = last update time/counter
     static constexpr uint32_t BATTERY_UPDATE_INTERVAL_MS = 1000;  // Update battery display every second
     
-    void RenderBattery();
-    void RenderTrackName();
-    void RenderContext();
+    // Retained widgets
+    Label name_label_;
+    Label battery_label_;
+    
     void UpdateBattery();
+    void UpdateBatteryText();
+    void UpdateTrackName();
 };
 
 } // namespace OpenChord
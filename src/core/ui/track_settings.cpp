@@ -17,6 +17,7 @@ TrackSettings::TrackSettings()
     : track_(nullptr)
     , key_root_value_(0)  // C
     , key_mode_value_(0)  // Ionian
+    , scale_lock_value_(false)
 {
     InitializeSettings();
 }
@@ -46,6 +47,18 @@ void TrackSettings::InitializeSettings() {
     settings_[1].enum_options = mode_names;
     settings_[1].enum_count = 7;
     settings_[1].on_change_callback = nullptr;
+    
+    // Setting 2: Scale Lock (keys and external MIDI play in the key's scale;
+    // Chords is left alone so joystick alterations sound as shown)
+    settings_[2].name = "Scale Lock";
+    settings_[2].type = SettingType::BOOL;
+    settings_[2].value_ptr = &scale_lock_value_;
+    settings_[2].min_value = 0.0f;
+    settings_[2].max_value = 1.0f;
+    settings_[2].step_size = 1.0f;
+    settings_[2].enum_options = nullptr;
+    settings_[2].enum_count = 0;
+    settings_[2].on_change_callback = nullptr;
 }
 
 int TrackSettings::GetSettingCount() const {
@@ -67,6 +80,8 @@ void TrackSettings::OnSettingChanged(int setting_index) {
     if (setting_index == 0 || setting_index == 1) {
         // Key root or mode changed - sync to track
         SyncToTrack();
+    } else if (setting_index == 2 && track_) {
+        track_->SetScaleLock(scale_lock_value_);
     }
 }
 
@@ -76,6 +91,7 @@ void TrackSettings::SyncFromTrack() const {
     MusicalKey key = track_->GetKey();
     key_root_value_ = key.root_note;
     key_mode_value_ = static_cast<int>(key.mode);
+    scale_lock_value_ = track_->IsScaleLocked();
 }
 
 void TrackSettings::SyncToTrack() {
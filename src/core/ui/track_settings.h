@@ -8,7 +8,7 @@ namespace OpenChord {
 class Track;
 
 /**
- * Track Settings - Track-level settings (key, BPM, etc.)
+ * Track Settings - Track-level settings (key, scale lock, etc.)
  * 
  * Implements IPluginWithSettings interface so it works with SettingsManager
  * This allows track settings to use the same UI system as plugin settings
@@ -32,9 +32,10 @@ private:
     // Settings values (helpers for UI) - mutable so they can be updated in const methods
     mutable int key_root_value_;  // 0-11 (C through B)
     mutable int key_mode_value_;  // 0-6 (Ionian through Locrian)
+    mutable bool scale_lock_value_;
     
     // Settings array
-    static constexpr int SETTING_COUNT = 2;  // Key Root, Mode
+    static constexpr int SETTING_COUNT = 3;  // Key Root, Mode, Scale Lock
     mutable PluginSetting settings_[SETTING_COUNT];
     
     // Initialize settings array
@@ -6,6 +6,7 @@
 #include "octave_ui.h"
 #include "../midi/octave_shift.h"
 #include "../io/power_manager.h"
+#include <cstring>
 #include <new>
 
 namespace OpenChord {
@@ -22,15 +23,24 @@ UIManager::UIManager()
     , octave_shift_(nullptr)
     , content_type_(ContentType::NONE)
     , main_ui_render_func_(nullptr)
+    , main_ui_dirty_func_(nullptr)
     , debug_render_func_(nullptr)
     , plugin_render_func_(nullptr)
     , current_track_(nullptr)
     , render_interval_ms_(100)  // 10 FPS default
     , last_render_time_(0)
+    , update_period_ms_(1)
     , needs_refresh_(true)
     , debug_mode_active_(false)
+    , skipped_frame_count_(0)
+    , render_stage_(RenderStage::IDLE)
+    , frame_content_type_(ContentType::NONE)
+    , render_clock_(nullptr)
+    , render_budget_us_(0)
     , power_mgr_(nullptr)
 {
+    std::memset(&render_stats_, 0, sizeof(render_stats_));
+    
     // Allocate UI components
         system_bar_ = new (std::nothrow) SystemBar();
         content_area_ = new (std::nothrow) ContentArea();
@@ -91,6 +101,7 @@ void UIManager::Init(DisplayManager* display, InputManager* input_manager, IOMan
     content_type_ = ContentType::NONE;
     current_track_ = nullptr;
     main_ui_render_func_ = nullptr;
+    main_ui_dirty_func_ = nullptr;
     debug_render_func_ = nullptr;
     plugin_render_func_ = nullptr;
     
@@ -121,6 +132,7 @@ void UIManager::SetContext(const char* context) {
 }
 
 void UIManager::SetContentType(ContentType type) {
+    if (type == content_type_) return;
     content_type_ = type;
     needs_refresh_ = true;
 }
@@ -129,6 +141,10 @@ void UIManager::SetMainUIRenderer(ContentRenderFunc render_func) {
     main_ui_render_func_ = render_func;
 }
 
+void UIManager::SetMainUIDirtyCheck(ContentDirtyFunc dirty_func) {
+    main_ui_dirty_func_ = dirty_func;
+}
+
 void UIManager::SetDebugRenderer(ContentRenderFunc render_func) {
     debug_render_func_ = render_func;
 }
@@ -157,6 +173,12 @@ bool UIManager::IsHealthy() const {
 void UIManager::Update() {
     if (!IsHealthy()) return;
     
+    // Finish the frame in progress before looking at new state
+    if (IsRenderInProgress()) {
+        ContinueRender();
+        return;
+    }
+    
         // Update system bar (battery, etc.)
     if (system_bar_) {
         system_bar_->Update();
@@ -221,58 +243,168 @@ void UIManager::Update() {
         render_interval_ms_ = power_mgr_->GetDisplayInterval();
     }
     
-    // Render periodically (UI Manager owns all rendering)
-    if (last_render_time_ >= render_interval_ms_ || needs_refresh_) {
-        Render();
-        last_render_time_ = 0;
-        needs_refresh_ = false;
-    } else {
-        last_render_time_++;
+    // Render when something changed, or periodically for screens that
+    // don't track changes (UI Manager owns all rendering)
+    bool periodic_due = IsPeriodicContent() && last_render_time_ >= render_interval_ms_;
+    if (needs_refresh_ || periodic_due || IsContentInvalid()) {
+        if (display_->IsTransferBusy()) {
+            // Previous frame is still going out - skip, retry next update instead of blocking
+            skipped_frame_count_++;
+        } else {
+            BeginRender();
+            ContinueRender();
+            last_render_time_ = 0;
+            needs_refresh_ = false;
+        }
+    } else if (last_render_time_ < render_interval_ms_) {
+        last_render_time_ += update_period_ms_;
+    }
+}
+
+bool UIManager::IsPeriodicContent() const {
+    switch (content_type_) {
+        case ContentType::MAIN_UI:
+            return main_ui_dirty_func_ == nullptr;
+        case ContentType::DEBUG:
+        case ContentType::SETTINGS:
+        case ContentType::PLUGIN_UI:
+            return true;
+        case ContentType::NONE:
+        case ContentType::MENU:
+        case ContentType::OCTAVE_UI:
+            return false;
+    }
+    return true;
+}
+
+bool UIManager::IsContentInvalid() {
+    if (system_bar_ && system_bar_->IsDirty()) return true;
+    
+    switch (content_type_) {
+        case ContentType::MAIN_UI:
+            return main_ui_dirty_func_ && main_ui_dirty_func_();
+        case ContentType::MENU:
+            if (!menu_manager_) return false;
+            menu_manager_->UpdateView();
+            return menu_manager_->IsDirty();
+        case ContentType::OCTAVE_UI:
+            return octave_ui_ && octave_ui_->IsDirty();
+        default:
+            return false;
     }
 }
 
 void UIManager::Render() {
     if (!IsHealthy()) return;
     
-    auto* disp = display_->GetDisplay();
-    if (!disp) return;
-    
-    // Clear entire display
-    disp->Fill(false);
-    
-    // Priority order: Octave UI > Debug Mode > Menu/Settings > Main UI
-    
-    // Octave UI takes priority - render it if active
-    if (content_type_ == ContentType::OCTAVE_UI && octave_ui_ && octave_ui_->IsActive()) {
-        RenderOctaveUI();
-        return;  // Octave UI handles its own display update
+    BeginRender();
+    while (IsRenderInProgress()) {
+        RenderStageNow(render_stage_);
+    }
+    render_stats_.frame_count++;
+}
+
+void UIManager::BeginRender() {
+    // Content is fixed for the whole frame, even if it changes between slices
+    frame_content_type_ = content_type_;
+    render_stage_ = RenderStage::CLEAR;
+    render_stats_.last_frame_slices = 0;
+}
+
+void UIManager::ContinueRender() {
+    if (!IsRenderInProgress()) return;
+    if (!IsHealthy()) {
+        render_stage_ = RenderStage::IDLE;
+        return;
     }
     
-    // Debug mode takes priority over menu/settings
-    if (content_type_ == ContentType::DEBUG) {
-        // Render debug content only (no menu overlay)
-        RenderContent();
-    } else {
-        // Render content area first
-        RenderContent();
+    // Run stages until the budget is used, always at least one
+    uint32_t slice_start = render_clock_ ? render_clock_() : 0;
+    do {
+        int stage_index = static_cast<int>(render_stage_);
+        uint32_t stage_start = render_clock_ ? render_clock_() : 0;
         
-        // Render menu or settings if active (only if not in debug mode)
-        if (menu_manager_ && menu_manager_->IsOpen()) {
-            if (settings_manager_ && settings_manager_->GetPlugin()) {
-                settings_manager_->Render();
-            } else {
-                menu_manager_->Render();
+        RenderStageNow(render_stage_);
+        
+        if (render_clock_) {
+            uint32_t stage_us = render_clock_() - stage_start;
+            if (stage_us > render_stats_.worst_stage_us[stage_index]) {
+                render_stats_.worst_stage_us[stage_index] = stage_us;
             }
         }
-    }
+    } while (IsRenderInProgress() &&
+             (render_budget_us_ == 0 || !render_clock_ ||
+              render_clock_() - slice_start < render_budget_us_));
     
-    // Render system bar on top (always visible)
-    if (system_bar_) {
-        system_bar_->Render();
+    if (render_clock_) {
+        uint32_t slice_us = render_clock_() - slice_start;
+        if (slice_us > render_stats_.worst_slice_us) {
+            render_stats_.worst_slice_us = slice_us;
+        }
+    }
+    render_stats_.slice_count++;
+    render_stats_.last_frame_slices++;
+    if (!IsRenderInProgress()) {
+        render_stats_.frame_count++;
+    }
+}
+
+void UIManager::RenderStageNow(RenderStage stage) {
+    auto* disp = display_->GetDisplay();
+    if (!disp) {
+        render_stage_ = RenderStage::IDLE;
+        return;
     }
     
-    // Update display (once at the end)
-    disp->Update();
+    // Priority order: Octave UI > Debug Mode > Menu/Settings > Main UI
+    switch (stage) {
+        case RenderStage::CLEAR:
+            // Clear entire display
+            disp->Fill(false);
+            render_stage_ = RenderStage::CONTENT;
+            break;
+            
+        case RenderStage::CONTENT:
+            // Octave UI takes priority - it draws the system bar and updates the display itself
+            if (frame_content_type_ == ContentType::OCTAVE_UI && octave_ui_ && octave_ui_->IsActive()) {
+                RenderOctaveUI();
+                render_stage_ = RenderStage::IDLE;
+                break;
+            }
+            RenderContent();
+            render_stage_ = RenderStage::OVERLAY;
+            break;
+            
+        case RenderStage::OVERLAY:
+            // Render menu or settings if active (only if not in debug mode)
+            if (frame_content_type_ != ContentType::DEBUG &&
+                menu_manager_ && menu_manager_->IsOpen()) {
+                if (settings_manager_ && settings_manager_->GetPlugin()) {
+                    settings_manager_->Render();
+                } else {
+                    menu_manager_->Render();
+                }
+            }
+            render_stage_ = RenderStage::SYSTEM_BAR;
+            break;
+            
+        case RenderStage::SYSTEM_BAR:
+            // Render system bar on top (always visible)
+            if (system_bar_) {
+                system_bar_->Render();
+            }
+            render_stage_ = RenderStage::SUBMIT;
+            break;
+            
+        case RenderStage::SUBMIT:
+            // Update display (once at the end)
+            disp->Update();
+            render_stage_ = RenderStage::IDLE;
+            break;
+            
+        case RenderStage::IDLE:
+            break;
+    }
 }
 
 void UIManager::RenderOctaveUI() {
@@ -321,8 +453,8 @@ bool UIManager::IsOctaveUIActive() const {
 
 void UIManager::UpdateOctaveUI(float joystick_x, uint32_t current_time_ms) {
     if (octave_ui_ && octave_ui_->IsActive()) {
+        // Redrawn when the shown value changes (see IsContentInvalid)
         octave_ui_->Update(joystick_x, current_time_ms);
-        needs_refresh_ = true;  // Request render after update
     }
 }
 
@@ -331,8 +463,10 @@ void UIManager::SetPowerManager(PowerManager* power_mgr) {
 }
 
 void UIManager::SetDebugMode(bool enabled) {
+    // Called every input pass - only a change forces a render
+    if (enabled == debug_mode_active_) return;
     debug_mode_active_ = enabled;
-    needs_refresh_ = true;  // Force immediate render update
+    needs_refresh_ = true;
     
     if (enabled) {
         // Close any open menus when entering debug mode
@@ -351,7 +485,7 @@ void UIManager::RenderContent() {
     // Route to appropriate content renderer based on content type
     ContentRenderFunc render_func = nullptr;
     
-    switch (content_type_) {
+    switch (frame_content_type_) {
         case ContentType::MAIN_UI:
             render_func = main_ui_render_func_;
             break;
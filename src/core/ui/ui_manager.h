@@ -21,6 +21,25 @@ class OctaveShift;
 // Content render callback type
 typedef void (*ContentRenderFunc)(DisplayManager* display);
 
+// Content dirty check - update retained widgets, return true if a redraw is needed
+typedef bool (*ContentDirtyFunc)();
+
+// Microsecond clock for render slice timing (daisy::System::GetUs on hardware)
+typedef uint32_t (*RenderClockFunc)();
+
+/**
+ * Render timing statistics (per slice = one Update()/ContinueRender() call)
+ */
+struct RenderStats {
+    static constexpr int STAGE_COUNT = 5;   // Clear, content, overlay, system bar, submit
+    
+    uint32_t frame_count;
+    uint32_t slice_count;
+    uint32_t last_frame_slices;
+    uint32_t worst_slice_us;
+    uint32_t worst_stage_us[STAGE_COUNT];
+};
+
 /**
  * UI Manager - Centralized UI coordinator
  * 
@@ -29,6 +48,17 @@ typedef void (*ContentRenderFunc)(DisplayManager* display);
  * - Content area (routed to active renderer)
  * 
  * Other components request to render content, UI Manager handles the actual display.
+ * 
+ * A frame is drawn in stages (clear, content, menu/settings overlay, system
+ * bar, submit). With a render budget set, each call runs stages only until
+ * the budget is used (at least one stage), and the rest continue on the next
+ * call, so one screen never holds the main loop for a whole frame.
+ * 
+ * Frames are drawn only when something is invalid: a refresh was requested
+ * (content switched, overlay opened) or a retained widget on screen changed
+ * (system bar, main UI, menu, octave overlay). An unchanged screen costs no
+ * drawing and no display traffic. Screens without retained widgets (debug,
+ * settings, plugin UIs) still redraw at the power-aware render interval.
  */
 class UIManager {
 public:
@@ -51,13 +81,27 @@ public:
     // Power management
     void SetPowerManager(PowerManager* power_mgr);
     
+    // How often Update() is called (ms) - render interval is counted in these steps
+    void SetUpdatePeriod(uint32_t period_ms) { update_period_ms_ = period_ms > 0 ? period_ms : 1; }
+    
     // Main update loop (call from main loop)
     // Updates state but doesn't render - use Render() separately
     void Update();
     
-    // Render the UI (call after Update() if rendering is needed)
+    // Render a whole frame now, ignoring the budget
     void Render();
     
+    // Time-sliced rendering: budget per call in microseconds (0 = whole frame per call)
+    void SetRenderClock(RenderClockFunc clock) { render_clock_ = clock; }
+    void SetRenderBudgetUs(uint32_t budget_us) { render_budget_us_ = budget_us; }
+    uint32_t GetRenderBudgetUs() const { return render_budget_us_; }
+    
+    // A frame is partly drawn - call ContinueRender() soon (e.g. next loop pass)
+    bool IsRenderInProgress() const { return render_stage_ != RenderStage::IDLE; }
+    void ContinueRender();
+    
+    const RenderStats& GetRenderStats() const { return render_stats_; }
+    
     // Render just the system bar (for overlays like octave UI)
     void RenderSystemBar();
     
@@ -75,6 +119,7 @@ public:
     
     // Register content renderers
     void SetMainUIRenderer(ContentRenderFunc render_func);
+    void SetMainUIDirtyCheck(ContentDirtyFunc dirty_func);  // Without one, main UI redraws periodically
     void SetDebugRenderer(ContentRenderFunc render_func);
     void SetPluginRenderer(ContentRenderFunc render_func);
     void ClearPluginRenderer();
@@ -96,6 +141,9 @@ public:
     // Health check
     bool IsHealthy() const;
     
+    // Renders skipped because the previous display transfer was still in flight
+    uint32_t GetSkippedFrameCount() const { return skipped_frame_count_; }
+    
 private:
     DisplayManager* display_;
     InputManager* input_manager_;
@@ -112,19 +160,41 @@ private:
     // Content management
     ContentType content_type_;
     ContentRenderFunc main_ui_render_func_;
+    ContentDirtyFunc main_ui_dirty_func_;
     ContentRenderFunc debug_render_func_;
     ContentRenderFunc plugin_render_func_;
     Track* current_track_;
     
     // Rendering state
     uint32_t render_interval_ms_;
-    uint32_t last_render_time_;
+    uint32_t last_render_time_;  // Elapsed ms since last render
+    uint32_t update_period_ms_;  // Time between Update() calls (1 = legacy 1 kHz loop)
     bool needs_refresh_;
     bool debug_mode_active_;  // Track if debug mode is active
+    uint32_t skipped_frame_count_;
+    
+    // Time-sliced rendering
+    enum class RenderStage {
+        CLEAR,
+        CONTENT,
+        OVERLAY,
+        SYSTEM_BAR,
+        SUBMIT,
+        IDLE        // No frame in progress
+    };
+    RenderStage render_stage_;
+    ContentType frame_content_type_;   // Content type when the frame started
+    RenderClockFunc render_clock_;
+    uint32_t render_budget_us_;
+    RenderStats render_stats_;
     PowerManager* power_mgr_;  // Power management for adaptive refresh
     
     void RenderContent();
     void RenderOctaveUI();
+    bool IsContentInvalid();
+    bool IsPeriodicContent() const;
+    void BeginRender();
+    void RenderStageNow(RenderStage stage);
 };
 
 } // namespace OpenChord
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include "widgets.h"
+#include <cstring>
+
+namespace OpenChord {
+
+void Widget::SetPosition(int x, int y) {
+    if (x == x_ && y == y_) return;
+    x_ = x;
+    y_ = y;
+    dirty_ = true;
+}
+
+void Widget::SetVisible(bool visible) {
+    if (visible == visible_) return;
+    visible_ = visible;
+    dirty_ = true;
+}
+
+void Widget::Draw(DisplayManager* display) {
+    if (display && visible_) {
+        DrawContent(display);
+    }
+    dirty_ = false;
+}
+
+Label::Label()
+    : font_(&Font_6x8)
+    , align_(Align::LEFT)
+    , width_(128)
+{
+    text_[0] = '\0';
+}
+
+void Label::Init(int x, int y, int width, const FontDef* font, Align align) {
+    SetPosition(x, y);
+    width_ = width;
+    font_ = font ? font : &Font_6x8;
+    align_ = align;
+    text_[0] = '\0';
+    Invalidate();
+}
+
+bool Label::SetText(const char* text) {
+    if (!text) text = "";
+    if (strncmp(text_, text, sizeof(text_) - 1) == 0) return false;
+
+    strncpy(text_, text, sizeof(text_) - 1);
+    text_[sizeof(text_) - 1] = '\0';
+    Invalidate();
+    return true;
+}
+
+void Label::DrawContent(DisplayManager* display) {
+    if (text_[0] == '\0') return;
+
+    int text_width = static_cast<int>(strlen(text_)) * font_->FontWidth;
+    int x = x_;
+    if (align_ == Align::CENTER) {
+        x = x_ + (width_ - text_width) / 2;
+    } else if (align_ == Align::RIGHT) {
+        x = x_ + width_ - text_width;
+    }
+    if (x < x_) x = x_;
+
+    display->DrawText(x, y_, text_, *font_, true);
+}
+
+void BigLabel::Init(int x, int y, int width) {
+    Label::Init(x, y, width, &Font_11x18, Align::CENTER);
+}
+
+Bar::Bar()
+    : length_(0)
+    , thickness_(1)
+    , orientation_(Orientation::HORIZONTAL)
+    , span_start_px_(0)
+    , span_length_px_(0)
+{
+}
+
+void Bar::Init(int x, int y, int length, int thickness, Orientation orientation) {
+    SetPosition(x, y);
+    length_ = length > 0 ? length : 1;
+    thickness_ = thickness > 0 ? thickness : 1;
+    orientation_ = orientation;
+    span_start_px_ = 0;
+    span_length_px_ = 0;
+    Invalidate();
+}
+
+bool Bar::SetSpan(float start, float length, int min_length_px) {
+    if (start < 0.0f) start = 0.0f;
+    if (start > 1.0f) start = 1.0f;
+    if (length < 0.0f) length = 0.0f;
+    if (length > 1.0f) length = 1.0f;
+
+    int length_px = static_cast<int>(length * length_);
+    if (length_px < min_length_px) length_px = min_length_px;
+    if (length_px > length_) length_px = length_;
+
+    // start positions the span within the track space it doesn't cover
+    int start_px = static_cast<int>(start * (length_ - length_px));
+
+    if (start_px == span_start_px_ && length_px == span_length_px_) return false;
+    span_start_px_ = start_px;
+    span_length_px_ = length_px;
+    Invalidate();
+    return true;
+}
+
+void Bar::DrawContent(DisplayManager* display) {
+    // Track end marks, then the span
+    int end = length_ - 1;
+    if (orientation_ == Orientation::HORIZONTAL) {
+        display->FillRect(x_, y_, x_, y_ + thickness_ - 1, true);
+        display->FillRect(x_ + end, y_, x_ + end, y_ + thickness_ - 1, true);
+        if (span_length_px_ > 0) {
+            display->FillRect(x_ + span_start_px_, y_,
+                              x_ + span_start_px_ + span_length_px_ - 1, y_ + thickness_ - 1, true);
+        }
+    } else {
+        display->FillRect(x_, y_, x_ + thickness_ - 1, y_, true);
+        display->FillRect(x_, y_ + end, x_ + thickness_ - 1, y_ + end, true);
+        if (span_length_px_ > 0) {
+            display->FillRect(x_, y_ + span_start_px_,
+                              x_ + thickness_ - 1, y_ + span_start_px_ + span_length_px_ - 1, true);
+        }
+    }
+}
+
+List::List()
+    : item_count_(0)
+    , selected_(0)
+    , first_visible_(0)
+    , visible_rows_(1)
+    , width_(128)
+    , height_(LINE_HEIGHT)
+{
+    memset(rows_, 0, sizeof(rows_));
+}
+
+void List::Init(int x, int y, int width, int height, int visible_rows) {
+    SetPosition(x, y);
+    width_ = width;
+    height_ = height;
+    visible_rows_ = visible_rows < 1 ? 1 : (visible_rows > MAX_ROWS ? MAX_ROWS : visible_rows);
+    item_count_ = 0;
+    selected_ = 0;
+    first_visible_ = 0;
+    memset(rows_, 0, sizeof(rows_));
+    scrollbar_.Init(x + width - SCROLLBAR_WIDTH, y, height, SCROLLBAR_WIDTH, Bar::Orientation::VERTICAL);
+    Invalidate();
+}
+
+bool List::SetItemCount(int count) {
+    if (count < 0) count = 0;
+    if (count == item_count_) return false;
+    item_count_ = count;
+    UpdateScroll();
+    Invalidate();
+    return true;
+}
+
+bool List::SetSelected(int index) {
+    if (index == selected_) return false;
+    selected_ = index;
+    UpdateScroll();
+    Invalidate();
+    return true;
+}
+
+bool List::SetItem(int index, const char* text) {
+    if (!IsRowVisible(index)) return false;
+    if (!text) text = "";
+
+    char clipped[MAX_ITEM_TEXT];
+    size_t len = strlen(text);
+    if (len >= MAX_ITEM_TEXT) {
+        memcpy(clipped, text, MAX_ITEM_TEXT - 4);
+        memcpy(&clipped[MAX_ITEM_TEXT - 4], "...", 4);
+    } else {
+        memcpy(clipped, text, len + 1);
+    }
+
+    char* row = rows_[index - first_visible_];
+    if (strcmp(row, clipped) == 0) return false;
+    memcpy(row, clipped, sizeof(clipped));
+    Invalidate();
+    return true;
+}
+
+void List::UpdateScroll() {
+    int first = selected_ >= visible_rows_ ? selected_ - visible_rows_ + 1 : 0;
+    if (first != first_visible_) {
+        // Rows now show other items - the caller sets them again
+        first_visible_ = first;
+        memset(rows_, 0, sizeof(rows_));
+    }
+
+    bool scrolls = item_count_ > visible_rows_;
+    scrollbar_.SetVisible(scrolls);
+    if (scrolls) {
+        float position = static_cast<float>(first_visible_) / (item_count_ - visible_rows_);
+        float size = static_cast<float>(visible_rows_) / item_count_;
+        scrollbar_.SetSpan(position, size, 4);
+    }
+}
+
+void List::DrawContent(DisplayManager* display) {
+    if (scrollbar_.IsVisible()) {
+        scrollbar_.Draw(display);
+    }
+
+    for (int row = 0; row < visible_rows_; row++) {
+        int index = first_visible_ + row;
+        if (index >= item_count_) break;
+
+        int x = display->DrawText(x_, y_ + row * LINE_HEIGHT, index == selected_ ? "> " : "  ",
+                                  Font_6x8, true);
+        display->DrawText(x, y_ + row * LINE_HEIGHT, rows_[row], Font_6x8, true);
+    }
+}
+
+} // namespace OpenChord
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "../io/display_manager.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace OpenChord {
+
+/**
+ * Widget - Retained UI element with a dirty flag
+ *
+ * Screens keep their widgets between frames and bind values to them with
+ * the Set*() calls, which only mark the widget dirty when what it shows
+ * actually changes. A screen is redrawn only while one of its widgets is
+ * dirty; Draw() clears the flag. Strings are built once per change, not
+ * once per frame. Drawing goes through DisplayManager's byte-wise text and
+ * rect calls.
+ */
+class Widget {
+public:
+    Widget() : x_(0), y_(0), visible_(true), dirty_(true) {}
+    virtual ~Widget() = default;
+
+    void SetPosition(int x, int y);
+    void SetVisible(bool visible);
+    bool IsVisible() const { return visible_; }
+
+    bool IsDirty() const { return dirty_; }
+    void Invalidate() { dirty_ = true; }
+
+    // Draw into the frame (display is already cleared) and mark clean
+    void Draw(DisplayManager* display);
+
+protected:
+    int x_;
+    int y_;
+
+    virtual void DrawContent(DisplayManager* display) = 0;
+
+private:
+    bool visible_;
+    bool dirty_;
+};
+
+/**
+ * Label - One line of text, left/center/right aligned within a width
+ */
+class Label : public Widget {
+public:
+    enum class Align { LEFT, CENTER, RIGHT };
+    static constexpr size_t MAX_TEXT = 32;
+
+    Label();
+
+    void Init(int x, int y, int width, const FontDef* font, Align align = Align::LEFT);
+
+    // Returns true if the text changed (nullptr = empty)
+    bool SetText(const char* text);
+    const char* GetText() const { return text_; }
+    bool IsEmpty() const { return text_[0] == '\0'; }
+
+protected:
+    void DrawContent(DisplayManager* display) override;
+
+private:
+    char text_[MAX_TEXT];
+    const FontDef* font_;
+    Align align_;
+    int width_;
+};
+
+/**
+ * Big Label - Centered Font_11x18 label for the main value on a screen
+ */
+class BigLabel : public Label {
+public:
+    static constexpr int FONT_HEIGHT = 18;
+
+    void Init(int x, int y, int width);
+};
+
+/**
+ * Bar - Filled span along a horizontal or vertical track
+ *
+ * SetSpan() takes start and length as fractions of the track; a level
+ * meter is SetSpan(0, level), a scrollbar or slider thumb is
+ * SetSpan(position, size). Values are snapped to pixels first, so changes
+ * smaller than a pixel don't cause a redraw. The track ends are marked.
+ */
+class Bar : public Widget {
+public:
+    enum class Orientation { HORIZONTAL, VERTICAL };
+
+    Bar();
+
+    // length along the track, thickness across it (pixels)
+    void Init(int x, int y, int length, int thickness, Orientation orientation);
+
+    // Returns true if the drawn span changed
+    bool SetSpan(float start, float length, int min_length_px = 1);
+
+protected:
+    void DrawContent(DisplayManager* display) override;
+
+private:
+    int length_;
+    int thickness_;
+    Orientation orientation_;
+    int span_start_px_;
+    int span_length_px_;
+};
+
+/**
+ * List - Scrolling Font_6x8 list with a selection marker and scrollbar
+ *
+ * Only the visible window is kept: set the count and selection first,
+ * then SetItem() the rows from GetFirstVisible() on (other indices are
+ * ignored), so items that are scrolled away are never formatted. Text is
+ * copied, so callers can build it in a temporary buffer. The window scrolls
+ * to keep the selection on its last row.
+ */
+class List : public Widget {
+public:
+    static constexpr int MAX_ROWS = 6;
+    static constexpr size_t MAX_ITEM_TEXT = 20;     // 19 columns after the marker + terminator
+    static constexpr int LINE_HEIGHT = 10;
+    static constexpr int SCROLLBAR_WIDTH = 2;
+
+    List();
+
+    // height is the scrollbar track; the last row may be clipped by the screen edge
+    void Init(int x, int y, int width, int height, int visible_rows);
+
+    // Each returns true if it changed what is shown. Long items end in "..."
+    bool SetItemCount(int count);
+    bool SetItem(int index, const char* text);
+    bool SetSelected(int index);
+
+    int GetItemCount() const { return item_count_; }
+    int GetSelected() const { return selected_; }
+    int GetFirstVisible() const { return first_visible_; }
+    int GetVisibleRows() const { return visible_rows_; }
+    bool IsRowVisible(int index) const {
+        return index >= first_visible_ && index < first_visible_ + visible_rows_ && index < item_count_;
+    }
+
+protected:
+    void DrawContent(DisplayManager* display) override;
+
+private:
+    char rows_[MAX_ROWS][MAX_ITEM_TEXT];       // Visible window only
+    int item_count_;
+    int selected_;
+    int first_visible_;
+    int visible_rows_;
+    int width_;
+    int height_;
+    Bar scrollbar_;
+
+    void UpdateScroll();
+};
+
+} // namespace OpenChord
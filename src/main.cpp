@@ -28,6 +28,7 @@
 #include "core/system_initializer.h"
 #include "core/button_controller.h"
 #include "core/midi_router.h"
+#include "core/task_scheduler.h"
 #include "plugins/input/chord_mapping_input.h"
 #include "plugins/input/piano_input.h"
 #include "plugins/input/drum_pad_input.h"
@@ -77,6 +78,25 @@ SplashScreen splash_screen;
 MainUI main_ui;
 UIManager ui_manager;
 
+// Controllers and routing (driven by scheduled tasks)
+ButtonController button_controller;
+MidiRouter midi_router;
+
+// Cooperative task scheduler (replaces the fixed-sequence main loop)
+TaskScheduler scheduler;
+int midi_task_id = TaskScheduler::INVALID_TASK;
+int input_task_id = TaskScheduler::INVALID_TASK;
+int adc_task_id = TaskScheduler::INVALID_TASK;
+int display_task_id = TaskScheduler::INVALID_TASK;
+
+// Task rates
+static constexpr uint32_t MIDI_TASK_PERIOD_US = 1000;     // 1 kHz
+static constexpr uint32_t INPUT_TASK_PERIOD_US = 1000;    // 1 kHz (key matrix debouncing)
+static constexpr uint32_t DISPLAY_TASK_PERIOD_MS = 50;    // 20 Hz
+static constexpr uint32_t POWER_TASK_PERIOD_MS = 10;      // 100 Hz
+static constexpr uint32_t UI_RENDER_BUDGET_US = 300;      // Render slice per loop pass
+static constexpr uint32_t HEARTBEAT_ON_MS = 20;
+
 #if DEBUG_SCREEN_ENABLED
 DebugScreen debug_screen;
 
@@ -98,14 +118,190 @@ void RenderAudioStatusWrapper(DisplayManager* display) {
 }
 
 void RenderMIDIStatusWrapper(DisplayManager* display) {
-    RenderMIDIStatus(display, &midi_handler);
+    RenderMIDIStatus(display, &midi_handler, &midi_router);
+}
+
+void RenderTaskStatusWrapper(DisplayManager* display) {
+    RenderTaskStatus(display, &scheduler);
 }
 #endif
 
 void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, size_t size) {
+    power_mgr.GetIdleMonitor()->NotifyWake(IdleMonitor::WAKE_AUDIO);
     audio_engine.ProcessAudio(in, out, size);
 }
 
+// MIDI: route and send at 1 kHz (input is already queued by the receive interrupts)
+void MidiTask() {
+    midi_router.RouteMIDI();
+    
+    // Print MIDI enabled status once after initialization (reduced logging for power)
+    static bool midi_enabled_printed = false;
+    static uint32_t init_counter = 0;
+    if (!midi_enabled_printed && ++init_counter > 100) {
+#if DEBUG_MODE
+        ExternalLog::PrintLine("MIDI Enabled: TRS=%s, USB=%s", 
+                    midi_handler.IsTrsInitialized() ? "YES" : "NO",
+                    midi_handler.IsUsbInitialized() ? "YES" : "NO");
+#endif
+        midi_enabled_printed = true;
+    }
+}
+
+// Input: keys, encoder, joystick, tracks and UI navigation at 1 kHz
+void InputTask() {
+    io_manager.UpdateDigital();
+    input_manager.Update();       // Update unified input manager (handles all inputs)
+    
+    // Check for user input activity (buttons, encoder, joystick)
+    if (input_manager.IsAnySystemButtonPressed() || 
+        input_manager.GetEncoder().GetDelta() != 0.0f ||
+        input_manager.GetJoystick().GetDeltaX() != 0.0f ||
+        input_manager.GetJoystick().GetDeltaY() != 0.0f) {
+        power_mgr.ReportUserInput();
+    }
+    
+    // Update system (updates all tracks)
+    openchord_system.Update();
+    
+    // Get joystick position and route to active track
+    JoystickInputHandler& joystick = input_manager.GetJoystick();
+    float joystick_x, joystick_y;
+    joystick.GetPosition(&joystick_x, &joystick_y);
+    openchord_system.HandleJoystick(joystick_x, joystick_y);
+    
+    // UI navigation is ignored while the splash screen is up
+    if (splash_screen.ShouldShow()) {
+        return;
+    }
+    
+#if DEBUG_SCREEN_ENABLED
+    // Update debug screen (handles toggle combo internally)
+    debug_screen.Update();
+    
+    // Check if we should show debug mode (takes priority over menu)
+    bool debug_enabled = debug_screen.IsEnabled();
+    ui_manager.SetDebugMode(debug_enabled);
+    
+    if (debug_enabled) {
+        ui_manager.SetContext("Debug Mode");
+        return;
+    }
+    ui_manager.SetContext(nullptr);  // Clear debug context
+#endif
+    
+    // Handle button controls (menu opening/closing, transport controls)
+    button_controller.Update();
+    
+    // Handle menu/settings navigation (centralized in MenuManager)
+    MenuManager* menu_mgr = ui_manager.GetMenuManager();
+    if (menu_mgr && menu_mgr->IsOpen()) {
+        uint32_t current_time = hw.system.GetNow();
+        menu_mgr->UpdateMenuInput(ui_manager.GetSettingsManager(), &io_manager, current_time);
+        
+        // Update context in system bar
+        ui_manager.SetContext(menu_mgr->GetContextName());
+    } else {
+        // Normal mode - handle octave UI (stick click)
+        static bool prev_joystick_button_normal = false;
+        bool joystick_button = false;
+        if (io_manager.GetDigital()) {
+            joystick_button = io_manager.GetDigital()->WasJoystickButtonPressed();
+        }
+        
+        if (joystick_button && !prev_joystick_button_normal) {
+            // Toggle octave UI via UI Manager (which manages its own state)
+            if (ui_manager.IsOctaveUIActive()) {
+                ui_manager.DeactivateOctaveUI();
+            } else {
+                ui_manager.ActivateOctaveUI();
+            }
+        }
+        prev_joystick_button_normal = joystick_button;
+        
+        // Update octave UI with joystick input
+        if (ui_manager.IsOctaveUIActive()) {
+            uint32_t current_time = hw.system.GetNow();
+            ui_manager.UpdateOctaveUI(joystick_x, current_time);
+        }
+        
+        // Octave overlay keeps its own content type until it hides
+        if (!ui_manager.IsOctaveUIActive()) {
+            ui_manager.SetContentType(UIManager::ContentType::MAIN_UI);
+        }
+        ui_manager.SetContext(nullptr);  // Normal mode - show track name
+    }
+}
+
+// ADC: volume, joystick, battery (rate follows PowerManager)
+void AdcTask() {
+    io_manager.UpdateAnalog();
+    volume_mgr.Update();          // Update volume manager to get latest ADC values
+    
+    if (volume_mgr.HasVolumeChanged()) {
+        volume_mgr.ClearChangeFlag();
+    }
+}
+
+// Display: splash screen or UI Manager at 20 Hz
+void DisplayTask() {
+    // A frame is being rendered in slices - draw the next slice, then come
+    // back on the next loop pass (after MIDI and input have had their turn)
+    if (ui_manager.IsRenderInProgress()) {
+        ui_manager.ContinueRender();
+        if (ui_manager.IsRenderInProgress()) {
+            scheduler.TriggerTask(display_task_id);
+        }
+        return;
+    }
+    
+    io_manager.UpdateServices();
+    
+    // Update splash screen
+    splash_screen.Update();
+    
+    // Show splash screen if it should be displayed
+    if (splash_screen.ShouldShow()) {
+        // Report activity during splash to prevent power optimization from interfering
+        power_mgr.ReportActivity();
+        splash_screen.Render();
+        return;
+    }
+    
+    // Update UI Manager (handles all state updates and rendering)
+    // UI Manager owns the display lifecycle and coordinates all rendering
+    // Its power-aware render interval is counted in display task periods
+    ui_manager.Update();
+    if (ui_manager.IsRenderInProgress()) {
+        scheduler.TriggerTask(display_task_id);
+    }
+}
+
+// Power: mode tracking, ADC rate and LED heartbeat
+void PowerTask() {
+    power_mgr.Update();
+    
+    // ADC rate follows the power mode
+    scheduler.SetTaskPeriod(adc_task_id, power_mgr.GetADCInterval() * 1000);
+    
+    // LED heartbeat - reduced frequency for power savings
+    // Non-blocking: LED is switched off by a later run instead of DelayMs
+    static uint32_t last_blink_ms = 0;
+    static bool led_on = false;
+    uint32_t now = hw.system.GetNow();
+    uint32_t heartbeat_interval = power_mgr.IsIdle() ? 5000 : 2000;  // 5s when idle, 2s when active
+    if (led_on) {
+        if (now - last_blink_ms >= HEARTBEAT_ON_MS) {
+            hw.SetLed(false);
+            led_on = false;
+        }
+    } else if (now - last_blink_ms >= heartbeat_interval) {
+        hw.SetLed(true);
+        led_on = true;
+        last_blink_ms = now;
+    }
+}
+
 int main(void) {
     // 1) Initialize hardware
     hw.Init();
@@ -148,6 +344,10 @@ int main(void) {
         ui_manager.SetMainUIRenderer([](DisplayManager* disp) {
             main_ui.Render(disp);
         });
+        ui_manager.SetMainUIDirtyCheck([]() -> bool {
+            main_ui.Update();
+            return main_ui.IsDirty();
+        });
         
         // Set octave UI check callback for chord plugin
         if (chord_plugin_ptr) {
@@ -164,6 +364,7 @@ int main(void) {
         debug_screen.AddView("Analog", RenderAnalogStatusWrapper);
         debug_screen.AddView("Audio", RenderAudioStatusWrapper);
         debug_screen.AddView("MIDI", RenderMIDIStatusWrapper);
+        debug_screen.AddView("Tasks", RenderTaskStatusWrapper);
         debug_screen.SetEnabled(false);  // Disabled by default, toggle with button combo
         
         // Register DebugScreen renderer with UI Manager
@@ -182,159 +383,45 @@ int main(void) {
     ExternalLog::PrintLine("System initialized OK");
     
     // 4) Initialize controllers
-    ButtonController button_controller;
-    MenuManager* menu_mgr = ui_manager.GetMenuManager();
-    SettingsManager* settings_mgr = ui_manager.GetSettingsManager();
-    button_controller.Init(&hw, &input_manager, menu_mgr, settings_mgr, 
+    button_controller.Init(&hw, &input_manager, ui_manager.GetMenuManager(), 
+                          ui_manager.GetSettingsManager(),
                           &transport_control, &ui_manager, &io_manager);
 #if DEBUG_SCREEN_ENABLED
     button_controller.SetDebugScreen(&debug_screen);
 #endif
     
-    MidiRouter midi_router;
     midi_router.Init(&openchord_system, &midi_handler, &octave_shift);
+    midi_router.SetGlobalSettings(&global_settings);
+    
+    // 5) Register tasks (lower priority number runs first when several are due)
+    // Power savings come from:
+    // 1. Reduced ADC sampling (10-100 Hz instead of 1 kHz when idle)
+    // 2. Reduced display refresh (1-20 Hz adaptive, power optimized)
+    // 3. Disabled mic ADC when not needed (disabled by default)
+    // 4. Disabled audio input processing by default (power savings)
+    // 5. Core sleeps (WFI) between tasks instead of spinning
+    scheduler.Init(daisy::System::GetUs);
+    midi_task_id = scheduler.AddTask("MIDI", MidiTask, MIDI_TASK_PERIOD_US, 0);
+    input_task_id = scheduler.AddTask("Input", InputTask, INPUT_TASK_PERIOD_US, 1);
+    adc_task_id = scheduler.AddTask("ADC", AdcTask, power_mgr.GetADCInterval() * 1000, 2);
+    display_task_id = scheduler.AddTask("Display", DisplayTask, DISPLAY_TASK_PERIOD_MS * 1000, 3);
+    scheduler.AddTask("Power", PowerTask, POWER_TASK_PERIOD_MS * 1000, 4);
+    ui_manager.SetUpdatePeriod(DISPLAY_TASK_PERIOD_MS);
+    ui_manager.SetRenderClock(daisy::System::GetUs);
+    ui_manager.SetRenderBudgetUs(UI_RENDER_BUDGET_US);
     
-    // 5) Main loop - Adaptive timing for power optimization
+    // 6) Main loop - run whatever is due, then sleep (WFI) until the next
+    // deadline. Received MIDI and new key edges end the sleep early and
+    // run their task right away instead of waiting for its next period.
     while(1) {
-        // Update power manager and get recommended loop delay
-        uint32_t loop_delay = power_mgr.Update();
-        
-        io_manager.Update();
-        input_manager.Update();       // Update unified input manager (handles all inputs)
-        
-        // Check for user input activity (buttons, encoder, joystick)
-        if (input_manager.IsAnySystemButtonPressed() || 
-            input_manager.GetEncoder().GetDelta() != 0.0f ||
-            input_manager.GetJoystick().GetDeltaX() != 0.0f ||
-            input_manager.GetJoystick().GetDeltaY() != 0.0f) {
-            power_mgr.ReportUserInput();
-        }
-        
-        volume_mgr.Update();          // Update volume manager to get latest ADC values
-        
-        // Update system (updates all tracks)
-        openchord_system.Update();
+        scheduler.RunPending();
         
-        // Get joystick position and route to active track
-        JoystickInputHandler& joystick = input_manager.GetJoystick();
-        float joystick_x, joystick_y;
-        joystick.GetPosition(&joystick_x, &joystick_y);
-        openchord_system.HandleJoystick(joystick_x, joystick_y);
-        
-        // Update splash screen
-        splash_screen.Update();
-        
-        // Show splash screen if it should be displayed
-        if (splash_screen.ShouldShow()) {
-            // Report activity during splash to prevent power optimization from interfering
-            power_mgr.ReportActivity();
-            splash_screen.Render();
-        } else {
-#if DEBUG_SCREEN_ENABLED
-            // Update debug screen (handles toggle combo internally)
-            debug_screen.Update();
-            
-            // Check if we should show debug mode (takes priority over menu)
-            bool debug_enabled = debug_screen.IsEnabled();
-            ui_manager.SetDebugMode(debug_enabled);
-            
-            if (debug_enabled) {
-                ui_manager.SetContext("Debug Mode");
-            } else {
-                ui_manager.SetContext(nullptr);  // Clear debug context
-            }
-            
-            if (!debug_enabled)
-#endif
-            {
-                // Handle button controls (menu opening/closing, transport controls)
-                button_controller.Update();
-                
-                // Handle menu/settings navigation (centralized in MenuManager)
-                if (menu_mgr && menu_mgr->IsOpen()) {
-                    uint32_t current_time = hw.system.GetNow();
-                    menu_mgr->UpdateMenuInput(settings_mgr, &io_manager, current_time);
-                    
-                    // Update context in system bar
-                    ui_manager.SetContext(menu_mgr->GetContextName());
-                } else {
-                    // Normal mode - handle octave UI (stick click)
-                    static bool prev_joystick_button_normal = false;
-                    bool joystick_button = false;
-                    if (io_manager.GetDigital()) {
-                        joystick_button = io_manager.GetDigital()->WasJoystickButtonPressed();
-                    }
-                    
-                    if (joystick_button && !prev_joystick_button_normal) {
-                        // Toggle octave UI via UI Manager (which manages its own state)
-                        if (ui_manager.IsOctaveUIActive()) {
-                            ui_manager.DeactivateOctaveUI();
-                        } else {
-                            ui_manager.ActivateOctaveUI();
-                        }
-                    }
-                    prev_joystick_button_normal = joystick_button;
-                    
-                    // Update octave UI with joystick input
-                    if (ui_manager.IsOctaveUIActive()) {
-                        float joystick_x, joystick_y;
-                        input_manager.GetJoystick().GetPosition(&joystick_x, &joystick_y);
-                        uint32_t current_time = hw.system.GetNow();
-                        ui_manager.UpdateOctaveUI(joystick_x, current_time);
-                    }
-                    
-                    ui_manager.SetContentType(UIManager::ContentType::MAIN_UI);
-                    ui_manager.SetContext(nullptr);  // Normal mode - show track name
-                }
-            }
-            
-            // Update UI Manager (handles all state updates and rendering)
-            // UI Manager owns the display lifecycle and coordinates all rendering
-            ui_manager.Update();
+        uint32_t work = power_mgr.Idle(scheduler.GetTimeUntilNextDue());
+        if (work & IdleMonitor::WakeBit(IdleMonitor::WAKE_MIDI_RX)) {
+            scheduler.TriggerTask(midi_task_id);
         }
-        
-        // Process incoming MIDI events at 1kHz for responsive timing
-        midi_handler.ProcessMidi();
-        
-        // Route MIDI using MidiRouter
-        midi_router.RouteMIDI();
-        
-        // Print MIDI enabled status once after initialization (reduced logging for power)
-        static bool midi_enabled_printed = false;
-        static uint32_t init_counter = 0;
-        if (!midi_enabled_printed && ++init_counter > 100) {
-#if DEBUG_MODE
-            ExternalLog::PrintLine("MIDI Enabled: TRS=%s, USB=%s", 
-                        midi_handler.IsTrsInitialized() ? "YES" : "NO",
-                        midi_handler.IsUsbInitialized() ? "YES" : "NO");
-#endif
-            midi_enabled_printed = true;
-        }
-        
-        // Report audio activity for power management
-        // (AudioEngine.IsNoteOn() always returns false now - TODO: query system/tracks for active notes)
-        // For now, we assume audio activity when system is running
-        
-        if (volume_mgr.HasVolumeChanged()) {
-            volume_mgr.ClearChangeFlag();
+        if (work & IdleMonitor::WakeBit(IdleMonitor::WAKE_KEY_SCAN)) {
+            scheduler.TriggerTask(input_task_id);
         }
-        
-        // LED heartbeat - reduced frequency for power savings
-        // Only blink when active, slower when idle
-        static uint32_t heartbeat = 0;
-        uint32_t heartbeat_interval = power_mgr.IsIdle() ? 5000 : 2000;  // 5s when idle, 2s when active
-        if (++heartbeat % heartbeat_interval == 0) {
-            hw.SetLed(true);   // Turn LED on
-            hw.DelayMs(20);    // Keep on for 20ms (reduced from 50ms)
-            hw.SetLed(false);  // Turn LED off
-        }
-        
-        // Adaptive timing - use power manager's recommended delay
-        // Power savings come from:
-        // 1. Reduced ADC sampling (10-100 Hz instead of 1 kHz when idle)
-        // 2. Reduced display refresh (1-20 Hz adaptive, power optimized)
-        // 3. Disabled mic ADC when not needed (disabled by default)
-        // 4. Disabled audio input processing by default (power savings)
-        hw.DelayMs(loop_delay);
     }
 }
@@ -0,0 +1,234 @@
+#include "arpeggiator_input.h"
+#include "../../core/tracks/track_interface.h"
+#include <cstring>
+
+namespace OpenChord {
+
+const char* ArpeggiatorInput::pattern_names_[] = {
+    "Up",
+    "Down",
+    "Up-Down",
+    "Random",
+    "Chord",
+    nullptr
+};
+
+const char* ArpeggiatorInput::rate_names_[] = {
+    "1/4",
+    "1/8",
+    "1/16",
+    "1/32",
+    nullptr
+};
+
+// 24 PPQN clocks per step for each rate
+const uint8_t ArpeggiatorInput::rate_ticks_[] = {24, 12, 6, 3};
+
+ArpeggiatorInput::ArpeggiatorInput()
+    : track_(nullptr)
+    , active_(false)
+    , was_active_(false)
+    , pattern_setting_value_(0)
+    , rate_setting_value_(2)      // 1/16
+    , gate_setting_value_(50)
+    , density_setting_value_(0)
+{
+    InitializeSettings();
+}
+
+ArpeggiatorInput::~ArpeggiatorInput() {
+}
+
+void ArpeggiatorInput::Init() {
+    ApplySettings();
+}
+
+void ArpeggiatorInput::Process(const float* const* in, float* const* out, size_t size) {
+    // This plugin doesn't process audio directly
+    (void)in;
+    (void)out;
+    (void)size;
+}
+
+void ArpeggiatorInput::Update() {
+    // Steps are generated in the audio callback (ProcessStackOutput)
+}
+
+void ArpeggiatorInput::UpdateUI() {
+    // UI updates handled by main UI system
+}
+
+void ArpeggiatorInput::HandleEncoder(int encoder, float delta) {
+    (void)encoder;
+    (void)delta;
+}
+
+void ArpeggiatorInput::HandleButton(int button, bool pressed) {
+    (void)button;
+    (void)pressed;
+}
+
+void ArpeggiatorInput::HandleJoystick(float x, float y) {
+    (void)x;
+    (void)y;
+}
+
+void ArpeggiatorInput::SaveState(void* buffer, size_t* size) const {
+    if (!buffer || !size) return;
+
+    SavedState state;
+    state.active = active_;
+    state.pattern = pattern_setting_value_;
+    state.rate_index = rate_setting_value_;
+    state.gate = gate_setting_value_;
+    state.max_notes_per_second = density_setting_value_;
+    std::memcpy(buffer, &state, sizeof(state));
+    *size = sizeof(state);
+}
+
+void ArpeggiatorInput::LoadState(const void* buffer, size_t size) {
+    if (!buffer || size < sizeof(SavedState)) return;
+
+    SavedState state;
+    std::memcpy(&state, buffer, sizeof(state));
+    pattern_setting_value_ = state.pattern;
+    rate_setting_value_ = state.rate_index;
+    gate_setting_value_ = state.gate;
+    density_setting_value_ = state.max_notes_per_second;
+    ApplySettings();
+    SetActive(state.active);
+}
+
+size_t ArpeggiatorInput::GetStateSize() const {
+    return sizeof(SavedState);
+}
+
+bool ArpeggiatorInput::IsActive() const {
+    // Still processed after being turned off until its notes are released
+    return active_ || was_active_ || arpeggiator_.HasSoundingNotes();
+}
+
+void ArpeggiatorInput::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) {
+    // Works on the stack's output (ProcessStackOutput)
+    (void)events;
+    (void)max_events;
+    *count = 0;
+}
+
+void ArpeggiatorInput::ProcessMIDI(const MidiEvent* events, size_t count) {
+    (void)events;
+    (void)count;
+}
+
+void ArpeggiatorInput::ProcessStackOutput(MidiEvent* events, size_t* count, size_t max_events) {
+    if (!track_) return;
+
+    const TrackContext& context = track_->GetContext();
+    if (!active_) {
+        if (was_active_) {
+            arpeggiator_.ClearHeld();
+            was_active_ = false;
+        }
+        arpeggiator_.Release(context.block_start_sample, events, count, max_events);
+        return;
+    }
+    was_active_ = true;
+
+    // Take the notes out of the block; the arpeggio plays them instead.
+    // Note-offs for notes that started before the arp was on still go through.
+    size_t kept = 0;
+    for (size_t i = 0; i < *count; i++) {
+        const MidiEvent& event = events[i];
+        if (event.type == MidiEvent::NOTE_ON && event.data2 > 0) {
+            arpeggiator_.NoteOn(event.data1, event.data2, event.channel);
+        } else if ((event.type == MidiEvent::NOTE_OFF || event.type == MidiEvent::NOTE_ON) &&
+                   arpeggiator_.NoteOff(event.data1)) {
+            continue;
+        } else {
+            events[kept++] = event;
+        }
+    }
+    *count = kept;
+
+    arpeggiator_.ProcessBlock(context.position, context.bpm, context.block_start_sample, context.block_size,
+                              events, count, max_events);
+}
+
+void ArpeggiatorInput::InitializeSettings() {
+    // Setting 0: Pattern
+    settings_[0].name = "Pattern";
+    settings_[0].type = SettingType::ENUM;
+    settings_[0].value_ptr = &pattern_setting_value_;
+    settings_[0].min_value = 0.0f;
+    settings_[0].max_value = static_cast<float>(static_cast<int>(Arpeggiator::Pattern::COUNT) - 1);
+    settings_[0].step_size = 1.0f;
+    settings_[0].enum_options = pattern_names_;
+    settings_[0].enum_count = static_cast<int>(Arpeggiator::Pattern::COUNT);
+    settings_[0].on_change_callback = nullptr;
+
+    // Setting 1: Rate (step length)
+    settings_[1].name = "Rate";
+    settings_[1].type = SettingType::ENUM;
+    settings_[1].value_ptr = &rate_setting_value_;
+    settings_[1].min_value = 0.0f;
+    settings_[1].max_value = 3.0f;
+    settings_[1].step_size = 1.0f;
+    settings_[1].enum_options = rate_names_;
+    settings_[1].enum_count = 4;
+    settings_[1].on_change_callback = nullptr;
+
+    // Setting 2: Gate (percent of the step)
+    settings_[2].name = "Gate";
+    settings_[2].type = SettingType::INT;
+    settings_[2].value_ptr = &gate_setting_value_;
+    settings_[2].min_value = 5.0f;
+    settings_[2].max_value = 100.0f;
+    settings_[2].step_size = 5.0f;
+    settings_[2].enum_options = nullptr;
+    settings_[2].enum_count = 0;
+    settings_[2].on_change_callback = nullptr;
+
+    // Setting 3: Note density limit (notes per second, 0 = off)
+    settings_[3].name = "Max Notes/s";
+    settings_[3].type = SettingType::INT;
+    settings_[3].value_ptr = &density_setting_value_;
+    settings_[3].min_value = 0.0f;
+    settings_[3].max_value = 100.0f;
+    settings_[3].step_size = 5.0f;
+    settings_[3].enum_options = nullptr;
+    settings_[3].enum_count = 0;
+    settings_[3].on_change_callback = nullptr;
+}
+
+int ArpeggiatorInput::GetSettingCount() const {
+    return SETTING_COUNT;
+}
+
+const PluginSetting* ArpeggiatorInput::GetSetting(int index) const {
+    if (index < 0 || index >= SETTING_COUNT) {
+        return nullptr;
+    }
+    return &settings_[index];
+}
+
+void ArpeggiatorInput::OnSettingChanged(int setting_index) {
+    (void)setting_index;
+    ApplySettings();
+}
+
+void ArpeggiatorInput::ApplySettings() {
+    if (pattern_setting_value_ < 0 || pattern_setting_value_ >= static_cast<int>(Arpeggiator::Pattern::COUNT)) {
+        pattern_setting_value_ = 0;
+    }
+    if (rate_setting_value_ < 0 || rate_setting_value_ > 3) rate_setting_value_ = 2;
+    if (gate_setting_value_ < 5) gate_setting_value_ = 5;
+    if (gate_setting_value_ > 100) gate_setting_value_ = 100;
+    if (density_setting_value_ < 0) density_setting_value_ = 0;
+
+    arpeggiator_.SetPattern(static_cast<Arpeggiator::Pattern>(pattern_setting_value_));
+    arpeggiator_.SetTicksPerStep(rate_ticks_[rate_setting_value_]);
+    arpeggiator_.SetGate(static_cast<uint8_t>(gate_setting_value_));
+    arpeggiator_.SetMaxNotesPerSecond(static_cast<float>(density_setting_value_));
+}
+
+} // namespace OpenChord
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../../core/plugin_interface.h"
+#include "../../core/midi/midi_types.h"
+#include "../../core/music/arpeggiator.h"
+#include "../../core/ui/plugin_settings.h"
+
+namespace OpenChord {
+
+// Forward declaration
+class Track;
+
+/**
+ * Arpeggiator Input Plugin ("Arp")
+ *
+ * Stack stage that takes the note-ons/offs every input above it generated
+ * for the block (chords, keys, external MIDI) out of the stack's output and
+ * plays the held notes as an Arpeggiator pattern instead, timed from the
+ * transport in the audio callback. Other events (bends, CCs) pass through.
+ * Sits before the sequencer and the looper, so loops record the arpeggio.
+ *
+ * Off by default; turning it off releases its notes and forgets what was held.
+ */
+class ArpeggiatorInput : public IInputPlugin, public IPluginWithSettings {
+public:
+    ArpeggiatorInput();
+    ~ArpeggiatorInput();
+
+    // IPlugin interface
+    void Init() override;
+    void Process(const float* const* in, float* const* out, size_t size) override;
+    void Update() override;
+    void UpdateUI() override;
+    void HandleEncoder(int encoder, float delta) override;
+    void HandleButton(int button, bool pressed) override;
+    void HandleJoystick(float x, float y) override;
+
+    const char* GetName() const override { return "Arp"; }
+    const char* GetCategory() const override { return "Input"; }
+    int GetVersion() const override { return 1; }
+
+    void SaveState(void* buffer, size_t* size) const override;
+    void LoadState(const void* buffer, size_t size) override;
+    size_t GetStateSize() const override;
+
+    // IInputPlugin interface
+    void GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) override;
+    void ProcessMIDI(const MidiEvent* events, size_t count) override;
+    void ProcessStackOutput(MidiEvent* events, size_t* count, size_t max_events) override;
+    bool IsActive() const override;
+    void SetActive(bool active) override { active_ = active; }
+    int GetPriority() const override { return 45; }  // After the performance inputs, before the sequencer
+
+    // IPluginWithSettings interface
+    int GetSettingCount() const override;
+    const PluginSetting* GetSetting(int index) const override;
+    void OnSettingChanged(int setting_index) override;
+
+    // Setup - must be called before Init()
+    void SetTrack(Track* track) { track_ = track; }
+    void SetSampleRate(float sample_rate) { arpeggiator_.SetSampleRate(sample_rate); }
+
+    const Arpeggiator& GetArpeggiator() const { return arpeggiator_; }
+
+private:
+    struct SavedState {
+        bool active;
+        int pattern;
+        int rate_index;
+        int gate;
+        int max_notes_per_second;
+    };
+
+    Track* track_;
+    bool active_;
+    bool was_active_;       // Audio callback: to clear held notes once turned off
+    Arpeggiator arpeggiator_;
+
+    // Settings support
+    static constexpr int SETTING_COUNT = 4;
+    int pattern_setting_value_;
+    int rate_setting_value_;
+    int gate_setting_value_;
+    int density_setting_value_;       // Max notes per second, 0 = no limit
+    PluginSetting settings_[SETTING_COUNT];
+    static const char* pattern_names_[];
+    static const char* rate_names_[];
+    static const uint8_t rate_ticks_[];
+
+    void InitializeSettings();
+    void ApplySettings();
+};
+
+} // namespace OpenChord
@@ -37,6 +37,7 @@ public:
     bool IsActive() const override { return active_; }
     void SetActive(bool active) override { active_ = active; }
     int GetPriority() const override { return 100; }  // High priority for external MIDI
+    bool FollowsScaleLock() const override { return true; }
 
 private:
     bool active_;
@@ -7,6 +7,12 @@
 
 namespace OpenChord {
 
+const char* ChordMappingInput::voicing_names_[] = {
+    "Fixed",
+    "Voice Lead",
+    nullptr
+};
+
 ChordMappingInput::ChordMappingInput()
     : input_manager_(nullptr)
     , track_(nullptr)
@@ -16,22 +22,28 @@ ChordMappingInput::ChordMappingInput()
     , chord_active_(false)
     , current_joystick_preset_index_(0)
     , current_joystick_preset_(nullptr)
+    , held_count_(0)
     , joystick_x_(0.0f)
     , joystick_y_(0.0f)
     , current_joystick_direction_(JoystickDirection::CENTER)
-    , prev_joystick_direction_(JoystickDirection::CENTER)
+    , voicing_setting_value_(VOICING_FIXED)
     , pending_read_pos_(0)
     , pending_write_pos_(0)
 {
-    std::memset(prev_button_states_, false, sizeof(prev_button_states_));
+    std::memset(held_keys_, 0, sizeof(held_keys_));
+    std::memset(sounding_, 0, sizeof(sounding_));
     pending_events_.resize(128);  // Buffer for MIDI events
     current_chord_.note_count = 0;
+    voicing_anchor_.note_count = 0;
     
     // Initialize settings
     InitializeSettings();
 }
 
 ChordMappingInput::~ChordMappingInput() {
+    if (initialized_ && input_manager_) {
+        input_manager_->GetEventStream().Unsubscribe(OnInputEvent, this);
+    }
 }
 
 void ChordMappingInput::Init() {
@@ -49,14 +61,17 @@ void ChordMappingInput::Init() {
     // Reset state
     chord_active_ = false;
     current_chord_.note_count = 0;
+    voicing_anchor_.note_count = 0;
     joystick_x_ = 0.0f;
     joystick_y_ = 0.0f;
     current_joystick_direction_ = JoystickDirection::CENTER;
-    prev_joystick_direction_ = JoystickDirection::CENTER;
-    std::memset(prev_button_states_, false, sizeof(prev_button_states_));
+    held_count_ = 0;
+    std::memset(sounding_, 0, sizeof(sounding_));
     
     pending_read_pos_ = 0;
     pending_write_pos_ = 0;
+    
+    input_manager_->GetEventStream().Subscribe(OnInputEvent, this);
 }
 
 void ChordMappingInput::Process(const float* const* in, float* const* out, size_t size) {
@@ -70,11 +85,11 @@ void ChordMappingInput::Process(const float* const* in, float* const* out, size_
 void ChordMappingInput::Update() {
     if (!initialized_ || !active_ || !input_manager_) return;
     
-    // Process button state changes
-    ProcessButtons();
-    
-    // Process joystick to update chord variations
-    ProcessJoystick();
+    // Buttons and joystick arrive as events (OnInputEvent). Only the octave
+    // UI takeover is polled: it owns the joystick while open.
+    if (octave_ui_check_func_ && octave_ui_check_func_()) {
+        current_joystick_direction_ = JoystickDirection::CENTER;
+    }
 }
 
 void ChordMappingInput::UpdateUI() {
@@ -87,12 +102,12 @@ void ChordMappingInput::HandleEncoder(int encoder, float delta) {
 }
 
 void ChordMappingInput::HandleButton(int button, bool pressed) {
-    // Buttons are processed via ProcessButtons() which polls state directly
+    // Musical buttons arrive via the input event stream (OnInputEvent)
     // This method could be used for system buttons if needed
 }
 
 void ChordMappingInput::HandleJoystick(float x, float y) {
-    // Joystick is processed via ProcessJoystick() which polls state directly
+    // Direction changes arrive via the input event stream (OnInputEvent)
     // This method receives joystick values from Track system
     joystick_x_ = x;
     joystick_y_ = y;
@@ -101,16 +116,18 @@ void ChordMappingInput::HandleJoystick(float x, float y) {
 void ChordMappingInput::SaveState(void* buffer, size_t* size) const {
     if (!buffer || !size) return;
     
-    // Save state: active flag and preset index
+    // Save state: active flag, preset index and voicing
     // Note: key is now stored in track, not in plugin state
     struct State {
         bool active;
         int preset_index;
+        int voicing;
     };
     
     State state;
     state.active = active_;
     state.preset_index = current_joystick_preset_index_;
+    state.voicing = voicing_setting_value_;
     
     std::memcpy(buffer, &state, sizeof(State));
     *size = sizeof(State);
@@ -122,39 +139,56 @@ void ChordMappingInput::LoadState(const void* buffer, size_t size) {
     struct State {
         bool active;
         int preset_index;
+        int voicing;
     };
     
-    struct LegacyState {
+    struct PresetState {
         bool active;
-        MusicalKey key;
         int preset_index;
     };
     
     if (size >= sizeof(State)) {
         const State* state = reinterpret_cast<const State*>(buffer);
-        active_ = state->active;
+        SetActive(state->active);
         SetJoystickPreset(state->preset_index);
-    } else if (size >= sizeof(LegacyState)) {
-        // Legacy format: load old state but key is now in track
-        const LegacyState* state = reinterpret_cast<const LegacyState*>(buffer);
-        active_ = state->active;
+        voicing_setting_value_ = (state->voicing >= 0 && state->voicing < VOICING_COUNT)
+                               ? state->voicing : VOICING_FIXED;
+    } else if (size >= sizeof(PresetState)) {
+        // Before the voicing setting: fixed voicing
+        const PresetState* state = reinterpret_cast<const PresetState*>(buffer);
+        SetActive(state->active);
         SetJoystickPreset(state->preset_index);
-        // Key is now stored in track, not here
+        voicing_setting_value_ = VOICING_FIXED;
     } else {
         // Very old format: just active flag
-        active_ = *reinterpret_cast<const bool*>(buffer);
+        SetActive(*reinterpret_cast<const bool*>(buffer));
         SetJoystickPreset(0);
     }
 }
 
 size_t ChordMappingInput::GetStateSize() const {
-    return sizeof(bool) + sizeof(int);  // active, preset_index (key removed - now track-level)
+    return sizeof(bool) + 2 * sizeof(int);  // active, preset_index, voicing (key removed - now track-level)
+}
+
+bool ChordMappingInput::IsActive() const {
+    // Still polled after being turned off until its note-offs are out
+    return active_ || pending_read_pos_ != pending_write_pos_;
+}
+
+void ChordMappingInput::SetActive(bool active) {
+    // Turning off releases whatever is sounding; held keys stay tracked
+    if (!active && active_) {
+        chord_active_ = false;
+        current_chord_.note_count = 0;
+        SendChordTransition();
+    }
+    active_ = active;
 }
 
 void ChordMappingInput::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) {
     *count = 0;
     
-    if (!active_ || !initialized_) return;
+    if (!initialized_) return;
     
     // Read from pending events buffer
     while (*count < max_events && pending_read_pos_ != pending_write_pos_) {
@@ -169,234 +203,128 @@ void ChordMappingInput::ProcessMIDI(const MidiEvent* events, size_t count) {
     // Could be enhanced to transform incoming MIDI if needed
 }
 
-void ChordMappingInput::ProcessButtons() {
-    if (!input_manager_) return;
-    
-    ButtonInputHandler& buttons = input_manager_->GetButtons();
-    
-    // Track which buttons are currently pressed
-    bool currently_pressed[7] = {false};
-    int pressed_count = 0;
-    int first_pressed = -1;
-    
-    // First pass: determine current button states
-    for (int i = 0; i < 7; i++) {
-        MusicalButton btn = ButtonIndexToMusicalButton(i);
-        bool current_pressed = buttons.IsMusicalButtonPressed(btn);
-        currently_pressed[i] = current_pressed;
-        
-        if (current_pressed) {
-            pressed_count++;
-            if (first_pressed < 0) {
-                first_pressed = i;
-            }
-        }
-    }
-    
-    // Second pass: handle button state changes
-    for (int i = 0; i < 7; i++) {
-        bool current_pressed = currently_pressed[i];
-        bool prev_pressed = prev_button_states_[i];
-        
-        // Detect button press
-        if (!prev_pressed && current_pressed) {
-            // Button just pressed
-            // Send NOTE_OFF for all currently active notes (if switching buttons)
-            if (chord_active_ && current_chord_.note_count > 0) {
-                for (uint8_t n = 0; n < current_chord_.note_count; n++) {
-                    MidiEvent event;
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF);
-                    event.channel = 0;
-                    event.data1 = current_chord_.notes[n];
-                    event.data2 = 0;
-                    event.timestamp = 0;
-                    
-                    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                    if (next_write != pending_read_pos_) {
-                        pending_events_[pending_write_pos_] = event;
-                        pending_write_pos_ = next_write;
-                    }
-                }
-            }
-            
-            // Generate new chord for the pressed button
-            UpdateChord(i);
-            chord_active_ = true;
-            
-            // Generate NOTE_ON events for all notes in new chord
-            if (current_chord_.note_count > 0) {
-                for (uint8_t n = 0; n < current_chord_.note_count; n++) {
-                    MidiEvent event;
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_ON);
-                    event.channel = 0;
-                    event.data1 = current_chord_.notes[n];
-                    event.data2 = 100;  // Velocity
-                    event.timestamp = 0;
-                    
-                    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                    if (next_write != pending_read_pos_) {
-                        pending_events_[pending_write_pos_] = event;
-                        pending_write_pos_ = next_write;
-                    }
-                }
-            }
+void ChordMappingInput::OnInputEvent(const InputEvent& event, void* context) {
+    ChordMappingInput* self = static_cast<ChordMappingInput*>(context);
+    if (!self || !self->initialized_) return;
+    
+    if (event.IsMusicalKey() && event.type != InputEventType::KEY_HELD) {
+        bool pressed = event.type == InputEventType::KEY_DOWN;
+        // Track held keys even while inactive so activation sees real state
+        if (pressed) {
+            self->AddHeldKey(event.id);
+        } else {
+            self->RemoveHeldKey(event.id);
         }
+        if (!self->active_) return;
         
-        // Detect button release
-        if (prev_pressed && !current_pressed) {
-            // Button just released
-            // If this was the active button, send NOTE_OFF for all notes
-            if (chord_active_ && current_chord_.note_count > 0) {
-                for (uint8_t n = 0; n < current_chord_.note_count; n++) {
-                    MidiEvent event;
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF);
-                    event.channel = 0;
-                    event.data1 = current_chord_.notes[n];
-                    event.data2 = 0;
-                    event.timestamp = 0;
-                    
-                    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                    if (next_write != pending_read_pos_) {
-                        pending_events_[pending_write_pos_] = event;
-                        pending_write_pos_ = next_write;
-                    }
-                }
-            }
-            
-            // Check if any buttons are still pressed
-            bool any_pressed = false;
-            int new_first_pressed = -1;
-            for (int j = 0; j < 7; j++) {
-                if (currently_pressed[j]) {
-                    any_pressed = true;
-                    if (new_first_pressed < 0) {
-                        new_first_pressed = j;
-                    }
-                }
-            }
-            
-            if (any_pressed && new_first_pressed >= 0) {
-                // Another button is still pressed - switch to that button's chord
-                UpdateChord(new_first_pressed);
-                chord_active_ = true;
-                
-                // Generate NOTE_ON events for the new chord
-                if (current_chord_.note_count > 0) {
-                    for (uint8_t n = 0; n < current_chord_.note_count; n++) {
-                        MidiEvent event;
-                        event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_ON);
-                        event.channel = 0;
-                        event.data1 = current_chord_.notes[n];
-                        event.data2 = 100;
-                        event.timestamp = 0;
-                        
-                        size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                        if (next_write != pending_read_pos_) {
-                            pending_events_[pending_write_pos_] = event;
-                            pending_write_pos_ = next_write;
-                        }
-                    }
-                }
-            } else {
-                // No buttons pressed - clear chord
-                chord_active_ = false;
-                current_chord_.note_count = 0;
-            }
+        if (pressed) {
+            self->HandleKeyDown(event.id);
+        } else {
+            self->HandleKeyUp(event.id);
         }
-        
-        prev_button_states_[i] = current_pressed;
+    } else if (event.type == InputEventType::JOYSTICK_DIRECTION) {
+        if (!self->active_) return;
+        self->HandleJoystickDirection(static_cast<JoystickDirection>(event.id));
     }
 }
 
-void ChordMappingInput::ProcessJoystick() {
-    if (!input_manager_) return;
-    
-    // Don't process joystick if octave UI is active (joystick is used for octave adjustment)
+void ChordMappingInput::HandleKeyDown(int button_index) {
+    // Switching buttons moves from the previous chord to this one
+    UpdateChord(button_index);
+    chord_active_ = true;
+    SendChordTransition();
+}
+
+void ChordMappingInput::HandleKeyUp(int button_index) {
+    (void)button_index;
+    
+    // Other buttons still pressed - back to the chord of the latest of them
+    int still_held = GetLatestHeldKey();
+    if (still_held >= 0) {
+        UpdateChord(still_held);
+        chord_active_ = true;
+    } else {
+        chord_active_ = false;
+        current_chord_.note_count = 0;
+    }
+    SendChordTransition();
+}
+
+void ChordMappingInput::HandleJoystickDirection(JoystickDirection direction) {
+    // Joystick is used for octave adjustment while the octave UI is open
     if (octave_ui_check_func_ && octave_ui_check_func_()) {
-        // Reset to center position when octave UI takes over
         current_joystick_direction_ = JoystickDirection::CENTER;
-        prev_joystick_direction_ = JoystickDirection::CENTER;
         return;
     }
     
-    // Get joystick position
-    JoystickInputHandler& joystick = input_manager_->GetJoystick();
-    float x, y;
-    joystick.GetPosition(&x, &y);
+    // Update direction first so UpdateChord uses it (CENTER = base chord)
+    current_joystick_direction_ = direction;
     
-    // Store for later use
-    joystick_x_ = x;
-    joystick_y_ = y;
-    
-    // Determine joystick direction
-    JoystickDirection new_direction = GetJoystickDirectionFromXY(x, y);
+    int held = GetLatestHeldKey();
+    if (held < 0) return;
     
-    // Update current direction immediately so UpdateChord can use it
-    JoystickDirection old_direction = current_joystick_direction_;
-    current_joystick_direction_ = new_direction;
-    
-    // Check if direction changed (including to/from CENTER)
-    bool direction_changed = (new_direction != prev_joystick_direction_);
-    
-    // If direction changed AND a button is pressed, update chord
-    if (direction_changed) {
-        bool any_button_pressed = false;
-        int pressed_button_index = -1;
-        
-        for (int i = 0; i < 7; i++) {
-            MusicalButton btn = ButtonIndexToMusicalButton(i);
-            if (input_manager_->GetButtons().IsMusicalButtonPressed(btn)) {
-                any_button_pressed = true;
-                pressed_button_index = i;
-                break;
-            }
+    UpdateChord(held);
+    SendChordTransition();
+}
+
+void ChordMappingInput::AddHeldKey(int button_index) {
+    // A repeated press moves the key to the top
+    RemoveHeldKey(button_index);
+    if (held_count_ < 7) {
+        held_keys_[held_count_++] = static_cast<uint8_t>(button_index);
+    }
+}
+
+void ChordMappingInput::RemoveHeldKey(int button_index) {
+    for (uint8_t i = 0; i < held_count_; i++) {
+        if (held_keys_[i] == button_index) {
+            std::memmove(&held_keys_[i], &held_keys_[i + 1], held_count_ - i - 1);
+            held_count_--;
+            return;
         }
-        
-        if (any_button_pressed && pressed_button_index >= 0) {
-            // Turn off old chord notes
-            if (current_chord_.note_count > 0) {
-                for (uint8_t n = 0; n < current_chord_.note_count; n++) {
-                    MidiEvent event;
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF);
-                    event.channel = 0;
-                    event.data1 = current_chord_.notes[n];
-                    event.data2 = 0;
-                    event.timestamp = 0;
-                    
-                    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                    if (next_write != pending_read_pos_) {
-                        pending_events_[pending_write_pos_] = event;
-                        pending_write_pos_ = next_write;
-                    }
-                }
-            }
-            
-            // Generate new chord with joystick variation (or base chord if CENTER)
-            // current_joystick_direction_ is already updated above, so UpdateChord will use the correct direction
-            UpdateChord(pressed_button_index);
-            
-            // Turn on new chord notes
-            if (current_chord_.note_count > 0) {
-                for (uint8_t n = 0; n < current_chord_.note_count; n++) {
-                    MidiEvent event;
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_ON);
-                    event.channel = 0;
-                    event.data1 = current_chord_.notes[n];
-                    event.data2 = 100;
-                    event.timestamp = 0;
-                    
-                    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                    if (next_write != pending_read_pos_) {
-                        pending_events_[pending_write_pos_] = event;
-                        pending_write_pos_ = next_write;
-                    }
-                }
-            }
+    }
+}
+
+int ChordMappingInput::GetLatestHeldKey() const {
+    return held_count_ > 0 ? held_keys_[held_count_ - 1] : -1;
+}
+
+void ChordMappingInput::SendChordTransition() {
+    // Notes the chord should have sounding now (none once released)
+    uint32_t target[4] = {0, 0, 0, 0};
+    if (chord_active_) {
+        for (uint8_t n = 0; n < current_chord_.note_count; n++) {
+            uint8_t note = current_chord_.notes[n] & 0x7F;
+            target[note >> 5] |= 1u << (note & 31);
         }
     }
     
-    // Update previous direction for next iteration
-    prev_joystick_direction_ = new_direction;
+    // Departing notes first, so a synth short of voices has them back for the arrivals
+    for (int w = 0; w < 4; w++) {
+        uint32_t departing = sounding_[w] & ~target[w];
+        while (departing) {
+            uint8_t note = static_cast<uint8_t>(w * 32 + __builtin_ctz(departing));
+            departing &= departing - 1;
+            QueueEvent(MidiEvent(MidiEvent::NOTE_OFF, 0, note, 0));
+        }
+    }
+    for (int w = 0; w < 4; w++) {
+        uint32_t arriving = target[w] & ~sounding_[w];
+        while (arriving) {
+            uint8_t note = static_cast<uint8_t>(w * 32 + __builtin_ctz(arriving));
+            arriving &= arriving - 1;
+            QueueEvent(MidiEvent(MidiEvent::NOTE_ON, 0, note, 100));
+        }
+        sounding_[w] = target[w];
+    }
+}
+
+void ChordMappingInput::QueueEvent(const MidiEvent& event) {
+    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
+    if (next_write != pending_read_pos_) {
+        pending_events_[pending_write_pos_] = event;
+        pending_write_pos_ = next_write;
+    }
 }
 
 void ChordMappingInput::UpdateChord(int button_index) {
@@ -406,115 +334,40 @@ void ChordMappingInput::UpdateChord(int button_index) {
     // Physical order (left-to-right): 0, 4, 1, 5, 2, 6, 3 → Scale degrees: I, II, III, IV, V, VI, VII
     int scale_degree = chord_engine_.PhysicalButtonToScaleDegree(button_index);
     
-    // Get MIDI note for this scale degree in the current key/mode
-    MusicalKey key = GetCurrentKey();
-    uint8_t root_midi_note;
-    chord_engine_.GetButtonMapping(key, button_index, &root_midi_note);
-    
-    // Get base chord quality for this scale degree in the current mode
-    ChordQuality base_quality = chord_engine_.GetChordQualityForDegree(key.mode, scale_degree);
-    
-    // Apply joystick variation if joystick is not centered
-    ChordQuality final_quality = base_quality;
-    if (current_joystick_direction_ != JoystickDirection::CENTER) {
-        final_quality = chord_engine_.ApplyJoystickVariation(
-            base_quality, 
-            static_cast<int>(current_joystick_direction_), 
-            current_joystick_preset_index_
-        );
+    // From the engine's table for the current key, with the joystick
+    // variation applied (CENTER = diatonic chord): root position, or the
+    // voicing nearest the last chord played
+    const int direction = static_cast<int>(current_joystick_direction_);
+    if (voicing_setting_value_ == VOICING_LEAD) {
+        chord_engine_.GetVoiceLedChord(scale_degree, direction, current_joystick_preset_index_,
+                                       voicing_anchor_, &current_chord_);
+    } else {
+        current_chord_ = chord_engine_.GetKeyChord(scale_degree, direction, current_joystick_preset_index_,
+                                                   ChordInversion::ROOT);
     }
-    
-    // Generate chord (always root position for now, could add inversion later)
-    chord_engine_.GenerateChord(
-        &current_chord_, 
-        root_midi_note, 
-        final_quality, 
-        ChordInversion::ROOT
-    );
+    voicing_anchor_ = current_chord_;
     
     // Note: Octave shift is applied in main.cpp to all MIDI events before sending
 }
 
-JoystickDirection ChordMappingInput::GetJoystickDirectionFromXY(float x, float y) const {
-    // User says joystick output is -0.5 to 0.5 range (normalized -1.0 to 1.0)
-    // Left and down are negative, right and up are positive
-    // Cardinal directions: >= 0.48 or <= -0.48
-    // Diagonals: both axes >= 0.24 or <= -0.24
-    const float cardinal_threshold = 0.48f;    // For UP, DOWN, LEFT, RIGHT
-    const float diagonal_threshold = 0.24f;    // For diagonals (both axes need to meet this)
-    const float dead_zone = 0.1f;              // Below this = CENTER
-    
-    float abs_x = std::abs(x);
-    float abs_y = std::abs(y);
-    float distance = std::sqrt(x * x + y * y);
-    
-    // Dead zone check first
-    if (distance < dead_zone) {
-        return JoystickDirection::CENTER;
-    }
-    
-    // Determine if this is more diagonal or cardinal by comparing axis magnitudes
-    // If both axes are significant (within ~30% of each other), treat as diagonal
-    float axis_ratio = (abs_x > abs_y) ? (abs_y / abs_x) : (abs_x / abs_y);
-    bool is_diagonal = (axis_ratio > 0.6f) && (abs_x >= diagonal_threshold) && (abs_y >= diagonal_threshold);
-    
-    // Check for diagonal directions if both axes are significant
-    if (is_diagonal) {
-        // Both axes meet diagonal threshold and are balanced - determine which diagonal
-        // x > 0 = right, y > 0 = up, x < 0 = left, y < 0 = down
-        if (x > 0 && y > 0) return JoystickDirection::UP_RIGHT;      // Northeast (right + up)
-        if (x > 0 && y < 0) return JoystickDirection::DOWN_RIGHT;    // Southeast (right + down)
-        if (x < 0 && y > 0) return JoystickDirection::UP_LEFT;       // Northwest (left + up)
-        if (x < 0 && y < 0) return JoystickDirection::DOWN_LEFT;     // Southwest (left + down)
-    }
-    
-    // Check cardinal directions (one axis dominates and meets threshold)
-    // Vertical dominates
-    if (abs_y >= cardinal_threshold && abs_y >= abs_x) {
-        if (y > 0) return JoystickDirection::UP;      // Up (positive Y)
-        else return JoystickDirection::DOWN;          // Down (negative Y)
-    }
-    
-    // Horizontal dominates
-    if (abs_x >= cardinal_threshold && abs_x >= abs_y) {
-        if (x > 0) return JoystickDirection::RIGHT;   // Right (positive X)
-        else return JoystickDirection::LEFT;          // Left (negative X)
-    }
-    
-    // If we get here, below thresholds but not in dead zone - return CENTER
-    return JoystickDirection::CENTER;
-}
-
-MusicalButton ChordMappingInput::ButtonIndexToMusicalButton(int index) const {
-    if (index < 0 || index >= 7) {
-        return MusicalButton::WHITE_0;
-    }
-    
-    static const MusicalButton mapping[] = {
-        MusicalButton::WHITE_0,  // 0 = F
-        MusicalButton::WHITE_1,  // 1 = G
-        MusicalButton::WHITE_2,  // 2 = A
-        MusicalButton::WHITE_3,  // 3 = B
-        MusicalButton::BLACK_0,  // 4 = F#
-        MusicalButton::BLACK_1,  // 5 = G#
-        MusicalButton::BLACK_2   // 6 = A#
-    };
-    
-    return mapping[index];
-}
-
 void ChordMappingInput::SetKey(MusicalKey key) {
+    // The track notifies its plugins (OnKeyChanged), this one included
     if (track_) {
         track_->SetKey(key);
+    } else {
+        OnKeyChanged(key);
     }
+}
+
+void ChordMappingInput::OnKeyChanged(const MusicalKey& key) {
+    chord_engine_.SetKey(key);
     
     // If chord is active, regenerate it with new key
     if (chord_active_) {
-        for (int i = 0; i < 7; i++) {
-            if (prev_button_states_[i]) {
-                UpdateChord(i);
-                break;
-            }
+        int held = GetLatestHeldKey();
+        if (held >= 0) {
+            UpdateChord(held);
+            SendChordTransition();
         }
     }
 }
@@ -539,11 +392,10 @@ void ChordMappingInput::SetJoystickPreset(int preset_index) {
     
     // If chord is active, regenerate it with new preset
     if (chord_active_ && current_joystick_direction_ != JoystickDirection::CENTER) {
-        for (int i = 0; i < 7; i++) {
-            if (prev_button_states_[i]) {
-                UpdateChord(i);
-                break;
-            }
+        int held = GetLatestHeldKey();
+        if (held >= 0) {
+            UpdateChord(held);
+            SendChordTransition();
         }
     }
 }
@@ -561,6 +413,17 @@ void ChordMappingInput::InitializeSettings() {
     settings_[0].enum_options = nullptr;
     settings_[0].enum_count = 0;
     settings_[0].on_change_callback = nullptr;
+    
+    // Setting 1: Voicing (fixed root position or voice leading)
+    settings_[1].name = "Voicing";
+    settings_[1].type = SettingType::ENUM;
+    settings_[1].value_ptr = &voicing_setting_value_;
+    settings_[1].min_value = 0.0f;
+    settings_[1].max_value = static_cast<float>(VOICING_COUNT - 1);
+    settings_[1].step_size = 1.0f;
+    settings_[1].enum_options = voicing_names_;
+    settings_[1].enum_count = VOICING_COUNT;
+    settings_[1].on_change_callback = nullptr;
 }
 
 int ChordMappingInput::GetSettingCount() const {
@@ -586,6 +449,11 @@ void ChordMappingInput::OnSettingChanged(int setting_index) {
             // Preset index changed, update preset
             SetJoystickPreset(current_joystick_preset_index_);
             break;
+        case 1:  // Voicing changed - takes effect from the next chord
+            if (voicing_setting_value_ < 0 || voicing_setting_value_ >= VOICING_COUNT) {
+                voicing_setting_value_ = VOICING_FIXED;
+            }
+            break;
     }
 }
 
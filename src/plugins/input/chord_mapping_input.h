@@ -5,6 +5,7 @@
 #include "../../core/music/chord_engine.h"
 #include "../../core/io/button_input_handler.h"
 #include "../../core/io/joystick_input_handler.h"  // For JoystickDirection enum
+#include "../../core/io/input_event_stream.h"
 #include "../../core/ui/plugin_settings.h"
 #include <vector>
 
@@ -20,8 +21,17 @@ namespace OpenChord {
  * Chord Mapping Input Plugin
  * 
  * Maps button presses (1-7) to chords and uses joystick to modify
- * chord inversions and extensions. Generates MIDI events for all
- * notes in the chord.
+ * chord inversions and extensions. Driven by KEY_DOWN / KEY_UP /
+ * JOYSTICK_DIRECTION events from the InputManager event stream.
+ *
+ * Chord changes are sent as a difference against the notes already
+ * sounding: departing notes get a note-off, arriving notes a note-on, and
+ * common tones keep sounding, so joystick morphs and button changes are
+ * legato and cost only the notes that actually change.
+ *
+ * In the Voice Lead voicing, each new chord takes the inversion and octave
+ * (from ChordEngine's key table) that moves least from the last chord
+ * played, so progressions stay in one place on the keyboard.
  */
 class ChordMappingInput : public IInputPlugin, public IPluginWithSettings {
 public:
@@ -49,9 +59,13 @@ public:
     // IInputPlugin interface
     void GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) override;
     void ProcessMIDI(const MidiEvent* events, size_t count) override;
-    bool IsActive() const override { return active_; }
-    void SetActive(bool active) override { active_ = active; }
+    bool IsActive() const override;
+    void SetActive(bool active) override;
     int GetPriority() const override { return 30; }  // Medium priority (after Piano, before Drum Pad)
+    void OnKeyChanged(const MusicalKey& key) override;
+    // Button chords are built in the key already; the joystick's out-of-key
+    // chords are deliberate, and the display names them as played
+    bool FollowsScaleLock() const override { return false; }
     
     // Setup - must be called before Init()
     void SetInputManager(InputManager* input_manager) {
@@ -78,6 +92,9 @@ public:
     // Joystick preset management
     void SetJoystickPreset(int preset_index);
     int GetCurrentJoystickPreset() const { return current_joystick_preset_index_; }
+    const JoystickPreset* GetCurrentJoystickPresetInfo() const {
+        return chord_engine_.GetJoystickPreset(current_joystick_preset_index_);
+    }
     
     // Get current joystick direction
     JoystickDirection GetCurrentJoystickDirection() const { return current_joystick_direction_; }
@@ -103,22 +120,34 @@ private:
     // Current chord state
     Chord current_chord_;
     bool chord_active_;
+    uint32_t sounding_[4];  // Notes we have on, one bit per MIDI note
+    Chord voicing_anchor_;  // Last voicing played: the next chord leads from it
     
     // Preset (key is stored in track)
     int current_joystick_preset_index_;
     const JoystickPreset* current_joystick_preset_;
     
-    // Button state tracking
-    bool prev_button_states_[7];  // One for each musical button
+    // Musical keys currently down, oldest press first (from KEY_DOWN / KEY_UP
+    // events): releasing the newest falls back to the one pressed before it
+    uint8_t held_keys_[7];
+    uint8_t held_count_;
     
     // Joystick state
     float joystick_x_;
     float joystick_y_;
     JoystickDirection current_joystick_direction_;
-    JoystickDirection prev_joystick_direction_;
+    
+    // Voicing: root position as built, or voice-led from the last chord
+    enum Voicing {
+        VOICING_FIXED = 0,
+        VOICING_LEAD,
+        VOICING_COUNT
+    };
+    int voicing_setting_value_;
+    static const char* voicing_names_[];
     
     // Settings support
-    static constexpr int SETTING_COUNT = 1;  // Preset only (key removed - now track-level)
+    static constexpr int SETTING_COUNT = 2;  // Preset, voicing (key removed - now track-level)
     mutable PluginSetting settings_[SETTING_COUNT];
     void InitializeSettings();
     
@@ -127,14 +156,19 @@ private:
     size_t pending_read_pos_;
     size_t pending_write_pos_;
     
+    // Input event handling
+    static void OnInputEvent(const InputEvent& event, void* context);
+    void HandleKeyDown(int button_index);
+    void HandleKeyUp(int button_index);
+    void HandleJoystickDirection(JoystickDirection direction);
+    void AddHeldKey(int button_index);
+    void RemoveHeldKey(int button_index);
+    int GetLatestHeldKey() const;
+    
     // Helper methods
-    void ProcessButtons();
-    void ProcessJoystick();
     void UpdateChord(int button_index);
-    JoystickDirection GetJoystickDirectionFromXY(float x, float y) const;
-    
-    // Convert button index (0-6) to MusicalButton enum
-    MusicalButton ButtonIndexToMusicalButton(int index) const;
+    void SendChordTransition();
+    void QueueEvent(const MidiEvent& event);
 };
 
 } // namespace OpenChord
@@ -12,12 +12,14 @@ DrumPadInput::DrumPadInput()
     , pending_read_pos_(0)
     , pending_write_pos_(0)
 {
-    std::memset(prev_button_states_, false, sizeof(prev_button_states_));
     std::memset(current_button_states_, false, sizeof(current_button_states_));
     pending_events_.resize(128);
 }
 
 DrumPadInput::~DrumPadInput() {
+    if (initialized_ && input_manager_) {
+        input_manager_->GetEventStream().Unsubscribe(OnInputEvent, this);
+    }
 }
 
 void DrumPadInput::Init() {
@@ -25,10 +27,11 @@ void DrumPadInput::Init() {
     
     active_ = false;  // Start inactive
     initialized_ = true;
-    std::memset(prev_button_states_, false, sizeof(prev_button_states_));
     std::memset(current_button_states_, false, sizeof(current_button_states_));
     pending_read_pos_ = 0;
     pending_write_pos_ = 0;
+    
+    input_manager_->GetEventStream().Subscribe(OnInputEvent, this);
 }
 
 void DrumPadInput::Process(const float* const* in, float* const* out, size_t size) {
@@ -40,10 +43,7 @@ void DrumPadInput::Process(const float* const* in, float* const* out, size_t siz
 }
 
 void DrumPadInput::Update() {
-    if (!initialized_ || !active_ || !input_manager_) return;
-    
-    // Process button state changes
-    ProcessButtons();
+    // Pads are handled as events (OnInputEvent) - nothing to poll
 }
 
 void DrumPadInput::UpdateUI() {
@@ -56,7 +56,7 @@ void DrumPadInput::HandleEncoder(int encoder, float delta) {
 }
 
 void DrumPadInput::HandleButton(int button, bool pressed) {
-    // Buttons are processed via ProcessButtons() which polls state directly
+    // Musical buttons arrive via the input event stream (OnInputEvent)
     // This method could be used for system buttons if needed
 }
 
@@ -101,54 +101,29 @@ void DrumPadInput::ProcessMIDI(const MidiEvent* events, size_t count) {
     // Could be enhanced to transform incoming MIDI if needed
 }
 
-void DrumPadInput::ProcessButtons() {
-    if (!input_manager_) return;
+void DrumPadInput::OnInputEvent(const InputEvent& event, void* context) {
+    DrumPadInput* self = static_cast<DrumPadInput*>(context);
+    if (!self || !self->initialized_) return;
+    if (!event.IsMusicalKey() || event.type == InputEventType::KEY_HELD) return;
     
-    ButtonInputHandler& buttons = input_manager_->GetButtons();
+    self->HandleKey(event.id, event.type == InputEventType::KEY_DOWN);
+}
+
+void DrumPadInput::HandleKey(int button_index, bool pressed) {
+    current_button_states_[button_index] = pressed;
+    if (!active_) return;
     
-    for (int i = 0; i < 7; i++) {
-        MusicalButton button = static_cast<MusicalButton>(i);
-        bool current_pressed = buttons.IsMusicalButtonPressed(button);
-        bool prev_pressed = prev_button_states_[i];
-        
-        // Update current state
-        current_button_states_[i] = current_pressed;
-        
-        if (current_pressed != prev_pressed) {
-            uint8_t drum_note = GetDrumNote(i);
-            
-            if (current_pressed && !prev_pressed) {
-                // Button pressed: send NOTE_ON on drum channel
-                size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                if (next_write != pending_read_pos_) {
-                    MidiEvent& event = pending_events_[pending_write_pos_];
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_ON);
-                    event.channel = DRUM_CHANNEL;  // Channel 10 (0-based = 9) for drums
-                    event.data1 = drum_note;
-                    event.data2 = 100;  // Default velocity (can be enhanced with velocity sensitivity)
-                    event.timestamp = 0;
-                    
-                    pending_write_pos_ = next_write;
-                }
-            } else if (!current_pressed && prev_pressed) {
-                // Button released: send NOTE_OFF on drum channel
-                // Note: Some drum sounds are one-shot and don't need NOTE_OFF,
-                // but we send it for completeness and compatibility
-                size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
-                if (next_write != pending_read_pos_) {
-                    MidiEvent& event = pending_events_[pending_write_pos_];
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF);
-                    event.channel = DRUM_CHANNEL;  // Channel 10 (0-based = 9) for drums
-                    event.data1 = drum_note;
-                    event.data2 = 0;
-                    event.timestamp = 0;
-                    
-                    pending_write_pos_ = next_write;
-                }
-            }
-            
-            prev_button_states_[i] = current_pressed;
-        }
+    // NOTE_ON on press, NOTE_OFF on release. Some drum sounds are one-shot and
+    // don't need NOTE_OFF, but we send it for completeness and compatibility
+    MidiEvent event(pressed ? MidiEvent::NOTE_ON : MidiEvent::NOTE_OFF,
+                    DRUM_CHANNEL,  // Channel 10 (0-based = 9) for drums
+                    GetDrumNote(button_index),
+                    pressed ? 100 : 0);  // Default velocity (can be enhanced with velocity sensitivity)
+    
+    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
+    if (next_write != pending_read_pos_) {
+        pending_events_[pending_write_pos_] = event;
+        pending_write_pos_ = next_write;
     }
 }
 
@@ -3,6 +3,7 @@
 #include "../../core/plugin_interface.h"
 #include "../../core/midi/midi_types.h"
 #include "../../core/io/button_input_handler.h"
+#include "../../core/io/input_event_stream.h"
 #include <vector>
 
 namespace OpenChord {
@@ -25,6 +26,8 @@ class InputManager;
  * - Button 4 (Black0): Crash Cymbal (C#1 = MIDI 37)
  * - Button 5 (Black1): Ride Cymbal (D#1 = MIDI 39)
  * - Button 6 (Black2): Tom (F#1 = MIDI 41)
+ *
+ * Pads are driven by KEY_DOWN / KEY_UP events from the InputManager event stream.
  */
 class DrumPadInput : public IInputPlugin {
 public:
@@ -69,8 +72,7 @@ private:
     bool active_;
     bool initialized_;
     
-    // Button state tracking
-    bool prev_button_states_[7];
+    // Button state tracking (from KEY_DOWN / KEY_UP events)
     bool current_button_states_[7];
     
     // MIDI event buffer
@@ -81,7 +83,8 @@ private:
     // Drum pad mapping
     static constexpr uint8_t DRUM_CHANNEL = 9;  // MIDI channel 10 (0-based = 9)
     
-    void ProcessButtons();
+    static void OnInputEvent(const InputEvent& event, void* context);
+    void HandleKey(int button_index, bool pressed);
     uint8_t GetDrumNote(int button_index) const;
 };
 
@@ -0,0 +1,212 @@
+#include "loop_recorder_input.h"
+#include "../../core/tracks/track_interface.h"
+#include <cstdio>
+
+namespace OpenChord {
+
+const char* LoopRecorderInput::file_action_names_[] = {
+    "-",
+    "Load",
+    "Save",
+    nullptr
+};
+
+LoopRecorderInput::LoopRecorderInput()
+    : track_(nullptr)
+    , storage_(nullptr)
+    , active_(true)  // Passes everything through until something is recorded
+    , sample_rate_(48000.0f)
+    , slot_setting_value_(1)
+    , file_setting_value_(FILE_IDLE)
+    , file_action_(FILE_IDLE)
+{
+    InitializeSettings();
+}
+
+LoopRecorderInput::~LoopRecorderInput() {
+}
+
+void LoopRecorderInput::Init() {
+    active_ = true;
+}
+
+void LoopRecorderInput::Process(const float* const* in, float* const* out, size_t size) {
+    // This plugin doesn't process audio directly
+    (void)in;
+    (void)out;
+    (void)size;
+}
+
+void LoopRecorderInput::Update() {
+    // Merge what the audio callback recorded into the playing loop
+    // (after a file transfer - an export reads the bank a merge rewrites)
+    if (transfer_.Update()) return;
+    loop_.Update();
+
+    // A Load / Save from the settings has finished (or failed)
+    if (file_.IsOpen()) {
+        file_.Close();
+        file_action_ = FILE_IDLE;
+        file_setting_value_ = FILE_IDLE;
+    }
+}
+
+void LoopRecorderInput::UpdateUI() {
+    // UI updates handled by main UI system
+}
+
+void LoopRecorderInput::HandleEncoder(int encoder, float delta) {
+    (void)encoder;
+    (void)delta;
+}
+
+void LoopRecorderInput::HandleButton(int button, bool pressed) {
+    // Controlled from the transport (TransportControl), not the musical buttons
+    (void)button;
+    (void)pressed;
+}
+
+void LoopRecorderInput::HandleJoystick(float x, float y) {
+    (void)x;
+    (void)y;
+}
+
+void LoopRecorderInput::SaveState(void* buffer, size_t* size) const {
+    if (!buffer || !size) return;
+
+    // Save state: active flag (loop content belongs to the scene, not the plugin)
+    *size = sizeof(bool);
+    *reinterpret_cast<bool*>(buffer) = active_;
+}
+
+void LoopRecorderInput::LoadState(const void* buffer, size_t size) {
+    if (!buffer || size < sizeof(bool)) return;
+
+    SetActive(*reinterpret_cast<const bool*>(buffer));
+}
+
+size_t LoopRecorderInput::GetStateSize() const {
+    return sizeof(bool);
+}
+
+void LoopRecorderInput::ToggleRecord() {
+    // Recorded notes wait in the loop's queue until the transfer lets it merge
+    if (transfer_.IsBusy()) return;
+    loop_.ToggleRecord();
+}
+
+bool LoopRecorderInput::ImportFile(IFileStream* file) {
+    if (loop_.IsRecording()) return false;
+    return transfer_.StartImport(&loop_, file, sample_rate_);
+}
+
+bool LoopRecorderInput::ExportFile(IFileStream* file) {
+    if (loop_.IsRecording()) return false;
+    float bpm = track_ ? track_->GetContext().bpm : 120.0f;
+    return transfer_.StartExport(&loop_, file, sample_rate_, bpm);
+}
+
+void LoopRecorderInput::StartFileAction(int action) {
+    if (!storage_ || file_.IsOpen() || transfer_.IsBusy()) return;
+
+    char name[16];
+    std::snprintf(name, sizeof(name), "loop%02d.mid", slot_setting_value_);
+    const bool save = action == FILE_SAVE;
+    if (!storage_->OpenMidiFile(name, save, &file_)) return;
+
+    const bool started = save ? ExportFile(&file_) : ImportFile(&file_);
+    if (!started) {
+        file_.Close();
+        return;
+    }
+    file_action_ = action;
+    file_setting_value_ = action;  // Shown until Update() sees the transfer end
+}
+
+bool LoopRecorderInput::IsActive() const {
+    // Still processed after being turned off until the stop has been applied
+    // in the audio callback, so notes sounding from the loop are released
+    MidiLoop::State state = loop_.GetState();
+    return active_ || (state != MidiLoop::State::EMPTY && state != MidiLoop::State::STOPPED);
+}
+
+void LoopRecorderInput::SetActive(bool active) {
+    // Turning the looper off stops playback (and releases its notes)
+    if (!active && active_) {
+        loop_.Stop();
+    }
+    active_ = active;
+}
+
+void LoopRecorderInput::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) {
+    // Playback is added on top of the stack's output (ProcessStackOutput)
+    (void)events;
+    (void)max_events;
+    *count = 0;
+}
+
+void LoopRecorderInput::ProcessMIDI(const MidiEvent* events, size_t count) {
+    // External MIDI is recorded as it leaves the stack (BasicMidiInput), not here
+    (void)events;
+    (void)count;
+}
+
+void LoopRecorderInput::InitializeSettings() {
+    // Setting 0: Slot (file number)
+    settings_[0].name = "Slot";
+    settings_[0].type = SettingType::INT;
+    settings_[0].value_ptr = &slot_setting_value_;
+    settings_[0].min_value = 1.0f;
+    settings_[0].max_value = static_cast<float>(MAX_SLOT);
+    settings_[0].step_size = 1.0f;
+    settings_[0].enum_options = nullptr;
+    settings_[0].enum_count = 0;
+    settings_[0].on_change_callback = nullptr;
+
+    // Setting 1: File (load or save the slot)
+    settings_[1].name = "File";
+    settings_[1].type = SettingType::ENUM;
+    settings_[1].value_ptr = &file_setting_value_;
+    settings_[1].min_value = 0.0f;
+    settings_[1].max_value = static_cast<float>(FILE_ACTION_COUNT - 1);
+    settings_[1].step_size = 1.0f;
+    settings_[1].enum_options = file_action_names_;
+    settings_[1].enum_count = FILE_ACTION_COUNT;
+    settings_[1].on_change_callback = nullptr;
+}
+
+int LoopRecorderInput::GetSettingCount() const {
+    return SETTING_COUNT;
+}
+
+const PluginSetting* LoopRecorderInput::GetSetting(int index) const {
+    if (index < 0 || index >= SETTING_COUNT) {
+        return nullptr;
+    }
+    return &settings_[index];
+}
+
+void LoopRecorderInput::OnSettingChanged(int setting_index) {
+    switch (setting_index) {
+        case 0:  // Slot
+            if (slot_setting_value_ < 1 || slot_setting_value_ > MAX_SLOT) slot_setting_value_ = 1;
+            break;
+        case 1: {  // File: picking Load / Save runs it on the slot
+            const int action = file_setting_value_;
+            file_setting_value_ = file_action_;
+            if (action == FILE_LOAD || action == FILE_SAVE) {
+                StartFileAction(action);
+            }
+            break;
+        }
+    }
+}
+
+void LoopRecorderInput::ProcessStackOutput(MidiEvent* events, size_t* count, size_t max_events) {
+    if (!track_) return;
+
+    const TrackContext& context = track_->GetContext();
+    loop_.ProcessBlock(context.block_start_sample, context.block_size, events, count, max_events);
+}
+
+} // namespace OpenChord
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "../../core/plugin_interface.h"
+#include "../../core/midi/midi_types.h"
+#include "../../core/midi/midi_loop.h"
+#include "../../core/midi/smf_loop_transfer.h"
+#include "../../core/io/storage_manager.h"
+#include "../../core/ui/plugin_settings.h"
+
+namespace OpenChord {
+
+// Forward declaration
+class Track;
+
+/**
+ * Loop Recorder Input Plugin ("Looper")
+ *
+ * Sits at the top of the input stack: records the notes the rest of the
+ * stack generates (built-in keys and external MIDI alike) into a MidiLoop
+ * and plays the loop back on top of them, sample-accurately, from the audio
+ * callback. The loop's event arena is allocated with the plugin at boot.
+ *
+ * Controlled from the transport (RECORD tap / play-pause with internal
+ * routing): first record tap starts the first pass, the next one closes the
+ * loop and plays it, later taps toggle overdub.
+ *
+ * Loops load from and bounce to Standard MIDI Files a slice per main loop
+ * pass (SmfLoopTransfer). From the settings menu, File: Load / Save moves the
+ * loop to and from 0:/midi/loopNN.mid (NN = the Slot setting), opening and
+ * closing the file itself. ImportFile()/ExportFile() take any open file;
+ * the caller keeps it open until IsFileBusy() is false.
+ *
+ * Recording waits for the looper's main loop merge, which a transfer holds
+ * off, so the two exclude each other: a transfer doesn't start while
+ * recording or overdubbing, and record taps are ignored while one runs
+ * (otherwise the record queue could overflow and drop notes).
+ */
+class LoopRecorderInput : public IInputPlugin, public IPluginWithSettings {
+public:
+    LoopRecorderInput();
+    ~LoopRecorderInput();
+
+    // IPlugin interface
+    void Init() override;
+    void Process(const float* const* in, float* const* out, size_t size) override;
+    void Update() override;
+    void UpdateUI() override;
+    void HandleEncoder(int encoder, float delta) override;
+    void HandleButton(int button, bool pressed) override;
+    void HandleJoystick(float x, float y) override;
+
+    const char* GetName() const override { return "Looper"; }
+    const char* GetCategory() const override { return "Input"; }
+    int GetVersion() const override { return 1; }
+
+    void SaveState(void* buffer, size_t* size) const override;
+    void LoadState(const void* buffer, size_t size) override;
+    size_t GetStateSize() const override;
+
+    // IInputPlugin interface
+    void GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) override;
+    void ProcessMIDI(const MidiEvent* events, size_t count) override;
+    void ProcessStackOutput(MidiEvent* events, size_t* count, size_t max_events) override;
+    bool IsActive() const override;
+    void SetActive(bool active) override;
+    int GetPriority() const override { return 5; }  // Top of the stack - appears first
+
+    // IPluginWithSettings interface
+    int GetSettingCount() const override;
+    const PluginSetting* GetSetting(int index) const override;
+    void OnSettingChanged(int setting_index) override;
+
+    // Setup - must be called before Init() (block timing comes from the track context)
+    void SetTrack(Track* track) { track_ = track; }
+    void SetSampleRate(float sample_rate) { sample_rate_ = sample_rate; }
+    void SetStorage(StorageManager* storage) { storage_ = storage; }
+
+    // Transport control (main loop) - record is ignored during a file transfer
+    void ToggleRecord();
+    void Play() { loop_.Play(); }
+    void Stop() { loop_.Stop(); }
+    void Clear() { loop_.Clear(); }
+    bool IsRecording() const { return loop_.IsRecording(); }
+
+    const MidiLoop& GetLoop() const { return loop_; }
+
+    // Loop files (main loop) - export writes at the track tempo; both fail
+    // while recording or overdubbing
+    bool ImportFile(IFileStream* file);
+    bool ExportFile(IFileStream* file);
+    bool IsFileBusy() const { return transfer_.IsBusy(); }
+    const SmfLoopTransfer& GetFileTransfer() const { return transfer_; }
+
+private:
+    Track* track_;
+    StorageManager* storage_;
+    bool active_;
+    float sample_rate_;
+    MidiLoop loop_;
+    SmfLoopTransfer transfer_;
+    StorageFile file_;  // Open for a Load / Save from the settings
+
+    // Settings support
+    enum FileAction {
+        FILE_IDLE = 0,
+        FILE_LOAD,
+        FILE_SAVE,
+        FILE_ACTION_COUNT
+    };
+    static constexpr int SETTING_COUNT = 2;  // Slot, file action
+    static constexpr int MAX_SLOT = 99;
+    int slot_setting_value_;
+    int file_setting_value_;  // Edited by the menu; shows file_action_ again once handled
+    int file_action_;         // Running Load / Save, idle when the transfer ends
+    static const char* file_action_names_[];
+    mutable PluginSetting settings_[SETTING_COUNT];
+    void InitializeSettings();
+    void StartFileAction(int action);
+};
+
+} // namespace OpenChord
@@ -29,7 +29,6 @@ PianoInput::PianoInput()
     , play_mode_setting_value_(static_cast<int>(PlayMode::SCALE))
     , pitch_bend_half_range_(false)  // Default to full range
 {
-    std::memset(prev_button_states_, false, sizeof(prev_button_states_));
     std::memset(current_button_states_, false, sizeof(current_button_states_));
     pending_events_.resize(128);
     
@@ -38,6 +37,9 @@ PianoInput::PianoInput()
 }
 
 PianoInput::~PianoInput() {
+    if (initialized_ && input_manager_) {
+        input_manager_->GetEventStream().Unsubscribe(OnInputEvent, this);
+    }
 }
 
 void PianoInput::Init() {
@@ -45,7 +47,7 @@ void PianoInput::Init() {
     
     active_ = true;
     initialized_ = true;
-    std::memset(prev_button_states_, false, sizeof(prev_button_states_));
+    std::memset(current_button_states_, false, sizeof(current_button_states_));
     pending_read_pos_ = 0;
     pending_write_pos_ = 0;
     joystick_x_ = 0.0f;
@@ -58,6 +60,8 @@ void PianoInput::Init() {
         SetKey(MusicalKey(0, MusicalMode::IONIAN));
     }
     SetPlayMode(PlayMode::SCALE);
+    
+    input_manager_->GetEventStream().Subscribe(OnInputEvent, this);
 }
 
 void PianoInput::Process(const float* const* in, float* const* out, size_t size) {
@@ -76,7 +80,7 @@ void PianoInput::Update() {
     // Only process if we're actually active
     if (!active_) return;
     
-    ProcessButtons();
+    // Buttons arrive as events (OnInputEvent), joystick is continuous
     ProcessJoystick();
 }
 
@@ -89,7 +93,7 @@ void PianoInput::HandleEncoder(int encoder, float delta) {
 }
 
 void PianoInput::HandleButton(int button, bool pressed) {
-    // Buttons processed via ProcessButtons()
+    // Musical buttons arrive via the input event stream (OnInputEvent)
 }
 
 void PianoInput::HandleJoystick(float x, float y) {
@@ -206,65 +210,39 @@ void PianoInput::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_event
     }
 }
 
-void PianoInput::ProcessButtons() {
-    if (!input_manager_) return;
+void PianoInput::OnInputEvent(const InputEvent& event, void* context) {
+    PianoInput* self = static_cast<PianoInput*>(context);
+    if (!self || !self->initialized_) return;
+    if (!event.IsMusicalKey() || event.type == InputEventType::KEY_HELD) return;
     
-    auto& button_handler = input_manager_->GetButtons();
+    self->HandleKey(event.id, event.type == InputEventType::KEY_DOWN);
+}
+
+void PianoInput::HandleKey(int button_index, bool pressed) {
+    current_button_states_[button_index] = pressed;
+    if (!active_) return;
     
-    for (int i = 0; i < 7; i++) {
-        MusicalButton button = static_cast<MusicalButton>(i);
-        bool current_pressed = button_handler.IsMusicalButtonPressed(button);
-        bool prev_pressed = prev_button_states_[i];
-        
-        // Update current state
-        current_button_states_[i] = current_pressed;
-        
-        if (current_pressed != prev_pressed) {
-            uint8_t midi_note;
-            
-            // Get MIDI note based on current play mode
-            if (play_mode_ == PlayMode::SCALE) {
-                midi_note = GetScaleNote(i);
-            } else {
-                midi_note = GetMidiNote(i);
-            }
-            
-            // Note: Octave shift is applied in main.cpp to all MIDI events before sending
-            
-            if (current_pressed && !prev_pressed) {
-                // Button pressed: send NOTE_ON
-                if (pending_write_pos_ < pending_events_.size()) {
-                    MidiEvent& event = pending_events_[pending_write_pos_];
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_ON);
-                    event.channel = 0;
-                    event.data1 = midi_note;  // Base note (octave shift applied later)
-                    event.data2 = 100;  // Default velocity
-                    event.timestamp = 0;
-                    
-                    pending_write_pos_++;
-                    if (pending_write_pos_ >= pending_events_.size()) {
-                        pending_write_pos_ = 0;
-                    }
-                }
-            } else if (!current_pressed && prev_pressed) {
-                // Button released: send NOTE_OFF
-                if (pending_write_pos_ < pending_events_.size()) {
-                    MidiEvent& event = pending_events_[pending_write_pos_];
-                    event.type = static_cast<uint8_t>(MidiEvent::Type::NOTE_OFF);
-                    event.channel = 0;
-                    event.data1 = midi_note;  // Base note (octave shift applied later)
-                    event.data2 = 0;
-                    event.timestamp = 0;
-                    
-                    pending_write_pos_++;
-                    if (pending_write_pos_ >= pending_events_.size()) {
-                        pending_write_pos_ = 0;
-                    }
-                }
-            }
-            
-            prev_button_states_[i] = current_pressed;
-        }
+    // Get MIDI note based on current play mode
+    uint8_t midi_note;
+    if (play_mode_ == PlayMode::SCALE) {
+        midi_note = GetScaleNote(button_index);
+    } else {
+        midi_note = GetMidiNote(button_index);
+    }
+    
+    // Note: Octave shift is applied in main.cpp to all MIDI events before sending
+    if (pressed) {
+        QueueEvent(MidiEvent(MidiEvent::NOTE_ON, 0, midi_note, 100));  // Default velocity
+    } else {
+        QueueEvent(MidiEvent(MidiEvent::NOTE_OFF, 0, midi_note, 0));
+    }
+}
+
+void PianoInput::QueueEvent(const MidiEvent& event) {
+    size_t next_write = (pending_write_pos_ + 1) % pending_events_.size();
+    if (next_write != pending_read_pos_) {
+        pending_events_[pending_write_pos_] = event;
+        pending_write_pos_ = next_write;
     }
 }
 
@@ -284,19 +262,9 @@ void PianoInput::ProcessJoystick() {
         // Pitch bend uses 14-bit value (0-16383), 8192 is center
         // This bends all currently playing notes chromatically, regardless of scale mode
         // Split into LSB (7 bits) and MSB (7 bits)
-        if (pending_write_pos_ < pending_events_.size()) {
-            MidiEvent& event = pending_events_[pending_write_pos_];
-            event.type = static_cast<uint8_t>(MidiEvent::Type::PITCH_BEND);
-            event.channel = 0;
-            event.data1 = pitch_bend & 0x7F;        // LSB (bits 0-6)
-            event.data2 = (pitch_bend >> 7) & 0x7F; // MSB (bits 7-13)
-            event.timestamp = 0;
-            
-            pending_write_pos_++;
-            if (pending_write_pos_ >= pending_events_.size()) {
-                pending_write_pos_ = 0;
-            }
-        }
+        QueueEvent(MidiEvent(MidiEvent::PITCH_BEND, 0,
+                             pitch_bend & 0x7F,           // LSB (bits 0-6)
+                             (pitch_bend >> 7) & 0x7F));  // MSB (bits 7-13)
         last_pitch_bend_value_ = pitch_bend;
     }
     
@@ -307,19 +275,7 @@ void PianoInput::ProcessJoystick() {
     uint8_t mod_wheel = CalculateModWheel(x, max_deflection);
     if (mod_wheel != last_mod_wheel_value_) {
         // Mod wheel changed - send MIDI CC 1 (Modulation Wheel)
-        if (pending_write_pos_ < pending_events_.size()) {
-            MidiEvent& event = pending_events_[pending_write_pos_];
-            event.type = static_cast<uint8_t>(MidiEvent::Type::CONTROL_CHANGE);
-            event.channel = 0;
-            event.data1 = 1;  // CC 1 = Modulation Wheel
-            event.data2 = mod_wheel;  // Value 0-127
-            event.timestamp = 0;
-            
-            pending_write_pos_++;
-            if (pending_write_pos_ >= pending_events_.size()) {
-                pending_write_pos_ = 0;
-            }
-        }
+        QueueEvent(MidiEvent(MidiEvent::CONTROL_CHANGE, 0, 1, mod_wheel));  // CC 1, value 0-127
         last_mod_wheel_value_ = mod_wheel;
     }
 }
@@ -423,20 +379,28 @@ uint8_t PianoInput::GetScaleNote(int button_index) const {
         return 60;  // Default to C4
     }
     
-    // Use ChordEngine to get the scale degree note for this button
-    MusicalKey key = GetCurrentKey();
-    uint8_t root_midi_note;
-    chord_engine_.GetButtonMapping(key, button_index, &root_midi_note);
+    // The track's scale table has the note of each scale degree for its key
+    int scale_degree = ChordEngine::PhysicalButtonToScaleDegree(button_index);
+    if (track_) {
+        return track_->GetScaleMap().GetDegreeNote(scale_degree);
+    }
     
+    uint8_t root_midi_note = 60;
+    ChordEngine::GetButtonMapping(GetCurrentKey(), button_index, &root_midi_note);
     return root_midi_note;
 }
 
 std::vector<uint8_t> PianoInput::GetActiveNotes() const {
-    std::vector<uint8_t> active;
-    
-    if (!initialized_) return active;
+    uint8_t notes[7];
+    size_t count = GetActiveNotes(notes, 7);
+    return std::vector<uint8_t>(notes, notes + count);
+}
+
+size_t PianoInput::GetActiveNotes(uint8_t* notes, size_t max_notes) const {
+    if (!initialized_ || !notes) return 0;
     
-    for (int i = 0; i < 7; i++) {
+    size_t count = 0;
+    for (int i = 0; i < 7 && count < max_notes; i++) {
         if (current_button_states_[i]) {
             uint8_t midi_note;
             if (play_mode_ == PlayMode::SCALE) {
@@ -450,14 +414,14 @@ std::vector<uint8_t> PianoInput::GetActiveNotes() const {
             if (octave_shift_) {
                 midi_note = octave_shift_->ApplyShift(midi_note);
             }
-            active.push_back(midi_note);
+            notes[count++] = midi_note;
         }
     }
     
     // Sort notes (lowest to highest)
-    std::sort(active.begin(), active.end());
+    std::sort(notes, notes + count);
     
-    return active;
+    return count;
 }
 
 void PianoInput::SetKey(MusicalKey key) {
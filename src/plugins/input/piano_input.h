@@ -3,6 +3,7 @@
 #include "../../core/plugin_interface.h"
 #include "../../core/midi/midi_types.h"
 #include "../../core/io/button_input_handler.h"
+#include "../../core/io/input_event_stream.h"
 #include "../../core/music/chord_engine.h"
 #include "../../core/ui/plugin_settings.h"
 #include <vector>
@@ -23,7 +24,11 @@ class Track;
  * 
  * Physical layout: White0, White1, White2, White3, Black0, Black1, Black2
  * In chromatic mode: C, D, E, F, C#, D#, F# (default starting from C4)
- * In scale mode: I, II, III, IV, V, VI, VII (scale degrees in selected key)
+ * In scale mode: I, II, III, IV, V, VI, VII (scale degrees in selected key,
+ * read from the track's scale table)
+ *
+ * Notes are driven by KEY_DOWN / KEY_UP events from the InputManager event
+ * stream; the joystick is polled for continuous pitch bend and mod wheel.
  */
 class PianoInput : public IInputPlugin, public IPluginWithSettings {
 public:
@@ -59,6 +64,7 @@ public:
     bool IsActive() const override;
     void SetActive(bool active) override { active_ = active; }
     int GetPriority() const override { return 10; }  // Highest priority (lowest number) - appears first
+    bool FollowsScaleLock() const override { return true; }
     
     // Set track to check for other active plugins and ensure default activation
     void SetTrack(Track* track) { track_ = track; }
@@ -75,6 +81,9 @@ public:
     // Get currently active notes (for UI display)
     std::vector<uint8_t> GetActiveNotes() const;
     
+    // Same, into a caller buffer without allocating (lowest first); returns the count
+    size_t GetActiveNotes(uint8_t* notes, size_t max_notes) const;
+    
     // Key selection (updates track key)
     void SetKey(MusicalKey key);
     MusicalKey GetCurrentKey() const;
@@ -95,9 +104,6 @@ private:
     bool active_;
     bool initialized_;
     
-    // Chord engine for scale mode
-    ChordEngine chord_engine_;
-    
     // Play mode (key is stored in track)
     PlayMode play_mode_;
     
@@ -108,9 +114,8 @@ private:
     mutable bool pitch_bend_half_range_;  // Limit pitch bend to half range (0.5 semitones)
     void InitializeSettings();
     
-    // Button state tracking
-    bool prev_button_states_[7];
-    bool current_button_states_[7];  // Track current pressed state
+    // Button state tracking (from KEY_DOWN / KEY_UP events)
+    bool current_button_states_[7];
     
     // MIDI event buffer
     std::vector<MidiEvent> pending_events_;
@@ -123,8 +128,10 @@ private:
     int16_t last_pitch_bend_value_;
     uint8_t last_mod_wheel_value_;
     
-    void ProcessButtons();
+    static void OnInputEvent(const InputEvent& event, void* context);
+    void HandleKey(int button_index, bool pressed);
     void ProcessJoystick();
+    void QueueEvent(const MidiEvent& event);
     uint8_t GetMidiNote(int button_index) const;
     uint8_t GetScaleNote(int button_index) const;  // For scale mode
     int16_t CalculatePitchBend(float joystick_y, float max_deflection) const;
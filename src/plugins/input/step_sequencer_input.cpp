@@ -0,0 +1,174 @@
+#include "step_sequencer_input.h"
+#include "../../core/tracks/track_interface.h"
+#include <cstring>
+
+namespace OpenChord {
+
+const char* StepSequencerInput::rate_names_[] = {
+    "1/4",
+    "1/8",
+    "1/16",
+    "1/32",
+    nullptr
+};
+
+// 24 PPQN clocks per step for each rate
+const uint8_t StepSequencerInput::rate_ticks_[] = {24, 12, 6, 3};
+
+StepSequencerInput::StepSequencerInput()
+    : track_(nullptr)
+    , active_(false)
+    , length_setting_value_(static_cast<int>(sequencer_.GetLength()))
+    , rate_setting_value_(2)  // 1/16
+{
+    InitializeSettings();
+}
+
+StepSequencerInput::~StepSequencerInput() {
+}
+
+void StepSequencerInput::Init() {
+    sequencer_.SetLength(static_cast<size_t>(length_setting_value_));
+    sequencer_.SetTicksPerStep(rate_ticks_[rate_setting_value_]);
+}
+
+void StepSequencerInput::Process(const float* const* in, float* const* out, size_t size) {
+    // This plugin doesn't process audio directly
+    (void)in;
+    (void)out;
+    (void)size;
+}
+
+void StepSequencerInput::Update() {
+    // Steps are generated in the audio callback (ProcessStackOutput)
+}
+
+void StepSequencerInput::UpdateUI() {
+    // UI updates handled by main UI system
+}
+
+void StepSequencerInput::HandleEncoder(int encoder, float delta) {
+    (void)encoder;
+    (void)delta;
+}
+
+void StepSequencerInput::HandleButton(int button, bool pressed) {
+    (void)button;
+    (void)pressed;
+}
+
+void StepSequencerInput::HandleJoystick(float x, float y) {
+    (void)x;
+    (void)y;
+}
+
+void StepSequencerInput::SaveState(void* buffer, size_t* size) const {
+    if (!buffer || !size) return;
+
+    SavedState state;
+    state.active = active_;
+    state.length = static_cast<uint8_t>(length_setting_value_);
+    state.rate_index = static_cast<uint8_t>(rate_setting_value_);
+    state.pattern = sequencer_.GetPattern();
+    std::memcpy(buffer, &state, sizeof(state));
+    *size = sizeof(state);
+}
+
+void StepSequencerInput::LoadState(const void* buffer, size_t size) {
+    if (!buffer || size < sizeof(SavedState)) return;
+
+    SavedState state;
+    std::memcpy(&state, buffer, sizeof(state));
+    sequencer_.SetPattern(state.pattern);
+    length_setting_value_ = state.length;
+    rate_setting_value_ = state.rate_index < 4 ? state.rate_index : 2;
+    OnSettingChanged(0);
+    OnSettingChanged(1);
+    SetActive(state.active);
+}
+
+size_t StepSequencerInput::GetStateSize() const {
+    return sizeof(SavedState);
+}
+
+bool StepSequencerInput::IsActive() const {
+    // Still processed after being turned off until its notes are released
+    return active_ || sequencer_.HasSoundingNotes();
+}
+
+void StepSequencerInput::SetActive(bool active) {
+    active_ = active;
+}
+
+void StepSequencerInput::GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) {
+    // Steps are added on top of the stack's output (ProcessStackOutput)
+    (void)events;
+    (void)max_events;
+    *count = 0;
+}
+
+void StepSequencerInput::ProcessMIDI(const MidiEvent* events, size_t count) {
+    (void)events;
+    (void)count;
+}
+
+void StepSequencerInput::ProcessStackOutput(MidiEvent* events, size_t* count, size_t max_events) {
+    if (!track_) return;
+
+    const TrackContext& context = track_->GetContext();
+    if (!active_) {
+        sequencer_.Release(context.block_start_sample, events, count, max_events);
+        return;
+    }
+    sequencer_.ProcessBlock(context.position, context.block_start_sample, context.block_size,
+                            events, count, max_events);
+}
+
+void StepSequencerInput::InitializeSettings() {
+    // Setting 0: Steps (pattern length)
+    settings_[0].name = "Steps";
+    settings_[0].type = SettingType::INT;
+    settings_[0].value_ptr = &length_setting_value_;
+    settings_[0].min_value = 1.0f;
+    settings_[0].max_value = static_cast<float>(StepSequencer::MAX_STEPS);
+    settings_[0].step_size = 1.0f;
+    settings_[0].enum_options = nullptr;
+    settings_[0].enum_count = 0;
+    settings_[0].on_change_callback = nullptr;
+
+    // Setting 1: Rate (step length)
+    settings_[1].name = "Rate";
+    settings_[1].type = SettingType::ENUM;
+    settings_[1].value_ptr = &rate_setting_value_;
+    settings_[1].min_value = 0.0f;
+    settings_[1].max_value = 3.0f;
+    settings_[1].step_size = 1.0f;
+    settings_[1].enum_options = rate_names_;
+    settings_[1].enum_count = 4;
+    settings_[1].on_change_callback = nullptr;
+}
+
+int StepSequencerInput::GetSettingCount() const {
+    return SETTING_COUNT;
+}
+
+const PluginSetting* StepSequencerInput::GetSetting(int index) const {
+    if (index < 0 || index >= SETTING_COUNT) {
+        return nullptr;
+    }
+    return &settings_[index];
+}
+
+void StepSequencerInput::OnSettingChanged(int setting_index) {
+    switch (setting_index) {
+        case 0:  // Steps
+            sequencer_.SetLength(static_cast<size_t>(length_setting_value_));
+            break;
+        case 1:  // Rate
+            if (rate_setting_value_ < 0 || rate_setting_value_ > 3) rate_setting_value_ = 2;
+            sequencer_.SetTicksPerStep(rate_ticks_[rate_setting_value_]);
+            break;
+    }
+}
+
+} // namespace OpenChord
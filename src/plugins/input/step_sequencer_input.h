@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../../core/plugin_interface.h"
+#include "../../core/midi/midi_types.h"
+#include "../../core/music/step_sequencer.h"
+#include "../../core/ui/plugin_settings.h"
+
+namespace OpenChord {
+
+// Forward declaration
+class Track;
+
+/**
+ * Step Sequencer Input Plugin ("Sequencer")
+ *
+ * Plays a StepSequencer pattern while the internal transport runs. Steps
+ * are generated in the audio callback from the transport's clock grid for
+ * the block (track context), not polled from the main loop, so they land
+ * on the sample of their clock. Its notes are added on top of what the
+ * rest of the stack plays (ProcessStackOutput), before the looper records.
+ *
+ * Off by default; turning it on or off takes effect at the next block.
+ */
+class StepSequencerInput : public IInputPlugin, public IPluginWithSettings {
+public:
+    StepSequencerInput();
+    ~StepSequencerInput();
+
+    // IPlugin interface
+    void Init() override;
+    void Process(const float* const* in, float* const* out, size_t size) override;
+    void Update() override;
+    void UpdateUI() override;
+    void HandleEncoder(int encoder, float delta) override;
+    void HandleButton(int button, bool pressed) override;
+    void HandleJoystick(float x, float y) override;
+
+    const char* GetName() const override { return "Sequencer"; }
+    const char* GetCategory() const override { return "Input"; }
+    int GetVersion() const override { return 1; }
+
+    void SaveState(void* buffer, size_t* size) const override;
+    void LoadState(const void* buffer, size_t size) override;
+    size_t GetStateSize() const override;
+
+    // IInputPlugin interface
+    void GenerateMIDI(MidiEvent* events, size_t* count, size_t max_events) override;
+    void ProcessMIDI(const MidiEvent* events, size_t count) override;
+    void ProcessStackOutput(MidiEvent* events, size_t* count, size_t max_events) override;
+    bool IsActive() const override;
+    void SetActive(bool active) override;
+    int GetPriority() const override { return 50; }  // After the performance inputs, before MIDI input
+
+    // IPluginWithSettings interface
+    int GetSettingCount() const override;
+    const PluginSetting* GetSetting(int index) const override;
+    void OnSettingChanged(int setting_index) override;
+
+    // Setup - must be called before Init() (transport position comes from the track context)
+    void SetTrack(Track* track) { track_ = track; }
+
+    StepSequencer& GetSequencer() { return sequencer_; }
+    const StepSequencer& GetSequencer() const { return sequencer_; }
+
+private:
+    struct SavedState {
+        bool active;
+        uint8_t length;
+        uint8_t rate_index;
+        StepSequencer::Pattern pattern;
+    };
+
+    Track* track_;
+    bool active_;
+    StepSequencer sequencer_;
+
+    // Settings support
+    static constexpr int SETTING_COUNT = 2;
+    int length_setting_value_;
+    int rate_setting_value_;
+    PluginSetting settings_[SETTING_COUNT];
+    static const char* rate_names_[];
+    static const uint8_t rate_ticks_[];
+
+    void InitializeSettings();
+};
+
+} // namespace OpenChord
@@ -0,0 +1,201 @@
+/**
+ * ADC Replay - Feed recorded ADC traces through the analog input filters on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/io -o build/adc_replay tools/adc_replay.cpp src/core/io/one_euro_filter.cpp
+ *
+ * Usage:
+ *   adc_replay [options] trace.csv   Replay a trace: "time_us,value[,value...]" per line
+ *                                    (normalized 0-1 ADC readings, '#' lines ignored)
+ *   adc_replay [options] --synthetic Generate a noisy rest -> flick -> rest joystick trace
+ *
+ * Options:
+ *   --volume               Use the volume pot tuning instead of the joystick tuning
+ *   --min-cutoff <hz>      Override rest cutoff
+ *   --beta <gain>          Override speed gain
+ *   --dcutoff <hz>         Override speed smoothing cutoff
+ *   --csv                  Print "time_us,raw...,filtered..." for every sample
+ *
+ * Prints per-channel jitter (output vs input total variation) and the largest
+ * output lag behind the input, so tuning changes can be compared on the same trace.
+ */
+
+#include "one_euro_filter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_CHANNELS = 5;
+
+struct TraceSample {
+    uint32_t time_us;
+    int channel_count;
+    float values[MAX_CHANNELS];
+};
+
+struct ChannelStats {
+    float input_variation;   // Sum of |step| of the input
+    float output_variation;  // Sum of |step| of the output
+    float worst_lag;         // Largest |output - input|
+    float prev_input;
+    float prev_output;
+};
+
+bool LoadTrace(const char* path, std::vector<TraceSample>& trace) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "adc_replay: cannot open %s\n", path);
+        return false;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        TraceSample sample;
+        memset(&sample, 0, sizeof(sample));
+        char* cursor = line;
+        sample.time_us = static_cast<uint32_t>(strtoul(cursor, &cursor, 10));
+        while (*cursor == ',' && sample.channel_count < MAX_CHANNELS) {
+            cursor++;
+            sample.values[sample.channel_count++] = strtof(cursor, &cursor);
+        }
+        if (sample.channel_count > 0) {
+            trace.push_back(sample);
+        }
+    }
+
+    fclose(file);
+    return !trace.empty();
+}
+
+void GenerateSynthetic(std::vector<TraceSample>& trace) {
+    // 1 kHz samples: 1 s at rest, 45 ms flick from 0.5 to 0.9, 2 s held,
+    // +-0.5% uniform noise (typical of the pot wiper on battery power)
+    srand(1);
+    for (uint32_t i = 0; i < 3000; i++) {
+        float target = 0.5f;
+        if (i >= 1000 && i < 1045) target = 0.5f + 0.4f * static_cast<float>(i - 1000) / 45.0f;
+        if (i >= 1045) target = 0.9f;
+        float noise = (static_cast<float>(rand() % 1000) / 1000.0f - 0.5f) * 0.01f;
+
+        TraceSample sample;
+        memset(&sample, 0, sizeof(sample));
+        sample.time_us = i * 1000;
+        sample.channel_count = 1;
+        sample.values[0] = target + noise;
+        trace.push_back(sample);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    OneEuroTuning tuning = JOYSTICK_FILTER_TUNING;
+    const char* path = nullptr;
+    bool synthetic = false;
+    bool print_csv = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--volume") == 0) {
+            tuning = VOLUME_FILTER_TUNING;
+        } else if (strcmp(argv[i], "--min-cutoff") == 0 && i + 1 < argc) {
+            tuning.min_cutoff_hz = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--beta") == 0 && i + 1 < argc) {
+            tuning.beta = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--dcutoff") == 0 && i + 1 < argc) {
+            tuning.derivative_cutoff_hz = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--synthetic") == 0) {
+            synthetic = true;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            print_csv = true;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    std::vector<TraceSample> trace;
+    if (synthetic) {
+        GenerateSynthetic(trace);
+    } else if (!path || !LoadTrace(path, trace)) {
+        fprintf(stderr, "usage: adc_replay [--volume] [--min-cutoff hz] [--beta gain] "
+                        "[--dcutoff hz] [--csv] (trace.csv | --synthetic)\n");
+        return 1;
+    }
+
+    int channel_count = trace[0].channel_count;
+    OneEuroFilter filters[MAX_CHANNELS];
+    ChannelStats stats[MAX_CHANNELS];
+    memset(stats, 0, sizeof(stats));
+    for (int c = 0; c < channel_count; c++) {
+        filters[c].Configure(tuning);
+    }
+
+    uint32_t prev_time_us = trace[0].time_us;
+    for (size_t i = 0; i < trace.size(); i++) {
+        const TraceSample& sample = trace[i];
+        float dt_s = static_cast<float>(sample.time_us - prev_time_us) * 0.000001f;
+        prev_time_us = sample.time_us;
+
+        float outputs[MAX_CHANNELS];
+        for (int c = 0; c < channel_count; c++) {
+            float input = sample.values[c];
+            float output = filters[c].Process(input, dt_s);
+            outputs[c] = output;
+
+            ChannelStats& s = stats[c];
+            if (i > 0) {
+                s.input_variation += fabsf(input - s.prev_input);
+                s.output_variation += fabsf(output - s.prev_output);
+            }
+            if (fabsf(output - input) > s.worst_lag) {
+                s.worst_lag = fabsf(output - input);
+            }
+            s.prev_input = input;
+            s.prev_output = output;
+        }
+
+        if (print_csv) {
+            printf("%u", sample.time_us);
+            for (int c = 0; c < channel_count; c++) printf(",%.5f", sample.values[c]);
+            for (int c = 0; c < channel_count; c++) printf(",%.5f", outputs[c]);
+            printf("\n");
+        }
+    }
+
+    fprintf(stderr, "tuning: min_cutoff=%.2f Hz beta=%.2f dcutoff=%.2f Hz, %zu samples\n",
+            tuning.min_cutoff_hz, tuning.beta, tuning.derivative_cutoff_hz, trace.size());
+    for (int c = 0; c < channel_count; c++) {
+        float ratio = stats[c].input_variation > 0.0f
+                          ? stats[c].output_variation / stats[c].input_variation
+                          : 0.0f;
+        fprintf(stderr, "ch%d: output/input variation %.3f, worst |out-in| %.4f\n",
+                c, ratio, stats[c].worst_lag);
+    }
+
+    if (synthetic) {
+        // Rest jitter before the flick, time to 90% of the step after it starts
+        float lo = 1.0f, hi = 0.0f;
+        int settle_ms = -1;
+        OneEuroFilter filter;
+        filter.Configure(tuning);
+        for (size_t i = 0; i < trace.size(); i++) {
+            float y = filter.Process(trace[i].values[0], i > 0 ? 0.001f : 0.0f);
+            if (i > 500 && i < 1000) {
+                if (y < lo) lo = y;
+                if (y > hi) hi = y;
+            }
+            if (settle_ms < 0 && i >= 1000 && y >= 0.86f) {
+                settle_ms = static_cast<int>(i) - 1000;
+            }
+        }
+        fprintf(stderr, "synthetic: rest p-p %.5f (input 0.01), 90%% reached after %d ms (input 41 ms)\n",
+                hi - lo, settle_ms);
+    }
+
+    return 0;
+}
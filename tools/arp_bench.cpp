@@ -0,0 +1,369 @@
+/**
+ * Arp Bench - arpeggiator patterns, timing, density limit and cost on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/music -Isrc/core/audio -o build/arp_bench tools/arp_bench.cpp src/core/music/arpeggiator.cpp src/core/music/note_scheduler.cpp src/core/audio/transport_clock.cpp
+ *
+ * Usage:
+ *   arp_bench [--bpm <tempo>]
+ *
+ * Drives the real Arpeggiator with the real TransportClock at 48 kHz from a
+ * simulated audio callback, the way ArpeggiatorInput does:
+ *   1. checks the held-note set against std::set through random presses and
+ *      releases, and times insert/remove
+ *   2. holds a chord and checks each pattern's note order, that every step
+ *      lands on its transport clock sample, and that block sizes from 1 to
+ *      1024 frames give the same events
+ *   3. checks the free-running grid with the transport stopped
+ *   4. checks the density limit holds a fast chord-repeat to its rate
+ *   5. times a block against the number of held notes
+ * Exits non-zero if a check fails.
+ */
+
+#include "arpeggiator.h"
+#include "transport_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t MAX_EVENTS = 64;          // Track event buffer per block
+
+struct Played {
+    uint32_t sample;
+    uint8_t type;
+    uint8_t note;
+
+    bool operator==(const Played& other) const {
+        return sample == other.sample && type == other.type && note == other.note;
+    }
+};
+
+struct Press {
+    uint32_t sample;    // From the start of the run
+    bool on;
+    uint8_t note;
+};
+
+void RecordClock(uint8_t status, uint32_t sample_time, void* context) {
+    if (status == 0xF8) {
+        static_cast<std::vector<uint32_t>*>(context)->push_back(sample_time);
+    }
+}
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+struct RunOptions {
+    float bpm = 174.0f;
+    size_t block = 48;
+    uint32_t samples = 48000 * 4;
+    bool transport = true;
+    Arpeggiator::Pattern pattern = Arpeggiator::Pattern::UP;
+    uint32_t ticks_per_step = 3;
+    float max_notes_per_second = 0.0f;
+};
+
+struct Run {
+    std::vector<Played> played;
+    std::vector<uint32_t> clocks;
+    uint32_t limited = 0;
+};
+
+// Transport + arpeggiator, with key presses delivered in the block they fall in
+Run Play(const RunOptions& options, const std::vector<Press>& presses) {
+    Run run;
+    TransportClock transport;
+    transport.Configure(SAMPLE_RATE);
+    transport.SetOutput(RecordClock, &run.clocks);
+    transport.SetTempo(options.bpm);
+
+    Arpeggiator arp;
+    arp.SetSampleRate(SAMPLE_RATE);
+    arp.SetPattern(options.pattern);
+    arp.SetTicksPerStep(options.ticks_per_step);
+    arp.SetMaxNotesPerSecond(options.max_notes_per_second);
+
+    const uint32_t first_sample = 777;
+    if (options.transport) transport.Start();
+    MidiEvent events[MAX_EVENTS];
+    size_t next_press = 0;
+    for (uint32_t done = 0; done < options.samples; done += static_cast<uint32_t>(options.block)) {
+        const uint32_t sample = first_sample + done;
+        transport.ProcessBlock(sample, options.block);
+        while (next_press < presses.size() && presses[next_press].sample < done + options.block) {
+            const Press& press = presses[next_press++];
+            if (press.on) {
+                arp.NoteOn(press.note, 100, 0);
+            } else {
+                arp.NoteOff(press.note);
+            }
+        }
+        size_t count = 0;
+        arp.ProcessBlock(transport.GetPosition(), options.bpm, sample, options.block, events, &count, MAX_EVENTS);
+        for (size_t i = 0; i < count; i++) {
+            if (events[i].timestamp - first_sample < options.samples) {
+                run.played.push_back({events[i].timestamp - first_sample, events[i].type, events[i].data1});
+            }
+        }
+    }
+    for (auto& clock : run.clocks) {
+        clock -= first_sample;
+    }
+    run.limited = arp.GetLimitedCount();
+    return run;
+}
+
+std::vector<uint8_t> NoteOns(const Run& run, size_t max_count) {
+    std::vector<uint8_t> notes;
+    for (const auto& played : run.played) {
+        if (played.type == MidiEvent::NOTE_ON && notes.size() < max_count) notes.push_back(played.note);
+    }
+    return notes;
+}
+
+bool Starts(const std::vector<uint8_t>& notes, const std::vector<uint8_t>& expected) {
+    if (notes.size() < expected.size()) return false;
+    return std::equal(expected.begin(), expected.end(), notes.begin());
+}
+
+// Held-note set through the arpeggiator's own interface: UP walks it in order
+void CheckHeldSet() {
+    std::printf("held-note set:\n");
+    std::mt19937 rng(3);
+    std::set<uint8_t> reference;
+    Arpeggiator arp;
+    arp.SetPattern(Arpeggiator::Pattern::CHORD);
+    arp.SetTicksPerStep(1);
+    bool same = true;
+    SongPosition stopped;
+    MidiEvent events[MAX_EVENTS];
+    uint32_t sample = 0;
+    for (int op = 0; op < 20000 && same; op++) {
+        uint8_t note = static_cast<uint8_t>(rng() % 128);
+        if (rng() % 2) {
+            arp.NoteOn(note, 100, 0);
+            reference.insert(note);
+        } else {
+            bool held = arp.NoteOff(note);
+            same = same && held == (reference.erase(note) == 1);
+        }
+        same = same && arp.GetHeldCount() == reference.size();
+        // Every 64 ops, one CHORD step must play the set in order (up to 8 notes)
+        if (op % 64 == 0 && !reference.empty()) {
+            size_t count = 0;
+            arp.Release(sample, events, &count, MAX_EVENTS);
+            count = 0;
+            arp.ProcessBlock(stopped, 300.0f, sample, 400, events, &count, MAX_EVENTS);   // One clock at 300 BPM
+            auto it = reference.begin();
+            size_t ons = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (events[i].type != MidiEvent::NOTE_ON) continue;
+                same = same && it != reference.end() && events[i].data1 == *it;
+                if (it != reference.end()) ++it;
+                ons++;
+            }
+            same = same && ons == std::min(reference.size(), Arpeggiator::MAX_CHORD_NOTES);
+            sample += 100000;
+        }
+    }
+    Check(same, "matches std::set through 20000 random presses and releases");
+
+    // Insert/remove cost
+    Arpeggiator timed;
+    std::vector<uint8_t> notes(1 << 16);
+    for (auto& note : notes) note = static_cast<uint8_t>(rng() % 128);
+    auto t0 = std::chrono::steady_clock::now();
+    size_t removed = 0;
+    for (int repeat = 0; repeat < 50; repeat++) {
+        for (size_t i = 0; i < notes.size(); i++) {
+            if (i & 1) {
+                removed += timed.NoteOff(notes[i]);
+            } else {
+                timed.NoteOn(notes[i], 100, 0);
+            }
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (50.0 * notes.size());
+    std::printf("  insert/remove: %.1f ns per operation (%zu removed)\n", ns, removed);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    float bpm = 174.0f;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--bpm") == 0 && i + 1 < argc) {
+            bpm = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            std::printf("usage: arp_bench [--bpm tempo]\n");
+            return 1;
+        }
+    }
+
+    CheckHeldSet();
+
+    // 2. Patterns over a held C major chord (pressed at once, released later)
+    std::printf("\npatterns (C E G held, 1/32 at %.0f BPM):\n", bpm);
+    const std::vector<Press> chord = {
+        {0, true, 64}, {0, true, 60}, {0, true, 67},
+        {48000 * 3, false, 60}, {48000 * 3, false, 64}, {48000 * 3, false, 67}
+    };
+    struct Expected {
+        Arpeggiator::Pattern pattern;
+        const char* name;
+        std::vector<uint8_t> notes;
+    };
+    const Expected expected[] = {
+        {Arpeggiator::Pattern::UP, "up", {60, 64, 67, 60, 64, 67, 60}},
+        {Arpeggiator::Pattern::DOWN, "down", {67, 64, 60, 67, 64, 60, 67}},
+        {Arpeggiator::Pattern::UP_DOWN, "up-down", {60, 64, 67, 64, 60, 64, 67, 64, 60}},
+        {Arpeggiator::Pattern::CHORD, "chord", {60, 64, 67, 60, 64, 67}},
+        {Arpeggiator::Pattern::RANDOM, "random", {}},
+    };
+    for (const auto& e : expected) {
+        RunOptions options;
+        options.bpm = bpm;
+        options.pattern = e.pattern;
+        Run run = Play(options, chord);
+        std::vector<uint8_t> notes = NoteOns(run, 1000);
+
+        char what[96];
+        if (!e.notes.empty()) {
+            std::snprintf(what, sizeof(what), "%s plays in order", e.name);
+            Check(Starts(notes, e.notes), what);
+        } else {
+            bool only_held = true;
+            int seen[128] = {};
+            for (uint8_t note : notes) {
+                only_held = only_held && (note == 60 || note == 64 || note == 67);
+                seen[note]++;
+            }
+            std::snprintf(what, sizeof(what), "%s plays only held notes, all of them", e.name);
+            Check(only_held && seen[60] && seen[64] && seen[67], what);
+        }
+
+        // Steps on their clocks: step k is clock k * 3, note-ons only there
+        bool on_clock = true;
+        size_t steps = 0;
+        for (const auto& played : run.played) {
+            if (played.type != MidiEvent::NOTE_ON) continue;
+            auto it = std::lower_bound(run.clocks.begin(), run.clocks.end(), played.sample);
+            bool is_step_clock = it != run.clocks.end() && *it == played.sample &&
+                                 (it - run.clocks.begin()) % 3 == 0;
+            on_clock = on_clock && is_step_clock;
+            steps++;
+        }
+        std::snprintf(what, sizeof(what), "%s: %zu note-ons, all on a step's clock sample", e.name, steps);
+        Check(on_clock && steps > 0, what);
+
+        // Nothing sounding after the release
+        bool released = true;
+        int sounding[128] = {};
+        for (const auto& played : run.played) {
+            sounding[played.note] += played.type == MidiEvent::NOTE_ON ? 1 : -1;
+        }
+        for (int s : sounding) released = released && s == 0;
+        std::snprintf(what, sizeof(what), "%s: every note-on has its note-off", e.name);
+        Check(released, what);
+
+        bool same = true;
+        for (size_t block : {size_t(1), size_t(16), size_t(256), size_t(1024)}) {
+            options.block = block;
+            same = same && Play(options, chord).played == run.played;
+        }
+        std::snprintf(what, sizeof(what), "%s: same events at block 1, 16, 48, 256, 1024", e.name);
+        Check(same, what);
+    }
+
+    // 3. Transport stopped: free grid at the track tempo, from the first note
+    std::printf("\nfree-running (transport stopped, 120 BPM, 1/16):\n");
+    {
+        RunOptions options;
+        options.bpm = 120.0f;
+        options.transport = false;
+        options.ticks_per_step = 6;
+        const std::vector<Press> late_chord = {{10000, true, 60}, {10000, true, 67}, {48000 * 3, false, 60}, {48000 * 3, false, 67}};
+        Run run = Play(options, late_chord);
+        // 6000 samples per sixteenth; the first step is at the block the chord arrived in
+        const uint32_t first = 10000 / 48 * 48;
+        bool spaced = true;
+        size_t k = 0;
+        for (const auto& played : run.played) {
+            if (played.type != MidiEvent::NOTE_ON) continue;
+            spaced = spaced && played.sample == first + k * 6000;
+            k++;
+        }
+        char what[96];
+        std::snprintf(what, sizeof(what), "%zu steps every 6000 samples from the first note", k);
+        Check(spaced && k > 10, what);
+    }
+
+    // 4. Density limit: chord-repeat of 4 notes at 1/32 would be ~93 notes/s at 174 BPM
+    std::printf("\ndensity limit (4-note chord repeat, 1/32):\n");
+    const std::vector<Press> four = {{0, true, 48}, {0, true, 55}, {0, true, 60}, {0, true, 64}};
+    for (float limit : {0.0f, 40.0f, 20.0f}) {
+        RunOptions options;
+        options.bpm = bpm;
+        options.pattern = Arpeggiator::Pattern::CHORD;
+        options.samples = 48000 * 10;
+        options.max_notes_per_second = limit;
+        Run run = Play(options, four);
+        size_t ons = NoteOns(run, 1u << 20).size();
+        double rate = ons / 10.0;
+        std::printf("  limit %3.0f: %.1f notes/s, %u skipped\n", limit, rate, run.limited);
+        if (limit > 0.0f) {
+            char what[96];
+            std::snprintf(what, sizeof(what), "held to %.0f notes/s (plus the %.0f-note burst)", limit,
+                          Arpeggiator::DENSITY_BURST);
+            Check(ons <= limit * 10.0f + Arpeggiator::DENSITY_BURST && ons >= limit * 10.0f - 2, what);
+        }
+    }
+
+    // 5. Cost per block against held notes
+    std::printf("\nblock 48, ns per block (best of 5), 1/32 up:\n");
+    for (size_t held : {size_t(1), size_t(8), size_t(32), size_t(100)}) {
+        double best = 1e30;
+        for (int repeat = 0; repeat < 5; repeat++) {
+            TransportClock transport;
+            transport.Configure(SAMPLE_RATE);
+            transport.SetTempo(bpm);
+            transport.Start();
+            Arpeggiator arp;
+            arp.SetTicksPerStep(3);
+            for (size_t i = 0; i < held; i++) arp.NoteOn(static_cast<uint8_t>(20 + i), 100, 0);
+            MidiEvent events[MAX_EVENTS];
+            const size_t blocks = 48000 * 10 / 48;
+            double total_ns = 0.0;
+            for (size_t b = 0; b < blocks; b++) {
+                uint32_t sample = static_cast<uint32_t>(b * 48);
+                transport.ProcessBlock(sample, 48);
+                SongPosition position = transport.GetPosition();
+                size_t count = 0;
+                auto t0 = std::chrono::steady_clock::now();
+                arp.ProcessBlock(position, bpm, sample, 48, events, &count, MAX_EVENTS);
+                auto t1 = std::chrono::steady_clock::now();
+                total_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            }
+            best = std::min(best, total_ns / blocks);
+        }
+        std::printf("  %3zu held: %.1f ns\n", held, best);
+    }
+
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+/**
+ * Audio Timing Sim - audio callback watchdog counters against simulated deadlines
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/audio -o build/audio_timing_sim tools/audio_timing_sim.cpp src/core/audio/audio_timing_monitor.cpp
+ *
+ * Usage:
+ *   audio_timing_sim [--block <frames>] [--seconds <simulated time>]
+ *
+ * Drives AudioTimingMonitor the way AudioEngine does (BeginCallback/EndCallback
+ * with a microsecond clock), from a simulated DMA interrupt at 48 kHz:
+ *   1. clean run: callback durations jitter below the period, none counted
+ *   2. injected overruns (a callback running past its deadline) and late
+ *      callbacks (a starved interrupt) at random points: each counted exactly
+ *      once, worst duration and worst interval match the injected ones
+ *   3. the microsecond timer wrapping during the run: no false counts
+ *   4. the callback start log returns the most recent starts, newest first
+ * Exits non-zero if a check fails.
+ */
+
+#include "audio_timing_monitor.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+struct Expected {
+    uint32_t xruns = 0;
+    uint32_t late = 0;
+    uint32_t worst_duration = 0;
+    uint32_t worst_interval = 0;
+};
+
+// Simulated callbacks: start at the period (plus interrupt jitter), run for a load
+// fraction of it. About one in overrun_one_in / late_one_in gets a fault injected.
+Expected Run(AudioTimingMonitor& monitor, std::mt19937& rng, uint32_t start_us, size_t callbacks,
+             float period_us, int overrun_one_in, int late_one_in) {
+    Expected expected;
+    std::uniform_real_distribution<float> load(0.2f, 0.9f);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    double due = start_us;
+    uint32_t previous_start = 0;
+    bool previous_late = false;
+    for (size_t i = 0; i < callbacks; i++) {
+        // Faults are counted as injected, not worked out from the times
+        double start = due + jitter(rng) * period_us;
+        previous_late = late_one_in > 0 && i > 0 && !previous_late && rng() % late_one_in == 0;
+        if (previous_late) {
+            start += period_us * (0.6f + 0.3f * load(rng));   // Interrupt held off by something else
+            expected.late++;
+        }
+        uint32_t duration = static_cast<uint32_t>(load(rng) * period_us);
+        if (overrun_one_in > 0 && rng() % overrun_one_in == 0) {
+            duration = static_cast<uint32_t>(period_us * (1.05f + load(rng)));
+            expected.xruns++;
+        }
+
+        const uint32_t start_us32 = static_cast<uint32_t>(static_cast<uint64_t>(start) & 0xFFFFFFFFu);
+        monitor.BeginCallback(start_us32);
+        monitor.EndCallback(start_us32 + duration);
+
+        if (i > 0) {
+            uint32_t interval = start_us32 - previous_start;
+            if (interval > expected.worst_interval) expected.worst_interval = interval;
+        }
+        if (duration > expected.worst_duration) expected.worst_duration = duration;
+        previous_start = start_us32;
+
+        // Next block is due a period after this one was (a late or long callback doesn't move the DMA)
+        due += period_us;
+    }
+    return expected;
+}
+
+bool Matches(const AudioTimingMonitor::Stats& stats, const Expected& expected, size_t callbacks) {
+    return stats.callback_count == callbacks && stats.xrun_count == expected.xruns &&
+           stats.late_count == expected.late && stats.worst_duration_us == expected.worst_duration &&
+           stats.worst_interval_us == expected.worst_interval;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t block = 48;
+    double seconds = 60.0;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            block = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else {
+            std::printf("usage: audio_timing_sim [--block frames] [--seconds s]\n");
+            return 1;
+        }
+    }
+    if (block < 1 || block > 4096) block = 48;
+    if (seconds <= 0.0) seconds = 60.0;
+
+    AudioTimingMonitor monitor;
+    monitor.Configure(SAMPLE_RATE, block);
+    const float period_us = static_cast<float>(block) * 1000000.0f / SAMPLE_RATE;
+    const size_t callbacks = static_cast<size_t>(seconds * 1000000.0 / period_us);
+    std::mt19937 rng(3);
+    char what[160];
+
+    std::printf("block %zu (%.1f us period), %zu callbacks per run\n", block, period_us, callbacks);
+    Check(monitor.GetStats().period_us == static_cast<uint32_t>(period_us), "period from the audio configuration");
+
+    // 1. Clean run
+    std::printf("\nclean run:\n");
+    Expected expected = Run(monitor, rng, 1000, callbacks, period_us, 0, 0);
+    const AudioTimingMonitor::Stats& stats = monitor.GetStats();
+    Check(Matches(stats, expected, callbacks) && stats.xrun_count == 0 && stats.late_count == 0,
+          "no xruns or late callbacks counted with the load below the period");
+    Check(monitor.GetLoad() > 0.0f && monitor.GetLoad() < 1.0f, "load of the last callback below 1");
+
+    // 2. Injected faults
+    std::printf("\ninjected overruns and late callbacks:\n");
+    monitor.Reset();
+    expected = Run(monitor, rng, 5000, callbacks, period_us, 500, 700);
+    std::snprintf(what, sizeof(what), "%u xruns and %u late callbacks injected, %u and %u counted",
+                  expected.xruns, expected.late, stats.xrun_count, stats.late_count);
+    Check(expected.xruns > 0 && expected.late > 0 && Matches(stats, expected, callbacks), what);
+    std::snprintf(what, sizeof(what), "worst duration %u us and worst interval %u us match the injected ones",
+                  stats.worst_duration_us, stats.worst_interval_us);
+    Check(stats.worst_duration_us == expected.worst_duration && stats.worst_interval_us == expected.worst_interval, what);
+
+    // 3. Timer wrap: start a second before the 32-bit microsecond counter rolls over
+    std::printf("\nmicrosecond timer wrap:\n");
+    monitor.Reset();
+    expected = Run(monitor, rng, 0xFFFFFFFFu - 1000000u, callbacks, period_us, 0, 0);
+    Check(Matches(stats, expected, callbacks) && stats.xrun_count == 0 && stats.late_count == 0,
+          "no false counts across the wrap");
+
+    // 4. Start log, newest first
+    std::printf("\ncallback log:\n");
+    monitor.Reset();
+    bool log_ok = true;
+    for (uint32_t i = 0; i < AudioTimingMonitor::LOG_SIZE + 5; i++) {
+        monitor.BeginCallback(1000 + i * 1000);
+        monitor.EndCallback(1000 + i * 1000 + 100);
+    }
+    log_ok = monitor.GetLogCount() == AudioTimingMonitor::LOG_SIZE;
+    for (size_t age = 0; log_ok && age < AudioTimingMonitor::LOG_SIZE; age++) {
+        log_ok = monitor.GetLoggedTimestamp(age) == 1000 + (AudioTimingMonitor::LOG_SIZE + 4 - age) * 1000;
+    }
+    Check(log_ok, "keeps the last LOG_SIZE callback starts, newest first");
+
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
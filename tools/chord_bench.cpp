@@ -0,0 +1,310 @@
+/**
+ * Chord Bench - chord lookup tables against the computed chord path on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/music -o build/chord_bench tools/chord_bench.cpp src/core/music/chord_engine.cpp
+ *
+ * Usage:
+ *   chord_bench
+ *
+ * Rebuilds, inside the tool, the way ChordMappingInput used to make a chord
+ * on every key press (button mapping, diatonic quality, joystick variation,
+ * intervals, inversion, snprintf name) and checks ChordEngine's key table
+ * gives the same notes and name for every key, mode, button, joystick
+ * direction, preset and inversion. Then times both per chord, and the table
+ * rebuild on a key change.
+ *
+ * Voice leading: plays common progressions in every key with fixed root
+ * position and with voice-led chords, checks each voice-led chord has the
+ * same pitch classes as its root position and is one of its inversions at
+ * most an octave from where it is built,
+ * and reports semitones moved and note-ons/offs per chord change (what
+ * ChordMappingInput sends after common tones are kept), plus the search time.
+ * Exits non-zero if any chord differs or a voicing check fails.
+ */
+
+#include "chord_engine.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace OpenChord;
+
+namespace {
+
+// The computed path, as ChordEngine did it before the tables
+void ReferenceIntervals(ChordQuality quality, int* intervals, int* count) {
+    static const int table[11][4] = {
+        {4, 7}, {3, 7}, {3, 6}, {4, 8}, {4, 7, 11}, {3, 7, 10}, {4, 7, 10},
+        {4, 7, 11, 14}, {3, 7, 10, 14}, {5, 7}, {2, 7}
+    };
+    static const int counts[11] = {2, 2, 2, 2, 3, 3, 3, 4, 4, 2, 2};
+    int q = static_cast<int>(quality);
+    *count = counts[q];
+    for (int i = 0; i < *count; i++) intervals[i] = table[q][i];
+}
+
+void ReferenceInversion(uint8_t* notes, uint8_t note_count, ChordInversion inversion) {
+    if (inversion == ChordInversion::FIRST) {
+        uint8_t root = notes[0];
+        for (int i = 0; i < note_count - 1; i++) notes[i] = notes[i + 1];
+        notes[note_count - 1] = root + 12;
+    } else if (inversion == ChordInversion::SECOND && note_count >= 3) {
+        uint8_t root = notes[0];
+        uint8_t third = notes[1];
+        notes[0] = notes[2];
+        for (int i = 1; i < note_count - 2; i++) notes[i] = notes[i + 2];
+        notes[note_count - 2] = root + 12;
+        notes[note_count - 1] = third + 12;
+    }
+}
+
+struct ReferenceChord {
+    uint8_t notes[5];
+    uint8_t note_count;
+    char name[32];
+};
+
+void ReferenceChordFor(const ChordEngine& engine, MusicalKey key, int button, int direction, int preset,
+                       ChordInversion inversion, ReferenceChord* chord) {
+    int degree = engine.PhysicalButtonToScaleDegree(button);
+    uint8_t root = 0;
+    engine.GetButtonMapping(key, button, &root);
+    ChordQuality quality = engine.GetChordQualityForDegree(key.mode, degree);
+    if (direction != 0) quality = engine.ApplyJoystickVariation(quality, direction, preset);
+
+    int intervals[5];
+    int count = 0;
+    ReferenceIntervals(quality, intervals, &count);
+    chord->notes[0] = root;
+    for (int i = 0; i < count; i++) {
+        int note = root + intervals[i];
+        chord->notes[i + 1] = static_cast<uint8_t>(note > 127 ? 127 : note);
+    }
+    chord->note_count = static_cast<uint8_t>(count + 1);
+    ReferenceInversion(chord->notes, chord->note_count, inversion);
+
+    static const char* note_names[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+    static const char* quality_names[] = {"", "m", "dim", "aug", "maj7", "m7", "7", "maj9", "m9", "sus4", "sus2"};
+    static const char* inversion_names[] = {"", " 1st Inv", " 2nd Inv"};
+    snprintf(chord->name, sizeof(chord->name), "%s%s%s", note_names[root % 12],
+             quality_names[static_cast<int>(quality)], inversion_names[static_cast<int>(inversion)]);
+}
+
+// Note-ons plus note-offs to move from one chord to the next, common tones kept
+int ChangedNotes(const Chord& from, const Chord& to) {
+    int changed = 0;
+    for (int i = 0; i < to.note_count; i++) {
+        if (!std::memchr(from.notes, to.notes[i], from.note_count)) changed++;
+    }
+    for (int i = 0; i < from.note_count; i++) {
+        if (!std::memchr(to.notes, from.notes[i], to.note_count)) changed++;
+    }
+    return changed;
+}
+
+// Semitones moved: each note to the nearest note of the other chord, both ways
+int Movement(const Chord& from, const Chord& to) {
+    int total = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        const Chord& a = pass == 0 ? to : from;
+        const Chord& b = pass == 0 ? from : to;
+        for (int i = 0; i < a.note_count; i++) {
+            int nearest = 128;
+            for (int j = 0; j < b.note_count; j++) {
+                int distance = std::abs(a.notes[i] - b.notes[j]);
+                if (distance < nearest) nearest = distance;
+            }
+            total += nearest;
+        }
+    }
+    return total;
+}
+
+uint16_t PitchClasses(const Chord& chord) {
+    uint16_t classes = 0;
+    for (int i = 0; i < chord.note_count; i++) classes |= 1u << (chord.notes[i] % 12);
+    return classes;
+}
+
+double NowNs() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int main() {
+    ChordEngine engine;
+    const int presets = engine.GetJoystickPresetCount();
+
+    // 1. Every chord the buttons can play
+    size_t checked = 0;
+    size_t mismatches = 0;
+    for (int root = 0; root < 12; root++) {
+        for (int mode = 0; mode < 7; mode++) {
+            MusicalKey key(static_cast<uint8_t>(root), static_cast<MusicalMode>(mode));
+            engine.SetKey(key);
+            for (int button = 0; button < 7; button++) {
+                for (int direction = 0; direction <= 8; direction++) {
+                    for (int preset = 0; preset < presets; preset++) {
+                        for (int inv = 0; inv < ChordEngine::INVERSION_COUNT; inv++) {
+                            ChordInversion inversion = static_cast<ChordInversion>(inv);
+                            ReferenceChord expected;
+                            ReferenceChordFor(engine, key, button, direction, preset, inversion, &expected);
+                            const Chord& chord = engine.GetKeyChord(engine.PhysicalButtonToScaleDegree(button),
+                                                                    direction, preset, inversion);
+                            bool same = chord.note_count == expected.note_count &&
+                                        std::memcmp(chord.notes, expected.notes, chord.note_count) == 0 &&
+                                        std::strcmp(chord.name, expected.name) == 0;
+                            if (!same && mismatches++ < 5) {
+                                std::printf("  mismatch: key %d mode %d button %d dir %d preset %d inv %d: %s vs %s\n",
+                                            root, mode, button, direction, preset, inv, chord.name, expected.name);
+                            }
+                            checked++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::printf("key table: %zu chords checked against the computed path, %zu differ\n", checked, mismatches);
+
+    // 2. Cost per chord: computed (with snprintf) against one table read
+    const int rounds = 200;
+    MusicalKey key(2, MusicalMode::DORIAN);
+    engine.SetKey(key);
+    volatile uint32_t sink = 0;
+    double best_reference = 1e30;
+    double best_table = 1e30;
+    for (int repeat = 0; repeat < 5; repeat++) {
+        double t0 = NowNs();
+        for (int r = 0; r < rounds; r++) {
+            for (int button = 0; button < 7; button++) {
+                for (int direction = 0; direction <= 8; direction++) {
+                    ReferenceChord chord;
+                    ReferenceChordFor(engine, key, button, direction, r % presets, ChordInversion::ROOT, &chord);
+                    sink = sink + chord.notes[0] + static_cast<uint8_t>(chord.name[0]);
+                }
+            }
+        }
+        double t1 = NowNs();
+        for (int r = 0; r < rounds; r++) {
+            for (int button = 0; button < 7; button++) {
+                for (int direction = 0; direction <= 8; direction++) {
+                    Chord chord = engine.GetKeyChord(engine.PhysicalButtonToScaleDegree(button), direction,
+                                                     r % presets, ChordInversion::ROOT);
+                    sink = sink + chord.notes[0] + static_cast<uint8_t>(chord.name[0]);
+                }
+            }
+        }
+        double t2 = NowNs();
+        const double chords = rounds * 7.0 * 9.0;
+        if ((t1 - t0) / chords < best_reference) best_reference = (t1 - t0) / chords;
+        if ((t2 - t1) / chords < best_table) best_table = (t2 - t1) / chords;
+    }
+    std::printf("per chord: computed %.1f ns, table %.1f ns (%.0fx)\n",
+                best_reference, best_table, best_reference / best_table);
+
+    // 3. Table rebuild on a key change
+    double best_rebuild = 1e30;
+    for (int repeat = 0; repeat < 5; repeat++) {
+        double t0 = NowNs();
+        for (int k = 0; k < 84; k++) {
+            engine.SetKey(MusicalKey(static_cast<uint8_t>(k % 12), static_cast<MusicalMode>(k % 7)));
+        }
+        double t1 = NowNs();
+        if ((t1 - t0) / 84.0 < best_rebuild) best_rebuild = (t1 - t0) / 84.0;
+    }
+    std::printf("key change rebuild: %.2f us, table %zu bytes\n", best_rebuild / 1000.0, sizeof(ChordEngine));
+
+    // 4. Voice leading over progressions (scale degrees, with a joystick direction each)
+    struct Step {
+        int degree;
+        int direction;
+    };
+    struct Progression {
+        const char* name;
+        Step steps[8];
+        int length;
+    };
+    const Progression progressions[] = {
+        {"I-V-vi-IV", {{0, 0}, {4, 0}, {5, 0}, {3, 0}}, 4},
+        {"ii7-V7-Imaj7", {{1, 2}, {4, 4}, {0, 6}}, 3},
+        {"circle of 5ths", {{0, 0}, {3, 0}, {6, 0}, {2, 0}, {5, 0}, {1, 0}, {4, 0}, {0, 0}}, 8},
+        {"I-vi-IV-V, 9ths", {{0, 1}, {5, 2}, {3, 1}, {4, 1}}, 4},
+    };
+    bool voicings_ok = true;
+    std::printf("\nvoice leading, all 12 keys x 7 modes, 10 passes (per chord change):\n");
+    std::printf("  %-16s %10s %10s %10s %10s\n", "progression", "fixed st", "led st", "fixed n", "led n");
+    for (const auto& progression : progressions) {
+        long fixed_movement = 0, led_movement = 0, fixed_changed = 0, led_changed = 0, changes = 0;
+        for (int k = 0; k < 84; k++) {
+            engine.SetKey(MusicalKey(static_cast<uint8_t>(k % 12), static_cast<MusicalMode>(k / 12)));
+            Chord fixed_previous{};
+            Chord led_previous{};
+            for (int pass = 0; pass < 10; pass++) {
+                for (int i = 0; i < progression.length; i++) {
+                    const Step& step = progression.steps[i];
+                    const Chord& fixed = engine.GetKeyChord(step.degree, step.direction, 0);
+                    Chord led;
+                    engine.GetVoiceLedChord(step.degree, step.direction, 0, led_previous, &led);
+
+                    // Same chord: one of its inversions, at most an octave from where it is built
+                    bool same_classes = PitchClasses(led) == PitchClasses(fixed) && led.note_count == fixed.note_count;
+                    bool placed = false;
+                    for (int inv = 0; inv < ChordEngine::INVERSION_COUNT; inv++) {
+                        const Chord& candidate = engine.GetKeyChord(step.degree, step.direction, 0,
+                                                                    static_cast<ChordInversion>(inv));
+                        for (int shift = -12; shift <= 12; shift += 12) {
+                            bool match = candidate.note_count == led.note_count;
+                            for (int n = 0; match && n < led.note_count; n++) {
+                                match = led.notes[n] == candidate.notes[n] + shift;
+                            }
+                            placed = placed || match;
+                        }
+                    }
+                    voicings_ok = voicings_ok && same_classes && placed;
+
+                    if (fixed_previous.note_count > 0) {
+                        fixed_movement += Movement(fixed_previous, fixed);
+                        led_movement += Movement(led_previous, led);
+                        fixed_changed += ChangedNotes(fixed_previous, fixed);
+                        led_changed += ChangedNotes(led_previous, led);
+                        changes++;
+                    }
+                    fixed_previous = fixed;
+                    led_previous = led;
+                }
+            }
+        }
+        std::printf("  %-16s %10.2f %10.2f %10.2f %10.2f\n", progression.name,
+                    fixed_movement / double(changes), led_movement / double(changes),
+                    fixed_changed / double(changes), led_changed / double(changes));
+        voicings_ok = voicings_ok && led_movement <= fixed_movement;
+    }
+    std::printf("  (st = semitones moved, n = note-ons + note-offs sent)\n");
+
+    // Search cost
+    engine.SetKey(MusicalKey(0, MusicalMode::IONIAN));
+    double best_search = 1e30;
+    for (int repeat = 0; repeat < 5; repeat++) {
+        Chord previous{};
+        double t0 = NowNs();
+        for (int r = 0; r < rounds * 9; r++) {
+            Chord led;
+            engine.GetVoiceLedChord(r % 7, r % 9, r % presets, previous, &led);
+            previous = led;
+        }
+        double t1 = NowNs();
+        sink = sink + previous.notes[0];
+        if ((t1 - t0) / (rounds * 9.0) < best_search) best_search = (t1 - t0) / (rounds * 9.0);
+    }
+    std::printf("voice-led chord: %.1f ns (%d candidates)\n", best_search,
+                ChordEngine::INVERSION_COUNT * ChordEngine::OCTAVE_PLACEMENTS);
+    if (!voicings_ok) std::printf("  FAIL: a voice-led chord changed notes, left its register, or moved more\n");
+
+    bool ok = mismatches == 0 && voicings_ok;
+    std::printf("\n%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
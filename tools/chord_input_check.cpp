@@ -0,0 +1,360 @@
+/**
+ * Chord Input Check - key press to chord MIDI through the input event stream on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Itools/host -Isrc -o build/chord_input_check tools/chord_input_check.cpp tools/host/host_daisy.cpp $(find src -name '*.cpp' ! -name main.cpp)
+ *
+ * Usage:
+ *   chord_input_check [--presses <n>]
+ *
+ * Runs the real input path against the host libDaisy: keys are switches
+ * between the matrix row and column pins, the key scan timer interrupt fires
+ * every 250 us, and a 1 kHz main loop runs IOManager and InputManager
+ * updates (scanner queue -> DigitalManager -> ButtonInputHandler ->
+ * InputEventStream -> ChordMappingInput) and collects the plugin's MIDI.
+ * Checks:
+ *   - end to end: every press gives its chord's note-ons within a full scan
+ *     plus one main loop pass of the switch closing, with the edge stamped
+ *     at the scan that saw it
+ *   - legato: releasing the newest of several held keys goes back to the
+ *     chord of the key pressed before it, not the lowest-numbered one, and
+ *     releasing an older key changes nothing
+ *   - chord changes: every change between two held chords sends exactly the
+ *     note-offs of departing notes, then the note-ons of arriving ones, and
+ *     nothing for common tones
+ *   - turning the plugin off with a chord held sends note-offs for exactly
+ *     the sounding notes, and the key's later release sends nothing
+ * Reports the key-to-MIDI latency distribution. Times are host time, so a
+ * loaded machine adds to them.
+ * Exits non-zero if a check fails.
+ */
+
+#include "core/io/io_manager.h"
+#include "core/io/input_manager.h"
+#include "plugins/input/chord_mapping_input.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr uint32_t TICK_US = 250;                   // Key scan timer, 4 kHz
+constexpr uint32_t SCAN_US = TICK_US * 3;           // Three rows
+constexpr uint32_t MAIN_LOOP_US = 1000;             // Input task rate
+constexpr uint32_t HOST_SLACK_US = 300;             // Host time spent in the updates themselves
+
+// Matrix pins, as DigitalManager::Init
+const daisy::Pin ROW_PINS[3] = {daisy::seed::D20, daisy::seed::D21, daisy::seed::D22};
+const daisy::Pin COL_PINS[4] = {daisy::seed::D23, daisy::seed::D24, daisy::seed::D25, daisy::seed::D26};
+
+daisy::DaisySeed hw;
+IOManager io_manager;
+InputManager input_manager;
+ChordMappingInput chord_plugin;
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+// Musical key index to matrix position (white keys on row 0, black on row 1)
+void SetKey(int key, bool pressed) {
+    const int row = key < 4 ? 0 : 1;
+    const int col = key < 4 ? key : key - 4;
+    daisy::GPIO::HostSetSwitch(ROW_PINS[row], COL_PINS[col], pressed);
+}
+
+// Notes the plugin has on, from the MIDI it generated
+struct Sounding {
+    uint32_t bits[4] = {0, 0, 0, 0};
+
+    bool operator==(const Sounding& other) const { return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+    bool operator!=(const Sounding& other) const { return !(*this == other); }
+    bool Empty() const { return !bits[0] && !bits[1] && !bits[2] && !bits[3]; }
+    bool Has(uint8_t note) const { return bits[note >> 5] & (1u << (note & 31)); }
+    int Count() const {
+        return __builtin_popcount(bits[0]) + __builtin_popcount(bits[1]) +
+               __builtin_popcount(bits[2]) + __builtin_popcount(bits[3]);
+    }
+};
+
+Sounding g_sounding;
+size_t g_note_ons = 0;
+size_t g_messages = 0;
+std::vector<MidiEvent> g_log;  // Everything the plugin sent, cleared by the checks
+
+// The key scan interrupt runs every TICK_US; the main loop every MAIN_LOOP_US
+void RunUs(uint32_t us) {
+    static uint32_t since_pass = 0;
+    for (uint32_t t = 0; t < us; t += TICK_US) {
+        daisy::System::DelayUs(TICK_US);
+        daisy::TimerHandle::HostElapse(daisy::TimerHandle::Config::Peripheral::TIM_5);
+        daisy::TimerHandle::HostElapse(daisy::TimerHandle::Config::Peripheral::TIM_4);  // ADC, joystick at rest
+        since_pass += TICK_US;
+        if (since_pass < MAIN_LOOP_US) continue;
+        since_pass = 0;
+
+        io_manager.Update();
+        input_manager.Update();
+        chord_plugin.Update();
+        MidiEvent events[64];
+        size_t count = 0;
+        chord_plugin.GenerateMIDI(events, &count, 64);
+        for (size_t i = 0; i < count; i++) {
+            g_log.push_back(events[i]);
+            const uint8_t note = events[i].data1 & 0x7F;
+            if (events[i].type == MidiEvent::NOTE_ON && events[i].data2 > 0) {
+                g_sounding.bits[note >> 5] |= 1u << (note & 31);
+                g_note_ons++;
+            } else if (events[i].type == MidiEvent::NOTE_OFF || events[i].type == MidiEvent::NOTE_ON) {
+                g_sounding.bits[note >> 5] &= ~(1u << (note & 31));
+            }
+        }
+        g_messages += count;
+    }
+}
+
+// Press (or release) and run until the plugin answers; returns the latency in us
+uint32_t Stroke(int key, bool pressed, uint32_t limit_us) {
+    SetKey(key, pressed);
+    const uint32_t start = daisy::System::GetUs();
+    const size_t messages = g_messages;
+    for (uint32_t waited = 0; waited < limit_us && g_messages == messages; waited += TICK_US) {
+        RunUs(TICK_US);
+    }
+    return daisy::System::GetUs() - start;
+}
+
+void CheckLatency(size_t presses) {
+    std::printf("key press to chord note-ons (%zu presses, random keys and times):\n", presses);
+    std::mt19937 rng(11);
+    std::vector<uint32_t> latencies;
+    uint32_t worst_edge_age = 0;
+    bool all_answered = true;
+    bool all_released = true;
+    for (size_t i = 0; i < presses; i++) {
+        RunUs(TICK_US * (40 + rng() % 200));          // Gap, and a random phase against scan and loop
+        const int key = static_cast<int>(rng() % 7);
+        const size_t ons = g_note_ons;
+        const uint32_t dispatched = input_manager.GetEventStream().GetDispatchedCount();
+        latencies.push_back(Stroke(key, true, 20000));
+        all_answered = all_answered && g_note_ons > ons;
+        // Edge time to dispatch: the scan stamped it, the main loop picked it up
+        if (input_manager.GetEventStream().GetDispatchedCount() > dispatched) {
+            worst_edge_age = std::max(worst_edge_age, input_manager.GetEventStream().GetLastLatencyUs());
+        }
+        RunUs(TICK_US * (40 + rng() % 400));          // Hold
+        Stroke(key, false, 40000);
+        all_released = all_released && g_sounding.Empty();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const uint32_t limit = SCAN_US + MAIN_LOOP_US + HOST_SLACK_US;
+    uint64_t total = 0;
+    for (uint32_t latency : latencies) total += latency;
+    std::printf("  latency: average %llu us, median %u us, 95%% %u us, worst %u us\n",
+                static_cast<unsigned long long>(total / latencies.size()), latencies[latencies.size() / 2],
+                latencies[latencies.size() * 95 / 100], latencies.back());
+
+    char what[160];
+    Check(all_answered, "every press produced note-ons");
+    std::snprintf(what, sizeof(what), "within a full scan plus a main loop pass (worst %u us, limit %u)",
+                  latencies.back(), limit);
+    Check(latencies.back() <= limit, what);
+    std::snprintf(what, sizeof(what), "edge to dispatch within a main loop pass (worst %u us)", worst_edge_age);
+    Check(worst_edge_age <= MAIN_LOOP_US + HOST_SLACK_US, what);
+    Check(all_released, "every release turns its chord off");
+}
+
+Sounding PlayAlone(int key) {
+    Stroke(key, true, 20000);
+    Sounding chord = g_sounding;
+    Stroke(key, false, 40000);
+    RunUs(30000);
+    return chord;
+}
+
+void CheckLegato() {
+    std::printf("\nlegato with several keys held:\n");
+    // Keys 0, 5, 2 are I, IV and V (physical order 0 4 1 5 2 6 3)
+    const Sounding one = PlayAlone(0);
+    const Sounding four = PlayAlone(5);
+    const Sounding five = PlayAlone(2);
+    Check(!one.Empty() && one != four && four != five, "I, IV and V alone are three different chords");
+
+    Stroke(0, true, 20000);
+    RunUs(30000);
+    Stroke(5, true, 20000);
+    RunUs(30000);
+    Stroke(2, true, 20000);
+    RunUs(30000);
+    const bool five_on_top = g_sounding == five;
+    Stroke(2, false, 40000);
+    RunUs(30000);
+    Check(five_on_top && g_sounding == four, "hold I, IV, V, release V: back to IV (the key pressed before)");
+
+    const size_t messages = g_messages;
+    Stroke(0, false, 40000);
+    RunUs(30000);
+    Check(g_sounding == four && g_messages == messages, "release I while IV is on top: nothing sent");
+
+    Stroke(0, true, 20000);
+    RunUs(30000);
+    const bool one_on_top = g_sounding == one;
+    Stroke(0, false, 40000);
+    RunUs(30000);
+    Check(one_on_top && g_sounding == four, "press I again, release it: back to IV");
+
+    Stroke(5, false, 40000);
+    RunUs(30000);
+    Check(g_sounding.Empty(), "release the last key: all off");
+}
+
+bool IsNoteOn(const MidiEvent& event) { return event.type == MidiEvent::NOTE_ON && event.data2 > 0; }
+
+// The messages of one change from `from` to `to`: offs for departing notes
+// first, then ons for arriving ones, each note once, common tones untouched
+bool IsMinimalTransition(const std::vector<MidiEvent>& log, const Sounding& from, const Sounding& to) {
+    Sounding departing, arriving;
+    for (int w = 0; w < 4; w++) {
+        departing.bits[w] = from.bits[w] & ~to.bits[w];
+        arriving.bits[w] = to.bits[w] & ~from.bits[w];
+    }
+    if (static_cast<int>(log.size()) != departing.Count() + arriving.Count()) return false;
+    for (size_t i = 0; i < log.size(); i++) {
+        const uint8_t note = log[i].data1 & 0x7F;
+        const bool off_phase = static_cast<int>(i) < departing.Count();
+        if (off_phase ? (IsNoteOn(log[i]) || !departing.Has(note)) : (!IsNoteOn(log[i]) || !arriving.Has(note))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CheckTransitions() {
+    std::printf("\nchord changes (every held key to every other):\n");
+    Sounding alone[7];
+    for (int key = 0; key < 7; key++) alone[key] = PlayAlone(key);
+
+    int changes = 0;
+    int minimal = 0;
+    size_t sent = 0;
+    size_t full_retrigger = 0;
+    for (int from = 0; from < 7; from++) {
+        for (int to = 0; to < 7; to++) {
+            if (to == from) continue;
+            Stroke(from, true, 20000);
+            RunUs(30000);
+            g_log.clear();
+            Stroke(to, true, 20000);
+            RunUs(30000);
+            changes++;
+            if (g_sounding == alone[to] && IsMinimalTransition(g_log, alone[from], alone[to])) minimal++;
+            sent += g_log.size();
+            full_retrigger += alone[from].Count() + alone[to].Count();
+            Stroke(to, false, 40000);
+            RunUs(30000);
+            Stroke(from, false, 40000);
+            RunUs(30000);
+        }
+    }
+    std::printf("  %zu messages for %d changes (%zu if every change released and re-struck the chord)\n",
+                sent, changes, full_retrigger);
+
+    char what[160];
+    std::snprintf(what, sizeof(what), "only departing offs then arriving ons, common tones kept (%d/%d)",
+                  minimal, changes);
+    Check(minimal == changes, what);
+
+    // I -> iii in C: E and G are common, C goes and B arrives
+    Stroke(0, true, 20000);
+    RunUs(30000);
+    g_log.clear();
+    Stroke(1, true, 20000);
+    RunUs(30000);
+    Check(alone[0].Has(64) && alone[0].Has(67) && alone[1].Has(64) && alone[1].Has(67) &&
+          g_log.size() == 2 && !IsNoteOn(g_log[0]) && g_log[0].data1 == 60 && IsNoteOn(g_log[1]) &&
+          g_log[1].data1 == 71,
+          "I -> iii: -C +B, E and G keep sounding");
+    Stroke(1, false, 40000);
+    RunUs(30000);
+    Stroke(0, false, 40000);
+    RunUs(30000);
+}
+
+void CheckDeactivate() {
+    std::printf("\nturning the plugin off with a chord held:\n");
+    Stroke(5, true, 20000);
+    RunUs(30000);
+    const Sounding held = g_sounding;
+    g_log.clear();
+    chord_plugin.SetActive(false);
+    const bool draining = chord_plugin.IsActive();
+    RunUs(2000);
+
+    bool offs_only = true;
+    Sounding released;
+    for (const MidiEvent& event : g_log) {
+        if (IsNoteOn(event)) offs_only = false;
+        released.bits[(event.data1 & 0x7F) >> 5] |= 1u << (event.data1 & 31);
+    }
+    Check(!held.Empty() && offs_only && released == held && static_cast<int>(g_log.size()) == held.Count(),
+          "note-offs for exactly the sounding notes");
+    Check(draining && !chord_plugin.IsActive(), "reports active until the note-offs are out, then off");
+
+    g_log.clear();
+    Stroke(5, false, 40000);
+    RunUs(30000);
+    Check(g_log.empty() && g_sounding.Empty(), "releasing the key afterwards sends nothing");
+
+    chord_plugin.SetActive(true);
+    Stroke(5, true, 20000);
+    RunUs(30000);
+    const bool plays_again = g_sounding == held;
+    Stroke(5, false, 40000);
+    RunUs(30000);
+    Check(plays_again && g_sounding.Empty(), "turned back on, the key plays its chord again");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t presses = 300;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--presses") == 0 && i + 1 < argc) {
+            presses = static_cast<size_t>(std::atoi(argv[++i]));
+        } else {
+            std::printf("usage: chord_input_check [--presses n]\n");
+            return 1;
+        }
+    }
+    if (presses < 20) presses = 20;
+
+    io_manager.Init(&hw);
+    input_manager.Init(&io_manager);
+    chord_plugin.SetInputManager(&input_manager);
+    chord_plugin.Init();
+    chord_plugin.SetActive(true);
+    RunUs(50000);   // Let the joystick settle and anything from start-up drain
+    g_sounding = Sounding();
+
+    if (!io_manager.GetDigital()->IsKeyScanTimerRunning()) {
+        std::printf("key scan timer not running\n");
+        return 1;
+    }
+
+    CheckLatency(presses);
+    CheckLegato();
+    CheckTransitions();
+    CheckDeactivate();
+
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,295 @@
+/**
+ * Clock Follow Sim - External MIDI clock following with jittery clock streams
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/midi -Isrc/core/audio -o build/clock_follow_sim tools/clock_follow_sim.cpp src/core/midi/midi_clock_follower.cpp src/core/audio/transport_clock.cpp
+ *
+ * Usage:
+ *   clock_follow_sim [--jitter <us>] [--seconds <s>] [--verbose]
+ *
+ * A simulated master sends START and 24 PPQN clock. Each clock arrives with
+ * a fixed latency plus random jitter (default up to +-1000us, like a busy
+ * USB host) and is timestamped on arrival, as the receive interrupt does.
+ * A simulated main loop (1ms MIDI task plus occasional UI stalls) feeds the
+ * events to the real MidiClockFollower, which drives the real TransportClock
+ * run sample by sample.
+ *
+ * Scenarios: steady tempo, tempo step, tempo ramp, dropped clocks, and the
+ * master going away. For each one it reports the lock time, the tempo error,
+ * and the transport clock error against the master's real send times, next
+ * to the raw arrival jitter. It exits non-zero if the transport doesn't lock,
+ * follows the jitter instead of smoothing it, or loses clocks.
+ */
+
+#include "midi_clock_follower.h"
+#include "transport_clock.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr double US_PER_SAMPLE = 1000000.0 / SAMPLE_RATE;
+constexpr double LATENCY_US = 300.0;            // Fixed transport latency
+constexpr uint32_t MIDI_TASK_SAMPLES = 48;      // 1ms MIDI task
+constexpr double SETTLE_SECONDS = 4.0;          // Excluded from the steady-state figures
+
+struct Scenario {
+    const char* name;
+    double start_bpm;
+    double end_bpm;
+    double change_at_s;     // Step (ramp_s == 0) or ramp start
+    double ramp_s;
+    double drop_rate;       // Fraction of clocks lost
+    double stop_at_s;       // Master stops sending clock (0 = never)
+};
+
+const Scenario SCENARIOS[] = {
+    {"steady 120",        120.0, 120.0,  0.0,  0.0, 0.0,  0.0},
+    {"steady 174.3",      174.3, 174.3,  0.0,  0.0, 0.0,  0.0},
+    {"step 120->140",     120.0, 140.0, 20.0,  0.0, 0.0,  0.0},
+    {"ramp 100->160",     100.0, 160.0, 10.0, 20.0, 0.0,  0.0},
+    {"2% dropped",        128.0, 128.0,  0.0,  0.0, 0.02, 0.0},
+    {"master goes away",  120.0, 120.0,  0.0,  0.0, 0.0, 30.0},
+};
+
+struct Options {
+    double jitter_us = 1000.0;
+    double seconds = 60.0;
+    bool verbose = false;
+};
+
+double TempoAt(const Scenario& scenario, double t) {
+    if (t < scenario.change_at_s) return scenario.start_bpm;
+    if (scenario.ramp_s <= 0.0) return scenario.end_bpm;
+    double progress = (t - scenario.change_at_s) / scenario.ramp_s;
+    if (progress > 1.0) progress = 1.0;
+    return scenario.start_bpm + (scenario.end_bpm - scenario.start_bpm) * progress;
+}
+
+// Outside the settling time after start-up and after each tempo change
+// (a step, or either end of a ramp)
+bool Settled(const Scenario& scenario, double t) {
+    if (t < SETTLE_SECONDS) return false;
+    if (scenario.change_at_s <= 0.0) return true;
+    if (t >= scenario.change_at_s && t < scenario.change_at_s + SETTLE_SECONDS) return false;
+    double ramp_end_s = scenario.change_at_s + scenario.ramp_s;
+    if (scenario.ramp_s > 0.0 && t >= ramp_end_s && t < ramp_end_s + SETTLE_SECONDS) return false;
+    return true;
+}
+
+struct Arrival {
+    uint32_t sample;
+    uint8_t type;
+    size_t clock;       // Index into the send times (clocks only)
+};
+
+struct Stats {
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    double worst = 0.0;
+    uint32_t count = 0;
+
+    void Add(double value) {
+        sum += value;
+        sum_sq += value * value;
+        if (std::fabs(value) > worst) worst = std::fabs(value);
+        count++;
+    }
+    double Mean() const { return count ? sum / count : 0.0; }
+    double StdDev() const {
+        if (count == 0) return 0.0;
+        double variance = sum_sq / count - Mean() * Mean();
+        return variance > 0.0 ? std::sqrt(variance) : 0.0;
+    }
+};
+
+bool RunScenario(const Scenario& scenario, const Options& options) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> jitter(-options.jitter_us, options.jitter_us);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // Master: START, then clocks at the true tempo, arriving late and jittered
+    std::vector<double> send_us;
+    std::vector<Arrival> arrivals;
+    const double start_us = 10000.0;
+    arrivals.push_back({static_cast<uint32_t>((start_us + LATENCY_US) / US_PER_SAMPLE), MidiEvent::START, 0});
+    double t_us = start_us + 1000.0;
+    const double end_us = (scenario.stop_at_s > 0.0 ? scenario.stop_at_s : options.seconds) * 1000000.0;
+    while (t_us < end_us) {
+        if (unit(rng) >= scenario.drop_rate) {
+            double arrival_us = t_us + LATENCY_US + jitter(rng);
+            arrivals.push_back({static_cast<uint32_t>(arrival_us / US_PER_SAMPLE), MidiEvent::CLOCK, send_us.size()});
+        }
+        send_us.push_back(t_us);
+        t_us += 60000000.0 / (TempoAt(scenario, t_us / 1000000.0) * TransportClock::PPQN);
+    }
+    // Arrival order is receive order
+    for (size_t i = 2; i < arrivals.size(); i++) {
+        if (arrivals[i].sample < arrivals[i - 1].sample) arrivals[i].sample = arrivals[i - 1].sample;
+    }
+
+    TransportClock transport;
+    transport.Configure(SAMPLE_RATE);
+    MidiClockFollower follower;
+    follower.Init(&transport, SAMPLE_RATE);
+
+    // Run sample by sample (block size 1) so each clock's sample is exact
+    const uint32_t total_samples = static_cast<uint32_t>(options.seconds * SAMPLE_RATE);
+    size_t next_arrival = 0;
+    uint32_t next_task_sample = 0;
+    uint32_t last_clock_count = 0;
+    int32_t lock_clock = -1;
+    bool locked_seen = false;
+    uint32_t unlock_sample = 0;
+    std::vector<uint32_t> tick_samples;
+    Stats tempo_error;
+    Stats raw_error_us;
+    Stats tick_error_us;
+    Stats interval_after_stop;
+
+    for (uint32_t sample = 0; sample < total_samples; sample++) {
+        transport.ProcessBlock(sample, 1);
+        // Catch-up clocks land on the same sample
+        while (last_clock_count != transport.GetClockCount()) {
+            last_clock_count++;
+            tick_samples.push_back(sample);
+        }
+
+        // Main loop MIDI task: everything received so far, then the timeout check
+        if (sample >= next_task_sample) {
+            while (next_arrival < arrivals.size() && arrivals[next_arrival].sample <= sample) {
+                MidiEvent event(arrivals[next_arrival].type, 0, 0, 0, MidiEvent::SOURCE_USB,
+                                arrivals[next_arrival].sample);
+                follower.ProcessEvent(event);
+                next_arrival++;
+            }
+            follower.Update(sample);
+
+            if (follower.IsLocked() && !locked_seen) {
+                locked_seen = true;
+                lock_clock = static_cast<int32_t>(follower.GetClockIndex());
+            }
+            if (locked_seen && !follower.IsLocked() && unlock_sample == 0) {
+                unlock_sample = sample;
+            }
+
+            double now_s = sample / SAMPLE_RATE;
+            if (follower.IsLocked() && Settled(scenario, now_s)) {
+                tempo_error.Add(follower.GetTempo() - TempoAt(scenario, now_s));
+            }
+
+            // Occasional UI stall of up to 8ms
+            uint32_t stall = (rng() % 16 == 0) ? static_cast<uint32_t>(unit(rng) * 8000.0 / US_PER_SAMPLE) : 0;
+            next_task_sample = sample + MIDI_TASK_SAMPLES + stall;
+        }
+    }
+
+    // Transport clock k against master clock k (START rebases the count)
+    for (size_t k = 0; k < tick_samples.size() && k < send_us.size(); k++) {
+        double tick_s = tick_samples[k] / SAMPLE_RATE;
+        if (!Settled(scenario, tick_s)) continue;
+        if (scenario.stop_at_s > 0.0 && tick_s > scenario.stop_at_s) continue;
+        tick_error_us.Add(tick_samples[k] * US_PER_SAMPLE - send_us[k]);
+    }
+    // Raw arrival error of the clocks as timestamped (what following each clock would give)
+    for (size_t i = 1; i < arrivals.size(); i++) {
+        double send_s = send_us[arrivals[i].clock] / 1000000.0;
+        if (!Settled(scenario, send_s)) continue;
+        raw_error_us.Add(arrivals[i].sample * US_PER_SAMPLE - send_us[arrivals[i].clock]);
+    }
+
+    // After the master went away the transport carries on at the last tempo
+    bool carried_on = true;
+    if (scenario.stop_at_s > 0.0) {
+        uint32_t stop_sample = static_cast<uint32_t>(scenario.stop_at_s * SAMPLE_RATE);
+        uint32_t ticks_after = 0;
+        for (size_t k = 1; k < tick_samples.size(); k++) {
+            if (tick_samples[k - 1] > stop_sample + SAMPLE_RATE) {
+                interval_after_stop.Add((tick_samples[k] - tick_samples[k - 1]) * US_PER_SAMPLE);
+                ticks_after++;
+            }
+        }
+        double expected_us = 60000000.0 / (scenario.end_bpm * TransportClock::PPQN);
+        carried_on = unlock_sample > stop_sample && ticks_after > 0 &&
+                     std::fabs(interval_after_stop.Mean() - expected_us) < expected_us * 0.01;
+    }
+
+    // Every master clock has a transport clock (after a stop the transport carries on alone)
+    long clock_difference = 0;
+    if (scenario.stop_at_s <= 0.0) {
+        clock_difference = static_cast<long>(tick_samples.size()) - static_cast<long>(send_us.size());
+    }
+
+    double jitter_free_us = tick_error_us.StdDev();
+    double raw_us = raw_error_us.StdDev();
+    std::printf("%-17s lock after %3d clocks  tempo err rms %.3f max %.3f BPM  "
+                "clock err %+7.1f us, jitter %6.1f us rms (arrivals %6.1f) max %6.1f\n",
+                scenario.name, lock_clock,
+                std::sqrt(tempo_error.sum_sq / (tempo_error.count ? tempo_error.count : 1)), tempo_error.worst,
+                tick_error_us.Mean(), jitter_free_us, raw_us,
+                std::fabs(tick_error_us.worst - std::fabs(tick_error_us.Mean())));
+    if (options.verbose) {
+        std::printf("  %zu master clocks, %zu transport clocks, relocks %u\n",
+                    send_us.size(), tick_samples.size(), follower.GetRelockCount());
+        if (scenario.stop_at_s > 0.0) {
+            std::printf("  unlocked %.3f s after the last clock, then %.2f us intervals\n",
+                        (unlock_sample - scenario.stop_at_s * SAMPLE_RATE) / SAMPLE_RATE, interval_after_stop.Mean());
+        }
+    }
+
+    bool ok = true;
+    if (lock_clock < 0 || lock_clock > 48) {
+        std::printf("  FAIL: no lock within two beats\n");
+        ok = false;
+    }
+    // Clocks land on whole samples, so allow one sample on top
+    if (jitter_free_us > raw_us * 0.5 + US_PER_SAMPLE) {
+        std::printf("  FAIL: transport clock follows the arrival jitter\n");
+        ok = false;
+    }
+    if (tempo_error.count && std::sqrt(tempo_error.sum_sq / tempo_error.count) > 0.5) {
+        std::printf("  FAIL: tempo estimate off\n");
+        ok = false;
+    }
+    if (std::labs(clock_difference) > 1) {
+        std::printf("  FAIL: %+ld transport clocks against the master\n", clock_difference);
+        ok = false;
+    }
+    if (!carried_on) {
+        std::printf("  FAIL: transport did not carry on at the last tempo\n");
+        ok = false;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) {
+            options.jitter_us = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            options.seconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else {
+            std::printf("usage: clock_follow_sim [--jitter us] [--seconds s] [--verbose]\n");
+            return 1;
+        }
+    }
+    if (options.seconds < 40.0) options.seconds = 40.0;  // Scenarios change tempo up to 30s in
+
+    bool ok = true;
+    for (const Scenario& scenario : SCENARIOS) {
+        ok = RunScenario(scenario, options) && ok;
+    }
+    return ok ? 0 : 1;
+}
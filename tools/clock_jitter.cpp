@@ -0,0 +1,219 @@
+/**
+ * Clock Jitter - MIDI clock interval jitter of the internal transport on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/audio -o build/clock_jitter tools/clock_jitter.cpp src/core/audio/transport_clock.cpp
+ *
+ * Usage:
+ *   clock_jitter [options]
+ *
+ * Options:
+ *   --bpm <tempo>          Transport tempo (default 120)
+ *   --block <frames>       Audio block size (default 4; 0 = compare 4, 16, 48 and 64)
+ *   --seconds <s>          Simulated run time (default 60)
+ *   --loop-period <us>     Main loop MIDI task period for the comparison (default 1000)
+ *   --ui-stall <us>        Worst extra main loop delay from UI work (default 8000)
+ *
+ * Runs the real TransportClock at 48 kHz from a simulated audio callback and
+ * records when each 0xF8 leaves: at the start of the callback of the block
+ * it falls in, as the USB path does. For comparison, the same clock is sent
+ * from a main loop task that runs every loop period plus a random UI delay.
+ * Reports clock interval statistics against the ideal interval, the drift
+ * after the run, and checks the song position. Exits non-zero if the audio
+ * timeline jitter exceeds one block or the clock count drifts.
+ */
+
+#include "transport_clock.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+
+struct Options {
+    float bpm = 120.0f;
+    int block = 4;
+    float seconds = 60.0f;
+    double loop_period_us = 1000.0;
+    double ui_stall_us = 8000.0;
+};
+
+struct Recorder {
+    std::vector<uint32_t> clock_samples;   // Sample time of each 0xF8
+    std::vector<double> clock_send_us;     // When it was handed to the transport
+    double callback_us = 0.0;              // Start time of the running callback
+    uint8_t first_status = 0;
+    uint32_t other_bytes = 0;
+};
+
+void RecordRealtime(uint8_t status, uint32_t sample_time, void* context) {
+    Recorder* recorder = static_cast<Recorder*>(context);
+    if (recorder->first_status == 0) recorder->first_status = status;
+    if (status == 0xF8) {
+        recorder->clock_samples.push_back(sample_time);
+        recorder->clock_send_us.push_back(recorder->callback_us);
+    } else {
+        recorder->other_bytes++;
+    }
+}
+
+struct IntervalStats {
+    double mean_us;
+    double min_us;
+    double max_us;
+    double stddev_us;
+    double worst_error_us;   // Largest |interval - ideal|
+};
+
+IntervalStats Measure(const std::vector<double>& send_us, double ideal_us) {
+    IntervalStats stats = {0.0, 1e12, 0.0, 0.0, 0.0};
+    size_t count = send_us.size() > 1 ? send_us.size() - 1 : 0;
+    if (count == 0) return stats;
+
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    for (size_t i = 1; i < send_us.size(); i++) {
+        double interval = send_us[i] - send_us[i - 1];
+        sum += interval;
+        sum_sq += interval * interval;
+        if (interval < stats.min_us) stats.min_us = interval;
+        if (interval > stats.max_us) stats.max_us = interval;
+        double error = std::fabs(interval - ideal_us);
+        if (error > stats.worst_error_us) stats.worst_error_us = error;
+    }
+    stats.mean_us = sum / count;
+    double variance = sum_sq / count - stats.mean_us * stats.mean_us;
+    stats.stddev_us = variance > 0.0 ? std::sqrt(variance) : 0.0;
+    return stats;
+}
+
+void PrintStats(const char* name, const IntervalStats& stats) {
+    std::printf("  %-14s mean %8.2f us  min %8.2f  max %8.2f  stddev %7.2f  worst error %8.2f us\n",
+                name, stats.mean_us, stats.min_us, stats.max_us, stats.stddev_us, stats.worst_error_us);
+}
+
+bool RunBlockSize(const Options& options, int block) {
+    TransportClock clock;
+    Recorder recorder;
+    clock.Configure(SAMPLE_RATE);
+    clock.SetTempo(options.bpm);
+    clock.SetOutput(RecordRealtime, &recorder);
+    clock.Start();
+
+    const uint32_t total_samples = static_cast<uint32_t>(options.seconds * SAMPLE_RATE);
+    const double us_per_sample = 1000000.0 / SAMPLE_RATE;
+    uint32_t sample = 0;
+    while (sample < total_samples) {
+        recorder.callback_us = sample * us_per_sample;
+        clock.ProcessBlock(sample, block);
+        sample += block;
+    }
+
+    const double ideal_us = 60000000.0 / (static_cast<double>(clock.GetTempo()) * TransportClock::PPQN);
+    const double block_us = block * us_per_sample;
+
+    // Main loop comparison: a clock is sent when the first task run after its
+    // ideal time gets to it (loop period plus UI delay)
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> stall(0.0, options.ui_stall_us);
+    std::vector<double> loop_send_us;
+    double loop_now_us = 0.0;
+    for (size_t i = 0; i < recorder.clock_samples.size(); i++) {
+        double due_us = i * ideal_us;
+        while (loop_now_us < due_us) {
+            loop_now_us += options.loop_period_us + stall(rng) * (rng() % 8 == 0);
+        }
+        loop_send_us.push_back(loop_now_us);
+    }
+
+    // Drift: clocks sent vs clocks due, and placement of the last clock
+    const double expected_clocks = std::ceil(sample * us_per_sample / ideal_us);
+    const long clock_error = static_cast<long>(recorder.clock_samples.size()) - static_cast<long>(expected_clocks);
+    double last_error_samples = 0.0;
+    if (!recorder.clock_samples.empty()) {
+        double ideal_last = (recorder.clock_samples.size() - 1) * ideal_us / us_per_sample;
+        last_error_samples = recorder.clock_samples.back() - ideal_last;
+    }
+
+    SongPosition position = clock.GetPosition();
+    uint32_t ticks_per_bar = TransportClock::PPQN * 4;
+    bool position_ok = position.playing &&
+                       position.tick == recorder.clock_samples.size() - 1 &&
+                       position.bar == position.tick / ticks_per_bar &&
+                       position.beat == (position.tick % ticks_per_bar) / TransportClock::PPQN &&
+                       position.tick_in_beat == position.tick % TransportClock::PPQN;
+
+    IntervalStats audio_stats = Measure(recorder.clock_send_us, ideal_us);
+    IntervalStats loop_stats = Measure(loop_send_us, ideal_us);
+
+    std::printf("block %d (%.1f us), %.2f BPM, ideal interval %.2f us, %zu clocks\n",
+                block, block_us, clock.GetTempo(), ideal_us, recorder.clock_samples.size());
+    PrintStats("audio timeline", audio_stats);
+    PrintStats("main loop", loop_stats);
+    std::printf("  drift: %+ld clocks, last clock %+.2f samples from ideal; position bar %u beat %u tick %u (%s)\n",
+                clock_error, last_error_samples, position.bar + 1, position.beat + 1, position.tick_in_beat,
+                position_ok ? "ok" : "WRONG");
+
+    // One sample of slack for the fixed point rounding of the clock placement
+    bool jitter_ok = audio_stats.worst_error_us <= block_us + us_per_sample;
+    // Placement rounds down to a sample, the 16.16 interval is off by up to half an LSB per clock
+    double drift_limit = 1.0 + recorder.clock_samples.size() * 0.5 / 65536.0;
+    bool drift_ok = clock_error == 0 && std::fabs(last_error_samples) <= drift_limit;
+    bool start_ok = recorder.first_status == 0xFA && recorder.other_bytes == 1 &&
+                    !recorder.clock_samples.empty() && recorder.clock_samples[0] == 0;
+    if (!jitter_ok) std::printf("  FAIL: audio timeline jitter exceeds one block\n");
+    if (!drift_ok) std::printf("  FAIL: clock drifted\n");
+    if (!start_ok) std::printf("  FAIL: START and first clock not on sample 0\n");
+    if (!position_ok) std::printf("  FAIL: song position does not match the clock count\n");
+    return jitter_ok && drift_ok && start_ok && position_ok;
+}
+
+void PrintUsage() {
+    std::printf("usage: clock_jitter [--bpm t] [--block frames] [--seconds s] [--loop-period us] [--ui-stall us]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--bpm") == 0 && value) {
+            options.bpm = static_cast<float>(std::atof(value)); i++;
+        } else if (std::strcmp(arg, "--block") == 0 && value) {
+            options.block = std::atoi(value); i++;
+        } else if (std::strcmp(arg, "--seconds") == 0 && value) {
+            options.seconds = static_cast<float>(std::atof(value)); i++;
+        } else if (std::strcmp(arg, "--loop-period") == 0 && value) {
+            options.loop_period_us = std::atof(value); i++;
+        } else if (std::strcmp(arg, "--ui-stall") == 0 && value) {
+            options.ui_stall_us = std::atof(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (options.block < 0 || options.block > 256 || options.seconds <= 0.0f || options.loop_period_us <= 0.0) {
+        PrintUsage();
+        return 1;
+    }
+
+    bool ok = true;
+    if (options.block == 0) {
+        const int blocks[] = {4, 16, 48, 64};
+        for (int block : blocks) {
+            ok = RunBlockSize(options, block) && ok;
+        }
+    } else {
+        ok = RunBlockSize(options, options.block);
+    }
+    return ok ? 0 : 1;
+}
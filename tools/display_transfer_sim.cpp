@@ -0,0 +1,170 @@
+/**
+ * Display Transfer Sim - Blocking vs background OLED frame transfers on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/io -o build/display_transfer_sim tools/display_transfer_sim.cpp src/core/io/oled_transfer.cpp src/core/io/frame_diff.cpp
+ *
+ * Usage:
+ *   display_transfer_sim [options]
+ *
+ * Options:
+ *   --ns-per-byte <ns>     SPI time per byte (default 640, ~12.5 Mbit/s)
+ *   --setup-ns <ns>        Per-transmit overhead: D/C switch, DMA start, interrupt (default 2000)
+ *   --interval-us <us>     Time between rendered frames (default 50000, 20 Hz)
+ *   --frames <n>           Frames per scenario (default 200)
+ *
+ * Runs OledTransfer over FakeOledBus in two scenarios (chord name change,
+ * full-screen change). Each is run twice: once waiting for the transfer
+ * like the old blocking driver, and once continuing while the bus works.
+ * Reports main loop stall per frame, how much of the transfer overlapped
+ * other work, and frames queued behind a busy bus. Also checks that the
+ * simulated panel RAM ends up equal to the last frame.
+ */
+
+#include "oled_transfer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t LOOP_PERIOD_NS = 1000000;   // 1 kHz main loop tasks
+
+enum class Scenario { CHORD_NAME, FULL_SCREEN };
+
+// Chord name: big text area (pages 2-4, columns 10-100) changes each frame,
+// system bar battery digit every 10th frame. Full screen: every byte changes.
+void DrawFrame(Scenario scenario, uint32_t frame_index, uint8_t* frame) {
+    if (scenario == Scenario::FULL_SCREEN) {
+        for (size_t i = 0; i < FrameDiff::FRAME_BYTES; i++) {
+            frame[i] = static_cast<uint8_t>(i * 7 + frame_index * 13 + 1);
+        }
+        return;
+    }
+
+    memset(frame, 0, FrameDiff::FRAME_BYTES);
+    for (size_t page = 2; page <= 4; page++) {
+        for (size_t col = 10; col <= 100; col++) {
+            frame[page * FrameDiff::WIDTH + col] = static_cast<uint8_t>((col + frame_index) * 31);
+        }
+    }
+    frame[110] = static_cast<uint8_t>(frame_index / 10);
+}
+
+struct Result {
+    uint64_t worst_stall_ns;
+    uint64_t total_stall_ns;
+    uint64_t bus_busy_ns;
+    uint32_t busy_submits;
+    uint32_t average_frame_bytes;
+    bool ram_matches;
+};
+
+Result Run(Scenario scenario, bool blocking, uint32_t ns_per_byte, uint32_t setup_ns,
+           uint64_t interval_ns, uint32_t frames) {
+    static uint8_t back[FrameDiff::FRAME_BYTES];
+    static uint8_t front[FrameDiff::FRAME_BYTES];
+    static uint8_t commands[OledTransfer::COMMAND_BUFFER_BYTES];
+    memset(front, 0, sizeof(front));
+
+    OledTransfer transfer;
+    FakeOledBus bus;
+    bus.Init(&transfer, ns_per_byte, setup_ns);
+    transfer.Init(&bus, front, commands);
+
+    Result result;
+    memset(&result, 0, sizeof(result));
+
+    uint64_t now = 0;
+    uint64_t next_frame = 0;
+    uint32_t drawn = 0;
+    uint64_t end = interval_ns * frames + 100 * LOOP_PERIOD_NS;
+    while (now < end) {
+        bus.Advance(now);
+        transfer.SubmitPending();   // DisplayManager::Update()
+
+        if (drawn < frames && now >= next_frame && !transfer.IsBusy()) {
+            DrawFrame(scenario, drawn, back);
+            transfer.Submit(back);
+            drawn++;
+            next_frame += interval_ns;
+
+            if (blocking) {
+                // Old driver: main loop waits for the last byte
+                uint64_t start = now;
+                while (transfer.IsBusy()) {
+                    now += 1000;
+                    bus.Advance(now);
+                }
+                uint64_t stall = now - start;
+                result.total_stall_ns += stall;
+                if (stall > result.worst_stall_ns) result.worst_stall_ns = stall;
+            }
+        } else if (drawn < frames && now >= next_frame) {
+            result.busy_submits++;   // UIManager skips this render
+        }
+
+        now += LOOP_PERIOD_NS;
+    }
+    bus.Advance(now);
+
+    result.bus_busy_ns = bus.GetBusyNs();
+    result.average_frame_bytes = transfer.GetFrameDiff().GetAverageFrameBytes();
+    result.ram_matches = memcmp(bus.GetRam(), back, FrameDiff::FRAME_BYTES) == 0;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t ns_per_byte = 640;
+    uint32_t setup_ns = 2000;
+    uint64_t interval_ns = 50000ull * 1000;
+    uint32_t frames = 200;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ns-per-byte") == 0 && i + 1 < argc) {
+            ns_per_byte = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--setup-ns") == 0 && i + 1 < argc) {
+            setup_ns = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--interval-us") == 0 && i + 1 < argc) {
+            interval_ns = strtoull(argv[++i], nullptr, 10) * 1000;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: display_transfer_sim [--ns-per-byte ns] [--setup-ns ns] "
+                            "[--interval-us us] [--frames n]\n");
+            return 1;
+        }
+    }
+    if (frames == 0 || interval_ns == 0) {
+        fprintf(stderr, "display_transfer_sim: frames and interval must be > 0\n");
+        return 1;
+    }
+
+    printf("%u ns/byte, %u ns/transmit, frame every %llu us, %u frames\n",
+           ns_per_byte, setup_ns, static_cast<unsigned long long>(interval_ns / 1000), frames);
+    printf("scenario     transfer   bytes/frame  stall avg/worst (us)  overlapped  skipped  panel\n");
+
+    const Scenario scenarios[] = {Scenario::CHORD_NAME, Scenario::FULL_SCREEN};
+    const char* names[] = {"chord name", "full screen"};
+    bool all_match = true;
+    for (int s = 0; s < 2; s++) {
+        for (int b = 1; b >= 0; b--) {
+            bool blocking = (b == 1);
+            Result r = Run(scenarios[s], blocking, ns_per_byte, setup_ns, interval_ns, frames);
+            double overlapped = r.bus_busy_ns > 0
+                                    ? 100.0 * (1.0 - static_cast<double>(r.total_stall_ns) / r.bus_busy_ns)
+                                    : 100.0;
+            if (overlapped < 0.0) overlapped = 0.0;
+            printf("%-12s %-10s %11u  %9.1f / %-9.1f  %9.1f%%  %7u  %s\n",
+                   names[s], blocking ? "blocking" : "dma",
+                   r.average_frame_bytes,
+                   static_cast<double>(r.total_stall_ns) / frames / 1000.0,
+                   static_cast<double>(r.worst_stall_ns) / 1000.0,
+                   overlapped, r.busy_submits, r.ram_matches ? "ok" : "MISMATCH");
+            all_match = all_match && r.ram_matches;
+        }
+    }
+    return all_match ? 0 : 1;
+}
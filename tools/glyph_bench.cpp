@@ -0,0 +1,219 @@
+/**
+ * Glyph Bench - Pixel-by-pixel text drawing vs the page-format blitter on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/io -o build/glyph_bench tools/glyph_bench.cpp src/core/io/page_blitter.cpp
+ *
+ * Usage:
+ *   glyph_bench [--iterations <n>]
+ *
+ * The pixel path is a copy of OledDisplay::WriteChar drawing through the
+ * SSD130x driver's DrawPixel, which is what the UI used before. The fonts
+ * are synthetic (random rows) at the sizes of Font_6x8 and Font_11x18;
+ * drawing cost doesn't depend on the glyph shapes. Each case is checked
+ * to produce the same framebuffer on both paths, then timed.
+ */
+
+#include "page_blitter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr int WIDTH = PageBlitter::WIDTH;
+constexpr int HEIGHT = PageBlitter::HEIGHT;
+constexpr size_t FRAME_BYTES = WIDTH * PageBlitter::PAGE_COUNT;
+
+struct Font {
+    uint8_t width;
+    uint8_t height;
+    uint16_t rows[PackedFont::GLYPH_COUNT * PackedFont::MAX_HEIGHT];
+};
+
+void MakeFont(Font& font, uint8_t width, uint8_t height, uint32_t seed) {
+    font.width = width;
+    font.height = height;
+    uint16_t used = static_cast<uint16_t>(0xFFFF << (16 - width));
+    for (size_t i = 0; i < PackedFont::GLYPH_COUNT * height; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        font.rows[i] = static_cast<uint16_t>(seed >> 16) & used;
+    }
+}
+
+// --- Pixel path: SSD130xDriver::DrawPixel + OledDisplay::WriteChar/WriteString ---
+
+void DrawPixel(uint8_t* buffer, int x, int y, bool on) {
+    if (x >= WIDTH || y >= HEIGHT) return;
+    if (on) {
+        buffer[x + (y / 8) * WIDTH] |= 1 << (y % 8);
+    } else {
+        buffer[x + (y / 8) * WIDTH] &= ~(1 << (y % 8));
+    }
+}
+
+bool WriteChar(uint8_t* buffer, int& cursor_x, int cursor_y, char ch, const Font& font, bool on) {
+    if (ch < 32 || ch > 126) return false;
+    if (WIDTH < cursor_x + font.width || HEIGHT < cursor_y + font.height) return false;
+
+    for (int i = 0; i < font.height; i++) {
+        uint32_t b = font.rows[(ch - 32) * font.height + i];
+        for (int j = 0; j < font.width; j++) {
+            DrawPixel(buffer, cursor_x + j, cursor_y + i, ((b << j) & 0x8000) ? on : !on);
+        }
+    }
+    cursor_x += font.width;
+    return true;
+}
+
+void WriteString(uint8_t* buffer, int x, int y, const char* text, const Font& font, bool on) {
+    while (*text) {
+        if (!WriteChar(buffer, x, y, *text, font, on)) return;
+        text++;
+    }
+}
+
+void PixelRect(uint8_t* buffer, int x0, int y0, int x1, int y1, bool on) {
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            DrawPixel(buffer, x, y, on);
+        }
+    }
+}
+
+// --- Cases ---
+
+struct TextCase {
+    const char* name;
+    const Font* font;
+    int y;
+    const char* text;
+};
+
+volatile uint8_t sink;
+
+template <typename Draw>
+double TimeNs(Draw draw, uint32_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        draw(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t iterations = 200000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: glyph_bench [--iterations n]\n");
+            return 1;
+        }
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "glyph_bench: iterations must be > 0\n");
+        return 1;
+    }
+
+    static Font small, large;
+    MakeFont(small, 6, 8, 1);
+    MakeFont(large, 11, 18, 2);
+
+    static uint32_t small_columns[PackedFont::GLYPH_COUNT * 6];
+    static uint32_t large_columns[PackedFont::GLYPH_COUNT * 11];
+    PackedFont packed_small, packed_large;
+    packed_small.Init(small.rows, 6, 8, small_columns, PackedFont::GLYPH_COUNT * 6);
+    packed_large.Init(large.rows, 11, 18, large_columns, PackedFont::GLYPH_COUNT * 11);
+
+    static uint8_t pixel_frame[FRAME_BYTES];
+    static uint8_t blit_frame[FRAME_BYTES];
+    PageBlitter blitter;
+    blitter.Init(blit_frame);
+
+    // System bar (page boundary), menu rows (off it), chord name in chord and key-less layout
+    const TextCase cases[] = {
+        {"6x8 aligned",   &small, 0,  "> Chord Mapping [ON]"},
+        {"6x8 unaligned", &small, 10, "> Chord Mapping [ON]"},
+        {"11x18 chord",   &large, 29, "Cmaj7 1st"},
+        {"11x18 page top", &large, 24, "Cmaj7 1st"},
+    };
+
+    printf("%u iterations per case\n", iterations);
+    printf("case            glyphs   pixel (glyph/s)  blitter (glyph/s)  speedup  match\n");
+
+    bool all_match = true;
+    for (const TextCase& c : cases) {
+        const PackedFont& packed = (c.font == &small) ? packed_small : packed_large;
+        size_t glyphs = strlen(c.text);
+        int max_x = WIDTH - static_cast<int>(glyphs) * c.font->width;
+        if (max_x < 0) max_x = 0;
+
+        // Same output on both paths, both colours, every x offset
+        bool match = true;
+        for (int on = 0; on <= 1 && match; on++) {
+            for (int x = 0; x <= max_x && match; x++) {
+                memset(pixel_frame, 0x5A, FRAME_BYTES);
+                memset(blit_frame, 0x5A, FRAME_BYTES);
+                WriteString(pixel_frame, x, c.y, c.text, *c.font, on != 0);
+                blitter.DrawString(x, c.y, c.text, packed, on != 0);
+                match = memcmp(pixel_frame, blit_frame, FRAME_BYTES) == 0;
+            }
+        }
+        all_match = all_match && match;
+
+        double pixel_ns = TimeNs([&](uint32_t i) {
+            WriteString(pixel_frame, static_cast<int>(i % (max_x + 1)), c.y, c.text, *c.font, true);
+            sink = pixel_frame[i % FRAME_BYTES];
+        }, iterations);
+        double blit_ns = TimeNs([&](uint32_t i) {
+            blitter.DrawString(static_cast<int>(i % (max_x + 1)), c.y, c.text, packed, true);
+            sink = blit_frame[i % FRAME_BYTES];
+        }, iterations);
+
+        double total_glyphs = static_cast<double>(glyphs) * iterations;
+        printf("%-15s%7zu  %15.3g  %17.3g  %6.1fx  %s\n", c.name, glyphs,
+               total_glyphs / (pixel_ns * 1e-9), total_glyphs / (blit_ns * 1e-9),
+               pixel_ns / blit_ns, match ? "ok" : "MISMATCH");
+    }
+
+    // Rects: system bar divider, menu scrollbar thumb, a content-area clear
+    struct RectCase { const char* name; int x0, y0, x1, y1; };
+    const RectCase rects[] = {
+        {"hline 128",     0, 7, 127, 7},
+        {"vline 2x20",    126, 23, 127, 42},
+        {"rect 128x48",   0, 10, 127, 57},
+    };
+    printf("\ncase            pixel (rect/s)   blitter (rect/s)  speedup  match\n");
+    for (const RectCase& r : rects) {
+        memset(pixel_frame, 0x5A, FRAME_BYTES);
+        memset(blit_frame, 0x5A, FRAME_BYTES);
+        PixelRect(pixel_frame, r.x0, r.y0, r.x1, r.y1, true);
+        blitter.FillRect(r.x0, r.y0, r.x1, r.y1, true);
+        if (r.x1 - r.x0 >= 2) {
+            // Clear the inside again to check the off path
+            PixelRect(pixel_frame, r.x0 + 1, r.y0, r.x1 - 1, r.y1, false);
+            blitter.FillRect(r.x0 + 1, r.y0, r.x1 - 1, r.y1, false);
+        }
+        bool match = memcmp(pixel_frame, blit_frame, FRAME_BYTES) == 0;
+        all_match = all_match && match;
+
+        double pixel_ns = TimeNs([&](uint32_t i) {
+            PixelRect(pixel_frame, r.x0, r.y0, r.x1, r.y1, (i & 1) != 0);
+            sink = pixel_frame[i % FRAME_BYTES];
+        }, iterations);
+        double blit_ns = TimeNs([&](uint32_t i) {
+            blitter.FillRect(r.x0, r.y0, r.x1, r.y1, (i & 1) != 0);
+            sink = blit_frame[i % FRAME_BYTES];
+        }, iterations);
+        printf("%-14s %15.3g  %17.3g  %6.1fx  %s\n", r.name,
+               iterations / (pixel_ns * 1e-9), iterations / (blit_ns * 1e-9),
+               pixel_ns / blit_ns, match ? "ok" : "MISMATCH");
+    }
+
+    return all_match ? 0 : 1;
+}
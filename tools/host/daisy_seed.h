@@ -0,0 +1,283 @@
+#pragma once
+
+/**
+ * Host libDaisy - The parts of daisy_seed.h the firmware uses, for host builds
+ *
+ * Lets src/ (except main.cpp) compile and link on a desktop machine so host
+ * tools can drive the real managers and UI. Peripherals are inert: GPIO
+ * reads idle, the ADC reads 0, the encoder never turns, init calls succeed.
+ * Host tools can close a switch between two pins (GPIO::HostSetSwitch, e.g.
+ * a key of the matrix) and fire a timer's interrupt (TimerHandle::HostElapse).
+ * System::GetNow()/GetUs() are real time since start plus all delays:
+ * DelayMs() moves the clock forward instead of sleeping, so the firmware's
+ * init delays cost nothing on host. Audio is not run.
+ *
+ * Only what the firmware calls is here; it is not a libDaisy emulation.
+ * Add to it when new code uses more of the API.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#define DMA_BUFFER_MEM_SECTION
+#define DSY_SDRAM_BSS
+
+namespace daisy {
+
+enum GPIOPort { PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG, PORTH, PORTI, PORTJ, PORTK, PORTX };
+
+struct Pin {
+    GPIOPort port;
+    uint8_t pin;
+
+    constexpr Pin() : port(PORTX), pin(255) {}
+    constexpr Pin(GPIOPort p, uint8_t n) : port(p), pin(n) {}
+    constexpr bool IsValid() const { return port != PORTX && pin < 16; }
+};
+
+class GPIO {
+public:
+    enum class Mode { INPUT, OUTPUT, OPEN_DRAIN, ANALOG };
+    enum class Pull { NOPULL, PULLUP, PULLDOWN };
+    enum class Speed { LOW, MEDIUM, HIGH, VERY_HIGH };
+
+    GPIO() = default;
+    GPIO(const GPIO&) = delete;
+    GPIO& operator=(const GPIO&) = delete;
+    ~GPIO() { DeInit(); }
+
+    void Init(Pin p, Mode m = Mode::INPUT, Pull pu = Pull::NOPULL, Speed sp = Speed::LOW) {
+        (void)sp;
+        DeInit();
+        mode_ = m;
+        state_ = (pu == Pull::PULLUP);
+        if (p.IsValid()) {
+            index_ = p.port * 16 + p.pin;
+            pins_[index_] = this;
+        }
+    }
+    void DeInit() {
+        if (index_ >= 0 && pins_[index_] == this) pins_[index_] = nullptr;
+        index_ = -1;
+    }
+    bool Read() {
+        // A closed switch to an output driven low pulls an input low
+        if (mode_ == Mode::INPUT && index_ >= 0) {
+            for (const Switch& sw : switches_) {
+                int other = sw.a == index_ ? sw.b : (sw.b == index_ ? sw.a : -1);
+                if (sw.used && sw.closed && other >= 0 && pins_[other] && pins_[other]->mode_ != Mode::INPUT &&
+                    !pins_[other]->state_) {
+                    return false;
+                }
+            }
+        }
+        return state_;
+    }
+    void Write(bool state) { if (mode_ != Mode::INPUT) state_ = state; }
+    void Toggle() { Write(!state_); }
+
+    // Host only: open or close a switch (a key) between two pins
+    static void HostSetSwitch(Pin a, Pin b, bool closed) {
+        const int ia = a.port * 16 + a.pin;
+        const int ib = b.port * 16 + b.pin;
+        for (Switch& sw : switches_) {
+            if (sw.used && ((sw.a == ia && sw.b == ib) || (sw.a == ib && sw.b == ia))) {
+                sw.closed = closed;
+                return;
+            }
+        }
+        for (Switch& sw : switches_) {
+            if (!sw.used) {
+                sw = {ia, ib, closed, true};
+                return;
+            }
+        }
+    }
+
+private:
+    struct Switch {
+        int a;
+        int b;
+        bool closed;
+        bool used;
+    };
+    static constexpr int PIN_COUNT = PORTX * 16;
+    static inline GPIO* pins_[PIN_COUNT] = {};
+    static inline Switch switches_[32] = {};
+
+    Mode mode_ = Mode::INPUT;
+    bool state_ = false;       // Inputs read their pull level (buttons released)
+    int index_ = -1;
+};
+
+class Encoder {
+public:
+    void Init(Pin a, Pin b, Pin click, float update_rate = 0.0f) { (void)a; (void)b; (void)click; (void)update_rate; }
+    void Debounce() {}
+    int32_t Increment() const { return 0; }
+    bool RisingEdge() const { return false; }
+    bool FallingEdge() const { return false; }
+    bool Pressed() const { return false; }
+    float TimeHeldMs() const { return 0.0f; }
+};
+
+class AdcChannelConfig {
+public:
+    void InitSingle(Pin pin) { (void)pin; }
+};
+
+class AdcHandle {
+public:
+    enum OverSampling { OVS_NONE, OVS_4, OVS_8, OVS_16, OVS_32, OVS_64, OVS_128, OVS_256, OVS_512, OVS_1024 };
+
+    void Init(AdcChannelConfig* cfg, size_t num_channels, OverSampling ovs = OVS_32) { (void)cfg; (void)num_channels; (void)ovs; }
+    void Start() {}
+    void Stop() {}
+    // Mid-scale on every channel: the joystick at rest in the centre
+    uint16_t Get(uint8_t chn) const { (void)chn; return 0x8000; }
+    float GetFloat(uint8_t chn) const { (void)chn; return 0.5f; }
+};
+
+class System {
+public:
+    // Time since start plus delays (host_daisy.cpp)
+    static uint32_t GetNow();
+    static uint32_t GetUs();
+    static uint32_t GetTick() { return GetUs(); }
+    static void Delay(uint32_t delay_ms);
+    static void DelayUs(uint32_t delay_us);
+    static uint32_t GetPClk1Freq() { return 120000000; }
+    static uint32_t GetTickFreq() { return 1000000; }
+};
+
+class TimerHandle {
+public:
+    struct Config {
+        enum class Peripheral { TIM_2, TIM_3, TIM_4, TIM_5 };
+        enum class CounterDir { UP, DOWN };
+        Peripheral periph = Peripheral::TIM_2;
+        CounterDir dir = CounterDir::UP;
+        uint32_t period = 0xFFFFFFFF;
+        bool enable_irq = false;
+    };
+    enum class Result { OK, ERR };
+    typedef void (*PeriodElapsedCallback)(void* data);
+
+    Result Init(const Config& config) { config_ = config; return Result::OK; }
+    void SetCallback(PeriodElapsedCallback cb, void* data = nullptr) { callback_ = cb; data_ = data; }
+    Result Start() { running_[static_cast<int>(config_.periph)] = this; return Result::OK; }
+    Result Stop() {
+        if (running_[static_cast<int>(config_.periph)] == this) running_[static_cast<int>(config_.periph)] = nullptr;
+        return Result::OK;
+    }
+    Result SetPeriod(uint32_t ticks) { config_.period = ticks; return Result::OK; }
+    uint32_t GetTick() { return System::GetUs(); }
+
+    // Host only: run the period interrupt of the started timer on periph
+    static void HostElapse(Config::Peripheral periph) {
+        TimerHandle* timer = running_[static_cast<int>(periph)];
+        if (timer && timer->config_.enable_irq && timer->callback_) timer->callback_(timer->data_);
+    }
+
+private:
+    Config config_;
+    PeriodElapsedCallback callback_ = nullptr;
+    void* data_ = nullptr;
+    static inline TimerHandle* running_[4] = {};
+};
+
+class SpiHandle {
+public:
+    struct Config {
+        enum class Peripheral { SPI_1, SPI_2, SPI_3, SPI_4, SPI_5, SPI_6 };
+        enum class Mode { MASTER, SLAVE };
+        enum class Direction { TWO_LINES, TWO_LINES_TX_ONLY, TWO_LINES_RX_ONLY, ONE_LINE };
+        enum class BaudPrescaler { PS_2, PS_4, PS_8, PS_16, PS_32, PS_64, PS_128, PS_256 };
+        struct {
+            Pin sclk, miso, mosi, nss;
+        } pin_config;
+        Peripheral periph = Peripheral::SPI_1;
+        Mode mode = Mode::MASTER;
+        Direction direction = Direction::TWO_LINES_TX_ONLY;
+        BaudPrescaler baud_prescaler = BaudPrescaler::PS_8;
+    };
+    enum class Result { OK, ERR };
+    typedef void (*StartCallbackFunctionPtr)(void* context);
+    typedef void (*EndCallbackFunctionPtr)(void* context, Result result);
+
+    Result Init(const Config& config) { (void)config; return Result::OK; }
+    Result BlockingTransmit(uint8_t* buff, size_t size, uint32_t timeout = 100) {
+        (void)buff; (void)size; (void)timeout;
+        return Result::OK;
+    }
+
+    // The bytes are "sent" at once: the end callback runs before this returns
+    Result DmaTransmit(uint8_t* buff, size_t size, StartCallbackFunctionPtr start_callback,
+                       EndCallbackFunctionPtr end_callback, void* callback_context) {
+        (void)buff; (void)size;
+        if (start_callback) start_callback(callback_context);
+        if (end_callback) end_callback(callback_context, Result::OK);
+        return Result::OK;
+    }
+};
+
+class UartHandler {
+public:
+    struct Config {
+        enum class Peripheral { USART_1, USART_2, USART_3, UART_4, UART_5, USART_6, UART_7, UART_8, LPUART_1 };
+    };
+};
+
+class AudioHandle {
+public:
+    typedef const float* const* InputBuffer;
+    typedef float** OutputBuffer;
+    typedef void (*AudioCallback)(InputBuffer in, OutputBuffer out, size_t size);
+};
+
+class DaisySeed {
+public:
+    AdcHandle adc;
+    System system;
+
+    void Init(bool boost = false) { (void)boost; }
+    void DelayMs(size_t del) { System::Delay(static_cast<uint32_t>(del)); }
+    void SetLed(bool state) { (void)state; }
+    static Pin GetPin(uint8_t pin_idx) { (void)pin_idx; return Pin(); }
+
+    void StartAudio(AudioHandle::AudioCallback cb) { (void)cb; }
+    void StopAudio() {}
+    void SetAudioBlockSize(size_t blocksize) { block_size_ = blocksize; }
+    size_t AudioBlockSize() { return block_size_; }
+    float AudioSampleRate() { return 48000.0f; }
+    float AudioCallbackRate() { return AudioSampleRate() / block_size_; }
+
+    static void StartLog(bool wait_for_pc = false) { (void)wait_for_pc; }
+    static void PrintLine(const char* format, ...) { (void)format; }
+    static void Print(const char* format, ...) { (void)format; }
+
+private:
+    size_t block_size_ = 48;
+};
+
+namespace seed {
+constexpr Pin D0{PORTB, 12}, D1{PORTC, 11}, D2{PORTC, 10}, D3{PORTC, 9}, D4{PORTC, 8},
+    D5{PORTD, 2}, D6{PORTC, 12}, D7{PORTG, 10}, D8{PORTG, 11}, D9{PORTB, 4},
+    D10{PORTB, 5}, D11{PORTB, 8}, D12{PORTB, 9}, D13{PORTB, 6}, D14{PORTB, 7},
+    D15{PORTC, 0}, D16{PORTA, 3}, D17{PORTB, 1}, D18{PORTA, 7}, D19{PORTA, 6},
+    D20{PORTC, 1}, D21{PORTC, 4}, D22{PORTA, 5}, D23{PORTA, 4}, D24{PORTA, 1},
+    D25{PORTA, 0}, D26{PORTD, 11}, D27{PORTG, 9}, D28{PORTA, 2}, D29{PORTB, 14},
+    D30{PORTB, 15};
+constexpr Pin A0 = D15, A1 = D16, A2 = D17, A3 = D18, A4 = D19, A5 = D20, A6 = D21,
+    A7 = D22, A8 = D23, A9 = D24, A10 = D25, A11 = D28;
+} // namespace seed
+
+} // namespace daisy
+
+// CMSIS intrinsics used by the firmware
+inline void __WFI() {}
+inline void __disable_irq() {}
+inline void __enable_irq() {}
@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * Host DaisySP - Inert DSP modules for host builds
+ *
+ * The classes the plugins use, with DaisySP's method signatures. Nothing
+ * is synthesised: oscillators and envelopes output 0, effects pass their
+ * input through. Enough to construct and configure the audio plugins on
+ * host (e.g. to drive their settings menus), not to listen to them.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace daisysp {
+
+class Oscillator {
+public:
+    enum { WAVE_SIN, WAVE_TRI, WAVE_SAW, WAVE_RAMP, WAVE_SQUARE, WAVE_POLYBLEP_TRI,
+           WAVE_POLYBLEP_SAW, WAVE_POLYBLEP_SQUARE, WAVE_LAST };
+
+    void Init(float sample_rate) { (void)sample_rate; }
+    void SetFreq(float f) { (void)f; }
+    void SetAmp(float a) { (void)a; }
+    void SetWaveform(uint8_t wf) { (void)wf; }
+    void SetPw(float pw) { (void)pw; }
+    void Reset(float phase = 0.0f) { (void)phase; }
+    float Process() { return 0.0f; }
+};
+
+class Adsr {
+public:
+    void Init(float sample_rate, int blockSize = 1) { (void)sample_rate; (void)blockSize; }
+    void Retrigger(bool hard) { (void)hard; }
+    void SetAttackTime(float timeInS, float shape = 0.0f) { (void)timeInS; (void)shape; }
+    void SetDecayTime(float timeInS) { (void)timeInS; }
+    void SetReleaseTime(float timeInS) { (void)timeInS; }
+    void SetSustainLevel(float sus_level) { (void)sus_level; }
+    float Process(bool gate) { running_ = gate; return 0.0f; }
+    bool IsRunning() const { return running_; }
+
+private:
+    bool running_ = false;
+};
+
+class Svf {
+public:
+    void Init(float sample_rate) { (void)sample_rate; }
+    void Process(float in) { low_ = in; }
+    void SetFreq(float f) { (void)f; }
+    void SetRes(float r) { (void)r; }
+    void SetDrive(float d) { (void)d; }
+    float Low() { return low_; }
+    float High() { return 0.0f; }
+    float Band() { return 0.0f; }
+
+private:
+    float low_ = 0.0f;
+};
+
+template <typename T, size_t max_size>
+class DelayLine {
+public:
+    void Init() {}
+    void Reset() {}
+    void SetDelay(size_t delay) { (void)delay; }
+    void SetDelay(float delay) { (void)delay; }
+    void Write(const T sample) { (void)sample; }
+    T Read() const { return T(0); }
+    T Read(float delay) const { (void)delay; return T(0); }
+};
+
+class Autowah {
+public:
+    void Init(float sample_rate) { (void)sample_rate; }
+    float Process(float in) { return in; }
+    void SetWah(float wah) { (void)wah; }
+    void SetDryWet(float drywet) { (void)drywet; }
+    void SetLevel(float level) { (void)level; }
+};
+
+class Chorus {
+public:
+    void Init(float sample_rate) { (void)sample_rate; }
+    float Process(float in) { left_ = in; right_ = in; return in; }
+    float GetLeft() { return left_; }
+    float GetRight() { return right_; }
+    void SetLfoDepth(float depth) { (void)depth; }
+    void SetLfoFreq(float freq) { (void)freq; }
+    void SetDelayMs(float ms) { (void)ms; }
+    void SetFeedback(float feedback) { (void)feedback; }
+
+private:
+    float left_ = 0.0f;
+    float right_ = 0.0f;
+};
+
+class Decimator {
+public:
+    void Init() {}
+    float Process(float input) { return input; }
+    void SetDownsampleFactor(float downsample_factor) { (void)downsample_factor; }
+    void SetBitcrushFactor(float bitcrush_factor) { (void)bitcrush_factor; }
+};
+
+class Flanger {
+public:
+    void Init(float sample_rate) { (void)sample_rate; }
+    float Process(float in) { return in; }
+    void SetFeedback(float feedback) { (void)feedback; }
+    void SetLfoDepth(float depth) { (void)depth; }
+    void SetLfoFreq(float freq) { (void)freq; }
+    void SetDelayMs(float ms) { (void)ms; }
+};
+
+class Overdrive {
+public:
+    void Init() {}
+    float Process(float in) { return in; }
+    void SetDrive(float drive) { (void)drive; }
+};
+
+class Phaser {
+public:
+    void Init(float sample_rate) { (void)sample_rate; }
+    float Process(float in) { return in; }
+    void SetPoles(int poles) { (void)poles; }
+    void SetLfoDepth(float depth) { (void)depth; }
+    void SetLfoFreq(float lfo_freq) { (void)lfo_freq; }
+    void SetFreq(float ap_freq) { (void)ap_freq; }
+    void SetFeedback(float feedback) { (void)feedback; }
+};
+
+class Tremolo {
+public:
+    void Init(float sample_rate) { (void)sample_rate; }
+    float Process(float in) { return in; }
+    void SetFreq(float freq) { (void)freq; }
+    void SetWaveform(int waveform) { (void)waveform; }
+    void SetDepth(float depth) { (void)depth; }
+};
+
+class Wavefolder {
+public:
+    void Init() {}
+    float Process(float in) { return in; }
+    void SetGain(float gain) { (void)gain; }
+    void SetOffset(float offset) { (void)offset; }
+};
+
+} // namespace daisysp
@@ -0,0 +1,185 @@
+#pragma once
+
+/**
+ * Host libDaisy - SSD130x driver and OledDisplay for host builds
+ *
+ * The driver keeps libDaisy's 128x64 page-format framebuffer (buffer_) and
+ * the drawing calls behave like libDaisy's (same pixel layout, opaque glyph
+ * cells, glyphs that don't fit are skipped), so a host frame is byte for
+ * byte what the firmware would send. The transport sends nothing.
+ */
+
+#include "daisy_seed.h"
+
+// libDaisy util/oled_fonts.h
+typedef struct {
+    const uint8_t FontWidth;
+    uint8_t FontHeight;
+    const uint16_t* data;
+} FontDef;
+
+extern "C" {
+extern FontDef Font_4x6;
+extern FontDef Font_6x8;
+extern FontDef Font_7x10;
+extern FontDef Font_11x18;
+extern FontDef Font_16x26;
+}
+
+namespace daisy {
+
+class SSD130x4WireSpiTransport {
+public:
+    struct Config {
+        SpiHandle::Config spi_config;
+        struct {
+            Pin dc;
+            Pin reset;
+        } pin_config;
+    };
+
+    void Init(const Config& config) { (void)config; }
+    void SendCommand(uint8_t cmd) { (void)cmd; }
+    void SendData(uint8_t* buff, size_t size) { (void)buff; (void)size; }
+};
+
+template <size_t width, size_t height, typename Transport>
+class SSD130xDriver {
+public:
+    struct Config {
+        typename Transport::Config transport_config;
+    };
+
+    void Init(Config config) {
+        transport_.Init(config.transport_config);
+        Fill(false);
+    }
+
+    size_t Width() const { return width; }
+    size_t Height() const { return height; }
+
+    void DrawPixel(uint_fast8_t x, uint_fast8_t y, bool on) {
+        if (x >= width || y >= height) return;
+        if (on) {
+            buffer_[x + (y / 8) * width] |= 1 << (y % 8);
+        } else {
+            buffer_[x + (y / 8) * width] &= ~(1 << (y % 8));
+        }
+    }
+
+    void Fill(bool on) {
+        memset(buffer_, on ? 0xFF : 0x00, sizeof(buffer_));
+    }
+
+    void Update() {
+        for (size_t page = 0; page < height / 8; page++) {
+            transport_.SendCommand(static_cast<uint8_t>(0xB0 + page));
+            transport_.SendCommand(0x00);
+            transport_.SendCommand(0x10);
+            transport_.SendData(&buffer_[width * page], width);
+        }
+    }
+
+protected:
+    Transport transport_;
+    uint8_t buffer_[width * height / 8];
+};
+
+using SSD130x4WireSpi128x64Driver = SSD130xDriver<128, 64, SSD130x4WireSpiTransport>;
+
+template <typename DisplayDriver>
+class OledDisplay {
+public:
+    struct Config {
+        typename DisplayDriver::Config driver_config;
+    };
+
+    void Init(Config config) {
+        driver_.Init(config.driver_config);
+        cursor_x_ = 0;
+        cursor_y_ = 0;
+    }
+
+    uint16_t Width() const { return static_cast<uint16_t>(driver_.Width()); }
+    uint16_t Height() const { return static_cast<uint16_t>(driver_.Height()); }
+
+    void Fill(bool on) { driver_.Fill(on); }
+    void DrawPixel(uint_fast8_t x, uint_fast8_t y, bool on) { driver_.DrawPixel(x, y, on); }
+
+    void DrawLine(uint_fast8_t x1, uint_fast8_t y1, uint_fast8_t x2, uint_fast8_t y2, bool on) {
+        int dx = abs(static_cast<int>(x2) - static_cast<int>(x1));
+        int dy = abs(static_cast<int>(y2) - static_cast<int>(y1));
+        int sx = x1 < x2 ? 1 : -1;
+        int sy = y1 < y2 ? 1 : -1;
+        int error = dx - dy;
+        int x = x1, y = y1;
+
+        DrawPixel(x2, y2, on);
+        while (x != x2 || y != y2) {
+            DrawPixel(x, y, on);
+            int error2 = error * 2;
+            if (error2 > -dy) {
+                error -= dy;
+                x += sx;
+            }
+            if (error2 < dx) {
+                error += dx;
+                y += sy;
+            }
+        }
+    }
+
+    void DrawRect(uint_fast8_t x1, uint_fast8_t y1, uint_fast8_t x2, uint_fast8_t y2, bool on,
+                  bool fill = false) {
+        if (x1 > x2) { uint_fast8_t t = x1; x1 = x2; x2 = t; }
+        if (y1 > y2) { uint_fast8_t t = y1; y1 = y2; y2 = t; }
+        if (fill) {
+            for (uint_fast8_t x = x1; x <= x2; x++) {
+                for (uint_fast8_t y = y1; y <= y2; y++) {
+                    DrawPixel(x, y, on);
+                }
+            }
+        } else {
+            DrawLine(x1, y1, x2, y1, on);
+            DrawLine(x2, y1, x2, y2, on);
+            DrawLine(x2, y2, x1, y2, on);
+            DrawLine(x1, y2, x1, y1, on);
+        }
+    }
+
+    void SetCursor(uint16_t x, uint16_t y) {
+        cursor_x_ = x;
+        cursor_y_ = y;
+    }
+
+    char WriteChar(char ch, FontDef font, bool on) {
+        if (ch < 32 || ch > 126) return 0;
+        if (Width() < cursor_x_ + font.FontWidth || Height() < cursor_y_ + font.FontHeight) return 0;
+
+        for (uint32_t i = 0; i < font.FontHeight; i++) {
+            uint32_t b = font.data[(ch - 32) * font.FontHeight + i];
+            for (uint32_t j = 0; j < font.FontWidth; j++) {
+                DrawPixel(cursor_x_ + j, cursor_y_ + i, ((b << j) & 0x8000) ? on : !on);
+            }
+        }
+        cursor_x_ += font.FontWidth;
+        return ch;
+    }
+
+    char WriteString(const char* str, FontDef font, bool on) {
+        while (*str) {
+            if (WriteChar(*str, font, on) != *str) return *str;
+            str++;
+        }
+        return *str;
+    }
+
+    void Update() { driver_.Update(); }
+
+private:
+    DisplayDriver driver_;
+    uint16_t cursor_x_ = 0;
+    uint16_t cursor_y_ = 0;
+};
+
+} // namespace daisy
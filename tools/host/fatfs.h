@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * Host libDaisy - SD card and FatFS stand-ins for host builds
+ *
+ * The SD card initialises but there is no file system on it: f_mount()
+ * reports FR_NOT_READY, so StorageManager runs in its "no card" state, and
+ * the file calls fail the same way. Host tools that need files implement
+ * OpenChord::IFileStream over stdio instead.
+ */
+
+#include "daisy_seed.h"
+
+typedef unsigned int UINT;
+typedef uint8_t BYTE;
+typedef uint32_t DWORD;
+typedef DWORD FSIZE_t;
+typedef char TCHAR;
+
+typedef enum {
+    FR_OK = 0, FR_DISK_ERR, FR_INT_ERR, FR_NOT_READY, FR_NO_FILE, FR_NO_PATH,
+    FR_INVALID_NAME, FR_DENIED, FR_EXIST, FR_INVALID_OBJECT, FR_WRITE_PROTECTED,
+    FR_INVALID_DRIVE, FR_NOT_ENABLED, FR_NO_FILESYSTEM, FR_MKFS_ABORTED, FR_TIMEOUT,
+    FR_LOCKED, FR_NOT_ENOUGH_CORE, FR_TOO_MANY_OPEN_FILES, FR_INVALID_PARAMETER
+} FRESULT;
+
+#define FM_FAT 0x01
+#define FM_FAT32 0x02
+#define FM_EXFAT 0x04
+#define FM_ANY 0x07
+#define FM_SFD 0x08
+
+#define FA_READ 0x01
+#define FA_WRITE 0x02
+#define FA_OPEN_EXISTING 0x00
+#define FA_CREATE_NEW 0x04
+#define FA_CREATE_ALWAYS 0x08
+#define FA_OPEN_ALWAYS 0x10
+#define FA_OPEN_APPEND 0x30
+
+typedef struct {
+    BYTE fs_type;
+} FATFS;
+
+typedef struct {
+    FSIZE_t fptr;
+    FSIZE_t obj_size;
+} FIL;
+
+#define f_size(fp) ((fp)->obj_size)
+#define f_tell(fp) ((fp)->fptr)
+
+inline FRESULT f_mount(FATFS* fs, const char* path, BYTE opt) {
+    (void)fs; (void)path; (void)opt;
+    return FR_NOT_READY;
+}
+
+inline FRESULT f_mkfs(const char* path, BYTE opt, DWORD au, void* work, UINT len) {
+    (void)path; (void)opt; (void)au; (void)work; (void)len;
+    return FR_NOT_READY;
+}
+
+inline FRESULT f_open(FIL* fp, const TCHAR* path, BYTE mode) {
+    (void)fp; (void)path; (void)mode;
+    return FR_NOT_READY;
+}
+
+inline FRESULT f_close(FIL* fp) {
+    (void)fp;
+    return FR_NOT_READY;
+}
+
+inline FRESULT f_read(FIL* fp, void* buff, UINT btr, UINT* br) {
+    (void)fp; (void)buff; (void)btr;
+    *br = 0;
+    return FR_NOT_READY;
+}
+
+inline FRESULT f_write(FIL* fp, const void* buff, UINT btw, UINT* bw) {
+    (void)fp; (void)buff; (void)btw;
+    *bw = 0;
+    return FR_NOT_READY;
+}
+
+inline FRESULT f_lseek(FIL* fp, FSIZE_t ofs) {
+    (void)fp; (void)ofs;
+    return FR_NOT_READY;
+}
+
+inline FRESULT f_mkdir(const TCHAR* path) {
+    (void)path;
+    return FR_NOT_READY;
+}
+
+namespace daisy {
+
+class SdmmcHandler {
+public:
+    enum class Result { OK, ERROR };
+    enum class BusWidth { BITS_1, BITS_4 };
+    enum class Speed { SLOW, MEDIUM_SLOW, STANDARD, FAST, VERY_FAST };
+
+    struct Config {
+        Speed speed;
+        BusWidth width;
+        bool clock_powersave;
+
+        void Defaults() {
+            speed = Speed::STANDARD;
+            width = BusWidth::BITS_4;
+            clock_powersave = false;
+        }
+    };
+
+    Result Init(const Config& cfg) { (void)cfg; return Result::OK; }
+};
+
+class FatFSInterface {
+public:
+    enum class Result { OK, ERR_TOO_MANY_VOLUMES, ERR_NO_MEDIA_SELECTED, ERR_GENERIC };
+
+    struct Config {
+        enum Media : uint8_t { MEDIA_SD = 0x01, MEDIA_USB = 0x02 };
+        uint8_t media;
+    };
+
+    Result Init(const Config& cfg) { (void)cfg; return Result::OK; }
+    Result Init(const uint8_t media) { (void)media; return Result::OK; }
+    const char* GetSDPath() const { return "0:/"; }
+    FATFS& GetSDFileSystem() { return sd_fs_; }
+
+private:
+    FATFS sd_fs_;
+};
+
+} // namespace daisy
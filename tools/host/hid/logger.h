@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * Host libDaisy - Logger for host builds
+ *
+ * Log lines go to stderr when OPENCHORD_HOST_LOG is defined, otherwise
+ * they are dropped so tool output stays readable.
+ */
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace daisy {
+
+enum LoggerDestination { LOGGER_NONE, LOGGER_INTERNAL, LOGGER_EXTERNAL, LOGGER_SEMIHOST };
+
+template <LoggerDestination dest>
+class Logger {
+public:
+    static void StartLog(bool wait_for_pc = false) { (void)wait_for_pc; }
+
+    static void PrintLine(const char* format, ...) {
+#ifdef OPENCHORD_HOST_LOG
+        va_list args;
+        va_start(args, format);
+        vfprintf(stderr, format, args);
+        va_end(args);
+        fputc('\n', stderr);
+#else
+        (void)format;
+#endif
+    }
+
+    static void Print(const char* format, ...) {
+#ifdef OPENCHORD_HOST_LOG
+        va_list args;
+        va_start(args, format);
+        vfprintf(stderr, format, args);
+        va_end(args);
+#else
+        (void)format;
+#endif
+    }
+};
+
+} // namespace daisy
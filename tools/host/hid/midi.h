@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * Host libDaisy - MIDI transports for host builds
+ *
+ * Nothing is received; transmitted bytes are counted and dropped. The USB
+ * transport packs each Tx() into one USB MIDI packet from the first message
+ * in the buffer, like libDaisy's, and logs the latest packets (for all USB
+ * transports, as there is one port) so host tools can check what would reach
+ * the computer.
+ */
+
+#include "daisy_seed.h"
+
+namespace daisy {
+
+enum MidiMessageType {
+    NoteOff, NoteOn, PolyphonicKeyPressure, ControlChange, ProgramChange,
+    ChannelPressure, PitchBend, SystemCommon, SystemRealTime, ChannelMode,
+    MessageLast,
+};
+
+class MidiUsbTransport {
+public:
+    typedef void (*MidiRxParseCallback)(uint8_t* data, size_t size, void* context);
+
+    struct Config {
+        enum Periph { INTERNAL = 0, EXTERNAL, HOST };
+        Periph periph = INTERNAL;
+        uint8_t tx_retry_count = 3;
+    };
+
+    void Init(Config config) { (void)config; }
+    void StartRx(MidiRxParseCallback callback, void* context) { (void)callback; (void)context; rx_active_ = true; }
+    bool RxActive() { return rx_active_; }
+    void FlushRx() {}
+    static constexpr size_t PACKET_LOG_SIZE = 64;
+
+    void Tx(uint8_t* buffer, size_t size) {
+        tx_bytes_ += size;
+        if (!buffer || size == 0) return;
+        // Cable 0, code index number from the status byte (0xF for a single byte)
+        uint8_t* packet = packets_[packet_count_ % PACKET_LOG_SIZE];
+        packet[0] = buffer[0] >= 0xF0 ? (size == 1 ? 0x0F : (size == 2 ? 0x02 : 0x03)) : buffer[0] >> 4;
+        for (size_t i = 0; i < 3; i++) packet[i + 1] = i < size ? buffer[i] : 0;
+        packet_count_++;
+        if (size > MessageSize(buffer[0])) lost_bytes_ += size - MessageSize(buffer[0]);
+    }
+
+    size_t GetTxBytes() const { return tx_bytes_; }
+    static size_t GetTxPacketCount() { return packet_count_; }
+    static size_t GetTxLostBytes() { return lost_bytes_; }   // Past the first message of a Tx()
+    static const uint8_t* GetTxPacket(size_t index) { return packets_[index % PACKET_LOG_SIZE]; }
+
+private:
+    bool rx_active_ = false;
+    size_t tx_bytes_ = 0;
+    static inline size_t packet_count_ = 0;
+    static inline size_t lost_bytes_ = 0;
+    static inline uint8_t packets_[PACKET_LOG_SIZE][4] = {};
+
+    static size_t MessageSize(uint8_t status) {
+        if (status >= 0xF8 || status == 0xF6) return 1;
+        if (status == 0xF1 || status == 0xF3) return 2;
+        if (status >= 0xF0) return 3;
+        return (status & 0xF0) == 0xC0 || (status & 0xF0) == 0xD0 ? 2 : 3;
+    }
+};
+
+class MidiUartTransport {
+public:
+    typedef void (*MidiRxParseCallback)(uint8_t* data, size_t size, void* context);
+
+    struct Config {
+        UartHandler::Config::Peripheral periph = UartHandler::Config::Peripheral::USART_1;
+        Pin rx;
+        Pin tx;
+    };
+
+    void Init(Config config) { (void)config; }
+    void StartRx(MidiRxParseCallback callback, void* context) { (void)callback; (void)context; rx_active_ = true; }
+    bool RxActive() { return rx_active_; }
+    void FlushRx() {}
+    void Tx(uint8_t* buffer, size_t size) { (void)buffer; tx_bytes_ += size; tx_count_++; }
+
+    size_t GetTxBytes() const { return tx_bytes_; }
+    static size_t GetTxCount() { return tx_count_; }   // Tx() calls on any UART transport
+
+private:
+    bool rx_active_ = false;
+    size_t tx_bytes_ = 0;
+    static inline size_t tx_count_ = 0;
+};
+
+} // namespace daisy
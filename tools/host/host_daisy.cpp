@@ -0,0 +1,137 @@
+/**
+ * Host libDaisy - System clock and OLED fonts for host builds
+ *
+ * The fonts are a stand-in: a classic 5x7 glyph set placed (and scaled up
+ * for the large sizes) into cells of libDaisy's font sizes. Widths and
+ * heights match, so layout and framebuffer traffic match the firmware;
+ * the glyph shapes don't. To draw with libDaisy's own fonts, build with
+ * -DHOST_DAISY_LIBDAISY_FONTS and add lib/libDaisy/src/util/oled_fonts.c.
+ */
+
+#include "daisy_seed.h"
+#include "dev/oled_ssd130x.h"
+#include <chrono>
+
+namespace daisy {
+
+namespace {
+
+const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+uint64_t skipped_us = 0;
+
+uint64_t ElapsedUs() {
+    auto elapsed = std::chrono::steady_clock::now() - start_time;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) + skipped_us;
+}
+
+} // namespace
+
+uint32_t System::GetNow() {
+    return static_cast<uint32_t>(ElapsedUs() / 1000);
+}
+
+uint32_t System::GetUs() {
+    return static_cast<uint32_t>(ElapsedUs());
+}
+
+void System::Delay(uint32_t delay_ms) {
+    skipped_us += static_cast<uint64_t>(delay_ms) * 1000;
+}
+
+void System::DelayUs(uint32_t delay_us) {
+    skipped_us += delay_us;
+}
+
+} // namespace daisy
+
+#ifndef HOST_DAISY_LIBDAISY_FONTS
+
+namespace {
+
+constexpr int GLYPH_COUNT = 95;   // ' ' to '~'
+
+// 5x7 glyphs, one byte per column, bit 0 = top row
+const uint8_t GLYPHS_5X7[GLYPH_COUNT][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+    {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+};
+
+// Row-major rows (libDaisy layout: leftmost pixel in bit 15) per font size
+uint16_t rows_4x6[GLYPH_COUNT * 6];
+uint16_t rows_6x8[GLYPH_COUNT * 8];
+uint16_t rows_7x10[GLYPH_COUNT * 10];
+uint16_t rows_11x18[GLYPH_COUNT * 18];
+uint16_t rows_16x26[GLYPH_COUNT * 26];
+
+// Scale each 5x7 glyph by the largest whole factor that leaves a one pixel
+// gap to the next cell, anchored at the cell's top left (clipped if too small)
+void BuildRows(uint16_t* rows, int width, int height) {
+    int scale = (width - 1) / 5 < (height - 1) / 7 ? (width - 1) / 5 : (height - 1) / 7;
+    if (scale < 1) scale = 1;
+
+    for (int glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+        for (int y = 0; y < height; y++) {
+            uint16_t bits = 0;
+            int src_row = y / scale;
+            for (int x = 0; x < width && x < 16; x++) {
+                int src_col = x / scale;
+                if (src_col < 5 && src_row < 7 && (GLYPHS_5X7[glyph][src_col] >> src_row) & 1) {
+                    bits |= static_cast<uint16_t>(0x8000 >> x);
+                }
+            }
+            rows[glyph * height + y] = bits;
+        }
+    }
+}
+
+struct FontBuilder {
+    FontBuilder() {
+        BuildRows(rows_4x6, 4, 6);
+        BuildRows(rows_6x8, 6, 8);
+        BuildRows(rows_7x10, 7, 10);
+        BuildRows(rows_11x18, 11, 18);
+        BuildRows(rows_16x26, 16, 26);
+    }
+};
+
+const FontBuilder font_builder;
+
+} // namespace
+
+FontDef Font_4x6 = {4, 6, rows_4x6};
+FontDef Font_6x8 = {6, 8, rows_6x8};
+FontDef Font_7x10 = {7, 10, rows_7x10};
+FontDef Font_11x18 = {11, 18, rows_11x18};
+FontDef Font_16x26 = {16, 26, rows_16x26};
+
+#endif
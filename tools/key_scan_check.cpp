@@ -0,0 +1,291 @@
+/**
+ * Key Scan Check - key matrix scanner debounce and edge timing on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/io -o build/key_scan_check tools/key_scan_check.cpp src/core/io/key_matrix_scanner.cpp
+ *
+ * Usage:
+ *   key_scan_check [--seconds <simulated time>] [--bounce-us <longest contact bounce>]
+ *
+ * Drives KeyMatrixScanner through FakeKeyMatrixGpio from a simulated 4 kHz
+ * scan timer on the 3x4 matrix (11 keys), with random strokes and chords
+ * whose contacts bounce on press and release, drained by a main loop with
+ * jittered passes. The run starts 10 s before the microsecond timer wraps.
+ * Checks:
+ *   - one press and one release edge per stroke, nothing from the unused key
+ *   - the press reported on the first scan that reads the contact closed,
+ *     the release once the bounce has settled and the integrator drained
+ *   - edge times taken back to the millisecond clock (as DigitalManager
+ *     stamps presses) stay right across the wrap
+ *   - a main loop that stops draining gets its lost edges counted
+ * Exits non-zero if a check fails.
+ */
+
+#include "key_matrix_scanner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int ROWS = 3;
+constexpr int COLS = 4;
+constexpr uint32_t TICK_US = 250;                           // 4 kHz, as DigitalManager
+constexpr uint32_t SCAN_US = TICK_US * ROWS;                // 750 us full scan
+constexpr uint8_t DEBOUNCE_SAMPLES = 7;                     // 5 ms at 750 us per scan
+constexpr uint64_t START_US = 0x100000000ull - 10000000ull; // 10 s before GetUs() wraps
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+bool IsValidKey(int row, int col) {
+    return !(row == 1 && col == 3);
+}
+
+uint64_t ValidMask() {
+    uint64_t mask = 0;
+    for (int row = 0; row < ROWS; row++) {
+        for (int col = 0; col < COLS; col++) {
+            if (IsValidKey(row, col)) mask |= 1ull << (row * KeyMatrixScanner::MAX_COLS + col);
+        }
+    }
+    return mask;
+}
+
+// Contact closes at press_us and opens at release_us, chattering for
+// bounce_us after each (the contact is closed the moment it first touches)
+struct Stroke {
+    uint64_t press_us;
+    uint64_t release_us;
+    uint32_t bounce_us;
+    uint64_t first_closed_read_us;   // First scan of its row that read it closed
+};
+
+bool ContactClosed(const Stroke& stroke, uint64_t now_us, uint32_t seed) {
+    if (now_us < stroke.press_us) return false;
+    if (now_us < stroke.press_us + stroke.bounce_us) {
+        if (now_us - stroke.press_us < 60) return true;
+        return ((now_us / 90) * 2654435761u + seed) % 3 != 0;
+    }
+    if (now_us < stroke.release_us) return true;
+    if (now_us < stroke.release_us + stroke.bounce_us) {
+        if (now_us - stroke.release_us < 60) return false;
+        return ((now_us / 70) * 2246822519u + seed) % 3 == 0;
+    }
+    return false;
+}
+
+struct Edge {
+    uint64_t time_us;       // Scan tick, full 64-bit time
+    uint32_t time_ms;       // EdgeTimeMs() at the drain
+    uint32_t old_ms;        // timestamp_us / 1000, the stamp before
+    bool pressed;
+};
+
+// Milliseconds since boot, as System::GetNow()
+uint32_t NowMs(uint64_t now_us) {
+    return static_cast<uint32_t>(now_us / 1000);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 60.0;
+    uint32_t max_bounce_us = 2000;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--bounce-us") == 0 && i + 1 < argc) {
+            max_bounce_us = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else {
+            std::printf("usage: key_scan_check [--seconds s] [--bounce-us us]\n");
+            return 1;
+        }
+    }
+    if (seconds <= 0.0) seconds = 60.0;
+    // Bounce must settle before the integrator drains, or a held key would release
+    const uint32_t bounce_limit = DEBOUNCE_SAMPLES * SCAN_US - 2 * SCAN_US;
+    if (max_bounce_us > bounce_limit) max_bounce_us = bounce_limit;
+    const uint64_t end_us = START_US + static_cast<uint64_t>(seconds * 1000000.0);
+    const uint64_t drain_us = (DEBOUNCE_SAMPLES + 2) * SCAN_US;
+    std::mt19937 rng(7);
+    char what[200];
+
+    std::printf("%d x %d matrix, %u us ticks, debounce %u scans, bounce up to %u us, %.0f s across the us wrap\n\n",
+                ROWS, COLS, TICK_US, DEBOUNCE_SAMPLES, max_bounce_us, seconds);
+
+    // Strokes per key: random holds (taps to long holds), sometimes starting together as chords
+    std::vector<Stroke> strokes[ROWS][COLS];
+    {
+        std::uniform_int_distribution<uint32_t> hold(2000, 400000);
+        std::uniform_int_distribution<uint32_t> gap(5000, 1500000);
+        std::uniform_int_distribution<uint32_t> bounce(0, max_bounce_us);
+        uint64_t next_free[ROWS][COLS];
+        for (auto& row : next_free) for (auto& t : row) t = START_US + 1000;
+        uint64_t now = START_US + 1000;
+        while (now < end_us - 2000000) {
+            now += gap(rng) / 4;
+            const int keys = rng() % 4 == 0 ? 3 : 1;
+            for (int k = 0; k < keys; k++) {
+                const int row = rng() % ROWS;
+                const int col = rng() % COLS;
+                if (!IsValidKey(row, col) || next_free[row][col] > now) continue;
+                Stroke stroke;
+                stroke.press_us = now + rng() % 3000;
+                stroke.release_us = stroke.press_us + hold(rng);
+                stroke.bounce_us = bounce(rng);
+                stroke.first_closed_read_us = 0;
+                // Next stroke on this key once this one has settled and drained
+                next_free[row][col] = stroke.release_us + stroke.bounce_us + drain_us + 1000;
+                strokes[row][col].push_back(stroke);
+            }
+        }
+    }
+
+    FakeKeyMatrixGpio gpio;
+    gpio.SetKey(1, 3, true);   // Unused position reads pressed: must never report
+    KeyMatrixScanner scanner;
+    const uint64_t valid = ValidMask();
+    scanner.Init(&gpio, ROWS, COLS, &valid);
+    scanner.SetDebounceSamples(DEBOUNCE_SAMPLES);
+
+    std::vector<Edge> edges[ROWS][COLS];
+    size_t stroke_index[ROWS][COLS] = {};
+    std::uniform_int_distribution<uint32_t> pass_us(300, 4000);
+    uint64_t next_pass = START_US + pass_us(rng);
+    bool unused_key_edge = false;
+    size_t max_queued = 0;
+
+    uint64_t tick_count = 0;
+    for (uint64_t now = START_US; now < end_us; now += TICK_US, tick_count++) {
+        // Contacts as the scan timer finds them (Tick reads row 0 first)
+        const int read_row = static_cast<int>(tick_count % ROWS);
+        for (int row = 0; row < ROWS; row++) {
+            for (int col = 0; col < COLS; col++) {
+                if (!IsValidKey(row, col)) continue;
+                std::vector<Stroke>& list = strokes[row][col];
+                size_t& index = stroke_index[row][col];
+                while (index + 1 < list.size() && list[index + 1].press_us <= now) index++;
+                bool closed = !list.empty() && ContactClosed(list[index], now, row * 16 + col);
+                gpio.SetKey(row, col, closed);
+                if (closed && row == read_row && list[index].first_closed_read_us == 0) {
+                    list[index].first_closed_read_us = now;
+                }
+            }
+        }
+        scanner.Tick(static_cast<uint32_t>(now));
+        max_queued = std::max(max_queued, scanner.GetQueuedCount());
+
+        // Main loop pass: both clocks read once, then the queue drained
+        if (now >= next_pass) {
+            const uint32_t now_us = static_cast<uint32_t>(now);
+            const uint32_t now_ms = NowMs(now);
+            KeyEvent event;
+            while (scanner.PopEvent(&event)) {
+                if (!IsValidKey(event.row, event.col) || event.row >= ROWS || event.col >= COLS) {
+                    unused_key_edge = true;
+                    continue;
+                }
+                Edge edge;
+                edge.time_us = now - static_cast<uint32_t>(now_us - event.timestamp_us);
+                edge.time_ms = KeyMatrixScanner::EdgeTimeMs(event, now_us, now_ms);
+                edge.old_ms = event.timestamp_us / 1000;
+                edge.pressed = event.pressed != 0;
+                edges[event.row][event.col].push_back(edge);
+            }
+            next_pass = now + pass_us(rng);
+        }
+    }
+
+    // Compare each key's edges with its strokes
+    size_t stroke_count = 0;
+    size_t edge_count = 0;
+    size_t paired = 0;
+    uint64_t worst_press_us = 0;
+    uint64_t worst_release_us = 0;
+    uint32_t worst_ms_error = 0;
+    size_t old_stamp_wrong = 0;
+    for (int row = 0; row < ROWS; row++) {
+        for (int col = 0; col < COLS; col++) {
+            const std::vector<Stroke>& list = strokes[row][col];
+            const std::vector<Edge>& got = edges[row][col];
+            stroke_count += list.size();
+            edge_count += got.size();
+            if (got.size() != list.size() * 2) continue;
+            bool key_ok = true;
+            for (size_t i = 0; i < list.size(); i++) {
+                const Edge& press = got[i * 2];
+                const Edge& release = got[i * 2 + 1];
+                if (!press.pressed || release.pressed || press.time_us != list[i].first_closed_read_us ||
+                    release.time_us < list[i].release_us) {
+                    key_ok = false;
+                    break;
+                }
+                worst_press_us = std::max(worst_press_us, press.time_us - list[i].press_us);
+                // Release counted from the last bounce
+                uint64_t settled = list[i].release_us + list[i].bounce_us;
+                worst_release_us = std::max(worst_release_us, release.time_us > settled ? release.time_us - settled : 0);
+                for (const Edge* edge : {&press, &release}) {
+                    uint32_t error = static_cast<uint32_t>(std::abs(static_cast<int32_t>(edge->time_ms - NowMs(edge->time_us))));
+                    worst_ms_error = std::max(worst_ms_error, error);
+                    if (edge->old_ms != NowMs(edge->time_us) && edge->old_ms + 1 != NowMs(edge->time_us)) old_stamp_wrong++;
+                }
+            }
+            if (key_ok) paired += list.size();
+        }
+    }
+
+    std::printf("strokes and edges:\n");
+    std::snprintf(what, sizeof(what), "%zu strokes, %zu edges: a press on the first closed sample, then one release",
+                  stroke_count, edge_count);
+    Check(paired == stroke_count && edge_count == stroke_count * 2 && stroke_count > 0, what);
+    Check(!unused_key_edge, "no edges from the unused position (row 1, col 3)");
+    std::snprintf(what, sizeof(what), "press within a full scan and the bounce of the contact closing (worst %llu us)",
+                  static_cast<unsigned long long>(worst_press_us));
+    Check(worst_press_us <= SCAN_US + max_bounce_us, what);
+    std::snprintf(what, sizeof(what), "release once settled and drained (worst %llu us after the last bounce, limit %u)",
+                  static_cast<unsigned long long>(worst_release_us), (DEBOUNCE_SAMPLES + 1) * SCAN_US);
+    Check(worst_release_us <= (DEBOUNCE_SAMPLES + 1) * SCAN_US, what);
+    std::snprintf(what, sizeof(what), "no drops (queue peaked at %zu of %zu)", max_queued,
+                  KeyMatrixScanner::QUEUE_CAPACITY);
+    Check(scanner.GetDroppedCount() == 0, what);
+
+    std::printf("\nmillisecond press times across the wrap:\n");
+    std::snprintf(what, sizeof(what), "edge times on the millisecond clock within %u ms of the tick", worst_ms_error);
+    Check(worst_ms_error <= 1, what);
+    std::printf("  (stamped timestamp_us / 1000, %zu of %zu edges would be off)\n", old_stamp_wrong, edge_count);
+
+    // A main loop that stops draining: every lost edge is counted
+    std::printf("\nqueue overflow:\n");
+    {
+        FakeKeyMatrixGpio stuck_gpio;
+        KeyMatrixScanner stuck;
+        stuck.Init(&stuck_gpio, ROWS, COLS, &valid);
+        stuck.SetDebounceSamples(1);
+        uint32_t now = 0;
+        size_t edges_made = 0;
+        for (int round = 0; round < 4; round++) {
+            for (bool pressed : {true, false}) {
+                for (int row = 0; row < ROWS; row++) {
+                    for (int col = 0; col < COLS; col++) stuck_gpio.SetKey(row, col, pressed);
+                }
+                for (int tick = 0; tick < ROWS * 3; tick++) stuck.Tick(now += TICK_US);
+                edges_made += 11;
+            }
+        }
+        std::snprintf(what, sizeof(what), "%zu edges, %zu queued, %u counted as dropped", edges_made,
+                      stuck.GetQueuedCount(), stuck.GetDroppedCount());
+        Check(stuck.GetQueuedCount() == KeyMatrixScanner::QUEUE_CAPACITY &&
+              stuck.GetQueuedCount() + stuck.GetDroppedCount() == edges_made, what);
+    }
+
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,347 @@
+/**
+ * Loop Bench - MIDI looper recording, overdub merge and playback on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/midi -o build/loop_bench tools/loop_bench.cpp src/core/midi/midi_loop.cpp
+ *
+ * Usage:
+ *   loop_bench [--block <frames>] [--events <n>] [--seconds <loop length>]
+ *
+ * Drives the real MidiLoop from a simulated audio callback (48 kHz) with a
+ * main loop Update() every millisecond, as the firmware does:
+ *   1. records a first pass of notes at known samples, then checks every
+ *      later pass plays each of them on exactly its sample
+ *   2. overdubs more notes pass by pass until the loop holds --events
+ *      events, checking the merged loop stays sorted and complete
+ *   3. times ProcessBlock (per block, against the events in it) and the
+ *      main loop merge at full size
+ *   4. checks Stop releases sounding notes and Clear empties the loop
+ * Heap allocations are counted from the moment the loop exists; any is a
+ * failure. Exits non-zero if a check fails.
+ */
+
+#include "midi_loop.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace OpenChord;
+
+// Count heap allocations made inside the loop's calls (it must make none)
+static bool g_watching = false;
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    if (g_watching) g_allocations++;
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 48000;
+constexpr size_t MAX_EVENTS = 64;          // Track event buffer per block
+
+struct Options {
+    size_t block = 48;
+    size_t events = 4000;
+    double seconds = 8.0;
+};
+
+struct Played {
+    uint32_t sample;
+    uint8_t type;
+    uint8_t note;
+};
+
+// Simulated firmware: audio blocks, main loop Update() every millisecond
+class Rig {
+public:
+    Rig(MidiLoop* loop, size_t block) : loop_(loop), block_(block), sample_(0), next_update_(0) {}
+
+    // One audio block with the given stack events; returns what the loop played
+    size_t Block(const MidiEvent* input, size_t input_count, Played* played, size_t max_played,
+                 double* block_us = nullptr) {
+        for (size_t i = 0; i < input_count && i < MAX_EVENTS; i++) {
+            events_[i] = input[i];
+        }
+        size_t count = input_count;
+
+        g_watching = true;
+        auto t0 = std::chrono::steady_clock::now();
+        loop_->ProcessBlock(sample_, block_, events_, &count, MAX_EVENTS);
+        auto t1 = std::chrono::steady_clock::now();
+        g_watching = false;
+        if (block_us) *block_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+
+        size_t n = 0;
+        for (size_t i = input_count; i < count && n < max_played; i++) {
+            played[n++] = {events_[i].timestamp, events_[i].type, events_[i].data1};
+        }
+        sample_ += static_cast<uint32_t>(block_);
+
+        if (sample_ >= next_update_) {
+            g_watching = true;
+            auto t2 = std::chrono::steady_clock::now();
+            loop_->Update();
+            auto t3 = std::chrono::steady_clock::now();
+            g_watching = false;
+            double update_us = std::chrono::duration<double, std::micro>(t3 - t2).count();
+            if (update_us > worst_update_us_) worst_update_us_ = update_us;
+            next_update_ = sample_ + SAMPLE_RATE / 1000;
+        }
+        return n;
+    }
+
+    uint32_t Sample() const { return sample_; }
+    double TakeWorstUpdate() { double worst = worst_update_us_; worst_update_us_ = 0.0; return worst; }
+
+private:
+    MidiLoop* loop_;
+    size_t block_;
+    uint32_t sample_;
+    uint32_t next_update_;
+    double worst_update_us_ = 0.0;
+    MidiEvent events_[MAX_EVENTS];
+};
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("  FAIL: %s\n", what);
+        g_ok = false;
+    }
+}
+
+// Notes to record, each on an exact sample of the pass
+struct Note {
+    uint32_t offset;    // From the pass start
+    uint8_t type;
+    uint8_t note;
+};
+
+// Run one pass, feeding `notes` (sorted) at their offsets; collects playback
+void RunPass(Rig& rig, uint32_t pass_start, uint32_t length, size_t block,
+             const std::vector<Note>& notes, std::vector<Played>* played,
+             double* worst_block_us = nullptr, double* total_block_us = nullptr) {
+    size_t next = 0;
+    Played out[MAX_EVENTS];
+    MidiEvent input[MAX_EVENTS];
+    while (rig.Sample() < pass_start + length) {
+        uint32_t block_start = rig.Sample();
+        size_t input_count = 0;
+        while (next < notes.size() && pass_start + notes[next].offset < block_start + block &&
+               input_count < MAX_EVENTS) {
+            input[input_count++] = MidiEvent(notes[next].type, 0, notes[next].note, 100,
+                                             MidiEvent::SOURCE_GENERATED, pass_start + notes[next].offset);
+            next++;
+        }
+        double block_us = 0.0;
+        size_t n = rig.Block(input, input_count, out, MAX_EVENTS, &block_us);
+        if (worst_block_us && block_us > *worst_block_us) *worst_block_us = block_us;
+        if (total_block_us) *total_block_us += block_us;
+        if (played) played->insert(played->end(), out, out + n);
+    }
+}
+
+// Every expected note played once, on its sample
+bool SamePlayback(const std::vector<Note>& expected, const std::vector<Played>& played, uint32_t pass_start) {
+    if (expected.size() != played.size()) return false;
+    for (size_t i = 0; i < expected.size(); i++) {
+        if (played[i].sample != pass_start + expected[i].offset) return false;
+        if (played[i].type != expected[i].type || played[i].note != expected[i].note) return false;
+    }
+    return true;
+}
+
+// Notes spread over the pass (on/off pairs, offsets sorted)
+std::vector<Note> MakeNotes(std::mt19937& rng, size_t pairs, uint32_t length, uint8_t first_note) {
+    std::vector<Note> notes;
+    std::uniform_int_distribution<uint32_t> offset(0, length - 2000);
+    std::uniform_int_distribution<uint32_t> duration(100, 1900);
+    for (size_t i = 0; i < pairs; i++) {
+        uint32_t on = offset(rng);
+        uint8_t note = static_cast<uint8_t>(first_note + i % 24);
+        notes.push_back({on, MidiEvent::NOTE_ON, note});
+        notes.push_back({on + duration(rng), MidiEvent::NOTE_OFF, note});
+    }
+    std::stable_sort(notes.begin(), notes.end(), [](const Note& a, const Note& b) { return a.offset < b.offset; });
+    return notes;
+}
+
+std::vector<Note> Merge(const std::vector<Note>& a, const std::vector<Note>& b) {
+    std::vector<Note> merged;
+    merged.reserve(a.size() + b.size());
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j >= b.size() || (i < a.size() && a[i].offset <= b[j].offset)) {
+            merged.push_back(a[i++]);
+        } else {
+            merged.push_back(b[j++]);
+        }
+    }
+    return merged;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            options.block = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            options.events = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            options.seconds = std::atof(argv[++i]);
+        } else {
+            std::printf("usage: loop_bench [--block frames] [--events n] [--seconds s]\n");
+            return 1;
+        }
+    }
+    if (options.block < 1 || options.block > 256) options.block = 48;
+    if (options.events > MidiLoop::CAPACITY - 1) options.events = MidiLoop::CAPACITY - 1;   // Room for the merge-cost note
+    const uint32_t length = static_cast<uint32_t>(options.seconds * SAMPLE_RATE);
+    const size_t block = options.block;
+
+    std::mt19937 rng(7);
+    // Test data is set up before the loop exists; only the loop is watched
+    std::vector<std::vector<Note>> passes;
+    size_t planned = 0;
+    const size_t pairs_per_pass = 100;
+    while (planned < options.events) {
+        size_t pairs = std::min(pairs_per_pass, (options.events - planned) / 2);
+        if (pairs == 0) break;
+        passes.push_back(MakeNotes(rng, pairs, length, static_cast<uint8_t>(36 + passes.size() % 48)));
+        planned += pairs * 2;
+    }
+    std::vector<Note> expected;
+    expected.reserve(options.events);
+    std::vector<Note> scratch;
+    scratch.reserve(options.events);
+    std::vector<Played> played;
+    played.reserve(options.events + MAX_EVENTS);
+
+    static MidiLoop loop;
+    Rig rig(&loop, block);
+
+    std::printf("loop %.2f s, block %zu, %zu events in %zu passes\n",
+                options.seconds, block, planned, passes.size());
+
+    // 1. First pass: recording starts at the block the toggle is applied in
+    loop.ToggleRecord();
+    uint32_t pass_start = rig.Sample();
+    RunPass(rig, pass_start, length, block, passes[0], nullptr);
+    expected = passes[0];
+    // Close the loop: its length is the pass up to the block the toggle lands in
+    const uint32_t loop_length = rig.Sample() - pass_start;
+    loop.ToggleRecord();
+    pass_start = rig.Sample();
+
+    // Let the merge land, then check the next pass plays back exactly
+    RunPass(rig, pass_start, loop_length, block, {}, nullptr);
+    Check(loop.GetLength() == loop_length, "loop length is the recorded pass");
+    Check(loop.GetState() == MidiLoop::State::PLAYING, "plays after the first pass");
+    pass_start += loop_length;
+    played.clear();
+    RunPass(rig, pass_start, loop_length, block, {}, &played);
+    Check(SamePlayback(expected, played, pass_start), "first pass plays back on its samples");
+    pass_start += loop_length;
+    std::printf("first pass: %zu events, loop length %u samples\n", loop.GetEventCount(), loop_length);
+
+    // 2. Overdub the rest, one pass each; every next pass must play all of it
+    loop.ToggleRecord();
+    bool overdub_ok = true;
+    for (size_t p = 1; p < passes.size(); p++) {
+        played.clear();
+        RunPass(rig, pass_start, loop_length, block, passes[p], &played);
+        overdub_ok = overdub_ok && SamePlayback(expected, played, pass_start);
+        scratch = Merge(expected, passes[p]);
+        expected.swap(scratch);
+        pass_start += loop_length;
+    }
+    loop.ToggleRecord();
+    Check(overdub_ok, "each overdub pass plays everything recorded before it");
+
+    // 3. Full loop: playback accuracy and cost
+    double worst_block_us = 0.0;
+    double total_block_us = 0.0;
+    played.clear();
+    RunPass(rig, pass_start, loop_length, block, {}, &played);   // Merge lands
+    pass_start += loop_length;
+    played.clear();
+    RunPass(rig, pass_start, loop_length, block, {}, &played, &worst_block_us, &total_block_us);
+    Check(SamePlayback(expected, played, pass_start), "full loop plays back sorted, complete and on its samples");
+    pass_start += loop_length;
+    size_t blocks = (loop_length + block - 1) / block;
+    std::printf("full loop: %zu events, dropped %u, block cost avg %.3f us max %.3f us (%.2f events/block avg)\n",
+                loop.GetEventCount(), loop.GetDroppedCount(), total_block_us / blocks, worst_block_us,
+                static_cast<double>(expected.size()) / blocks);
+    Check(loop.GetEventCount() == expected.size(), "loop holds every recorded event");
+    Check(loop.GetDroppedCount() == 0, "nothing dropped");
+
+    // Merge cost at full size: one overdubbed note into a full loop
+    loop.ToggleRecord();
+    rig.Block(nullptr, 0, nullptr, 0);
+    MidiEvent one(MidiEvent::NOTE_ON, 0, 60, 100, MidiEvent::SOURCE_GENERATED, rig.Sample());
+    Played out[MAX_EVENTS];
+    rig.TakeWorstUpdate();
+    rig.Block(&one, 1, out, MAX_EVENTS);
+    for (int i = 0; i < 1000 && loop.GetEventCount() == expected.size(); i++) {
+        rig.Block(nullptr, 0, out, MAX_EVENTS);
+    }
+    std::printf("merge into full loop (main loop): %.1f us\n", rig.TakeWorstUpdate());
+    loop.ToggleRecord();
+    rig.Block(nullptr, 0, nullptr, 0);
+
+    // 4. Stop releases what the loop holds down; Clear empties it
+    size_t held = 0;
+    for (int i = 0; i < 200 && held == 0; i++) {
+        size_t n = rig.Block(nullptr, 0, out, MAX_EVENTS);
+        for (size_t k = 0; k < n; k++) {
+            if (out[k].type == MidiEvent::NOTE_ON) held++;
+            if (out[k].type == MidiEvent::NOTE_OFF && held > 0) held--;
+        }
+    }
+    loop.Stop();
+    size_t n = rig.Block(nullptr, 0, out, MAX_EVENTS);
+    size_t released = 0;
+    for (size_t k = 0; k < n; k++) {
+        if (out[k].type == MidiEvent::NOTE_OFF) released++;
+    }
+    Check(loop.GetState() == MidiLoop::State::STOPPED, "stops");
+    Check(held == 0 || released > 0, "stop releases sounding notes");
+
+    loop.Clear();
+    for (int i = 0; i < 100; i++) {
+        rig.Block(nullptr, 0, nullptr, 0);
+    }
+    loop.Play();
+    size_t after_clear = 0;
+    for (uint32_t s = 0; s < loop_length; s += static_cast<uint32_t>(block)) {
+        after_clear += rig.Block(nullptr, 0, out, MAX_EVENTS);
+    }
+    Check(loop.GetState() == MidiLoop::State::EMPTY && loop.GetEventCount() == 0 && after_clear == 0,
+          "clear empties the loop");
+
+    std::printf("heap allocations in the loop: %zu\n", g_allocations);
+    Check(g_allocations == 0, "no heap allocation");
+
+    std::printf("%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+/**
+ * MIDI RX Sim - receive-interrupt parsing and input-to-track latency on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/midi -o build/midi_rx_sim tools/midi_rx_sim.cpp src/core/midi/midi_rx_queue.cpp
+ *
+ * Usage:
+ *   midi_rx_sim [--seconds <simulated time>] [--stall-ms <longest main loop pass>]
+ *
+ * Generates random MIDI traffic (notes, CC, program change, pitch bend,
+ * SysEx, clock bytes dropped in the middle of other messages, running status
+ * on and off) and delivers it the way the firmware receives it: UART bytes
+ * one at a time at 31.25 kbaud, USB in 1 ms chunks, each parsed into a
+ * MidiRxQueue with the arrival time, as the receive interrupts do. A main
+ * loop with jittered pass times and occasional UI stalls drains the queues
+ * and records the latency to the track in MidiLatencyStats, as MidiRouter
+ * does. Checks:
+ *   - every message comes out once, in order, with its bytes and the time
+ *     its last byte arrived (not when the main loop got to it)
+ *   - each latency is the wait for the next main loop pass, and the
+ *     histogram adds up
+ *   - a main loop stalled long enough to fill the queue counts its drops
+ * Exits non-zero if a check fails.
+ */
+
+#include "midi_rx_queue.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr uint32_t UART_BYTE_US = 320;      // 10 bits at 31.25 kbaud
+constexpr uint32_t USB_FRAME_US = 1000;
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+struct Byte {
+    uint32_t arrival_us;
+    uint8_t value;
+};
+
+// What the parser should produce, with the arrival time of its last byte
+struct Message {
+    uint32_t timestamp_us;
+    uint8_t status;
+    uint8_t data[2];
+};
+
+// Random traffic as bytes on the wire, and the messages the parser should find in it
+class Traffic {
+public:
+    explicit Traffic(uint32_t seed) : rng_(seed), running_status_(0) {}
+
+    void Generate(uint32_t end_us, uint32_t mean_gap_us, uint32_t byte_us,
+                  std::vector<Byte>* bytes, std::vector<Message>* messages) {
+        std::exponential_distribution<double> gap(1.0 / mean_gap_us);
+        uint32_t now = 0;
+        while (now < end_us) {
+            now += static_cast<uint32_t>(gap(rng_)) + byte_us;
+            now = Add(now, byte_us, bytes, messages);
+        }
+    }
+
+private:
+    std::mt19937 rng_;
+    uint8_t running_status_;
+
+    // One byte; between the bytes of a message a clock byte now and then
+    // (the parser passes it on straight away, ahead of the message)
+    uint32_t Put(uint32_t now, uint32_t byte_us, uint8_t value, bool last,
+                 std::vector<Byte>* bytes, std::vector<Message>* messages) {
+        bytes->push_back({now, value});
+        now += byte_us;
+        if (!last && rng_() % 40 == 0) {
+            bytes->push_back({now, 0xF8});
+            messages->push_back({now, 0xF8, {0, 0}});
+            now += byte_us;
+        }
+        return now;
+    }
+
+    uint32_t Add(uint32_t now, uint32_t byte_us, std::vector<Byte>* bytes, std::vector<Message>* messages) {
+        const uint32_t kind = rng_() % 20;
+        if (kind == 0) {
+            // SysEx: skipped, and it cancels running status
+            now = Put(now, byte_us, 0xF0, false, bytes, messages);
+            for (uint32_t i = 0, n = 2 + rng_() % 8; i < n; i++) {
+                now = Put(now, byte_us, rng_() & 0x7F, false, bytes, messages);
+            }
+            now = Put(now, byte_us, 0xF7, true, bytes, messages);
+            running_status_ = 0;
+            return now;
+        }
+        if (kind == 1) {
+            messages->push_back({now, 0xF8, {0, 0}});
+            return Put(now, byte_us, 0xF8, true, bytes, messages);
+        }
+
+        static const uint8_t types[] = {0x90, 0x90, 0x90, 0x80, 0x80, 0xB0, 0xB0, 0xC0, 0xE0, 0xD0};
+        const uint8_t channel = static_cast<uint8_t>(rng_() % 4 == 0 ? rng_() % 16 : 0);
+        const uint8_t status = static_cast<uint8_t>(types[rng_() % sizeof(types)] | channel);
+        const bool two = (status & 0xF0) != 0xC0 && (status & 0xF0) != 0xD0;
+        Message message = {0, status, {static_cast<uint8_t>(rng_() & 0x7F), 0}};
+        if (two) message.data[1] = static_cast<uint8_t>(rng_() & 0x7F);
+        if ((status & 0xF0) == 0x90 && rng_() % 4 == 0) message.data[1] = 0;
+
+        // Running status when the sender can use it (and sometimes it doesn't)
+        if (status != running_status_ || rng_() % 3 == 0) {
+            now = Put(now, byte_us, status, false, bytes, messages);
+        }
+        running_status_ = status;
+        now = Put(now, byte_us, message.data[0], !two, bytes, messages);
+        if (two) now = Put(now, byte_us, message.data[1], true, bytes, messages);
+
+        // Stamped with the last byte; note on with velocity 0 comes out as a note off
+        message.timestamp_us = now - byte_us;
+        if ((status & 0xF0) == 0x90 && message.data[1] == 0) {
+            message.status = static_cast<uint8_t>(0x80 | (status & 0x0F));
+        }
+        messages->push_back(message);
+        return now;
+    }
+};
+
+struct Result {
+    size_t matched = 0;
+    size_t expected = 0;
+    bool in_order = true;
+    bool latency_ok = true;
+    uint32_t dropped = 0;
+};
+
+// Runs one transport: receive interrupts feed the queue, the main loop drains it
+Result Run(const std::vector<Byte>& bytes, const std::vector<Message>& messages, bool usb,
+           uint32_t end_us, uint32_t stall_us, uint32_t seed, MidiLatencyStats* stats) {
+    MidiRxQueue queue;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> pass_us(200, 3000);
+
+    Result result;
+    result.expected = messages.size();
+    size_t next_byte = 0;
+    uint32_t next_frame = USB_FRAME_US;
+    uint32_t now = 0;
+    while (now < end_us + 50000) {
+        // Main loop pass: mostly short, now and then a UI stall
+        uint32_t pass = (rng() % 200 == 0) ? stall_us : pass_us(rng);
+        now += pass;
+
+        // Interrupts during the pass
+        if (usb) {
+            // USB: whatever arrived during a frame, in 64-byte packets at the frame end
+            while (next_frame <= now) {
+                while (next_byte < bytes.size() && bytes[next_byte].arrival_us < next_frame) {
+                    uint8_t packet[64];
+                    size_t count = 0;
+                    while (next_byte < bytes.size() && bytes[next_byte].arrival_us < next_frame &&
+                           count < sizeof(packet)) {
+                        packet[count++] = bytes[next_byte++].value;
+                    }
+                    queue.ParseBytes(packet, count, next_frame);
+                }
+                next_frame += USB_FRAME_US;
+            }
+        } else {
+            while (next_byte < bytes.size() && bytes[next_byte].arrival_us <= now) {
+                queue.ParseBytes(&bytes[next_byte].value, 1, bytes[next_byte].arrival_us);
+                next_byte++;
+            }
+        }
+
+        // Drain, as MidiRouter does
+        MidiRxEvent event;
+        while (queue.Pop(&event)) {
+            uint32_t latency = now - event.timestamp_us;
+            stats->Record(latency);
+            // Arrived during this pass, so waited no longer than it
+            if (latency > pass) result.latency_ok = false;
+
+            if (result.matched >= messages.size()) {
+                result.in_order = false;
+                continue;
+            }
+            const Message& expected = messages[result.matched];
+            uint32_t expected_time = usb ? (expected.timestamp_us / USB_FRAME_US + 1) * USB_FRAME_US
+                                         : expected.timestamp_us;
+            if (event.status != expected.status || event.data[0] != expected.data[0] ||
+                event.data[1] != expected.data[1] || event.timestamp_us != expected_time) {
+                result.in_order = false;
+            }
+            result.matched++;
+        }
+    }
+    result.dropped = queue.GetDroppedCount();
+    return result;
+}
+
+void Report(const char* name, const MidiLatencyStats& stats) {
+    std::printf("  %s: %u events, average %u us, worst %u us\n    ", name, stats.GetCount(),
+                stats.GetAverageUs(), stats.GetWorstUs());
+    uint32_t total = 0;
+    for (int i = 0; i < MidiLatencyStats::BUCKET_COUNT; i++) {
+        uint32_t limit = MidiLatencyStats::GetBucketLimitUs(i);
+        total += stats.GetBucket(i);
+        if (i == MidiLatencyStats::BUCKET_COUNT - 1) {
+            std::printf("above: %u\n", stats.GetBucket(i));
+        } else {
+            std::printf("<%u us: %u  ", limit, stats.GetBucket(i));
+        }
+    }
+    if (total != stats.GetCount()) {
+        std::printf("  FAIL: histogram adds up to %u\n", total);
+        g_ok = false;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 30.0;
+    uint32_t stall_ms = 20;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--stall-ms") == 0 && i + 1 < argc) {
+            stall_ms = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else {
+            std::printf("usage: midi_rx_sim [--seconds s] [--stall-ms ms]\n");
+            return 1;
+        }
+    }
+    if (seconds <= 0.0) seconds = 30.0;
+    const uint32_t end_us = static_cast<uint32_t>(seconds * 1000000.0);
+    char what[160];
+
+    std::printf("%.0f s of traffic, main loop passes 0.2-3 ms with %u ms stalls\n\n", seconds, stall_ms);
+
+    // UART: dense traffic, close to what the wire carries
+    {
+        std::vector<Byte> bytes;
+        std::vector<Message> messages;
+        Traffic(1).Generate(end_us, 2000, UART_BYTE_US, &bytes, &messages);
+        MidiLatencyStats stats;
+        Result result = Run(bytes, messages, false, end_us, stall_ms * 1000, 2, &stats);
+        std::printf("TRS (UART, one byte per interrupt):\n");
+        std::snprintf(what, sizeof(what), "%zu of %zu messages parsed in order, stamped with their last byte's arrival",
+                      result.matched, result.expected);
+        Check(result.in_order && result.matched == result.expected && result.dropped == 0, what);
+        Check(result.latency_ok, "each waits only for the next main loop pass");
+        Report("latency", stats);
+    }
+
+    // USB: faster traffic in 1 ms frames
+    {
+        std::vector<Byte> bytes;
+        std::vector<Message> messages;
+        Traffic(3).Generate(end_us, 400, 10, &bytes, &messages);
+        MidiLatencyStats stats;
+        Result result = Run(bytes, messages, true, end_us, stall_ms * 1000, 4, &stats);
+        std::printf("\nUSB (1 ms frames):\n");
+        std::snprintf(what, sizeof(what), "%zu of %zu messages parsed in order, stamped with their frame",
+                      result.matched, result.expected);
+        Check(result.in_order && result.matched == result.expected && result.dropped == 0, what);
+        Check(result.latency_ok, "each waits only for the next main loop pass");
+        Report("latency", stats);
+    }
+
+    // A stall long enough to fill the queue: the overflow is counted, not silent
+    {
+        std::vector<Byte> bytes;
+        std::vector<Message> messages;
+        Traffic(5).Generate(2000000, 50, 10, &bytes, &messages);
+        MidiLatencyStats stats;
+        Result result = Run(bytes, messages, true, 2000000, 500000, 6, &stats);
+        std::printf("\nqueue overflow (500 ms stall under a flood):\n");
+        std::snprintf(what, sizeof(what), "%u events dropped and counted, %zu delivered + dropped of %zu",
+                      result.dropped, result.matched, result.expected);
+        Check(result.dropped > 0 && result.matched + result.dropped == result.expected, what);
+    }
+
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
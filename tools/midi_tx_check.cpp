@@ -0,0 +1,164 @@
+/**
+ * MIDI TX Check - output batch layout and transfers per chord on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Itools/host -Isrc -o build/midi_tx_check tools/midi_tx_check.cpp tools/host/host_daisy.cpp src/core/midi/midi_handler.cpp src/core/midi/midi_tx_batch.cpp src/core/midi/midi_rx_queue.cpp src/core/midi/midi_hub.cpp src/core/audio/sample_clock.cpp src/core/io/idle_monitor.cpp
+ *
+ * Usage:
+ *   midi_tx_check
+ *
+ * Checks MidiTxBatch on its own (each USB message kept whole, the TRS stream
+ * with running status across batches, real-time bytes in between, running
+ * status switched off), then sends chords through OpenChordMidiHandler
+ * against the host USB transport, which packs one USB MIDI packet per Tx()
+ * call like libDaisy's: every note of a chord has to arrive as its own packet
+ * with nothing lost, and one UART write per batch. Reports Tx calls and TRS
+ * bytes per chord size.
+ * Exits non-zero if a check fails.
+ */
+
+#include "core/midi/midi_handler.h"
+#include "core/midi/midi_tx_batch.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace OpenChord;
+
+namespace {
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+bool UsbMessageIs(const MidiTxBatch& batch, size_t index, const uint8_t* expected, size_t size) {
+    size_t actual_size = 0;
+    const uint8_t* message = batch.GetUsbMessage(index, &actual_size);
+    return message && actual_size == size && std::memcmp(message, expected, size) == 0;
+}
+
+bool TrsIs(const MidiTxBatch& batch, const uint8_t* expected, size_t size) {
+    return batch.GetTrsSize() == size && std::memcmp(batch.GetTrsBytes(), expected, size) == 0;
+}
+
+void CheckBatch() {
+    std::printf("batch layout:\n");
+    MidiTxBatch batch;
+    const uint8_t chord[3][3] = {{0x90, 60, 100}, {0x90, 64, 100}, {0x90, 67, 100}};
+    const uint8_t clock = 0xF8;
+    const uint8_t cc[3] = {0xB1, 7, 90};
+    batch.Add(chord[0], 3);
+    batch.Add(chord[1], 3);
+    batch.Add(&clock, 1);
+    batch.Add(chord[2], 3);
+    batch.Add(cc, 3);
+
+    bool usb_ok = batch.GetMessageCount() == 5 && UsbMessageIs(batch, 0, chord[0], 3) &&
+                  UsbMessageIs(batch, 1, chord[1], 3) && UsbMessageIs(batch, 2, &clock, 1) &&
+                  UsbMessageIs(batch, 3, chord[2], 3) && UsbMessageIs(batch, 4, cc, 3) &&
+                  batch.GetUsbMessage(5, nullptr) == nullptr;
+    Check(usb_ok, "USB keeps each message whole, status byte included, in order");
+
+    const uint8_t trs[] = {0x90, 60, 100, 64, 100, 0xF8, 67, 100, 0xB1, 7, 90};
+    Check(TrsIs(batch, trs, sizeof(trs)) && batch.GetTrsBytesSaved() == 2,
+          "TRS sends the chord's status once, the clock byte in between");
+
+    // Running status carries into the next batch, system common resets it
+    batch.Clear();
+    const uint8_t cc2[3] = {0xB1, 7, 91};
+    const uint8_t song_select[2] = {0xF3, 2};
+    batch.Add(cc2, 3);
+    batch.Add(song_select, 2);
+    batch.Add(cc2, 3);
+    const uint8_t trs2[] = {7, 91, 0xF3, 2, 0xB1, 7, 91};
+    Check(TrsIs(batch, trs2, sizeof(trs2)), "running status kept across batches, reset by system common");
+
+    // With running status off, every message carries its status
+    batch.Clear();
+    batch.SetRunningStatusEnabled(false);
+    batch.Add(chord[0], 3);
+    batch.Add(chord[1], 3);
+    const uint8_t trs3[] = {0x90, 60, 100, 0x90, 64, 100};
+    Check(TrsIs(batch, trs3, sizeof(trs3)) && batch.GetTrsBytesSaved() == 0, "no running status with it disabled");
+
+    // Full at MAX_MESSAGES
+    batch.Clear();
+    size_t added = 0;
+    while (batch.Add(chord[0], 3)) added++;
+    Check(added == MidiTxBatch::MAX_MESSAGES && batch.IsFull(), "holds MAX_MESSAGES, then refuses");
+}
+
+// Checks the packets logged since first are note-ons for notes base, base+1, ...
+bool PacketsAreChord(size_t first, size_t count, uint8_t base) {
+    if (daisy::MidiUsbTransport::GetTxPacketCount() - first != count) return false;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* packet = daisy::MidiUsbTransport::GetTxPacket(first + i);
+        if (packet[0] != 0x09 || packet[1] != 0x90 || packet[2] != base + i || packet[3] != 100) return false;
+    }
+    return true;
+}
+
+void CheckHandler() {
+    std::printf("\nhandler output:\n");
+    static daisy::DaisySeed hw;
+    static OpenChordMidiHandler handler;
+    handler.Init(&hw);
+    char what[160];
+
+    bool all_ok = true;
+    for (size_t notes = 1; notes <= 24; notes++) {
+        const size_t packets_before = daisy::MidiUsbTransport::GetTxPacketCount();
+        const uint32_t transfers_before = handler.GetUsbTransferCount();
+        const uint32_t trs_before = handler.GetTrsTxByteCount();
+        const size_t writes_before = daisy::MidiUartTransport::GetTxCount();
+        for (size_t i = 0; i < notes; i++) {
+            handler.QueueMidi(MidiEvent(MidiEvent::NOTE_ON, 0, static_cast<uint8_t>(48 + i), 100));
+        }
+        handler.FlushMidi();
+
+        const uint32_t transfers = handler.GetUsbTransferCount() - transfers_before;
+        const uint32_t trs_bytes = handler.GetTrsTxByteCount() - trs_before;
+        const size_t writes = daisy::MidiUartTransport::GetTxCount() - writes_before;
+        const size_t batches = (notes + MidiTxBatch::MAX_MESSAGES - 1) / MidiTxBatch::MAX_MESSAGES;
+        // Status byte sent once: running status carries over from the chord before
+        const size_t expected_trs = notes * 2 + (notes == 1 ? 1 : 0);
+        bool ok = PacketsAreChord(packets_before, notes, 48) && transfers == notes && writes == batches &&
+                  trs_bytes == expected_trs;
+        if (notes == 1 || notes == 3 || notes == 5 || notes == 16 || notes == 24 || !ok) {
+            std::printf("  %2zu notes: %u USB Tx, %zu UART write(s) of %u bytes\n", notes, transfers, writes, trs_bytes);
+        }
+        all_ok = all_ok && ok;
+    }
+    std::snprintf(what, sizeof(what), "chords of 1 to 24 notes: a USB packet per note, a UART write per batch, %zu bytes lost",
+                  daisy::MidiUsbTransport::GetTxLostBytes());
+    Check(all_ok && daisy::MidiUsbTransport::GetTxLostBytes() == 0, what);
+
+    // Real-time byte from the audio callback: its own packet at once, TRS on the next pass
+    const size_t packets_before = daisy::MidiUsbTransport::GetTxPacketCount();
+    const uint32_t trs_before = handler.GetTrsTxByteCount();
+    handler.SendRealtimeFromAudio(0xF8);
+    const uint8_t* packet = daisy::MidiUsbTransport::GetTxPacket(packets_before);
+    bool usb_ok = daisy::MidiUsbTransport::GetTxPacketCount() == packets_before + 1 &&
+                  packet[0] == 0x0F && packet[1] == 0xF8;
+    bool trs_waits = handler.GetTrsTxByteCount() == trs_before;
+    handler.ProcessMidi();
+    Check(usb_ok && trs_waits && handler.GetTrsTxByteCount() == trs_before + 1,
+          "clock byte: single-byte USB packet at once, TRS byte from the main loop");
+
+    handler.SendSystemRealtime(0xFA);
+    packet = daisy::MidiUsbTransport::GetTxPacket(daisy::MidiUsbTransport::GetTxPacketCount() - 1);
+    Check(packet[0] == 0x0F && packet[1] == 0xFA && daisy::MidiUsbTransport::GetTxLostBytes() == 0,
+          "start sent as its own packet");
+}
+
+} // namespace
+
+int main() {
+    CheckBatch();
+    CheckHandler();
+
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
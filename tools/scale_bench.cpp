@@ -0,0 +1,182 @@
+/**
+ * Scale Bench - scale lookup table and scale lock on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/music -o build/scale_bench tools/scale_bench.cpp src/core/music/scale_map.cpp src/core/music/chord_engine.cpp
+ *
+ * Usage:
+ *   scale_bench
+ *
+ * Checks the track's ScaleMap for every key and mode against a per-note
+ * search through the scale intervals (what an input plugin would do without
+ * the table): each note goes to the nearest scale note at or below it, scale
+ * notes stay put, and the degree notes match ChordEngine's button roots.
+ * Then runs random note streams through ScaleLock with key changes and the
+ * lock toggled while notes are held, and checks every note-on it sends is
+ * released exactly once. Times the table read against the search and the
+ * rebuild on a key change. Exits non-zero if a check fails.
+ */
+
+#include "scale_map.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace OpenChord;
+
+namespace {
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+// Without the table: work through the scale intervals for one note
+uint8_t SearchQuantize(MusicalKey key, uint8_t note) {
+    int intervals[7];
+    int count = 0;
+    ChordEngine::GetScaleIntervals(key.mode, intervals, &count);
+    for (int down = 0; down <= note; down++) {
+        int pitch_class = (note - down - key.root_note + 120) % 12;
+        for (int i = 0; i < count; i++) {
+            if (intervals[i] == pitch_class) return static_cast<uint8_t>(note - down);
+        }
+    }
+    for (int up = 1; note + up < 128; up++) {
+        int pitch_class = (note + up - key.root_note + 120) % 12;
+        for (int i = 0; i < count; i++) {
+            if (intervals[i] == pitch_class) return static_cast<uint8_t>(note + up);
+        }
+    }
+    return note;
+}
+
+double NowNs() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int main() {
+    ScaleMap map;
+
+    // 1. Tables against the search, every key and mode
+    std::printf("scale table:\n");
+    bool same = true;
+    bool in_scale_kept = true;
+    bool degrees_match = true;
+    for (int k = 0; k < 84; k++) {
+        MusicalKey key(static_cast<uint8_t>(k % 12), static_cast<MusicalMode>(k / 12));
+        map.SetKey(key);
+        for (int note = 0; note < 128; note++) {
+            uint8_t quantized = map.Quantize(static_cast<uint8_t>(note));
+            same = same && quantized == SearchQuantize(key, static_cast<uint8_t>(note));
+            same = same && map.InScale(quantized);
+            if (map.InScale(static_cast<uint8_t>(note))) in_scale_kept = in_scale_kept && quantized == note;
+        }
+        for (int button = 0; button < 7; button++) {
+            uint8_t expected = 0;
+            ChordEngine::GetButtonMapping(key, button, &expected);
+            degrees_match = degrees_match &&
+                            map.GetDegreeNote(ChordEngine::PhysicalButtonToScaleDegree(button)) == expected;
+        }
+    }
+    Check(same, "84 keys x 128 notes match the interval search, all in scale");
+    Check(in_scale_kept, "notes already in the scale are unchanged");
+    Check(degrees_match, "degree notes match ChordEngine's button roots");
+
+    // 2. Scale lock: random presses/releases, key changes and lock toggles while held
+    std::printf("\nscale lock:\n");
+    std::mt19937 rng(11);
+    bool balanced = true;
+    bool in_key = true;
+    size_t sent_ons = 0;
+    size_t sent_offs = 0;
+    for (int run = 0; run < 200; run++) {
+        ScaleLock lock;
+        bool enabled = true;
+        map.SetKey(MusicalKey(0, MusicalMode::IONIAN));
+        bool held[128] = {};
+        int sounding[128] = {};
+        auto send = [&](MidiEvent* events, size_t count) {
+            lock.Process(map, enabled, events, &count);
+            for (size_t i = 0; i < count; i++) {
+                if (events[i].type == MidiEvent::NOTE_ON) {
+                    if (enabled) in_key = in_key && map.InScale(events[i].data1);
+                    sounding[events[i].data1] = 1;     // A retrigger is still one note
+                    sent_ons++;
+                } else {
+                    balanced = balanced && sounding[events[i].data1] == 1;
+                    sounding[events[i].data1] = 0;
+                    sent_offs++;
+                }
+            }
+        };
+        for (int step = 0; step < 400; step++) {
+            uint32_t action = rng() % 20;
+            if (action == 0) {
+                map.SetKey(MusicalKey(static_cast<uint8_t>(rng() % 12), static_cast<MusicalMode>(rng() % 7)));
+                continue;
+            }
+            if (action == 1) {
+                enabled = !enabled;
+                continue;
+            }
+            // A small block of events, as one source generates in a block
+            MidiEvent events[8];
+            size_t count = 1 + rng() % 4;
+            for (size_t i = 0; i < count; i++) {
+                uint8_t note = static_cast<uint8_t>(48 + rng() % 24);
+                if (held[note]) {
+                    events[i] = MidiEvent(MidiEvent::NOTE_OFF, 0, note, 0);
+                    held[note] = false;
+                } else {
+                    events[i] = MidiEvent(MidiEvent::NOTE_ON, 0, note, 100);
+                    held[note] = true;
+                }
+            }
+            send(events, count);
+        }
+        // Release everything still held
+        for (int note = 0; note < 128; note++) {
+            if (!held[note]) continue;
+            MidiEvent off(MidiEvent::NOTE_OFF, 0, static_cast<uint8_t>(note), 0);
+            send(&off, 1);
+        }
+        for (int note = 0; note < 128; note++) balanced = balanced && sounding[note] == 0;
+    }
+    char what[128];
+    std::snprintf(what, sizeof(what), "%zu note-ons, %zu note-offs: each sounding note released once, none left on",
+                  sent_ons, sent_offs);
+    Check(balanced, what);
+    Check(in_key, "every note-on sent while locked is in the key of the moment");
+
+    // 3. Cost: table read against the search, and the rebuild
+    std::printf("\ncost:\n");
+    MusicalKey key(9, MusicalMode::DORIAN);
+    map.SetKey(key);
+    std::vector<uint8_t> notes(1 << 14);
+    for (auto& note : notes) note = static_cast<uint8_t>(rng() % 128);
+    volatile uint32_t sink = 0;
+    double best_table = 1e30, best_search = 1e30, best_rebuild = 1e30;
+    for (int repeat = 0; repeat < 5; repeat++) {
+        double t0 = NowNs();
+        for (uint8_t note : notes) sink = sink + map.Quantize(note);
+        double t1 = NowNs();
+        for (uint8_t note : notes) sink = sink + SearchQuantize(key, note);
+        double t2 = NowNs();
+        for (int k = 0; k < 84; k++) map.SetKey(MusicalKey(static_cast<uint8_t>(k % 12), static_cast<MusicalMode>(k / 12)));
+        double t3 = NowNs();
+        if ((t1 - t0) / notes.size() < best_table) best_table = (t1 - t0) / notes.size();
+        if ((t2 - t1) / notes.size() < best_search) best_search = (t2 - t1) / notes.size();
+        if ((t3 - t2) / 84.0 < best_rebuild) best_rebuild = (t3 - t2) / 84.0;
+    }
+    std::printf("  per note: table %.2f ns, interval search %.1f ns\n", best_table, best_search);
+    std::printf("  key change rebuild: %.2f us, %zu bytes per track\n", best_rebuild / 1000.0, sizeof(ScaleMap) + sizeof(ScaleLock));
+
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
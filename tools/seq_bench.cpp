@@ -0,0 +1,301 @@
+/**
+ * Sequencer Bench - step sequencer timing and per-block cost on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/music -Isrc/core/audio -o build/seq_bench tools/seq_bench.cpp src/core/music/step_sequencer.cpp src/core/music/note_scheduler.cpp src/core/audio/transport_clock.cpp
+ *
+ * Usage:
+ *   seq_bench [--bpm <tempo>] [--seconds <s>]
+ *
+ * Runs the real TransportClock and StepSequencer at 48 kHz from a simulated
+ * audio callback, as the firmware does (transport first, then the track's
+ * stack with the block's song position):
+ *   1. plays the same pattern at block sizes from 1 to 4096 frames and checks
+ *      every run produces the same events on the same samples, and that each
+ *      step's first hit is on the sample of its transport clock
+ *   2. times a block against pattern length (1 to 64 steps, same notes per
+ *      step) next to a reference that scans every step each block, and
+ *      against events per block. Cost should follow events, not steps.
+ * Exits non-zero if timing differs between block sizes or the cost grows
+ * with the step count.
+ */
+
+#include "step_sequencer.h"
+#include "transport_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t MAX_EVENTS = 64;          // Track event buffer per block
+
+struct Options {
+    float bpm = 174.0f;
+    float seconds = 20.0f;
+};
+
+struct Played {
+    uint32_t sample;
+    uint8_t type;
+    uint8_t note;
+
+    bool operator==(const Played& other) const {
+        return sample == other.sample && type == other.type && note == other.note;
+    }
+};
+
+void RecordClock(uint8_t status, uint32_t sample_time, void* context) {
+    if (status == 0xF8) {
+        static_cast<std::vector<uint32_t>*>(context)->push_back(sample_time);
+    }
+}
+
+// Pattern with ratchets, rests, short and full gates and chance steps
+void LoadTestPattern(StepSequencer* sequencer, size_t length, uint8_t ratchet_every) {
+    for (size_t i = 0; i < StepSequencer::MAX_STEPS; i++) {
+        uint8_t ratchet = (ratchet_every && i % ratchet_every == ratchet_every - 1u) ? 3 : 1;
+        uint8_t velocity = (i % 11 == 5) ? 0 : 100;
+        uint8_t gate = (i % 3 == 0) ? 100 : 35;
+        uint8_t probability = (i % 7 == 3) ? 60 : 100;
+        sequencer->SetStep(i, static_cast<uint8_t>(36 + (i * 5) % 24), velocity, gate, probability, ratchet);
+    }
+    sequencer->SetLength(length);
+}
+
+// Transport + sequencer through `seconds` of audio in `block` frame blocks
+struct Run {
+    std::vector<Played> played;
+    std::vector<uint32_t> clocks;
+    uint32_t dropped = 0;
+};
+
+Run Play(const Options& options, size_t block, size_t length, uint32_t ticks_per_step) {
+    Run run;
+    const uint32_t total = static_cast<uint32_t>(options.seconds * SAMPLE_RATE);
+    const uint32_t first_sample = 1000;   // Not zero: timestamps are absolute
+    run.clocks.reserve(static_cast<size_t>(options.seconds * options.bpm / 60.0f * 24.0f) + 16);
+
+    TransportClock transport;
+    transport.Configure(SAMPLE_RATE);
+    transport.SetOutput(RecordClock, &run.clocks);
+    transport.SetTempo(options.bpm);
+
+    StepSequencer sequencer;
+    LoadTestPattern(&sequencer, length, 4);
+    sequencer.SetTicksPerStep(ticks_per_step);
+
+    MidiEvent events[MAX_EVENTS];
+    uint32_t sample = first_sample;
+    transport.Start();
+    for (uint32_t done = 0; done < total; done += static_cast<uint32_t>(block)) {
+        transport.ProcessBlock(sample, block);
+        SongPosition position = transport.GetPosition();
+        size_t count = 0;
+        sequencer.ProcessBlock(position, sample, block, events, &count, MAX_EVENTS);
+        for (size_t i = 0; i < count; i++) {
+            if (events[i].timestamp < sample || events[i].timestamp >= sample + block) {
+                std::printf("  event outside its block (sample %u, block %u+%zu)\n",
+                            events[i].timestamp, sample, block);
+            }
+            // The last block may run past the others' end
+            if (events[i].timestamp < first_sample + total) {
+                run.played.push_back({events[i].timestamp, events[i].type, events[i].data1});
+            }
+        }
+        sample += static_cast<uint32_t>(block);
+    }
+    run.dropped = sequencer.GetDroppedCount();
+    return run;
+}
+
+// Reference: the O(steps) approach - every block, look at every step's start
+// time to see whether it falls in the block
+struct ScanReference {
+    uint8_t velocity[StepSequencer::MAX_STEPS];
+    uint8_t note[StepSequencer::MAX_STEPS];
+
+    size_t ProcessBlock(const SongPosition& position, uint32_t block_start, size_t block, size_t length,
+                        uint32_t ticks_per_step, MidiEvent* events, size_t max_events) {
+        if (!position.playing || position.tick_interval_q16 == 0) return 0;
+        const uint64_t step_q16 = static_cast<uint64_t>(ticks_per_step) * position.tick_interval_q16;
+        const uint64_t pattern_q16 = step_q16 * length;
+        const uint32_t pattern_ticks = ticks_per_step * static_cast<uint32_t>(length);
+        // Pattern start relative to the block, from the first clock in it
+        const uint32_t ticks_into_pattern = position.block_tick % pattern_ticks;
+        const int64_t pattern_start_q16 = static_cast<int64_t>(position.block_tick_offset_q16) -
+                                          static_cast<int64_t>(ticks_into_pattern) * position.tick_interval_q16;
+        size_t count = 0;
+        for (size_t step = 0; step < length; step++) {
+            for (int64_t start = pattern_start_q16 + static_cast<int64_t>(step * step_q16);
+                 start < (static_cast<int64_t>(block) << 16); start += static_cast<int64_t>(pattern_q16)) {
+                if (start >= 0 && velocity[step] && count < max_events) {
+                    events[count++] = MidiEvent(MidiEvent::NOTE_ON, 0, note[step], velocity[step],
+                                                MidiEvent::SOURCE_GENERATED,
+                                                block_start + static_cast<uint32_t>(start >> 16));
+                }
+            }
+        }
+        return count;
+    }
+};
+
+struct Cost {
+    double ns_per_block;
+    double events_per_block;
+};
+
+// Best of several runs of `blocks` blocks, timing only the sequencer call
+template <typename Process>
+Cost TimeBlocks(const Options& options, size_t block, Process process) {
+    double best = 1e30;
+    double events_per_block = 0.0;
+    for (int repeat = 0; repeat < 5; repeat++) {
+        TransportClock transport;
+        transport.Configure(SAMPLE_RATE);
+        transport.SetTempo(options.bpm);
+        transport.Start();
+
+        MidiEvent events[MAX_EVENTS];
+        const size_t blocks = static_cast<size_t>(options.seconds * SAMPLE_RATE) / block;
+        uint32_t sample = 0;
+        process(SongPosition(), sample, events);   // Stopped: drop what the last run left
+        size_t total_events = 0;
+        double total_ns = 0.0;
+        for (size_t b = 0; b < blocks; b++) {
+            transport.ProcessBlock(sample, block);
+            SongPosition position = transport.GetPosition();
+            auto t0 = std::chrono::steady_clock::now();
+            total_events += process(position, sample, events);
+            auto t1 = std::chrono::steady_clock::now();
+            total_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            sample += static_cast<uint32_t>(block);
+        }
+        best = std::min(best, total_ns / blocks);
+        events_per_block = static_cast<double>(total_events) / blocks;
+    }
+    return {best, events_per_block};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--bpm") == 0 && i + 1 < argc) {
+            options.bpm = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            options.seconds = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            std::printf("usage: seq_bench [--bpm tempo] [--seconds s]\n");
+            return 1;
+        }
+    }
+    bool ok = true;
+
+    // 1. Same events on the same samples whatever the block size
+    const size_t blocks[] = {1, 16, 48, 256, 1024, 4096};
+    const uint32_t ticks_per_step = 3;   // 32nds
+    Run reference = Play(options, 1, 16, ticks_per_step);
+    std::printf("%.0f BPM, 1/32 steps, %zu events at block 1\n", options.bpm, reference.played.size());
+
+    // Step starts on their clocks: pattern step k starts on clock k*ticks_per_step
+    size_t on_clock = 0;
+    size_t checked = 0;
+    {
+        StepSequencer pattern_source;
+        LoadTestPattern(&pattern_source, 16, 4);
+        const StepSequencer::Pattern& pattern = pattern_source.GetPattern();
+        size_t next = 0;
+        for (size_t tick = 0; tick + 1 < reference.clocks.size(); tick += ticks_per_step) {
+            size_t step = (tick / ticks_per_step) % 16;
+            if (pattern.velocity[step] == 0 || pattern.probability[step] < 100) continue;
+            uint32_t clock = reference.clocks[tick];
+            while (next < reference.played.size() && reference.played[next].sample < clock) next++;
+            checked++;
+            // The note-on may follow the last step's note-off on the same sample
+            for (size_t i = next; i < reference.played.size() && reference.played[i].sample == clock; i++) {
+                if (reference.played[i].type == MidiEvent::NOTE_ON && reference.played[i].note == pattern.note[step]) {
+                    on_clock++;
+                    break;
+                }
+            }
+        }
+    }
+    std::printf("  step starts on their clock sample: %zu / %zu\n", on_clock, checked);
+    if (on_clock != checked || checked == 0) ok = false;
+
+    for (size_t block : blocks) {
+        Run run = Play(options, block, 16, ticks_per_step);
+        bool same = run.played == reference.played;
+        std::printf("  block %4zu: %zu events, %s, dropped %u\n", block, run.played.size(),
+                    same ? "same samples" : "DIFFERENT", run.dropped);
+        if (!same || run.dropped > 0) ok = false;
+    }
+
+    // 2. Cost per block against steps, and against events
+    const size_t cost_block = 48;
+    std::printf("\nblock %zu, ns per block (best of 5):\n", cost_block);
+    std::printf("  steps   sequencer   step scan   events/block\n");
+    double first_cost = 0.0;
+    double worst_ratio = 0.0;
+    const size_t lengths[] = {1, 4, 16, 64};
+    for (size_t length : lengths) {
+        // Same note on every step, so events per block don't change with length
+        StepSequencer sequencer;
+        ScanReference scan;
+        for (size_t i = 0; i < StepSequencer::MAX_STEPS; i++) {
+            sequencer.SetStep(i, 60, 100, 50, 100, 1);
+            scan.velocity[i] = 100;
+            scan.note[i] = 60;
+        }
+        sequencer.SetLength(length);
+        sequencer.SetTicksPerStep(ticks_per_step);
+
+        Cost ours = TimeBlocks(options, cost_block, [&](const SongPosition& position, uint32_t sample, MidiEvent* events) {
+            size_t count = 0;
+            sequencer.ProcessBlock(position, sample, cost_block, events, &count, MAX_EVENTS);
+            return count;
+        });
+        Cost scanned = TimeBlocks(options, cost_block, [&](const SongPosition& position, uint32_t sample, MidiEvent* events) {
+            return scan.ProcessBlock(position, sample, cost_block, length, ticks_per_step, events, MAX_EVENTS);
+        });
+        std::printf("  %5zu   %9.1f   %9.1f   %.3f\n", length, ours.ns_per_block, scanned.ns_per_block,
+                    ours.events_per_block);
+        if (length == 1) first_cost = ours.ns_per_block;
+        worst_ratio = std::max(worst_ratio, ours.ns_per_block / first_cost);
+    }
+    std::printf("  sequencer cost, 64 steps vs 1: worst %.2fx\n", worst_ratio);
+    // Generous: timing noise on a shared host, the scan grows far more
+    if (worst_ratio > 2.0) ok = false;
+
+    std::printf("\nevents per block against cost (64 steps, ratchet on every step):\n");
+    const uint8_t ratchets[] = {1, 2, 4};
+    for (uint8_t ratchet : ratchets) {
+        for (size_t block : {size_t(48), size_t(1024)}) {
+            StepSequencer sequencer;
+            for (size_t i = 0; i < StepSequencer::MAX_STEPS; i++) {
+                sequencer.SetStep(i, 60, 100, 50, 100, ratchet);
+            }
+            sequencer.SetLength(64);
+            sequencer.SetTicksPerStep(ticks_per_step);
+            Cost cost = TimeBlocks(options, block, [&](const SongPosition& position, uint32_t sample, MidiEvent* events) {
+                size_t count = 0;
+                sequencer.ProcessBlock(position, sample, block, events, &count, MAX_EVENTS);
+                return count;
+            });
+            std::printf("  ratchet %u, block %4zu: %8.1f ns per block, %6.3f events per block, %5.1f ns per event\n",
+                        ratchet, block, cost.ns_per_block, cost.events_per_block,
+                        cost.events_per_block > 0.0 ? cost.ns_per_block / cost.events_per_block : 0.0);
+        }
+    }
+
+    std::printf("\n%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,580 @@
+/**
+ * SMF Bench - Standard MIDI File import/export through the looper on host
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Isrc/core/midi -o build/smf_bench tools/smf_bench.cpp src/core/midi/smf_file.cpp src/core/midi/smf_loop_transfer.cpp src/core/midi/midi_loop.cpp
+ *
+ * Usage:
+ *   smf_bench [file.mid ...]
+ *
+ * Runs SmfReader, SmfWriter and SmfLoopTransfer over stdio files (the
+ * IFileStream the SD card's StorageFile stands for on the firmware):
+ *   1. a hand-built format 1 file - tempo changes on the tempo track, running
+ *      status, SysEx and meta events to skip - read back on the exact sample
+ *      of each event from an independent tempo map, then timecode division,
+ *      a truncated file, format 2 and a file that isn't MIDI
+ *   2. a large file read a slice at a time: events in time order, bytes read
+ *      per slice and per-slice time independent of the file size
+ *   3. a file imported into a MidiLoop from a simulated audio callback and
+ *      main loop, played back on its samples, bounced out and imported again
+ *      (same events within half a tick, same length), and a file larger than
+ *      the loop's arena
+ * Heap allocations inside the reader, writer and transfer are counted; any is
+ * a failure. Files given on the command line are imported and reported.
+ * Exits non-zero if a check fails.
+ */
+
+#include "midi_loop.h"
+#include "smf_file.h"
+#include "smf_loop_transfer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace OpenChord;
+
+// Count heap allocations made inside the SMF calls (they must make none)
+static bool g_watching = false;
+static size_t g_allocations = 0;
+
+static void* CountedAlloc(size_t size) {
+    if (g_watching) g_allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void* CountedAlignedAlloc(size_t size, std::align_val_t align) {
+    if (g_watching) g_allocations++;
+    const size_t alignment = static_cast<size_t>(align);
+    void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size) { return CountedAlloc(size); }
+void* operator new[](size_t size) { return CountedAlloc(size); }
+void* operator new(size_t size, std::align_val_t align) { return CountedAlignedAlloc(size, align); }
+void* operator new[](size_t size, std::align_val_t align) { return CountedAlignedAlloc(size, align); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t BLOCK = 48;
+constexpr size_t MAX_EVENTS = 64;
+
+bool g_ok = true;
+
+void Check(bool condition, const char* what) {
+    std::printf("  %s: %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition) g_ok = false;
+}
+
+// POSIX file backend, counting what goes through it
+class PosixFile : public IFileStream {
+public:
+    PosixFile() : file_(nullptr), bytes_read_(0), seeks_(0) {}
+    ~PosixFile() { Close(); }
+
+    bool Open(const char* path, bool write) {
+        Close();
+        file_ = std::fopen(path, write ? "w+b" : "rb");
+        return file_ != nullptr;
+    }
+    void Close() {
+        if (file_) std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    size_t Read(void* data, size_t size) override {
+        size_t read = std::fread(data, 1, size, file_);
+        bytes_read_ += read;
+        return read;
+    }
+    size_t Write(const void* data, size_t size) override { return std::fwrite(data, 1, size, file_); }
+    bool Seek(uint32_t position) override {
+        seeks_++;
+        return std::fseek(file_, static_cast<long>(position), SEEK_SET) == 0;
+    }
+
+    size_t TakeBytesRead() { size_t bytes = bytes_read_; bytes_read_ = 0; return bytes; }
+    size_t GetSeeks() const { return seeks_; }
+
+private:
+    FILE* file_;
+    size_t bytes_read_;
+    size_t seeks_;
+};
+
+// Builds SMF bytes in memory (test data, allocates freely)
+class SmfBuilder {
+public:
+    void Header(uint16_t format, uint16_t tracks, uint16_t division) {
+        Text("MThd");
+        Word(6, 4);
+        Word(format, 2);
+        Word(tracks, 2);
+        Word(division, 2);
+    }
+    void BeginTrack() {
+        Text("MTrk");
+        length_at_ = bytes.size();
+        Word(0, 4);
+    }
+    void EndTrack(bool end_of_track = true) {
+        if (end_of_track) Bytes({0, 0xFF, 0x2F, 0});
+        uint32_t length = static_cast<uint32_t>(bytes.size() - length_at_ - 4);
+        for (int i = 0; i < 4; i++) bytes[length_at_ + i] = static_cast<uint8_t>(length >> (24 - 8 * i));
+    }
+    void Delta(uint32_t value) {
+        uint8_t groups[4];
+        int count = 0;
+        do {
+            groups[count++] = value & 0x7F;
+            value >>= 7;
+        } while (value);
+        while (count > 1) bytes.push_back(groups[--count] | 0x80);
+        bytes.push_back(groups[0]);
+    }
+    void Bytes(std::initializer_list<uint8_t> data) { bytes.insert(bytes.end(), data); }
+    void Text(const char* text) { while (*text) bytes.push_back(static_cast<uint8_t>(*text++)); }
+    void Word(uint32_t value, int size) {
+        for (int i = size - 1; i >= 0; i--) bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    bool Save(const char* path) const {
+        FILE* file = std::fopen(path, "wb");
+        if (!file) return false;
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    std::vector<uint8_t> bytes;
+
+private:
+    size_t length_at_ = 0;
+};
+
+struct Expected {
+    uint32_t tick;
+    uint8_t type;
+    uint8_t channel;
+    uint8_t data1;
+    uint8_t data2;
+};
+
+// Tempo map worked out from the start for each tick (not incrementally like the reader)
+struct TempoChange {
+    uint32_t tick;
+    uint32_t us_per_quarter;
+};
+
+uint32_t ExpectedSample(uint32_t tick, const std::vector<TempoChange>& tempo, uint16_t division) {
+    long double us = 0.0L;
+    uint32_t from = 0;
+    uint32_t us_per_quarter = 500000;
+    for (const TempoChange& change : tempo) {
+        if (change.tick > tick) break;
+        us += static_cast<long double>(change.tick - from) * us_per_quarter / division;
+        from = change.tick;
+        us_per_quarter = change.us_per_quarter;
+    }
+    us += static_cast<long double>(tick - from) * us_per_quarter / division;
+    return static_cast<uint32_t>(std::llround(us * SAMPLE_RATE / 1e6L));
+}
+
+// Reads a whole file through the reader, a slice at a time
+SmfReader::Result ReadAll(const char* path, std::vector<MidiEvent>* events, SmfReader* reader,
+                          size_t slice = 64, size_t* max_slice_bytes = nullptr, double* max_slice_us = nullptr) {
+    PosixFile file;
+    if (!file.Open(path, false)) return SmfReader::Result::FILE_ERROR;
+    MidiEvent batch[256];
+    g_watching = true;
+    SmfReader::Result result = reader->Open(&file, SAMPLE_RATE);
+    g_watching = false;
+    file.TakeBytesRead();
+    while (result == SmfReader::Result::OK) {
+        size_t count = 0;
+        g_watching = true;
+        auto t0 = std::chrono::steady_clock::now();
+        result = reader->Read(batch, slice, &count);
+        auto t1 = std::chrono::steady_clock::now();
+        g_watching = false;
+        double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        size_t bytes = file.TakeBytesRead();
+        if (max_slice_bytes && bytes > *max_slice_bytes) *max_slice_bytes = bytes;
+        if (max_slice_us && us > *max_slice_us) *max_slice_us = us;
+        events->insert(events->end(), batch, batch + count);
+    }
+    return result;
+}
+
+// Simulated firmware: audio blocks through the loop, the looper plugin's
+// Update() every millisecond (transfer first, merge when it's idle)
+class Rig {
+public:
+    Rig(MidiLoop* loop, SmfLoopTransfer* transfer)
+        : loop_(loop), transfer_(transfer), sample_(0), next_update_(0), updates_(0), worst_update_us_(0.0) {}
+
+    // Runs until the transfer is done; returns main loop passes taken
+    size_t RunTransfer(size_t max_blocks) {
+        size_t start = updates_;
+        for (size_t i = 0; i < max_blocks && transfer_->IsBusy(); i++) Block(nullptr);
+        return updates_ - start;
+    }
+
+    void Block(std::vector<MidiEvent>* played) {
+        size_t count = 0;
+        loop_->ProcessBlock(sample_, BLOCK, events_, &count, MAX_EVENTS);
+        if (played) played->insert(played->end(), events_, events_ + count);
+        sample_ += BLOCK;
+        if (sample_ >= next_update_) {
+            g_watching = true;
+            auto t0 = std::chrono::steady_clock::now();
+            if (!transfer_->Update()) loop_->Update();
+            auto t1 = std::chrono::steady_clock::now();
+            g_watching = false;
+            double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+            if (us > worst_update_us_) worst_update_us_ = us;
+            next_update_ = sample_ + static_cast<uint32_t>(SAMPLE_RATE) / 1000;
+            updates_++;
+        }
+    }
+
+    uint32_t Sample() const { return sample_; }
+    double TakeWorstUpdate() { double worst = worst_update_us_; worst_update_us_ = 0.0; return worst; }
+
+private:
+    MidiLoop* loop_;
+    SmfLoopTransfer* transfer_;
+    uint32_t sample_;
+    uint32_t next_update_;
+    size_t updates_;
+    double worst_update_us_;
+    MidiEvent events_[MAX_EVENTS];
+};
+
+// A format 1 file: a tempo track and `tracks` note tracks of `notes` notes each
+void BuildLargeFile(SmfBuilder* smf, std::mt19937& rng, int tracks, int notes) {
+    smf->Header(1, static_cast<uint16_t>(tracks + 1), 480);
+    smf->BeginTrack();
+    smf->Bytes({0, 0xFF, 0x51, 3, 0x07, 0xA1, 0x20});       // 120 BPM
+    smf->EndTrack();
+    for (int t = 0; t < tracks; t++) {
+        smf->BeginTrack();
+        for (int n = 0; n < notes; n++) {
+            uint8_t note = static_cast<uint8_t>(36 + rng() % 48);
+            smf->Delta(rng() % 240);
+            smf->Bytes({static_cast<uint8_t>(0x90 | t), note, 100});
+            smf->Delta(1 + rng() % 240);
+            smf->Bytes({note, 0});                          // Running status note-off
+        }
+        smf->EndTrack();
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* hand_path = "smf_bench_hand.mid";
+    const char* large_path = "smf_bench_large.mid";
+    const char* bounce_path = "smf_bench_bounce.mid";
+    std::mt19937 rng(5);
+
+    // 1. Hand-built format 1 file
+    std::printf("decoding:\n");
+    {
+        const uint16_t division = 96;
+        std::vector<TempoChange> tempo = {{0, 500000}, {192, 250000}, {384, 1000000}};
+        SmfBuilder smf;
+        smf.Header(1, 3, division);
+        smf.BeginTrack();       // Tempo track: name, tempo changes, time signature
+        smf.Bytes({0, 0xFF, 0x03, 5}); smf.Text("Tempo");
+        smf.Bytes({0, 0xFF, 0x51, 3, 0x07, 0xA1, 0x20});
+        smf.Bytes({0, 0xFF, 0x58, 4, 4, 2, 24, 8});
+        smf.Delta(192); smf.Bytes({0xFF, 0x51, 3, 0x03, 0xD0, 0x90});
+        smf.Delta(192); smf.Bytes({0xFF, 0x51, 3, 0x0F, 0x42, 0x40});
+        smf.EndTrack();
+        std::vector<Expected> expected;
+        smf.BeginTrack();       // Notes with running status, SysEx in between, velocity-0 note-off
+        smf.Bytes({0, 0xC0, 5});                                  expected.push_back({0, 0xC0, 0, 5, 0});
+        smf.Bytes({0, 0x90, 60, 100});                            expected.push_back({0, 0x90, 0, 60, 100});
+        smf.Delta(96); smf.Bytes({64, 90});                       expected.push_back({96, 0x90, 0, 64, 90});
+        smf.Delta(96); smf.Bytes({0xF0, 3, 0x7E, 0x01, 0xF7});
+        smf.Delta(0); smf.Bytes({0x90, 60, 0});                   expected.push_back({192, 0x90, 0, 60, 0});
+        smf.Delta(100); smf.Bytes({0x80, 64, 40});                expected.push_back({292, 0x80, 0, 64, 40});
+        smf.Delta(200); smf.Bytes({0xB0, 7, 80});                 expected.push_back({492, 0xB0, 0, 7, 80});
+        smf.Delta(10); smf.Bytes({0xE0, 0, 64});                  expected.push_back({502, 0xE0, 0, 0, 64});
+        smf.EndTrack();
+        smf.BeginTrack();       // A second channel interleaved with the first, no end-of-track event
+        smf.Delta(50); smf.Bytes({0x93, 48, 70});                 expected.push_back({50, 0x90, 3, 48, 70});
+        smf.Delta(300); smf.Bytes({0x83, 48, 0});                 expected.push_back({350, 0x80, 3, 48, 0});
+        smf.Delta(40); smf.Bytes({0xFF, 0x01, 0x81, 0x00});       // 128-byte text meta
+        for (int i = 0; i < 128; i++) smf.Bytes({'x'});
+        smf.Delta(0); smf.Bytes({0xA3, 48, 10});                  expected.push_back({390, 0xA0, 3, 48, 10});
+        smf.EndTrack(false);
+        smf.Save(hand_path);
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const Expected& a, const Expected& b) { return a.tick < b.tick; });
+
+        std::vector<MidiEvent> events;
+        SmfReader reader;
+        SmfReader::Result result = ReadAll(hand_path, &events, &reader, 3);
+        bool same = result == SmfReader::Result::END && events.size() == expected.size();
+        for (size_t i = 0; same && i < events.size(); i++) {
+            const MidiEvent& e = events[i];
+            const Expected& x = expected[i];
+            same = e.type == x.type && e.channel == x.channel && e.data1 == x.data1 && e.data2 == x.data2 &&
+                   std::abs(static_cast<int64_t>(e.timestamp) - ExpectedSample(x.tick, tempo, division)) <= 1;
+        }
+        Check(same, "format 1: channel events in time order on their samples across tempo changes");
+        Check(reader.GetEndSample() == ExpectedSample(502, tempo, division),
+              "end of file is the end of the longest track");
+
+        // Timecode division: 25 fps x 40 ticks = 1 ms per tick, tempo events ignored
+        SmfBuilder smpte;
+        smpte.Header(0, 1, static_cast<uint16_t>((0x100 - 25) << 8 | 40));
+        smpte.BeginTrack();
+        smpte.Bytes({0, 0xFF, 0x51, 3, 0x03, 0xD0, 0x90});
+        smpte.Delta(1000); smpte.Bytes({0x90, 60, 100});
+        smpte.EndTrack();
+        smpte.Save(hand_path);
+        events.clear();
+        result = ReadAll(hand_path, &events, &reader);
+        Check(result == SmfReader::Result::END && events.size() == 1 && events[0].timestamp == 48000,
+              "timecode division: 1000 ticks at 25 fps x 40 is one second");
+
+        // Cut short in the middle of a note: what's there comes out, the track ends
+        smf.bytes.resize(smf.bytes.size() / 2);
+        smf.Save(hand_path);
+        events.clear();
+        result = ReadAll(hand_path, &events, &reader);
+        Check(result == SmfReader::Result::END && !events.empty() && events.size() < expected.size(),
+              "truncated file: reads the events before the cut");
+
+        SmfBuilder format2;
+        format2.Header(2, 1, 96);
+        format2.BeginTrack();
+        format2.EndTrack();
+        format2.Save(hand_path);
+        Check(ReadAll(hand_path, &events, &reader) == SmfReader::Result::UNSUPPORTED, "format 2 is refused");
+        SmfBuilder junk;
+        junk.Text("RIFF....WAVEfmt ");
+        junk.Save(hand_path);
+        Check(ReadAll(hand_path, &events, &reader) == SmfReader::Result::NOT_SMF, "not a MIDI file is refused");
+    }
+
+    // 2. Large file a slice at a time: bytes and time per slice don't grow with the file
+    std::printf("\nstreaming (slices of %zu file events):\n", SmfLoopTransfer::EVENTS_PER_UPDATE);
+    {
+        const int sizes[] = {500, 5000, 50000};
+        size_t slice_bytes[3] = {};
+        for (int s = 0; s < 3; s++) {
+            SmfBuilder smf;
+            BuildLargeFile(&smf, rng, 4, sizes[s]);
+            smf.Save(large_path);
+            std::vector<MidiEvent> events;
+            events.reserve(static_cast<size_t>(sizes[s]) * 8);
+            SmfReader reader;
+            double max_us = 0.0;
+            auto t0 = std::chrono::steady_clock::now();
+            SmfReader::Result result = ReadAll(large_path, &events, &reader, SmfLoopTransfer::EVENTS_PER_UPDATE,
+                                               &slice_bytes[s], &max_us);
+            auto t1 = std::chrono::steady_clock::now();
+            bool ordered = result == SmfReader::Result::END && events.size() == static_cast<size_t>(sizes[s]) * 8;
+            for (size_t i = 1; ordered && i < events.size(); i++) ordered = events[i].timestamp >= events[i - 1].timestamp;
+            double total_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            std::printf("  %7zu bytes, %6zu events: %.1f ms total (%.0f ns/event), slice <= %zu bytes, <= %.1f us\n",
+                        smf.bytes.size(), events.size(), total_ms, total_ms * 1e6 / events.size(),
+                        slice_bytes[s], max_us);
+            Check(ordered, "every event read, in time order across 4 tracks");
+        }
+        Check(slice_bytes[2] <= slice_bytes[0] + SmfReader::TRACK_BUFFER_SIZE &&
+              slice_bytes[2] <= SmfLoopTransfer::EVENTS_PER_UPDATE * SmfReader::TRACK_BUFFER_SIZE,
+              "bytes read per slice don't depend on the file size");
+        std::printf("  reader %zu bytes (buffers for %zu tracks), transfer %zu bytes, loop %zu bytes\n",
+                    sizeof(SmfReader), SmfReader::MAX_TRACKS, sizeof(SmfLoopTransfer), sizeof(MidiLoop));
+    }
+
+    // 3. Import into the looper, play back, bounce out, import again
+    std::printf("\nlooper import/export:\n");
+    {
+        static MidiLoop loop;
+        static MidiLoop reloaded;
+        SmfLoopTransfer transfer;
+        Rig rig(&loop, &transfer);
+
+        SmfBuilder smf;
+        BuildLargeFile(&smf, rng, 3, 600);      // 3600 events
+        smf.Save(large_path);
+        std::vector<MidiEvent> file_events;
+        SmfReader reader;
+        ReadAll(large_path, &file_events, &reader);
+        const uint32_t file_end = reader.GetEndSample();
+
+        // Something already playing while the file loads
+        loop.ToggleRecord();
+        for (int i = 0; i < 100; i++) rig.Block(nullptr);
+        loop.ToggleRecord();
+        for (int i = 0; i < 10; i++) rig.Block(nullptr);
+
+        PosixFile file;
+        file.Open(large_path, false);
+        g_watching = true;
+        bool started = transfer.StartImport(&loop, &file, SAMPLE_RATE);
+        g_watching = false;
+        rig.TakeWorstUpdate();
+        size_t passes = rig.RunTransfer(100000);
+        for (int i = 0; i < 4; i++) rig.Block(nullptr);
+        double worst_import = rig.TakeWorstUpdate();
+        file.Close();
+        Check(started && transfer.GetState() == SmfLoopTransfer::State::DONE &&
+              loop.GetEventCount() == file_events.size(),
+              "every event of the file loaded into the loop's arena");
+        Check(loop.GetState() == MidiLoop::State::STOPPED && loop.GetLength() == file_end,
+              "loaded stopped, the length running to the end of the file");
+        std::printf("  %zu events in %zu main loop passes, worst pass %.1f us\n",
+                    file_events.size(), passes, worst_import);
+
+        // Play it: each event on its sample from the loop start (a note-off on the loop end just before it)
+        loop.Play();
+        rig.Block(nullptr);
+        const uint32_t start = rig.Sample() - static_cast<uint32_t>(BLOCK);
+        std::vector<MidiEvent> played;
+        played.reserve(file_events.size() + 64);
+        while (rig.Sample() - start < file_end) rig.Block(&played);
+        bool on_sample = played.size() >= file_events.size();
+        for (size_t i = 0; on_sample && i < file_events.size(); i++) {
+            const uint32_t position = std::min(file_events[i].timestamp, file_end - 1);
+            on_sample = played[i].timestamp - start == position &&
+                        played[i].data1 == file_events[i].data1 && played[i].type == file_events[i].type;
+        }
+        Check(on_sample, "one pass plays every loaded event on its sample");
+        loop.Stop();
+        rig.Block(nullptr);
+
+        // Bounce out at 120 BPM, then import the bounce into another loop
+        file.Open(bounce_path, true);
+        g_watching = true;
+        started = transfer.StartExport(&loop, &file, SAMPLE_RATE, 120.0f);
+        g_watching = false;
+        passes = rig.RunTransfer(100000);
+        double worst_export = rig.TakeWorstUpdate();
+        file.Close();
+        Check(started && transfer.GetState() == SmfLoopTransfer::State::DONE, "bounced to a format 0 file");
+        std::printf("  %zu events out in %zu main loop passes, worst pass %.1f us\n",
+                    transfer.GetEventCount(), passes, worst_export);
+
+        SmfLoopTransfer reimport;
+        Rig rig2(&reloaded, &reimport);
+        file.Open(bounce_path, false);
+        reimport.StartImport(&reloaded, &file, SAMPLE_RATE);
+        rig2.RunTransfer(100000);
+        for (int i = 0; i < 4; i++) rig2.Block(nullptr);
+        file.Close();
+        MidiEventSpan before = loop.GetEvents();
+        MidiEventSpan after = reloaded.GetEvents();
+        const double half_tick = SAMPLE_RATE * 0.5 / SmfWriter::DIVISION / 2.0;   // Quarter = 0.5 s
+        bool same = after.size == before.size;
+        for (size_t i = 0; same && i < before.size; i++) {
+            same = after[i].type == before[i].type && after[i].channel == before[i].channel &&
+                   after[i].data1 == before[i].data1 && after[i].data2 == before[i].data2 &&
+                   std::fabs(static_cast<double>(after[i].timestamp) - before[i].timestamp) <= half_tick + 1.0;
+        }
+        Check(same, "the bounce imports back to the same events, each within half a tick");
+        Check(std::fabs(static_cast<double>(reloaded.GetLength()) - loop.GetLength()) <= half_tick + 1.0,
+              "and the same loop length");
+
+        // One note on the file's first tick: the loop still gets a block, and plays it once a pass
+        SmfBuilder one;
+        one.Header(0, 1, 480);
+        one.BeginTrack();
+        one.Bytes({0, 0x90, 60, 100});
+        one.Bytes({0, 0x80, 60, 0});
+        one.EndTrack();
+        one.Save(large_path);
+        file.Open(large_path, false);
+        transfer.StartImport(&loop, &file, SAMPLE_RATE);
+        rig.RunTransfer(100000);
+        for (int i = 0; i < 4; i++) rig.Block(nullptr);
+        file.Close();
+        Check(transfer.GetState() == SmfLoopTransfer::State::DONE && loop.GetEventCount() == 2 &&
+              loop.GetLength() >= static_cast<uint32_t>(BLOCK),
+              "a one-note file loads as a loop at least a block long");
+        loop.Play();
+        bool in_block = true;
+        size_t note_ons = 0;
+        const int blocks = 200;
+        for (int i = 0; i < blocks; i++) {
+            const uint32_t block_start = rig.Sample();
+            played.clear();
+            rig.Block(&played);
+            for (const MidiEvent& event : played) {
+                in_block = in_block && event.timestamp - block_start < static_cast<uint32_t>(BLOCK);
+                if (event.type == MidiEvent::NOTE_ON && event.data2 > 0) note_ons++;
+            }
+            in_block = in_block && loop.GetPosition() < loop.GetLength();
+        }
+        loop.Stop();
+        rig.Block(nullptr);
+        const size_t passes_played = static_cast<size_t>(blocks) * BLOCK / loop.GetLength();
+        Check(in_block && note_ons >= passes_played && note_ons <= passes_played + 1,
+              "and plays its note once a pass, inside the block, the position inside the loop");
+
+        // More events than the arena holds: the first CAPACITY load, the rest are counted
+        SmfBuilder big;
+        BuildLargeFile(&big, rng, 2, 1500);     // 6000 events
+        big.Save(large_path);
+        file.Open(large_path, false);
+        transfer.StartImport(&loop, &file, SAMPLE_RATE);
+        rig.RunTransfer(100000);
+        for (int i = 0; i < 4; i++) rig.Block(nullptr);
+        file.Close();
+        Check(transfer.GetState() == SmfLoopTransfer::State::DONE && loop.GetEventCount() == MidiLoop::CAPACITY &&
+              transfer.GetDroppedCount() == 6000 - MidiLoop::CAPACITY,
+              "a file past the arena's capacity loads what fits and counts the rest");
+    }
+
+    char what[96];
+    std::snprintf(what, sizeof(what), "%zu heap allocations in the reader, writer and transfer", g_allocations);
+    Check(g_allocations == 0, what);
+
+    // Files from the command line
+    for (int i = 1; i < argc; i++) {
+        static MidiLoop loop;
+        SmfLoopTransfer transfer;
+        Rig rig(&loop, &transfer);
+        PosixFile file;
+        if (!file.Open(argv[i], false)) {
+            std::printf("\n%s: can't open\n", argv[i]);
+            continue;
+        }
+        transfer.StartImport(&loop, &file, SAMPLE_RATE);
+        size_t passes = rig.RunTransfer(10000000);
+        for (int b = 0; b < 4; b++) rig.Block(nullptr);
+        std::printf("\n%s: %s, %zu events (%zu past capacity) in %zu passes, %.2f s, worst pass %.1f us\n",
+                    argv[i], transfer.GetState() == SmfLoopTransfer::State::DONE ? "loaded" : "failed",
+                    transfer.GetEventCount(), transfer.GetDroppedCount(), passes,
+                    loop.GetLength() / SAMPLE_RATE, rig.TakeWorstUpdate());
+    }
+
+    std::remove(hand_path);
+    std::remove(large_path);
+    std::remove(bounce_path);
+    std::printf("\n%s\n", g_ok ? "OK" : "FAILED");
+    return g_ok ? 0 : 1;
+}
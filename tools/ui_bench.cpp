@@ -0,0 +1,431 @@
+/**
+ * UI Bench - Renders every UI screen on host and measures each frame
+ *
+ * Build (from the repo root):
+ *   g++ -std=c++17 -O2 -Itools/host -Isrc -o build/ui_bench tools/ui_bench.cpp tools/host/host_daisy.cpp $(find src -name '*.cpp' ! -name main.cpp)
+ *
+ * Usage:
+ *   ui_bench [--updates <n>] [--dump <dir>]
+ *
+ * Options:
+ *   --updates <n>   UIManager::Update() calls per screen (default 40, 50 ms apart)
+ *   --dump <dir>    Write the last frame of each screen as <dir>/NN-<screen>.pbm
+ *
+ * Brings the firmware up with SystemInitializer and the host libDaisy in
+ * tools/host (inert hardware, the OLED framebuffer in memory), wires the UI
+ * like main.cpp, then walks through the screens of each UIManager content
+ * type: main UI (idle, key changes, played notes and chords), the menus, plugin
+ * and global settings, the octave overlay and each debug view. Each screen
+ * gets the same number of display task updates while its state is changed
+ * the way a user would (scrolling, turning values, moving the stick).
+ *
+ * For every screen it reports how many updates drew a frame, the time to
+ * draw and submit one (on this machine - compare screens, not to hardware),
+ * the bytes sent to the panel for the first frame (the switch from the
+ * previous screen) and on average after it, and frames that changed nothing.
+ * Frames are taken from the transfer's front buffer, i.e. what the panel
+ * shows. Glyphs are the host stand-in font (see tools/host/host_daisy.cpp).
+ */
+
+#include "core/config.h"
+#include "core/io/io_manager.h"
+#include "core/io/input_manager.h"
+#include "core/io/power_manager.h"
+#include "core/audio/volume_manager.h"
+#include "core/audio/audio_engine.h"
+#include "core/midi/midi_handler.h"
+#include "core/midi/octave_shift.h"
+#include "core/system_interface.h"
+#include "core/system_initializer.h"
+#include "core/transport_control.h"
+#include "core/midi_router.h"
+#include "core/task_scheduler.h"
+#include "core/ui/ui_manager.h"
+#include "core/ui/main_ui.h"
+#include "core/ui/splash_screen.h"
+#include "core/ui/menu_manager.h"
+#include "core/ui/settings_manager.h"
+#include "core/ui/global_settings.h"
+#include "core/ui/track_settings.h"
+#include "core/ui/debug_screen.h"
+#include "core/ui/debug_views.h"
+#include "plugins/input/chord_mapping_input.h"
+#include "plugins/input/piano_input.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace OpenChord;
+
+namespace {
+
+constexpr uint32_t DISPLAY_TASK_PERIOD_MS = 50;   // As in main.cpp
+
+daisy::DaisySeed hw;
+VolumeManager volume_mgr;
+AudioEngine audio_engine;
+IOManager io_manager;
+OpenChordMidiHandler midi_handler;
+InputManager input_manager;
+PowerManager power_mgr;
+OctaveShift octave_shift;
+GlobalSettings global_settings;
+TrackSettings track_settings;
+TransportControl transport_control;
+OpenChordSystem openchord_system;
+ChordMappingInput* chord_plugin_ptr = nullptr;
+PianoInput* piano_plugin_ptr = nullptr;
+SplashScreen splash_screen;
+MainUI main_ui;
+UIManager ui_manager;
+MidiRouter midi_router;
+TaskScheduler scheduler;
+DebugScreen debug_screen;
+
+void NoTask() {}
+
+void RenderSystemStatusWrapper(DisplayManager* display) { RenderSystemStatus(display, &io_manager); }
+void RenderInputStatusWrapper(DisplayManager* display) { RenderInputStatus(display, &input_manager, &io_manager); }
+void RenderAnalogStatusWrapper(DisplayManager* display) { RenderAnalogStatus(display, &io_manager); }
+void RenderAudioStatusWrapper(DisplayManager* display) { RenderAudioStatus(display, &audio_engine, &volume_mgr); }
+void RenderMIDIStatusWrapper(DisplayManager* display) { RenderMIDIStatus(display, &midi_handler, &midi_router); }
+void RenderTaskStatusWrapper(DisplayManager* display) { RenderTaskStatus(display, &scheduler); }
+
+bool InitFirmware() {
+    SystemInitializer initializer;
+    SystemInitializer::InitParams params;
+    params.hw = &hw;
+    params.io_manager = &io_manager;
+    params.input_manager = &input_manager;
+    params.volume_mgr = &volume_mgr;
+    params.audio_engine = &audio_engine;
+    params.midi_handler = &midi_handler;
+    params.power_mgr = &power_mgr;
+    params.ui_manager = &ui_manager;
+    params.system = &openchord_system;
+    params.global_settings = &global_settings;
+    params.track_settings = &track_settings;
+    params.transport_control = &transport_control;
+    params.octave_shift = &octave_shift;
+    params.splash_screen = &splash_screen;
+    params.main_ui = &main_ui;
+    params.chord_plugin_ptr = &chord_plugin_ptr;
+    params.piano_plugin_ptr = &piano_plugin_ptr;
+    params.debug_screen = &debug_screen;
+    if (!initializer.Initialize(params)) return false;
+
+    DisplayManager* display = io_manager.GetDisplay();
+    if (!display || !display->IsHealthy()) return false;
+
+    // UI wiring from main.cpp
+    ui_manager.SetMainUIRenderer([](DisplayManager* disp) { main_ui.Render(disp); });
+    ui_manager.SetMainUIDirtyCheck([]() -> bool {
+        main_ui.Update();
+        return main_ui.IsDirty();
+    });
+    if (chord_plugin_ptr) {
+        chord_plugin_ptr->SetOctaveUICheckCallback([]() -> bool { return ui_manager.IsOctaveUIActive(); });
+    }
+
+    debug_screen.Init(display, &input_manager);
+    debug_screen.AddView("System", RenderSystemStatusWrapper);
+    debug_screen.AddView("Inputs", RenderInputStatusWrapper);
+    debug_screen.AddView("Analog", RenderAnalogStatusWrapper);
+    debug_screen.AddView("Audio", RenderAudioStatusWrapper);
+    debug_screen.AddView("MIDI", RenderMIDIStatusWrapper);
+    debug_screen.AddView("Tasks", RenderTaskStatusWrapper);
+    debug_screen.SetEnabled(false);
+    ui_manager.SetDebugRenderer([](DisplayManager* disp) { debug_screen.Render(disp); });
+
+    midi_router.Init(&openchord_system, &midi_handler, &octave_shift);
+    midi_router.SetGlobalSettings(&global_settings);
+
+    // Same task table as the firmware, so the task view has rows
+    scheduler.Init(daisy::System::GetUs);
+    scheduler.AddTask("MIDI", NoTask, 1000, 0);
+    scheduler.AddTask("Input", NoTask, 1000, 1);
+    scheduler.AddTask("ADC", NoTask, power_mgr.GetADCInterval() * 1000, 2);
+    scheduler.AddTask("Display", NoTask, DISPLAY_TASK_PERIOD_MS * 1000, 3);
+    scheduler.AddTask("Power", NoTask, 10000, 4);
+
+    // Whole frame per update: the time measured is one full frame
+    ui_manager.SetUpdatePeriod(DISPLAY_TASK_PERIOD_MS);
+    ui_manager.SetRenderClock(daisy::System::GetUs);
+    ui_manager.SetRenderBudgetUs(0);
+    return true;
+}
+
+void PushKey(InputEventType type, uint8_t key) {
+    InputEventStream& stream = input_manager.GetEventStream();
+    uint32_t now = daisy::System::GetUs();
+    stream.BeginPass(now);
+    stream.Push(type, key, 0);
+    stream.Dispatch(now);
+}
+
+// --- Screens ---
+
+// Called before each update with the update index (state changes go here)
+typedef void (*StepFunc)(int update);
+
+struct Screen {
+    const char* name;
+    void (*enter)();
+    StepFunc step;
+    void (*leave)();
+};
+
+void NoStep(int) {}
+void Nothing() {}
+
+// Main UI
+void MainKeyStep(int update) {
+    Track* track = openchord_system.GetTrack(0);
+    if (track && update % 8 == 0) {
+        track->SetKey(MusicalKey(static_cast<uint8_t>((update / 8) * 7 % 12), MusicalMode::IONIAN));
+    }
+}
+void MainKeyLeave() {
+    Track* track = openchord_system.GetTrack(0);
+    if (track) track->SetKey(MusicalKey(0, MusicalMode::IONIAN));
+}
+void MainPlayStep(int update) {
+    // Play a key every 8 updates, held for 6 of them
+    uint8_t key = static_cast<uint8_t>((update / 8) % InputEvent::MUSICAL_KEY_COUNT);
+    if (update % 8 == 0) PushKey(InputEventType::KEY_DOWN, key);
+    if (update % 8 == 6) PushKey(InputEventType::KEY_UP, key);
+}
+bool chord_was_active = false;
+void MainChordEnter() {
+    chord_was_active = chord_plugin_ptr && chord_plugin_ptr->IsActive();
+    if (chord_plugin_ptr) chord_plugin_ptr->SetActive(true);
+}
+void MainChordLeave() {
+    if (chord_plugin_ptr) chord_plugin_ptr->SetActive(chord_was_active);
+}
+
+// Menus
+void MenuMainEnter() { ui_manager.GetMenuManager()->OpenMainMenu(); }
+void MenuInputEnter() { ui_manager.GetMenuManager()->OpenInputStackMenu(); }
+void MenuInstrumentEnter() { ui_manager.GetMenuManager()->OpenInstrumentMenu(); }
+void MenuFxEnter() { ui_manager.GetMenuManager()->OpenFXMenu(); }
+void MenuStep(int update) {
+    // Scroll down one item every 4 updates, then back up
+    if (update % 4 != 3) return;
+    if ((update / 20) % 2 == 0) {
+        ui_manager.GetMenuManager()->NavigateDown();
+    } else {
+        ui_manager.GetMenuManager()->NavigateUp();
+    }
+}
+void MenuLeave() {
+    ui_manager.GetSettingsManager()->SetPlugin(nullptr);
+    ui_manager.GetMenuManager()->CloseMenu();
+}
+
+// Settings (what MenuManager::UpdateMenuInput does after entering an item)
+void SyncSettings() {
+    ui_manager.GetSettingsManager()->SetPlugin(ui_manager.GetMenuManager()->GetCurrentSettingsPlugin());
+}
+void SettingsInputEnter() {
+    ui_manager.GetMenuManager()->OpenInputStackMenu();
+    ui_manager.GetMenuManager()->NavigateEnter();
+    SyncSettings();
+}
+void SettingsGlobalEnter() {
+    ui_manager.GetMenuManager()->OpenGlobalSettingsMenu();
+    ui_manager.GetMenuManager()->NavigateEnter();
+    SyncSettings();
+}
+void SettingsStep(int update) {
+    // Turn the selected value up then back, then move to the next setting
+    SettingsManager* settings = ui_manager.GetSettingsManager();
+    switch (update % 10) {
+        case 2: case 3: settings->ChangeValue(1.0f); break;
+        case 5: case 6: settings->ChangeValue(-1.0f); break;
+        case 9: settings->MoveSelection(1); break;
+        default: break;
+    }
+}
+
+// Octave overlay: stick pushed right then left (shifts and moves the bar)
+void OctaveEnter() { ui_manager.ActivateOctaveUI(); }
+void OctaveStep(int update) {
+    float x = 0.0f;
+    int phase = update % 16;
+    if (phase >= 2 && phase < 6) x = 1.0f;
+    if (phase >= 10 && phase < 14) x = -1.0f;
+    ui_manager.UpdateOctaveUI(x, daisy::System::GetNow());
+}
+void OctaveLeave() { ui_manager.DeactivateOctaveUI(); }
+
+// Debug views
+template <int VIEW>
+void DebugEnter() {
+    debug_screen.SetEnabled(true);
+    debug_screen.SetView(VIEW);
+    ui_manager.SetDebugMode(true);
+}
+void DebugLeave() {
+    debug_screen.SetEnabled(false);
+    ui_manager.SetDebugMode(false);
+}
+
+const Screen SCREENS[] = {
+    {"main-idle",        Nothing,                NoStep,        Nothing},
+    {"main-key",         Nothing,                MainKeyStep,   MainKeyLeave},
+    {"main-notes",       Nothing,                MainPlayStep,  Nothing},
+    {"main-chord",       MainChordEnter,         MainPlayStep,  MainChordLeave},
+    {"menu-main",        MenuMainEnter,          MenuStep,      MenuLeave},
+    {"menu-input",       MenuInputEnter,         MenuStep,      MenuLeave},
+    {"menu-instrument",  MenuInstrumentEnter,    MenuStep,      MenuLeave},
+    {"menu-fx",          MenuFxEnter,            MenuStep,      MenuLeave},
+    {"settings-input",   SettingsInputEnter,     SettingsStep,  MenuLeave},
+    {"settings-global",  SettingsGlobalEnter,    SettingsStep,  MenuLeave},
+    {"octave",           OctaveEnter,            OctaveStep,    OctaveLeave},
+    {"debug-system",     DebugEnter<0>,          NoStep,        DebugLeave},
+    {"debug-inputs",     DebugEnter<1>,          NoStep,        DebugLeave},
+    {"debug-analog",     DebugEnter<2>,          NoStep,        DebugLeave},
+    {"debug-audio",      DebugEnter<3>,          NoStep,        DebugLeave},
+    {"debug-midi",       DebugEnter<4>,          NoStep,        DebugLeave},
+    {"debug-tasks",      DebugEnter<5>,          NoStep,        DebugLeave},
+};
+
+const char* ContentTypeName(UIManager::ContentType type) {
+    switch (type) {
+        case UIManager::ContentType::NONE:      return "NONE";
+        case UIManager::ContentType::MAIN_UI:   return "MAIN_UI";
+        case UIManager::ContentType::DEBUG:     return "DEBUG";
+        case UIManager::ContentType::MENU:      return "MENU";
+        case UIManager::ContentType::SETTINGS:  return "SETTINGS";
+        case UIManager::ContentType::PLUGIN_UI: return "PLUGIN_UI";
+        case UIManager::ContentType::OCTAVE_UI: return "OCTAVE_UI";
+    }
+    return "?";
+}
+
+// Binary PBM, lit pixels white as on the panel
+bool WritePbm(const char* path, const uint8_t* frame) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    fprintf(file, "P4\n%zu %zu\n", FrameDiff::WIDTH, FrameDiff::PAGE_COUNT * 8);
+    for (size_t y = 0; y < FrameDiff::PAGE_COUNT * 8; y++) {
+        uint8_t row[FrameDiff::WIDTH / 8];
+        for (size_t x = 0; x < FrameDiff::WIDTH; x += 8) {
+            uint8_t bits = 0;
+            for (size_t i = 0; i < 8; i++) {
+                bool lit = (frame[(y / 8) * FrameDiff::WIDTH + x + i] >> (y % 8)) & 1;
+                if (!lit) bits |= static_cast<uint8_t>(0x80 >> i);
+            }
+            row[x / 8] = bits;
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+    return fclose(file) == 0;
+}
+
+struct Result {
+    UIManager::ContentType content;
+    uint32_t frames;
+    double total_us;
+    double worst_us;
+    uint32_t first_bytes;
+    uint64_t later_bytes;
+    uint32_t unchanged;
+};
+
+Result RunScreen(const Screen& screen, int updates) {
+    Result result = {};
+    DisplayManager* display = io_manager.GetDisplay();
+    const FrameDiff& stats = display->GetUpdateStats();
+
+    screen.enter();
+    for (int i = 0; i < updates; i++) {
+        screen.step(i);
+
+        uint32_t frames_before = stats.GetFrameCount();
+        uint32_t unchanged_before = stats.GetUnchangedFrameCount();
+        auto start = std::chrono::steady_clock::now();
+        ui_manager.Update();
+        auto end = std::chrono::steady_clock::now();
+        daisy::System::Delay(DISPLAY_TASK_PERIOD_MS);
+        if (stats.GetFrameCount() == frames_before) continue;
+
+        double us = std::chrono::duration<double, std::micro>(end - start).count();
+        uint32_t bytes = stats.GetLastFrameBytes();
+        if (result.frames == 0) {
+            result.first_bytes = bytes;
+        } else {
+            result.later_bytes += bytes;
+        }
+        if (stats.GetUnchangedFrameCount() != unchanged_before) result.unchanged++;
+        result.frames++;
+        result.total_us += us;
+        if (us > result.worst_us) result.worst_us = us;
+    }
+    result.content = ui_manager.GetContentType();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int updates = 40;
+    const char* dump_dir = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--updates") == 0 && i + 1 < argc) {
+            updates = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dump_dir = argv[++i];
+        } else {
+            fprintf(stderr, "usage: ui_bench [--updates n] [--dump dir]\n");
+            return 1;
+        }
+    }
+    if (updates <= 0) {
+        fprintf(stderr, "ui_bench: updates must be > 0\n");
+        return 1;
+    }
+
+    if (!InitFirmware()) {
+        fprintf(stderr, "ui_bench: firmware init failed\n");
+        return 1;
+    }
+
+    // Settle on the main screen first so the first screen doesn't pay for init
+    for (int i = 0; i < 10; i++) {
+        ui_manager.Update();
+        daisy::System::Delay(DISPLAY_TASK_PERIOD_MS);
+    }
+
+    printf("%d updates per screen, %u ms apart\n", updates, DISPLAY_TASK_PERIOD_MS);
+    printf("screen            content    frames  render avg/worst (us)  first bytes  avg bytes  unchanged\n");
+
+    bool ok = true;
+    int index = 0;
+    for (const Screen& screen : SCREENS) {
+        Result r = RunScreen(screen, updates);
+        uint32_t later_frames = r.frames > 1 ? r.frames - 1 : 0;
+        printf("%-17s %-10s %6u  %9.1f / %-9.1f  %11u  %9.0f  %9u\n", screen.name, ContentTypeName(r.content),
+               r.frames, r.frames ? r.total_us / r.frames : 0.0, r.worst_us, r.first_bytes,
+               later_frames ? static_cast<double>(r.later_bytes) / later_frames : 0.0, r.unchanged);
+
+        if (dump_dir) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%02d-%s.pbm", dump_dir, index, screen.name);
+            if (!WritePbm(path, io_manager.GetDisplay()->GetTransfer().GetFrontBuffer())) {
+                fprintf(stderr, "ui_bench: can't write %s\n", path);
+                ok = false;
+            }
+        }
+        screen.leave();
+        index++;
+    }
+
+    const FrameDiff& stats = io_manager.GetDisplay()->GetUpdateStats();
+    printf("\ntotal: %u frames, %u unchanged, average %u bytes, worst %u bytes (full frame %zu)\n",
+           stats.GetFrameCount(), stats.GetUnchangedFrameCount(), stats.GetAverageFrameBytes(),
+           stats.GetWorstFrameBytes(), FrameDiff::FULL_FRAME_BYTES);
+    return ok ? 0 : 1;
+}